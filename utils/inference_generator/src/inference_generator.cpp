@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include <math.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <algorithm>
 
 #define error(...) printf("ERROR: " __VA_ARGS__), exit(1)
 #define info(...)  printf("OK: " __VA_ARGS__)
@@ -351,12 +352,27 @@ void writeGDF(
     std::ostream& ofsGDF,
     std::vector<std::vector<std::string>>& net,
     std::map<std::string,std::vector<int>>& tensorMap,
+    std::map<std::string,std::string>& tensorFormatMap,
     std::string tensorType,
     int fixedPointPosition,
     std::string convertPolicy,
     std::string roundPolicy,
     bool isVirtualEnabled)
 {
+    // tensorFormatMap holds "type,fixed-point-position" of quantized tensors; when it is
+    // non-empty, all remaining tensors are FLOAT32
+    auto tensorFormat = [&](const std::string& name) -> std::string {
+        auto it = tensorFormatMap.find(name);
+        if(it != tensorFormatMap.end()) return it->second;
+        if(tensorFormatMap.empty()) return tensorType + "," + std::to_string(fixedPointPosition);
+        return "VX_TYPE_FLOAT32,0";
+    };
+    auto tensorFileExtension = [&](const std::string& name) -> std::string {
+        std::string format = tensorFormat(name);
+        if(format.find("VX_TYPE_INT8,") == 0) return ".i8";
+        if(format.find("VX_TYPE_INT16,") == 0) return ".i16";
+        return ".f32";
+    };
     std::map<std::string,bool> tensorCheck;
     ofsGDF << "import vx_nn" << std::endl;
     for(auto& node : net) {
@@ -367,17 +383,17 @@ void writeGDF(
             if(node[i] != "" && tensorCheck.find(node[i]) == tensorCheck.end()) {
                 auto&& dim = tensorMap[node[i]];
                 if((isVirtualEnabled && isFirstLayer) || (isVirtualEnabled && isLastLayer)) {
-                    ofsGDF << "data " << node[i] << " = tensor:4,{" << dim[3] << "," << dim[2] << "," << dim[1] << "," << dim[0] << "}," << tensorType << "," << fixedPointPosition << std::endl;
+                    ofsGDF << "data " << node[i] << " = tensor:4,{" << dim[3] << "," << dim[2] << "," << dim[1] << "," << dim[0] << "}," << tensorFormat(node[i]) << std::endl;
                     tensorCheck[node[i]] = true;
                     if(!isLastLayer){
                         ofsGDF << "read data input.f32" << std::endl;
                     }
                 }else {
                     if(isVirtualEnabled) {
-                        ofsGDF << "data " << node[i] << " = virtual-tensor:4,{" << dim[3] << "," << dim[2] << "," << dim[1] << "," << dim[0] << "}," << tensorType << "," << fixedPointPosition << std::endl;
+                        ofsGDF << "data " << node[i] << " = virtual-tensor:4,{" << dim[3] << "," << dim[2] << "," << dim[1] << "," << dim[0] << "}," << tensorFormat(node[i]) << std::endl;
                         tensorCheck[node[i]] = true;
                     }else{
-                        ofsGDF << "data " << node[i] << " = tensor:4,{" << dim[3] << "," << dim[2] << "," << dim[1] << "," << dim[0] << "}," << tensorType << "," << fixedPointPosition << std::endl;
+                        ofsGDF << "data " << node[i] << " = tensor:4,{" << dim[3] << "," << dim[2] << "," << dim[1] << "," << dim[0] << "}," << tensorFormat(node[i]) << std::endl;
                         tensorCheck[node[i]]= true;
                         if(isFirstLayer) ofsGDF << "read data input.f32" << std::endl;
                     }
@@ -388,13 +404,13 @@ void writeGDF(
         auto&& odim = tensorMap[output];
         if(!tensorCheck[output]) {
             if(!isVirtualEnabled) {
-                ofsGDF << "data " << output << " = tensor:4,{" << odim[3] << "," << odim[2] << "," << odim[1] << "," << odim[0] << "}," << tensorType << "," << fixedPointPosition << std::endl;
+                ofsGDF << "data " << output << " = tensor:4,{" << odim[3] << "," << odim[2] << "," << odim[1] << "," << odim[0] << "}," << tensorFormat(output) << std::endl;
             } else {
                 if(!isLastLayer) {
-                    ofsGDF << "data " << output << " = virtual-tensor:4,{" << odim[3] << "," << odim[2] << "," << odim[1] << "," << odim[0] << "}," << tensorType << "," << fixedPointPosition << std::endl;
+                    ofsGDF << "data " << output << " = virtual-tensor:4,{" << odim[3] << "," << odim[2] << "," << odim[1] << "," << odim[0] << "}," << tensorFormat(output) << std::endl;
                 }
                 else {
-                    ofsGDF << "data " << output << " = tensor:4,{" << odim[3] << "," << odim[2] << "," << odim[1] << "," << odim[0] << "}," << tensorType << "," << fixedPointPosition << std::endl;
+                    ofsGDF << "data " << output << " = tensor:4,{" << odim[3] << "," << odim[2] << "," << odim[1] << "," << odim[0] << "}," << tensorFormat(output) << std::endl;
                 }
             }
 #if ENABLE_DIRECTIVE
@@ -414,8 +430,8 @@ void writeGDF(
             ss >> k >> kernel_w >> kernel_h >> stride_w >> stride_h >> pad_w >> pad_h >> dilation_w >> dilation_h >> bias_term;
             std::string weights = output + "_W";
             auto&& dim = tensorMap[weights];
-            ofsGDF << "data " << weights << " = tensor:4,{" << dim[3] << "," << dim[2] << "," << dim[1] << "," << dim[0] << "}," << tensorType << "," << fixedPointPosition << std::endl;
-            ofsGDF << "init " << weights << " weights/" << layer_name << ".f32" << std::endl;
+            ofsGDF << "data " << weights << " = tensor:4,{" << dim[3] << "," << dim[2] << "," << dim[1] << "," << dim[0] << "}," << tensorFormat(weights) << std::endl;
+            ofsGDF << "init " << weights << " weights/" << layer_name << tensorFileExtension(weights) << std::endl;
 #if ENABLE_DIRECTIVE
             ofsGDF << "directive " << weights << " VX_DIRECTIVE_AMD_COPY_TO_OPENCL" << std::endl;
 #endif
@@ -423,8 +439,8 @@ void writeGDF(
             std::string bias = "NULL";
             if(bias_term) {
                 bias = output + "_B";
-                ofsGDF << "data " << bias << " = tensor:1,{" << k << "}," << tensorType << "," << fixedPointPosition << std::endl;
-                ofsGDF << "init " << bias << " bias/"<< layer_name << ".f32" << std::endl;
+                ofsGDF << "data " << bias << " = tensor:1,{" << k << "}," << tensorFormat(bias) << std::endl;
+                ofsGDF << "init " << bias << " bias/" << layer_name << tensorFileExtension(bias) << std::endl;
 #if ENABLE_DIRECTIVE
                 ofsGDF << "directive " << bias << " VX_DIRECTIVE_AMD_COPY_TO_OPENCL" << std::endl;
 #endif
@@ -446,7 +462,7 @@ void writeGDF(
             ss >> k >> kernel_w >> kernel_h >> stride_w >> stride_h >> pad_w >> pad_h >> dilation_w >> dilation_h >> bias_term;
             std::string weights = output + "_W";
             auto&& dim = tensorMap[weights];
-            ofsGDF << "data " << weights << " = tensor:4,{" << dim[3] << "," << dim[2] << "," << dim[1] << "," << dim[0] << "}," << tensorType << "," << fixedPointPosition << std::endl;
+            ofsGDF << "data " << weights << " = tensor:4,{" << dim[3] << "," << dim[2] << "," << dim[1] << "," << dim[0] << "}," << tensorFormat(weights) << std::endl;
             ofsGDF << "init " << weights << " weights/" << layer_name << ".f32" << std::endl;
 #if ENABLE_DIRECTIVE
             ofsGDF << "directive " << weights << " VX_DIRECTIVE_AMD_COPY_TO_OPENCL" << std::endl;
@@ -455,7 +471,7 @@ void writeGDF(
             std::string bias = "NULL";
             if(bias_term) {
                 bias = output + "_B";
-                ofsGDF << "data " << bias << " = tensor:1,{" << k << "}," << tensorType << "," << fixedPointPosition << std::endl;
+                ofsGDF << "data " << bias << " = tensor:1,{" << k << "}," << tensorFormat(bias) << std::endl;
                 ofsGDF << "init " << bias << " bias/"<< layer_name << ".f32" << std::endl;
 #if ENABLE_DIRECTIVE
                 ofsGDF << "directive " << bias << " VX_DIRECTIVE_AMD_COPY_TO_OPENCL" << std::endl;
@@ -463,7 +479,7 @@ void writeGDF(
                 tensorCheck[bias] = true;
             }else{
                 bias = output + "_B";
-                ofsGDF << "data " << bias << " = tensor:1,{" << k << "}," << tensorType << "," << fixedPointPosition << std::endl;
+                ofsGDF << "data " << bias << " = tensor:1,{" << k << "}," << tensorFormat(bias) << std::endl;
 #if ENABLE_DIRECTIVE
                 ofsGDF << "directive " << bias << " VX_DIRECTIVE_AMD_COPY_TO_OPENCL" << std::endl;
 #endif
@@ -509,8 +525,8 @@ void writeGDF(
             ss >> k >> bias_term;
             std::string weights = output + "_W";
             auto&& dim = tensorMap[weights];
-            ofsGDF << "data " << weights << " = tensor:4,{" << dim[3] << "," << dim[2] << "," << dim[1] << "," << dim[0] << "}," << tensorType << "," << fixedPointPosition << std::endl;
-            ofsGDF << "init " << weights << " weights/"<< layer_name << ".f32" << std::endl;
+            ofsGDF << "data " << weights << " = tensor:4,{" << dim[3] << "," << dim[2] << "," << dim[1] << "," << dim[0] << "}," << tensorFormat(weights) << std::endl;
+            ofsGDF << "init " << weights << " weights/" << layer_name << tensorFileExtension(weights) << std::endl;
 #if ENABLE_DIRECTIVE
             ofsGDF << "directive " << weights << " VX_DIRECTIVE_AMD_COPY_TO_OPENCL" << std::endl;
 #endif
@@ -518,8 +534,8 @@ void writeGDF(
             std::string bias = "NULL";
             if(bias_term) {
                 bias = output + "_B";
-                ofsGDF << "data " << bias << " = tensor:1,{" << k << "}," << tensorType << "," << fixedPointPosition << std::endl;
-                ofsGDF << "init " << bias << " bias/"<< layer_name << ".f32" << std::endl;
+                ofsGDF << "data " << bias << " = tensor:1,{" << k << "}," << tensorFormat(bias) << std::endl;
+                ofsGDF << "init " << bias << " bias/" << layer_name << tensorFileExtension(bias) << std::endl;
 #if ENABLE_DIRECTIVE
                 ofsGDF << "directive " << bias << " VX_DIRECTIVE_AMD_COPY_TO_OPENCL" << std::endl;
 #endif
@@ -536,6 +552,18 @@ void writeGDF(
             ofsGDF << "write "<< node[3] << " out/"<< layer_name << ".f32" << std::endl;
 #endif
         }
+        else if(type == "ConvertDepth") {
+            // conversion between float and quantized tensors inserted by quantizeNet
+            ofsGDF << "data " << node[3] << "_policy =" << " scalar:VX_TYPE_ENUM," << convertPolicy << std::endl;
+            ofsGDF << "data " << node[3] << "_norm =" << " scalar:VX_TYPE_FLOAT32,1" << std::endl;
+            ofsGDF << "data " << node[3] << "_offset =" << " scalar:VX_TYPE_FLOAT32,0" << std::endl;
+            ofsGDF << "node org.khronos.openvx.tensor_convert_depth " << node[4] << " "
+                   << node[3] << "_policy "
+                   << node[3] << "_norm "
+                   << node[3] << "_offset"
+                   << " " << node[3]
+                   << std::endl;
+        }
         else if(type == "ReLU") {
             ofsGDF << "data " << node[3] << "_mode = " << " scalar:VX_TYPE_ENUM,VX_NN_ACTIVATION_RELU" << std::endl;
             ofsGDF << "data " << node[3] << "_param_a =" << " scalar:VX_TYPE_FLOAT32,0" << std::endl;
@@ -609,7 +637,7 @@ void writeGDF(
                 std::string out = node[3];
                 if(i < node.size()-1) {
                     out += "tmp_" + std::to_string(i-4);
-                    ofsGDF << "data " << out << " = tensor:4,{" << dim[3] << "," << dim[2] << "," << dim[1] << "," << dim[0] << "}," << tensorType << "," << fixedPointPosition << std::endl;
+                    ofsGDF << "data " << out << " = tensor:4,{" << dim[3] << "," << dim[2] << "," << dim[1] << "," << dim[0] << "}," << tensorFormat(out) << std::endl;
                     tensorCheck[out] = true;
                 }
                 if(op == 1) {
@@ -1343,19 +1371,21 @@ void writeVXCode(
 void generateCode(
     std::ostream& ofsCodeH,
     std::ostream& ofsCodeC,
-    std::ofstream& ofsCodeM,
     std::vector<std::vector<std::string>>& net,
     std::map<std::string,std::vector<int>>& tensorMap,
     std::string tensorType,
     int fixedPointPosition,
     std::string convertPolicy,
     std::string roundPolicy,
-    bool isVirtualEnabled)
+    bool isVirtualEnabled,
+    std::string netSuffix)
 {
     // TODO: this code needs to be verified
 
-    ofsCodeH << "#ifndef __net_h__" << std::endl;
-    ofsCodeH << "#define __net_h__" << std::endl << std::endl;
+    // netSuffix keeps class and include guard names unique when code for several batch sizes is linked together
+    std::string className = "NetVX" + netSuffix;
+    ofsCodeH << "#ifndef __net" << netSuffix << "_h__" << std::endl;
+    ofsCodeH << "#define __net" << netSuffix << "_h__" << std::endl << std::endl;
     ofsCodeH << "#include <VX/vx.h>" << std::endl;
     ofsCodeH << "#include <vx_ext_amd.h>" << std::endl;
     ofsCodeH << "#include <VX/vx_khr_nn.h>" << std::endl << std::endl;
@@ -1381,13 +1411,13 @@ void generateCode(
     ofsCodeH << "#define ERROR_CHECK_OBJECT(obj) { vx_status status = vxGetStatus((vx_reference)(obj)); if(status != VX_SUCCESS){ vxAddLogEntry((vx_reference)(obj), status, \"ERROR: failed with status = (%d) at \" __FILE__ \"#%d\", status, __LINE__); return status; }}"
              << std::endl;
     ofsCodeH
-            << "class NetVX {" << std::endl
+            << "class " << className << " {" << std::endl
             << "public:" << std::endl
-            << "    NetVX();" << std::endl
+            << "    " << className << "();" << std::endl
             << "    int Initialize(const char * dataFolder);" << std::endl
             << "    int Shutdown();" << std::endl
             << "    int Run(float * inputTensor, size_t inputSizeInBytes, float * outputTensor, size_t outputSizeInBytes);" << std::endl
-            << "    ~NetVX();"
+            << "    ~" << className << "();"
             << std::endl << std::endl
             << "protected:" << std::endl
                ;
@@ -1395,22 +1425,22 @@ void generateCode(
     ofsCodeH << "};" << std::endl << std::endl << "#endif" << std::endl;
 
     ofsCodeC << "#include \"net.h\"" << std::endl << std::endl;
-    ofsCodeC << "NetVX::NetVX() :" << std::endl;
+    ofsCodeC << className << "::" << className << "() :" << std::endl;
     writeVXCode(ofsCodeH,ofsCodeC, net, tensorMap, tensorType, fixedPointPosition, convertPolicy, roundPolicy, isVirtualEnabled, "constructor");
     ofsCodeC << "{" << std::endl;
     ofsCodeC << std::endl;
     ofsCodeC << "}" << std::endl << std::endl;
 
-    ofsCodeC << "NetVX::~NetVX() {}" << std::endl << std::endl;
+    ofsCodeC << className << "::~" << className << "() {}" << std::endl << std::endl;
 
-    ofsCodeC << "int NetVX::Initialize(const char * dataFolder)" << std::endl;
+    ofsCodeC << "int " << className << "::Initialize(const char * dataFolder)" << std::endl;
     ofsCodeC << "{" << std::endl;
     ofsCodeC << "   std::string str = dataFolder, fileName;" << std::endl;
     writeVXCode(ofsCodeH,ofsCodeC, net, tensorMap, tensorType, fixedPointPosition, convertPolicy, roundPolicy, isVirtualEnabled, "initialize");
     ofsCodeC << "	return 0;" << std::endl;
     ofsCodeC << "}" << std::endl << std::endl;
 
-    ofsCodeC << "int NetVX::Shutdown()" << std::endl;
+    ofsCodeC << "int " << className << "::Shutdown()" << std::endl;
     ofsCodeC << "{" << std::endl;
     writeVXCode(ofsCodeH,ofsCodeC, net, tensorMap, tensorType, fixedPointPosition, convertPolicy, roundPolicy, isVirtualEnabled, "release_nodes");
     writeVXCode(ofsCodeH,ofsCodeC, net, tensorMap, tensorType, fixedPointPosition, convertPolicy, roundPolicy, isVirtualEnabled, "release_graph");
@@ -1419,12 +1449,15 @@ void generateCode(
     ofsCodeC << "	return 0;" << std::endl;
     ofsCodeC << "}" << std::endl << std::endl;
 
-    ofsCodeC << "int NetVX::Run(float * inputTensor, size_t inputSizeInBytes, float * outputTensor, size_t outputSizeInBytes)" << std::endl;
+    ofsCodeC << "int " << className << "::Run(float * inputTensor, size_t inputSizeInBytes, float * outputTensor, size_t outputSizeInBytes)" << std::endl;
     ofsCodeC << "{" << std::endl;
     writeVXCode(ofsCodeH,ofsCodeC, net, tensorMap, tensorType, fixedPointPosition, convertPolicy, roundPolicy, isVirtualEnabled, "run");
     ofsCodeC << "	return 0;" << std::endl;
     ofsCodeC << "}" << std::endl << std::endl;
+}
 
+void generateMainCode(std::ostream& ofsCodeM)
+{
     ofsCodeM << "#include \"net.h\"" << std::endl ;
     ofsCodeM << "#include <iostream> " << std::endl;
     ofsCodeM << "#include <stdio.h>" << std::endl;
@@ -1457,7 +1490,160 @@ void generateCode(
     ofsCodeM << "   " << "delete[] outputTensor;" << std::endl;
     ofsCodeM << "   " << "return 1;" << std::endl << std::endl;
     ofsCodeM << "}" << std::endl;
+}
 
+void generateBatcherCode(std::ostream& ofsCodeB, std::vector<int>& batchSizes)
+{
+    // FrameBatcher coalesces frames submitted by producer threads into the largest batch that is
+    // ready within a deadline and picks the smallest generated batch size that can hold it
+    ofsCodeB << "#ifndef __batcher_h__" << std::endl;
+    ofsCodeB << "#define __batcher_h__" << std::endl << std::endl;
+    ofsCodeB << "#include <vector>" << std::endl;
+    ofsCodeB << "#include <deque>" << std::endl;
+    ofsCodeB << "#include <mutex>" << std::endl;
+    ofsCodeB << "#include <condition_variable>" << std::endl;
+    ofsCodeB << "#include <chrono>" << std::endl;
+    ofsCodeB << "#include <algorithm>" << std::endl;
+    ofsCodeB << "#include <string.h>" << std::endl << std::endl;
+    ofsCodeB << "static const int generatedBatchSizes[] = {";
+    for(size_t i = 0; i < batchSizes.size(); i++) {
+        ofsCodeB << (i > 0 ? ", " : " ") << batchSizes[i];
+    }
+    ofsCodeB << " };" << std::endl << std::endl;
+    ofsCodeB
+        << "class FrameBatcher {" << std::endl
+        << "public:" << std::endl
+        << "    FrameBatcher(size_t frameSizeInBytes, int deadlineInMicroseconds)" << std::endl
+        << "        : frameSize(frameSizeInBytes), deadline(deadlineInMicroseconds), closed(false)" << std::endl
+        << "    {" << std::endl
+        << "        batchSizes.assign(generatedBatchSizes, generatedBatchSizes + sizeof(generatedBatchSizes) / sizeof(generatedBatchSizes[0]));" << std::endl
+        << "        std::sort(batchSizes.begin(), batchSizes.end());" << std::endl
+        << "    }" << std::endl
+        << "    int MaxBatchSize() { return batchSizes.back(); }" << std::endl << std::endl
+        << "    // queue a frame: returns the frame sequence number" << std::endl
+        << "    long long Push(const void * frame)" << std::endl
+        << "    {" << std::endl
+        << "        std::lock_guard<std::mutex> lock(mutex);" << std::endl
+        << "        Frame item;" << std::endl
+        << "        item.data.assign((const char *)frame, (const char *)frame + frameSize);" << std::endl
+        << "        item.arrival = std::chrono::steady_clock::now();" << std::endl
+        << "        item.sequence = sequence++;" << std::endl
+        << "        frames.push_back(std::move(item));" << std::endl
+        << "        // wake up Pop() on the first frame so that it starts the deadline timer and again when the batch is full" << std::endl
+        << "        if(frames.size() == 1 || (int)frames.size() >= MaxBatchSize()) ready.notify_one();" << std::endl
+        << "        return frames.back().sequence;" << std::endl
+        << "    }" << std::endl << std::endl
+        << "    // wake up Pop() and stop waiting for new frames" << std::endl
+        << "    void Close()" << std::endl
+        << "    {" << std::endl
+        << "        std::lock_guard<std::mutex> lock(mutex);" << std::endl
+        << "        closed = true;" << std::endl
+        << "        ready.notify_all();" << std::endl
+        << "    }" << std::endl << std::endl
+        << "    // wait until MaxBatchSize() frames are queued or the oldest frame reaches the deadline;" << std::endl
+        << "    // copies the frames into batchBuffer (MaxBatchSize() frames) padded with zeros up to graphBatchSize." << std::endl
+        << "    // returns the number of valid frames (0 when closed and empty); sequence numbers go into firstSequence" << std::endl
+        << "    int Pop(void * batchBuffer, int& graphBatchSize, long long& firstSequence)" << std::endl
+        << "    {" << std::endl
+        << "        std::unique_lock<std::mutex> lock(mutex);" << std::endl
+        << "        while(!closed && (int)frames.size() < MaxBatchSize()) {" << std::endl
+        << "            if(frames.empty()) {" << std::endl
+        << "                ready.wait(lock);" << std::endl
+        << "            }" << std::endl
+        << "            else if(ready.wait_until(lock, frames.front().arrival + std::chrono::microseconds(deadline)) == std::cv_status::timeout) {" << std::endl
+        << "                break;" << std::endl
+        << "            }" << std::endl
+        << "        }" << std::endl
+        << "        int count = std::min((int)frames.size(), MaxBatchSize());" << std::endl
+        << "        if(count == 0) return 0;" << std::endl
+        << "        graphBatchSize = *std::lower_bound(batchSizes.begin(), batchSizes.end(), count);" << std::endl
+        << "        firstSequence = frames.front().sequence;" << std::endl
+        << "        char * dst = (char *)batchBuffer;" << std::endl
+        << "        for(int i = 0; i < count; i++, dst += frameSize) {" << std::endl
+        << "            memcpy(dst, frames.front().data.data(), frameSize);" << std::endl
+        << "            frames.pop_front();" << std::endl
+        << "        }" << std::endl
+        << "        memset(dst, 0, (graphBatchSize - count) * frameSize);" << std::endl
+        << "        return count;" << std::endl
+        << "    }" << std::endl << std::endl
+        << "protected:" << std::endl
+        << "    struct Frame {" << std::endl
+        << "        std::vector<char> data;" << std::endl
+        << "        std::chrono::steady_clock::time_point arrival;" << std::endl
+        << "        long long sequence;" << std::endl
+        << "    };" << std::endl
+        << "    size_t frameSize;" << std::endl
+        << "    int deadline;" << std::endl
+        << "    bool closed;" << std::endl
+        << "    long long sequence = 0;" << std::endl
+        << "    std::vector<int> batchSizes;" << std::endl
+        << "    std::deque<Frame> frames;" << std::endl
+        << "    std::mutex mutex;" << std::endl
+        << "    std::condition_variable ready;" << std::endl
+        << "};" << std::endl << std::endl
+        << "#endif" << std::endl;
+}
+
+void generateBatchedMainCode(std::ostream& ofsCodeM, std::vector<int>& batchSizes, size_t inputFrameSize, size_t outputFrameSize)
+{
+    // main.cpp for --batch-sizes: a producer thread pushes frames from input.f32 into FrameBatcher and
+    // each batch runs on the graph generated for the batch size picked by the batcher
+    ofsCodeM << "#include \"batcher.h\"" << std::endl;
+    for(auto batchSize : batchSizes) {
+        ofsCodeM << "#include \"b" << batchSize << "/net.h\"" << std::endl;
+    }
+    ofsCodeM << "#include <iostream>" << std::endl;
+    ofsCodeM << "#include <thread>" << std::endl;
+    ofsCodeM << "#include <stdio.h>" << std::endl;
+    ofsCodeM << "#include <stdlib.h>" << std::endl << std::endl;
+    ofsCodeM << "static const size_t inputFrameSize = " << inputFrameSize << ";" << std::endl;
+    ofsCodeM << "static const size_t outputFrameSize = " << outputFrameSize << ";" << std::endl << std::endl;
+    ofsCodeM << "int main(int argc , char * argv[])" << std::endl;
+    ofsCodeM << "{" << std::endl;
+    ofsCodeM << "   " << "// optional argument: batcher deadline in microseconds" << std::endl;
+    ofsCodeM << "   " << "int deadline = argc > 1 ? atoi(argv[1]) : 1000;" << std::endl;
+    for(auto batchSize : batchSizes) {
+        ofsCodeM << "   " << "NetVX_b" << batchSize << " net_b" << batchSize << ";" << std::endl;
+    }
+    for(auto batchSize : batchSizes) {
+        ofsCodeM << "   " << "if(net_b" << batchSize << ".Initialize(\".\")) { std::cerr << \"ERROR: unable to initialize graph for batch size " << batchSize << "\" << std::endl; return -1; }" << std::endl;
+    }
+    ofsCodeM << "   " << "FILE * fInput = fopen(\"input.f32\", \"rb\");" << std::endl;
+    ofsCodeM << "   " << "if(!fInput) { std::cerr << \" Unable to open the file input.f32 \" << std::endl; return -1; } " << std::endl;
+    ofsCodeM << "   " << "FILE * fOut = fopen(\"output.f32\", \"wb\");" << std::endl;
+    ofsCodeM << "   " << "if(!fOut) { std::cerr << \"ERROR: unable to open output.f32\" << std::endl; fclose(fInput); return -1; }" << std::endl << std::endl;
+    ofsCodeM << "   " << "FrameBatcher batcher(inputFrameSize, deadline);" << std::endl;
+    ofsCodeM << "   " << "std::thread producer([&]() {" << std::endl;
+    ofsCodeM << "   " << "    std::vector<char> frame(inputFrameSize);" << std::endl;
+    ofsCodeM << "   " << "    while(fread(frame.data(), 1, inputFrameSize, fInput) == inputFrameSize) batcher.Push(frame.data());" << std::endl;
+    ofsCodeM << "   " << "    batcher.Close();" << std::endl;
+    ofsCodeM << "   " << "});" << std::endl << std::endl;
+    ofsCodeM << "   " << "float * inputTensor = new float[batcher.MaxBatchSize() * inputFrameSize / sizeof(float)];" << std::endl;
+    ofsCodeM << "   " << "float * outputTensor = new float[batcher.MaxBatchSize() * outputFrameSize / sizeof(float)];" << std::endl;
+    ofsCodeM << "   " << "int graphBatchSize = 0, count;" << std::endl;
+    ofsCodeM << "   " << "long long firstSequence;" << std::endl;
+    ofsCodeM << "   " << "while((count = batcher.Pop(inputTensor, graphBatchSize, firstSequence)) > 0) {" << std::endl;
+    ofsCodeM << "   " << "    // dispatch to the graph for the current batch size" << std::endl;
+    ofsCodeM << "   " << "    size_t inputBytes = graphBatchSize * inputFrameSize, outputBytes = graphBatchSize * outputFrameSize;" << std::endl;
+    ofsCodeM << "   " << "    switch(graphBatchSize) {" << std::endl;
+    for(auto batchSize : batchSizes) {
+        ofsCodeM << "   " << "    case " << batchSize << ": net_b" << batchSize << ".Run(inputTensor, inputBytes, outputTensor, outputBytes); break;" << std::endl;
+    }
+    ofsCodeM << "   " << "    }" << std::endl;
+    ofsCodeM << "   " << "    // padding frames of a partial batch are dropped from the output" << std::endl;
+    ofsCodeM << "   " << "    fwrite(outputTensor, 1, count * outputFrameSize, fOut);" << std::endl;
+    ofsCodeM << "   " << "}" << std::endl;
+    ofsCodeM << "   " << "producer.join();" << std::endl;
+    ofsCodeM << "   " << "fclose(fInput);" << std::endl;
+    ofsCodeM << "   " << "fclose(fOut);" << std::endl << std::endl;
+    ofsCodeM << "   " << "//Release nodes,graph,tensors,context" << std::endl;
+    for(auto batchSize : batchSizes) {
+        ofsCodeM << "   " << "net_b" << batchSize << ".Shutdown();" << std::endl;
+    }
+    ofsCodeM << "   " << "delete[] inputTensor;" << std::endl;
+    ofsCodeM << "   " << "delete[] outputTensor;" << std::endl;
+    ofsCodeM << "   " << "return 0;" << std::endl;
+    ofsCodeM << "}" << std::endl;
 }
 
 void parseCaffeModel(const caffe::NetParameter& net_parameter, std::vector<std::vector<std::string>>& net, int inputDim[4], std::string outputFolder, int flags)
@@ -1600,6 +1786,184 @@ int loadCaffeModelFile(
     return 0;
 }
 
+int getFixedPointPosition(float maxAbs, int bits)
+{
+    // pick the fixed-point position that keeps maxAbs representable in a signed integer with "bits" fractional capacity
+    if(maxAbs <= 0) return bits;
+    int fpp = bits - ((int)floorf(log2f(maxAbs)) + 1);
+    if(fpp < 0) fpp = 0;
+    if(fpp > 2 * bits) fpp = 2 * bits;
+    return fpp;
+}
+
+int loadFloatFile(std::string fileName, std::vector<float>& data)
+{
+    FILE * fp = fopen(fileName.c_str(), "rb");
+    if(!fp) return -1;
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    data.resize(size / sizeof(float));
+    size_t count = data.size() > 0 ? fread(&data[0], sizeof(float), data.size(), fp) : 0;
+    fclose(fp);
+    if(count != data.size()) return -1;
+    return 0;
+}
+
+void loadCalibrationRanges(
+    std::string calibrationFolder,
+    std::vector<std::vector<std::string>>& net,
+    std::map<std::string,float>& rangeMap)
+{
+    // calibration folder contains float tensor dumps: input.f32 for the network input
+    // and <layer>.f32 for layer outputs (see ENABLE_DUMP_LAYER_DATA)
+    std::vector<std::pair<std::string,std::string>> tensorFiles;
+    tensorFiles.push_back(std::make_pair(net.front()[4], calibrationFolder + "/input.f32"));
+    for(auto& node : net) {
+        std::string layer_name = node[3];
+        formatFileName(layer_name,"/","_");
+        tensorFiles.push_back(std::make_pair(node[3], calibrationFolder + "/" + layer_name + ".f32"));
+    }
+    int count = 0;
+    for(auto& tensorFile : tensorFiles) {
+        std::vector<float> data;
+        if(loadFloatFile(tensorFile.second, data) < 0)
+            continue;
+        float maxAbs = rangeMap.find(tensorFile.first) != rangeMap.end() ? rangeMap[tensorFile.first] : 0.0f;
+        for(auto v : data) {
+            if(fabsf(v) > maxAbs) maxAbs = fabsf(v);
+        }
+        rangeMap[tensorFile.first] = maxAbs;
+        count++;
+    }
+    info("loadCalibrationRanges: loaded %d tensor ranges from %s\n", count, calibrationFolder.c_str());
+}
+
+int quantizeLayerData(std::string fileName, std::string tensorType, int bits)
+{
+    // converts <fileName>.f32 into <fileName>.i8 or <fileName>.i16 and returns the fixed-point position used
+    std::vector<float> data;
+    if(loadFloatFile(fileName + ".f32", data) < 0) {
+        error("quantizeLayerData: unable to read %s.f32\n", fileName.c_str());
+    }
+    float maxAbs = 0;
+    for(auto v : data) {
+        if(fabsf(v) > maxAbs) maxAbs = fabsf(v);
+    }
+    int fpp = getFixedPointPosition(maxAbs, bits);
+    float scale = ldexpf(1.0f, fpp), maxValue = (float)((1 << bits) - 1), minValue = -(float)(1 << bits);
+    std::string outputFileName = fileName + (tensorType == "VX_TYPE_INT8" ? ".i8" : ".i16");
+    FILE * fp = fopen(outputFileName.c_str(), "wb");
+    if(!fp) {
+        error("quantizeLayerData: unable to create %s\n", outputFileName.c_str());
+    }
+    for(auto v : data) {
+        float q = nearbyintf(v * scale);
+        q = q > maxValue ? maxValue : (q < minValue ? minValue : q);
+        if(tensorType == "VX_TYPE_INT8") {
+            signed char value = (signed char)q;
+            fwrite(&value, sizeof(value), 1, fp);
+        }
+        else {
+            short value = (short)q;
+            fwrite(&value, sizeof(value), 1, fp);
+        }
+    }
+    fclose(fp);
+    return fpp;
+}
+
+void quantizeNet(
+    std::vector<std::vector<std::string>>& net,
+    std::map<std::string,std::vector<int>>& tensorMap,
+    std::map<std::string,std::string>& tensorFormatMap,
+    std::map<std::string,float>& rangeMap,
+    std::string tensorType,
+    int fixedPointPosition,
+    std::string outputFolder,
+    std::map<std::string,int>& quantizedDataMap)
+{
+    // Convolution, Pooling, InnerProduct, and ReLU layers run on quantized tensors; Dropout and Split keep the
+    // format of their input; all other layers run on float tensors. ConvertDepth nodes are inserted at the boundaries.
+    int bits = (tensorType == "VX_TYPE_INT8") ? 7 : 15;
+    auto activationFormat = [&](const std::string& name) -> std::string {
+        int fpp = rangeMap.find(name) != rangeMap.end() ? getFixedPointPosition(rangeMap[name], bits) : fixedPointPosition;
+        return tensorType + "," + std::to_string(fpp);
+    };
+    std::map<std::string,std::string> quantizedName, floatName;
+    auto getTensor = [&](const std::string& name, bool quantized, std::vector<std::vector<std::string>>& qnet) -> std::string {
+        std::map<std::string,std::string>& nameMap = quantized ? quantizedName : floatName;
+        if(nameMap.find(name) != nameMap.end()) return nameMap[name];
+        std::string source = quantized ? floatName[name] : quantizedName[name];
+        std::string converted = name + (quantized ? "_q" : "_f");
+        tensorMap[converted] = tensorMap[name];
+        if(quantized) tensorFormatMap[converted] = activationFormat(name);
+        std::vector<std::string> node = { "ConvertDepth", "", converted, converted, source };
+        qnet.push_back(node);
+        nameMap[name] = converted;
+        return converted;
+    };
+
+    std::vector<std::vector<std::string>> qnet;
+    for(auto& node : net) {
+        auto&& type = node[0];
+        bool isQuantized = (type == "Convolution" || type == "Pooling" || type == "InnerProduct" || type == "ReLU");
+        bool isPassThrough = (type == "Dropout" || type == "Split");
+        for(size_t i = 4; i < node.size(); i++) {
+            if(quantizedName.find(node[i]) == quantizedName.end() && floatName.find(node[i]) == floatName.end())
+                floatName[node[i]] = node[i];
+        }
+        if(isPassThrough) {
+            isQuantized = (floatName.find(node[4]) == floatName.end());
+        }
+        std::vector<std::string> qnode = node;
+        for(size_t i = 4; i < node.size(); i++) {
+            qnode[i] = getTensor(node[i], isQuantized, qnet);
+        }
+        if(isQuantized) {
+            std::string layer_name = node[3];
+            formatFileName(layer_name,"/","_");
+            if(type == "Convolution" || type == "InnerProduct") {
+                tensorFormatMap[node[3]] = activationFormat(node[3]);
+                // weights and biases don't depend on the batch size: quantize each file only once
+                std::string fileName = outputFolder + "/weights/" + layer_name;
+                if(quantizedDataMap.find(fileName) == quantizedDataMap.end())
+                    quantizedDataMap[fileName] = quantizeLayerData(fileName, tensorType, bits);
+                int fpp = quantizedDataMap[fileName];
+                tensorFormatMap[node[3] + "_W"] = tensorType + "," + std::to_string(fpp);
+                std::stringstream ss(node[1]);
+                int k, bias_term = 0;
+                ss >> k;
+                if(type == "Convolution") {
+                    int kernel_w, kernel_h, stride_w, stride_h, pad_w, pad_h, dilation_w, dilation_h;
+                    ss >> kernel_w >> kernel_h >> stride_w >> stride_h >> pad_w >> pad_h >> dilation_w >> dilation_h;
+                }
+                ss >> bias_term;
+                if(bias_term) {
+                    fileName = outputFolder + "/bias/" + layer_name;
+                    if(quantizedDataMap.find(fileName) == quantizedDataMap.end())
+                        quantizedDataMap[fileName] = quantizeLayerData(fileName, tensorType, bits);
+                    fpp = quantizedDataMap[fileName];
+                    tensorFormatMap[node[3] + "_B"] = tensorType + "," + std::to_string(fpp);
+                }
+            }
+            else {
+                tensorFormatMap[node[3]] = tensorFormatMap[qnode[4]];
+            }
+            quantizedName[node[3]] = node[3];
+        }
+        else {
+            floatName[node[3]] = node[3];
+        }
+        qnet.push_back(qnode);
+    }
+    // keep the network output in float
+    if(quantizedName.find(net.back()[3]) != quantizedName.end()) {
+        getTensor(net.back()[3], false, qnet);
+    }
+    net = qnet;
+}
+
 int main(int argc, char* argv[])
 {
     const char * usage =
@@ -1611,6 +1975,11 @@ int main(int argc, char* argv[])
             "      --[no-]generate-vx-code   - do/don't generate OpenVX C Code with weight/bias initialization (default: OFF)\n"
             "      --output-dir <folder>     - specify output folder for weights/biases, GDF, and OpenVX C Code (default: current)\n"
             "      --flags <int>             - specify custom flags (default: 0)\n"
+            "      --batch-sizes <n,n,...>   - generate net_b<n>.gdf for each batch size; OpenVX C Code goes into b<n>/ for\n"
+            "                                  each batch size and main.cpp uses batcher.h to coalesce frames into batches\n"
+            "                                  and run each batch on the graph for its batch size\n"
+            "      --calibrate <folder>      - specify folder with float layer dumps (input.f32 and <layer>.f32) used to\n"
+            "                                  pick fixed-point positions for VX_TYPE_INT8/VX_TYPE_INT16 (can be repeated)\n"
             ;
 
     // get options
@@ -1619,6 +1988,8 @@ int main(int argc, char* argv[])
     bool generateVXC = false;
     std::string outputFolder = ".";
     int flags = 0;
+    std::vector<std::string> calibrationFolders;
+    std::vector<int> batchSizes;
     for(; argc > 1 && argv[1][0] == '-'; argc--, argv++) {
         if(!strcmp(argv[1], "--virtual-buffers")) {
             isVirtualEnabled = true;
@@ -1649,6 +2020,25 @@ int main(int argc, char* argv[])
             argc--;
             argv++;
         }
+        else if(!strcmp(argv[1], "--batch-sizes") && argc > 2) {
+            std::stringstream ss(argv[2]);
+            std::string item;
+            while(std::getline(ss, item, ',')) {
+                int n = atoi(item.c_str());
+                if(n < 1) {
+                    printf("ERROR: invalid batch size in: %s\n", argv[2]);
+                    return -1;
+                }
+                batchSizes.push_back(n);
+            }
+            argc--;
+            argv++;
+        }
+        else if(!strcmp(argv[1], "--calibrate") && argc > 2) {
+            calibrationFolders.push_back(argv[2]);
+            argc--;
+            argv++;
+        }
         else {
             printf("ERROR: invalid option: %s\n", argv[1]);
             return -1;
@@ -1704,22 +2094,85 @@ int main(int argc, char* argv[])
         return -1;
     }
 
-    // generate tensorMap for given input dimensions
-    std::map<std::string,std::vector<int>> tensorMap;
-    if(calculateTensorDim(net, inputDim, tensorMap) < 0) {
-        return -1;
+    // get batch sizes to generate
+    bool isBatched = batchSizes.size() > 0;
+    if(!isBatched) {
+        batchSizes.push_back(inputDim[0]);
     }
+    std::sort(batchSizes.begin(), batchSizes.end());
+    batchSizes.erase(std::unique(batchSizes.begin(), batchSizes.end()), batchSizes.end());
 
-    if(generateGDF) {
-        std::ofstream ofsGDF(outputFolder + "/net.gdf", std::ios::binary);
-        writeGDF(ofsGDF, net, tensorMap, tensorType, fixedPointPosition, convertPolicy, roundPolicy, isVirtualEnabled);
+    bool isQuantized = !strcmp(tensorType, "VX_TYPE_INT8") || !strcmp(tensorType, "VX_TYPE_INT16");
+    if(isQuantized) {
+        if(!strstr(fileName,".caffemodel")) {
+            printf("ERROR: %s requires a .caffemodel with weights\n", tensorType);
+            return -1;
+        }
+        if(generateVXC) {
+            printf("ERROR: --generate-vx-code is not supported for %s\n", tensorType);
+            return -1;
+        }
+    }
+    else if(calibrationFolders.size() > 0) {
+        printf("ERROR: --calibrate requires VX_TYPE_INT8 or VX_TYPE_INT16 tensor type\n");
+        return -1;
     }
+    std::map<std::string,float> rangeMap;
+    for(auto& folder : calibrationFolders) {
+        loadCalibrationRanges(folder, net, rangeMap);
+    }
+    std::map<std::string,int> quantizedDataMap;
+    size_t inputFrameSize = 0, outputFrameSize = 0;
+
+    for(auto batchSize : batchSizes) {
+        // generate tensorMap for given input dimensions
+        int batchInputDim[4] = { batchSize, inputDim[1], inputDim[2], inputDim[3] };
+        std::vector<std::vector<std::string>> batchNet = net;
+        std::map<std::string,std::vector<int>> tensorMap;
+        if(calculateTensorDim(batchNet, batchInputDim, tensorMap) < 0) {
+            return -1;
+        }
+        auto&& idim = tensorMap[batchNet.front()[4]];
+        auto&& odim = tensorMap[batchNet.back()[3]];
+        inputFrameSize = idim[1] * idim[2] * idim[3] * sizeof(float);
+        outputFrameSize = odim[1] * odim[2] * odim[3] * sizeof(float);
+
+        // quantize network for fixed-point tensor types
+        std::map<std::string,std::string> tensorFormatMap;
+        if(isQuantized) {
+            quantizeNet(batchNet, tensorMap, tensorFormatMap, rangeMap, tensorType, fixedPointPosition, outputFolder, quantizedDataMap);
+        }
+
+        if(generateGDF) {
+            std::string gdfName = isBatched ? "/net_b" + std::to_string(batchSize) + ".gdf" : "/net.gdf";
+            std::ofstream ofsGDF(outputFolder + gdfName, std::ios::binary);
+            writeGDF(ofsGDF, batchNet, tensorMap, tensorFormatMap, tensorType, fixedPointPosition, convertPolicy, roundPolicy, isVirtualEnabled);
+        }
 
+        if(generateVXC) {
+            // each batch size gets its own OpenVX C Code in <output-dir>/b<n> with class NetVX_b<n>
+            std::string codeFolder = outputFolder, netSuffix;
+            if(isBatched) {
+                netSuffix = "_b" + std::to_string(batchSize);
+                codeFolder = outputFolder + "/b" + std::to_string(batchSize);
+                mkdir(codeFolder.c_str(), 0777);
+            }
+            std::ofstream ofsCodeH(codeFolder + "/net.h", std::ios::binary);
+            std::ofstream ofsCodeC(codeFolder + "/net.cpp", std::ios::binary);
+            generateCode(ofsCodeH, ofsCodeC, batchNet, tensorMap, tensorType, fixedPointPosition, convertPolicy, roundPolicy, isVirtualEnabled, netSuffix);
+        }
+    }
     if(generateVXC) {
-        std::ofstream ofsCodeH(outputFolder + "/net.h", std::ios::binary);
-        std::ofstream ofsCodeC(outputFolder + "/net.cpp", std::ios::binary);
+        // with --batch-sizes, a single main.cpp runs all generated graphs through FrameBatcher
         std::ofstream ofsCodeM(outputFolder + "/main.cpp", std::ios::binary);
-        generateCode(ofsCodeH, ofsCodeC, ofsCodeM,  net, tensorMap, tensorType, fixedPointPosition, convertPolicy, roundPolicy, isVirtualEnabled);
+        if(isBatched) {
+            std::ofstream ofsCodeB(outputFolder + "/batcher.h", std::ios::binary);
+            generateBatcherCode(ofsCodeB, batchSizes);
+            generateBatchedMainCode(ofsCodeM, batchSizes, inputFrameSize, outputFrameSize);
+        }
+        else {
+            generateMainCode(ofsCodeM);
+        }
     }
 
     return 0;
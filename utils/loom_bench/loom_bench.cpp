@@ -0,0 +1,903 @@
+/*
+Copyright (c) 2017 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+#include "live_stitch_api.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <map>
+
+#if _WIN32
+#include <windows.h>
+#undef min
+#undef max
+#else
+#include <chrono>
+#include <strings.h>
+#define _stricmp  strcasecmp
+#endif
+
+//! \brief The maximum number of attributes set by a feature toggle.
+#define BENCH_MAX_FEATURE_ATTR 2
+//! \brief The reference images are the outputs downscaled by this factor.
+#define BENCH_REFERENCE_SCALE  8
+//! \brief The flat field check: minimum percentage of output pixels covered by cameras.
+#define BENCH_FLAT_MIN_COVERAGE 25.0
+//! \brief The flat field check: maximum percentage of covered pixels off the camera color (coverage edges).
+#define BENCH_FLAT_MAX_OUTLIERS 2.0
+//! \brief The scene check: maximum percentage of covered pixels off the scene color (coverage edges).
+#define BENCH_SCENE_MAX_OUTLIERS 2.0
+
+//! \brief The feature toggles: LoomSL attributes set on top of the defaults.
+//  A feature with compareWith is also run with that feature on the same rig and both outputs are compared with PSNR:
+//  used for variants of a kernel that should give almost the same output (e.g., coarse-to-fine seam path search).
+typedef struct {
+	const char * name;
+	vx_uint32    attrCount;
+	struct { vx_uint32 offset; vx_float32 value; } attr[BENCH_MAX_FEATURE_ATTR];
+	const char * compareWith;
+} BenchFeature;
+
+static const BenchFeature benchFeatures[] = {
+	{ "base",        0, { } },
+	{ "expcomp1",    1, { { LIVE_STITCH_ATTR_EXPCOMP, 1 } } },
+	{ "expcomp2",    1, { { LIVE_STITCH_ATTR_EXPCOMP, 2 } } },
+	{ "expcomp3",    1, { { LIVE_STITCH_ATTR_EXPCOMP, 3 } } },
+	{ "expcomp4",    1, { { LIVE_STITCH_ATTR_EXPCOMP, 4 } } },
+	{ "seamfind",    1, { { LIVE_STITCH_ATTR_SEAMFIND, 1 } } },
+	{ "seamcoarse",  2, { { LIVE_STITCH_ATTR_SEAMFIND, 1 }, { LIVE_STITCH_ATTR_SEAM_COARSE_SCALE, 4 } }, "seamfind" },
+	{ "multiband2",  2, { { LIVE_STITCH_ATTR_MULTIBAND, 1 }, { LIVE_STITCH_ATTR_MULTIBAND_NUMBANDS, 2 } } },
+	{ "multiband4",  2, { { LIVE_STITCH_ATTR_MULTIBAND, 1 }, { LIVE_STITCH_ATTR_MULTIBAND_NUMBANDS, 4 } } },
+	{ "multiband6",  2, { { LIVE_STITCH_ATTR_MULTIBAND, 1 }, { LIVE_STITCH_ATTR_MULTIBAND_NUMBANDS, 6 } } },
+	{ "noisefilter", 1, { { LIVE_STITCH_ATTR_NOISE_FILTER, 1 } } },
+	{ "chromakey",   1, { { LIVE_STITCH_ATTR_CHROMA_KEY, 1 } } },
+};
+
+//! \brief The camera color of flat field rigs (RGB): far from the default chroma key color.
+static const vx_uint8 benchFlatColor[3] = { 160, 112, 80 };
+
+//! \brief Pi for the synthetic scene directions.
+static const double benchPi = 3.14159265358979323846;
+
+//! \brief The names of LIVE_STITCH_PERF_STAGE_* in the timing records.
+static const char * benchStageNames[LIVE_STITCH_PERF_STAGE_COUNT] = {
+	"frame", "input", "warp", "expcomp", "seamfind", "blend", "overlay", "output"
+};
+
+//! \brief The benchmark options.
+typedef struct {
+	bool useGpu;                            // OpenCL buffers instead of host execution
+	bool verbose;                           // show LoomSL log messages
+	bool updateGolden;                      // record checksums and reference images instead of comparing
+	bool flatField;                         // uniform camera images: check output against the camera color
+	vx_int32 flatTolerance;                 // maximum difference of a flat field output pixel from the camera color
+	bool sceneField;                        // camera images of a synthetic scene: check output against the scene color
+	vx_int32 sceneTolerance;                // maximum difference of a scene output pixel from the scene color
+	double minPsnr;                         // minimum PSNR (dB) of an output against its reference image
+	double minComparePsnr;                  // minimum PSNR (dB) of an output against the output of its compareWith feature
+	bool crossCheck;                        // with useGpu: run each case again on the CPU and compare the outputs
+	double minCrossPsnr;                    // minimum PSNR (dB) of an OpenCL output against the CPU output
+	vx_uint32 frameCount;                   // frames processed per case
+	std::vector<vx_uint32> cameraCounts;    // synthetic rig sizes
+	std::vector<vx_uint32> lensTypes;       // camera_lens_type of all cameras in the rig
+	std::vector<vx_uint32> outputWidths;    // equirectangular output widths
+	std::vector<const BenchFeature *> features;
+	std::string goldenFile;                 // checksums: one "case checksum" per line
+	std::string referenceDir;               // reference images: one downscaled PPM per case
+	std::string jsonFile;                   // timing records: one JSON object per case per line
+} BenchOptions;
+
+//! \brief The result of a benchmark case.
+typedef struct {
+	std::string name;
+	std::string status;                     // pass, fail, new, updated, or error
+	std::string checksum;
+	std::string detail;                     // result of the flat field or reference image check
+	std::vector<vx_uint8> output;           // output image of the last frame
+	double initMsec;
+	double frameMsecMin, frameMsecAvg, frameMsecMax;
+	ls_perf_info stages[LIVE_STITCH_PERF_STAGE_COUNT];
+} BenchResult;
+
+static bool g_verbose = false;
+
+static void Message(const char * format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	vprintf(format, args);
+	va_end(args);
+	fflush(stdout);
+}
+
+static vx_status Error(const char * format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	vprintf(format, args);
+	va_end(args);
+	printf("\n");
+	fflush(stdout);
+	return VX_FAILURE;
+}
+
+static void log_callback(const char * message)
+{
+	if (g_verbose) {
+		printf("%s", message);
+		fflush(stdout);
+	}
+}
+
+static int64_t GetClockCounter()
+{
+#if _WIN32
+	LARGE_INTEGER v;
+	QueryPerformanceCounter(&v);
+	return v.QuadPart;
+#else
+	return std::chrono::high_resolution_clock::now().time_since_epoch().count();
+#endif
+}
+
+static int64_t GetClockFrequency()
+{
+#if _WIN32
+	LARGE_INTEGER v;
+	QueryPerformanceFrequency(&v);
+	return v.QuadPart;
+#else
+	return std::chrono::high_resolution_clock::period::den / std::chrono::high_resolution_clock::period::num;
+#endif
+}
+
+//! \brief Parse comma separated list of unsigned integers: "4k" and "8k" are output widths.
+static bool ParseList(const char * text, std::vector<vx_uint32>& list)
+{
+	list.clear();
+	for (const char * s = text; *s; ) {
+		char item[64] = { 0 };
+		size_t len = strcspn(s, ",");
+		if (len == 0 || len >= sizeof(item)) return false;
+		strncpy(item, s, len);
+		if (!_stricmp(item, "4k")) list.push_back(3840);
+		else if (!_stricmp(item, "8k")) list.push_back(7680);
+		else {
+			char * end = nullptr;
+			unsigned long value = strtoul(item, &end, 0);
+			if (*end) return false;
+			list.push_back((vx_uint32)value);
+		}
+		s += len;
+		if (*s == ',') s++;
+	}
+	return list.size() > 0;
+}
+
+//! \brief Feature toggle with the name, or nullptr.
+static const BenchFeature * FindFeature(const char * name, size_t len)
+{
+	for (size_t i = 0; i < sizeof(benchFeatures) / sizeof(benchFeatures[0]); i++) {
+		if (strlen(benchFeatures[i].name) == len && !strncmp(benchFeatures[i].name, name, len))
+			return &benchFeatures[i];
+	}
+	return nullptr;
+}
+
+//! \brief Parse comma separated list of feature names or "all".
+static bool ParseFeatures(const char * text, std::vector<const BenchFeature *>& list)
+{
+	list.clear();
+	if (!_stricmp(text, "all")) {
+		for (size_t i = 0; i < sizeof(benchFeatures) / sizeof(benchFeatures[0]); i++)
+			list.push_back(&benchFeatures[i]);
+		return true;
+	}
+	for (const char * s = text; *s; ) {
+		size_t len = strcspn(s, ",");
+		const BenchFeature * feature = FindFeature(s, len);
+		if (!feature) return false;
+		list.push_back(feature);
+		s += len;
+		if (*s == ',') s++;
+	}
+	return list.size() > 0;
+}
+
+//! \brief Camera parameters of a synthetic rig: one ring of cameras up to 4, two rings at +/-30 degrees pitch above that.
+static void GetSyntheticCameraParams(vx_uint32 numCamera, vx_uint32 camIndex, camera_lens_type lensType, vx_uint32 camWidth, vx_uint32 camHeight, camera_params * par)
+{
+	memset(par, 0, sizeof(camera_params));
+	vx_uint32 ringSize = (numCamera > 4) ? numCamera / 2 : numCamera;
+	vx_uint32 ring = camIndex / ringSize, ringIndex = camIndex % ringSize;
+	par->focal.yaw = -180.0f + (360.0f * ringIndex + 180.0f * (ring + 1)) / ringSize;
+	par->focal.pitch = (numCamera > 4) ? (ring ? -30.0f : 30.0f) : 0.0f;
+	vx_float32 overlapFov = 1.5f * 360.0f / ringSize;
+	par->lens.lens_type = lensType;
+	par->lens.haw = (vx_float32)camWidth;
+	if (lensType == ptgui_lens_rectilinear || lensType == adobe_lens_rectilinear) {
+		par->lens.hfov = std::min(overlapFov, 120.0f);
+	}
+	else if (lensType == ptgui_lens_fisheye_circ) {
+		par->lens.hfov = std::max(std::min(overlapFov, 200.0f), 150.0f);
+		par->lens.haw = (vx_float32)camHeight;
+		par->lens.r_crop = camHeight * 0.5f;
+	}
+	else {
+		par->lens.hfov = std::max(std::min(overlapFov, 200.0f), 120.0f);
+	}
+}
+
+//! \brief Deterministic camera images: gradients with 32x32 texture blocks that move with frame number.
+static void FillSyntheticCameraBuffer(vx_uint8 * buf, vx_uint32 stride, vx_uint32 numRows, vx_uint32 numColumns, vx_uint32 camWidth, vx_uint32 camHeight, vx_uint32 frame)
+{
+	for (vx_uint32 y = 0; y < numRows * camHeight; y++) {
+		vx_uint8 * row = buf + y * stride;
+		vx_uint32 cy = y % camHeight;
+		for (vx_uint32 x = 0; x < numColumns * camWidth; x++) {
+			vx_uint32 cam = (y / camHeight) * numColumns + x / camWidth, cx = x % camWidth;
+			vx_uint32 block = (((cx + frame * 4) >> 5) ^ (cy >> 5)) & 1;
+			row[x * 3 + 0] = (vx_uint8)((cx * 255 / camWidth + cam * 37) & 0xff);
+			row[x * 3 + 1] = (vx_uint8)((cy * 255 / camHeight + cam * 53) & 0xff);
+			row[x * 3 + 2] = (vx_uint8)(block ? 200 - cam * 5 : 40 + cam * 5);
+		}
+	}
+}
+
+//! \brief Uniform camera images: every stitched pixel covered by a camera should get the same color.
+static void FillFlatCameraBuffer(vx_uint8 * buf, size_t size)
+{
+	for (size_t i = 0; i < size; i += 3) {
+		buf[i + 0] = benchFlatColor[0];
+		buf[i + 1] = benchFlatColor[1];
+		buf[i + 2] = benchFlatColor[2];
+	}
+}
+
+//! \brief Color of the synthetic scene in direction X (unit vector of the equirectangular output frame): a gradient of
+//  the direction with a low frequency texture. The colors stay away from black (uncovered output pixels) and from
+//  the default chroma key color.
+static void GetSceneColor(const double * X, vx_uint8 * rgb)
+{
+	double t = sin(32.0 * X[0]) * sin(32.0 * X[1]) * sin(32.0 * X[2]);
+	rgb[0] = (vx_uint8)(128.5 + 80.0 * X[0] + 40.0 * t);
+	rgb[1] = (vx_uint8)(120.5 + 80.0 * X[1]);
+	rgb[2] = (vx_uint8)(128.5 + 80.0 * X[2] - 40.0 * t);
+}
+
+//! \brief Camera images of the synthetic scene: every camera pixel gets the scene color of its viewing direction.
+//  This is the inverse of the LoomSL warp (CalculateCameraWarpParameters and the lens models without distortion) for
+//  the rig of GetSyntheticCameraParams, so every stitched pixel is known whatever camera, seam or blend covers it.
+static void FillSceneCameraBuffer(vx_uint8 * buf, vx_uint32 stride, vx_uint32 numRows, vx_uint32 numColumns, vx_uint32 camWidth, vx_uint32 camHeight, camera_lens_type lensType)
+{
+	const double deg2rad = benchPi / 180.0;
+	vx_uint32 numCamera = numRows * numColumns;
+	for (vx_uint32 cam = 0; cam < numCamera; cam++) {
+		camera_params par;
+		GetSyntheticCameraParams(numCamera, cam, lensType, camWidth, camHeight, &par);
+		// camera rotation M of the warp maps output direction X to camera direction Y = M * X (the rig isn't rotated)
+		double th = par.focal.yaw * deg2rad, fi = par.focal.pitch * deg2rad, sy = par.focal.roll * deg2rad;
+		double sth = sin(th), cth = cos(th), sfi = sin(fi), cfi = cos(fi), ssy = sin(sy), csy = cos(sy);
+		double M[9] = {
+			sth*ssy*sfi + cth*csy, ssy*cfi, cth*ssy*sfi - sth*csy,
+			sth*csy*sfi - cth*ssy, csy*cfi, cth*csy*sfi + sth*ssy,
+			sth*cfi,               -sfi,    cth*cfi
+		};
+		bool rectilinear = (lensType == ptgui_lens_rectilinear || lensType == adobe_lens_rectilinear);
+		double halfFov = 0.5 * par.lens.hfov * deg2rad, halfWidth = 0.5 * par.lens.haw;
+		vx_uint8 * camBuf = buf + (cam / numColumns) * camHeight * stride + (cam % numColumns) * camWidth * 3;
+		for (vx_uint32 y = 0; y < camHeight; y++) {
+			for (vx_uint32 x = 0; x < camWidth; x++) {
+				// angle from the optical axis: radius is tan(angle) for rectilinear and angle for fisheye lenses
+				double dx = x - 0.5 * camWidth, dy = y - 0.5 * camHeight;
+				double r = sqrt(dx * dx + dy * dy) / halfWidth;
+				double angle = rectilinear ? atan(r * tan(halfFov)) : r * halfFov;
+				double ph = atan2(dy, dx);
+				double Y[3] = { sin(angle) * cos(ph), sin(angle) * sin(ph), cos(angle) };
+				double X[3] = {
+					M[0] * Y[0] + M[3] * Y[1] + M[6] * Y[2],
+					M[1] * Y[0] + M[4] * Y[1] + M[7] * Y[2],
+					M[2] * Y[0] + M[5] * Y[1] + M[8] * Y[2]
+				};
+				GetSceneColor(X, camBuf + y * stride + x * 3);
+			}
+		}
+	}
+}
+
+//! \brief FNV-1a 64-bit checksum of the image rows.
+static std::string ImageChecksum(const vx_uint8 * buf, vx_uint32 stride, vx_uint32 rowBytes, vx_uint32 height)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (vx_uint32 y = 0; y < height; y++) {
+		const vx_uint8 * row = buf + y * stride;
+		for (vx_uint32 x = 0; x < rowBytes; x++) {
+			hash ^= row[x];
+			hash *= 1099511628211ull;
+		}
+	}
+	char text[32];
+	sprintf(text, "%016llx", (unsigned long long)hash);
+	return text;
+}
+
+//! \brief OpenCL buffers for the stitch when host execution is not used.
+typedef struct {
+	cl_command_queue cmdq;
+	cl_mem input, output, chromaKey;
+} BenchOpenCLBuffers;
+
+static vx_status CreateOpenCLBuffers(ls_context stitch, size_t inputSize, size_t outputSize, bool chromaKey, BenchOpenCLBuffers& cl)
+{
+	cl_context opencl_context = nullptr;
+	vx_status status = lsGetOpenCLContext(stitch, &opencl_context);
+	if (status) return Error("ERROR: lsGetOpenCLContext() failed (%d)", status);
+	cl_device_id device_id = nullptr;
+	cl_int err = clGetContextInfo(opencl_context, CL_CONTEXT_DEVICES, sizeof(device_id), &device_id, nullptr);
+	if (err) return Error("ERROR: clGetContextInfo(*,CL_CONTEXT_DEVICES) failed (%d)", err);
+	cl.cmdq = clCreateCommandQueue(opencl_context, device_id, 0, &err);
+	if (!cl.cmdq) return Error("ERROR: clCreateCommandQueue() failed (%d)", err);
+	cl.input = clCreateBuffer(opencl_context, CL_MEM_READ_WRITE, inputSize, nullptr, &err);
+	if (!cl.input) return Error("ERROR: clCreateBuffer(...,%d,...) failed (%d)", (int)inputSize, err);
+	cl.output = clCreateBuffer(opencl_context, CL_MEM_READ_WRITE, outputSize, nullptr, &err);
+	if (!cl.output) return Error("ERROR: clCreateBuffer(...,%d,...) failed (%d)", (int)outputSize, err);
+	if (chromaKey) {
+		cl.chromaKey = clCreateBuffer(opencl_context, CL_MEM_READ_WRITE, outputSize, nullptr, &err);
+		if (!cl.chromaKey) return Error("ERROR: clCreateBuffer(...,%d,...) failed (%d)", (int)outputSize, err);
+	}
+	return VX_SUCCESS;
+}
+
+static void ReleaseOpenCLBuffers(BenchOpenCLBuffers& cl)
+{
+	if (cl.input) clReleaseMemObject(cl.input);
+	if (cl.output) clReleaseMemObject(cl.output);
+	if (cl.chromaKey) clReleaseMemObject(cl.chromaKey);
+	if (cl.cmdq) clReleaseCommandQueue(cl.cmdq);
+	memset(&cl, 0, sizeof(cl));
+}
+
+//! \brief Initialize a stitch context for the case, process the frames, and collect timings and output checksum.
+static vx_status RunCase(const BenchOptions& opt, const vx_float32 * defaultAttr, vx_uint32 numCamera, vx_uint32 lensType, vx_uint32 outputWidth, const BenchFeature * feature, BenchResult& result)
+{
+	// global attributes: defaults, profiler for per stage timings, and feature toggles
+	std::vector<vx_float32> attr(defaultAttr, defaultAttr + LIVE_STITCH_ATTR_MAX_COUNT);
+	attr[LIVE_STITCH_ATTR_PROFILER] = 1.0f;
+	attr[LIVE_STITCH_ATTR_HOST_EXECUTION] = opt.useGpu ? 0.0f : 1.0f;
+	for (vx_uint32 i = 0; i < feature->attrCount; i++) {
+		attr[feature->attr[i].offset] = feature->attr[i].value;
+	}
+	vx_status status = lsGlobalSetAttributes(0, LIVE_STITCH_ATTR_MAX_COUNT, attr.data());
+	if (status) return Error("ERROR: lsGlobalSetAttributes() failed (%d)", status);
+
+	// synthetic rig: up to 4 camera columns, cameras at 1/4 of output width with 4:3 aspect ratio
+	vx_uint32 outputHeight = outputWidth / 2;
+	vx_uint32 camWidth = outputWidth / 4, camHeight = (camWidth * 3 / 4) & ~7u;
+	vx_uint32 numColumns = std::min(numCamera, 4u);
+	while (numCamera % numColumns) numColumns--;
+	vx_uint32 numRows = numCamera / numColumns;
+	vx_uint32 inputStride = numColumns * camWidth * 3, outputStride = outputWidth * 3;
+	size_t inputSize = (size_t)inputStride * numRows * camHeight, outputSize = (size_t)outputStride * outputHeight;
+	ls_context stitch = lsCreateContext();
+	if (!stitch) return Error("ERROR: lsCreateContext() failed");
+	BenchOpenCLBuffers cl = { 0 };
+	std::vector<vx_uint8> input(inputSize), output(outputSize), chromaKeyInput;
+	double clk2msec = 1000.0 / GetClockFrequency();
+	bool chromaKey = attr[LIVE_STITCH_ATTR_CHROMA_KEY] != 0.0f;
+	rig_params rig = { 0.0f, 0.0f, 0.0f, 0.0f };
+	if ((status = lsSetOutputConfig(stitch, VX_DF_IMAGE_RGB, outputWidth, outputHeight)) != VX_SUCCESS ||
+		(status = lsSetCameraConfig(stitch, numRows, numColumns, VX_DF_IMAGE_RGB, numColumns * camWidth, numRows * camHeight)) != VX_SUCCESS ||
+		(status = lsSetRigParams(stitch, &rig)) != VX_SUCCESS)
+	{
+		Error("ERROR: %s: stitch configuration failed (%d)", result.name.c_str(), status);
+	}
+	for (vx_uint32 i = 0; !status && i < numCamera; i++) {
+		camera_params par;
+		GetSyntheticCameraParams(numCamera, i, (camera_lens_type)lensType, camWidth, camHeight, &par);
+		if ((status = lsSetCameraParams(stitch, i, &par)) != VX_SUCCESS)
+			Error("ERROR: %s: lsSetCameraParams(%d) failed (%d)", result.name.c_str(), i, status);
+	}
+	if (!status) {
+		int64_t clk = GetClockCounter();
+		status = lsInitialize(stitch);
+		result.initMsec = clk2msec * (GetClockCounter() - clk);
+		if (status) Error("ERROR: %s: lsInitialize() failed (%d)", result.name.c_str(), status);
+	}
+	if (!status) {
+		if (opt.useGpu) {
+			if ((status = CreateOpenCLBuffers(stitch, inputSize, outputSize, chromaKey, cl)) == VX_SUCCESS) {
+				if ((status = lsSetCameraBuffer(stitch, &cl.input)) != VX_SUCCESS ||
+					(status = lsSetOutputBuffer(stitch, &cl.output)) != VX_SUCCESS ||
+					(chromaKey && (status = lsSetChromaKeyBuffer(stitch, &cl.chromaKey)) != VX_SUCCESS))
+				{
+					Error("ERROR: %s: setting OpenCL buffers failed (%d)", result.name.c_str(), status);
+				}
+				else if (chromaKey) {
+					// uniform key color everywhere: exercises the chroma key kernels on every pixel
+					std::vector<vx_uint8> key(outputSize, 0x80);
+					status = clEnqueueWriteBuffer(cl.cmdq, cl.chromaKey, CL_TRUE, 0, outputSize, key.data(), 0, nullptr, nullptr);
+				}
+			}
+		}
+		else {
+			if (chromaKey) {
+				// uniform key color everywhere: exercises the chroma key kernels on every pixel
+				chromaKeyInput.assign(outputSize, 0x80);
+			}
+			void * inputPtr = input.data(), * outputPtr = output.data(), * chromaKeyPtr = chromaKeyInput.data();
+			if ((status = lsSetCameraBufferHost(stitch, &inputPtr)) != VX_SUCCESS ||
+				(status = lsSetOutputBufferHost(stitch, &outputPtr)) != VX_SUCCESS ||
+				(chromaKey && (status = lsSetChromaKeyBufferHost(stitch, &chromaKeyPtr)) != VX_SUCCESS))
+			{
+				Error("ERROR: %s: setting host buffers failed (%d)", result.name.c_str(), status);
+			}
+		}
+	}
+
+	// process frames: wall clock time of each frame excludes filling camera buffers
+	double msecSum = 0;
+	for (vx_uint32 frame = 0; !status && frame < opt.frameCount; frame++) {
+		if (opt.flatField)
+			FillFlatCameraBuffer(input.data(), inputSize);
+		else if (opt.sceneField)
+			FillSceneCameraBuffer(input.data(), inputStride, numRows, numColumns, camWidth, camHeight, (camera_lens_type)lensType);
+		else
+			FillSyntheticCameraBuffer(input.data(), inputStride, numRows, numColumns, camWidth, camHeight, frame);
+		if (opt.useGpu && (status = clEnqueueWriteBuffer(cl.cmdq, cl.input, CL_TRUE, 0, inputSize, input.data(), 0, nullptr, nullptr)) != CL_SUCCESS) {
+			Error("ERROR: %s: clEnqueueWriteBuffer() failed (%d)", result.name.c_str(), status);
+			break;
+		}
+		int64_t clk = GetClockCounter();
+		if ((status = lsScheduleFrame(stitch)) != VX_SUCCESS) {
+			Error("ERROR: %s: lsScheduleFrame() failed (%d) @frame:%d", result.name.c_str(), status, frame);
+			break;
+		}
+		if ((status = lsWaitForCompletion(stitch)) != VX_SUCCESS) {
+			Error("ERROR: %s: lsWaitForCompletion() failed (%d) @frame:%d", result.name.c_str(), status, frame);
+			break;
+		}
+		double msec = clk2msec * (GetClockCounter() - clk);
+		result.frameMsecMin = (frame == 0) ? msec : std::min(result.frameMsecMin, msec);
+		result.frameMsecMax = (frame == 0) ? msec : std::max(result.frameMsecMax, msec);
+		msecSum += msec;
+	}
+	if (!status && opt.frameCount > 0) {
+		result.frameMsecAvg = msecSum / opt.frameCount;
+		if ((status = lsGetPerformance(stitch, result.stages, nullptr, nullptr)) != VX_SUCCESS)
+			Error("ERROR: %s: lsGetPerformance() failed (%d)", result.name.c_str(), status);
+		if (!status && opt.useGpu && (status = clEnqueueReadBuffer(cl.cmdq, cl.output, CL_TRUE, 0, outputSize, output.data(), 0, nullptr, nullptr)) != CL_SUCCESS)
+			Error("ERROR: %s: clEnqueueReadBuffer() failed (%d)", result.name.c_str(), status);
+		if (!status) {
+			result.checksum = ImageChecksum(output.data(), outputStride, outputWidth * 3, outputHeight);
+			result.output.swap(output);
+		}
+	}
+
+	// release buffers before the context
+	if (opt.useGpu) {
+		lsSetCameraBuffer(stitch, nullptr);
+		lsSetOutputBuffer(stitch, nullptr);
+		if (chromaKey) lsSetChromaKeyBuffer(stitch, nullptr);
+		ReleaseOpenCLBuffers(cl);
+	}
+	else {
+		lsSetCameraBufferHost(stitch, nullptr);
+		lsSetOutputBufferHost(stitch, nullptr);
+		if (chromaKey) lsSetChromaKeyBufferHost(stitch, nullptr);
+	}
+	lsReleaseContext(&stitch);
+	return status;
+}
+
+static bool LoadGoldenFile(const std::string& fileName, std::map<std::string, std::string>& golden)
+{
+	FILE * fp = fopen(fileName.c_str(), "r");
+	if (!fp) return false;
+	char line[512];
+	while (fgets(line, sizeof(line), fp)) {
+		char name[256], checksum[64];
+		if (line[0] != '#' && sscanf(line, "%255s %63s", name, checksum) == 2)
+			golden[name] = checksum;
+	}
+	fclose(fp);
+	return true;
+}
+
+static bool SaveGoldenFile(const std::string& fileName, const std::map<std::string, std::string>& golden)
+{
+	FILE * fp = fopen(fileName.c_str(), "w");
+	if (!fp) return false;
+	fprintf(fp, "# loom_bench golden output checksums: <case> <fnv1a-64>\n");
+	for (auto it = golden.begin(); it != golden.end(); it++)
+		fprintf(fp, "%s %s\n", it->first.c_str(), it->second.c_str());
+	fclose(fp);
+	return true;
+}
+
+//! \brief Check the output of a flat field rig: pixels covered by cameras should have the camera color within the tolerance.
+static bool CheckFlatField(const BenchOptions& opt, const std::vector<vx_uint8>& output, std::string& detail)
+{
+	size_t numPixels = output.size() / 3, covered = 0, outliers = 0;
+	for (size_t i = 0; i < output.size(); i += 3) {
+		const vx_uint8 * pix = &output[i];
+		if (std::max(pix[0], std::max(pix[1], pix[2])) <= opt.flatTolerance)
+			continue; // not covered by any camera
+		covered++;
+		for (int c = 0; c < 3; c++) {
+			if (abs((vx_int32)pix[c] - (vx_int32)benchFlatColor[c]) > opt.flatTolerance) {
+				outliers++;
+				break;
+			}
+		}
+	}
+	double coverage = numPixels ? 100.0 * covered / numPixels : 0.0;
+	double outlierRatio = covered ? 100.0 * outliers / covered : 100.0;
+	char text[128];
+	sprintf(text, "flat:%.1f%%covered,%.2f%%outliers", coverage, outlierRatio);
+	detail = text;
+	return coverage >= BENCH_FLAT_MIN_COVERAGE && outlierRatio <= BENCH_FLAT_MAX_OUTLIERS;
+}
+
+//! \brief Compare the output with the synthetic scene: a covered output pixel off the scene color of its direction
+//  means a broken warp, a wrong camera index or a seam that picks a camera not covering the pixel.
+static bool CheckScene(const BenchOptions& opt, const std::vector<vx_uint8>& output, vx_uint32 outputWidth, std::string& detail)
+{
+	vx_uint32 outputHeight = outputWidth / 2;
+	size_t numPixels = output.size() / 3, covered = 0, outliers = 0;
+	for (vx_uint32 y = 0; y < outputHeight && numPixels; y++) {
+		// output direction of the equirectangular pixel as in the LoomSL warp
+		double pe = y * benchPi / outputHeight - 0.5 * benchPi;
+		for (vx_uint32 x = 0; x < outputWidth; x++) {
+			const vx_uint8 * pix = &output[((size_t)y * outputWidth + x) * 3];
+			if (std::max(pix[0], std::max(pix[1], pix[2])) <= opt.sceneTolerance)
+				continue; // not covered by any camera
+			covered++;
+			double te = x * benchPi / outputHeight - benchPi;
+			double X[3] = { sin(te) * cos(pe), sin(pe), cos(te) * cos(pe) };
+			vx_uint8 color[3];
+			GetSceneColor(X, color);
+			for (int c = 0; c < 3; c++) {
+				if (abs((vx_int32)pix[c] - (vx_int32)color[c]) > opt.sceneTolerance) {
+					outliers++;
+					break;
+				}
+			}
+		}
+	}
+	double coverage = numPixels ? 100.0 * covered / numPixels : 0.0;
+	double outlierRatio = covered ? 100.0 * outliers / covered : 100.0;
+	char text[128];
+	sprintf(text, "scene:%.1f%%covered,%.2f%%outliers", coverage, outlierRatio);
+	detail = text;
+	return coverage >= BENCH_FLAT_MIN_COVERAGE && outlierRatio <= BENCH_SCENE_MAX_OUTLIERS;
+}
+
+//! \brief Box filter downscale of the output by BENCH_REFERENCE_SCALE: small enough to commit as reference images.
+static void DownscaleImage(const std::vector<vx_uint8>& output, vx_uint32 width, vx_uint32 height, std::vector<vx_uint8>& image)
+{
+	vx_uint32 scaledWidth = width / BENCH_REFERENCE_SCALE, scaledHeight = height / BENCH_REFERENCE_SCALE;
+	image.resize((size_t)scaledWidth * scaledHeight * 3);
+	for (vx_uint32 y = 0; y < scaledHeight; y++) {
+		for (vx_uint32 x = 0; x < scaledWidth; x++) {
+			for (vx_uint32 c = 0; c < 3; c++) {
+				vx_uint32 sum = 0;
+				for (vx_uint32 j = 0; j < BENCH_REFERENCE_SCALE; j++) {
+					const vx_uint8 * row = &output[((size_t)(y * BENCH_REFERENCE_SCALE + j) * width + x * BENCH_REFERENCE_SCALE) * 3 + c];
+					for (vx_uint32 i = 0; i < BENCH_REFERENCE_SCALE; i++)
+						sum += row[i * 3];
+				}
+				image[((size_t)y * scaledWidth + x) * 3 + c] = (vx_uint8)((sum + BENCH_REFERENCE_SCALE * BENCH_REFERENCE_SCALE / 2) / (BENCH_REFERENCE_SCALE * BENCH_REFERENCE_SCALE));
+			}
+		}
+	}
+}
+
+static bool LoadPPM(const std::string& fileName, vx_uint32 width, vx_uint32 height, std::vector<vx_uint8>& image)
+{
+	FILE * fp = fopen(fileName.c_str(), "rb");
+	if (!fp) return false;
+	int w = 0, h = 0, maxval = 0;
+	bool ok = (fscanf(fp, "P6 %d %d %d", &w, &h, &maxval) == 3) && (fgetc(fp) != EOF) && (w == (int)width) && (h == (int)height) && (maxval == 255);
+	image.resize((size_t)width * height * 3);
+	ok = ok && (fread(image.data(), 1, image.size(), fp) == image.size());
+	fclose(fp);
+	return ok;
+}
+
+static bool SavePPM(const std::string& fileName, vx_uint32 width, vx_uint32 height, const std::vector<vx_uint8>& image)
+{
+	FILE * fp = fopen(fileName.c_str(), "wb");
+	if (!fp) return false;
+	fprintf(fp, "P6\n%d %d\n255\n", width, height);
+	bool ok = (fwrite(image.data(), 1, image.size(), fp) == image.size());
+	fclose(fp);
+	return ok;
+}
+
+//! \brief PSNR in dB of two images of the same size: identical images are reported as 99 dB.
+static double ComputePSNR(const std::vector<vx_uint8>& a, const std::vector<vx_uint8>& b)
+{
+	double sqrSum = 0;
+	for (size_t i = 0; i < a.size(); i++) {
+		double diff = (double)a[i] - (double)b[i];
+		sqrSum += diff * diff;
+	}
+	if (sqrSum == 0 || a.empty()) return 99.0;
+	return std::min(99.0, 10.0 * log10(255.0 * 255.0 * a.size() / sqrSum));
+}
+
+//! \brief Reference image file of a case: the case name with '/' replaced by '_'.
+static std::string GetReferenceFileName(const BenchOptions& opt, const std::string& caseName)
+{
+	std::string name = caseName;
+	std::replace(name.begin(), name.end(), '/', '_');
+	return opt.referenceDir + "/" + name + ".ppm";
+}
+
+//! \brief Compare the output with the reference image of the case, or record the reference image with -update.
+static const char * CheckReference(const BenchOptions& opt, vx_uint32 outputWidth, BenchResult& result)
+{
+	std::vector<vx_uint8> image, reference;
+	vx_uint32 scaledWidth = outputWidth / BENCH_REFERENCE_SCALE, scaledHeight = outputWidth / 2 / BENCH_REFERENCE_SCALE;
+	DownscaleImage(result.output, outputWidth, outputWidth / 2, image);
+	std::string fileName = GetReferenceFileName(opt, result.name);
+	bool found = LoadPPM(fileName, scaledWidth, scaledHeight, reference);
+	double psnr = found ? ComputePSNR(image, reference) : 0.0;
+	char text[64];
+	sprintf(text, found ? "psnr:%.2fdB" : "psnr:missing", psnr);
+	result.detail = text;
+	if (opt.updateGolden) {
+		if (found && psnr >= opt.minPsnr) return "pass";
+		if (!SavePPM(fileName, scaledWidth, scaledHeight, image)) {
+			Error("ERROR: unable to write reference image: %s", fileName.c_str());
+			return "error";
+		}
+		return found ? "updated" : "new";
+	}
+	return (found && psnr >= opt.minPsnr) ? "pass" : "fail";
+}
+
+//! \brief Compare the output with the output of the compareWith feature on the same rig and execution path.
+static const char * CheckCompare(const BenchOptions& opt, const vx_float32 * defaultAttr, vx_uint32 numCamera, vx_uint32 lensType, vx_uint32 outputWidth,
+	const BenchFeature * feature, BenchResult& result)
+{
+	const BenchFeature * other = FindFeature(feature->compareWith, strlen(feature->compareWith));
+	BenchResult otherResult = BenchResult();
+	otherResult.name = result.name + "@" + feature->compareWith;
+	if (!other || RunCase(opt, defaultAttr, numCamera, lensType, outputWidth, other, otherResult) != VX_SUCCESS)
+		return "error";
+	double psnr = ComputePSNR(result.output, otherResult.output);
+	char text[128];
+	sprintf(text, "%s%s:%.2fdB", result.detail.empty() ? "" : ",", feature->compareWith, psnr);
+	result.detail += text;
+	return (psnr >= opt.minComparePsnr) ? "pass" : "fail";
+}
+
+//! \brief Run the case again on the CPU (host execution) and compare the OpenCL output with it: both paths implement
+//  the same kernels, so a low PSNR points at a kernel that differs between them.
+static const char * CheckCrossPath(const BenchOptions& opt, const vx_float32 * defaultAttr, vx_uint32 numCamera, vx_uint32 lensType, vx_uint32 outputWidth,
+	const BenchFeature * feature, BenchResult& result)
+{
+	BenchOptions cpuOpt = opt;
+	cpuOpt.useGpu = false;
+	BenchResult cpuResult = BenchResult();
+	cpuResult.name = result.name + "@cpu";
+	if (RunCase(cpuOpt, defaultAttr, numCamera, lensType, outputWidth, feature, cpuResult) != VX_SUCCESS)
+		return "error";
+	double psnr = ComputePSNR(result.output, cpuResult.output);
+	char text[128];
+	sprintf(text, "%scpu:%.2fdB", result.detail.empty() ? "" : ",", psnr);
+	result.detail += text;
+	return (psnr >= opt.minCrossPsnr) ? "pass" : "fail";
+}
+
+//! \brief Write the result of a case as one line of JSON.
+static void WriteJsonRecord(FILE * fp, const BenchOptions& opt, vx_uint32 numCamera, vx_uint32 lensType, vx_uint32 outputWidth, const BenchFeature * feature, const BenchResult& result)
+{
+	fprintf(fp, "{\"case\":\"%s\",\"path\":\"%s\",\"cameras\":%d,\"lens\":%d,\"output_width\":%d,\"output_height\":%d,\"feature\":\"%s\",\"status\":\"%s\"",
+		result.name.c_str(), opt.useGpu ? "gpu" : "cpu", numCamera, lensType, outputWidth, outputWidth / 2, feature->name, result.status.c_str());
+	if (result.status != "error") {
+		fprintf(fp, ",\"checksum\":\"%s\",\"init_ms\":%.3f,\"frames\":%d,\"frame_ms\":{\"min\":%.3f,\"avg\":%.3f,\"max\":%.3f},\"stages\":{",
+			result.checksum.c_str(), result.initMsec, opt.frameCount, result.frameMsecMin, result.frameMsecAvg, result.frameMsecMax);
+		for (vx_uint32 stage = 0; stage < LIVE_STITCH_PERF_STAGE_COUNT; stage++) {
+			const ls_perf_info& info = result.stages[stage];
+			fprintf(fp, "%s\"%s\":{\"min_ms\":%.3f,\"avg_ms\":%.3f,\"p99_ms\":%.3f,\"max_ms\":%.3f,\"bytes\":%llu}", stage ? "," : "",
+				benchStageNames[stage], info.min_ms, info.avg_ms, info.p99_ms, info.max_ms, (unsigned long long)info.bytes);
+		}
+		fprintf(fp, "}");
+		if (!result.detail.empty())
+			fprintf(fp, ",\"check\":\"%s\"", result.detail.c_str());
+	}
+	fprintf(fp, "}\n");
+	fflush(fp);
+}
+
+static void ShowUsage()
+{
+	Message("Usage: loom_bench [options]\n");
+	Message("   -cpu                    run stitch on CPU with host buffers (default)\n");
+	Message("   -gpu                    run stitch with OpenCL buffers\n");
+	Message("   -cameras <n,...>        synthetic rig sizes (default: 2,4,8,16)\n");
+	Message("   -lens <n,...>           camera_lens_type of the rig cameras (default: 0,1,2,3,4)\n");
+	Message("   -output <w,...>         output widths, 4k and 8k are 3840 and 7680 (default: 4k,8k)\n");
+	Message("   -features <name,...>    feature toggles or all (default: all):\n");
+	Message("                          ");
+	for (size_t i = 0; i < sizeof(benchFeatures) / sizeof(benchFeatures[0]); i++)
+		Message(" %s", benchFeatures[i].name);
+	Message("\n");
+	Message("   -frames <n>             frames processed per case (default: 8)\n");
+	Message("   -golden <file>          compare output checksums with golden file (exact, same platform only)\n");
+	Message("   -reference <dir>        compare downscaled outputs with reference images in <dir> using PSNR\n");
+	Message("   -psnr <dB>              minimum PSNR against reference images (default: 40)\n");
+	Message("   -cmppsnr <dB>           minimum PSNR of a feature against the feature it is compared with (default: 30)\n");
+	Message("   -crosscheck             with -gpu: run each case again on the CPU and compare the outputs using PSNR\n");
+	Message("   -crosspsnr <dB>         minimum PSNR of the OpenCL output against the CPU output (default: 40)\n");
+	Message("   -update                 record output checksums and reference images instead of comparing\n");
+	Message("   -flat                   uniform camera images: check output pixels against the camera color\n");
+	Message("   -tolerance <n>          maximum difference from the camera color with -flat (default: 4)\n");
+	Message("   -scene                  camera images of a synthetic scene: check output pixels against the scene color\n");
+	Message("   -scenetol <n>           maximum difference from the scene color with -scene (default: 16)\n");
+	Message("   -json <file>            write timings per case and per stage as JSON lines\n");
+	Message("   -v                      show LoomSL log messages\n");
+}
+
+int main(int argc, char * argv[])
+{
+	BenchOptions opt;
+	opt.useGpu = false;
+	opt.verbose = false;
+	opt.updateGolden = false;
+	opt.flatField = false;
+	opt.flatTolerance = 4;
+	opt.sceneField = false;
+	opt.sceneTolerance = 16;
+	opt.minPsnr = 40.0;
+	opt.minComparePsnr = 30.0;
+	opt.crossCheck = false;
+	opt.minCrossPsnr = 40.0;
+	opt.frameCount = 8;
+	ParseList("2,4,8,16", opt.cameraCounts);
+	ParseList("0,1,2,3,4", opt.lensTypes);
+	ParseList("4k,8k", opt.outputWidths);
+	ParseFeatures("all", opt.features);
+	for (int arg = 1; arg < argc; arg++) {
+		bool hasValue = (arg + 1 < argc);
+		if (!_stricmp(argv[arg], "-cpu")) opt.useGpu = false;
+		else if (!_stricmp(argv[arg], "-gpu")) opt.useGpu = true;
+		else if (!_stricmp(argv[arg], "-v")) opt.verbose = true;
+		else if (!_stricmp(argv[arg], "-update")) opt.updateGolden = true;
+		else if (!_stricmp(argv[arg], "-flat")) opt.flatField = true;
+		else if (!_stricmp(argv[arg], "-tolerance") && hasValue) opt.flatTolerance = atoi(argv[++arg]);
+		else if (!_stricmp(argv[arg], "-scene")) opt.sceneField = true;
+		else if (!_stricmp(argv[arg], "-scenetol") && hasValue) opt.sceneTolerance = atoi(argv[++arg]);
+		else if (!_stricmp(argv[arg], "-psnr") && hasValue) opt.minPsnr = atof(argv[++arg]);
+		else if (!_stricmp(argv[arg], "-cmppsnr") && hasValue) opt.minComparePsnr = atof(argv[++arg]);
+		else if (!_stricmp(argv[arg], "-crosscheck")) opt.crossCheck = true;
+		else if (!_stricmp(argv[arg], "-crosspsnr") && hasValue) opt.minCrossPsnr = atof(argv[++arg]);
+		else if (!_stricmp(argv[arg], "-reference") && hasValue) opt.referenceDir = argv[++arg];
+		else if (!_stricmp(argv[arg], "-cameras") && hasValue && ParseList(argv[arg + 1], opt.cameraCounts)) arg++;
+		else if (!_stricmp(argv[arg], "-lens") && hasValue && ParseList(argv[arg + 1], opt.lensTypes)) arg++;
+		else if (!_stricmp(argv[arg], "-output") && hasValue && ParseList(argv[arg + 1], opt.outputWidths)) arg++;
+		else if (!_stricmp(argv[arg], "-features") && hasValue && ParseFeatures(argv[arg + 1], opt.features)) arg++;
+		else if (!_stricmp(argv[arg], "-frames") && hasValue) opt.frameCount = (vx_uint32)atoi(argv[++arg]);
+		else if (!_stricmp(argv[arg], "-golden") && hasValue) opt.goldenFile = argv[++arg];
+		else if (!_stricmp(argv[arg], "-json") && hasValue) opt.jsonFile = argv[++arg];
+		else {
+			ShowUsage();
+			return (!_stricmp(argv[arg], "-help")) ? 0 : 1;
+		}
+	}
+	for (auto it = opt.cameraCounts.begin(); it != opt.cameraCounts.end(); it++) {
+		if (*it < 1 || *it > LIVE_STITCH_MAX_CAMERAS) { Error("ERROR: invalid camera count %d", *it); return 1; }
+	}
+	for (auto it = opt.lensTypes.begin(); it != opt.lensTypes.end(); it++) {
+		if (*it > adobe_lens_fisheye) { Error("ERROR: invalid lens type %d", *it); return 1; }
+	}
+	for (auto it = opt.outputWidths.begin(); it != opt.outputWidths.end(); it++) {
+		if (*it < 64 || (*it % 64) != 0) { Error("ERROR: output width %d should be a multiple of 64", *it); return 1; }
+	}
+	if (opt.updateGolden && opt.goldenFile.empty() && opt.referenceDir.empty()) { Error("ERROR: -update requires -golden <file> or -reference <dir>"); return 1; }
+	if (opt.flatField && (!opt.goldenFile.empty() || !opt.referenceDir.empty())) { Error("ERROR: -flat can't be used with -golden or -reference"); return 1; }
+	if (opt.crossCheck && !opt.useGpu) { Error("ERROR: -crosscheck requires -gpu"); return 1; }
+	if (opt.sceneField && (opt.flatField || !opt.goldenFile.empty() || !opt.referenceDir.empty())) { Error("ERROR: -scene can't be used with -flat, -golden or -reference"); return 1; }
+	g_verbose = opt.verbose;
+	lsGlobalSetLogCallback(log_callback);
+
+	std::map<std::string, std::string> golden;
+	if (!opt.goldenFile.empty() && !LoadGoldenFile(opt.goldenFile, golden) && !opt.updateGolden) {
+		Error("ERROR: unable to read golden file: %s", opt.goldenFile.c_str());
+		return 1;
+	}
+	FILE * fpJson = nullptr;
+	if (!opt.jsonFile.empty() && !(fpJson = fopen(opt.jsonFile.c_str(), "w"))) {
+		Error("ERROR: unable to create %s", opt.jsonFile.c_str());
+		return 1;
+	}
+	vx_float32 defaultAttr[LIVE_STITCH_ATTR_MAX_COUNT] = { 0 };
+	lsGlobalGetAttributes(0, LIVE_STITCH_ATTR_MAX_COUNT, defaultAttr);
+
+	// run all combinations
+	vx_uint32 counts[4] = { 0 }; // pass, fail, new/updated, error
+	Message("%-40s %-8s %10s %10s %10s %10s  %-16s %s\n", "case", "status", "init(ms)", "avg(ms)", "warp(ms)", "blend(ms)", "checksum", "check");
+	for (auto itCam = opt.cameraCounts.begin(); itCam != opt.cameraCounts.end(); itCam++) {
+		for (auto itLens = opt.lensTypes.begin(); itLens != opt.lensTypes.end(); itLens++) {
+			for (auto itOut = opt.outputWidths.begin(); itOut != opt.outputWidths.end(); itOut++) {
+				for (auto itFeature = opt.features.begin(); itFeature != opt.features.end(); itFeature++) {
+					BenchResult result = BenchResult();
+					char name[256];
+					sprintf(name, "%s/cam%d/lens%d/%dx%d/%s", opt.useGpu ? "gpu" : "cpu", *itCam, *itLens, *itOut, *itOut / 2, (*itFeature)->name);
+					result.name = name;
+					if (RunCase(opt, defaultAttr, *itCam, *itLens, *itOut, *itFeature, result) != VX_SUCCESS) {
+						result.status = "error";
+					}
+					else if (opt.flatField) {
+						result.status = CheckFlatField(opt, result.output, result.detail) ? "pass" : "fail";
+					}
+					else if (opt.sceneField) {
+						result.status = CheckScene(opt, result.output, *itOut, result.detail) ? "pass" : "fail";
+					}
+					else {
+						// checksums are exact and only match on the recording platform: with reference images, the PSNR check decides
+						std::string checksumStatus = "new";
+						if (golden.count(result.name))
+							checksumStatus = (golden[result.name] == result.checksum) ? "pass" : (opt.updateGolden ? "updated" : "fail");
+						if (opt.updateGolden && !opt.goldenFile.empty())
+							golden[result.name] = result.checksum;
+						result.status = opt.referenceDir.empty() ? checksumStatus : CheckReference(opt, *itOut, result);
+					}
+					if (result.status != "error" && result.status != "fail" && (*itFeature)->compareWith) {
+						// variants of a kernel should also match the output of the feature they are compared with
+						const char * compareStatus = CheckCompare(opt, defaultAttr, *itCam, *itLens, *itOut, *itFeature, result);
+						if (strcmp(compareStatus, "pass") != 0)
+							result.status = compareStatus;
+					}
+					if (result.status != "error" && result.status != "fail" && opt.crossCheck) {
+						// the OpenCL output should also match the CPU output of the same case
+						const char * crossStatus = CheckCrossPath(opt, defaultAttr, *itCam, *itLens, *itOut, *itFeature, result);
+						if (strcmp(crossStatus, "pass") != 0)
+							result.status = crossStatus;
+					}
+					counts[(result.status == "pass") ? 0 : (result.status == "fail") ? 1 : (result.status == "error") ? 3 : 2]++;
+					Message("%-40s %-8s %10.3f %10.3f %10.3f %10.3f  %-16s %s\n", result.name.c_str(), result.status.c_str(), result.initMsec, result.frameMsecAvg,
+						result.stages[LIVE_STITCH_PERF_STAGE_WARP].avg_ms, result.stages[LIVE_STITCH_PERF_STAGE_BLEND].avg_ms, result.checksum.c_str(), result.detail.c_str());
+					if (fpJson) WriteJsonRecord(fpJson, opt, *itCam, *itLens, *itOut, *itFeature, result);
+				}
+			}
+		}
+	}
+	lsGlobalSetAttributes(0, LIVE_STITCH_ATTR_MAX_COUNT, defaultAttr);
+	if (fpJson) fclose(fpJson);
+	if (opt.updateGolden && !SaveGoldenFile(opt.goldenFile, golden)) {
+		Error("ERROR: unable to write golden file: %s", opt.goldenFile.c_str());
+		return 1;
+	}
+	Message("OK: loom_bench: %d pass, %d fail, %d new/updated, %d error\n", counts[0], counts[1], counts[2], counts[3]);
+	return (counts[1] > 0 || counts[3] > 0) ? 1 : 0;
+}
@@ -106,6 +106,7 @@ void CLoomShellParser::help(bool detailed)
 	Message("        createOpenVXContext(&openvx_context);\n");
 	Message("        lsSetOpenCLContext(context,opencl_context);\n");
 	Message("        lsSetOpenVXContext(context,openvx_context);\n");
+	Message("        lsShareInternalTables(context,table_owner_context);\n");
 	Message("        releaseOpenCLContext(&opencl_context);\n");
 	Message("        releaseOpenVXContext(&openvx_context);\n");
 	Message("    ~ attributes (advanced)\n");
@@ -122,6 +123,7 @@ void CLoomShellParser::help(bool detailed)
 	Message("        loadExpCompGains(context,num_entries,\"gains.txt\");\n");
 	Message("        saveExpCompGains(context,num_entries,\"gains.txt\");\n");
 	Message("        loadBlendWeights(context,\"blend-weights.raw\");\n");
+	Message("        showPerformance(context);\n");
 	Message("    ~ miscellaneous\n");
 	Message("        help\n");
 	Message("        include \"script.lss\"\n");
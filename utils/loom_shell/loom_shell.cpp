@@ -407,6 +407,21 @@ int CLoomShellParser::OnCommand()
 		if (status) return Error("ERROR: lsSetOpenCLContext(%s[%d],%s[%d]) failed (%d)", name_ls, contextIndex, name_cl, clIndex, status);
 		Message("..lsSetOpenCLContext: set OpenCL context %s[%d] for %s[%d]\n", name_cl, clIndex, name_ls, contextIndex);
 	}
+	else if (!_stricmp(command, "lsShareInternalTables")) {
+		// parse the command
+		vx_uint32 contextIndex = 0, ownerIndex = 0;
+		const char * invalidSyntax = "ERROR: invalid syntax: expects: lsShareInternalTables(ls[#],ls[#])";
+		SYNTAX_CHECK(ParseSkip(s, "("));
+		SYNTAX_CHECK(ParseContextWithErrorCheck(s, contextIndex, invalidSyntax));
+		SYNTAX_CHECK(ParseSkip(s, ","));
+		SYNTAX_CHECK(ParseContextWithErrorCheck(s, ownerIndex, invalidSyntax));
+		SYNTAX_CHECK(ParseSkip(s, ")"));
+		SYNTAX_CHECK(ParseEndOfLine(s));
+		// process the command
+		vx_status status = lsShareInternalTables(context_[contextIndex], context_[ownerIndex]);
+		if (status) return Error("ERROR: lsShareInternalTables(%s[%d],%s[%d]) failed (%d)", name_ls, contextIndex, name_ls, ownerIndex, status);
+		Message("..lsShareInternalTables: %s[%d] shares internal tables of %s[%d]\n", name_ls, contextIndex, name_ls, ownerIndex);
+	}
 	else if (!_stricmp(command, "lsSetRigParams")) {
 		// parse the command
 		vx_uint32 contextIndex = 0;
@@ -1668,6 +1683,18 @@ int CLoomShellParser::OnCommand()
 		vx_status status = loadBlendWeights(context_[contextIndex], fileName);
 		if (status) return status;
 	}
+	else if (!_stricmp(command, "showPerformance")) {
+		// parse the command
+		vx_uint32 contextIndex = 0;
+		const char * invalidSyntax = "ERROR: invalid syntax: expects: showPerformance(context);";
+		SYNTAX_CHECK(ParseSkip(s, "("));
+		SYNTAX_CHECK(ParseContextWithErrorCheck(s, contextIndex, invalidSyntax));
+		SYNTAX_CHECK(ParseSkip(s, ")"));
+		SYNTAX_CHECK(ParseEndOfLine(s));
+		// process the command
+		vx_status status = showPerformance(context_[contextIndex]);
+		if (status) return status;
+	}
 	else if (!_stricmp(command, "help")) {
 		Message("..help\n");
 		help(false);
@@ -1042,3 +1042,33 @@ vx_status loadBlendWeights(ls_context stitch, const char * fileName)
 	delete[] buf;
 	return VX_SUCCESS;
 }
+
+vx_status showPerformance(ls_context stitch)
+{
+	std::vector<ls_perf_info> stages(LIVE_STITCH_PERF_STAGE_COUNT);
+	vx_uint32 num_nodes = 0;
+	vx_status status = lsGetPerformance(stitch, stages.data(), nullptr, &num_nodes);
+	if (status) return Error("ERROR: lsGetPerformance: failed (%d)\n", status);
+	std::vector<ls_perf_info> nodes(num_nodes);
+	if (num_nodes > 0) {
+		status = lsGetPerformance(stitch, nullptr, nodes.data(), &num_nodes);
+		if (status) return Error("ERROR: lsGetPerformance: failed (%d)\n", status);
+	}
+	Message("  %-44s %8s %9s %9s %9s %9s %9s %10s\n", "stage/node", "frames", "last(ms)", "min(ms)", "avg(ms)", "p99(ms)", "max(ms)", "MB/frame");
+	for (vx_uint32 stage = 0; stage < LIVE_STITCH_PERF_STAGE_COUNT; stage++) {
+		const ls_perf_info& info = stages[stage];
+		if (stage != LIVE_STITCH_PERF_STAGE_FRAME && info.bytes == 0) continue;
+		Message("  %-44s %8d %9.3f %9.3f %9.3f %9.3f %9.3f %10.2f\n", info.name, (vx_uint32)info.frames, info.last_ms, info.min_ms, info.avg_ms, info.p99_ms, info.max_ms, (float)info.bytes / (1024.0f * 1024.0f));
+		for (vx_uint32 i = 0; i < num_nodes; i++) {
+			const ls_perf_info& node = nodes[i];
+			if (node.stage != stage) continue;
+			Message("    %-42s %8d %9.3f %9.3f %9.3f %9.3f %9.3f %10.2f\n", node.name, (vx_uint32)node.frames, node.last_ms, node.min_ms, node.avg_ms, node.p99_ms, node.max_ms, (float)node.bytes / (1024.0f * 1024.0f));
+		}
+	}
+	ls_host_memory_info memory = { 0 };
+	status = lsGetHostMemoryUsage(stitch, &memory);
+	if (status) return Error("ERROR: lsGetHostMemoryUsage: failed (%d)\n", status);
+	Message("  host memory: %.2f MB (peak %.2f MB, hugepages %.2f MB)\n", (float)memory.allocated_bytes / (1024.0f * 1024.0f),
+		(float)memory.peak_bytes / (1024.0f * 1024.0f), (float)memory.hugepage_bytes / (1024.0f * 1024.0f));
+	return VX_SUCCESS;
+}
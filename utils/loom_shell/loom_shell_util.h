@@ -69,6 +69,7 @@ vx_status loadExpCompGains(ls_context stitch, size_t num_entries, const char * f
 vx_status saveExpCompGains(ls_context stitch, size_t num_entries, const char * fileName);
 
 vx_status loadBlendWeights(ls_context stitch, const char * fileName);
+vx_status showPerformance(ls_context stitch);
 vx_status initializeBuffer(cl_mem mem, vx_uint32 size, cl_int pattern);
 
 vx_status ClearCmdqCache();
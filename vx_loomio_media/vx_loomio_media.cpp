@@ -25,6 +25,8 @@ THE SOFTWARE.
 #include <Windows.h>
 #else
 #include <chrono>
+#include <stdlib.h>
+#include <sys/mman.h>
 #endif
 
 ////////////////////////////////////////////////////////////////////////////
@@ -65,19 +67,38 @@ vx_status initialize_ffmpeg()
 	return VX_SUCCESS;
 }
 
+#define ALIGNED_ALLOC_HUGEPAGE_SIZE ((size_t)2 << 20)
+#define ALIGNED_ALLOC_HEADER_SIZE   (2 * sizeof(uint8_t *))
+
 uint8_t * aligned_alloc(size_t size)
 {
-	uint8_t * buf = new uint8_t[size + 32 + sizeof(uint8_t *)];
+	size_t allocSize = size + 32 + ALIGNED_ALLOC_HEADER_SIZE;
+	uint8_t * buf = nullptr;
+	uintptr_t hugepage = 0;
+#if !_WIN32
+	if (size >= ALIGNED_ALLOC_HUGEPAGE_SIZE) {
+		// frame buffers of 2MB or larger: start at hugepage boundary and request transparent hugepages to reduce TLB misses
+		void * mem = nullptr;
+		if (posix_memalign(&mem, ALIGNED_ALLOC_HUGEPAGE_SIZE, allocSize) == 0) {
+			buf = (uint8_t *)mem;
+			hugepage = 1;
+			madvise(buf, allocSize, MADV_HUGEPAGE);
+		}
+	}
+#endif
+	if (!buf) buf = new uint8_t[allocSize];
 	if (!buf) return nullptr;
-	uint8_t * ptr = buf + (32 - (((intptr_t)buf) & 31)) + sizeof(uint8_t *);
-	*(uint8_t **)(ptr - sizeof(uint8_t *)) = buf;
+	uint8_t * ptr = (uint8_t *)(((uintptr_t)buf + ALIGNED_ALLOC_HEADER_SIZE + 31) & ~(uintptr_t)31);
+	((uint8_t **)ptr)[-1] = buf;
+	((uintptr_t *)ptr)[-2] = hugepage;
 	return ptr;
 }
 
 void aligned_free(uint8_t * ptr)
 {
-	uint8_t * buf = *(uint8_t **)(ptr - sizeof(uint8_t *));
-	delete[] buf;
+	uint8_t * buf = ((uint8_t **)ptr)[-1];
+	if (((uintptr_t *)ptr)[-2]) free(buf);
+	else delete[] buf;
 }
 
 int64_t ClockCounter()
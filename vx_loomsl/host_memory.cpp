@@ -0,0 +1,149 @@
+/*
+Copyright (c) 2017 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "host_memory.h"
+#include <stdlib.h>
+#if _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define HOST_MEMORY_HUGEPAGE_SIZE   ((vx_size)2 << 20)
+#define HOST_MEMORY_HEADER_SIZE     64
+
+//! \brief The header in front of each buffer: keeps the allocation size and method for HostMemoryFree.
+struct HostMemoryHeader {
+	vx_size   size;        // allocation size including the header
+	vx_uint32 flags;       // HOST_MEMORY_FLAG_*
+};
+enum {
+	HOST_MEMORY_FLAG_MAPPED   = 1,  // allocated with mmap/VirtualAlloc instead of the heap
+	HOST_MEMORY_FLAG_HUGEPAGE = 2,  // backed by or advised for hugepages
+};
+
+#if !_WIN32
+//! \brief Map anonymous memory aligned to the hugepage size, so that transparent hugepages cover the whole buffer.
+static vx_uint8 * MapAlignedMemory(vx_size size)
+{
+	vx_size mapSize = size + HOST_MEMORY_HUGEPAGE_SIZE;
+	void * ptr = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (ptr == MAP_FAILED)
+		return nullptr;
+	vx_uint8 * start = (vx_uint8 *)ptr;
+	vx_uint8 * aligned = (vx_uint8 *)(((size_t)start + HOST_MEMORY_HUGEPAGE_SIZE - 1) & ~(HOST_MEMORY_HUGEPAGE_SIZE - 1));
+	if (aligned > start) munmap(start, aligned - start);
+	if (aligned + size < start + mapSize) munmap(aligned + size, start + mapSize - (aligned + size));
+	return aligned;
+}
+
+//! \brief Prefer NUMA node for pages of a mapping that are not yet touched.
+static void BindMemoryToNode(void * ptr, vx_size size, vx_int32 numaNode)
+{
+#ifdef SYS_mbind
+	const int MPOL_PREFERRED_ = 1; // from numaif.h: falls back to other nodes when the node is out of memory
+	unsigned long nodemask[16] = { 0 };
+	if (numaNode < (vx_int32)(sizeof(nodemask) * 8)) {
+		nodemask[numaNode / (sizeof(unsigned long) * 8)] = 1ul << (numaNode % (sizeof(unsigned long) * 8));
+		syscall(SYS_mbind, ptr, size, MPOL_PREFERRED_, nodemask, sizeof(nodemask) * 8, 0);
+	}
+#endif
+}
+#endif
+
+void * HostMemoryAlloc(HostMemoryStats * stats, vx_size size, bool useHugepages, vx_int32 numaNode)
+{
+	vx_size allocSize = size + HOST_MEMORY_HEADER_SIZE;
+	vx_uint8 * base = nullptr;
+	vx_uint32 flags = 0;
+	if (allocSize >= HOST_MEMORY_HUGEPAGE_SIZE && (useHugepages || numaNode >= 0)) {
+		allocSize = (allocSize + HOST_MEMORY_HUGEPAGE_SIZE - 1) & ~(HOST_MEMORY_HUGEPAGE_SIZE - 1);
+		flags = HOST_MEMORY_FLAG_MAPPED;
+#if _WIN32
+		HANDLE process = GetCurrentProcess();
+		DWORD node = (numaNode >= 0) ? (DWORD)numaNode : NUMA_NO_PREFERRED_NODE;
+		SIZE_T largePageSize = GetLargePageMinimum();
+		if (useHugepages && largePageSize > 0 && (allocSize % largePageSize) == 0) {
+			// large pages need SeLockMemoryPrivilege: fall back to regular pages without it
+			base = (vx_uint8 *)VirtualAllocExNuma(process, nullptr, allocSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE, node);
+			if (base) flags |= HOST_MEMORY_FLAG_HUGEPAGE;
+		}
+		if (!base) {
+			base = (vx_uint8 *)VirtualAllocExNuma(process, nullptr, allocSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, node);
+		}
+#else
+		if (useHugepages) {
+			// explicit hugepages are only available when reserved by the administrator (vm.nr_hugepages)
+			void * ptr = mmap(nullptr, allocSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (ptr != MAP_FAILED) {
+				base = (vx_uint8 *)ptr;
+				flags |= HOST_MEMORY_FLAG_HUGEPAGE;
+			}
+		}
+		if (!base) {
+			base = MapAlignedMemory(allocSize);
+			if (base && useHugepages && madvise(base, allocSize, MADV_HUGEPAGE) == 0)
+				flags |= HOST_MEMORY_FLAG_HUGEPAGE;
+		}
+		if (base && numaNode >= 0) {
+			BindMemoryToNode(base, allocSize, numaNode);
+		}
+#endif
+	}
+	else {
+		base = (vx_uint8 *)malloc(allocSize);
+	}
+	if (!base)
+		return nullptr;
+	HostMemoryHeader * header = (HostMemoryHeader *)base;
+	header->size = allocSize;
+	header->flags = flags;
+	stats->allocatedBytes += allocSize;
+	if (stats->peakBytes < stats->allocatedBytes) stats->peakBytes = stats->allocatedBytes;
+	if (flags & HOST_MEMORY_FLAG_HUGEPAGE) stats->hugepageBytes += allocSize;
+	return base + HOST_MEMORY_HEADER_SIZE;
+}
+
+void HostMemoryFree(HostMemoryStats * stats, void * ptr)
+{
+	if (!ptr)
+		return;
+	vx_uint8 * base = (vx_uint8 *)ptr - HOST_MEMORY_HEADER_SIZE;
+	HostMemoryHeader * header = (HostMemoryHeader *)base;
+	vx_size allocSize = header->size;
+	vx_uint32 flags = header->flags;
+	stats->allocatedBytes -= allocSize;
+	if (flags & HOST_MEMORY_FLAG_HUGEPAGE) stats->hugepageBytes -= allocSize;
+	if (flags & HOST_MEMORY_FLAG_MAPPED) {
+#if _WIN32
+		VirtualFree(base, 0, MEM_RELEASE);
+#else
+		munmap(base, allocSize);
+#endif
+	}
+	else {
+		free(base);
+	}
+}
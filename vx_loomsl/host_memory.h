@@ -0,0 +1,46 @@
+/*
+Copyright (c) 2017 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#ifndef __HOST_MEMORY_H__
+#define __HOST_MEMORY_H__
+
+#include <VX/vx.h>
+
+//! \brief The host memory held by a stitch context (see HostMemoryAlloc).
+struct HostMemoryStats {
+	vx_size allocatedBytes;     // host memory currently allocated
+	vx_size peakBytes;          // largest allocatedBytes so far
+	vx_size hugepageBytes;      // part of allocatedBytes backed by (or advised for) 2MB hugepages
+};
+
+//! \brief Allocate a host buffer for large stitch tables.
+//  - buffers of 2MB or larger use 2MB hugepages when useHugepages is set (falls back to regular pages)
+//  - buffers of 2MB or larger are placed on NUMA node numaNode when it is not negative
+//  - smaller buffers come from the heap
+//  - returns nullptr when out of memory
+void * HostMemoryAlloc(HostMemoryStats * stats, vx_size size, bool useHugepages, vx_int32 numaNode);
+
+//! \brief Release a buffer allocated by HostMemoryAlloc (nullptr is ignored).
+void HostMemoryFree(HostMemoryStats * stats, void * ptr);
+
+#endif //__HOST_MEMORY_H__
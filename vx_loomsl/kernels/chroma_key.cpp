@@ -109,7 +109,7 @@ static vx_status VX_CALLBACK chroma_key_mask_generation_query_target_support(vx_
 	int CHROMAKEY_MASK = 0;
 	if (StitchGetEnvironmentVariable("CHROMAKEY_MASK", textBuffer, sizeof(textBuffer))) { CHROMAKEY_MASK = atoi(textBuffer); }
 
-	if (!CHROMAKEY_MASK)
+	if (!CHROMAKEY_MASK && !StitchIsHostExecution(graph))
 		supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
 	else
 		supported_target_affinity = AGO_TARGET_AFFINITY_CPU;
@@ -437,7 +437,7 @@ static vx_status VX_CALLBACK chroma_key_merge_query_target_support(vx_graph grap
 	int CHROMAKEY_MERGE = 0;
 	if (StitchGetEnvironmentVariable("CHROMAKEY_MERGE", textBuffer, sizeof(textBuffer))) { CHROMAKEY_MERGE = atoi(textBuffer); }
 
-	if (!CHROMAKEY_MERGE)
+	if (!CHROMAKEY_MERGE && !StitchIsHostExecution(graph))
 		supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
 	else
 		supported_target_affinity = AGO_TARGET_AFFINITY_CPU;
@@ -99,7 +99,7 @@ static vx_status VX_CALLBACK color_convert_query_target_support(vx_graph graph,
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = StitchIsHostExecution(graph) ? AGO_TARGET_AFFINITY_CPU : AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -514,10 +514,103 @@ static vx_status VX_CALLBACK color_convert_opencl_codegen(
 	return VX_SUCCESS;
 }
 
-//! \brief The kernel execution.
+//! \brief The kernel execution: used with host execution and matches the OpenCL kernel.
 static vx_status VX_CALLBACK color_convert_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_SUPPORTED;
+	// get input and output image configurations
+	vx_image input_image = (vx_image)parameters[0];
+	vx_image output_image = (vx_image)parameters[1];
+	vx_uint32 width = 0, height = 0;
+	vx_df_image input_format = VX_DF_IMAGE_VIRT, output_format = VX_DF_IMAGE_VIRT;
+	vx_channel_range_e input_channel_range;
+	vx_color_space_e input_color_space;
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_FORMAT, &input_format, sizeof(input_format)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_RANGE, &input_channel_range, sizeof(input_channel_range)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_SPACE, &input_color_space, sizeof(input_color_space)));
+	ERROR_CHECK_STATUS(vxQueryImage(output_image, VX_IMAGE_ATTRIBUTE_FORMAT, &output_format, sizeof(output_format)));
+	vx_rectangle_t rect = { 0, 0, width, height };
+	vx_imagepatch_addressing_t input_addr, output_addr;
+	void * input_ptr = nullptr, * output_ptr = nullptr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(input_image, &rect, 0, &input_addr, &input_ptr, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(output_image, &rect, 0, &output_addr, &output_ptr, VX_WRITE_ONLY));
+
+	if (input_format == VX_DF_IMAGE_RGB) {
+		// RGB to UYVY/YUYV: BT709 with U and V from the even pixel of each pair
+		const vx_float32 cY[3] = { 0.2126f, 0.7152f, 0.0722f };
+		const vx_float32 cU[3] = { -0.1146f, -0.3854f, 0.5f };
+		const vx_float32 cV[3] = { 0.5f, -0.4542f, -0.0458f };
+		bool isUYVY = (output_format == VX_DF_IMAGE_UYVY);
+#pragma omp parallel for
+		for (int y = 0; y < (int)height; y++) {
+			const vx_uint8 * ip = (const vx_uint8 *)input_ptr + y * input_addr.stride_y;
+			vx_uint8 * op = (vx_uint8 *)output_ptr + y * output_addr.stride_y;
+			for (vx_uint32 x = 0; x + 1 < width; x += 2, ip += 6, op += 4) {
+				vx_uint8 u = StitchPackU8(cU[0] * ip[0] + cU[1] * ip[1] + cU[2] * ip[2] + 128.0f);
+				vx_uint8 v = StitchPackU8(cV[0] * ip[0] + cV[1] * ip[1] + cV[2] * ip[2] + 128.0f);
+				vx_uint8 y0 = StitchPackU8(cY[0] * ip[0] + cY[1] * ip[1] + cY[2] * ip[2]);
+				vx_uint8 y1 = StitchPackU8(cY[0] * ip[3] + cY[1] * ip[4] + cY[2] * ip[5]);
+				if (isUYVY) { op[0] = u; op[1] = y0; op[2] = v; op[3] = y1; }
+				else { op[0] = y0; op[1] = u; op[2] = y1; op[3] = v; }
+			}
+		}
+	}
+	else {
+		// 4:2:2 to RGB/RGBX: RGBX gets luma as alpha
+		bool is16bit = (input_format == VX_DF_IMAGE_Y210_AMD || input_format == VX_DF_IMAGE_Y216_AMD);
+		vx_float32 cRv, cGu, cGv, cBu, r2f[4] = { 1.0f, 0.0f, 1.0f, -128.0f };
+		if (input_format == VX_DF_IMAGE_Y210_AMD) {
+			cRv = 1.57943176f; cGu = -0.18785088f; cGv = -0.46947676f; cBu = 1.86105765f;
+		}
+		else if (input_format == VX_DF_IMAGE_Y216_AMD) {
+			cRv = 1.5809516f; cGu = -0.18803164f; cGv = -0.46992852f; cBu = 1.86284844f;
+		}
+		else if (input_color_space == VX_COLOR_SPACE_BT601_525 || input_color_space == VX_COLOR_SPACE_BT601_625) {
+			cRv = 1.4030f; cGu = -0.3440f; cGv = -0.7140f; cBu = 1.7730f;
+		}
+		else { // VX_COLOR_SPACE_BT709
+			cRv = 1.5748f; cGu = -0.1873f; cGv = -0.4681f; cBu = 1.8556f;
+		}
+		if (!is16bit && input_channel_range == VX_CHANNEL_RANGE_RESTRICTED) {
+			r2f[0] = 256.0f / 219.0f; r2f[1] = -16.0f * 256.0f / 219.0f; r2f[2] = 256.0f / 224.0f; r2f[3] = -128.0f * 256.0f / 224.0f;
+		}
+		// byte offsets of U, Y0, V, Y1 within a pixel pair
+		vx_uint32 iu = 0, iy0 = 1, iv = 2, iy1 = 3;
+		if (input_format == VX_DF_IMAGE_YUYV) {
+			iu = 1; iy0 = 0; iv = 3; iy1 = 2;
+		}
+		vx_uint32 output_pixel_size = (output_format == VX_DF_IMAGE_RGBX) ? 4 : 3;
+#pragma omp parallel for
+		for (int y = 0; y < (int)height; y++) {
+			const vx_uint8 * ip = (const vx_uint8 *)input_ptr + y * input_addr.stride_y;
+			vx_uint8 * op = (vx_uint8 *)output_ptr + y * output_addr.stride_y;
+			for (vx_uint32 x = 0; x + 1 < width; x += 2) {
+				vx_float32 yk[2], u, v;
+				if (is16bit) {
+					const vx_uint8 * p = ip + x * 4;
+					u = p[0] + p[1] * 0.00390625f - 128.0f; yk[0] = p[2] + p[3] * 0.00390625f;
+					v = p[4] + p[5] * 0.00390625f - 128.0f; yk[1] = p[6] + p[7] * 0.00390625f;
+				}
+				else {
+					const vx_uint8 * p = ip + x * 2;
+					u = p[iu] * r2f[2] + r2f[3]; yk[0] = p[iy0] * r2f[0] + r2f[1];
+					v = p[iv] * r2f[2] + r2f[3]; yk[1] = p[iy1] * r2f[0] + r2f[1];
+				}
+				for (vx_uint32 k = 0; k < 2; k++) {
+					vx_uint8 * o = op + (x + k) * output_pixel_size;
+					o[0] = StitchPackU8(cRv * v + yk[k]);
+					o[1] = StitchPackU8(cGu * u + cGv * v + yk[k]);
+					o[2] = StitchPackU8(cBu * u + yk[k]);
+					if (output_pixel_size == 4) o[3] = StitchPackU8(yk[k]);
+				}
+			}
+		}
+	}
+
+	ERROR_CHECK_STATUS(vxCommitImagePatch(input_image, &rect, 0, &input_addr, input_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(output_image, &rect, 0, &output_addr, output_ptr));
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel publisher.
@@ -23,6 +23,46 @@ THE SOFTWARE.
 #define _CRT_SECURE_NO_WARNINGS
 #include "exposure_compensation.h"
 
+//! \brief The OpenCL macros to decode StitchOverlapPixelEntry or StitchOverlapPixelWideEntry.
+static const char * exposure_comp_overlap_entry_macros(bool bWideEntry)
+{
+	return bWideEntry ?
+		"#define OVERLAP_ENTRY uint4\n"
+		"#define OVERLAP_X(e) (int)(e).s2\n"
+		"#define OVERLAP_Y(e) (int)(e).s3\n"
+		"#define OVERLAP_CAM_IDS(e) (uint2)(((e).s0 & 0xff), (((e).s0 >> 8) & 0xff))\n" :
+		"#define OVERLAP_ENTRY uint2\n"
+		"#define OVERLAP_X(e) (int)(((e).s0 >> 5) & 0x3FFF)\n"
+		"#define OVERLAP_Y(e) (int)((e).s0 >> 19)\n"
+		"#define OVERLAP_CAM_IDS(e) (uint2)(((e).s0 & 0x1f), (((e).s1 >> 12) & 0x1f))\n";
+}
+
+//! \brief The OpenCL macros to decode StitchExpCompCalcEntry or StitchExpCompCalcWideEntry.
+static const char * exposure_comp_calc_entry_macros(bool bWideEntry)
+{
+	return bWideEntry ?
+		"#define EXPCOMP_ENTRY uint4\n"
+		"#define EXPCOMP_CAM(e) (int)(e).s0\n"
+		"#define EXPCOMP_X(e) (int)(e).s2\n"
+		"#define EXPCOMP_Y(e) (int)((e).s3 << 1)\n" :
+		"#define EXPCOMP_ENTRY uint2\n"
+		"#define EXPCOMP_CAM(e) (int)((e).s0 & 0x3f)\n"
+		"#define EXPCOMP_X(e) (int)(((e).s0 >> 6) & 0xFFF)\n"
+		"#define EXPCOMP_Y(e) (int)(((e).s0 >> 18) << 1)\n";
+}
+
+//! \brief The gamma to linear lookup table generated with gamma = 2.2: used by RGB error function.
+static const vx_uint8 g_Gamma2LinearLookUp[256] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2,
+	2, 2, 3, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10, 10, 11, 11,
+	12, 12, 13, 13, 13, 14, 14, 15, 15, 16, 16, 17, 17, 18, 18, 19, 19, 20, 21, 21, 22, 22, 23, 23, 24, 25, 25, 26, 27, 27, 28, 29,
+	29, 30, 31, 31, 32, 33, 33, 34, 35, 36, 36, 37, 38, 39, 40, 40, 41, 42, 43, 44, 45, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55,
+	55, 56, 57, 58, 59, 60, 61, 62, 63, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 77, 78, 79, 80, 81, 82, 84, 85, 86, 87, 88, 90,
+	91, 92, 93, 95, 96, 97, 99, 100, 101, 103, 104, 105, 107, 108, 109, 111, 112, 114, 115, 117, 118, 119, 121, 122, 124, 125, 127, 128, 130, 131, 133, 135,
+	136, 138, 139, 141, 142, 144, 146, 147, 149, 151, 152, 154, 156, 157, 159, 161, 162, 164, 166, 168, 169, 171, 173, 175, 176, 178, 180, 182, 184, 186, 187, 189,
+	191, 193, 195, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221, 223, 225, 227, 229, 231, 233, 235, 237, 239, 241, 244, 246, 248, 250, 252, 255
+};
+
 //! \brief The input validator callback.
 static vx_status VX_CALLBACK exposure_comp_calcErrorFn_input_validator(vx_node node, vx_uint32 index)
 {
@@ -65,7 +105,7 @@ static vx_status VX_CALLBACK exposure_comp_calcErrorFn_input_validator(vx_node n
 		vx_size capacity = 0;
 		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
 		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_CAPACITY, &capacity, sizeof(capacity)));
-		if (itemsize != sizeof(StitchOverlapPixelEntry)) {
+		if (itemsize != sizeof(StitchOverlapPixelEntry) && itemsize != sizeof(StitchOverlapPixelWideEntry)) {
 			status = VX_ERROR_INVALID_TYPE;
 			vxAddLogEntry((vx_reference)node, status, "ERROR: exposure_compensation gains array type should be float32\n");
 		}
@@ -95,6 +135,24 @@ static vx_status VX_CALLBACK exposure_comp_calcErrorFn_input_validator(vx_node n
 		}
 		status = VX_SUCCESS;
 	}
+	else if (index == 5)
+	{ // optional array object of StitchCameraPlaneEntry type
+		if (ref) {
+			vx_size itemsize = 0;
+			ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
+			ERROR_CHECK_STATUS(vxReleaseArray((vx_array *)&ref));
+			if (itemsize != sizeof(StitchCameraPlaneEntry)) {
+				status = VX_ERROR_INVALID_DIMENSION;
+				vxAddLogEntry((vx_reference)node, status, "ERROR: exposure_compensation array element (StitchCameraPlaneEntry) size should be 16 bytes\n");
+			}
+			else {
+				status = VX_SUCCESS;
+			}
+		}
+		else {
+			status = VX_SUCCESS;
+		}
+	}
 	return status;
 }
 
@@ -133,14 +191,220 @@ static vx_status VX_CALLBACK exposure_comp_calcErrorFn_query_target_support(vx_g
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	char textBuffer[256];
+	int EXPCOMP_CPU = 0;
+	if (StitchGetEnvironmentVariable("EXPCOMP_CPU", textBuffer, sizeof(textBuffer))) { EXPCOMP_CPU = atoi(textBuffer); }
+
+	if (!EXPCOMP_CPU && !StitchIsHostExecution(graph))
+		supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	else
+		supported_target_affinity = AGO_TARGET_AFFINITY_CPU;
+	return VX_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////
+// CPU implementation of error function: each thread walks a share of the
+// overlap entries (128x32 blocks) with 4 pixels per SSE vector and masked sums,
+// accumulating into its own partial matrix; partial matrices are reduced at end.
+
+//! \brief The decoded overlap pixel entry used by CPU kernels.
+typedef struct {
+	vx_uint32 camI, camJ;         // overlapping camera pair
+	vx_uint32 x, y;               // destination start pixel coordinates of the 128x32 block
+	vx_uint32 width, height;      // number of pixels processed in the block: multiple of 8x2 like OpenCL kernel
+} ExpCompOverlapBlock;
+
+static inline void DecodeOverlapEntry(const vx_uint8 * ptr, vx_size itemsize, ExpCompOverlapBlock& block)
+{
+	vx_uint32 end_x, end_y;
+	if (itemsize == sizeof(StitchOverlapPixelWideEntry)) {
+		const StitchOverlapPixelWideEntry * entry = (const StitchOverlapPixelWideEntry *)ptr;
+		block.camI = entry->camId0; block.camJ = entry->camId1;
+		block.x = entry->start_x; block.y = entry->start_y;
+		end_x = entry->end_x; end_y = entry->end_y;
+	}
+	else {
+		const StitchOverlapPixelEntry * entry = (const StitchOverlapPixelEntry *)ptr;
+		block.camI = entry->camId0; block.camJ = entry->camId1;
+		block.x = entry->start_x; block.y = entry->start_y;
+		end_x = entry->end_x; end_y = entry->end_y;
+	}
+	block.width = ((end_x + 7) >> 3) << 3;
+	block.height = ((end_y + 1) >> 1) << 1;
+}
+
+//! \brief Valid pixel mask of 4 pixels of I and J: all ones when neither is 0x80000000 and mask images agree.
+static inline __m128i ExpCompPixelMask(__m128i I, __m128i J, const vx_uint8 * mI, const vx_uint8 * mJ)
+{
+	const __m128i invalid = _mm_set1_epi32((int)0x80000000);
+	__m128i mask = _mm_or_si128(_mm_cmpeq_epi32(I, invalid), _mm_cmpeq_epi32(J, invalid));
+	mask = _mm_andnot_si128(mask, _mm_set1_epi32(-1));
+	if (mI) {
+		vx_int32 m = *(const vx_int32 *)mI & *(const vx_int32 *)mJ;
+		mask = _mm_and_si128(mask, _mm_cvtepi8_epi32(_mm_cvtsi32_si128(m)));
+	}
+	return mask;
+}
+
+//! \brief The node local data of RGB error function: per thread rows of gamma linearized pixels.
+struct ExpCompLinearScratch {
+	vx_uint32 width;                              // image width in pixels
+	std::vector< std::vector<vx_uint8> > rows;    // [thread]: linearized row of camera I followed by row of camera J
+};
+
+//! \brief Gamma linearize a row of RGBX pixels with alpha cleared, so that sums can use vector loads.
+static inline void ExpCompLinearizeRow(const vx_uint8 * src, vx_uint8 * dst, vx_uint32 count)
+{
+	for (vx_uint32 x = 0; x < count; x++, src += 4, dst += 4) {
+		dst[0] = g_Gamma2LinearLookUp[src[0]];
+		dst[1] = g_Gamma2LinearLookUp[src[1]];
+		dst[2] = g_Gamma2LinearLookUp[src[2]];
+		dst[3] = 0;
+	}
+}
+
+//! \brief Accumulate error function of overlap entries into matrix: rgb selects per channel sums
+//  of gamma linearized R, G and B into [3*num_cameras x num_cameras] matrix instead of Y sums
+//  and needs scratch rows from the node local data.
+static vx_status ExpCompCalcErrorFnCPU(const vx_reference * parameters, ExpCompLinearScratch * scratch)
+{
+	bool rgb = scratch ? true : false;
+	vx_uint32 num_cameras = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &num_cameras));
+	vx_image image = (vx_image)parameters[1], mask_image = (vx_image)parameters[3];
+	vx_array arr = (vx_array)parameters[2];
+	vx_matrix mat = (vx_matrix)parameters[4];
+	vx_size columns = 0, rows = 0, itemsize = 0, numitems = 0;
+	ERROR_CHECK_STATUS(vxQueryMatrix(mat, VX_MATRIX_ATTRIBUTE_COLUMNS, &columns, sizeof(columns)));
+	ERROR_CHECK_STATUS(vxQueryMatrix(mat, VX_MATRIX_ATTRIBUTE_ROWS, &rows, sizeof(rows)));
+	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
+	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &numitems, sizeof(numitems)));
+	// accumulate on top of current matrix contents like the atomic adds of the GPU kernel,
+	// so that statistics of several frames can be gathered between exposure solves
+	std::vector<vx_int32> AMat(columns * rows, 0);
+	ERROR_CHECK_STATUS(vxReadMatrix(mat, AMat.data()));
+
+	// access input, mask image and overlap entries
+	vx_uint32 width = 0, height = 0, height_one;
+	vx_rectangle_t rect, mask_rect;
+	vx_imagepatch_addressing_t addr, mask_addr;
+	void * ptr = nullptr, * mask_ptr = nullptr;
+	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	height_one = height / num_cameras;
+	rect.start_x = rect.start_y = 0; rect.end_x = width; rect.end_y = height;
+	std::vector<vx_int32> camRow;
+	ERROR_CHECK_STATUS(GetCameraPlaneRows((vx_array)parameters[5], num_cameras, height_one, camRow));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(image, &rect, 0, &addr, &ptr, VX_READ_ONLY));
+	if (mask_image) {
+		mask_rect = rect;
+		ERROR_CHECK_STATUS(vxAccessImagePatch(mask_image, &mask_rect, 0, &mask_addr, &mask_ptr, VX_READ_ONLY));
+	}
+	vx_uint8 * arr_ptr = nullptr;
+	vx_size arr_stride = itemsize;
+	if (numitems > 0) {
+		ERROR_CHECK_STATUS(vxAccessArrayRange(arr, 0, numitems, &arr_stride, (void **)&arr_ptr, VX_READ_ONLY));
+	}
+	// only rows of overlap blocks are gamma linearized, into scratch rows of each thread: scratch rows
+	// are allocated by node initialize and only grow here when the number of threads has changed
+	if (rgb && (scratch->rows.size() < (size_t)omp_get_max_threads() || scratch->width < width)) {
+		scratch->width = std::max(scratch->width, width);
+		scratch->rows.resize(std::max(scratch->rows.size(), (size_t)omp_get_max_threads()));
+		for (size_t i = 0; i < scratch->rows.size(); i++)
+			scratch->rows[i].resize((size_t)scratch->width << 3);
+	}
+
+#pragma omp parallel
+	{
+		std::vector<vx_int32> partial(columns * rows, 0);
+		vx_uint8 * linRowI = rgb ? scratch->rows[omp_get_thread_num()].data() : nullptr;
+		vx_uint8 * linRowJ = rgb ? linRowI + ((size_t)scratch->width << 2) : nullptr;
+#pragma omp for
+		for (int k = 0; k < (int)numitems; k++) {
+			ExpCompOverlapBlock block;
+			DecodeOverlapEntry(arr_ptr + k * arr_stride, itemsize, block);
+			if (block.x >= width || block.camI >= num_cameras || block.camJ >= num_cameras)
+				continue;
+			// output rows held by camera planes of both cameras
+			vx_int32 startI = camRow[block.camI] + (vx_int32)block.y, startJ = camRow[block.camJ] + (vx_int32)block.y;
+			vx_int32 rowsI = (vx_int32)((block.camI + 1) * height_one) - startI, rowsJ = (vx_int32)((block.camJ + 1) * height_one) - startJ;
+			if (startI < (vx_int32)(block.camI * height_one) || startJ < (vx_int32)(block.camJ * height_one) || rowsI <= 0 || rowsJ <= 0)
+				continue;
+			block.width = std::min(block.width, (width - block.x) & ~3u);
+			block.height = std::min(block.height, (vx_uint32)std::min(rowsI, rowsJ));
+			__m128i sumI = _mm_setzero_si128(), sumJ = _mm_setzero_si128();
+			for (vx_uint32 y = 0; y < block.height; y++) {
+				const vx_uint8 * rowI = (const vx_uint8 *)ptr + (startI + y) * addr.stride_y + (block.x << 2);
+				const vx_uint8 * rowJ = (const vx_uint8 *)ptr + (startJ + y) * addr.stride_y + (block.x << 2);
+				const vx_uint8 * maskI = nullptr, * maskJ = nullptr;
+				if (mask_ptr) {
+					maskI = (const vx_uint8 *)mask_ptr + (startI + y) * mask_addr.stride_y + block.x;
+					maskJ = (const vx_uint8 *)mask_ptr + (startJ + y) * mask_addr.stride_y + block.x;
+				}
+				if (!rgb) {
+					// sum of Y in upper byte of valid pixels
+					for (vx_uint32 x = 0; x < block.width; x += 4) {
+						__m128i I = _mm_loadu_si128((const __m128i *)(rowI + (x << 2)));
+						__m128i J = _mm_loadu_si128((const __m128i *)(rowJ + (x << 2)));
+						__m128i mask = ExpCompPixelMask(I, J, maskI ? maskI + x : nullptr, maskJ ? maskJ + x : nullptr);
+						sumI = _mm_add_epi32(sumI, _mm_srli_epi32(_mm_and_si128(I, mask), 24));
+						sumJ = _mm_add_epi32(sumJ, _mm_srli_epi32(_mm_and_si128(J, mask), 24));
+					}
+				}
+				else {
+					// per channel sum of gamma linearized RGB of valid pixels: 16-bit sums within a row
+					__m128i rowSumI = _mm_setzero_si128(), rowSumJ = _mm_setzero_si128();
+					const __m128i zero = _mm_setzero_si128();
+					ExpCompLinearizeRow(rowI, linRowI, block.width);
+					ExpCompLinearizeRow(rowJ, linRowJ, block.width);
+					for (vx_uint32 x = 0; x < block.width; x += 4) {
+						__m128i I = _mm_loadu_si128((const __m128i *)(rowI + (x << 2)));
+						__m128i J = _mm_loadu_si128((const __m128i *)(rowJ + (x << 2)));
+						__m128i mask = ExpCompPixelMask(I, J, maskI ? maskI + x : nullptr, maskJ ? maskJ + x : nullptr);
+						I = _mm_and_si128(_mm_loadu_si128((const __m128i *)(linRowI + (x << 2))), mask);
+						J = _mm_and_si128(_mm_loadu_si128((const __m128i *)(linRowJ + (x << 2))), mask);
+						rowSumI = _mm_add_epi16(rowSumI, _mm_add_epi16(_mm_unpacklo_epi8(I, zero), _mm_unpackhi_epi8(I, zero)));
+						rowSumJ = _mm_add_epi16(rowSumJ, _mm_add_epi16(_mm_unpacklo_epi8(J, zero), _mm_unpackhi_epi8(J, zero)));
+					}
+					sumI = _mm_add_epi32(sumI, _mm_add_epi32(_mm_cvtepu16_epi32(rowSumI), _mm_cvtepu16_epi32(_mm_srli_si128(rowSumI, 8))));
+					sumJ = _mm_add_epi32(sumJ, _mm_add_epi32(_mm_cvtepu16_epi32(rowSumJ), _mm_cvtepu16_epi32(_mm_srli_si128(rowSumJ, 8))));
+				}
+			}
+			vx_uint32 sI[4], sJ[4];
+			_mm_storeu_si128((__m128i *)sI, sumI);
+			_mm_storeu_si128((__m128i *)sJ, sumJ);
+			vx_size idxI = block.camI * columns + block.camJ, idxJ = block.camJ * columns + block.camI;
+			if (!rgb) {
+				partial[idxI] += (vx_int32)((sI[0] + sI[1] + sI[2] + sI[3]) * 0.0625f);
+				partial[idxJ] += (vx_int32)((sJ[0] + sJ[1] + sJ[2] + sJ[3]) * 0.0625f);
+			}
+			else {
+				for (vx_uint32 c = 0; c < 3; c++) {
+					partial[idxI + c * num_cameras * columns] += (vx_int32)(sI[c] * 0.0625f);
+					partial[idxJ + c * num_cameras * columns] += (vx_int32)(sJ[c] * 0.0625f);
+				}
+			}
+		}
+#pragma omp critical
+		for (vx_size i = 0; i < partial.size(); i++)
+			AMat[i] += partial[i];
+	}
+
+	if (numitems > 0) {
+		ERROR_CHECK_STATUS(vxCommitArrayRange(arr, 0, numitems, arr_ptr));
+	}
+	if (mask_image) {
+		ERROR_CHECK_STATUS(vxCommitImagePatch(mask_image, &mask_rect, 0, &mask_addr, mask_ptr));
+	}
+	ERROR_CHECK_STATUS(vxCommitImagePatch(image, &rect, 0, &addr, ptr));
+	ERROR_CHECK_STATUS(vxWriteMatrix(mat, AMat.data()));
 	return VX_SUCCESS;
 }
 
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK exposure_comp_calcErrorFn_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_SUPPORTED;
+	return ExpCompCalcErrorFnCPU(parameters, nullptr);
 }
 
 //! \brief The OpenCL global work updater callback.
@@ -195,8 +459,10 @@ static vx_status VX_CALLBACK exposure_comp_calcErrorFn_opencl_codegen(
 	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &input_height, sizeof(input_height)));
 	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_FORMAT, &input_format, sizeof(input_format)));
 	ERROR_CHECK_STATUS(vxReleaseImage(&image));
+	vx_size arr_itemsize = 0;
 	vx_array exp_data = (vx_array)avxGetNodeParamRef(node, 2);
 	ERROR_CHECK_STATUS(vxQueryArray(exp_data, VX_ARRAY_ATTRIBUTE_CAPACITY, &arr_size, sizeof(arr_size)));
+	ERROR_CHECK_STATUS(vxQueryArray(exp_data, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &arr_itemsize, sizeof(arr_itemsize)));
 	ERROR_CHECK_STATUS(vxReleaseArray(&exp_data));
 	vx_image mask_image = (vx_image)avxGetNodeParamRef(node, 3);
 	if (mask_image != NULL){
@@ -205,8 +471,13 @@ static vx_status VX_CALLBACK exposure_comp_calcErrorFn_opencl_codegen(
 		ERROR_CHECK_STATUS(vxQueryImage(mask_image, VX_IMAGE_ATTRIBUTE_FORMAT, &input_format, sizeof(input_format)));
 	}
 
+	vx_array cam_plane_arr = (vx_array)avxGetNodeParamRef(node, 5);
+	bool packed = (cam_plane_arr != nullptr);
+	if (cam_plane_arr) ERROR_CHECK_STATUS(vxReleaseArray(&cam_plane_arr));
+
 	// set kernel configuration
 	vx_uint32 height_one = (vx_uint32)(input_height / num_cameras);
+	char height1[16]; sprintf(height1, "%u", height_one);
 	strcpy(opencl_kernel_function_name, "exposure_comp_calc_errorfn_mask");
 	opencl_work_dim = 2;
 	opencl_local_work[0] = 16;
@@ -224,15 +495,13 @@ static vx_status VX_CALLBACK exposure_comp_calcErrorFn_opencl_codegen(
 			"			uint	pIn_width, uint	pIn_height, __global uchar *pIn_buf, uint pIn_stride, uint	pIn_offs,\n"
 			"			__global uchar * exp_data, uint	exp_data_offs, uint exp_data_num,\n"
 			"			uint	pWt_width, uint	pWt_height, __global uchar *pWt_buf, uint pWt_stride, uint	pWt_offs,\n"
-			"			__global int * pAMat, uint cols, uint rows)\n"
+			"			__global int * pAMat, uint cols, uint rows%s)\n"
 			"{\n"
 			"	int grp_id = get_global_id(0)>>4;\n"
 			"   if (grp_id < exp_data_num) {\n"
 			"	__local uint  sumI[256], sumJ[256];\n"
-			"	uint2 offs = ((__global uint2 *)(exp_data+exp_data_offs))[grp_id];\n"
-			"	uint size = (uint)(pIn_stride*%d);\n"
-			"	uint wt_size = (uint)(pWt_stride*%d);\n"
-			, (int)opencl_local_work[0], (int)opencl_local_work[1], opencl_kernel_function_name, height_one, height_one);
+			"	OVERLAP_ENTRY offs = ((__global OVERLAP_ENTRY *)(exp_data+exp_data_offs))[grp_id];\n"
+			, (int)opencl_local_work[0], (int)opencl_local_work[1], opencl_kernel_function_name, GetCameraPlaneOpenCLArgs(packed));
 		opencl_kernel_code = item;
 		opencl_kernel_code +=
 			"	int lx = get_local_id(0);\n"
@@ -244,17 +513,17 @@ static vx_status VX_CALLBACK exposure_comp_calcErrorFn_opencl_codegen(
 			"		global uint *pI, *pJ;\n"
 			"		uint4 maskSrc, I, J, mask; \n"
 			"		uint4 Isum4, Jsum4;\n"
-			"		int   gx = (lx<<3) + ((offs.s0 >> 5) & 0x3FFF);\n"
-			"		int   gy = (ly<<1) + (offs.s0 >> 19);\n"
-			"		uint2 cam_id = (uint2)((offs.s0 & 0x1f), ((offs.s1>>12) & 0x1f));\n"
+			"		int   gx = (lx<<3) + OVERLAP_X(offs);\n"
+			"		int   gy = (ly<<1) + OVERLAP_Y(offs);\n"
+			"		uint2 cam_id = OVERLAP_CAM_IDS(offs);\n"
 			"		pIn_buf += pIn_offs + mad24(gy, (int)pIn_stride, (gx<<2));\n"
 			"		pWt_buf += pWt_offs + mad24(gy, (int)pWt_stride, gx);\n"
-			"		pI	   =  (global uint *)(pIn_buf + size*cam_id.x);\n"
-			"		pJ	   =  (global uint *)(pIn_buf + size*cam_id.y);\n"
-			"		maskSrc.s01	   =  *(global uint2 *)(pWt_buf + wt_size*cam_id.x);\n"
-			"		maskSrc.s01	   &=  *(global uint2 *)(pWt_buf + wt_size*cam_id.y); pWt_buf += pWt_stride;\n"
-			"		maskSrc.s23	   =  *(global uint2 *)(pWt_buf + wt_size*cam_id.x);\n"
-			"		maskSrc.s23	   &=  *(global uint2 *)(pWt_buf + wt_size*cam_id.y);\n"
+			"		pI	   =  (global uint *)(pIn_buf + CAM_ROW(cam_id.x)*(int)pIn_stride);\n"
+			"		pJ	   =  (global uint *)(pIn_buf + CAM_ROW(cam_id.y)*(int)pIn_stride);\n"
+			"		maskSrc.s01	   =  *(global uint2 *)(pWt_buf + CAM_ROW(cam_id.x)*(int)pWt_stride);\n"
+			"		maskSrc.s01	   &=  *(global uint2 *)(pWt_buf + CAM_ROW(cam_id.y)*(int)pWt_stride); pWt_buf += pWt_stride;\n"
+			"		maskSrc.s23	   =  *(global uint2 *)(pWt_buf + CAM_ROW(cam_id.x)*(int)pWt_stride);\n"
+			"		maskSrc.s23	   &=  *(global uint2 *)(pWt_buf + CAM_ROW(cam_id.y)*(int)pWt_stride);\n"
 			"		char4 maskIJ = as_char4(maskSrc.s0);\n"
 			"		I = vload4(0, pI);\n"
 			"		J = vload4(0, pJ); \n"
@@ -301,14 +570,13 @@ static vx_status VX_CALLBACK exposure_comp_calcErrorFn_opencl_codegen(
 			"__kernel void %s(uint num_cameras,\n" // opencl_kernel_function_name
 			"			uint	pIn_width, uint	pIn_height, __global uchar *pIn_buf, uint pIn_stride, uint	pIn_offs,\n"
 			"			__global uchar * exp_data, uint	exp_data_offs, uint exp_data_num,\n"
-			"			__global int * pAMat, uint cols, uint rows)\n"
+			"			__global int * pAMat, uint cols, uint rows%s)\n"
 			"{\n"
 			"	int grp_id = get_global_id(0)>>4;\n"
 			"   if (grp_id < exp_data_num) {\n"
 			"	__local uint  sumI[256], sumJ[256];\n"
-			"	uint2 offs = ((__global uint2 *)(exp_data+exp_data_offs))[grp_id];\n"
-			"	uint size = (uint)(pIn_stride*%d);\n"
-			, (int)opencl_local_work[0], (int)opencl_local_work[1], opencl_kernel_function_name, height_one);
+			"	OVERLAP_ENTRY offs = ((__global OVERLAP_ENTRY *)(exp_data+exp_data_offs))[grp_id];\n"
+			, (int)opencl_local_work[0], (int)opencl_local_work[1], opencl_kernel_function_name, GetCameraPlaneOpenCLArgs(packed));
 		opencl_kernel_code = item;
 		opencl_kernel_code +=
 			"	int lx = get_local_id(0);\n"
@@ -320,12 +588,12 @@ static vx_status VX_CALLBACK exposure_comp_calcErrorFn_opencl_codegen(
 			"		global uint *pI, *pJ;\n"
 			"		uint4  I, J, mask; \n"
 			"		uint4 Isum4, Jsum4;\n"
-			"		int   gx = (lx<<3) + ((offs.s0 >> 5) & 0x3FFF);\n"
-			"		int   gy = (ly<<1) + (offs.s0 >> 19);\n"
-			"		uint2 cam_id = (uint2)((offs.s0 & 0x1f), ((offs.s1>>12) & 0x1f));\n"
+			"		int   gx = (lx<<3) + OVERLAP_X(offs);\n"
+			"		int   gy = (ly<<1) + OVERLAP_Y(offs);\n"
+			"		uint2 cam_id = OVERLAP_CAM_IDS(offs);\n"
 			"		pIn_buf += pIn_offs + mad24(gy, (int)pIn_stride, (gx<<2));\n"
-			"		pI	   =  (global uint *)(pIn_buf + size*cam_id.x);\n"
-			"		pJ	   =  (global uint *)(pIn_buf + size*cam_id.y);\n"
+			"		pI	   =  (global uint *)(pIn_buf + CAM_ROW(cam_id.x)*(int)pIn_stride);\n"
+			"		pJ	   =  (global uint *)(pIn_buf + CAM_ROW(cam_id.y)*(int)pIn_stride);\n"
 			"		I = vload4(0, pI);\n"
 			"		J = vload4(0, pJ); \n"
 			"		mask.s0	= select(0xff000000, 0u, ((I.s0==0x80000000) | (J.s0==0x80000000)));\n"
@@ -410,6 +678,7 @@ static vx_status VX_CALLBACK exposure_comp_calcErrorFn_opencl_codegen(
 		"	}\n"
 		"	}\n"
 		"}\n";
+	opencl_kernel_code = exposure_comp_overlap_entry_macros(arr_itemsize == sizeof(StitchOverlapPixelWideEntry)) + GetCameraPlaneOpenCLMacros(packed, height1) + opencl_kernel_code;
 	if (mask_image)ERROR_CHECK_STATUS(vxReleaseImage(&mask_image));
 	return VX_SUCCESS;
 }
@@ -421,7 +690,7 @@ vx_status exposure_comp_calcErrorFn_publish(vx_context context)
 	vx_kernel kernel = vxAddKernel(context, "com.amd.loomsl.expcomp_compute_gainmatrix",
 		AMDOVX_KERNEL_STITCHING_EXPCOMP_COMPUTE_GAINMAT,
 		exposure_comp_calcErrorFn_kernel,
-		5,
+		6,
 		exposure_comp_calcErrorFn_input_validator,
 		exposure_comp_calcErrorFn_output_validator,
 		nullptr,
@@ -440,6 +709,7 @@ vx_status exposure_comp_calcErrorFn_publish(vx_context context)
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 2, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 3, VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_OPTIONAL));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 4, VX_OUTPUT, VX_TYPE_MATRIX, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 5, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_OPTIONAL));
 	// finalize and release kernel object
 	ERROR_CHECK_STATUS(vxFinalizeKernel(kernel));
 	ERROR_CHECK_STATUS(vxReleaseKernel(&kernel));
@@ -507,7 +777,7 @@ static vx_status VX_CALLBACK exposure_comp_applygains_input_validator(vx_node no
 		vx_size itemsize = 0, capacity = 0;
 		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_CAPACITY, &capacity, sizeof(capacity)));
 		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
-		if (itemsize != sizeof(StitchExpCompCalcEntry)) {
+		if (itemsize != sizeof(StitchExpCompCalcEntry) && itemsize != sizeof(StitchExpCompCalcWideEntry)) {
 			status = VX_ERROR_INVALID_TYPE;
 			vxAddLogEntry((vx_reference)node, status, "ERROR: exposure_compensation offset array type should be VX_TYPE_UINT64\n");
 		}
@@ -548,6 +818,42 @@ static vx_status VX_CALLBACK exposure_comp_applygains_input_validator(vx_node no
 			}
 		}
 	}
+	else if (index == 7)
+	{ // optional array object of StitchCameraPlaneEntry type
+		if (ref) {
+			vx_size itemsize = 0;
+			ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
+			ERROR_CHECK_STATUS(vxReleaseArray((vx_array *)&ref));
+			if (itemsize != sizeof(StitchCameraPlaneEntry)) {
+				status = VX_ERROR_INVALID_DIMENSION;
+				vxAddLogEntry((vx_reference)node, status, "ERROR: exposure_compensation array element (StitchCameraPlaneEntry) size should be 16 bytes\n");
+			}
+			else {
+				status = VX_SUCCESS;
+			}
+		}
+		else {
+			status = VX_SUCCESS;
+		}
+	}
+	else if (index == 8)
+	{ // optional scalar for camera height of packed images
+		if (ref) {
+			vx_enum itemtype = VX_TYPE_INVALID;
+			ERROR_CHECK_STATUS(vxQueryScalar((vx_scalar)ref, VX_SCALAR_ATTRIBUTE_TYPE, &itemtype, sizeof(itemtype)));
+			ERROR_CHECK_STATUS(vxReleaseScalar((vx_scalar *)&ref));
+			if (itemtype == VX_TYPE_UINT32) {
+				status = VX_SUCCESS;
+			}
+			else {
+				status = VX_ERROR_INVALID_TYPE;
+				vxAddLogEntry((vx_reference)node, status, "ERROR: exp_comp camera height scalar type should be a UINT32\n");
+			}
+		}
+		else {
+			status = VX_SUCCESS;
+		}
+	}
 	return status;
 }
 
@@ -580,14 +886,177 @@ static vx_status VX_CALLBACK exposure_comp_applygains_query_target_support(vx_gr
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = StitchIsHostExecution(graph) ? AGO_TARGET_AFFINITY_CPU : AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
+//////////////////////////////////////////////////////////////////////
+// CPU implementation of apply gains: each thread walks a share of the
+// calc entries (128x32 blocks) with the same gain modes as the OpenCL kernel.
+
+//! \brief Pack RGBX floats to pixel with saturation and round to nearest like amd_pack.
+static inline vx_uint32 ExpCompPackPixel(__m128 f)
+{
+	__m128i v = _mm_packs_epi32(_mm_cvtps_epi32(f), _mm_setzero_si128());
+	return (vx_uint32)_mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+}
+
+//! \brief Multiply RGBX pixel by per channel gains.
+static inline vx_uint32 ExpCompGainPixel(vx_uint32 rgbx, __m128 g4)
+{
+	__m128 f = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128((int)rgbx)));
+	return ExpCompPackPixel(_mm_mul_ps(f, g4));
+}
+
+//! \brief Bilinear sample of block gains: nc gains per cell, indices clamped to the gain array.
+static inline void ExpCompBlockGain(const vx_float32 * gains, vx_size num_gains, vx_size base, vx_uint32 ystride, vx_uint32 nc,
+	float fx, float fy0, float fy1, float * g)
+{
+	float fint = floorf(fx), frac = fx - fint;
+	vx_int64 idx[4];
+	idx[0] = (vx_int64)base + (vx_int64)fint * nc; idx[1] = idx[0] + nc;
+	idx[2] = idx[0] + ystride; idx[3] = idx[1] + ystride;
+	for (vx_uint32 c = 0; c < nc; c++) {
+		float f[4];
+		for (int k = 0; k < 4; k++)
+			f[k] = gains[std::min(std::max(idx[k] + (vx_int64)c, (vx_int64)0), (vx_int64)num_gains - 1)];
+		g[c] = (f[0] * (1.0f - frac) + f[1] * frac) * fy0 + (f[2] * (1.0f - frac) + f[3] * frac) * fy1;
+	}
+}
+
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK exposure_comp_applygains_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_SUPPORTED;
+	vx_image input_image = (vx_image)parameters[0], output_image = (vx_image)parameters[6];
+	vx_array gains_arr = (vx_array)parameters[1], arr = (vx_array)parameters[2];
+	vx_scalar sc_width = (vx_scalar)parameters[4], sc_height = (vx_scalar)parameters[5], sc_eqr_height = (vx_scalar)parameters[8];
+	vx_uint32 num_cam = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[3], &num_cam));
+	if (!num_cam) num_cam = 1;	// has to be atleast 1
+	vx_uint32 bg_width = 1, bg_height = 1;
+	if (sc_width) ERROR_CHECK_STATUS(vxReadScalarValue(sc_width, &bg_width));
+	if (sc_height) ERROR_CHECK_STATUS(vxReadScalarValue(sc_height, &bg_height));
+	bg_width = std::max(1, (int)bg_width);
+	bg_height = std::max(1, (int)bg_height);
+	// gain mode is picked from the gain array capacity like the OpenCL code generator
+	vx_size num_gains = 0, gains_numitems = 0, itemsize = 0, numitems = 0;
+	ERROR_CHECK_STATUS(vxQueryArray(gains_arr, VX_ARRAY_ATTRIBUTE_CAPACITY, &num_gains, sizeof(num_gains)));
+	ERROR_CHECK_STATUS(vxQueryArray(gains_arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &gains_numitems, sizeof(gains_numitems)));
+	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
+	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &numitems, sizeof(numitems)));
+	if (num_gains < bg_width*bg_height*num_cam || gains_numitems < bg_width*bg_height*num_cam)
+		return VX_ERROR_INVALID_DIMENSION;
+	bool bBlockGain = sc_width && sc_height;
+	bool bRGBGain = (num_gains >= bg_width*bg_height*num_cam * 3);
+	bool bColorTransform = !bBlockGain && (num_gains == num_cam * 12);
+	if ((bRGBGain && gains_numitems < bg_width*bg_height*num_cam * 3) || (bColorTransform && gains_numitems < num_gains))
+		return VX_ERROR_INVALID_DIMENSION;
+
+	// access images, gains and calc entries: pixels outside of entries keep their previous contents
+	vx_uint32 input_width = 0, input_height = 0, output_width = 0, output_height = 0;
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_WIDTH, &input_width, sizeof(input_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &input_height, sizeof(input_height)));
+	ERROR_CHECK_STATUS(vxQueryImage(output_image, VX_IMAGE_ATTRIBUTE_WIDTH, &output_width, sizeof(output_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(output_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &output_height, sizeof(output_height)));
+	vx_uint32 height_one_in = input_height / num_cam, height_one_out = output_height / num_cam;
+	// camera planes give the rows of each camera when the images are packed
+	std::vector<vx_int32> camRowIn, camRowOut;
+	ERROR_CHECK_STATUS(GetCameraPlaneRows((vx_array)parameters[7], num_cam, height_one_in, camRowIn));
+	ERROR_CHECK_STATUS(GetCameraPlaneRows((vx_array)parameters[7], num_cam, height_one_out, camRowOut));
+	vx_uint32 eqr_height_one = height_one_out;
+	if (sc_eqr_height) ERROR_CHECK_STATUS(vxReadScalarValue(sc_eqr_height, &eqr_height_one));
+	vx_rectangle_t input_rect, output_rect;
+	vx_imagepatch_addressing_t input_addr, output_addr;
+	void * input_ptr = nullptr, * output_ptr = nullptr;
+	input_rect.start_x = input_rect.start_y = 0; input_rect.end_x = input_width; input_rect.end_y = input_height;
+	output_rect.start_x = output_rect.start_y = 0; output_rect.end_x = output_width; output_rect.end_y = output_height;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(input_image, &input_rect, 0, &input_addr, &input_ptr, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(output_image, &output_rect, 0, &output_addr, &output_ptr, VX_READ_AND_WRITE));
+	vx_float32 * gains = nullptr;
+	vx_size gains_stride = sizeof(vx_float32);
+	ERROR_CHECK_STATUS(vxAccessArrayRange(gains_arr, 0, gains_numitems, &gains_stride, (void **)&gains, VX_READ_ONLY));
+	vx_uint8 * arr_ptr = nullptr;
+	vx_size arr_stride = itemsize;
+	if (numitems > 0) {
+		ERROR_CHECK_STATUS(vxAccessArrayRange(arr, 0, numitems, &arr_stride, (void **)&arr_ptr, VX_READ_ONLY));
+	}
+
+	float xscale = 1.0f, yscale = 1.0f, xoffset = 0.0f, yoffset = 0.0f;
+	if (bBlockGain) {
+		xscale = (float)bg_width / output_width;
+		xoffset = (float)(xscale*0.5 - 0.5);
+		yscale = (float)bg_height / eqr_height_one;
+		yoffset = (float)(yscale*0.5 - 0.5);
+	}
+	vx_uint32 width = std::min(input_width, output_width);
+
+#pragma omp parallel for
+	for (int k = 0; k < (int)numitems; k++) {
+		vx_uint32 cam, dstX, dstY, end_x, end_y;
+		const vx_uint8 * entry_ptr = arr_ptr + k * arr_stride;
+		if (itemsize == sizeof(StitchExpCompCalcWideEntry)) {
+			const StitchExpCompCalcWideEntry * entry = (const StitchExpCompCalcWideEntry *)entry_ptr;
+			cam = entry->camId; dstX = entry->dstX; dstY = entry->dstY << 1; end_x = entry->end_x; end_y = entry->end_y;
+		}
+		else {
+			const StitchExpCompCalcEntry * entry = (const StitchExpCompCalcEntry *)entry_ptr;
+			cam = entry->camId; dstX = entry->dstX; dstY = entry->dstY << 1; end_x = entry->end_x; end_y = entry->end_y;
+		}
+		if (cam >= num_cam)
+			continue;
+		// per camera gains of the non block modes
+		const vx_float32 * ct = gains + cam * 12;
+		__m128 g4 = bRGBGain ? _mm_setr_ps(gains[cam * 3], gains[cam * 3 + 1], gains[cam * 3 + 2], 1.0f) : _mm_setr_ps(gains[cam], gains[cam], gains[cam], 1.0f);
+		for (vx_uint32 ly = 0; ly <= end_y && ly < 32; ly++) {
+			vx_uint32 gy = dstY + ly;
+			vx_int32 rowIn = camRowIn[cam] + (vx_int32)gy, rowOut = camRowOut[cam] + (vx_int32)gy;
+			if (rowIn < (vx_int32)(cam * height_one_in) || rowOut < (vx_int32)(cam * height_one_out))
+				continue;
+			if (rowIn >= (vx_int32)((cam + 1) * height_one_in) || rowOut >= (vx_int32)((cam + 1) * height_one_out))
+				break;
+			const vx_uint32 * src = (const vx_uint32 *)((const vx_uint8 *)input_ptr + rowIn * input_addr.stride_y);
+			vx_uint32 * dst = (vx_uint32 *)((vx_uint8 *)output_ptr + rowOut * output_addr.stride_y);
+			float fy0 = 0.0f, fy1 = 0.0f;
+			vx_size base = 0;
+			vx_uint32 nc = bRGBGain ? 3 : 1, ystride = bg_width * nc;
+			if (bBlockGain) {
+				float fy = gy * yscale + yoffset;
+				fy0 = floorf(fy); fy1 = fy - fy0; fy0 = 1.0f - fy1;
+				base = (vx_size)cam * bg_width * bg_height * nc + (vx_size)(fy > 0.0f ? (vx_uint32)fy : 0) * ystride;
+			}
+			for (vx_uint32 lx = 0; (lx << 3) < end_x && lx < 16; lx++) {
+				vx_uint32 x = (dstX + lx) << 3;
+				if (x + 8 > width)
+					break;
+				float fx = x * xscale + xoffset;
+				for (vx_uint32 i = 0; i < 8; i++, fx += xscale) {
+					vx_uint32 rgbx = src[x + i];
+					if (bBlockGain) {
+						float g[3];
+						ExpCompBlockGain(gains, gains_numitems, base, ystride, nc, fx, fy0, fy1, g);
+						// single gain applies to alpha too like the OpenCL kernel
+						dst[x + i] = ExpCompGainPixel(rgbx, bRGBGain ? _mm_setr_ps(g[0], g[1], g[2], 1.0f) : _mm_set1_ps(g[0]));
+					}
+					else if (bColorTransform) {
+						float r = (float)(rgbx & 0xff), g = (float)((rgbx >> 8) & 0xff), b = (float)((rgbx >> 16) & 0xff);
+						dst[x + i] = ExpCompPackPixel(_mm_setr_ps(r * ct[0] + g * ct[1] + b * ct[2] + ct[3],
+							r * ct[4] + g * ct[5] + b * ct[6] + ct[7], r * ct[8] + g * ct[9] + b * ct[10] + ct[11], (float)(rgbx >> 24)));
+					}
+					else {
+						dst[x + i] = ExpCompGainPixel(rgbx, g4);
+					}
+				}
+			}
+		}
+	}
+
+	if (numitems > 0) {
+		ERROR_CHECK_STATUS(vxCommitArrayRange(arr, 0, numitems, arr_ptr));
+	}
+	ERROR_CHECK_STATUS(vxCommitArrayRange(gains_arr, 0, gains_numitems, gains));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(output_image, &output_rect, 0, &output_addr, output_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(input_image, &input_rect, 0, &input_addr, input_ptr));
+	return VX_SUCCESS;
 }
 
 //! \brief The OpenCL global work updater callback.
@@ -641,8 +1110,10 @@ static vx_status VX_CALLBACK exposure_comp_applygains_opencl_codegen(
 	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &output_height, sizeof(output_height)));
 	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_FORMAT, &output_format, sizeof(output_format)));
 	ERROR_CHECK_STATUS(vxReleaseImage(&image));
+	vx_size wg_itemsize = 0;
 	vx_array wg_offsets = (vx_array)avxGetNodeParamRef(node, 2);
 	ERROR_CHECK_STATUS(vxQueryArray(wg_offsets, VX_ARRAY_ATTRIBUTE_CAPACITY, &wg_num, sizeof(wg_num)));
+	ERROR_CHECK_STATUS(vxQueryArray(wg_offsets, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &wg_itemsize, sizeof(wg_itemsize)));
 	ERROR_CHECK_STATUS(vxReleaseArray(&wg_offsets));
 	vx_uint32 num_cam = 0;
 	vx_scalar scalar = (vx_scalar)avxGetNodeParamRef(node, 3);			// input scalar - num cameras
@@ -667,6 +1138,17 @@ static vx_status VX_CALLBACK exposure_comp_applygains_opencl_codegen(
 	vx_uint32 height_one_in, height_one_out;
 	height_one_in = (vx_uint32)(input_height / num_cam);
 	height_one_out = (vx_uint32)(output_height / num_cam);
+	// packed images use camera plane rows and the camera height from the optional scalar for gain lookups
+	vx_array cam_plane_arr = (vx_array)avxGetNodeParamRef(node, 7);
+	bool packed = (cam_plane_arr != nullptr);
+	if (cam_plane_arr) ERROR_CHECK_STATUS(vxReleaseArray(&cam_plane_arr));
+	vx_uint32 eqr_height_one = height_one_out;
+	vx_scalar sc_eqr_height = (vx_scalar)avxGetNodeParamRef(node, 8);
+	bool bEqrHeight = (sc_eqr_height != nullptr);
+	if (sc_eqr_height) {
+		ERROR_CHECK_STATUS(vxReadScalarValue(sc_eqr_height, &eqr_height_one));
+		ERROR_CHECK_STATUS(vxReleaseScalar(&sc_eqr_height));
+	}
 	// set kernel configuration
 	strcpy(opencl_kernel_function_name, "exposure_comp_apply_gains");
 	opencl_work_dim = 2;
@@ -684,7 +1166,7 @@ static vx_status VX_CALLBACK exposure_comp_applygains_opencl_codegen(
 			xoffset = (vx_float32)(xscale*0.5 - 0.5);
 		}
 		if (bg_height >= 1){
-			yscale = (vx_float32)(bg_height*num_cam) / output_height;
+			yscale = (vx_float32)bg_height / eqr_height_one;
 			yoffset = (vx_float32)(yscale*0.5 - 0.5);
 		}
 		if (!bRGBGain){
@@ -723,14 +1205,14 @@ static vx_status VX_CALLBACK exposure_comp_applygains_opencl_codegen(
 				, (int)opencl_local_work[0], (int)opencl_local_work[1], opencl_kernel_function_name, height_one_in, height_one_out, xscale, yscale, xoffset, yoffset, bg_height);
 			opencl_kernel_code = item;
 			opencl_kernel_code +=
-				"	uint2 offs = ((__global uint2 *)(pExpData_buf+pExpData_offset))[grp_id];\n"
-				"	int cam_id = offs.s0&0x3f;\n"
+				"	EXPCOMP_ENTRY offs = ((__global EXPCOMP_ENTRY *)(pExpData_buf+pExpData_offset))[grp_id];\n"
+				"	int cam_id = EXPCOMP_CAM(offs);\n"
 				"	__global float *pGainBuf = (__global float *)(pG_buf + pG_offs);\n"
 				"	pGainBuf += (cam_id*size_bg);\n"
 				"	int  lx = get_local_id(0);\n"
 				"	int  ly = get_global_id(1);\n"
-				"   int   gx = lx + ((offs.s0 >> 6) & 0xFFF);\n"
-				"   int   gy = ly + (offs.s0 >> 17) ;\n"
+				"   int   gx = lx + EXPCOMP_X(offs);\n"
+				"   int   gy = ly + EXPCOMP_Y(offs);\n"
 				"   pIn_buf += pIn_offset + (size.x*cam_id) + mad24(gy, (int)pIn_stride, (gx<<5));\n"
 				"   pOut_buf += pOut_offset + (size.y*cam_id) + mad24(gy, (int)pOut_stride, (gx<<5));\n"
 				"   uchar4 offs4 = as_uchar4(offs.s1); \n"
@@ -799,14 +1281,14 @@ static vx_status VX_CALLBACK exposure_comp_applygains_opencl_codegen(
 				, (int)opencl_local_work[0], (int)opencl_local_work[1], opencl_kernel_function_name, height_one_in, height_one_out, xscale, yscale, xoffset, yoffset, bg_height);
 			opencl_kernel_code = item;
 			opencl_kernel_code +=
-				"	uint2 offs = ((__global uint2 *)(pExpData_buf+pExpData_offset))[grp_id];\n"
-				"	int cam_id = offs.s0&0x3f; uint gstride = bg_width*3;\n"
+				"	EXPCOMP_ENTRY offs = ((__global EXPCOMP_ENTRY *)(pExpData_buf+pExpData_offset))[grp_id];\n"
+				"	int cam_id = EXPCOMP_CAM(offs); uint gstride = bg_width*3;\n"
 				"	__global float *pGainBuf = (__global float *)(pG_buf + pG_offs);\n"
 				"	pGainBuf += (cam_id*size_bg);\n"
 				"	int  lx = get_local_id(0);\n"
 				"	int  ly = get_global_id(1);\n"
-				"   int   gx = lx + ((offs.s0 >> 6) & 0xFFF);\n"
-				"   int   gy = ly + (offs.s0 >> 17) ;\n"
+				"   int   gx = lx + EXPCOMP_X(offs);\n"
+				"   int   gy = ly + EXPCOMP_Y(offs);\n"
 				"   pIn_buf += pIn_offset + (size.x*cam_id) + mad24(gy, (int)pIn_stride, (gx<<5));\n"
 				"   pOut_buf += pOut_offset + (size.y*cam_id) + mad24(gy, (int)pOut_stride, (gx<<5));\n"
 				"   uchar4 offs4 = as_uchar4(offs.s1); \n"
@@ -871,14 +1353,14 @@ static vx_status VX_CALLBACK exposure_comp_applygains_opencl_codegen(
 			"  int grp_id = get_global_id(0)>>4;\n"
 			"  if (grp_id < pExpData_num) {\n"
 			"    uint2 size = (uint2)((pIn_stride*%d), (pOut_stride*%d));\n"
-			"    uint2 offs = ((__global uint2 *)(pExpData_buf+pExpData_offset))[grp_id];\n"
-			"    pG_buf += pG_offs; int cam_id = offs.s0&0x3f;\n"
+			"    EXPCOMP_ENTRY offs = ((__global EXPCOMP_ENTRY *)(pExpData_buf+pExpData_offset))[grp_id];\n"
+			"    pG_buf += pG_offs; int cam_id = EXPCOMP_CAM(offs);\n"
 			"    __global float4 * pg = (__global float4 *)pG_buf; pg += cam_id*3;\n"
 			"    float4 r4 = pg[0], g4 = pg[1], b4 = pg[2];\n"
 			"    int  lx = get_local_id(0);\n"
 			"    int  ly = get_global_id(1);\n"
-			"    int   gx = lx + ((offs.s0 >> 6) & 0xFFF);\n"
-			"    int   gy = ly + ((offs.s0 >> 18) << 1);\n"
+			"    int   gx = lx + EXPCOMP_X(offs);\n"
+			"    int   gy = ly + EXPCOMP_Y(offs);\n"
 			"    pIn_buf += pIn_offset + (size.x*cam_id) + mad24(gy, (int)pIn_stride, (gx<<5));\n"
 			"    pOut_buf += pOut_offset + (size.y*cam_id) + mad24(gy, (int)pOut_stride, (gx<<5));\n"
 			"    uchar4 offs4 = as_uchar4(offs.s1); \n"
@@ -920,8 +1402,8 @@ static vx_status VX_CALLBACK exposure_comp_applygains_opencl_codegen(
 			"	int grp_id = get_global_id(0)>>4;\n"
 			"   if (grp_id < pExpData_num) {\n"
 			"	uint2 size = (uint2)((pIn_stride*%d), (pOut_stride*%d));\n"
-			"	uint2 offs = ((__global uint2 *)(pExpData_buf+pExpData_offset))[grp_id];\n"
-			"	pG_buf += pG_offs; int cam_id = offs.s0&0x3f;\n"
+			"	EXPCOMP_ENTRY offs = ((__global EXPCOMP_ENTRY *)(pExpData_buf+pExpData_offset))[grp_id];\n"
+			"	pG_buf += pG_offs; int cam_id = EXPCOMP_CAM(offs);\n"
 			, (int)opencl_local_work[0], (int)opencl_local_work[1], opencl_kernel_function_name, height_one_in, height_one_out);
 		opencl_kernel_code = item;
 		if (bRGBGain){
@@ -938,8 +1420,8 @@ static vx_status VX_CALLBACK exposure_comp_applygains_opencl_codegen(
 		opencl_kernel_code +=
 			"	int  lx = get_local_id(0);\n"
 			"	int  ly = get_global_id(1);\n"
-			"   int   gx = lx + ((offs.s0 >> 6) & 0xFFF);\n"
-			"   int   gy = ly + ((offs.s0 >> 18) << 1);\n"
+			"   int   gx = lx + EXPCOMP_X(offs);\n"
+			"   int   gy = ly + EXPCOMP_Y(offs);\n"
 			"   pIn_buf += pIn_offset + (size.x*cam_id) + mad24(gy, (int)pIn_stride, (gx<<5));\n"
 			"   pOut_buf += pOut_offset + (size.y*cam_id) + mad24(gy, (int)pOut_stride, (gx<<5));\n"
 			"   uchar4 offs4 = as_uchar4(offs.s1); \n"
@@ -959,6 +1441,20 @@ static vx_status VX_CALLBACK exposure_comp_applygains_opencl_codegen(
 		"}\n"
 	"}\n";
 	}
+	// trailing optional arguments: camera planes and camera height
+	std::string args = GetCameraPlaneOpenCLArgs(packed);
+	if (bEqrHeight)
+		args += ", uint eqr_height_one";
+	size_t pos = opencl_kernel_code.find("uint pOut_offset)\n");
+	opencl_kernel_code.replace(pos, strlen("uint pOut_offset)\n"), "uint pOut_offset" + args + ")\n");
+	if (packed) {
+		for (pos = opencl_kernel_code.find("(size.x*cam_id)"); pos != std::string::npos; pos = opencl_kernel_code.find("(size.x*cam_id)", pos))
+			opencl_kernel_code.replace(pos, strlen("(size.x*cam_id)"), "CAM_ROW(cam_id)*(int)pIn_stride");
+		for (pos = opencl_kernel_code.find("(size.y*cam_id)"); pos != std::string::npos; pos = opencl_kernel_code.find("(size.y*cam_id)", pos))
+			opencl_kernel_code.replace(pos, strlen("(size.y*cam_id)"), "CAM_ROW(cam_id)*(int)pOut_stride");
+	}
+	char height1[16]; sprintf(height1, "%u", height_one_out);
+	opencl_kernel_code = exposure_comp_calc_entry_macros(wg_itemsize == sizeof(StitchExpCompCalcWideEntry)) + GetCameraPlaneOpenCLMacros(packed, height1) + opencl_kernel_code;
 	return VX_SUCCESS;
 }
 
@@ -969,7 +1465,7 @@ vx_status exposure_comp_applygains_publish(vx_context context)
 	vx_kernel kernel = vxAddKernel(context, "com.amd.loomsl.expcomp_applygains",
 		AMDOVX_KERNEL_STITCHING_EXPCOMP_APPLYGAINS,
 		exposure_comp_applygains_kernel,
-		6,
+		9,
 		exposure_comp_applygains_input_validator,
 		exposure_comp_applygains_output_validator,
 		nullptr,
@@ -989,6 +1485,8 @@ vx_status exposure_comp_applygains_publish(vx_context context)
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 4, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_OPTIONAL));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 5, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_OPTIONAL));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 6, VX_OUTPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 7, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_OPTIONAL));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 8, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_OPTIONAL));
 	// finalize and release kernel object
 	ERROR_CHECK_STATUS(vxFinalizeKernel(kernel));
 	ERROR_CHECK_STATUS(vxReleaseKernel(&kernel));
@@ -1061,6 +1559,19 @@ static vx_status VX_CALLBACK exposure_comp_solvegains_input_validator(vx_node no
 			vxAddLogEntry((vx_reference)node, status, "ERROR: exp_comp_solve matrix data types are not valid\n");
 		}
 	}
+	else if (index == 5)
+	{ // optional number of frames scalar of type VX_TYPE_UINT32
+		vx_enum type = VX_TYPE_INVALID;
+		ERROR_CHECK_STATUS(vxQueryScalar((vx_scalar)ref, VX_SCALAR_ATTRIBUTE_TYPE, &type, sizeof(type)));
+		if (type == VX_TYPE_UINT32) {
+			status = VX_SUCCESS;
+		}
+		else {
+			status = VX_ERROR_INVALID_TYPE;
+			vxAddLogEntry((vx_reference)node, status, "ERROR: exp_comp_solve number of frames scalar type should be an uint32\n");
+		}
+		ERROR_CHECK_STATUS(vxReleaseScalar((vx_scalar *)&ref));
+	}
 	return status;
 }
 
@@ -1105,6 +1616,13 @@ static vx_status VX_CALLBACK exposure_comp_solvegains_kernel(vx_node node, const
 	CExpCompensator* exp_comp = nullptr;
 	status = vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &exp_comp, sizeof(exp_comp)); if (status != VX_SUCCESS) return VX_FAILURE;
 
+	// optional number of frames summed in the intensity matrix
+	vx_uint32 num_frames = 1;
+	if (parameters[5]) {
+		ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[5], &num_frames));
+		num_frames = std::max(num_frames, 1u);
+	}
+
 	vx_scalar scalar = (vx_scalar)parameters[0];
 	ERROR_CHECK_STATUS(vxReadScalarValue(scalar, &alpha));
 	scalar = (vx_scalar)parameters[1];
@@ -1115,6 +1633,11 @@ static vx_status VX_CALLBACK exposure_comp_solvegains_kernel(vx_node node, const
 	ERROR_CHECK_STATUS(vxQueryMatrix(mat, VX_MATRIX_ATTRIBUTE_ROWS, &rows, sizeof(rows)));
 	pIMat = exp_comp->m_pIMat;
 	ERROR_CHECK_STATUS(vxReadMatrix(mat, (void *)pIMat));
+	if (num_frames > 1) {
+		// average the intensity sums of all frames
+		for (vx_size i = 0; i < rows * columns; i++)
+			pIMat[i] = (pIMat[i] + (num_frames >> 1)) / num_frames;
+	}
 	mat = (vx_matrix)parameters[3];
 	vx_size rows1 = 0;
 	ERROR_CHECK_STATUS(vxQueryMatrix(mat, VX_MATRIX_ATTRIBUTE_COLUMNS, &columns, sizeof(columns)));
@@ -1175,7 +1698,7 @@ vx_status exposure_comp_solvegains_publish(vx_context context)
 	vx_kernel kernel = vxAddKernel(context, "com.amd.loomsl.expcomp_solvegains",
 		AMDOVX_KERNEL_STITCHING_EXPCOMP_SOLVE,
 		exposure_comp_solvegains_kernel,
-		5,
+		6,
 		exposure_comp_solvegains_input_validator,
 		exposure_comp_solvegains_output_validator,
 		exposure_comp_solvegains_initialize,
@@ -1187,6 +1710,7 @@ vx_status exposure_comp_solvegains_publish(vx_context context)
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 2, VX_INPUT, VX_TYPE_MATRIX, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 3, VX_INPUT, VX_TYPE_MATRIX, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 4, VX_OUTPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 5, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_OPTIONAL));
 	// finalize and release kernel object
 	ERROR_CHECK_STATUS(vxFinalizeKernel(kernel));
 	ERROR_CHECK_STATUS(vxReleaseKernel(&kernel));
@@ -1235,7 +1759,7 @@ static vx_status VX_CALLBACK exposure_comp_calcRGBErrorFn_input_validator(vx_nod
 		vx_size capacity = 0;
 		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
 		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_CAPACITY, &capacity, sizeof(capacity)));
-		if (itemsize != sizeof(StitchOverlapPixelEntry)) {
+		if (itemsize != sizeof(StitchOverlapPixelEntry) && itemsize != sizeof(StitchOverlapPixelWideEntry)) {
 			status = VX_ERROR_INVALID_TYPE;
 			vxAddLogEntry((vx_reference)node, status, "ERROR: exposure_compensation gains array type should be float32\n");
 		}
@@ -1265,6 +1789,24 @@ static vx_status VX_CALLBACK exposure_comp_calcRGBErrorFn_input_validator(vx_nod
 		}
 		status = VX_SUCCESS;
 	}
+	else if (index == 5)
+	{ // optional array object of StitchCameraPlaneEntry type
+		if (ref) {
+			vx_size itemsize = 0;
+			ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
+			ERROR_CHECK_STATUS(vxReleaseArray((vx_array *)&ref));
+			if (itemsize != sizeof(StitchCameraPlaneEntry)) {
+				status = VX_ERROR_INVALID_DIMENSION;
+				vxAddLogEntry((vx_reference)node, status, "ERROR: exposure_compensation array element (StitchCameraPlaneEntry) size should be 16 bytes\n");
+			}
+			else {
+				status = VX_SUCCESS;
+			}
+		}
+		else {
+			status = VX_SUCCESS;
+		}
+	}
 	return status;
 }
 
@@ -1329,8 +1871,10 @@ static vx_status VX_CALLBACK exposure_comp_calcRGBErrorFn_opencl_codegen(
 	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &input_height, sizeof(input_height)));
 	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_FORMAT, &input_format, sizeof(input_format)));
 	ERROR_CHECK_STATUS(vxReleaseImage(&image));
+	vx_size arr_itemsize = 0;
 	vx_array exp_data = (vx_array)avxGetNodeParamRef(node, 2);
 	ERROR_CHECK_STATUS(vxQueryArray(exp_data, VX_ARRAY_ATTRIBUTE_CAPACITY, &arr_size, sizeof(arr_size)));
+	ERROR_CHECK_STATUS(vxQueryArray(exp_data, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &arr_itemsize, sizeof(arr_itemsize)));
 	ERROR_CHECK_STATUS(vxReleaseArray(&exp_data));
 	vx_image mask_image = (vx_image)avxGetNodeParamRef(node, 3);
 	if (mask_image != NULL){
@@ -1339,8 +1883,13 @@ static vx_status VX_CALLBACK exposure_comp_calcRGBErrorFn_opencl_codegen(
 		ERROR_CHECK_STATUS(vxQueryImage(mask_image, VX_IMAGE_ATTRIBUTE_FORMAT, &input_format, sizeof(input_format)));
 	}
 
+	vx_array cam_plane_arr = (vx_array)avxGetNodeParamRef(node, 5);
+	bool packed = (cam_plane_arr != nullptr);
+	if (cam_plane_arr) ERROR_CHECK_STATUS(vxReleaseArray(&cam_plane_arr));
+
 	// set kernel configuration
 	vx_uint32 height_one = (vx_uint32)(input_height / num_cameras);
+	char height1[16]; sprintf(height1, "%u", height_one);
 	strcpy(opencl_kernel_function_name, "exposure_comp_calc_errorRGBfn_mask");
 	opencl_work_dim = 2;
 	opencl_local_work[0] = 16;
@@ -1351,15 +1900,12 @@ static vx_status VX_CALLBACK exposure_comp_calcRGBErrorFn_opencl_codegen(
 	char item[8192];
 	opencl_kernel_code = 
 		// lookup table generated with gamma = 2.2
-		"__constant uchar g_Gamma2LinearLookUp[256] = { \n"
-		"	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, \n"
-		"	2, 3, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10, 10, 11, 11, 12,\n"
-		"	12, 13, 13, 13, 14, 14, 15, 15, 16, 16, 17, 17, 18, 18, 19, 19, 20, 21, 21, 22, 22, 23, 23, 24, 25, 25, 26, 27, 27, 28, 29, 29,\n"
-		"	30, 31, 31, 32, 33, 33, 34, 35, 36, 36, 37, 38, 39, 40, 40, 41, 42, 43, 44, 45, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 55,\n"
-		"	56, 57, 58, 59, 60, 61, 62, 63, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 77, 78, 79, 80, 81, 82, 84, 85, 86, 87, 88, 90, 91,\n"
-		"	92, 93, 95, 96, 97, 99, 100, 101, 103, 104, 105, 107, 108, 109, 111, 112, 114, 115, 117, 118, 119, 121, 122, 124, 125, 127, 128, 130, 131, 133, 135, 136,\n"
-		"	138, 139, 141, 142, 144, 146, 147, 149, 151, 152, 154, 156, 157, 159, 161, 162, 164, 166, 168, 169, 171, 173, 175, 176, 178, 180, 182, 184, 186, 187, 189, 191,\n"
-		"	193, 195, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221, 223, 225, 227, 229, 231, 233, 235, 237, 239, 241, 244, 246, 248, 250, 252, 255};\n";
+		"__constant uchar g_Gamma2LinearLookUp[256] = {";
+	for (int i = 0; i < 256; i++) {
+		sprintf(item, "%s%s%d", i ? "," : "", (i & 31) ? " " : "\n\t", g_Gamma2LinearLookUp[i]);
+		opencl_kernel_code += item;
+	}
+	opencl_kernel_code += "};\n";
 	if (mask_image){
 		sprintf(item,
 			"#pragma OPENCL EXTENSION cl_amd_media_ops : enable\n"
@@ -1369,17 +1915,15 @@ static vx_status VX_CALLBACK exposure_comp_calcRGBErrorFn_opencl_codegen(
 			"			uint	pIn_width, uint	pIn_height, __global uchar *pIn_buf, uint pIn_stride, uint	pIn_offs,\n"
 			"			__global uchar * exp_data, uint	exp_data_offs, uint exp_data_num,\n"
 			"			uint	pWt_width, uint	pWt_height, __global uchar *pWt_buf, uint pWt_stride, uint	pWt_offs,\n"
-			"			__global int * pAMat, uint cols, uint rows)\n"
+			"			__global int * pAMat, uint cols, uint rows%s)\n"
 			"{\n"
 			"	int grp_id = get_global_id(0)>>4;\n"
 			"   if (grp_id < exp_data_num) {\n"
 			"	__local uchar gamma2Linear[256];\n"
 			"	__local uint4 sumI[256], sumJ[256];\n"
-			"	uint2 offs = ((__global uint2 *)(exp_data+exp_data_offs))[grp_id];\n"
-			"	uint size = (uint)(pIn_stride*%d);\n"
-			"	uint wt_size = (uint)(pWt_stride*%d);\n"
+			"	OVERLAP_ENTRY offs = ((__global OVERLAP_ENTRY *)(exp_data+exp_data_offs))[grp_id];\n"
 			"	uint row1 = %d;\n"
-			, (int)opencl_local_work[0], (int)opencl_local_work[1], opencl_kernel_function_name, height_one, height_one, num_cameras);
+			, (int)opencl_local_work[0], (int)opencl_local_work[1], opencl_kernel_function_name, GetCameraPlaneOpenCLArgs(packed), num_cameras);
 		opencl_kernel_code += item;
 		opencl_kernel_code +=
 			"	int lx = get_local_id(0);\n"
@@ -1393,17 +1937,17 @@ static vx_status VX_CALLBACK exposure_comp_calcRGBErrorFn_opencl_codegen(
 			"		global uint *pI, *pJ;\n"
 			"		uint4 maskSrc, I, J, mask; \n"
 			"		uint4 Isum4, Jsum4;\n"
-			"		int   gx = (lx<<3) + ((offs.s0 >> 5) & 0x3FFF);\n"
-			"		int   gy = (ly<<1) + (offs.s0 >> 19);\n"
-			"		uint2 cam_id = (uint2)((offs.s0 & 0x1f), ((offs.s1>>12) & 0x1f));\n"
+			"		int   gx = (lx<<3) + OVERLAP_X(offs);\n"
+			"		int   gy = (ly<<1) + OVERLAP_Y(offs);\n"
+			"		uint2 cam_id = OVERLAP_CAM_IDS(offs);\n"
 			"		pIn_buf += pIn_offs + mad24(gy, (int)pIn_stride, (gx<<2));\n"
 			"		pWt_buf += pWt_offs + mad24(gy, (int)pWt_stride, gx);\n"
-			"		pI	   =  (global uint *)(pIn_buf + size*cam_id.x);\n"
-			"		pJ	   =  (global uint *)(pIn_buf + size*cam_id.y);\n"
-			"		maskSrc.s01	   =  *(global uint2 *)(pWt_buf + wt_size*cam_id.x);\n"
-			"		maskSrc.s01	   &=  *(global uint2 *)(pWt_buf + wt_size*cam_id.y); pWt_buf += pWt_stride;\n"
-			"		maskSrc.s23	   =  *(global uint2 *)(pWt_buf + wt_size*cam_id.x);\n"
-			"		maskSrc.s23	   &=  *(global uint2 *)(pWt_buf + wt_size*cam_id.y);\n"
+			"		pI	   =  (global uint *)(pIn_buf + CAM_ROW(cam_id.x)*(int)pIn_stride);\n"
+			"		pJ	   =  (global uint *)(pIn_buf + CAM_ROW(cam_id.y)*(int)pIn_stride);\n"
+			"		maskSrc.s01	   =  *(global uint2 *)(pWt_buf + CAM_ROW(cam_id.x)*(int)pWt_stride);\n"
+			"		maskSrc.s01	   &=  *(global uint2 *)(pWt_buf + CAM_ROW(cam_id.y)*(int)pWt_stride); pWt_buf += pWt_stride;\n"
+			"		maskSrc.s23	   =  *(global uint2 *)(pWt_buf + CAM_ROW(cam_id.x)*(int)pWt_stride);\n"
+			"		maskSrc.s23	   &=  *(global uint2 *)(pWt_buf + CAM_ROW(cam_id.y)*(int)pWt_stride);\n"
 			"		char4 maskIJ = as_char4(maskSrc.s0);\n"
 			"		I = vload4(0, pI);\n"
 			"		J = vload4(0, pJ); \n"
@@ -1493,16 +2037,15 @@ static vx_status VX_CALLBACK exposure_comp_calcRGBErrorFn_opencl_codegen(
 			"__kernel void %s(uint num_cameras,\n" // opencl_kernel_function_name
 			"			uint	pIn_width, uint	pIn_height, __global uchar *pIn_buf, uint pIn_stride, uint	pIn_offs,\n"
 			"			__global uchar * exp_data, uint	exp_data_offs, uint exp_data_num,\n"
-			"			__global int * pAMat, uint cols, uint rows)\n"
+			"			__global int * pAMat, uint cols, uint rows%s)\n"
 			"{\n"
 			"	int grp_id = get_global_id(0)>>4;\n"
 			"   if (grp_id < exp_data_num) {\n"
 			"	__local uchar gamma2Linear[256];\n"
 			"	__local uint4  sumI[256], sumJ[256];\n"
-			"	uint2 offs = ((__global uint2 *)(exp_data+exp_data_offs))[grp_id];\n"
-			"	uint size = (uint)(pIn_stride*%d);\n"
+			"	OVERLAP_ENTRY offs = ((__global OVERLAP_ENTRY *)(exp_data+exp_data_offs))[grp_id];\n"
 			"	uint row1 = %d;\n"
-			, (int)opencl_local_work[0], (int)opencl_local_work[1], opencl_kernel_function_name, height_one, num_cameras);
+			, (int)opencl_local_work[0], (int)opencl_local_work[1], opencl_kernel_function_name, GetCameraPlaneOpenCLArgs(packed), num_cameras);
 		opencl_kernel_code += item;
 		opencl_kernel_code +=
 			"	int lx = get_local_id(0);\n"
@@ -1516,12 +2059,12 @@ static vx_status VX_CALLBACK exposure_comp_calcRGBErrorFn_opencl_codegen(
 			"		global uint *pI, *pJ;\n"
 			"		uint4  I, J, mask; \n"
 			"		uint4 Isum4, Jsum4;\n"
-			"		int   gx = (lx<<3) + ((offs.s0 >> 5) & 0x3FFF);\n"
-			"		int   gy = (ly<<1) + (offs.s0 >> 19);\n"
-			"		uint2 cam_id = (uint2)((offs.s0 & 0x1f), ((offs.s1>>12) & 0x1f));\n"
+			"		int   gx = (lx<<3) + OVERLAP_X(offs);\n"
+			"		int   gy = (ly<<1) + OVERLAP_Y(offs);\n"
+			"		uint2 cam_id = OVERLAP_CAM_IDS(offs);\n"
 			"		pIn_buf += pIn_offs + mad24(gy, (int)pIn_stride, (gx<<2));\n"
-			"		pI	   =  (global uint *)(pIn_buf + size*cam_id.x);\n"
-			"		pJ	   =  (global uint *)(pIn_buf + size*cam_id.y);\n"
+			"		pI	   =  (global uint *)(pIn_buf + CAM_ROW(cam_id.x)*(int)pIn_stride);\n"
+			"		pJ	   =  (global uint *)(pIn_buf + CAM_ROW(cam_id.y)*(int)pIn_stride);\n"
 			"		I = vload4(0, pI);\n"
 			"		J = vload4(0, pJ); \n"
 			"		mask.s0	= select(0xffffffff, 0u, ((I.s0==0x80000000) | (J.s0==0x80000000)));\n"
@@ -1662,6 +2205,7 @@ static vx_status VX_CALLBACK exposure_comp_calcRGBErrorFn_opencl_codegen(
 		"	}\n"
 		"	}\n"
 		"}\n";
+	opencl_kernel_code = exposure_comp_overlap_entry_macros(arr_itemsize == sizeof(StitchOverlapPixelWideEntry)) + GetCameraPlaneOpenCLMacros(packed, height1) + opencl_kernel_code;
 	if (mask_image)ERROR_CHECK_STATUS(vxReleaseImage(&mask_image));
 	return VX_SUCCESS;
 }
@@ -1669,7 +2213,36 @@ static vx_status VX_CALLBACK exposure_comp_calcRGBErrorFn_opencl_codegen(
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK exposure_comp_calcRGBErrorFn_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_SUPPORTED;
+	ExpCompLinearScratch * scratch = nullptr;
+	ERROR_CHECK_STATUS(vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &scratch, sizeof(scratch)));
+	if (!scratch)
+		return VX_ERROR_NOT_ALLOCATED;
+	return ExpCompCalcErrorFnCPU(parameters, scratch);
+}
+
+//! \brief The kernel initialize: allocate scratch rows of each thread for CPU execution.
+static vx_status VX_CALLBACK exposure_comp_calcRGBErrorFn_initialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	vx_uint32 width = 0;
+	ERROR_CHECK_STATUS(vxQueryImage((vx_image)parameters[1], VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ExpCompLinearScratch * scratch = new ExpCompLinearScratch;
+	scratch->width = width;
+	scratch->rows.resize(omp_get_max_threads());
+	for (size_t i = 0; i < scratch->rows.size(); i++)
+		scratch->rows[i].resize((size_t)width << 3);
+	vx_size size = sizeof(ExpCompLinearScratch);
+	ERROR_CHECK_STATUS(vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &size, sizeof(size)));
+	ERROR_CHECK_STATUS(vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &scratch, sizeof(scratch)));
+	return VX_SUCCESS;
+}
+
+//! \brief The kernel uninitialize.
+static vx_status VX_CALLBACK exposure_comp_calcRGBErrorFn_uninitialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	ExpCompLinearScratch * scratch = nullptr;
+	ERROR_CHECK_STATUS(vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &scratch, sizeof(scratch)));
+	delete scratch;
+	return VX_SUCCESS;
 }
 
 
@@ -1680,11 +2253,11 @@ vx_status exposure_comp_calcRGBErrorFn_publish(vx_context context)
 	vx_kernel kernel = vxAddKernel(context, "com.amd.loomsl.expcomp_compute_gainmatrix_rgb",
 		AMDOVX_KERNEL_STITCHING_EXPCOMP_COMPUTE_GAINMAT_RGB,
 		exposure_comp_calcRGBErrorFn_kernel,
-		5,
+		6,
 		exposure_comp_calcRGBErrorFn_input_validator,
 		exposure_comp_calcRGBErrorFn_output_validator,
-		nullptr,
-		nullptr);
+		exposure_comp_calcRGBErrorFn_initialize,
+		exposure_comp_calcRGBErrorFn_uninitialize);
 	ERROR_CHECK_OBJECT(kernel);
 	// set codegen for opencl
 	amd_kernel_query_target_support_f query_target_support_f = exposure_comp_calcErrorFn_query_target_support;
@@ -1699,6 +2272,7 @@ vx_status exposure_comp_calcRGBErrorFn_publish(vx_context context)
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 2, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 3, VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_OPTIONAL));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 4, VX_OUTPUT, VX_TYPE_MATRIX, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 5, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_OPTIONAL));
 	// finalize and release kernel object
 	ERROR_CHECK_STATUS(vxFinalizeKernel(kernel));
 	ERROR_CHECK_STATUS(vxReleaseKernel(&kernel));
@@ -1730,12 +2304,12 @@ vx_status CalculateSmallestExpCompBufferSizes(
 	vx_uint32 numCamera,                           // [in] number of cameras
 	vx_uint32 eqrWidth,                            // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                           // [in] output equirectangular image height
-	const vx_uint32 * validPixelCamMap,            // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,            // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
 	const vx_rectangle_t * const * overlapValid,   // [in] overlap regions: overlapValid[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i
-	const vx_uint32 * validCamOverlapInfo,         // [in] camera overlap info - use "validCamOverlapInfo[cam_i] & (1 << cam_j)": size: [32]
-	const vx_uint32 * paddedPixelCamMap,           // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
+	const vx_uint64 * validCamOverlapInfo,         // [in] camera overlap info - use "validCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
+	const vx_uint64 * paddedPixelCamMap,           // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
 	const vx_rectangle_t * const * overlapPadded,  // [in] overlap regions: overlapPadded[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i(optional)
-	const vx_uint32 * paddedCamOverlapInfo,        // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & (1 << cam_j)": size: [32](optional)
+	const vx_uint64 * paddedCamOverlapInfo,        // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS](optional)
 	vx_size * validTableEntryCount,                // [out] number of entries needed by expComp valid table
 	vx_size * overlapTableEntryCount               // [out] number of entries needed by expComp overlap table
 	)
@@ -1745,7 +2319,7 @@ vx_status CalculateSmallestExpCompBufferSizes(
 	// count validTable entries
 	vx_uint32 validEntryCount = 0;
 	for (vx_uint32 i = 0; i < numCamera; i++) {
-		vx_uint32 camMaskBit = (1 << i);
+		vx_uint64 camMaskBit = StitchCameraBit(i);
 		vx_uint32 start_x = overlapValid[i][i].start_x, end_x = overlapValid[i][i].end_x;
 		vx_uint32 start_y = overlapValid[i][i].start_y, end_y = overlapValid[i][i].end_y;
 		if ((start_x < end_x) && (start_y < end_y))	{
@@ -1777,7 +2351,7 @@ vx_status CalculateSmallestExpCompBufferSizes(
 	vx_uint32 overlapEntryCount = 0;
 	for (vx_uint32 i = 1; i < numCamera; i++) {
 		for (vx_uint32 j = 0; j < i; j++) {
-			vx_uint32 overlapMaskBits = (1 << i) | (1 << j);
+			vx_uint64 overlapMaskBits = StitchCameraBit(i) | StitchCameraBit(j);
 			vx_uint32 start_x = overlapRegion[i][j].start_x, end_x = overlapRegion[i][j].end_x;
 			vx_uint32 start_y = overlapRegion[i][j].start_y, end_y = overlapRegion[i][j].end_y;
 			if ((start_x < end_x) && (start_y < end_y))	{
@@ -1817,27 +2391,30 @@ vx_status GenerateExpCompBuffers(
 	vx_uint32 numCamera,                           // [in] number of cameras
 	vx_uint32 eqrWidth,                            // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                           // [in] output equirectangular image height
-	const vx_uint32 * validPixelCamMap,            // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,            // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
 	const vx_rectangle_t * const * overlapValid,   // [in] overlap regions: overlapValid[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i
-	const vx_uint32 * validCamOverlapInfo,         // [in] camera overlap info - use "validCamOverlapInfo[cam_i] & (1 << cam_j)": size: [32]
-	const vx_uint32 * paddedPixelCamMap,           // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
+	const vx_uint64 * validCamOverlapInfo,         // [in] camera overlap info - use "validCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
+	const vx_uint64 * paddedPixelCamMap,           // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
 	const vx_rectangle_t * const * overlapPadded,  // [in] overlap regions: overlapPadded[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i(optional)
-	const vx_uint32 * paddedCamOverlapInfo,        // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & (1 << cam_j)": size: [32](optional)
+	const vx_uint64 * paddedCamOverlapInfo,        // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS](optional)
 	vx_size validTableSize,                        // [in] size of valid table, in terms of number of entries
 	vx_size overlapTableSize,                      // [in] size of overlap table, in terms of number of entries
 	StitchExpCompCalcEntry * validTable,           // [out] expComp valid table
 	StitchOverlapPixelEntry * overlapTable,        // [out] expComp overlap table
+	StitchExpCompCalcWideEntry * validTableWide,   // [out] expComp wide valid table (optional)
+	StitchOverlapPixelWideEntry * overlapTableWide, // [out] expComp wide overlap table (optional)
 	vx_size * validTableEntryCount,                // [out] number of entries needed by expComp valid table
 	vx_size * overlapTableEntryCount,              // [out] number of entries needed by expComp overlap table
 	vx_int32 * overlapPixelCountMatrix             // [out] expComp overlap pixel count matrix: size: [numCamera * numCamera]
 	)
 {
 	const vx_rectangle_t * const * overlapRegion = paddedPixelCamMap ? overlapPadded : overlapValid;
+	bool useOverlapTable = (overlapTable || overlapTableWide);
 
 	// generate validTable
 	vx_uint32 validEntryCount = 0;
 	for (vx_uint32 i = 0; i < numCamera; i++) {
-		vx_uint32 camMaskBit = (1 << i);
+		vx_uint64 camMaskBit = StitchCameraBit(i);
 		vx_uint32 start_x = overlapValid[i][i].start_x, end_x = overlapValid[i][i].end_x;
 		vx_uint32 start_y = overlapValid[i][i].start_y, end_y = overlapValid[i][i].end_y;
 		if ((start_x < end_x) && (start_y < end_y))	{
@@ -1859,7 +2436,18 @@ vx_status GenerateExpCompBuffers(
 					}
 					if (count > 0) {
 						// add valid entry
-						if (validEntryCount < validTableSize){
+						if (validEntryCount < validTableSize && validTableWide) {
+							StitchExpCompCalcWideEntry validEntry;
+							validEntry.camId = i;
+							validEntry.dstX = (xs >> 3);
+							validEntry.dstY = (ys >> 1);
+							validEntry.start_x = xs & 7;
+							validEntry.start_y = ys & 1;
+							validEntry.end_x = xe - xs - 1;
+							validEntry.end_y = ye - ys - 1;
+							validTableWide[validEntryCount] = validEntry;
+						}
+						else if (validEntryCount < validTableSize){
 							StitchExpCompCalcEntry validEntry;
 							validEntry.camId = i;
 							validEntry.dstX = (xs >> 3);
@@ -1882,7 +2470,7 @@ vx_status GenerateExpCompBuffers(
 	vx_uint32 overlapEntryCount = 0;
 	for (vx_uint32 i = 1; i < numCamera; i++) {
 		for (vx_uint32 j = 0; j < i; j++) {
-			vx_uint32 overlapMaskBits = (1 << i) | (1 << j);
+			vx_uint64 overlapMaskBits = StitchCameraBit(i) | StitchCameraBit(j);
 			vx_uint32 start_x = overlapRegion[i][j].start_x, end_x = overlapRegion[i][j].end_x;
 			vx_uint32 start_y = overlapRegion[i][j].start_y, end_y = overlapRegion[i][j].end_y;
 			if ((start_x < end_x) && (start_y < end_y))	{
@@ -1903,8 +2491,21 @@ vx_status GenerateExpCompBuffers(
 							overlapPixelCountMatrix[i * numCamera + j] += count;
 							overlapPixelCountMatrix[j * numCamera + i] += count;
 							// add overlapTable entry
-							if (overlapTable){
-								if (overlapEntryCount < overlapTableSize) {
+							if (useOverlapTable){
+								if (overlapEntryCount < overlapTableSize && overlapTableWide) {
+									StitchOverlapPixelWideEntry overlapEntry = { 0 };
+									overlapEntry.camId0 = i;
+									overlapEntry.start_x = xs;
+									overlapEntry.start_y = ys;
+									overlapEntry.end_x = xe - xs - 1;
+									overlapEntry.end_y = ye - ys - 1;
+									overlapEntry.camId1 = j;
+									overlapEntry.camId2 = 0xFF;
+									overlapEntry.camId3 = 0xFF;
+									overlapEntry.camId4 = 0xFF;
+									overlapTableWide[overlapEntryCount] = overlapEntry;
+								}
+								else if (overlapEntryCount < overlapTableSize) {
 									StitchOverlapPixelEntry overlapEntry;
 									overlapEntry.camId0 = i;
 									overlapEntry.start_x = xs;
@@ -1927,7 +2528,7 @@ vx_status GenerateExpCompBuffers(
 	}
 
 	// check for buffer overflow error condition and updated output entry counts
-	if (validEntryCount > validTableSize || (overlapTable && (overlapEntryCount > overlapTableSize))) {
+	if (validEntryCount > validTableSize || (useOverlapTable && (overlapEntryCount > overlapTableSize))) {
 		return VX_ERROR_NOT_SUFFICIENT;
 	}
 	*validTableEntryCount = validEntryCount;
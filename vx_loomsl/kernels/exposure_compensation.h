@@ -24,6 +24,7 @@ THE SOFTWARE.
 #define __EXPOSURE_COMPENSATION_H__
 
 #include "exp_comp.h"
+#include "warp.h"
 
 //////////////////////////////////////////////////////////////////////
 //! \brief The exposure comp calc entry.
@@ -51,6 +52,40 @@ typedef struct {
 	vx_uint32 camId4  :  5; // values [0..30] overlapping cameraId; 31 indicates invalid cameraId
 } StitchOverlapPixelEntry;
 
+//////////////////////////////////////////////////////////////////////
+//! \brief The wide exposure comp calc entry.
+//  Used instead of StitchExpCompCalcEntry with wide tables: second word has same layout as StitchExpCompCalcEntry.
+typedef struct {
+	vx_uint32 camId;        // destination buffer/camera ID
+	vx_uint32 start_x :  8; // starting pixel x-coordinate within the 128x32 block
+	vx_uint32 start_y :  8; // starting pixel y-coordinate within the 128x32 block
+	vx_uint32 end_x   :  8; // ending pixel x-coordinate within the 128x32 block
+	vx_uint32 end_y   :  8; // ending pixel y-coordinate within the 128x32 block
+	vx_uint32 dstX;         // destination pixel x-coordinate/8 (integer)
+	vx_uint32 dstY;         // destination pixel y-coordinate/2 (integer)
+} StitchExpCompCalcWideEntry;
+
+//////////////////////////////////////////////////////////////////////
+//! \brief The wide overlap pixel entry.
+//  Used instead of StitchOverlapPixelEntry with wide tables: end_x and end_y are at same position as in StitchOverlapPixelEntry.
+typedef struct {
+	vx_uint32 camId0    :  8; // destination buffer/camera ID
+	vx_uint32 camId1    :  8; // values [0..254] overlapping cameraId; 255 indicates invalid cameraId
+	vx_uint32 camId2    :  8; // values [0..254] overlapping cameraId; 255 indicates invalid cameraId
+	vx_uint32 camId3    :  8; // values [0..254] overlapping cameraId; 255 indicates invalid cameraId
+	vx_uint32 end_x     :  7; // ending pixel x-coordinate within the 128x32 block
+	vx_uint32 end_y     :  5; // ending pixel y-coordinate within the 128x32 block
+	vx_uint32 camId4    :  8; // values [0..254] overlapping cameraId; 255 indicates invalid cameraId
+	vx_uint32 reserved0 : 12; // reserved (shall be zero)
+	vx_uint32 start_x;        // destination start pixel x-coordinate
+	vx_uint32 start_y;        // destination start pixel y-coordinate
+} StitchOverlapPixelWideEntry;
+
+//////////////////////////////////////////////////////////////////////
+//! \brief The limits of compact exposure comp tables
+#define STITCH_EXPCOMP_COMPACT_MAX_DST_WIDTH   16384 // StitchOverlapPixelEntry::start_x has 14 bits
+#define STITCH_EXPCOMP_COMPACT_MAX_DST_HEIGHT   8192 // StitchOverlapPixelEntry::start_y has 13 bits
+
 //////////////////////////////////////////////////////////////////////
 //! \brief The kernel registration functions.
 vx_status exposure_comp_calcErrorFn_publish(vx_context context);
@@ -62,7 +97,8 @@ vx_status exposure_comp_calcRGBErrorFn_publish(vx_context context);
 // Calculate buffer sizes and generate data in buffers for exposure compensation
 //   CalculateLargestExpCompBufferSizes  - useful when reinitialize is enabled
 //   CalculateSmallestExpCompBufferSizes - useful when reinitialize is disabled
-//   GenerateExpCompBuffers              - generate tables
+//   GenerateExpCompBuffers              - generate tables: validTableWide and overlapTableWide are used instead of
+//                                         validTable and overlapTable when not NULL
 
 vx_status CalculateLargestExpCompBufferSizes(
 	vx_uint32 numCamera,                    // [in] number of cameras
@@ -76,12 +112,12 @@ vx_status CalculateSmallestExpCompBufferSizes(
 	vx_uint32 numCamera,                           // [in] number of cameras
 	vx_uint32 eqrWidth,                            // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                           // [in] output equirectangular image height
-	const vx_uint32 * validPixelCamMap,            // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,            // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
 	const vx_rectangle_t * const * overlapValid,   // [in] overlap regions: overlapValid[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i
-	const vx_uint32 * validCamOverlapInfo,         // [in] camera overlap info - use "validCamOverlapInfo[cam_i] & (1 << cam_j)": size: [32]
-	const vx_uint32 * paddedPixelCamMap,           // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
+	const vx_uint64 * validCamOverlapInfo,         // [in] camera overlap info - use "validCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
+	const vx_uint64 * paddedPixelCamMap,           // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
 	const vx_rectangle_t * const * overlapPadded,  // [in] overlap regions: overlapPadded[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i(optional)
-	const vx_uint32 * paddedCamOverlapInfo,        // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & (1 << cam_j)": size: [32](optional)
+	const vx_uint64 * paddedCamOverlapInfo,        // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS](optional)
 	vx_size * validTableEntryCount,                // [out] number of entries needed by expComp valid table
 	vx_size * overlapTableEntryCount               // [out] number of entries needed by expComp overlap table
 	);
@@ -90,16 +126,18 @@ vx_status GenerateExpCompBuffers(
 	vx_uint32 numCamera,                           // [in] number of cameras
 	vx_uint32 eqrWidth,                            // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                           // [in] output equirectangular image height
-	const vx_uint32 * validPixelCamMap,            // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,            // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
 	const vx_rectangle_t * const * overlapValid,   // [in] overlap regions: overlapValid[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i
-	const vx_uint32 * validCamOverlapInfo,         // [in] camera overlap info - use "validCamOverlapInfo[cam_i] & (1 << cam_j)": size: [32]
-	const vx_uint32 * paddedPixelCamMap,           // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
+	const vx_uint64 * validCamOverlapInfo,         // [in] camera overlap info - use "validCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
+	const vx_uint64 * paddedPixelCamMap,           // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
 	const vx_rectangle_t * const * overlapPadded,  // [in] overlap regions: overlapPadded[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i(optional)
-	const vx_uint32 * paddedCamOverlapInfo,        // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & (1 << cam_j)": size: [32](optional)
+	const vx_uint64 * paddedCamOverlapInfo,        // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS](optional)
 	vx_size validTableSize,                        // [in] size of valid table, in terms of number of entries
 	vx_size overlapTableSize,                      // [in] size of overlap table, in terms of number of entries
 	StitchExpCompCalcEntry * validTable,           // [out] expComp valid table
 	StitchOverlapPixelEntry * overlapTable,        // [out] expComp overlap table
+	StitchExpCompCalcWideEntry * validTableWide,   // [out] expComp wide valid table (optional)
+	StitchOverlapPixelWideEntry * overlapTableWide, // [out] expComp wide overlap table (optional)
 	vx_size * validTableEntryCount,                // [out] number of entries needed by expComp valid table
 	vx_size * overlapTableEntryCount,              // [out] number of entries needed by expComp overlap table
 	vx_int32 * overlapPixelCountMatrix             // [out] expComp overlap pixel count matrix: size: [numCamera * numCamera]
@@ -0,0 +1,210 @@
+/*
+Copyright (c) 2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "half_scale_rgb.h"
+
+//! \brief The input validator callback.
+static vx_status VX_CALLBACK half_scale_rgb_input_validator(vx_node node, vx_uint32 index)
+{
+	vx_status status = VX_ERROR_INVALID_PARAMETERS;
+	// get reference for parameter at specified index
+	vx_reference ref = avxGetNodeParamRef(node, index);
+	ERROR_CHECK_OBJECT(ref);
+	// validate each parameter
+	if (index == 0)
+	{ // image of format RGB
+		vx_df_image format = VX_DF_IMAGE_VIRT;
+		ERROR_CHECK_STATUS(vxQueryImage((vx_image)ref, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format)));
+		if (format == VX_DF_IMAGE_RGB) {
+			status = VX_SUCCESS;
+		}
+		else {
+			status = VX_ERROR_INVALID_TYPE;
+			vxAddLogEntry((vx_reference)node, status, "ERROR: half_scale_rgb doesn't support input image format: %4.4s\n", &format);
+		}
+		ERROR_CHECK_STATUS(vxReleaseImage((vx_image *)&ref));
+	}
+	return status;
+}
+
+//! \brief The output validator callback.
+static vx_status VX_CALLBACK half_scale_rgb_output_validator(vx_node node, vx_uint32 index, vx_meta_format meta)
+{
+	vx_status status = VX_ERROR_INVALID_PARAMETERS;
+	if (index == 1)
+	{ // image of format RGB with half the input dimensions
+		vx_image image = (vx_image)avxGetNodeParamRef(node, 0);
+		ERROR_CHECK_OBJECT(image);
+		vx_uint32 input_width = 0, input_height = 0;
+		ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_WIDTH, &input_width, sizeof(input_width)));
+		ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &input_height, sizeof(input_height)));
+		ERROR_CHECK_STATUS(vxReleaseImage(&image));
+		image = (vx_image)avxGetNodeParamRef(node, index);
+		ERROR_CHECK_OBJECT(image);
+		vx_uint32 output_width = 0, output_height = 0;
+		vx_df_image output_format = VX_DF_IMAGE_VIRT;
+		ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_WIDTH, &output_width, sizeof(output_width)));
+		ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &output_height, sizeof(output_height)));
+		ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_FORMAT, &output_format, sizeof(output_format)));
+		ERROR_CHECK_STATUS(vxReleaseImage(&image));
+		if (output_width != ((input_width + 1) >> 1) || output_height != ((input_height + 1) >> 1))
+		{
+			status = VX_ERROR_INVALID_DIMENSION;
+			vxAddLogEntry((vx_reference)node, status, "ERROR: half_scale_rgb output image should be %dx%d (got %dx%d)\n",
+				(input_width + 1) >> 1, (input_height + 1) >> 1, output_width, output_height);
+			return status;
+		}
+		output_format = VX_DF_IMAGE_RGB;
+		// set output image meta data
+		ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(meta, VX_IMAGE_ATTRIBUTE_WIDTH, &output_width, sizeof(output_width)));
+		ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(meta, VX_IMAGE_ATTRIBUTE_HEIGHT, &output_height, sizeof(output_height)));
+		ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(meta, VX_IMAGE_ATTRIBUTE_FORMAT, &output_format, sizeof(output_format)));
+		status = VX_SUCCESS;
+	}
+	return status;
+}
+
+//! \brief The kernel target support callback.
+static vx_status VX_CALLBACK half_scale_rgb_query_target_support(vx_graph graph, vx_node node,
+	vx_bool use_opencl_1_2,              // [input]  false: OpenCL driver is 2.0+; true: OpenCL driver is 1.2
+	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
+	)
+{
+	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	return VX_SUCCESS;
+}
+
+//! \brief The OpenCL code generator callback.
+static vx_status VX_CALLBACK half_scale_rgb_opencl_codegen(
+	vx_node node,                                  // [input] node
+	const vx_reference parameters[],               // [input] parameters
+	vx_uint32 num,                                 // [input] number of parameters
+	bool opencl_load_function,                     // [input]  false: normal OpenCL kernel; true: reserved
+	char opencl_kernel_function_name[64],          // [output] kernel_name for clCreateKernel()
+	std::string& opencl_kernel_code,               // [output] string for clCreateProgramWithSource()
+	std::string& opencl_build_options,             // [output] options for clBuildProgram()
+	vx_uint32& opencl_work_dim,                    // [output] work_dim for clEnqueueNDRangeKernel()
+	vx_size opencl_global_work[],                  // [output] global_work[] for clEnqueueNDRangeKernel()
+	vx_size opencl_local_work[],                   // [output] local_work[] for clEnqueueNDRangeKernel()
+	vx_uint32& opencl_local_buffer_usage_mask,     // [output] reserved: must be ZERO
+	vx_uint32& opencl_local_buffer_size_in_bytes   // [output] reserved: must be ZERO
+	)
+{
+	// get output image configuration
+	vx_uint32 output_width = 0, output_height = 0;
+	vx_image image = (vx_image)avxGetNodeParamRef(node, 1);
+	ERROR_CHECK_OBJECT(image);
+	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_WIDTH, &output_width, sizeof(output_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &output_height, sizeof(output_height)));
+	ERROR_CHECK_STATUS(vxReleaseImage(&image));
+
+	// set kernel configuration: each work item generates 4 output pixels from 8x2 input pixels
+	vx_uint32 work_items[2] = { (output_width + 3) / 4, output_height };
+	strcpy(opencl_kernel_function_name, "half_scale_rgb");
+	opencl_work_dim = 2;
+	opencl_local_work[0] = 16;
+	opencl_local_work[1] = 4;
+	opencl_global_work[0] = (work_items[0] + opencl_local_work[0] - 1) & ~(opencl_local_work[0] - 1);
+	opencl_global_work[1] = (work_items[1] + opencl_local_work[1] - 1) & ~(opencl_local_work[1] - 1);
+
+	// Setting variables required by the interface
+	opencl_local_buffer_usage_mask = 0;
+	opencl_local_buffer_size_in_bytes = 0;
+
+	// 2x2 box filter: full groups of 4 output pixels use 24-byte row loads, the right edge falls back to per pixel access
+	char item[8192];
+	sprintf(item,
+		"__kernel __attribute__((reqd_work_group_size(%d, %d, 1)))\n" // opencl_local_work[0], opencl_local_work[1]
+		"void %s(uint ip_width, uint ip_height, __global uchar * ip_buf, uint ip_stride, uint ip_offset,\n" // opencl_kernel_function_name
+		"        uint op_width, uint op_height, __global uchar * op_buf, uint op_stride, uint op_offset)\n"
+		"{\n"
+		"  int gx = get_global_id(0);\n"
+		"  int gy = get_global_id(1);\n"
+		"  if ((gx < %d) && (gy < %d)) {\n" // work_items[0], work_items[1]
+		"    __global uchar * ip0 = ip_buf + ip_offset + (gy << 1) * ip_stride;\n"
+		"    __global uchar * ip1 = ip_buf + ip_offset + min((gy << 1) + 1, (int)ip_height - 1) * ip_stride;\n"
+		"    __global uchar * op = op_buf + op_offset + gy * op_stride + gx * 12;\n"
+		"    uint x = gx << 2;\n"
+		"    if ((x + 4 <= op_width) && ((x << 1) + 8 <= ip_width)) {\n"
+		"      ip0 += gx * 24; ip1 += gx * 24;\n"
+		"      ushort16 a = convert_ushort16(as_uchar16(vload4(0, (__global uint *) ip0))) + convert_ushort16(as_uchar16(vload4(0, (__global uint *) ip1)));\n"
+		"      ushort8 b = convert_ushort8(as_uchar8(vload2(2, (__global uint *) ip0))) + convert_ushort8(as_uchar8(vload2(2, (__global uint *) ip1)));\n"
+		"      ushort4 t0 = (ushort4)(a.s0 + a.s3, a.s1 + a.s4, a.s2 + a.s5, a.s6 + a.s9);\n"
+		"      ushort4 t1 = (ushort4)(a.s7 + a.sa, a.s8 + a.sb, a.sc + a.sf, a.sd + b.s0);\n"
+		"      ushort4 t2 = (ushort4)(a.se + b.s1, b.s2 + b.s5, b.s3 + b.s6, b.s4 + b.s7);\n"
+		"      uint3 o;\n"
+		"      o.s0 = as_uint(convert_uchar4((t0 + (ushort4)2) >> (ushort4)2));\n"
+		"      o.s1 = as_uint(convert_uchar4((t1 + (ushort4)2) >> (ushort4)2));\n"
+		"      o.s2 = as_uint(convert_uchar4((t2 + (ushort4)2) >> (ushort4)2));\n"
+		"      vstore3(o, 0, (__global uint *) op);\n"
+		"    }\n"
+		"    else {\n"
+		"      for (uint i = 0; i < 4 && x + i < op_width; i++) {\n"
+		"        uint x0 = (x + i) << 1, x1 = min(x0 + 1, ip_width - 1);\n"
+		"        ushort3 s = convert_ushort3(vload3(x0, ip0)) + convert_ushort3(vload3(x1, ip0)) + convert_ushort3(vload3(x0, ip1)) + convert_ushort3(vload3(x1, ip1));\n"
+		"        vstore3(convert_uchar3((s + (ushort3)2) >> (ushort3)2), i, op);\n"
+		"      }\n"
+		"    }\n"
+		"  }\n"
+		"}\n"
+		, (int)opencl_local_work[0], (int)opencl_local_work[1], opencl_kernel_function_name, work_items[0], work_items[1]);
+	opencl_kernel_code = item;
+
+	return VX_SUCCESS;
+}
+
+//! \brief The kernel execution.
+static vx_status VX_CALLBACK half_scale_rgb_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
+{
+	return VX_ERROR_NOT_SUPPORTED;
+}
+
+//! \brief The kernel publisher.
+vx_status half_scale_rgb_publish(vx_context context)
+{
+	// add kernel to the context with callbacks
+	vx_kernel kernel = vxAddKernel(context, "com.amd.loomsl.half_scale_rgb",
+		AMDOVX_KERNEL_STITCHING_HALF_SCALE_RGB,
+		half_scale_rgb_kernel,
+		2,
+		half_scale_rgb_input_validator,
+		half_scale_rgb_output_validator,
+		nullptr,
+		nullptr);
+	ERROR_CHECK_OBJECT(kernel);
+	amd_kernel_query_target_support_f query_target_support_f = half_scale_rgb_query_target_support;
+	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = half_scale_rgb_opencl_codegen;
+	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
+	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
+
+	// set kernel parameters
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 1, VX_OUTPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
+
+	// finalize and release kernel object
+	ERROR_CHECK_STATUS(vxFinalizeKernel(kernel));
+	ERROR_CHECK_STATUS(vxReleaseKernel(&kernel));
+
+	return VX_SUCCESS;
+}
@@ -24,12 +24,15 @@ THE SOFTWARE.
 #include "chroma_key.h"
 #include "color_convert.h"
 #include "warp.h"
+#include "warp_merge.h"
 #include "seam_find.h"
 #include "exposure_compensation.h"
 #include "multiband_blender.h"
 #include "pyramid_scale.h"
 #include "merge.h"
 #include "alpha_blend.h"
+#include "overlay_blend.h"
+#include "half_scale_rgb.h"
 #include "noise_filter.h"
 #include "warp_eqr_to_aze.h"
 #include "lens_distortion_remap.h"
@@ -57,7 +60,10 @@ SHARED_PUBLIC vx_status VX_API_CALL vxPublishKernels(vx_context context)
 	ERROR_CHECK_STATUS(exposure_comp_solvegains_publish(context));
 	ERROR_CHECK_STATUS(exposure_comp_applygains_publish(context));
 	ERROR_CHECK_STATUS(merge_publish(context));
+	ERROR_CHECK_STATUS(warp_merge_publish(context));
 	ERROR_CHECK_STATUS(alpha_blend_publish(context));
+	ERROR_CHECK_STATUS(overlay_blend_publish(context));
+	ERROR_CHECK_STATUS(half_scale_rgb_publish(context));
 	ERROR_CHECK_STATUS(multiband_blend_publish(context));
 	ERROR_CHECK_STATUS(half_scale_gaussian_publish(context));
 	ERROR_CHECK_STATUS(upscale_gaussian_subtract_publish(context));
@@ -195,6 +201,17 @@ bool StitchGetEnvironmentVariable(const char * name, char * value, size_t valueS
 #endif
 }
 
+//! \brief Check for host execution, i.e., the graph context has CPU target affinity (see LIVE_STITCH_ATTR_HOST_EXECUTION).
+//  Kernels with host implementations use it to pick the CPU target in the query target support callback.
+bool StitchIsHostExecution(vx_graph graph)
+{
+	AgoTargetAffinityInfo affinity = { 0 };
+	vx_context context = vxGetContext((vx_reference)graph);
+	if (!context || vxQueryContext(context, VX_CONTEXT_ATTRIBUTE_AMD_AFFINITY, &affinity, sizeof(affinity)) != VX_SUCCESS)
+		return false;
+	return (affinity.device_type == AGO_TARGET_AFFINITY_CPU) ? true : false;
+}
+
 /***********************************************************************************************************************************
 OVX Stich Nodes
 ************************************************************************************************************************************/
@@ -266,6 +283,35 @@ VX_API_ENTRY vx_node VX_API_CALL stitchMergeNode(vx_graph graph, vx_image camera
 	return node;
 }
 
+/**
+* \brief Function to create Stitch Warp Merge node
+*/
+VX_API_ENTRY vx_node VX_API_CALL stitchWarpMergeNode(vx_graph graph, vx_uint32 num_cam, vx_array ValidPixelEntry, vx_array WarpRemapEntry,
+	vx_image index_image, vx_image input, vx_image weight_image, vx_image output, vx_array gain_array, vx_uint32 num_camera_columns)
+{
+	vx_scalar NUM_CAM = vxCreateScalar(vxGetContext((vx_reference)graph), VX_TYPE_UINT32, &num_cam);
+	vx_scalar s_num_camera_columns = vxCreateScalar(vxGetContext((vx_reference)graph), VX_TYPE_UINT32, &num_camera_columns);
+
+	vx_reference params[] = {
+		(vx_reference)NUM_CAM,
+		(vx_reference)ValidPixelEntry,
+		(vx_reference)WarpRemapEntry,
+		(vx_reference)index_image,
+		(vx_reference)input,
+		(vx_reference)weight_image,
+		(vx_reference)output,
+		(vx_reference)gain_array,
+		(vx_reference)s_num_camera_columns,
+	};
+	vx_node node = stitchCreateNode(graph,
+		AMDOVX_KERNEL_STITCHING_WARP_MERGE,
+		params,
+		dimof(params));
+	vxReleaseScalar(&NUM_CAM);
+	vxReleaseScalar(&s_num_camera_columns);
+	return node;
+}
+
 /**
 * \brief Function to create Stitch AlphaBlendnode
 */
@@ -284,6 +330,42 @@ VX_API_ENTRY vx_node VX_API_CALL stitchAlphaBlendNode(vx_graph graph, vx_image i
 	return node;
 }
 
+/**
+* \brief Function to create Stitch OverlayBlend node
+*/
+VX_API_ENTRY vx_node VX_API_CALL stitchOverlayBlendNode(vx_graph graph, vx_array ValidPixelEntry, vx_array WarpRemapEntry, vx_image overlay, vx_image output_rgb)
+{
+	vx_reference params[] = {
+		(vx_reference)ValidPixelEntry,
+		(vx_reference)WarpRemapEntry,
+		(vx_reference)overlay,
+		(vx_reference)output_rgb
+	};
+	vx_node node = stitchCreateNode(graph,
+		AMDOVX_KERNEL_STITCHING_OVERLAY_BLEND,
+		params,
+		dimof(params));
+
+	return node;
+}
+
+/**
+* \brief Function to create Stitch HalfScaleRGB node
+*/
+VX_API_ENTRY vx_node VX_API_CALL stitchHalfScaleRGBNode(vx_graph graph, vx_image input_rgb, vx_image output_rgb)
+{
+	vx_reference params[] = {
+		(vx_reference)input_rgb,
+		(vx_reference)output_rgb
+	};
+	vx_node node = stitchCreateNode(graph,
+		AMDOVX_KERNEL_STITCHING_HALF_SCALE_RGB,
+		params,
+		dimof(params));
+
+	return node;
+}
+
 /**
 * \brief Function to create Calculate Error Function node
 */
@@ -333,10 +415,11 @@ VX_API_ENTRY vx_node VX_API_CALL stitchExposureCompCalcErrorFnRGBNode(vx_graph g
 /**
 * \brief Function to create Calculate Gains node
 */
-VX_API_ENTRY vx_node VX_API_CALL stitchExposureCompSolveForGainNode(vx_graph graph, vx_float32 alpha, vx_float32 beta, vx_matrix in_intensity, vx_matrix in_count, vx_array out_gains)
+VX_API_ENTRY vx_node VX_API_CALL stitchExposureCompSolveForGainNode(vx_graph graph, vx_float32 alpha, vx_float32 beta, vx_matrix in_intensity, vx_matrix in_count, vx_array out_gains, vx_uint32 num_frames)
 {
 	vx_scalar Alpha = vxCreateScalar(vxGetContext((vx_reference)graph), VX_TYPE_FLOAT32, &alpha);
 	vx_scalar Beta = vxCreateScalar(vxGetContext((vx_reference)graph), VX_TYPE_FLOAT32, &beta);
+	vx_scalar NumFrames = vxCreateScalar(vxGetContext((vx_reference)graph), VX_TYPE_UINT32, &num_frames);
 
 	vx_reference params[] = {
 		(vx_reference)Alpha,
@@ -344,6 +427,7 @@ VX_API_ENTRY vx_node VX_API_CALL stitchExposureCompSolveForGainNode(vx_graph gra
 		(vx_reference)in_intensity,
 		(vx_reference)in_count,
 		(vx_reference)out_gains,
+		(vx_reference)NumFrames,
 	};
 	vx_node node = stitchCreateNode(graph,
 		AMDOVX_KERNEL_STITCHING_EXPCOMP_SOLVE,
@@ -352,6 +436,7 @@ VX_API_ENTRY vx_node VX_API_CALL stitchExposureCompSolveForGainNode(vx_graph gra
 
 	vxReleaseScalar(&Alpha);
 	vxReleaseScalar(&Beta);
+	vxReleaseScalar(&NumFrames);
 	return node;
 }
 
@@ -424,12 +509,13 @@ VX_API_ENTRY vx_node VX_API_CALL stitchSeamFindCostGenerateNode(vx_graph graph,
 	return node;
 }
 
-//*\brief Function to create SeamFind Cost Accumulate Node - GPU 
+//*\brief Function to create SeamFind Cost Accumulate Node - GPU/CPU
 VX_API_ENTRY vx_node VX_API_CALL stitchSeamFindCostAccumulateNode(vx_graph graph, vx_scalar current_frame, vx_uint32 output_width, vx_uint32 output_height,
-	vx_image magnitude_img, vx_image phase_img, vx_image mask_img, vx_array valid_seam, vx_array pref_seam, vx_array info_seam, vx_array accum_seam)
+	vx_image magnitude_img, vx_image phase_img, vx_image mask_img, vx_array valid_seam, vx_array pref_seam, vx_array info_seam, vx_array accum_seam, vx_uint32 coarse_scale)
 {
 	vx_scalar OUTPUT_WIDTH = vxCreateScalar(vxGetContext((vx_reference)graph), VX_TYPE_UINT32, &output_width);
 	vx_scalar OUTPUT_HEIGHT = vxCreateScalar(vxGetContext((vx_reference)graph), VX_TYPE_UINT32, &output_height);
+	vx_scalar COARSE_SCALE = vxCreateScalar(vxGetContext((vx_reference)graph), VX_TYPE_UINT32, &coarse_scale);
 
 	vx_reference params[] = {
 		(vx_reference)current_frame,
@@ -441,7 +527,8 @@ VX_API_ENTRY vx_node VX_API_CALL stitchSeamFindCostAccumulateNode(vx_graph graph
 		(vx_reference)valid_seam,
 		(vx_reference)pref_seam,
 		(vx_reference)info_seam,
-		(vx_reference)accum_seam
+		(vx_reference)accum_seam,
+		(vx_reference)COARSE_SCALE
 	};
 	vx_node node = stitchCreateNode(graph,
 		AMDOVX_KERNEL_STITCHING_SEAMFIND_COST_ACCUMULATE,
@@ -450,6 +537,7 @@ VX_API_ENTRY vx_node VX_API_CALL stitchSeamFindCostAccumulateNode(vx_graph graph
 
 	vxReleaseScalar(&OUTPUT_WIDTH);
 	vxReleaseScalar(&OUTPUT_HEIGHT);
+	vxReleaseScalar(&COARSE_SCALE);
 	return node;
 }
 
@@ -506,12 +594,13 @@ VX_API_ENTRY vx_node VX_API_CALL stitchSeamFindSetWeightsNode(vx_graph graph, vx
 }
 
 //*\brief Function to create SeamFind Seam Analyze Node - CPU
-VX_API_ENTRY vx_node VX_API_CALL stitchSeamFindAnalyzeNode(vx_graph graph, vx_scalar current_frame, vx_array seam_pref, vx_scalar flag)
+VX_API_ENTRY vx_node VX_API_CALL stitchSeamFindAnalyzeNode(vx_graph graph, vx_scalar current_frame, vx_array seam_pref, vx_scalar flag, vx_scalar budget)
 {
 	vx_reference params[] = {
 		(vx_reference)current_frame,
 		(vx_reference)seam_pref,
-		(vx_reference)flag
+		(vx_reference)flag,
+		(vx_reference)budget
 	};
 	vx_node node = stitchCreateNode(graph,
 		AMDOVX_KERNEL_STITCHING_SEAMFIND_ANALYZE,
@@ -72,6 +72,17 @@ static inline vx_uint32 GetOneBitCount(vx_uint32 a)
 {
 	return __popcnt(a);
 }
+#pragma intrinsic(_BitScanReverse64)
+static inline vx_uint32 GetOneBitPosition(vx_uint64 a)
+{
+	unsigned long index;
+	_BitScanReverse64(&index, (unsigned __int64)a);
+	return (vx_uint32)index;
+}
+static inline vx_uint32 GetOneBitCount(vx_uint64 a)
+{
+	return (vx_uint32)__popcnt64(a);
+}
 #else
 static inline vx_uint32 GetOneBitPosition(vx_uint32 a)
 {
@@ -81,8 +92,28 @@ static inline vx_uint32 GetOneBitCount(vx_uint32 a)
 {
 	return __builtin_popcount(a);
 }
+static inline vx_uint32 GetOneBitPosition(vx_uint64 a)
+{
+	return a ? (63 - __builtin_clzll(a)) : 64;
+}
+static inline vx_uint32 GetOneBitCount(vx_uint64 a)
+{
+	return __builtin_popcountll(a);
+}
 #endif
 
+//! \brief The bit of a camera in the per-pixel camera maps and overlap masks (up to LIVE_STITCH_MAX_CAMERAS).
+static inline vx_uint64 StitchCameraBit(vx_uint32 camId)
+{
+	return (vx_uint64)1 << camId;
+}
+
+//! \brief Round and saturate to U8 like amd_pack() in the OpenCL kernels (used by host kernels).
+static inline vx_uint8 StitchPackU8(vx_float32 f)
+{
+	return (f <= 0.0f) ? 0 : (f >= 255.0f) ? 255 : (vx_uint8)(f + 0.5f);
+}
+
 //////////////////////////////////////////////////////////////////////
 //! \brief The AMD extension library for stitching
 #define	AMDOVX_LIBRARY_STITCHING          2
@@ -180,6 +211,15 @@ enum vx_kernel_stitching_amd_e {
 	//! \brief The warp to sphere kernel. Kernel name is "com.amd.loomsl.extend_padding_vert".
 	AMDOVX_KERNEL_STITCHING_INIT_EXTEND_PAD_VERT = VX_KERNEL_BASE(VX_ID_AMD, AMDOVX_LIBRARY_STITCHING) + 0x01c,
 
+	//! \brief The fused warp, exposure gain and merge kernel. Kernel name is "com.amd.loomsl.warp_merge".
+	AMDOVX_KERNEL_STITCHING_WARP_MERGE = VX_KERNEL_BASE(VX_ID_AMD, AMDOVX_LIBRARY_STITCHING) + 0x01d,
+
+	//! \brief The sparse overlay warp and alpha blend kernel. Kernel name is "com.amd.loomsl.overlay_blend".
+	AMDOVX_KERNEL_STITCHING_OVERLAY_BLEND = VX_KERNEL_BASE(VX_ID_AMD, AMDOVX_LIBRARY_STITCHING) + 0x01e,
+
+	//! \brief The RGB 2x2 downscale kernel for output renditions. Kernel name is "com.amd.loomsl.half_scale_rgb".
+	AMDOVX_KERNEL_STITCHING_HALF_SCALE_RGB = VX_KERNEL_BASE(VX_ID_AMD, AMDOVX_LIBRARY_STITCHING) + 0x01f,
+
 	// TBD: remove
 
 	//! \brief The Exposure Compensation kernel. Kernel name is "com.amd.loomsl.exposure_compensation_model".
@@ -236,6 +276,23 @@ VX_API_ENTRY vx_node VX_API_CALL stitchWarpNode(vx_graph graph, vx_enum method,
 */
 VX_API_ENTRY vx_node VX_API_CALL stitchMergeNode(vx_graph graph, vx_image camera_id_image, vx_image group1_image, vx_image group2_image, vx_image input, vx_image weight_image, vx_image output);
 
+/*! \brief [Graph] Creates a Stitch Warp Merge node: warp, exposure gain and merge in a single pass without intermediate images.
+* \param [in] graph The reference to the graph.
+* \param [in] num_cam The number of cameras.
+* \param [in] ValidPixelEntry The input array of StitchValidPixel ordered by output location (see GenerateWarpMergeBuffers).
+* \param [in] WarpRemapEntry The input array of StitchWarpRemap ordered by output location.
+* \param [in] index_image The input index image of StitchWarpMergeIndexEntry (U032).
+* \param [in] input The input RGB image.
+* \param [in] weight_image The weight image.
+* \param [out] output The output image.
+* \param [in] gain_array The exposure comp gain array with one or three gains per camera (optional).
+* \param [in] num_camera_columns The number of camera columns.
+* \return <tt>\ref vx_node</tt>.
+* \retval vx_node A node reference. Any possible errors preventing a successful creation should be checked using <tt>\ref vxGetStatus</tt>
+*/
+VX_API_ENTRY vx_node VX_API_CALL stitchWarpMergeNode(vx_graph graph, vx_uint32 num_cam, vx_array ValidPixelEntry, vx_array WarpRemapEntry,
+	vx_image index_image, vx_image input, vx_image weight_image, vx_image output, vx_array gain_array, vx_uint32 num_camera_columns);
+
 /*! \brief [Graph] Creates a AlphaBlend node.
 * \param [in] graph The reference to the graph.
 * \param [in] input_rgb Input RGB image.
@@ -246,6 +303,26 @@ VX_API_ENTRY vx_node VX_API_CALL stitchMergeNode(vx_graph graph, vx_image camera
 */
 VX_API_ENTRY vx_node VX_API_CALL stitchAlphaBlendNode(vx_graph graph, vx_image input_rgb, vx_image input_rgba, vx_image output_rgb);
 
+/*! \brief [Graph] Creates a OverlayBlend node: warp and alpha blend of overlays only at output locations in the overlay tables.
+* \param [in] graph The reference to the graph.
+* \param [in] ValidPixelEntry The input array of StitchValidPixel for overlays (see GenerateOverlayBuffers).
+* \param [in] WarpRemapEntry The input array of StitchWarpRemap with locations in the overlay image.
+* \param [in] overlay Input RGBX overlay image with alpha channel.
+* \param [in,out] output_rgb RGB image updated in place.
+* \return <tt>\ref vx_node</tt>.
+* \retval vx_node A node reference. Any possible errors preventing a successful creation should be checked using <tt>\ref vxGetStatus</tt>
+*/
+VX_API_ENTRY vx_node VX_API_CALL stitchOverlayBlendNode(vx_graph graph, vx_array ValidPixelEntry, vx_array WarpRemapEntry, vx_image overlay, vx_image output_rgb);
+
+/*! \brief [Graph] Creates a HalfScaleRGB node: 2x2 box filter downscale of an RGB image.
+* \param [in] graph The reference to the graph.
+* \param [in] input_rgb Input RGB image.
+* \param [out] output_rgb Output RGB image with dimensions ((width+1)/2, (height+1)/2).
+* \return <tt>\ref vx_node</tt>.
+* \retval vx_node A node reference. Any possible errors preventing a successful creation should be checked using <tt>\ref vxGetStatus</tt>
+*/
+VX_API_ENTRY vx_node VX_API_CALL stitchHalfScaleRGBNode(vx_graph graph, vx_image input_rgb, vx_image output_rgb);
+
 /*! \brief [Graph] Creates a ExposureCompCalcErrorFn node.
 * \param [in] graph      The reference to the graph.
 * \param [in] numCameras Scalar (uint32: number of cameras)
@@ -267,11 +344,12 @@ VX_API_ENTRY vx_node VX_API_CALL stitchExposureCompCalcErrorFnNode(vx_graph grap
 * \param [in] in_intensity  Input matrix for sum of overlapping pixels.
 * \param [in] in_count      Input matrix for count of overlapping pixels.
 * \param [out] out_gains    Output array for gains.
+* \param [in] num_frames    Number of frames summed in in_intensity (1: single frame).
 * \return <tt>\ref vx_node</tt>.
 * \retval vx_node A node reference. Any possible errors preventing a successful creation should be checked using <tt>\ref vxGetStatus</tt>
 */
 VX_API_ENTRY vx_node VX_API_CALL stitchExposureCompSolveForGainNode(vx_graph graph, vx_float32 alpha,
-	vx_float32 beta, vx_matrix in_intensity, vx_matrix in_count, vx_array out_gains);
+	vx_float32 beta, vx_matrix in_intensity, vx_matrix in_count, vx_array out_gains, vx_uint32 num_frames);
 
 /*! \brief [Graph] Creates a ExposureCompApplyGain node.
 * \param [in] graph      The reference to the graph.
@@ -410,12 +488,13 @@ VX_API_ENTRY vx_node VX_API_CALL stitchSeamFindCostGenerateNode(vx_graph graph,
 * \param [in] pref_seam     The input array of seam preference.
 * \param [in] info_seam     The input seam info array.
 * \param [out] output       The output seam_accum array.
+* \param [in] coarse_scale  Downsample factor of the coarse path search (0 or 1: full resolution search).
 * \return <tt>\ref vx_node</tt>.
 * \retval vx_node A node reference. Any possible errors preventing a successful creation should be checked using <tt>\ref vxGetStatus</tt>
 */
 VX_API_ENTRY vx_node VX_API_CALL stitchSeamFindCostAccumulateNode(vx_graph graph, vx_scalar current_frame,
 	vx_uint32 output_width, vx_uint32 output_height, vx_image magnitude_img, vx_image phase_img,
-	vx_image mask_img, vx_array valid_seam, vx_array pref_seam, vx_array info_seam, vx_array accum_seam);
+	vx_image mask_img, vx_array valid_seam, vx_array pref_seam, vx_array info_seam, vx_array accum_seam, vx_uint32 coarse_scale);
 
 /*! \brief [Graph] Creates a SeamFind Accumulate node K4 - GPU/CPU.
 * \param [in] graph The reference to the graph.
@@ -451,12 +530,13 @@ VX_API_ENTRY vx_node VX_API_CALL stitchSeamFindSetWeightsNode(vx_graph graph, vx
 /*!\brief Function to create SeamFind Seam Analyze Node - CPU
 * \param [in] graph         The reference to the graph.
 * \param [in] current_frame The input Current Frame.
-* \param [in] seam_pref     The input array of seam preference.
+* \param [inout] seam_pref  The array of seam preference: event driven overlaps get scheduled for the current frame.
 * \param [out] output       The output flag.
+* \param [in] budget        The optional max number of event driven overlaps scheduled per frame (0: unlimited).
 * \return <tt>\ref vx_node</tt>.
 * \retval vx_node A node reference. Any possible errors preventing a successful creation should be checked using <tt>\ref vxGetStatus</tt>
 */
-VX_API_ENTRY vx_node VX_API_CALL stitchSeamFindAnalyzeNode(vx_graph graph, vx_scalar current_frame, vx_array seam_pref, vx_scalar flag);
+VX_API_ENTRY vx_node VX_API_CALL stitchSeamFindAnalyzeNode(vx_graph graph, vx_scalar current_frame, vx_array seam_pref, vx_scalar flag, vx_scalar budget);
 
 //////////////////////////////////////////////////////////////////////
 // Chroma Key Kernels
@@ -521,6 +601,7 @@ vx_reference avxGetNodeParamRef(vx_node node, vx_uint32 index);
 vx_node stitchCreateNode(vx_graph graph, vx_enum kernelEnum, vx_reference params[], vx_uint32 num);
 vx_node stitchCreateNode(vx_graph graph, const char * kernelName, vx_reference params[], vx_uint32 num);
 bool StitchGetEnvironmentVariable(const char * name, char * value, size_t valueSize);
+bool StitchIsHostExecution(vx_graph graph);
 
 //////////////////////////////////////////////////////////////////////
 //! \brief The macro for error checking from OpenVX status.
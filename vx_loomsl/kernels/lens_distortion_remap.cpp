@@ -153,17 +153,17 @@ static inline float adobe_lens_fisheye_model(float th, float fr, float k1, float
 static void CalculatePaddedRegion(
 	vx_uint32 eqrWidth, vx_uint32 eqrHeight, // [in] output equirectangular dimensions
 	vx_uint32 camId,                         // [in] camera index
-	vx_uint32 * validPixelCamMap,            // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	vx_uint64 * validPixelCamMap,            // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
 	vx_uint32 paddingPixelCount,             // [in] padding pixels around valid region
-	vx_uint32 * paddedPixelCamMap            // [out] padded pixel camera index map: size: [eqrWidth * eqrHeight]
+	vx_uint64 * paddedPixelCamMap            // [out] padded pixel camera index map: size: [eqrWidth * eqrHeight]
 	)
 {
-	vx_uint32 camMapBit = 1 << camId;
+	vx_uint64 camMapBit = StitchCameraBit(camId);
 	vx_uint32 loopPixels = (2 * paddingPixelCount) + 1;
 	// dilate using separable filter for (N x 1) & (1 x N)
 	for (vx_uint32 y_eqr = 0, pixelPosition = 0; y_eqr < (int)eqrHeight; y_eqr++) {
 		for (vx_uint32 x_eqr = 0; x_eqr < (int)eqrWidth; x_eqr++, pixelPosition++) {
-			vx_uint32 val = 0;
+			vx_uint64 val = 0;
 			vx_int32 X = (vx_int32)x_eqr - paddingPixelCount;
 			// get the neighborhood of (x_eqr,y_eqr)
 			for (vx_uint32 i = 0; i < loopPixels; i++){
@@ -183,7 +183,7 @@ static void CalculatePaddedRegion(
 	}
 	for (vx_uint32 y_eqr = 0, pixelPosition = 0; y_eqr < (int)eqrHeight; y_eqr++) {
 		for (vx_uint32 x_eqr = 0; x_eqr < (int)eqrWidth; x_eqr++, pixelPosition++) {
-			vx_uint32 val = 0;
+			vx_uint64 val = 0;
 			vx_int32 Y = (vx_int32)y_eqr - paddingPixelCount;
 			// get the neighborhood of (x_eqr,y_eqr)
 			for (vx_uint32 j = 0; j < loopPixels; j++){
@@ -204,14 +204,43 @@ static void CalculatePaddedRegion(
 	return;
 }
 
+//////////////////////////////////////////////////////////////////////
+// calculate direction of an output pixel in cubemap layout: 3x2 faces (see output_projection)
+static inline void CalculateCubemapDirection(vx_uint32 outputProjection, vx_uint32 faceSize, vx_uint32 x, vx_uint32 y, float * X)
+{
+	// forward, right, and down axes of each face in layout order
+	static const float faceAxes[6][3][3] = {
+		{ { -1, 0, 0 }, { 0, 0, 1 }, { 0, 1, 0 } },  // left
+		{ { 0, 0, 1 }, { 1, 0, 0 }, { 0, 1, 0 } },   // front
+		{ { 1, 0, 0 }, { 0, 0, -1 }, { 0, 1, 0 } },  // right
+		{ { 0, 1, 0 }, { 1, 0, 0 }, { 0, 0, -1 } },  // bottom
+		{ { 0, 0, -1 }, { -1, 0, 0 }, { 0, 1, 0 } }, // back
+		{ { 0, -1, 0 }, { 1, 0, 0 }, { 0, 0, 1 } },  // top
+	};
+	vx_uint32 face_x = x / faceSize, face_y = y / faceSize;
+	const float(*axes)[3] = faceAxes[face_y * 3 + face_x];
+	// face coordinates of pixel center in [-1,1]: equi-angular cubemap samples angles uniformly
+	float u = ((float)(x - face_x * faceSize) + 0.5f) * 2.0f / (float)faceSize - 1.0f;
+	float v = ((float)(y - face_y * faceSize) + 0.5f) * 2.0f / (float)faceSize - 1.0f;
+	if (outputProjection == output_projection_eac) {
+		u = tanf(u * (float)M_PI_4);
+		v = tanf(v * (float)M_PI_4);
+	}
+	float nfactor = 1.0f / sqrtf(1.0f + u * u + v * v);
+	for (int i = 0; i < 3; i++) {
+		X[i] = (axes[0][i] + u * axes[1][i] + v * axes[2][i]) * nfactor;
+	}
+}
+
 //////////////////////////////////////////////////////////////////////
 // calculate lens distorion and warp maps using lens model
 static void CalculateLensDistortionAndWarpMapsUsingLensModel(
 	vx_uint32 camWidth, vx_uint32 camHeight, // [in] individual camera dimensions
 	vx_uint32 eqrWidth, vx_uint32 eqrHeight, // [in] output equirectangular dimensions
-	vx_uint32 * validPixelCamMap,            // [out] valid pixel camera index map: size: [eqrWidth * eqrHeight] (optional)
+	vx_uint32 outputProjection,              // [in] output projection (see output_projection)
+	vx_uint64 * validPixelCamMap,            // [out] valid pixel camera index map: size: [eqrWidth * eqrHeight] (optional)
 	vx_uint32 paddingPixelCount,             // [in] padding pixels around valid region
-	vx_uint32 * paddedPixelCamMap,           // [out] padded pixel camera index map: size: [eqrWidth * eqrHeight] (optional)
+	vx_uint64 * paddedPixelCamMap,           // [out] padded pixel camera index map: size: [eqrWidth * eqrHeight] (optional)
 	StitchCoord2dFloat * camSrcMap,          // [out] camera coordinate mapping: size: [numCamera * eqrWidth * eqrHeight] (optional)
 	vx_float32 * internalBufferForCamIndex,  // [tmp] buffer for internal use: size: [eqrWidth * eqrHeight] (optional)
 	vx_uint8 * defaultCamIndex,              // [out] default camera index (255 refers to no camera): size: [eqrWidth * eqrHeight] (optional)
@@ -223,7 +252,7 @@ static void CalculateLensDistortionAndWarpMapsUsingLensModel(
 	camera_lens_type lens_type
 	)
 {
-	vx_uint32 camMapBit = 1 << camId;
+	vx_uint64 camMapBit = StitchCameraBit(camId);
 	float pi_by_h = (float)M_PI / (float)eqrHeight;
 	float center_x = du0 + (float)camWidth * 0.5f, center_y = dv0 + (float)camHeight * 0.5f;
 	float rightMinus1 = right - 1, right2Minus2 = rightMinus1 * 2;
@@ -234,10 +263,16 @@ static void CalculateLensDistortionAndWarpMapsUsingLensModel(
 		float cos_pe = cosf(pe);
 		for (vx_uint32 x_eqr = 0; x_eqr < (int)eqrWidth; x_eqr++, pixelPosition++) {
 			float x_src = -1, y_src = -1;
-			float te = (float)x_eqr * pi_by_h - (float)M_PI;
-			float sin_te = sinf(te);
-			float cos_te = cosf(te);
-			float X[3] = { sin_te*cos_pe, sin_pe, cos_te*cos_pe };
+			float X[3];
+			if (outputProjection == output_projection_equirectangular) {
+				float te = (float)x_eqr * pi_by_h - (float)M_PI;
+				float sin_te = sinf(te);
+				float cos_te = cosf(te);
+				X[0] = sin_te*cos_pe; X[1] = sin_pe; X[2] = cos_te*cos_pe;
+			}
+			else {
+				CalculateCubemapDirection(outputProjection, eqrHeight >> 1, x_eqr, y_eqr, X);
+			}
 			float Xt[3] = { X[0] - T[0], X[1] - T[1], X[2] - T[2] };
 			float nfactor = sqrtf(Xt[0] * Xt[0] + Xt[1] * Xt[1] + Xt[2] * Xt[2]);
 			Xt[0] /= nfactor;
@@ -310,11 +345,12 @@ vx_status CalculateLensDistortionAndWarpMaps(
 	vx_uint32 numCamera,                     // [in] number of cameras
 	vx_uint32 camWidth, vx_uint32 camHeight, // [in] individual camera dimensions
 	vx_uint32 eqrWidth, vx_uint32 eqrHeight, // [in] output equirectangular dimensions
+	vx_uint32 outputProjection,              // [in] output projection (see output_projection)
 	const rig_params * rigParam,             // [in] rig configuration
 	const camera_params * camParam,          // [in] individual camera configuration: size: [numCamera]
-	vx_uint32 * validPixelCamMap,            // [out] valid pixel camera index map: size: [eqrWidth * eqrHeight] (optional)
+	vx_uint64 * validPixelCamMap,            // [out] valid pixel camera index map: size: [eqrWidth * eqrHeight] (optional)
 	vx_uint32 paddingPixelCount,             // [in] padding pixels around valid region
-	vx_uint32 * paddedPixelCamMap,           // [out] padded pixel camera index map: size: [eqrWidth * eqrHeight] (optional)
+	vx_uint64 * paddedPixelCamMap,           // [out] padded pixel camera index map: size: [eqrWidth * eqrHeight] (optional)
 	StitchCoord2dFloat * camSrcMap,          // [out] camera coordinate mapping: size: [numCamera * eqrWidth * eqrHeight] (optional)
 	vx_float32 * internalBufferForCamIndex,  // [tmp] buffer for internal use: size: [eqrWidth * eqrHeight] (optional)
 	vx_uint8 * defaultCamIndex               // [out] default camera index (255 refers to no camera): size: [eqrWidth * eqrHeight] (optional)
@@ -325,9 +361,10 @@ vx_status CalculateLensDistortionAndWarpMaps(
 		internalBufferForCamIndex = nullptr;
 		defaultCamIndex = nullptr;
 	}
-	// supports upto 32 cameras
-	if (numCamera > 32) {
-		printf("ERROR: CalculateValidPixelMap: can't support %d cameras -- 32 is the current limit\n", numCamera);
+	// camera maps have one bit per camera: the initialize kernels generate 32-bit maps
+	vx_uint32 maxCamera = (pInitData && pInitData->graphInitialize) ? 32 : LIVE_STITCH_MAX_CAMERAS;
+	if (numCamera > maxCamera) {
+		printf("ERROR: CalculateValidPixelMap: can't support %d cameras -- %d is the current limit\n", numCamera, maxCamera);
 		return VX_ERROR_NOT_SUPPORTED;
 	}
 #if PROFILE_STARTUP_TIME
@@ -349,11 +386,13 @@ vx_status CalculateLensDistortionAndWarpMaps(
 		ERROR_CHECK_STATUS(vxQueryImage(pInitData->ValidPixelMap, VX_IMAGE_ATTRIBUTE_HEIGHT, &rectFull.end_y, sizeof(rectFull.end_y)));
 		// write all image planes from vx_image
 		ERROR_CHECK_STATUS(vxAccessImagePatch(pInitData->ValidPixelMap, &rectFull, plane, &addr, (void **)&src, VX_READ_ONLY));
-		vx_size width_in_bytes = (addr.dim_x * addr.stride_x);
-		vx_uint8 *dst = (vx_uint8 *)validPixelCamMap;
+		// the U032 maps of the initialize kernels are widened to 64-bit camera maps
+		vx_size width_in_bytes = 0;
+		vx_uint8 *dst = NULL;
+		vx_uint64 *dstMap = validPixelCamMap;
 		for (vx_uint32 y = 0; y < addr.dim_y; y += addr.step_y){
-			vx_uint8 *srcp = (vx_uint8 *)vxFormatImagePatchAddress2d(src, 0, y, &addr);
-			memcpy(dst, srcp, width_in_bytes); dst += width_in_bytes;
+			const vx_uint32 *srcp = (const vx_uint32 *)vxFormatImagePatchAddress2d(src, 0, y, &addr);
+			for (vx_uint32 x = 0; x < addr.dim_x; x++) *dstMap++ = srcp[x];
 		}
 		ERROR_CHECK_STATUS(vxCommitImagePatch(pInitData->ValidPixelMap, &rectFull, plane, &addr, src));
 
@@ -364,11 +403,10 @@ vx_status CalculateLensDistortionAndWarpMaps(
 			addr = { 0 };
 			src = NULL;
 			ERROR_CHECK_STATUS(vxAccessImagePatch(pInitData->PaddedPixMap, &rectFull, plane, &addr, (void **)&src, VX_READ_ONLY));
-			width_in_bytes = (addr.dim_x * addr.stride_x);
-			dst = (vx_uint8 *)paddedPixelCamMap;
+			dstMap = paddedPixelCamMap;
 			for (vx_uint32 y = 0; y < addr.dim_y; y += addr.step_y){
-				vx_uint8 *srcp = (vx_uint8 *)vxFormatImagePatchAddress2d(src, 0, y, &addr);
-				memcpy(dst, srcp, width_in_bytes); dst += width_in_bytes;
+				const vx_uint32 *srcp = (const vx_uint32 *)vxFormatImagePatchAddress2d(src, 0, y, &addr);
+				for (vx_uint32 x = 0; x < addr.dim_x; x++) *dstMap++ = srcp[x];
 			}
 			ERROR_CHECK_STATUS(vxCommitImagePatch(pInitData->PaddedPixMap, &rectFull, plane, &addr, src));
 		}
@@ -414,7 +452,7 @@ vx_status CalculateLensDistortionAndWarpMaps(
 	else
 	{
 		// compute camera warp parameters and check for supported lens types
-		float Mcam[32 * 9], Tcam[32 * 3], fcam[32 * 2], Mr[3 * 3];
+		float Mcam[LIVE_STITCH_MAX_CAMERAS * 9], Tcam[LIVE_STITCH_MAX_CAMERAS * 3], fcam[LIVE_STITCH_MAX_CAMERAS * 2], Mr[3 * 3];
 		vx_status status = CalculateCameraWarpParameters(numCamera, camWidth, camHeight, rigParam, camParam, Mcam, Tcam, fcam, Mr);
 		if (status != VX_SUCCESS) return status;
 
@@ -422,10 +460,10 @@ vx_status CalculateLensDistortionAndWarpMaps(
 		// initialize buffers
 		size_t totSize = eqrWidth * eqrHeight;
 		if (validPixelCamMap) {
-			memset(validPixelCamMap, 0, totSize*sizeof(vx_uint32));
+			memset(validPixelCamMap, 0, totSize*sizeof(vx_uint64));
 		}
 		if (paddedPixelCamMap) {
-			memset(paddedPixelCamMap, 0, totSize*sizeof(vx_uint32));
+			memset(paddedPixelCamMap, 0, totSize*sizeof(vx_uint64));
 		}
 		if (defaultCamIndex) {
 			memset(internalBufferForCamIndex, 0, totSize*sizeof(vx_uint32));
@@ -445,28 +483,28 @@ vx_status CalculateLensDistortionAndWarpMaps(
 				bottom = std::min(bottom, lens->reserved[6]);
 			}
 			if (lens->lens_type == ptgui_lens_rectilinear) {
-				CalculateLensDistortionAndWarpMapsUsingLensModel(camWidth, camHeight, eqrWidth, eqrHeight,
+				CalculateLensDistortionAndWarpMapsUsingLensModel(camWidth, camHeight, eqrWidth, eqrHeight, outputProjection,
 					validPixelCamMap, paddingPixelCount, paddedPixelCamMap, &camSrcMap[cam * eqrWidth * eqrHeight],
 					internalBufferForCamIndex, defaultCamIndex,
 					cam, M, T, f, lens->k1, lens->k2, lens->k3, k0, lens->du0, lens->dv0, lens->r_crop,
 					left, top, right, bottom, ptgui_lens_rectilinear_model, lens->lens_type);
 			}
 			else if (lens->lens_type == ptgui_lens_fisheye_ff || lens->lens_type == ptgui_lens_fisheye_circ) {
-				CalculateLensDistortionAndWarpMapsUsingLensModel(camWidth, camHeight, eqrWidth, eqrHeight,
+				CalculateLensDistortionAndWarpMapsUsingLensModel(camWidth, camHeight, eqrWidth, eqrHeight, outputProjection,
 					validPixelCamMap, paddingPixelCount, paddedPixelCamMap, &camSrcMap[cam * eqrWidth * eqrHeight],
 					internalBufferForCamIndex, defaultCamIndex,
 					cam, M, T, f, lens->k1, lens->k2, lens->k3, k0, lens->du0, lens->dv0, lens->r_crop,
 					left, top, right, bottom, ptgui_lens_fisheye_model, lens->lens_type);
 			}
 			else if (lens->lens_type == adobe_lens_rectilinear) {
-				CalculateLensDistortionAndWarpMapsUsingLensModel(camWidth, camHeight, eqrWidth, eqrHeight,
+				CalculateLensDistortionAndWarpMapsUsingLensModel(camWidth, camHeight, eqrWidth, eqrHeight, outputProjection,
 					validPixelCamMap, paddingPixelCount, paddedPixelCamMap, &camSrcMap[cam * eqrWidth * eqrHeight],
 					internalBufferForCamIndex, defaultCamIndex,
 					cam, M, T, f, lens->k1, lens->k2, lens->k3, k0, lens->du0, lens->dv0, lens->r_crop,
 					left, top, right, bottom, adobe_lens_rectilinear_model, lens->lens_type);
 			}
 			else if (lens->lens_type == adobe_lens_fisheye) {
-				CalculateLensDistortionAndWarpMapsUsingLensModel(camWidth, camHeight, eqrWidth, eqrHeight,
+				CalculateLensDistortionAndWarpMapsUsingLensModel(camWidth, camHeight, eqrWidth, eqrHeight, outputProjection,
 					validPixelCamMap, paddingPixelCount, paddedPixelCamMap, &camSrcMap[cam * eqrWidth * eqrHeight],
 					internalBufferForCamIndex, defaultCamIndex,
 					cam, M, T, f, lens->k1, lens->k2, lens->k3, k0, lens->du0, lens->dv0, lens->r_crop,
@@ -474,7 +512,7 @@ vx_status CalculateLensDistortionAndWarpMaps(
 			}
 		}
 #if DUMP_BUFFERS_INITIALIZE
-		DumpBuffer((vx_uint8 *)paddedPixelCamMap, eqrWidth*eqrHeight * 4, "PaddedCamMap.bin");
+		DumpBuffer((vx_uint8 *)paddedPixelCamMap, eqrWidth*eqrHeight * sizeof(vx_uint64), "PaddedCamMap.bin");
 #endif
 	}
 #if PROFILE_STARTUP_TIME
@@ -496,17 +534,17 @@ vx_uint32 CalculateValidOverlapRegions(
 	vx_uint32 numCamera,                 // [in] number of cameras
 	vx_uint32 eqrWidth,                  // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                 // [in] output equirectangular image height
-	const vx_uint32 * validPixelCamMap,  // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,  // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
 	vx_rectangle_t ** overlapValid,      // [out] overlap regions: overlapValid[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i
-	vx_uint32 * validCamOverlapInfo,     // [out] camera overlap info - use "validCamOverlapInfo[cam_i] & (1 << cam_j)": size: [32]
-	const vx_uint32 * paddedPixelCamMap, // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
+	vx_uint64 * validCamOverlapInfo,     // [out] camera overlap info - use "validCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
+	const vx_uint64 * paddedPixelCamMap, // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
 	vx_rectangle_t ** overlapPadded,     // [out] overlap regions: overlapPadded[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i(optional)
-	vx_uint32 * paddedCamOverlapInfo     // [out] camera overlap info - use "paddedCamOverlapInfo[cam_i] & (1 << cam_j)": size: [32](optional)
+	vx_uint64 * paddedCamOverlapInfo     // [out] camera overlap info - use "paddedCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS](optional)
 	)
 {
 	// initialize camera overlap info
-	memset(validCamOverlapInfo, 0, LIVE_STITCH_MAX_CAMERAS * sizeof(vx_uint32));
-	if (paddedCamOverlapInfo) memset(paddedCamOverlapInfo, 0, LIVE_STITCH_MAX_CAMERAS * sizeof(vx_uint32));
+	memset(validCamOverlapInfo, 0, LIVE_STITCH_MAX_CAMERAS * sizeof(vx_uint64));
+	if (paddedCamOverlapInfo) memset(paddedCamOverlapInfo, 0, LIVE_STITCH_MAX_CAMERAS * sizeof(vx_uint64));
 	if (!paddedPixelCamMap)
 	{
 		overlapPadded = nullptr;
@@ -527,36 +565,36 @@ vx_uint32 CalculateValidOverlapRegions(
 	if (paddedPixelCamMap){
 		for (vx_uint32 y_eqr = 0, pixelPosition = 0; y_eqr < (vx_uint32)eqrHeight; y_eqr++) {
 			for (vx_uint32 x_eqr = 0; x_eqr < (vx_uint32)eqrWidth; x_eqr++, pixelPosition++) {
-				vx_uint32 validCamMap = validPixelCamMap[pixelPosition];
+				vx_uint64 validCamMap = validPixelCamMap[pixelPosition];
 				// update each of valid and overlaped regions
 				validPixelOverlapCountMax = max(validPixelOverlapCountMax, GetOneBitCount(validCamMap));
-				for (unsigned long camMapI = validCamMap; camMapI;) {
+				for (vx_uint64 camMapI = validCamMap; camMapI;) {
 					// get cam_i
 					vx_uint32 cam_i = GetOneBitPosition(camMapI);
-					camMapI &= ~(1 << cam_i);
+					camMapI &= ~StitchCameraBit(cam_i);
 					// update overlapValid[cam_i][cam_i]
 					rect_bound(overlapValid[cam_i][cam_i], x_eqr, y_eqr);
-					for (unsigned long camMapJ = camMapI; camMapJ;) {
+					for (vx_uint64 camMapJ = camMapI; camMapJ;) {
 						vx_uint32 cam_j = GetOneBitPosition(camMapJ);
-						validCamOverlapInfo[cam_i] |= (1 << cam_j);
-						camMapJ &= ~(1 << cam_j);
+						validCamOverlapInfo[cam_i] |= StitchCameraBit(cam_j);
+						camMapJ &= ~StitchCameraBit(cam_j);
 						// update overlapValid[cam_i][cam_j]
 						rect_bound(overlapValid[cam_i][cam_j], x_eqr, y_eqr);
 					}
 				}
-				vx_uint32 paddedCamMap = validCamMap | paddedPixelCamMap[pixelPosition];
+				vx_uint64 paddedCamMap = validCamMap | paddedPixelCamMap[pixelPosition];
 				paddedPixelOverlapCountMax = max(paddedPixelOverlapCountMax, GetOneBitCount(paddedCamMap));
 				// update each of padded overlaped region
-				for (unsigned long camMapI = paddedCamMap; camMapI;) {
+				for (vx_uint64 camMapI = paddedCamMap; camMapI;) {
 					// get cam_i
 					vx_uint32 cam_i = GetOneBitPosition(camMapI);
-					camMapI &= ~(1 << cam_i);
+					camMapI &= ~StitchCameraBit(cam_i);
 					// update overlapPadded[cam_i][cam_i]
 					rect_bound(overlapPadded[cam_i][cam_i], x_eqr, y_eqr);
-					for (unsigned long camMapJ = camMapI; camMapJ;) {
+					for (vx_uint64 camMapJ = camMapI; camMapJ;) {
 						vx_uint32 cam_j = GetOneBitPosition(camMapJ);
-						paddedCamOverlapInfo[cam_i] |= (1 << cam_j);
-						camMapJ &= ~(1 << cam_j);
+						paddedCamOverlapInfo[cam_i] |= StitchCameraBit(cam_j);
+						camMapJ &= ~StitchCameraBit(cam_j);
 						// update overlapPadded[cam_i][cam_j]
 						rect_bound(overlapPadded[cam_i][cam_j], x_eqr, y_eqr);
 					}
@@ -568,19 +606,19 @@ vx_uint32 CalculateValidOverlapRegions(
 	{
 		for (vx_uint32 y_eqr = 0, pixelPosition = 0; y_eqr < (vx_uint32)eqrHeight; y_eqr++) {
 			for (vx_uint32 x_eqr = 0; x_eqr < (vx_uint32)eqrWidth; x_eqr++, pixelPosition++) {
-				vx_uint32 validCamMap = validPixelCamMap[pixelPosition];
+				vx_uint64 validCamMap = validPixelCamMap[pixelPosition];
 				// update each of valid and overlaped regions
 				validPixelOverlapCountMax = max(validPixelOverlapCountMax, GetOneBitCount(validCamMap));
-				for (unsigned long camMapI = validCamMap; camMapI;) {
+				for (vx_uint64 camMapI = validCamMap; camMapI;) {
 					// get cam_i
 					vx_uint32 cam_i = GetOneBitPosition(camMapI);
-					camMapI &= ~(1 << cam_i);
+					camMapI &= ~StitchCameraBit(cam_i);
 					// update overlapValid[cam_i][cam_i]
 					rect_bound(overlapValid[cam_i][cam_i], x_eqr, y_eqr);
-					for (unsigned long camMapJ = camMapI; camMapJ;) {
+					for (vx_uint64 camMapJ = camMapI; camMapJ;) {
 						vx_uint32 cam_j = GetOneBitPosition(camMapJ);
-						validCamOverlapInfo[cam_i] |= (1 << cam_j);
-						camMapJ &= ~(1 << cam_j);
+						validCamOverlapInfo[cam_i] |= StitchCameraBit(cam_j);
+						camMapJ &= ~StitchCameraBit(cam_j);
 						// update overlapValid[cam_i][cam_j]
 						rect_bound(overlapValid[cam_i][cam_j], x_eqr, y_eqr);
 					}
@@ -616,14 +654,14 @@ vx_status GenerateValidMaskImage(
 	vx_uint32 numCamera,                  // [in] number of cameras
 	vx_uint32 eqrWidth,                   // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                  // [in] output equirectangular image height
-	const vx_uint32 * validPixelCamMap,   // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,   // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
 	vx_uint32  maskStride,                // [in] stride (in bytes) of mask image
 	vx_uint8 * maskBuf                    // [out] valid mask image buffer: size: [eqrWidth * eqrHeight * numCamera]
 	)
 {
 	vx_uint32 maskPosition = 0;
 	for (vx_uint32 camId = 0; camId < numCamera; camId++) {
-		vx_uint32 camMaskBit = 1 << camId;
+		vx_uint64 camMaskBit = StitchCameraBit(camId);
 		for (vx_uint32 y = 0, pixelPosition = 0; y < eqrHeight; y++) {
 			for (vx_uint32 x = 0; x < eqrWidth; x++, pixelPosition++) {
 				maskBuf[maskPosition + x] = (validPixelCamMap[pixelPosition] & camMaskBit) ? 255 : 0;
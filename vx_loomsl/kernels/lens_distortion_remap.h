@@ -80,11 +80,12 @@ vx_status CalculateLensDistortionAndWarpMaps(
 	vx_uint32 numCamera,                     // [in] number of cameras
 	vx_uint32 camWidth, vx_uint32 camHeight, // [in] individual camera dimensions
 	vx_uint32 eqrWidth, vx_uint32 eqrHeight, // [in] output equirectangular dimensions
+	vx_uint32 outputProjection,              // [in] output projection (see output_projection)
 	const rig_params * rigParam,             // [in] rig configuration
 	const camera_params * camParam,          // [in] individual camera configuration: size: [numCamera]
-	vx_uint32 * validPixelCamMap,            // [out] valid pixel camera index map: size: [eqrWidth * eqrHeight] (optional)
+	vx_uint64 * validPixelCamMap,            // [out] valid pixel camera index map: size: [eqrWidth * eqrHeight] (optional)
 	vx_uint32 paddingPixelCount,             // [in] padding pixels around valid region
-	vx_uint32 * paddedPixelCamMap,           // [out] padded pixel camera index map: size: [eqrWidth * eqrHeight] (optional)
+	vx_uint64 * paddedPixelCamMap,           // [out] padded pixel camera index map: size: [eqrWidth * eqrHeight] (optional)
 	StitchCoord2dFloat * camSrcMap,          // [out] camera coordinate mapping: size: [numCamera * eqrWidth * eqrHeight] (optional)
 	vx_float32 * internalBufferForCamIndex,  // [tmp] buffer for internal use: size: [eqrWidth * eqrHeight] (optional)
 	vx_uint8 * defaultCamIndex               // [out] default camera index (255 refers to no camera): size: [eqrWidth * eqrHeight] (optional)
@@ -96,12 +97,12 @@ vx_uint32 CalculateValidOverlapRegions(
 	vx_uint32 numCamera,                 // [in] number of cameras
 	vx_uint32 eqrWidth,                  // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                 // [in] output equirectangular image height
-	const vx_uint32 * validPixelCamMap,  // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,  // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
 	vx_rectangle_t ** overlapValid,      // [out] overlap regions: overlapValid[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i
-	vx_uint32 * validCamOverlapInfo,     // [out] camera overlap info - use "validCamOverlapInfo[cam_i] & (1 << cam_j)": size: [32]
-	const vx_uint32 * paddedPixelCamMap, // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
+	vx_uint64 * validCamOverlapInfo,     // [out] camera overlap info - use "validCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
+	const vx_uint64 * paddedPixelCamMap, // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
 	vx_rectangle_t ** overlapPadded,     // [out] overlap regions: overlapPadded[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i(optional)
-	vx_uint32 * paddedCamOverlapInfo     // [out] camera overlap info - use "paddedCamOverlapInfo[cam_i] & (1 << cam_j)": size: [32](optional)
+	vx_uint64 * paddedCamOverlapInfo     // [out] camera overlap info - use "paddedCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS](optional)
 	);
 
 //////////////////////////////////////////////////////////////////////
@@ -110,7 +111,7 @@ vx_status GenerateValidMaskImage(
 	vx_uint32 numCamera,                  // [in] number of cameras
 	vx_uint32 eqrWidth,                   // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                  // [in] output equirectangular image height
-	const vx_uint32 * validPixelCamMap,   // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,   // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
 	vx_uint32  maskStride,                // [in] stride (in bytes) of mask image
 	vx_uint8 * maskBuf                    // [out] valid mask image buffer: size: [eqrWidth * eqrHeight * numCamera]
 	);
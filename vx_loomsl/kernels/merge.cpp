@@ -87,6 +87,12 @@ static vx_status VX_CALLBACK merge_input_validator(vx_node node, vx_uint32 index
 		ERROR_CHECK_STATUS(vxQueryImage((vx_image)ref, VX_IMAGE_ATTRIBUTE_HEIGHT, &input_height, sizeof(input_height)));
 		ERROR_CHECK_STATUS(vxQueryImage((vx_image)ref, VX_IMAGE_ATTRIBUTE_FORMAT, &input_format, sizeof(input_format)));
 		ERROR_CHECK_STATUS(vxReleaseImage((vx_image *)&ref));
+		// packed camera planes (parameter 6) can be narrower than the output
+		vx_array cameraPlanes = (vx_array)avxGetNodeParamRef(node, 6);
+		if (cameraPlanes) {
+			ERROR_CHECK_STATUS(vxReleaseArray(&cameraPlanes));
+			width = input_width / 8;
+		}
 		if (input_format != VX_DF_IMAGE_RGBX) {
 			status = VX_ERROR_INVALID_TYPE;
 			vxAddLogEntry((vx_reference)node, status, "ERROR: merge input image should be of RGBX type\n");
@@ -126,6 +132,32 @@ static vx_status VX_CALLBACK merge_input_validator(vx_node node, vx_uint32 index
 			status = VX_SUCCESS;
 		}
 	}
+	else if (index == 6)
+	{ // array object of StitchCameraPlaneEntry type
+		vx_size itemsize = 0;
+		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
+		if (itemsize == sizeof(StitchCameraPlaneEntry)) {
+			status = VX_SUCCESS;
+		}
+		else {
+			status = VX_ERROR_INVALID_DIMENSION;
+			vxAddLogEntry((vx_reference)node, status, "ERROR: merge array element (StitchCameraPlaneEntry) size should be 16 bytes\n");
+		}
+		ERROR_CHECK_STATUS(vxReleaseArray((vx_array *)&ref));
+	}
+	else if (index == 7)
+	{ // array object of UINT32 type (or UINT64 type with wide merge tables) for overflow camera masks
+		vx_enum itemtype = VX_TYPE_INVALID;
+		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMTYPE, &itemtype, sizeof(itemtype)));
+		ERROR_CHECK_STATUS(vxReleaseArray((vx_array *)&ref));
+		if (itemtype == VX_TYPE_UINT32 || itemtype == VX_TYPE_UINT64) {
+			status = VX_SUCCESS;
+		}
+		else {
+			status = VX_ERROR_INVALID_TYPE;
+			vxAddLogEntry((vx_reference)node, status, "ERROR: merge overflow array element type should be UINT32 or UINT64\n");
+		}
+	}
 	return status;
 }
 
@@ -178,7 +210,7 @@ static vx_status VX_CALLBACK merge_query_target_support(vx_graph graph, vx_node
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = StitchIsHostExecution(graph) ? AGO_TARGET_AFFINITY_CPU : AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -207,6 +239,13 @@ static vx_status VX_CALLBACK merge_opencl_codegen(
 	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
 	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_FORMAT, &output_format, sizeof(output_format)));
 	ERROR_CHECK_STATUS(vxReleaseImage(&image));
+	bool packedCameraPlanes = parameters[6] ? true : false;
+	bool overflowTable = parameters[7] ? true : false;
+	vx_enum overflowItemType = VX_TYPE_UINT32;
+	if (overflowTable) {
+		ERROR_CHECK_STATUS(vxQueryArray((vx_array)parameters[7], VX_ARRAY_ATTRIBUTE_ITEMTYPE, &overflowItemType, sizeof(overflowItemType)));
+	}
+	bool wideOverflowTable = (overflowItemType == VX_TYPE_UINT64);
 	// set kernel configuration
 	strcpy(opencl_kernel_function_name, "merge");
 	vx_uint32 work_items[2] = { (width + 3) / 4, height };
@@ -237,14 +276,29 @@ static vx_status VX_CALLBACK merge_opencl_codegen(
 		"        uint camID2_img_width, uint camID2_img_height, __global uchar * camID2_img_buf, uint camID2_img_stride, uint camID2_img_offset,\n"
 		"        uint ip_width, uint ip_height, __global uchar * ip_buf, uint ip_stride, uint ip_offset,\n"
 		"        uint wt_width, uint wt_height, __global uchar * wt_buf, uint wt_stride, uint wt_offset,\n"
-		"        uint op_width, uint op_height, __global uchar * op_buf, uint op_stride, uint op_offset)\n"
+		"        uint op_width, uint op_height, __global uchar * op_buf, uint op_stride, uint op_offset%s%s)\n" // camera plane array, overflow array
 		"{\n"
 		"  int gx = get_global_id(0);\n"
 		"  int gy = get_global_id(1);\n"
 		"  float weight_mul_factor = %f;\n" // wt_mul_factor
 		"  if ((gx < %d) && (gy < %d)) {\n" // work_items[0], work_items[1]
-		, (int)opencl_local_work[0], (int)opencl_local_work[1], opencl_kernel_function_name, wt_mul_factor, work_items[0], work_items[1]);
+		, (int)opencl_local_work[0], (int)opencl_local_work[1], opencl_kernel_function_name,
+		packedCameraPlanes ? ",\n        __global uchar * cp_buf, uint cp_offset, uint cp_num_items" : "",
+		overflowTable ? ",\n        __global uchar * ov_buf, uint ov_offset, uint ov_num_items" : "",
+		wt_mul_factor, work_items[0], work_items[1]);
 	opencl_kernel_code = item;
+	// camera plane location in input and weight images: full size planes or packed camera planes
+	if (packedCameraPlanes) {
+		opencl_kernel_code +=
+			"  __global int4 * cam_plane = (__global int4 *)(cp_buf + cp_offset);\n"
+			"  #define PLANE_ROW(c) (gy + cam_plane[c].s1)\n"
+			"  #define PLANE_COL(c) ((gx << 2) + cam_plane[c].s0)\n";
+	}
+	else {
+		opencl_kernel_code +=
+			"  #define PLANE_ROW(c) (gy + op_height * (c))\n"
+			"  #define PLANE_COL(c) (gx << 2)\n";
+	}
 
 	opencl_kernel_code +=
 		"  uint4 pRGB_out;\n"
@@ -253,20 +307,44 @@ static vx_status VX_CALLBACK merge_opencl_codegen(
 		"  uint4 pRGBX_in; float4 weights;\n"
 		"  float16 fa = 0;\n"
 		"  if(camIdSelect < 31) {\n"
-		"    pRGBX_in = *(__global uint4 *) (ip_buf + ip_offset + ((gy + op_height * camIdSelect) * ip_stride) + (gx << 4));\n"
+		"    pRGBX_in = *(__global uint4 *) (ip_buf + ip_offset + (PLANE_ROW(camIdSelect) * ip_stride) + (PLANE_COL(camIdSelect) << 2));\n"
 		"    fa.s0123 += amd_unpack(pRGBX_in.s0);\n"
 		"    fa.s4567 += amd_unpack(pRGBX_in.s1);\n"
 		"    fa.s89AB += amd_unpack(pRGBX_in.s2);\n"
 		"    fa.sCDEF += amd_unpack(pRGBX_in.s3);\n"
-		"  }\n"
+		"  }\n";
+	if (overflowTable) {
+		// blocks with more cameras than group1 and group2 can hold: camera mask from overflow table
+		// (wide merge tables use 64-bit camera masks for rigs with more than STITCH_MERGE_MAX_CAMID_CAMERAS cameras)
+		opencl_kernel_code +=
+			"  else if(camIdSelect == 255) {\n"
+			"    uint ov_index = *(__global ushort *)(camID1_img_buf + camID1_img_offset + gy * camID1_img_stride + ((gx >> 1) << 1));\n"
+			"    ov_index |= (uint)*(__global ushort *)(camID2_img_buf + camID2_img_offset + gy * camID2_img_stride + ((gx >> 1) << 1)) << 16;\n";
+		opencl_kernel_code += wideOverflowTable ?
+			"    ulong camMask = (ov_index < ov_num_items) ? *(__global ulong *)(ov_buf + ov_offset + (ov_index << 3)) : 0;\n"
+			"    while (camMask) {\n"
+			"      uint camId = (uint)(63 - clz(camMask & (~camMask + 1)));\n" :
+			"    uint camMask = (ov_index < ov_num_items) ? *(__global uint *)(ov_buf + ov_offset + (ov_index << 2)) : 0;\n"
+			"    while (camMask) {\n"
+			"      uint camId = 31 - clz(camMask & (~camMask + 1));\n";
+		opencl_kernel_code +=
+			"      camMask &= camMask - 1;\n"
+			"      pRGBX_in = *(__global uint4 *) (ip_buf + ip_offset + (PLANE_ROW(camId) * ip_stride) + (PLANE_COL(camId) << 2));\n"
+			"      weights = convert_float4(*(__global uchar4 *) (wt_buf + wt_offset + (PLANE_ROW(camId) * wt_stride) + PLANE_COL(camId)));\n"
+			"      weights *= weight_mul_factor;\n"
+			"      fa.s0123 = mad((float4)weights.s0, amd_unpack(pRGBX_in.s0), fa.s0123); fa.s4567 = mad((float4)weights.s1, amd_unpack(pRGBX_in.s1), fa.s4567); fa.s89AB = mad((float4)weights.s2, amd_unpack(pRGBX_in.s2), fa.s89AB); fa.sCDEF = mad((float4)weights.s3, amd_unpack(pRGBX_in.s3), fa.sCDEF);\n"
+			"    }\n"
+			"  }\n";
+	}
+	opencl_kernel_code +=
 		"  else if(camIdSelect > 31) {\n"
 		"    camID1_img_buf += camID1_img_offset + gy * camID1_img_stride + ((gx >> 1) << 1);\n"
 		"    ushort camID_struct = *(__global ushort *)camID1_img_buf;\n"
 		"    ushort camId = camID_struct & 0x1f;\n"
 		"    pRGBX_in = (uint4)0;  weights = (float4)0;\n"
 		"    if (camId < 31) {\n"
-		"      pRGBX_in = *(__global uint4 *) (ip_buf + ip_offset + ((gy + op_height * camId) * ip_stride) + (gx << 4));\n"
-		"      weights = convert_float4(*(__global uchar4 *) (wt_buf + wt_offset + ((gy + op_height * camId) * wt_stride) + (gx << 2)));\n"
+		"      pRGBX_in = *(__global uint4 *) (ip_buf + ip_offset + (PLANE_ROW(camId) * ip_stride) + (PLANE_COL(camId) << 2));\n"
+		"      weights = convert_float4(*(__global uchar4 *) (wt_buf + wt_offset + (PLANE_ROW(camId) * wt_stride) + PLANE_COL(camId)));\n"
 		"      weights *= weight_mul_factor;\n"
 		"    }\n"
 		"    fa.s0123 += weights.s0 * amd_unpack(pRGBX_in.s0); fa.s4567 += weights.s1 * amd_unpack(pRGBX_in.s1); fa.s89AB += weights.s2 * amd_unpack(pRGBX_in.s2); fa.sCDEF += weights.s3 * amd_unpack(pRGBX_in.s3);\n"
@@ -274,8 +352,8 @@ static vx_status VX_CALLBACK merge_opencl_codegen(
 		"    camId = (camID_struct >> 5) & 0x1f;\n"
 		"    weights = (float4)0;\n"
 		"    if (camId < 31) {\n"
-		"      pRGBX_in = *(__global uint4 *) (ip_buf + ip_offset + ((gy + op_height * camId) * ip_stride) + (gx << 4));\n"
-		"      weights = convert_float4(*(__global uchar4 *) (wt_buf + wt_offset + ((gy + op_height * camId) * wt_stride) + (gx << 2)));\n"
+		"      pRGBX_in = *(__global uint4 *) (ip_buf + ip_offset + (PLANE_ROW(camId) * ip_stride) + (PLANE_COL(camId) << 2));\n"
+		"      weights = convert_float4(*(__global uchar4 *) (wt_buf + wt_offset + (PLANE_ROW(camId) * wt_stride) + PLANE_COL(camId)));\n"
 		"      weights *= weight_mul_factor;\n"
 		"    }\n"
 		"    fa.s0123 = mad((float4)weights.s0, amd_unpack(pRGBX_in.s0), fa.s0123); fa.s4567 = mad((float4)weights.s1, amd_unpack(pRGBX_in.s1), fa.s4567); fa.s89AB = mad((float4)weights.s2, amd_unpack(pRGBX_in.s2), fa.s89AB); fa.sCDEF = mad((float4)weights.s3, amd_unpack(pRGBX_in.s3), fa.sCDEF);\n"
@@ -283,8 +361,8 @@ static vx_status VX_CALLBACK merge_opencl_codegen(
 		"      camId = (camID_struct >> 10) & 0x1f;\n"
 		"      weights = (float4)0;\n"
 		"      if (camId < 31) {\n"
-		"        pRGBX_in = *(__global uint4 *) (ip_buf + ip_offset + ((gy + op_height * camId) * ip_stride) + (gx << 4));\n"
-		"        weights = convert_float4(*(__global uchar4 *) (wt_buf + wt_offset + ((gy + op_height * camId) * wt_stride) + (gx << 2)));\n"
+		"        pRGBX_in = *(__global uint4 *) (ip_buf + ip_offset + (PLANE_ROW(camId) * ip_stride) + (PLANE_COL(camId) << 2));\n"
+		"        weights = convert_float4(*(__global uchar4 *) (wt_buf + wt_offset + (PLANE_ROW(camId) * wt_stride) + PLANE_COL(camId)));\n"
 		"        weights *= weight_mul_factor;\n"
 		"      }\n"
 		"      fa.s0123 = mad((float4)weights.s0, amd_unpack(pRGBX_in.s0), fa.s0123); fa.s4567 = mad((float4)weights.s1, amd_unpack(pRGBX_in.s1), fa.s4567); fa.s89AB = mad((float4)weights.s2, amd_unpack(pRGBX_in.s2), fa.s89AB); fa.sCDEF = mad((float4)weights.s3, amd_unpack(pRGBX_in.s3), fa.sCDEF);\n"
@@ -295,8 +373,8 @@ static vx_status VX_CALLBACK merge_opencl_codegen(
 		"      camId = camID_struct & 0x1f;\n"
 		"      weights = (float4)0;\n"
 		"      if (camId < 31) {\n"
-		"        pRGBX_in = *(__global uint4 *) (ip_buf + ip_offset + ((gy + op_height * camId) * ip_stride) + (gx << 4));\n"
-		"        weights = convert_float4(*(__global uchar4 *) (wt_buf + wt_offset + ((gy + op_height * camId) * wt_stride) + (gx << 2)));\n"
+		"        pRGBX_in = *(__global uint4 *) (ip_buf + ip_offset + (PLANE_ROW(camId) * ip_stride) + (PLANE_COL(camId) << 2));\n"
+		"        weights = convert_float4(*(__global uchar4 *) (wt_buf + wt_offset + (PLANE_ROW(camId) * wt_stride) + PLANE_COL(camId)));\n"
 		"        weights *= weight_mul_factor;\n"
 		"      }\n"
 		"      fa.s0123 = mad((float4)weights.s0, amd_unpack(pRGBX_in.s0), fa.s0123); fa.s4567 = mad((float4)weights.s1, amd_unpack(pRGBX_in.s1), fa.s4567); fa.s89AB = mad((float4)weights.s2, amd_unpack(pRGBX_in.s2), fa.s89AB); fa.sCDEF = mad((float4)weights.s3, amd_unpack(pRGBX_in.s3), fa.sCDEF);\n"
@@ -305,8 +383,8 @@ static vx_status VX_CALLBACK merge_opencl_codegen(
 		"      camId = (camID_struct >> 5) & 0x1f;\n"
 		"       weights = (float4)0;\n"
 		"      if (camId < 31) {\n"
-		"        pRGBX_in = *(__global uint4 *) (ip_buf + ip_offset + ((gy + op_height * camId) * ip_stride) + (gx << 4));\n"
-		"        weights = convert_float4(*(__global uchar4 *) (wt_buf + wt_offset + ((gy + op_height * camId) * wt_stride) + (gx << 2)));\n"
+		"        pRGBX_in = *(__global uint4 *) (ip_buf + ip_offset + (PLANE_ROW(camId) * ip_stride) + (PLANE_COL(camId) << 2));\n"
+		"        weights = convert_float4(*(__global uchar4 *) (wt_buf + wt_offset + (PLANE_ROW(camId) * wt_stride) + PLANE_COL(camId)));\n"
 		"        weights *= weight_mul_factor;\n"
 		"      }\n"
 		"      fa.s0123 = mad((float4)weights.s0, amd_unpack(pRGBX_in.s0), fa.s0123); fa.s4567 = mad((float4)weights.s1, amd_unpack(pRGBX_in.s1), fa.s4567); fa.s89AB = mad((float4)weights.s2, amd_unpack(pRGBX_in.s2), fa.s89AB); fa.sCDEF = mad((float4)weights.s3, amd_unpack(pRGBX_in.s3), fa.sCDEF);\n"
@@ -315,8 +393,8 @@ static vx_status VX_CALLBACK merge_opencl_codegen(
 		"      camId = (camID_struct >> 10) & 0x1f;\n"
 		"      weights = (float4)0;\n"
 		"      if (camId < 31) {\n"
-		"        pRGBX_in = *(__global uint4 *) (ip_buf + ip_offset + ((gy + op_height * camId) * ip_stride) + (gx << 4));\n"
-		"        weights = convert_float4(*(__global uchar4 *) (wt_buf + wt_offset + ((gy + op_height * camId) * wt_stride) + (gx << 2)));\n"
+		"        pRGBX_in = *(__global uint4 *) (ip_buf + ip_offset + (PLANE_ROW(camId) * ip_stride) + (PLANE_COL(camId) << 2));\n"
+		"        weights = convert_float4(*(__global uchar4 *) (wt_buf + wt_offset + (PLANE_ROW(camId) * wt_stride) + PLANE_COL(camId)));\n"
 		"        weights *= weight_mul_factor;\n"
 		"      }\n"
 		"      fa.s0123 = mad((float4)weights.s0, amd_unpack(pRGBX_in.s0), fa.s0123); fa.s4567 = mad((float4)weights.s1, amd_unpack(pRGBX_in.s1), fa.s4567); fa.s89AB = mad((float4)weights.s2, amd_unpack(pRGBX_in.s2), fa.s89AB); fa.sCDEF = mad((float4)weights.s3, amd_unpack(pRGBX_in.s3), fa.sCDEF);\n"
@@ -361,10 +439,143 @@ static vx_status VX_CALLBACK merge_deinitialize(vx_node node, const vx_reference
 	return VX_SUCCESS;
 }
 
-//! \brief The kernel execution.
+//! \brief The kernel execution: used with host execution and matches the OpenCL kernel.
 static vx_status VX_CALLBACK merge_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_IMPLEMENTED;
+	// get input and output image configurations
+	vx_image camId_image = (vx_image)parameters[0];
+	vx_image group1_image = (vx_image)parameters[1];
+	vx_image group2_image = (vx_image)parameters[2];
+	vx_image input_image = (vx_image)parameters[3];
+	vx_image weight_image = (vx_image)parameters[4];
+	vx_image output_image = (vx_image)parameters[5];
+	vx_array cam_plane_arr = (vx_array)parameters[6];
+	vx_array overflow_arr = (vx_array)parameters[7];
+	vx_uint32 width = 0, height = 0, camId_width = 0, ip_width = 0, ip_height = 0;
+	vx_df_image output_format = VX_DF_IMAGE_VIRT;
+	ERROR_CHECK_STATUS(vxQueryImage(output_image, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage(output_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	ERROR_CHECK_STATUS(vxQueryImage(output_image, VX_IMAGE_ATTRIBUTE_FORMAT, &output_format, sizeof(output_format)));
+	ERROR_CHECK_STATUS(vxQueryImage(camId_image, VX_IMAGE_ATTRIBUTE_WIDTH, &camId_width, sizeof(camId_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_WIDTH, &ip_width, sizeof(ip_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &ip_height, sizeof(ip_height)));
+	vx_uint32 op_pixel_size = (output_format == VX_DF_IMAGE_RGBX) ? 4 : 3;
+
+	// access images
+	vx_rectangle_t camId_rect = { 0, 0, camId_width, height };
+	vx_rectangle_t ip_rect = { 0, 0, ip_width, ip_height }, op_rect = { 0, 0, width, height };
+	vx_imagepatch_addressing_t camId_addr, group1_addr, group2_addr, ip_addr, wt_addr, op_addr;
+	void * camId_ptr = nullptr, * group1_ptr = nullptr, * group2_ptr = nullptr, * ip_ptr = nullptr, * wt_ptr = nullptr, * op_ptr = nullptr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(camId_image, &camId_rect, 0, &camId_addr, &camId_ptr, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(group1_image, &camId_rect, 0, &group1_addr, &group1_ptr, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(group2_image, &camId_rect, 0, &group2_addr, &group2_ptr, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(input_image, &ip_rect, 0, &ip_addr, &ip_ptr, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(weight_image, &ip_rect, 0, &wt_addr, &wt_ptr, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(output_image, &op_rect, 0, &op_addr, &op_ptr, VX_READ_AND_WRITE));
+	vx_size cp_num_items = 0, ov_num_items = 0, cp_stride = 0, ov_stride = 0;
+	StitchCameraPlaneEntry * cp_buf = nullptr;
+	vx_uint8 * ov_buf = nullptr;
+	if (cam_plane_arr) {
+		ERROR_CHECK_STATUS(vxQueryArray(cam_plane_arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &cp_num_items, sizeof(cp_num_items)));
+		if (cp_num_items > 0) {
+			ERROR_CHECK_STATUS(vxAccessArrayRange(cam_plane_arr, 0, cp_num_items, &cp_stride, (void **)&cp_buf, VX_READ_ONLY));
+		}
+	}
+	if (overflow_arr) {
+		ERROR_CHECK_STATUS(vxQueryArray(overflow_arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &ov_num_items, sizeof(ov_num_items)));
+		if (ov_num_items > 0) {
+			ERROR_CHECK_STATUS(vxAccessArrayRange(overflow_arr, 0, ov_num_items, &ov_stride, (void **)&ov_buf, VX_READ_ONLY));
+		}
+	}
+
+	// blend each block of 8 pixels from the cameras selected by camId, group1/group2, or overflow tables
+	const vx_float32 weight_mul_factor = 1.0f / 255.0f;
+#pragma omp parallel for
+	for (int y = 0; y < (int)height; y++) {
+		const vx_uint8 * camId_row = (const vx_uint8 *)camId_ptr + y * camId_addr.stride_y;
+		const vx_uint8 * group1_row = (const vx_uint8 *)group1_ptr + y * group1_addr.stride_y;
+		const vx_uint8 * group2_row = (const vx_uint8 *)group2_ptr + y * group2_addr.stride_y;
+		vx_uint8 * op_row = (vx_uint8 *)op_ptr + y * op_addr.stride_y;
+		for (vx_uint32 xb = 0; xb < camId_width && xb * 8 < width; xb++) {
+			vx_uint8 camIdSelect = camId_row[xb];
+			if (camIdSelect == 31)
+				continue;
+			// list of cameras contributing to this block
+			vx_uint32 camList[LIVE_STITCH_MAX_CAMERAS], camCount = 0;
+			if (camIdSelect < 31) {
+				camList[camCount++] = camIdSelect;
+			}
+			else {
+				vx_uint16 group1 = 0, group2 = 0;
+				memcpy(&group1, group1_row + xb * 2, sizeof(group1));
+				memcpy(&group2, group2_row + xb * 2, sizeof(group2));
+				if (camIdSelect == 255 && overflow_arr) {
+					vx_uint32 ov_index = (vx_uint32)group1 | ((vx_uint32)group2 << 16);
+					vx_uint64 camMask = 0;
+					if (ov_index < ov_num_items) {
+						if (ov_stride == sizeof(vx_uint64)) {
+							memcpy(&camMask, ov_buf + ov_index * ov_stride, sizeof(vx_uint64));
+						}
+						else {
+							vx_uint32 camMask32 = 0;
+							memcpy(&camMask32, ov_buf + ov_index * ov_stride, sizeof(camMask32));
+							camMask = camMask32;
+						}
+					}
+					for (vx_uint32 c = 0; c < LIVE_STITCH_MAX_CAMERAS; c++)
+						if (camMask & StitchCameraBit(c))
+							camList[camCount++] = c;
+				}
+				else {
+					vx_uint32 ids[6] = { group1 & 0x1fu, (group1 >> 5) & 0x1fu, (group1 >> 10) & 0x1fu, group2 & 0x1fu, (group2 >> 5) & 0x1fu, (group2 >> 10) & 0x1fu };
+					vx_uint32 numIds = (camIdSelect > 131) ? 6 : (camIdSelect > 130) ? 5 : (camIdSelect > 129) ? 4 : (camIdSelect > 128) ? 3 : 2;
+					for (vx_uint32 k = 0; k < numIds; k++)
+						if (ids[k] < 31)
+							camList[camCount++] = ids[k];
+				}
+			}
+			// accumulate 8 pixels
+			vx_float32 fa[8][4] = { { 0.0f } };
+			for (vx_uint32 k = 0; k < camCount; k++) {
+				vx_uint32 c = camList[k];
+				vx_uint32 plane_row = y + height * c, plane_col = xb * 8;
+				if (cp_buf) {
+					const StitchCameraPlaneEntry * cp = (const StitchCameraPlaneEntry *)((const vx_uint8 *)cp_buf + c * cp_stride);
+					plane_row = y + cp->offsetY;
+					plane_col = xb * 8 + cp->offsetX;
+				}
+				const vx_uint8 * ip = (const vx_uint8 *)ip_ptr + plane_row * ip_addr.stride_y + plane_col * 4;
+				const vx_uint8 * wt = (const vx_uint8 *)wt_ptr + plane_row * wt_addr.stride_y + plane_col;
+				for (vx_uint32 i = 0; i < 8; i++) {
+					vx_float32 w = (camIdSelect < 31) ? 1.0f : wt[i] * weight_mul_factor;
+					for (vx_uint32 ch = 0; ch < 4; ch++)
+						fa[i][ch] += ip[i * 4 + ch] * w;
+				}
+			}
+			for (vx_uint32 i = 0, x = xb * 8; i < 8 && x < width; i++, x++) {
+				vx_uint8 * op = op_row + x * op_pixel_size;
+				op[0] = StitchPackU8(fa[i][0]);
+				op[1] = StitchPackU8(fa[i][1]);
+				op[2] = StitchPackU8(fa[i][2]);
+				if (op_pixel_size == 4)
+					op[3] = 255;
+			}
+		}
+	}
+
+	if (cp_buf) {
+		ERROR_CHECK_STATUS(vxCommitArrayRange(cam_plane_arr, 0, cp_num_items, cp_buf));
+	}
+	if (ov_buf) {
+		ERROR_CHECK_STATUS(vxCommitArrayRange(overflow_arr, 0, ov_num_items, ov_buf));
+	}
+	ERROR_CHECK_STATUS(vxCommitImagePatch(camId_image, &camId_rect, 0, &camId_addr, camId_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(group1_image, &camId_rect, 0, &group1_addr, group1_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(group2_image, &camId_rect, 0, &group2_addr, group2_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(input_image, &ip_rect, 0, &ip_addr, ip_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(weight_image, &ip_rect, 0, &wt_addr, wt_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(output_image, &op_rect, 0, &op_addr, op_ptr));
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel publisher.
@@ -374,7 +585,7 @@ vx_status merge_publish(vx_context context)
 	vx_kernel kernel = vxAddKernel(context, "com.amd.loomsl.merge",
 		AMDOVX_KERNEL_STITCHING_MERGE,
 		merge_kernel,
-		6,
+		8,
 		merge_input_validator,
 		merge_output_validator,
 		merge_initialize,
@@ -392,6 +603,8 @@ vx_status merge_publish(vx_context context)
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 3, VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 4, VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 5, VX_OUTPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 6, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_OPTIONAL));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 7, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_OPTIONAL));
 
 	// finalize and release kernel object
 	ERROR_CHECK_STATUS(vxFinalizeKernel(kernel));
@@ -400,78 +613,100 @@ vx_status merge_publish(vx_context context)
 	return VX_SUCCESS;
 }
 
+//////////////////////////////////////////////////////////////////////
+//! \brief Get the masks of cameras used by any and by all pixels of a block of 8 pixels.
+static inline void GetMergeBlockCamMasks(const vx_uint64 * validPixelCamMap, const vx_uint64 * paddedPixelCamMap,
+	vx_uint64& validMaskFor8Pixels, vx_uint64& commonValidMaskFor8Pixels)
+{
+	validMaskFor8Pixels = 0;
+	commonValidMaskFor8Pixels = ~(vx_uint64)0;
+	for (vx_uint32 i = 0; i < 8; i++) {
+		vx_uint64 mask = validPixelCamMap[i] | (paddedPixelCamMap ? paddedPixelCamMap[i] : 0);
+		validMaskFor8Pixels |= mask;
+		commonValidMaskFor8Pixels &= mask;
+	}
+}
+
+//! \brief Check if a block goes into the overflow table.
+//  With wide merge tables, only fully covered single camera blocks with camId below 31 stay in camId table.
+static inline bool IsMergeOverflowBlock(bool wideMerge, vx_uint64 validMaskFor8Pixels, vx_uint64 commonValidMaskFor8Pixels)
+{
+	vx_uint32 count = GetOneBitCount(validMaskFor8Pixels);
+	if (wideMerge) {
+		return count > 1 || (count == 1 && (commonValidMaskFor8Pixels == 0 ||
+			GetOneBitPosition(validMaskFor8Pixels) >= STITCH_MERGE_MAX_CAMID_CAMERAS));
+	}
+	return count > STITCH_MERGE_MAX_GROUP_CAMERAS;
+}
+
 //////////////////////////////////////////////////////////////////////
 // Generate data in buffers for merge
 vx_status GenerateMergeBuffers(
 	vx_uint32 numCamera,                  // [in] number of cameras
 	vx_uint32 eqrWidth,                   // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                  // [in] output equirectangular image height
-	const vx_uint32 * validPixelCamMap,   // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
-	const vx_uint32 * paddedPixelCamMap,  // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight] (optional)
+	const vx_uint64 * validPixelCamMap,   // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * paddedPixelCamMap,  // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight] (optional)
 	vx_uint32  camIdStride,               // [in] stride (in bytes) of camId table (image)
 	vx_uint32  camGroup1Stride,           // [in] stride (in bytes) of camGroup1 table (image)
 	vx_uint32  camGroup2Stride,           // [in] stride (in bytes) of camGroup2 table (image)
 	vx_uint8 * camIdBuf,                  // [out] camId table (image)
 	StitchMergeCamIdEntry * camGroup1Buf, // [out] camId Group1 table (image)
-	StitchMergeCamIdEntry * camGroup2Buf  // [out] camId Group2 table (image)
+	StitchMergeCamIdEntry * camGroup2Buf, // [out] camId Group2 table (image)
+	vx_size    overflowTableSize,         // [in] size of overflow table, in terms of number of entries
+	vx_uint32 * overflowBuf,              // [out] overflow table: camera mask for each overflow block (optional)
+	vx_size  * overflowEntryCount,        // [out] number of entries added to overflow table (optional)
+	vx_uint64 * overflowBufWide           // [out] wide overflow table: camera mask for each overflow block (required with wide merge tables)
 	)
 {
+	bool wideMerge = numCamera > STITCH_MERGE_MAX_CAMID_CAMERAS;
+	vx_size overflowCount = 0;
 	for (vx_uint32 y = 0; y < eqrHeight; y++) {
 		for (vx_uint32 x = 0, xi = 0; x < eqrWidth; x += 8, xi++) {
-			vx_uint32 validMaskFor8Pixels =
-				validPixelCamMap[x + 0] | validPixelCamMap[x + 1] |
-				validPixelCamMap[x + 2] | validPixelCamMap[x + 3] |
-				validPixelCamMap[x + 4] | validPixelCamMap[x + 5] |
-				validPixelCamMap[x + 6] | validPixelCamMap[x + 7];
-			if (paddedPixelCamMap) {
-				validMaskFor8Pixels |=
-					paddedPixelCamMap[x + 0] | paddedPixelCamMap[x + 1] |
-					paddedPixelCamMap[x + 2] | paddedPixelCamMap[x + 3] |
-					paddedPixelCamMap[x + 4] | paddedPixelCamMap[x + 5] |
-					paddedPixelCamMap[x + 6] | paddedPixelCamMap[x + 7];
-			}
+			vx_uint64 validMaskFor8Pixels, commonValidMaskFor8Pixels;
+			GetMergeBlockCamMasks(validPixelCamMap + x, paddedPixelCamMap ? paddedPixelCamMap + x : nullptr, validMaskFor8Pixels, commonValidMaskFor8Pixels);
 			vx_uint32 count = GetOneBitCount(validMaskFor8Pixels);
+			// use two pixel mode with second cam as 31 if not all 8 pixels are from same camera
+			if (count == 1 && commonValidMaskFor8Pixels == 0) {
+				count = 2;
+			}
 			vx_uint8 camId = 31;
 			vx_uint8 id[6] = { 31, 31, 31, 31, 31, 31 };
-			if (count == 1) {
-				// use two pixel mode with second cam as 31 if not all 8 pixels are from same camera
-				vx_uint32 commonValidMaskFor8Pixels =
-					validPixelCamMap[x + 0] & validPixelCamMap[x + 1] &
-					validPixelCamMap[x + 2] & validPixelCamMap[x + 3] &
-					validPixelCamMap[x + 4] & validPixelCamMap[x + 5] &
-					validPixelCamMap[x + 6] & validPixelCamMap[x + 7];
-				if (paddedPixelCamMap) {
-					commonValidMaskFor8Pixels =
-						(validPixelCamMap[x + 0] | paddedPixelCamMap[x + 0]) &
-						(validPixelCamMap[x + 1] | paddedPixelCamMap[x + 1]) &
-						(validPixelCamMap[x + 2] | paddedPixelCamMap[x + 2]) &
-						(validPixelCamMap[x + 3] | paddedPixelCamMap[x + 3]) &
-						(validPixelCamMap[x + 4] | paddedPixelCamMap[x + 4]) &
-						(validPixelCamMap[x + 5] | paddedPixelCamMap[x + 5]) &
-						(validPixelCamMap[x + 6] | paddedPixelCamMap[x + 6]) &
-						(validPixelCamMap[x + 7] | paddedPixelCamMap[x + 7]);
-				}
-
-				if (commonValidMaskFor8Pixels == 0) {
-					count = 2;
-				}
+			bool overflowBlock = IsMergeOverflowBlock(wideMerge, validMaskFor8Pixels, commonValidMaskFor8Pixels);
+			if (overflowBlock && wideMerge && !overflowBufWide) {
+				// camId and group entries can't address all cameras of wide merge tables
+				return VX_ERROR_NOT_SUFFICIENT;
 			}
-			if (count == 1) {
-				camId = (vx_uint8)GetOneBitPosition(validMaskFor8Pixels);
+			if (overflowBlock && (overflowBuf || overflowBufWide)) {
+				// camera mask goes into overflow table and group1/group2 hold the index
+				if (overflowCount < overflowTableSize) {
+					if (overflowBufWide) overflowBufWide[overflowCount] = validMaskFor8Pixels;
+					else overflowBuf[overflowCount] = (vx_uint32)validMaskFor8Pixels;
+				}
+				camId = STITCH_MERGE_CAMID_OVERFLOW;
+				vx_uint16 index1 = (vx_uint16)(overflowCount & 0xffff), index2 = (vx_uint16)(overflowCount >> 16);
+				memcpy(&camGroup1Buf[xi], &index1, sizeof(index1));
+				memcpy(&camGroup2Buf[xi], &index2, sizeof(index2));
+				overflowCount++;
 			}
-			else if (count >= 2) {
-				camId = (vx_uint8)(126 + count);
-				for (vx_uint32 j = 0, k = 0; j < 32 && k < 6; j++) {
-					if (validMaskFor8Pixels & (1 << j)) {
-						id[k++] = j;
+			else {
+				if (count == 1) {
+					camId = (vx_uint8)GetOneBitPosition(validMaskFor8Pixels);
+				}
+				else if (count >= 2) {
+					camId = (vx_uint8)(126 + std::min(count, (vx_uint32)STITCH_MERGE_MAX_GROUP_CAMERAS));
+					for (vx_uint32 j = 0, k = 0; j < 32 && k < 6; j++) {
+						if (validMaskFor8Pixels & StitchCameraBit(j)) {
+							id[k++] = j;
+						}
 					}
 				}
+				StitchMergeCamIdEntry group1 = { id[0], id[1], id[2], 0 };
+				StitchMergeCamIdEntry group2 = { id[3], id[4], id[5], 0 };
+				camGroup1Buf[xi] = group1;
+				camGroup2Buf[xi] = group2;
 			}
-			StitchMergeCamIdEntry group1 = { id[0], id[1], id[2], 0 };
-			StitchMergeCamIdEntry group2 = { id[3], id[4], id[5], 0 };
 			camIdBuf[xi] = camId;
-			camGroup1Buf[xi] = group1;
-			camGroup2Buf[xi] = group2;
 		}
 		validPixelCamMap += eqrWidth;
 		if (paddedPixelCamMap) paddedPixelCamMap += eqrWidth;
@@ -479,6 +714,36 @@ vx_status GenerateMergeBuffers(
 		camGroup1Buf += (camGroup1Stride >> 1);
 		camGroup2Buf += (camGroup2Stride >> 1);
 	}
+	if (overflowCount > overflowTableSize && (overflowBuf || overflowBufWide)) {
+		return VX_ERROR_NOT_SUFFICIENT;
+	}
+	if (overflowEntryCount) *overflowEntryCount = overflowCount;
+	return VX_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Calculate number of merge overflow table entries
+vx_status CalculateMergeOverflowBufferSize(
+	vx_uint32 numCamera,                  // [in] number of cameras
+	vx_uint32 eqrWidth,                   // [in] output equirectangular image width
+	vx_uint32 eqrHeight,                  // [in] output equirectangular image height
+	const vx_uint64 * validPixelCamMap,   // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * paddedPixelCamMap,  // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight] (optional)
+	vx_size * overflowTableSize           // [out] number of entries needed by overflow table
+	)
+{
+	bool wideMerge = numCamera > STITCH_MERGE_MAX_CAMID_CAMERAS;
+	vx_size overflowCount = 0;
+	if (numCamera > STITCH_MERGE_MAX_GROUP_CAMERAS) {
+		for (vx_uint32 pixelPosition = 0; pixelPosition < eqrWidth * eqrHeight; pixelPosition += 8) {
+			vx_uint64 validMaskFor8Pixels, commonValidMaskFor8Pixels;
+			GetMergeBlockCamMasks(validPixelCamMap + pixelPosition, paddedPixelCamMap ? paddedPixelCamMap + pixelPosition : nullptr,
+				validMaskFor8Pixels, commonValidMaskFor8Pixels);
+			if (IsMergeOverflowBlock(wideMerge, validMaskFor8Pixels, commonValidMaskFor8Pixels))
+				overflowCount++;
+		}
+	}
+	*overflowTableSize = overflowCount;
 	return VX_SUCCESS;
 }
 
@@ -504,3 +769,37 @@ vx_status GenerateDefaultMergeMaskImage(
 	}
 	return VX_SUCCESS;
 }
+
+//////////////////////////////////////////////////////////////////////
+// Generate default merge mask image for packed camera planes
+vx_status GeneratePackedMergeMaskImage(
+	vx_uint32 numCamera,                  // [in] number of cameras
+	vx_uint32 eqrWidth,                   // [in] output equirectangular image width
+	vx_uint32 eqrHeight,                  // [in] output equirectangular image height
+	const vx_uint8 * defaultCamIndex,     // [in] default camera index (255 refers to no camera): size: [eqrWidth * eqrHeight]
+	const StitchCameraPlaneEntry * cameraPlane, // [in] camera planes: size: [numCamera]
+	vx_uint32  packedWidth,               // [in] width of packed mask image
+	vx_uint32  maskStride,                // [in] stride (in bytes) of mask image
+	vx_uint8 * maskBuf                    // [out] mask image buffer: size: [packedWidth * packedHeight]
+	)
+{
+	vx_uint32 maskPosition = 0;
+	for (vx_uint32 camId = 0; camId < numCamera; camId++) {
+		const StitchCameraPlaneEntry& plane = cameraPlane[camId];
+		// camera planes are stacked vertically in camera order
+		vx_int32 yp = (vx_int32)(maskPosition / maskStride);
+		for (vx_uint32 i = 0; i < plane.height; i++, yp++) {
+			vx_int32 y = yp - plane.offsetY;
+			for (vx_uint32 xp = 0; xp < packedWidth; xp++) {
+				vx_int32 x = (vx_int32)xp - plane.offsetX;
+				vx_uint8 mask = 0;
+				if (xp < plane.width && x >= 0 && x < (vx_int32)eqrWidth && y >= 0 && y < (vx_int32)eqrHeight) {
+					mask = (defaultCamIndex[y * eqrWidth + x] == camId) ? 255 : 0;
+				}
+				maskBuf[maskPosition + xp] = mask;
+			}
+			maskPosition += maskStride;
+		}
+	}
+	return VX_SUCCESS;
+}
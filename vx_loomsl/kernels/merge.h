@@ -26,6 +26,7 @@ THE SOFTWARE.
 
 #include "kernels.h"
 #include "lens_distortion_remap.h"
+#include "warp.h"
 
 //////////////////////////////////////////////////////////////////////
 //! \brief The merge cameraId packing within U016 pixel entry.
@@ -36,24 +37,53 @@ typedef struct {
 	vx_uint16 reserved0 : 1; // reserved (shall be zero)
 } StitchMergeCamIdEntry;
 
+//////////////////////////////////////////////////////////////////////
+//! \brief The merge overflow encoding for blocks with more cameras than camId group1 and group2 can hold.
+//  The camId table has STITCH_MERGE_CAMID_OVERFLOW and group1 (low 16 bits) with group2 (high 16 bits)
+//  is an index into the overflow table: each overflow table entry is a vx_uint32 mask of cameras.
+//  Rigs with more than STITCH_MERGE_MAX_CAMID_CAMERAS cameras use wide merge tables: camId and group ids
+//  can't address all cameras, so all blocks other than fully covered single camera blocks with camId
+//  below 31 go into the overflow table of vx_uint64 camera masks (VX_TYPE_UINT64 overflow array).
+#define STITCH_MERGE_MAX_GROUP_CAMERAS         6 // number of cameras in camId group1 and group2
+#define STITCH_MERGE_MAX_CAMID_CAMERAS        31 // number of cameras addressable by 5-bit camId and group entries
+#define STITCH_MERGE_CAMID_OVERFLOW          255 // camId table value for blocks in overflow table
+
 //////////////////////////////////////////////////////////////////////
 //! \brief The kernel registration functions.
 vx_status merge_publish(vx_context context);
 
 //////////////////////////////////////////////////////////////////////
-// Generate data in buffers for merge
+// Calculate buffer sizes and generate data in buffers for merge
+//   CalculateMergeOverflowBufferSize - number of 8 pixel blocks with more than STITCH_MERGE_MAX_GROUP_CAMERAS cameras
+//                                      (or all blocks needing overflow entries with wide merge tables)
+//   GenerateMergeBuffers             - generate tables: blocks with more than STITCH_MERGE_MAX_GROUP_CAMERAS cameras
+//                                      use only first cameras when overflowBuf is NULL; overflowBufWide is used
+//                                      instead of overflowBuf when numCamera > STITCH_MERGE_MAX_CAMID_CAMERAS
+vx_status CalculateMergeOverflowBufferSize(
+	vx_uint32 numCamera,                  // [in] number of cameras
+	vx_uint32 eqrWidth,                   // [in] output equirectangular image width
+	vx_uint32 eqrHeight,                  // [in] output equirectangular image height
+	const vx_uint64 * validPixelCamMap,   // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * paddedPixelCamMap,  // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight] (optional)
+	vx_size * overflowTableSize           // [out] number of entries needed by overflow table
+	);
+
 vx_status GenerateMergeBuffers(
 	vx_uint32 numCamera,                  // [in] number of cameras
 	vx_uint32 eqrWidth,                   // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                  // [in] output equirectangular image height
-	const vx_uint32 * validPixelCamMap,   // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
-	const vx_uint32 * paddedPixelCamMap,  // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight] (optional)
+	const vx_uint64 * validPixelCamMap,   // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * paddedPixelCamMap,  // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight] (optional)
 	vx_uint32  camIdStride,               // [in] stride (in bytes) of camId table (image)
 	vx_uint32  camGroup1Stride,           // [in] stride (in bytes) of camGroup1 table (image)
 	vx_uint32  camGroup2Stride,           // [in] stride (in bytes) of camGroup2 table (image)
 	vx_uint8 * camIdBuf,                  // [out] camId table (image)
 	StitchMergeCamIdEntry * camGroup1Buf, // [out] camId Group1 table (image)
-	StitchMergeCamIdEntry * camGroup2Buf  // [out] camId Group2 table (image)
+	StitchMergeCamIdEntry * camGroup2Buf, // [out] camId Group2 table (image)
+	vx_size    overflowTableSize = 0,     // [in] size of overflow table, in terms of number of entries
+	vx_uint32 * overflowBuf = nullptr,    // [out] overflow table: camera mask for each overflow block (optional)
+	vx_size  * overflowEntryCount = nullptr, // [out] number of entries added to overflow table (optional)
+	vx_uint64 * overflowBufWide = nullptr // [out] wide overflow table: camera mask for each overflow block (required with wide merge tables)
 	);
 
 //////////////////////////////////////////////////////////////////////
@@ -67,4 +97,17 @@ vx_status GenerateDefaultMergeMaskImage(
 	vx_uint8 * maskBuf                    // [out] mask image buffer: size: [eqrWidth * eqrHeight * numCamera]
 	);
 
+//////////////////////////////////////////////////////////////////////
+// Generate default merge mask image for packed camera planes
+vx_status GeneratePackedMergeMaskImage(
+	vx_uint32 numCamera,                  // [in] number of cameras
+	vx_uint32 eqrWidth,                   // [in] output equirectangular image width
+	vx_uint32 eqrHeight,                  // [in] output equirectangular image height
+	const vx_uint8 * defaultCamIndex,     // [in] default camera index (255 refers to no camera): size: [eqrWidth * eqrHeight]
+	const StitchCameraPlaneEntry * cameraPlane, // [in] camera planes: size: [numCamera]
+	vx_uint32  packedWidth,               // [in] width of packed mask image
+	vx_uint32  maskStride,                // [in] stride (in bytes) of mask image
+	vx_uint8 * maskBuf                    // [out] mask image buffer: size: [packedWidth * packedHeight]
+	);
+
 #endif //__MERGE_H__
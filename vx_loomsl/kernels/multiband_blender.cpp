@@ -22,6 +22,7 @@ THE SOFTWARE.
 
 #define _CRT_SECURE_NO_WARNINGS
 #include "multiband_blender.h"
+#include "pyramid_scale.h"
 
 //! \brief The input validator callback.
 static vx_status VX_CALLBACK multiband_blend_input_validator(vx_node node, vx_uint32 index)
@@ -89,7 +90,7 @@ static vx_status VX_CALLBACK multiband_blend_input_validator(vx_node node, vx_ui
 	{ // array object for offsets
 		vx_size itemsize = 0;
 		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
-		if (itemsize == sizeof(StitchBlendValidEntry)) {
+		if (itemsize == sizeof(StitchBlendValidEntry) || itemsize == sizeof(StitchBlendValidWideEntry)) {
 			status = VX_SUCCESS;
 		}
 		else {
@@ -144,7 +145,7 @@ static vx_status VX_CALLBACK multiband_blend_query_target_support(vx_graph graph
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = PyramidTargetAffinity(graph);
 	return VX_SUCCESS;
 }
 
@@ -193,8 +194,10 @@ static vx_status VX_CALLBACK multiband_blend_opencl_codegen(
 	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
 	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_FORMAT, &out_format, sizeof(out_format)));
 	ERROR_CHECK_STATUS(vxReleaseImage(&image));
+	vx_size wg_itemsize = 0;
 	vx_array wg_offsets = (vx_array)avxGetNodeParamRef(node, 4);
 	ERROR_CHECK_STATUS(vxQueryArray(wg_offsets, VX_ARRAY_ATTRIBUTE_CAPACITY, &wg_num, sizeof(wg_num)));
+	ERROR_CHECK_STATUS(vxQueryArray(wg_offsets, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &wg_itemsize, sizeof(wg_itemsize)));
 	ERROR_CHECK_STATUS(vxReleaseArray(&wg_offsets));
 	// set kernel configuration
 	strcpy(opencl_kernel_function_name, "multiband_blend");
@@ -225,8 +228,8 @@ static vx_status VX_CALLBACK multiband_blend_opencl_codegen(
 		"{\n"
 		"	int grp_id = get_global_id(0)>>4, lx = get_local_id(0), ly = get_local_id(1);\n"
 		"	if (grp_id < pG_num) {\n"
-		"	uint2 offs = ((__global uint2 *)(pG_buf+pG_offs))[grp_id+arr_offs];\n"
-		"	uint camera_id = offs.x & 0x1f; uint gx = (lx<<2) + ((offs.x >> 5) & 0x3FFF); uint gy = ly + (offs.x >> 19);\n"
+		"	BLEND_ENTRY offs = ((__global BLEND_ENTRY *)(pG_buf+pG_offs))[grp_id+arr_offs];\n"
+		"	uint camera_id = BLEND_CAM(offs); uint gx = (lx<<2) + BLEND_X(offs); uint gy = ly + BLEND_Y(offs);\n"
 		"	bool outputValid = (lx*4 <= (offs.y & 0xFF)) && (ly <= ((offs.y >> 8) & 0xFF));\n"
 		"	op_buf  += op_offset + mad24(gy, op_stride, gx*6);\n"
 		"	ip_buf += (camera_id * ip_stride*%d);\n"
@@ -294,13 +297,71 @@ static vx_status VX_CALLBACK multiband_blend_opencl_codegen(
 		" }\n"
 	" }\n";
 	}
+	opencl_kernel_code = GetBlendValidEntryOpenCLMacros(wg_itemsize == sizeof(StitchBlendValidWideEntry)) + opencl_kernel_code;
 	return VX_SUCCESS;
 }
 
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK multiband_blend_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_IMPLEMENTED;
+	vx_uint32 numCam = 0, arr_offset = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &numCam));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[1], &arr_offset));
+	std::vector<StitchBlendTile> tiles;
+	ERROR_CHECK_STATUS(GetBlendWorkList((vx_array)parameters[4], arr_offset, tiles));
+
+	// access input, weight and output images
+	vx_image image[3] = { (vx_image)parameters[2], (vx_image)parameters[3], (vx_image)parameters[5] };
+	vx_enum usage[3] = { VX_READ_ONLY, VX_READ_ONLY, VX_WRITE_ONLY };
+	vx_rectangle_t rect[3]; vx_imagepatch_addressing_t addr[3]; void * ptr[3] = { nullptr, nullptr, nullptr };
+	vx_uint32 width[3] = { 0 }, height[3] = { 0 }; vx_df_image format[3] = { VX_DF_IMAGE_VIRT };
+	for (int i = 0; i < 3; i++) {
+		ERROR_CHECK_STATUS(vxQueryImage(image[i], VX_IMAGE_ATTRIBUTE_WIDTH, &width[i], sizeof(width[i])));
+		ERROR_CHECK_STATUS(vxQueryImage(image[i], VX_IMAGE_ATTRIBUTE_HEIGHT, &height[i], sizeof(height[i])));
+		ERROR_CHECK_STATUS(vxQueryImage(image[i], VX_IMAGE_ATTRIBUTE_FORMAT, &format[i], sizeof(format[i])));
+		rect[i].start_x = rect[i].start_y = 0; rect[i].end_x = width[i]; rect[i].end_y = height[i];
+		ERROR_CHECK_STATUS(vxAccessImagePatch(image[i], &rect[i], 0, &addr[i], &ptr[i], usage[i]));
+	}
+	vx_uint32 height1 = numCam ? height[2] / numCam : height[2];
+	const float divfactor = (format[1] == VX_DF_IMAGE_U8) ? 0.0627451f : 0.000490196f;
+	const __m128 scale = _mm_set1_ps(divfactor);
+
+	// output = input * weight (RGBX input) or input (RGB4 input) scaled by divfactor, same as OpenCL kernel
+#pragma omp parallel for
+	for (int t = 0; t < (int)tiles.size(); t++) {
+		const StitchBlendTile& tile = tiles[t];
+		if (tile.dstX >= width[2] || tile.dstY >= height1) continue;
+		vx_uint32 nx = std::min(std::min(((tile.last_x >> 2) + 1) << 2, 64u), width[2] - tile.dstX);
+		vx_uint32 ny = std::min(std::min(tile.last_y + 1, 16u), height1 - tile.dstY);
+		for (vx_uint32 y = 0; y < ny; y++) {
+			vx_uint32 row = tile.camId * height1 + tile.dstY + y;
+			const vx_uint8 * ip = (const vx_uint8 *)ptr[0] + row * addr[0].stride_y;
+			const vx_uint8 * wt = (const vx_uint8 *)ptr[1] + row * addr[1].stride_y;
+			vx_int16 * op = (vx_int16 *)((vx_uint8 *)ptr[2] + row * addr[2].stride_y) + tile.dstX * 3;
+			for (vx_uint32 x = 0; x < nx; x++, op += 3) {
+				vx_uint32 gx = tile.dstX + x;
+				__m128 f;
+				if (format[0] == VX_DF_IMAGE_RGBX) {
+					float w = (format[1] == VX_DF_IMAGE_U8) ? (float)wt[gx] : (float)((const vx_int16 *)wt)[gx];
+					f = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(((const vx_int32 *)ip)[gx])));
+					f = _mm_mul_ps(f, _mm_set1_ps(w));
+				}
+				else {
+					const vx_int16 * p = (const vx_int16 *)ip + gx * 3;
+					f = _mm_setr_ps(p[0], p[1], p[2], 0.0f);
+				}
+				__m128i v = _mm_packs_epi32(_mm_cvtps_epi32(_mm_mul_ps(f, scale)), _mm_setzero_si128());
+				op[0] = (vx_int16)_mm_extract_epi16(v, 0);
+				op[1] = (vx_int16)_mm_extract_epi16(v, 1);
+				op[2] = (vx_int16)_mm_extract_epi16(v, 2);
+			}
+		}
+	}
+
+	for (int i = 0; i < 3; i++) {
+		ERROR_CHECK_STATUS(vxCommitImagePatch(image[i], &rect[i], 0, &addr[i], ptr[i]));
+	}
+	return VX_SUCCESS;
 }
 
 //! \brief The OpenCL global work updater callback.
@@ -364,26 +425,223 @@ vx_status multiband_blend_publish(vx_context context)
 	return VX_SUCCESS;
 }
 
+//////////////////////////////////////////////////////////////////////
+//! \brief Read the blend work list at arr_offs (entry count at arr_offs-1) for CPU kernels.
+vx_status GetBlendWorkList(vx_array arr, vx_uint32 arr_offs, std::vector<StitchBlendTile>& tiles)
+{
+	vx_size itemsize = 0, numitems = 0;
+	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
+	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &numitems, sizeof(numitems)));
+	tiles.clear();
+	if (arr_offs < 1 || arr_offs > numitems)
+		return VX_ERROR_INVALID_PARAMETERS;
+	// get number of entries from the count entry
+	vx_uint8 * ptr = nullptr;
+	vx_size stride = itemsize;
+	ERROR_CHECK_STATUS(vxAccessArrayRange(arr, arr_offs - 1, arr_offs, &stride, (void **)&ptr, VX_READ_ONLY));
+	vx_size count = std::min((vx_size)*((vx_uint32 *)ptr), numitems - arr_offs);
+	ERROR_CHECK_STATUS(vxCommitArrayRange(arr, arr_offs - 1, arr_offs, ptr));
+	if (!count)
+		return VX_SUCCESS;
+	// decode entries
+	ptr = nullptr;
+	stride = itemsize;
+	ERROR_CHECK_STATUS(vxAccessArrayRange(arr, arr_offs, arr_offs + count, &stride, (void **)&ptr, VX_READ_ONLY));
+	tiles.resize(count);
+	for (vx_size i = 0; i < count; i++) {
+		StitchBlendTile& tile = tiles[i];
+		vx_uint32 skip_y;
+		if (itemsize == sizeof(StitchBlendValidWideEntry)) {
+			const StitchBlendValidWideEntry * entry = (const StitchBlendValidWideEntry *)(ptr + i * stride);
+			tile.camId = entry->camId; tile.dstX = entry->dstX; tile.dstY = entry->dstY;
+			tile.last_x = entry->last_x; tile.last_y = entry->last_y; skip_y = entry->skip_y;
+		}
+		else {
+			const StitchBlendValidEntry * entry = (const StitchBlendValidEntry *)(ptr + i * stride);
+			tile.camId = entry->camId; tile.dstX = entry->dstX; tile.dstY = entry->dstY;
+			tile.last_x = entry->last_x; tile.last_y = entry->last_y; skip_y = entry->skip_y;
+		}
+		tile.border = (skip_y >> 6) & 3;
+		tile.copyTile = (skip_y & STITCH_BLEND_COPY_TILE) ? true : false;
+	}
+	ERROR_CHECK_STATUS(vxCommitArrayRange(arr, arr_offs, arr_offs + count, ptr));
+	return VX_SUCCESS;
+}
+
+//! \brief The OpenCL macros to decode StitchBlendValidEntry or StitchBlendValidWideEntry.
+const char * GetBlendValidEntryOpenCLMacros(bool bWideEntry)
+{
+	return bWideEntry ?
+		"#define BLEND_ENTRY uint4\n"
+		"#define BLEND_ENTRY_SHIFT 4\n"
+		"#define BLEND_CAM(e) (e).s0\n"
+		"#define BLEND_X(e) (e).s2\n"
+		"#define BLEND_Y(e) (e).s3\n" :
+		"#define BLEND_ENTRY uint2\n"
+		"#define BLEND_ENTRY_SHIFT 3\n"
+		"#define BLEND_CAM(e) ((e).s0 & 0x1f)\n"
+		"#define BLEND_X(e) (((e).s0 >> 5) & 0x3FFF)\n"
+		"#define BLEND_Y(e) (((e).s0 >> 19) & 0x1FFF)\n";
+}
+
 //////////////////////////////////////////////////////////////////////
 // Calculate buffer sizes and generate data in buffers for blend
 //   CalculateLargestBlendBufferSizes  - useful when reinitialize is enabled
 //   CalculateSmallestBlendBufferSizes - useful when reinitialize is disabled
-//   GenerateBlendBuffers              - generate tables
+//   GenerateBlendBuffers              - generate tables: blendOffsetTableWide is used instead of blendOffsetTable when not NULL
+//   PackBlendBuffers                  - move tables into row packed camera planes from CalculateRowPackedCameraPlanes
+
+//! \brief Mark seam cells (16x16 blocks at level#0) of each camera and compute summed area table of marks.
+//  A seam pixel of a camera is a pixel shared with other cameras or at the edge of its footprint,
+//  i.e., where its blend weight can be other than 0 or 255. Table size: [numCamera * (cellsX + 1) * (cellsY + 1)]
+static void CalculateBlendSeamCells(
+	vx_uint32 numCamera,                    // [in] number of cameras
+	vx_uint32 eqrWidth,                     // [in] output equirectangular image width
+	vx_uint32 eqrHeight,                    // [in] output equirectangular image height
+	const vx_uint64 * pixelCamMap,          // [in] pixel camera index map: size: [eqrWidth * eqrHeight]
+	std::vector<vx_uint32>& seamCellSum     // [out] summed area table of seam cells
+	)
+{
+	vx_uint32 sw = ((eqrWidth + 15) >> 4) + 1, sh = ((eqrHeight + 15) >> 4) + 1;
+	seamCellSum.assign(numCamera * sw * sh, 0);
+	for (vx_uint32 y = 0; y < eqrHeight; y++) {
+		const vx_uint64 * row = &pixelCamMap[y * eqrWidth];
+		for (vx_uint32 x = 0; x < eqrWidth; x++) {
+			vx_uint64 mask = row[x];
+			if (!mask) continue;
+			// cameras present in all 4-neighbors (x wraps around)
+			vx_uint64 inner = mask & row[(x > 0) ? x - 1 : eqrWidth - 1] & row[(x + 1 < eqrWidth) ? x + 1 : 0];
+			if (y > 0) inner &= row[(vx_int32)x - (vx_int32)eqrWidth];
+			if (y + 1 < eqrHeight) inner &= row[x + eqrWidth];
+			vx_uint64 seamMask = (mask & (mask - 1)) ? mask : (mask & ~inner);
+			for (vx_uint32 camId = 0; seamMask; camId++, seamMask >>= 1) {
+				if (seamMask & 1) {
+					seamCellSum[(camId * sh + (y >> 4) + 1) * sw + (x >> 4) + 1] = 1;
+				}
+			}
+		}
+	}
+	for (vx_uint32 camId = 0; camId < numCamera; camId++) {
+		vx_uint32 * sum = &seamCellSum[camId * sw * sh];
+		for (vx_uint32 cy = 1; cy < sh; cy++) {
+			for (vx_uint32 cx = 1; cx < sw; cx++) {
+				sum[cy * sw + cx] += sum[cy * sw + cx - 1] + sum[(cy - 1) * sw + cx] - sum[(cy - 1) * sw + cx - 1];
+			}
+		}
+	}
+}
+
+//! \brief Check if a rectangle at level#0 has any seam cells of a camera: x wraps around.
+static bool HasBlendSeamCells(const vx_uint32 * seamCellSum, vx_int32 eqrWidth, vx_int32 eqrHeight,
+	vx_int32 start_x, vx_int32 start_y, vx_int32 end_x, vx_int32 end_y)
+{
+	vx_int32 sw = ((eqrWidth + 15) >> 4) + 1;
+	vx_int32 cy0 = std::max(0, start_y) >> 4, cy1 = (std::min(eqrHeight, end_y) + 15) >> 4;
+	if (cy0 >= cy1)
+		return false;
+	if (end_x - start_x >= eqrWidth) {
+		start_x = 0; end_x = eqrWidth;
+	}
+	for (vx_int32 wrap = -eqrWidth; wrap <= eqrWidth; wrap += eqrWidth) {
+		vx_int32 cx0 = std::max(0, start_x + wrap) >> 4, cx1 = (std::min(eqrWidth, end_x + wrap) + 15) >> 4;
+		if (cx0 < cx1 && (seamCellSum[cy1 * sw + cx1] - seamCellSum[cy0 * sw + cx1] - seamCellSum[cy1 * sw + cx0] + seamCellSum[cy0 * sw + cx0]) > 0)
+			return true;
+	}
+	return false;
+}
+
+//! \brief Generate work list of a level: just count entries when entry buffers are NULL.
+//  Without seamCellSum, the list covers camera footprints. Otherwise, only tiles within a band around seams are
+//  listed and rest of the footprint is listed as copy tiles at level#0. The band radius grows with level by a tile
+//  plus filter margin so that the reconstruction of a band tile always finds the next level computed.
+static vx_uint32 GenerateBlendLevelEntries(
+	vx_uint32 numCamera,                           // [in] number of cameras
+	vx_uint32 eqrWidth,                            // [in] output equirectangular image width
+	vx_uint32 eqrHeight,                           // [in] output equirectangular image height
+	vx_uint32 numBands,                            // [in] number of bands in multiband blend
+	vx_uint32 level,                               // [in] pyramid level
+	const vx_rectangle_t * const * overlapPadded,  // [in] overlap regions: overlapPadded[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i
+	const vx_uint32 * seamCellSum,                 // [in] summed area table of seam cells from CalculateBlendSeamCells (optional)
+	StitchBlendValidEntry * entryBuf,              // [out] work list (optional)
+	StitchBlendValidWideEntry * entryBufWide       // [out] wide work list (optional)
+	)
+{
+	vx_int32 align = (1 << (numBands - 1)), border = align * 2;
+	vx_int32 levelAlign = (1 << level) - 1;
+	vx_int32 bandRadiusX = border + 68 * levelAlign, bandRadiusY = border + 20 * levelAlign;
+	vx_uint32 seamCellSumSize = (((eqrWidth + 15) >> 4) + 1) * (((eqrHeight + 15) >> 4) + 1);
+	vx_uint32 entryCount = 0;
+	for (vx_uint32 camId = 0; camId < numCamera; camId++) {
+		vx_int32 start_x = overlapPadded[camId][camId].start_x, end_x = overlapPadded[camId][camId].end_x;
+		vx_int32 start_y = overlapPadded[camId][camId].start_y, end_y = overlapPadded[camId][camId].end_y;
+		start_x = (std::max(0, start_x - border) & ~(align - 1)) >> level;
+		start_y = (std::max(0, start_y - border) & ~(align - 1)) >> level;
+		end_x = (std::min((vx_int32)eqrWidth, (end_x + border + align - 1) & ~(align - 1)) + levelAlign) >> level;
+		end_y = (std::min((vx_int32)eqrHeight, (end_y + border + align - 1) & ~(align - 1)) + levelAlign) >> level;
+		for (int y = start_y; y < end_y; y += 16) {
+			for (int x = start_x & ~15; x < end_x; x += 64) {
+				vx_uint32 skip_y = 0;
+				if (seamCellSum && !HasBlendSeamCells(&seamCellSum[camId * seamCellSumSize], eqrWidth, eqrHeight,
+					(x << level) - bandRadiusX, (y << level) - bandRadiusY, ((x + 64) << level) + bandRadiusX, ((y + 16) << level) + bandRadiusY))
+				{
+					// tile is away from seams: only level#0 needs it, to copy the pixels through
+					if (level > 0)
+						continue;
+					skip_y = STITCH_BLEND_COPY_TILE;
+				}
+				vx_uint32 last_x = std::min(64, end_x - x) - 1;
+				vx_uint32 last_y = std::min(16, end_y - y) - 1;
+				vx_uint32 skip_x = (x < start_x) ? (start_x - x) : 0;
+				// check if the workgroup is processing border pixels, store it in high bits of skip_y
+				skip_y |= ((!x) | (((x + 64) << level) >= (vx_int32)eqrWidth)) << 6;
+				skip_y |= ((!y) | (((y + 16) << level) >= (vx_int32)eqrHeight)) << 7;
+				if (entryBufWide) {
+					StitchBlendValidWideEntry * entry = &entryBufWide[entryCount];
+					entry->camId = camId;
+					entry->dstX = x;
+					entry->dstY = y;
+					entry->last_x = last_x;
+					entry->last_y = last_y;
+					entry->skip_x = skip_x;
+					entry->skip_y = skip_y;
+				}
+				else if (entryBuf) {
+					StitchBlendValidEntry * entry = &entryBuf[entryCount];
+					entry->camId = camId;
+					entry->dstX = x;
+					entry->dstY = y;
+					entry->last_x = last_x;
+					entry->last_y = last_y;
+					entry->skip_x = skip_x;
+					entry->skip_y = skip_y;
+				}
+				entryCount++;
+			}
+		}
+	}
+	return entryCount;
+}
 
 vx_uint32 CalculateLargestBlendBufferSizes(
 	vx_uint32 numCamera,                    // [in] number of cameras
 	vx_uint32 eqrWidth,                     // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                    // [in] output equirectangular image height
 	vx_uint32 numBands,						// [in] number of bands in multiband blend
-	vx_size * blendOffsetIntoBuffer,        // [out] individual level offset table: size [numBands]
+	vx_size * blendOffsetIntoBuffer,        // [out] individual level offset table: size [numBands * 2]
 	vx_size * blendOffsetEntryCount         // [out] number of entries needed by blend offset table
 	)
 {
 	vx_uint32 totalCount = 0, levelRound = 0;
 	for (vx_uint32 level = 0; level < numBands; level++) {
-		blendOffsetIntoBuffer[level] = 1 + totalCount;
 		vx_uint32 count = 1 + ((((eqrWidth + levelRound) >> level) + 63) >> 6) * ((((eqrHeight + levelRound) >> level) + 15) >> 4) * numCamera;
+		blendOffsetIntoBuffer[level] = 1 + totalCount;
 		totalCount += count;
+		// level#0 of Gaussian pyramid is the input itself: no separate list needed
+		blendOffsetIntoBuffer[numBands + level] = blendOffsetIntoBuffer[level];
+		if (level > 0) {
+			blendOffsetIntoBuffer[numBands + level] = 1 + totalCount;
+			totalCount += count;
+		}
 		levelRound = (levelRound << 1) | 1;
 	}
 	*blendOffsetEntryCount = totalCount;
@@ -395,34 +653,30 @@ vx_uint32 CalculateSmallestBlendBufferSizes(
 	vx_uint32 eqrWidth,                            // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                           // [in] output equirectangular image height
 	vx_uint32 numBands,						       // [in] number of bands in multiband blend
-	const vx_uint32 * validPixelCamMap,            // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
-	const vx_uint32 * paddedPixelCamMap,           // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,            // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * paddedPixelCamMap,           // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight]
 	const vx_rectangle_t * const * overlapPadded,  // [in] overlap regions: overlapPadded[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i
-	const vx_uint32 * paddedCamOverlapInfo,        // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & (1 << cam_j)": size: [32]
-	vx_size * blendOffsetIntoBuffer,               // [out] individual level offset table: size [numBands]
+	const vx_uint64 * paddedCamOverlapInfo,        // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
+	vx_size * blendOffsetIntoBuffer,               // [out] individual level offset table: size [numBands * 2]
 	vx_size * blendOffsetEntryCount                // [out] number of entries needed by blend offset table
 	)
 {
+	std::vector<vx_uint32> seamCellSum;
+	const vx_uint64 * pixelCamMap = paddedPixelCamMap ? paddedPixelCamMap : validPixelCamMap;
+	if (pixelCamMap) {
+		CalculateBlendSeamCells(numCamera, eqrWidth, eqrHeight, pixelCamMap, seamCellSum);
+	}
 	vx_uint32 totalCount = 0;
-	vx_int32 align = (1 << (numBands - 1)), border = align * 2;
 	for (vx_uint32 level = 0; level < numBands; level++) {
 		blendOffsetIntoBuffer[level] = 1 + totalCount;
-		vx_uint32 entryCount = 0;
-		vx_int32 levelAlign = (1 << level) - 1;
-		for (vx_uint32 camId = 0; camId < numCamera; camId++) {
-			vx_int32 start_x = overlapPadded[camId][camId].start_x, end_x = overlapPadded[camId][camId].end_x;
-			vx_int32 start_y = overlapPadded[camId][camId].start_y, end_y = overlapPadded[camId][camId].end_y;
-			start_x = (std::max(0, start_x - border) & ~(align - 1)) >> level;
-			start_y = (std::max(0, start_y - border) & ~(align - 1)) >> level;
-			end_x = (std::min((vx_int32)eqrWidth, (end_x + border + align - 1) & ~(align - 1)) + levelAlign) >> level;
-			end_y = (std::min((vx_int32)eqrHeight, (end_y + border + align - 1) & ~(align - 1)) + levelAlign) >> level;
-			for (int y = start_y; y < end_y; y += 16) {
-				for (int x = start_x & ~15; x < end_x; x += 64) {
-					entryCount++;
-				}
-			}
+		totalCount += 1 + GenerateBlendLevelEntries(numCamera, eqrWidth, eqrHeight, numBands, level, overlapPadded,
+			seamCellSum.empty() ? nullptr : seamCellSum.data(), nullptr, nullptr);
+		// level#0 of Gaussian pyramid is the input itself: no separate list needed
+		blendOffsetIntoBuffer[numBands + level] = blendOffsetIntoBuffer[level];
+		if (level > 0) {
+			blendOffsetIntoBuffer[numBands + level] = 1 + totalCount;
+			totalCount += 1 + GenerateBlendLevelEntries(numCamera, eqrWidth, eqrHeight, numBands, level, overlapPadded, nullptr, nullptr, nullptr);
 		}
-		totalCount += 1 + entryCount;
 	}
 	*blendOffsetEntryCount = totalCount;
 	return VX_SUCCESS;
@@ -433,44 +687,91 @@ vx_uint32 GenerateBlendBuffers(
 	vx_uint32 eqrWidth,                              // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                             // [in] output equirectangular image height
 	vx_uint32 numBands,						         // [in] number of bands in multiband blend
-	const vx_uint32 * validPixelCamMap,              // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
-	const vx_uint32 * paddedPixelCamMap,             // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,              // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * paddedPixelCamMap,             // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight]
 	const vx_rectangle_t * const * overlapPadded,    // [in] overlap regions: overlapPadded[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i
-	const vx_uint32 * paddedCamOverlapInfo,          // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & (1 << cam_j)": size: [32]
-	const vx_size * blendOffsetIntoBuffer,           // [in] individual level offset table: size [numBands]
+	const vx_uint64 * paddedCamOverlapInfo,          // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
+	const vx_size * blendOffsetIntoBuffer,           // [in] individual level offset table: size [numBands * 2]
 	vx_size blendOffsetTableSize,                    // [in] size of blend offset table
-	StitchBlendValidEntry * blendOffsetTable         // [out] blend offset table
+	StitchBlendValidEntry * blendOffsetTable,        // [out] blend offset table
+	StitchBlendValidWideEntry * blendOffsetTableWide // [out] wide blend offset table (optional)
 	)
 {
-	vx_int32 align = (1 << (numBands - 1)), border = align * 2;
-	for (vx_uint32 level = 0; level < numBands; level++) {
-		StitchBlendValidEntry * entryBuf = &blendOffsetTable[blendOffsetIntoBuffer[level]];
-		vx_uint32 entryCount = 0;
-		vx_int32 levelAlign = (1 << level) - 1;
-		for (vx_uint32 camId = 0; camId < numCamera; camId++) {
-			vx_int32 start_x = overlapPadded[camId][camId].start_x, end_x = overlapPadded[camId][camId].end_x;
-			vx_int32 start_y = overlapPadded[camId][camId].start_y, end_y = overlapPadded[camId][camId].end_y;
-			start_x = (std::max(0, start_x - border) & ~(align - 1)) >> level;
-			start_y = (std::max(0, start_y - border) & ~(align - 1)) >> level;
-			end_x = (std::min((vx_int32)eqrWidth, (end_x + border + align - 1) & ~(align - 1)) + levelAlign) >> level;
-			end_y = (std::min((vx_int32)eqrHeight, (end_y + border + align - 1) & ~(align - 1)) + levelAlign) >> level;
-			for (int y = start_y; y < end_y; y += 16) {
-				for (int x = start_x & ~15; x < end_x; x += 64) {
-					StitchBlendValidEntry * entry = &entryBuf[entryCount++];
-					entry->camId = camId;
-					entry->dstX = x;
-					entry->dstY = y;
-					entry->last_x = std::min(64, end_x - x) - 1;
-					entry->last_y = std::min(16, end_y - y) - 1;
-					entry->skip_x = (x < start_x) ? (start_x - x) : 0;
-					entry->skip_y = 0;
-					// check if the workgroup is processing border pixels, store it in high bits of skip_y
-					entry->skip_y |= ((!x) | (((x + 64) << level) >= (vx_int32)eqrWidth)) << 6;
-					entry->skip_y |= ((!y) | (((y + 16) << level) >= (vx_int32)eqrHeight)) << 7;
-				}
+	std::vector<vx_uint32> seamCellSum;
+	const vx_uint64 * pixelCamMap = paddedPixelCamMap ? paddedPixelCamMap : validPixelCamMap;
+	if (pixelCamMap) {
+		CalculateBlendSeamCells(numCamera, eqrWidth, eqrHeight, pixelCamMap, seamCellSum);
+	}
+	for (vx_uint32 list = 0; list < numBands * 2; list++) {
+		// lists [0..numBands-1] are seam band lists and [numBands+1..] are camera footprint lists
+		if (list == numBands)
+			continue;
+		vx_uint32 level = list % numBands;
+		const vx_uint32 * seamCells = (list < numBands && !seamCellSum.empty()) ? seamCellSum.data() : nullptr;
+		StitchBlendValidEntry * entryBuf = blendOffsetTableWide ? nullptr : &blendOffsetTable[blendOffsetIntoBuffer[list]];
+		StitchBlendValidWideEntry * entryBufWide = blendOffsetTableWide ? &blendOffsetTableWide[blendOffsetIntoBuffer[list]] : nullptr;
+		vx_uint32 entryCount = GenerateBlendLevelEntries(numCamera, eqrWidth, eqrHeight, numBands, level, overlapPadded, seamCells, entryBuf, entryBufWide);
+		// first entry of each list holds the number of entries in the list
+		if (entryBufWide)
+			*((vx_uint64 *)&entryBufWide[-1]) = entryCount;
+		else
+			*((vx_uint64 *)&entryBuf[-1]) = entryCount;
+	}
+
+	return VX_SUCCESS;
+}
+
+vx_status PackBlendBuffers(
+	vx_uint32 numCamera,                             // [in] number of cameras
+	vx_uint32 numBands,						         // [in] number of bands in multiband blend
+	const StitchCameraPlaneEntry * cameraPlane,      // [in] row packed camera planes: size: [numCamera]
+	const vx_size * blendOffsetIntoBuffer,           // [in] individual level offset table: size [numBands * 2]
+	StitchBlendValidEntry * blendOffsetTable,        // [in/out] blend offset table
+	StitchBlendValidWideEntry * blendOffsetTableWide // [in/out] wide blend offset table (optional)
+	)
+{
+	// camera planes have same height and start at rows aligned to the coarsest level, so that tiles of each level
+	// move up by (first row of camera plane >> level) and the y border is at the top and bottom of camera planes
+	vx_uint32 align = 1 << (numBands - 1);
+	vx_int32 planeHeight = (vx_int32)cameraPlane[0].height;
+	std::vector<vx_int32> startY(numCamera);
+	for (vx_uint32 camId = 0; camId < numCamera; camId++) {
+		startY[camId] = (vx_int32)camId * planeHeight - cameraPlane[camId].offsetY;
+		if (cameraPlane[camId].offsetX != 0 || (vx_int32)cameraPlane[camId].height != planeHeight || startY[camId] < 0 || (startY[camId] & (align - 1)))
+			return VX_ERROR_INVALID_PARAMETERS;
+	}
+	for (vx_uint32 list = 0; list < numBands * 2; list++) {
+		// level#0 footprint list is same as level#0 seam band list
+		if (list == numBands)
+			continue;
+		vx_uint32 level = list % numBands;
+		vx_uint64 entryCount = blendOffsetTableWide ? *((vx_uint64 *)&blendOffsetTableWide[blendOffsetIntoBuffer[list] - 1])
+			: *((vx_uint64 *)&blendOffsetTable[blendOffsetIntoBuffer[list] - 1]);
+		for (vx_uint64 i = 0; i < entryCount; i++) {
+			vx_uint32 camId = 0, dstY = 0, skip_y = 0;
+			if (blendOffsetTableWide) {
+				const StitchBlendValidWideEntry& entry = blendOffsetTableWide[blendOffsetIntoBuffer[list] + i];
+				camId = entry.camId; dstY = entry.dstY; skip_y = entry.skip_y;
+			}
+			else {
+				const StitchBlendValidEntry& entry = blendOffsetTable[blendOffsetIntoBuffer[list] + i];
+				camId = entry.camId; dstY = entry.dstY; skip_y = entry.skip_y;
+			}
+			if (camId >= numCamera)
+				return VX_ERROR_INVALID_PARAMETERS;
+			vx_int32 y = (vx_int32)dstY - (startY[camId] >> level);
+			if (y < 0 || ((y + 1) << level) > planeHeight)
+				return VX_ERROR_INVALID_PARAMETERS;
+			skip_y = (skip_y & ~0x80) | (((!y) | (((y + 16) << level) >= planeHeight)) << 7);
+			if (blendOffsetTableWide) {
+				blendOffsetTableWide[blendOffsetIntoBuffer[list] + i].dstY = (vx_uint32)y;
+				blendOffsetTableWide[blendOffsetIntoBuffer[list] + i].skip_y = skip_y;
+			}
+			else {
+				blendOffsetTable[blendOffsetIntoBuffer[list] + i].dstY = (vx_uint32)y;
+				blendOffsetTable[blendOffsetIntoBuffer[list] + i].skip_y = skip_y;
 			}
 		}
-		*((vx_uint64 *)&entryBuf[-1]) = entryCount;
 	}
 
 	return VX_SUCCESS;
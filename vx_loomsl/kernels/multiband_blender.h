@@ -25,6 +25,7 @@ THE SOFTWARE.
 #define __MULTIBAND_BLENDER_H__
 
 #include "kernels.h"
+#include "warp.h"
 
 /*********************************************************************
 Multiband blend Data Structures
@@ -40,7 +41,8 @@ typedef struct{
 	vx_node BlendNode;
 	vx_node UpscaleAddNode;
 	vx_node LaplacianReconNode;
-	vx_uint32 valid_array_offset;		// in number of elements
+	vx_uint32 valid_array_offset;		// in number of elements: seam band work list
+	vx_uint32 gaussian_array_offset;	// in number of elements: camera footprint work list for Gaussian pyramid
 }StitchMultibandData;
 
 typedef struct {
@@ -53,6 +55,43 @@ typedef struct {
 	vx_uint32 skip_y  :  8; // starting pixel y-coordinate within the 64x16 block
 } StitchBlendValidEntry;
 
+//! \brief The wide blend valid entry: used instead of StitchBlendValidEntry with wide tables.
+//  Second word has same layout as StitchBlendValidEntry.
+typedef struct {
+	vx_uint32 camId;        // destination buffer/camera ID
+	vx_uint32 last_x  :  8; // ending pixel x-coordinate within the 64x16 block
+	vx_uint32 last_y  :  8; // ending pixel y-coordinate within the 64x16 block
+	vx_uint32 skip_x  :  8; // starting pixel x-coordinate within the 64x16 block
+	vx_uint32 skip_y  :  8; // starting pixel y-coordinate within the 64x16 block
+	vx_uint32 dstX;         // destination pixel x-coordinate (integer)
+	vx_uint32 dstY;         // destination pixel y-coordinate (integer)
+} StitchBlendValidWideEntry;
+
+//! \brief The skip_y flag of level#0 blend entries for tiles away from seams:
+//  such tiles are copied through without Laplacian pyramid processing.
+#define STITCH_BLEND_COPY_TILE              0x20
+
+//! \brief The limits of compact blend valid entries
+#define STITCH_BLEND_COMPACT_MAX_DST_WIDTH   16384 // StitchBlendValidEntry::dstX has 14 bits
+#define STITCH_BLEND_COMPACT_MAX_DST_HEIGHT   8192 // StitchBlendValidEntry::dstY has 13 bits
+
+//! \brief The decoded blend valid entry used by CPU kernels
+typedef struct {
+	vx_uint32 camId;            // destination buffer/camera ID
+	vx_uint32 dstX, dstY;       // destination pixel coordinates of the 64x16 block
+	vx_uint32 last_x, last_y;   // ending pixel coordinates within the 64x16 block
+	vx_uint32 border;           // bit#0: x border, bit#1: y border
+	bool copyTile;              // level#0 tile marked with STITCH_BLEND_COPY_TILE
+} StitchBlendTile;
+
+//! \brief Read the blend work list at arr_offs (entry count at arr_offs-1) for CPU kernels:
+//  handles both StitchBlendValidEntry and StitchBlendValidWideEntry arrays.
+vx_status GetBlendWorkList(vx_array arr, vx_uint32 arr_offs, std::vector<StitchBlendTile>& tiles);
+
+//! \brief The OpenCL macros to decode StitchBlendValidEntry or StitchBlendValidWideEntry:
+//  BLEND_ENTRY (type), BLEND_ENTRY_SHIFT (log2 of size), BLEND_CAM(e), BLEND_X(e), BLEND_Y(e); e.s1 is same for both.
+const char * GetBlendValidEntryOpenCLMacros(bool bWideEntry);
+
 //////////////////////////////////////////////////////////////////////
 //! \brief The kernel registration functions.
 vx_status multiband_blend_publish(vx_context context);
@@ -61,14 +100,20 @@ vx_status multiband_blend_publish(vx_context context);
 // Calculate buffer sizes and generate data in buffers for blend
 //   CalculateLargestBlendBufferSizes  - useful when reinitialize is enabled
 //   CalculateSmallestBlendBufferSizes - useful when reinitialize is disabled
-//   GenerateBlendBuffers              - generate tables
+//   GenerateBlendBuffers              - generate tables: blendOffsetTableWide is used instead of blendOffsetTable when not NULL
+//   PackBlendBuffers                  - move tables into row packed camera planes from CalculateRowPackedCameraPlanes
+// The blend offset table has two work lists per level:
+//   blendOffsetIntoBuffer[level]            - tiles within a band of ~2^numBands pixels around seams, used by
+//                                             Laplacian, blend and reconstruct kernels; level#0 also has copy tiles
+//                                             for rest of the camera footprint (marked with STITCH_BLEND_COPY_TILE)
+//   blendOffsetIntoBuffer[numBands + level] - tiles covering the camera footprint, used by Gaussian pyramid kernels
 
 vx_uint32 CalculateLargestBlendBufferSizes(
 	vx_uint32 numCamera,                    // [in] number of cameras
 	vx_uint32 eqrWidth,                     // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                    // [in] output equirectangular image height
 	vx_uint32 numBands,						// [in] number of bands in multiband blend
-	vx_size * blendOffsetIntoBuffer,        // [out] individual level offset table: size [numBands]
+	vx_size * blendOffsetIntoBuffer,        // [out] individual level offset table: size [numBands * 2]
 	vx_size * blendOffsetEntryCount         // [out] number of entries needed by blend offset table
 	);
 
@@ -77,11 +122,11 @@ vx_uint32 CalculateSmallestBlendBufferSizes(
 	vx_uint32 eqrWidth,                            // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                           // [in] output equirectangular image height
 	vx_uint32 numBands,						       // [in] number of bands in multiband blend
-	const vx_uint32 * validPixelCamMap,            // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
-	const vx_uint32 * paddedPixelCamMap,           // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,            // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * paddedPixelCamMap,           // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight]
 	const vx_rectangle_t * const * overlapPadded,  // [in] overlap regions: overlapPadded[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i
-	const vx_uint32 * paddedCamOverlapInfo,        // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & (1 << cam_j)": size: [32]
-	vx_size * blendOffsetIntoBuffer,               // [out] individual level offset table: size [numBands]
+	const vx_uint64 * paddedCamOverlapInfo,        // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
+	vx_size * blendOffsetIntoBuffer,               // [out] individual level offset table: size [numBands * 2]
 	vx_size * blendOffsetEntryCount                // [out] number of entries needed by blend offset table
 	);
 
@@ -90,13 +135,23 @@ vx_uint32 GenerateBlendBuffers(
 	vx_uint32 eqrWidth,                              // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                             // [in] output equirectangular image height
 	vx_uint32 numBands,						         // [in] number of bands in multiband blend
-	const vx_uint32 * validPixelCamMap,              // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
-	const vx_uint32 * paddedPixelCamMap,             // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,              // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * paddedPixelCamMap,             // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight]
 	const vx_rectangle_t * const * overlapPadded,    // [in] overlap regions: overlapPadded[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i
-	const vx_uint32 * paddedCamOverlapInfo,          // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & (1 << cam_j)": size: [32]
-	const vx_size * blendOffsetIntoBuffer,           // [in] individual level offset table: size [numBands]
+	const vx_uint64 * paddedCamOverlapInfo,          // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
+	const vx_size * blendOffsetIntoBuffer,           // [in] individual level offset table: size [numBands * 2]
 	vx_size blendOffsetTableSize,                    // [in] size of blend offset table
-	StitchBlendValidEntry * blendOffsetTable         // [out] blend offset table
+	StitchBlendValidEntry * blendOffsetTable,        // [out] blend offset table
+	StitchBlendValidWideEntry * blendOffsetTableWide // [out] wide blend offset table (optional)
+	);
+
+vx_status PackBlendBuffers(
+	vx_uint32 numCamera,                             // [in] number of cameras
+	vx_uint32 numBands,						         // [in] number of bands in multiband blend
+	const StitchCameraPlaneEntry * cameraPlane,      // [in] row packed camera planes: size: [numCamera]
+	const vx_size * blendOffsetIntoBuffer,           // [in] individual level offset table: size [numBands * 2]
+	StitchBlendValidEntry * blendOffsetTable,        // [in/out] blend offset table
+	StitchBlendValidWideEntry * blendOffsetTableWide // [in/out] wide blend offset table (optional)
 	);
 
 #endif //__MULTIBAND_BLENDER_H__
@@ -137,7 +137,7 @@ static vx_status VX_CALLBACK noise_filter_query_target_support(vx_graph graph, v
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = StitchIsHostExecution(graph) ? AGO_TARGET_AFFINITY_CPU : AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -217,7 +217,38 @@ static vx_status VX_CALLBACK noise_filter_opencl_codegen(
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK noise_filter_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_SUPPORTED;
+	// get lambda and access images: output = lambda * input0 + (1 - lambda) * input1 per byte of RGB pixels
+	vx_float32 lambda = 0.0f;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &lambda));
+	vx_float32 oneMinusLambda = 1.0f - lambda;
+	vx_image image0 = (vx_image)parameters[1], image1 = (vx_image)parameters[2], image_out = (vx_image)parameters[3];
+	vx_uint32 width = 0, height = 0;
+	ERROR_CHECK_STATUS(vxQueryImage(image_out, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage(image_out, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	vx_rectangle_t rect0, rect1, rect_out;
+	rect0.start_x = rect0.start_y = 0; rect0.end_x = width; rect0.end_y = height;
+	rect1 = rect_out = rect0;
+	vx_imagepatch_addressing_t addr0, addr1, addr_out;
+	void * ptr0 = nullptr, * ptr1 = nullptr, * ptr_out = nullptr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(image0, &rect0, 0, &addr0, &ptr0, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(image1, &rect1, 0, &addr1, &ptr1, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(image_out, &rect_out, 0, &addr_out, &ptr_out, VX_WRITE_ONLY));
+
+#pragma omp parallel for
+	for (int y = 0; y < (int)height; y++) {
+		const vx_uint8 * src0 = (const vx_uint8 *)ptr0 + y * addr0.stride_y;
+		const vx_uint8 * src1 = (const vx_uint8 *)ptr1 + y * addr1.stride_y;
+		vx_uint8 * dst = (vx_uint8 *)ptr_out + y * addr_out.stride_y;
+		for (vx_uint32 x = 0; x < width * 3; x++) {
+			long v = lrintf(src0[x] * lambda + src1[x] * oneMinusLambda);
+			dst[x] = (vx_uint8)std::min(std::max(v, 0L), 255L);
+		}
+	}
+
+	ERROR_CHECK_STATUS(vxCommitImagePatch(image_out, &rect_out, 0, &addr_out, ptr_out));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(image1, &rect1, 0, &addr1, ptr1));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(image0, &rect0, 0, &addr0, ptr0));
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel publisher.
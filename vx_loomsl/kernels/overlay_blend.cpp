@@ -0,0 +1,347 @@
+/*
+Copyright (c) 2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "overlay_blend.h"
+
+//! \brief The input validator callback.
+static vx_status VX_CALLBACK overlay_blend_input_validator(vx_node node, vx_uint32 index)
+{
+	vx_status status = VX_ERROR_INVALID_PARAMETERS;
+	// get reference for parameter at specified index
+	vx_reference ref = avxGetNodeParamRef(node, index);
+	ERROR_CHECK_OBJECT(ref);
+	// validate each parameter
+	if (index == 0)
+	{ // array object of StitchValidPixelEntry type
+		vx_size itemsize = 0;
+		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
+		ERROR_CHECK_STATUS(vxReleaseArray((vx_array *)&ref));
+		if (itemsize == sizeof(StitchValidPixelEntry) || itemsize == sizeof(StitchValidPixelWideEntry)) {
+			status = VX_SUCCESS;
+		}
+		else {
+			status = VX_ERROR_INVALID_DIMENSION;
+			vxAddLogEntry((vx_reference)node, status, "ERROR: overlay_blend array element (StitchValidPixelEntry) size should be 4 bytes (or 8 bytes for StitchValidPixelWideEntry)\n");
+		}
+	}
+	else if (index == 1)
+	{ // array object of StitchWarpRemapEntry type
+		vx_size itemsize = 0;
+		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
+		ERROR_CHECK_STATUS(vxReleaseArray((vx_array *)&ref));
+		if (itemsize == sizeof(StitchWarpRemapEntry)) {
+			status = VX_SUCCESS;
+		}
+		else {
+			status = VX_ERROR_INVALID_DIMENSION;
+			vxAddLogEntry((vx_reference)node, status, "ERROR: overlay_blend array element (StitchWarpRemapEntry) size should be 32 bytes\n");
+		}
+	}
+	else if (index == 2)
+	{ // overlay image of format RGBX
+		vx_df_image format = VX_DF_IMAGE_VIRT;
+		ERROR_CHECK_STATUS(vxQueryImage((vx_image)ref, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format)));
+		ERROR_CHECK_STATUS(vxReleaseImage((vx_image *)&ref));
+		if (format == VX_DF_IMAGE_RGBX) {
+			status = VX_SUCCESS;
+		}
+		else {
+			status = VX_ERROR_INVALID_TYPE;
+			vxAddLogEntry((vx_reference)node, status, "ERROR: overlay_blend doesn't support overlay image format: %4.4s\n", &format);
+		}
+	}
+	else if (index == 3)
+	{ // output image of format RGB: overlays are blended in place
+		vx_df_image format = VX_DF_IMAGE_VIRT;
+		ERROR_CHECK_STATUS(vxQueryImage((vx_image)ref, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format)));
+		ERROR_CHECK_STATUS(vxReleaseImage((vx_image *)&ref));
+		if (format == VX_DF_IMAGE_RGB) {
+			status = VX_SUCCESS;
+		}
+		else {
+			status = VX_ERROR_INVALID_TYPE;
+			vxAddLogEntry((vx_reference)node, status, "ERROR: overlay_blend doesn't support output image format: %4.4s\n", &format);
+		}
+	}
+	return status;
+}
+
+//! \brief The output validator callback.
+static vx_status VX_CALLBACK overlay_blend_output_validator(vx_node node, vx_uint32 index, vx_meta_format meta)
+{
+	return VX_ERROR_INVALID_PARAMETERS;
+}
+
+//! \brief The kernel target support callback.
+static vx_status VX_CALLBACK overlay_blend_query_target_support(vx_graph graph, vx_node node,
+	vx_bool use_opencl_1_2,              // [input]  false: OpenCL driver is 2.0+; true: OpenCL driver is 1.2
+	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
+	)
+{
+	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	return VX_SUCCESS;
+}
+
+//! \brief The OpenCL global work updater callback.
+static vx_status VX_CALLBACK overlay_blend_opencl_global_work_update(
+	vx_node node,                                  // [input] node
+	const vx_reference parameters[],               // [input] parameters
+	vx_uint32 num,                                 // [input] number of parameters
+	vx_uint32 opencl_work_dim,                     // [input] work_dim for clEnqueueNDRangeKernel()
+	vx_size opencl_global_work[],                  // [output] global_work[] for clEnqueueNDRangeKernel()
+	const vx_size opencl_local_work[]              // [input] local_work[] for clEnqueueNDRangeKernel()
+	)
+{
+	// one work item per overlay table entry
+	vx_size arr_numitems = 0;
+	vx_array arr = (vx_array)avxGetNodeParamRef(node, 0);				// valid pixel array
+	ERROR_CHECK_OBJECT(arr);
+	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &arr_numitems, sizeof(arr_numitems)));
+	ERROR_CHECK_STATUS(vxReleaseArray(&arr));
+
+	opencl_global_work[0] = (arr_numitems + opencl_local_work[0] - 1) & ~(opencl_local_work[0] - 1);
+
+	return VX_SUCCESS;
+}
+
+//! \brief The OpenCL code generator callback.
+static vx_status VX_CALLBACK overlay_blend_opencl_codegen(
+	vx_node node,                                  // [input] node
+	const vx_reference parameters[],               // [input] parameters
+	vx_uint32 num,                                 // [input] number of parameters
+	bool opencl_load_function,                     // [input]  false: normal OpenCL kernel; true: reserved
+	char opencl_kernel_function_name[64],          // [output] kernel_name for clCreateKernel()
+	std::string& opencl_kernel_code,               // [output] string for clCreateProgramWithSource()
+	std::string& opencl_build_options,             // [output] options for clBuildProgram()
+	vx_uint32& opencl_work_dim,                    // [output] work_dim for clEnqueueNDRangeKernel()
+	vx_size opencl_global_work[],                  // [output] global_work[] for clEnqueueNDRangeKernel()
+	vx_size opencl_local_work[],                   // [output] local_work[] for clEnqueueNDRangeKernel()
+	vx_uint32& opencl_local_buffer_usage_mask,     // [output] reserved: must be ZERO
+	vx_uint32& opencl_local_buffer_size_in_bytes   // [output] reserved: must be ZERO
+	)
+{
+	// get configuration of tables
+	vx_size arr_capacity = 0, valid_pix_itemsize = 0;
+	vx_array arr = (vx_array)avxGetNodeParamRef(node, 0);				// valid pixel array
+	ERROR_CHECK_OBJECT(arr);
+	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_CAPACITY, &arr_capacity, sizeof(arr_capacity)));
+	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &valid_pix_itemsize, sizeof(valid_pix_itemsize)));
+	ERROR_CHECK_STATUS(vxReleaseArray(&arr));
+	bool bWideValidPixel = (valid_pix_itemsize == sizeof(StitchValidPixelWideEntry));
+
+	// set kernel configuration
+	strcpy(opencl_kernel_function_name, "overlay_blend");
+	opencl_work_dim = 1;
+	opencl_local_work[0] = 64;
+	opencl_global_work[0] = (arr_capacity + opencl_local_work[0] - 1) & ~(opencl_local_work[0] - 1);
+
+	// Setting variables required by the interface
+	opencl_local_buffer_usage_mask = 0;
+	opencl_local_buffer_size_in_bytes = 0;
+
+	// valid pixel table access: wide entries come with Q14.2 warp remap entries
+	vx_uint32 warp_remap_qf = bWideValidPixel ? 2 : 3;
+	const char * valid_pix_load = bWideValidPixel ?
+		"    uint2 pixelEntry = *(__global uint2 *) (valid_pix_buf + valid_pix_buf_offset + (gid << 3));\n"
+		"    if (pixelEntry.s0 == 0xffffffff) return;\n"
+		"    uint op_x = pixelEntry.s1 & 0xffff, op_y = pixelEntry.s1 >> 16;\n" :
+		"    uint pixelEntry = *(__global uint *) (valid_pix_buf + valid_pix_buf_offset + (gid << 2));\n"
+		"    if (pixelEntry == 0xffffffff) return;\n"
+		"    uint op_x = (pixelEntry >> 8) & 0x7ff, op_y = (pixelEntry >> 19) & 0x1fff;\n";
+
+	// each work item blends 8 consecutive output pixels of an entry: pixels without overlay are left unchanged
+	char item[8192];
+	sprintf(item,
+		"__kernel __attribute__((reqd_work_group_size(%d, 1, 1)))\n" // opencl_local_work[0]
+		"void %s(__global char * valid_pix_buf, uint valid_pix_buf_offset, uint valid_pix_num_items,\n" // opencl_kernel_function_name
+		"        __global char * warp_remap_buf, uint warp_remap_buf_offset, uint warp_remap_num_items,\n"
+		"        uint ip_width, uint ip_height, __global uchar * ip_buf, uint ip_stride, uint ip_offset,\n"
+		"        uint op_width, uint op_height, __global uchar * op_buf, uint op_stride, uint op_offset)\n"
+		"{\n"
+		"  int gid = get_global_id(0);\n"
+		"  if (gid < valid_pix_num_items) {\n"
+		"%s" // valid_pix_load
+		"    uint QF = %d;\n" // warp_remap_qf
+		"    uint QFB = (1 << QF) - 1; float QFM = 1.0f / (1 << QF);\n"
+		"    uint8 map = *(__global uint8 *) (warp_remap_buf + warp_remap_buf_offset + (gid << 5));\n"
+		"    uint sxy[8] = { map.s0, map.s1, map.s2, map.s3, map.s4, map.s5, map.s6, map.s7 };\n"
+		"    __global uchar * op = op_buf + op_offset + op_y * op_stride + op_x * 24;\n"
+		"    ip_buf += ip_offset;\n"
+		"    for (uint i = 0; i < 8; i++) {\n"
+		"      uint sx = sxy[i] & 0xffff, sy = sxy[i] >> 16;\n"
+		"      if (sx == 0xffff && sy == 0xffff) continue;\n"
+		"      uint x0 = sx >> QF, y0 = sy >> QF;\n"
+		"      uint x1 = min(x0 + 1, ip_width - 1), y1 = min(y0 + 1, ip_height - 1);\n"
+		"      float fx = (sx & QFB) * QFM, fy = (sy & QFB) * QFM;\n"
+		"      __global uchar * ip0 = ip_buf + y0 * ip_stride, * ip1 = ip_buf + y1 * ip_stride;\n"
+		"      float4 p0 = mix(convert_float4(as_uchar4(*(__global uint *) (ip0 + (x0 << 2)))), convert_float4(as_uchar4(*(__global uint *) (ip0 + (x1 << 2)))), fx);\n"
+		"      float4 p1 = mix(convert_float4(as_uchar4(*(__global uint *) (ip1 + (x0 << 2)))), convert_float4(as_uchar4(*(__global uint *) (ip1 + (x1 << 2)))), fx);\n"
+		"      float4 f = mix(p0, p1, fy);\n"
+		"      float alpha = f.s3 * 0.0039215686274509803921568627451f;\n"
+		"      float3 o = convert_float3(vload3(i, op));\n"
+		"      vstore3(convert_uchar3_sat_rte(mad(f.s012 - o, (float3)alpha, o)), i, op);\n"
+		"    }\n"
+		"  }\n"
+		"}\n"
+		, (int)opencl_local_work[0], opencl_kernel_function_name, valid_pix_load, warp_remap_qf);
+	opencl_kernel_code = item;
+
+	return VX_SUCCESS;
+}
+
+//! \brief The kernel execution.
+static vx_status VX_CALLBACK overlay_blend_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
+{
+	return VX_ERROR_NOT_SUPPORTED;
+}
+
+//! \brief The kernel publisher.
+vx_status overlay_blend_publish(vx_context context)
+{
+	// add kernel to the context with callbacks
+	vx_kernel kernel = vxAddKernel(context, "com.amd.loomsl.overlay_blend",
+		AMDOVX_KERNEL_STITCHING_OVERLAY_BLEND,
+		overlay_blend_kernel,
+		4,
+		overlay_blend_input_validator,
+		overlay_blend_output_validator,
+		nullptr,
+		nullptr);
+	ERROR_CHECK_OBJECT(kernel);
+	amd_kernel_query_target_support_f query_target_support_f = overlay_blend_query_target_support;
+	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = overlay_blend_opencl_codegen;
+	amd_kernel_opencl_global_work_update_callback_f opencl_global_work_update_callback_f = overlay_blend_opencl_global_work_update;
+	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
+	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
+	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_GLOBAL_WORK_UPDATE_CALLBACK, &opencl_global_work_update_callback_f, sizeof(opencl_global_work_update_callback_f)));
+
+	// set kernel parameters
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 1, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 2, VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 3, VX_BIDIRECTIONAL, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
+
+	// finalize and release kernel object
+	ERROR_CHECK_STATUS(vxFinalizeKernel(kernel));
+	ERROR_CHECK_STATUS(vxReleaseKernel(&kernel));
+
+	return VX_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Calculate buffer sizes and generate data in buffers for overlay blend
+
+vx_status CalculateOverlayBufferSize(
+	vx_uint32 numOverlay,                        // [in] number of overlays
+	vx_uint32 eqrWidth,                          // [in] output equirectangular image width
+	vx_uint32 eqrHeight,                         // [in] output equirectangular image height
+	const vx_uint8 * overlayIndexBuf,            // [in] overlay index map: size: [eqrWidth * eqrHeight]
+	vx_size * mapTableSize                       // [out] size of overlay valid/warp table, in terms of number of entries
+	)
+{
+	vx_size entryCount = 0;
+	for (vx_uint32 y = 0; y < eqrHeight; y++) {
+		const vx_uint8 * index = overlayIndexBuf + (vx_size)y * eqrWidth;
+		for (vx_uint32 x = 0; x < eqrWidth; x += 8) {
+			for (vx_uint32 i = 0; i < 8; i++) {
+				if (index[x + i] < numOverlay) {
+					entryCount++;
+					break;
+				}
+			}
+		}
+	}
+	*mapTableSize = entryCount;
+	return VX_SUCCESS;
+}
+
+vx_status GenerateOverlayBuffers(
+	vx_uint32 numOverlay,                        // [in] number of overlays
+	vx_uint32 eqrWidth,                          // [in] output equirectangular image width
+	vx_uint32 eqrHeight,                         // [in] output equirectangular image height
+	const vx_uint8 * overlayIndexBuf,            // [in] overlay index map: size: [eqrWidth * eqrHeight]
+	const StitchCoord2dFloat * overlaySrcMap,    // [in] overlay coordinate mapping: size: [numOverlay * eqrWidth * eqrHeight]
+	vx_uint32 numOverlayColumns,                 // [in] number of overlay columns
+	vx_uint32 overlayWidth,                      // [in] overlay image width
+	vx_uint32 overlayHeight,                     // [in] overlay image height
+	vx_size   mapTableSize,                      // [in] size of overlay valid/warp table, in terms of number of entries
+	StitchValidPixelEntry * validMap,            // [out] valid map table (NULL when validMapWide is used)
+	StitchValidPixelWideEntry * validMapWide,    // [out] wide valid map table (NULL when validMap is used)
+	StitchWarpRemapEntry * warpMap,              // [out] warp map table
+	vx_size * mapEntryCount                      // [out] number of entries added to overlay valid/warp table
+	)
+{
+	// source coordinates are in the whole overlay buffer: Q13.3 or Q14.2 with wide valid pixel entries
+	vx_uint32 numOverlayRows = (numOverlay + numOverlayColumns - 1) / numOverlayColumns;
+	vx_float32 qfScale = validMapWide ? 4.0f : 8.0f;
+	vx_uint32 srcLimit = validMapWide ? STITCH_WARP_WIDE_MAX_SRC_SIZE : STITCH_WARP_COMPACT_MAX_SRC_SIZE;
+	if (overlayWidth * numOverlayColumns > srcLimit || overlayHeight * numOverlayRows > srcLimit)
+		return VX_ERROR_NOT_SUPPORTED;
+	vx_size pixelsPerEqrImage = (vx_size)eqrWidth * eqrHeight;
+	vx_size entryCount = 0;
+	for (vx_uint32 y = 0; y < eqrHeight; y++) {
+		for (vx_uint32 x = 0; x < eqrWidth; x += 8) {
+			vx_size pos = (vx_size)y * eqrWidth + x;
+			vx_uint32 firstOverlay = numOverlay;
+			vx_uint16 src[16];
+			for (vx_uint32 i = 0; i < 8; i++) {
+				vx_uint32 overlayId = overlayIndexBuf[pos + i];
+				src[2 * i + 0] = src[2 * i + 1] = 0xffff;
+				if (overlayId < numOverlay) {
+					const StitchCoord2dFloat * mapEntry = &overlaySrcMap[pos + i + overlayId * pixelsPerEqrImage];
+					vx_float32 xs = std::min(std::max(mapEntry->x, 0.0f), (vx_float32)(overlayWidth - 1));
+					vx_float32 ys = std::min(std::max(mapEntry->y, 0.0f), (vx_float32)(overlayHeight - 1));
+					xs += (vx_float32)((overlayId % numOverlayColumns) * overlayWidth);
+					ys += (vx_float32)((overlayId / numOverlayColumns) * overlayHeight);
+					src[2 * i + 0] = (vx_uint16)(xs * qfScale + 0.5f);
+					src[2 * i + 1] = (vx_uint16)(ys * qfScale + 0.5f);
+					if (firstOverlay == numOverlay)
+						firstOverlay = overlayId;
+				}
+			}
+			if (firstOverlay == numOverlay)
+				continue;
+			if (entryCount >= mapTableSize)
+				return VX_ERROR_NOT_SUFFICIENT;
+			if (validMapWide) {
+				StitchValidPixelWideEntry entry = { 0 };
+				entry.camId = firstOverlay;
+				entry.dstX = x >> 3;
+				entry.dstY = y;
+				validMapWide[entryCount] = entry;
+			}
+			else {
+				StitchValidPixelEntry entry = { 0 };
+				entry.camId = firstOverlay;
+				entry.dstX = x >> 3;
+				entry.dstY = y;
+				validMap[entryCount] = entry;
+			}
+			memcpy(&warpMap[entryCount], src, sizeof(StitchWarpRemapEntry));
+			entryCount++;
+		}
+	}
+	*mapEntryCount = entryCount;
+	return VX_SUCCESS;
+}
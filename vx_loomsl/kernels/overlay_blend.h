@@ -0,0 +1,66 @@
+/*
+Copyright (c) 2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#ifndef __OVERLAY_BLEND_H__
+#define __OVERLAY_BLEND_H__
+
+#include "kernels.h"
+#include "warp.h"
+#include "lens_distortion_remap.h"
+
+//////////////////////////////////////////////////////////////////////
+//! \brief The kernel registration functions.
+vx_status overlay_blend_publish(vx_context context);
+
+//////////////////////////////////////////////////////////////////////
+// Calculate buffer sizes and generate data in buffers for overlay blend
+//   CalculateOverlayBufferSize - number of entries in overlay valid/warp tables: one per group of 8 output pixels with an overlay
+//   GenerateOverlayBuffers     - generate overlay valid/warp tables with source locations in the overlay buffer:
+//                                StitchValidPixelEntry/StitchValidPixelWideEntry with camId as the first overlay of the group,
+//                                StitchWarpRemapEntry in Q13.3 format (Q14.2 format with wide valid pixel entries)
+
+vx_status CalculateOverlayBufferSize(
+	vx_uint32 numOverlay,                        // [in] number of overlays
+	vx_uint32 eqrWidth,                          // [in] output equirectangular image width
+	vx_uint32 eqrHeight,                         // [in] output equirectangular image height
+	const vx_uint8 * overlayIndexBuf,            // [in] overlay index map: size: [eqrWidth * eqrHeight]
+	vx_size * mapTableSize                       // [out] size of overlay valid/warp table, in terms of number of entries
+	);
+
+vx_status GenerateOverlayBuffers(
+	vx_uint32 numOverlay,                        // [in] number of overlays
+	vx_uint32 eqrWidth,                          // [in] output equirectangular image width
+	vx_uint32 eqrHeight,                         // [in] output equirectangular image height
+	const vx_uint8 * overlayIndexBuf,            // [in] overlay index map: size: [eqrWidth * eqrHeight]
+	const StitchCoord2dFloat * overlaySrcMap,    // [in] overlay coordinate mapping: size: [numOverlay * eqrWidth * eqrHeight]
+	vx_uint32 numOverlayColumns,                 // [in] number of overlay columns
+	vx_uint32 overlayWidth,                      // [in] overlay image width
+	vx_uint32 overlayHeight,                     // [in] overlay image height
+	vx_size   mapTableSize,                      // [in] size of overlay valid/warp table, in terms of number of entries
+	StitchValidPixelEntry * validMap,            // [out] valid map table (NULL when validMapWide is used)
+	StitchValidPixelWideEntry * validMapWide,    // [out] wide valid map table (NULL when validMap is used)
+	StitchWarpRemapEntry * warpMap,              // [out] warp map table
+	vx_size * mapEntryCount                      // [out] number of entries added to overlay valid/warp table
+	);
+
+#endif //__OVERLAY_BLEND_H__
@@ -24,6 +24,277 @@ THE SOFTWARE.
 #include "pyramid_scale.h"
 #include "multiband_blender.h"
 
+//////////////////////////////////////////////////////////////////////
+// CPU implementation of pyramid kernels: each 64x16 tile of the work list is
+// filtered with a horizontal pass into a small ring of rows followed by a vertical
+// pass, so that the working set of a tile stays within L1 cache. Pixels are kept
+// in __m128 with one lane per channel (U8/S16: one, RGB4_AMD: three, RGBX: four).
+
+//! \brief The image accessed by CPU kernels.
+typedef struct {
+	vx_image image;
+	vx_rectangle_t rect;
+	vx_imagepatch_addressing_t addr;
+	void * ptr;
+	vx_df_image format;
+	vx_uint32 width, height1;   // height1: height of each camera
+} PyramidImageCPU;
+
+static vx_status PyramidImageAccess(PyramidImageCPU& img, vx_reference ref, vx_uint32 numCam, vx_enum usage)
+{
+	vx_uint32 height = 0;
+	img.image = (vx_image)ref;
+	img.ptr = nullptr;
+	ERROR_CHECK_STATUS(vxQueryImage(img.image, VX_IMAGE_ATTRIBUTE_WIDTH, &img.width, sizeof(img.width)));
+	ERROR_CHECK_STATUS(vxQueryImage(img.image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	ERROR_CHECK_STATUS(vxQueryImage(img.image, VX_IMAGE_ATTRIBUTE_FORMAT, &img.format, sizeof(img.format)));
+	img.height1 = numCam ? height / numCam : height;
+	img.rect.start_x = img.rect.start_y = 0; img.rect.end_x = img.width; img.rect.end_y = height;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(img.image, &img.rect, 0, &img.addr, &img.ptr, usage));
+	return VX_SUCCESS;
+}
+
+static vx_status PyramidImageCommit(PyramidImageCPU& img)
+{
+	ERROR_CHECK_STATUS(vxCommitImagePatch(img.image, &img.rect, 0, &img.addr, img.ptr));
+	return VX_SUCCESS;
+}
+
+//! \brief Row of camera image: y is clamped to camera image like OpenCL kernels do for border tiles.
+static inline vx_uint8 * PyramidImageRow(const PyramidImageCPU& img, vx_uint32 camId, vx_int32 y)
+{
+	y = std::max(0, std::min((vx_int32)img.height1 - 1, y));
+	return (vx_uint8 *)img.ptr + (camId * img.height1 + y) * img.addr.stride_y;
+}
+
+static inline __m128 PyramidLoadPixel(const vx_uint8 * row, vx_uint32 x, vx_df_image format)
+{
+	if (format == VX_DF_IMAGE_RGBX) {
+		return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(((const vx_int32 *)row)[x])));
+	}
+	else if (format == VX_DF_IMAGE_U8) {
+		return _mm_set_ss((float)row[x]);
+	}
+	else if (format == VX_DF_IMAGE_S16) {
+		return _mm_set_ss((float)((const vx_int16 *)row)[x]);
+	}
+	const vx_int16 * p = (const vx_int16 *)row + x * 3;
+	return _mm_setr_ps(p[0], p[1], p[2], 0.0f);
+}
+
+//! \brief Store pixel with round to nearest even and saturation: same as convert_*_sat_rte and amd_pack.
+static inline void PyramidStorePixel(vx_uint8 * row, vx_uint32 x, vx_df_image format, __m128 f)
+{
+	__m128i v = _mm_packs_epi32(_mm_cvtps_epi32(f), _mm_setzero_si128());
+	if (format == VX_DF_IMAGE_RGBX) {
+		((vx_int32 *)row)[x] = _mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+	}
+	else if (format == VX_DF_IMAGE_U8) {
+		row[x] = (vx_uint8)_mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+	}
+	else if (format == VX_DF_IMAGE_S16) {
+		((vx_int16 *)row)[x] = (vx_int16)_mm_extract_epi16(v, 0);
+	}
+	else {
+		vx_int16 * p = (vx_int16 *)row + x * 3;
+		p[0] = (vx_int16)_mm_extract_epi16(v, 0);
+		p[1] = (vx_int16)_mm_extract_epi16(v, 1);
+		p[2] = (vx_int16)_mm_extract_epi16(v, 2);
+	}
+}
+
+//! \brief Load count pixels of a row starting at x: the format is resolved once and groups of 4 pixels are read
+//  with one or two loads that stay within the pixels. Same results as PyramidLoadPixel.
+static inline void PyramidLoadPixels(__m128 * pix, const vx_uint8 * row, vx_uint32 x, vx_uint32 count, vx_df_image format)
+{
+	vx_uint32 i = 0;
+	if (format == VX_DF_IMAGE_RGBX) {
+		for (; i + 4 <= count; i += 4) {
+			__m128i v = _mm_loadu_si128((const __m128i *)(row + (x + i) * 4));
+			pix[i + 0] = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(v));
+			pix[i + 1] = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(v, 4)));
+			pix[i + 2] = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(v, 8)));
+			pix[i + 3] = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(v, 12)));
+		}
+	}
+	else if (format == VX_DF_IMAGE_U8 || format == VX_DF_IMAGE_S16) {
+		// one channel in lane 0 with other lanes zero
+		for (; i + 4 <= count; i += 4) {
+			__m128i v = (format == VX_DF_IMAGE_U8) ?
+				_mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(const vx_int32 *)(row + x + i))) :
+				_mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)((const vx_int16 *)row + x + i)));
+			__m128 f = _mm_cvtepi32_ps(v);
+			pix[i + 0] = _mm_insert_ps(f, f, 0x0E);
+			pix[i + 1] = _mm_insert_ps(f, f, 0x4E);
+			pix[i + 2] = _mm_insert_ps(f, f, 0x8E);
+			pix[i + 3] = _mm_insert_ps(f, f, 0xCE);
+		}
+	}
+	else {
+		// RGB4_AMD: 4 pixels are 24 bytes read as bytes 0..15 and 8..23
+		const __m128i zero = _mm_setzero_si128();
+		for (; i + 4 <= count; i += 4) {
+			const vx_int16 * p = (const vx_int16 *)row + (x + i) * 3;
+			__m128i v0 = _mm_loadu_si128((const __m128i *)p);
+			__m128i v1 = _mm_loadu_si128((const __m128i *)(p + 4));
+			pix[i + 0] = _mm_cvtepi32_ps(_mm_blend_epi16(_mm_cvtepi16_epi32(v0), zero, 0xC0));
+			pix[i + 1] = _mm_cvtepi32_ps(_mm_blend_epi16(_mm_cvtepi16_epi32(_mm_srli_si128(v0, 6)), zero, 0xC0));
+			pix[i + 2] = _mm_cvtepi32_ps(_mm_blend_epi16(_mm_cvtepi16_epi32(_mm_srli_si128(v1, 4)), zero, 0xC0));
+			pix[i + 3] = _mm_cvtepi32_ps(_mm_blend_epi16(_mm_cvtepi16_epi32(_mm_srli_si128(v1, 10)), zero, 0xC0));
+		}
+	}
+	for (; i < count; i++)
+		pix[i] = PyramidLoadPixel(row, x + i, format);
+}
+
+//! \brief Store count pixels of a row starting at x: the format is resolved once and groups of 4 pixels are packed
+//  and written with one or two stores. Same results as PyramidStorePixel.
+static inline void PyramidStorePixels(vx_uint8 * row, vx_uint32 x, vx_uint32 count, vx_df_image format, const __m128 * pix)
+{
+	vx_uint32 i = 0;
+	if (format == VX_DF_IMAGE_RGBX) {
+		for (; i + 4 <= count; i += 4) {
+			__m128i v0 = _mm_packs_epi32(_mm_cvtps_epi32(pix[i + 0]), _mm_cvtps_epi32(pix[i + 1]));
+			__m128i v1 = _mm_packs_epi32(_mm_cvtps_epi32(pix[i + 2]), _mm_cvtps_epi32(pix[i + 3]));
+			_mm_storeu_si128((__m128i *)(row + (x + i) * 4), _mm_packus_epi16(v0, v1));
+		}
+	}
+	else if (format == VX_DF_IMAGE_U8 || format == VX_DF_IMAGE_S16) {
+		// gather lane 0 of 4 pixels
+		for (; i + 4 <= count; i += 4) {
+			__m128 f = _mm_movelh_ps(_mm_unpacklo_ps(pix[i + 0], pix[i + 1]), _mm_unpacklo_ps(pix[i + 2], pix[i + 3]));
+			__m128i v = _mm_packs_epi32(_mm_cvtps_epi32(f), _mm_setzero_si128());
+			if (format == VX_DF_IMAGE_U8)
+				*(vx_int32 *)(row + x + i) = _mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+			else
+				_mm_storel_epi64((__m128i *)((vx_int16 *)row + x + i), v);
+		}
+	}
+	else {
+		// RGB4_AMD: drop lane 3 of each pixel and write 24 bytes as 16 + 8
+		const __m128i pack3 = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1);
+		for (; i + 4 <= count; i += 4) {
+			vx_int16 * p = (vx_int16 *)row + (x + i) * 3;
+			__m128i v0 = _mm_shuffle_epi8(_mm_packs_epi32(_mm_cvtps_epi32(pix[i + 0]), _mm_cvtps_epi32(pix[i + 1])), pack3);
+			__m128i v1 = _mm_shuffle_epi8(_mm_packs_epi32(_mm_cvtps_epi32(pix[i + 2]), _mm_cvtps_epi32(pix[i + 3])), pack3);
+			_mm_storeu_si128((__m128i *)p, _mm_or_si128(v0, _mm_slli_si128(v1, 12)));
+			_mm_storel_epi64((__m128i *)(p + 8), _mm_srli_si128(v1, 4));
+		}
+	}
+	for (; i < count; i++)
+		PyramidStorePixel(row, x + i, format, pix[i]);
+}
+
+//! \brief Load count pixels of a camera row starting at x: x wraps around like OpenCL kernels do for border tiles.
+static inline void PyramidLoadRow(__m128 * pix, const PyramidImageCPU& img, vx_uint32 camId, vx_int32 y, vx_int32 x, vx_uint32 count)
+{
+	const vx_uint8 * row = PyramidImageRow(img, camId, y);
+	vx_int32 width = (vx_int32)img.width;
+	if (x >= 0 && x + (vx_int32)count <= width) {
+		PyramidLoadPixels(pix, row, (vx_uint32)x, count, img.format);
+	}
+	else {
+		for (vx_uint32 i = 0; i < count; i++) {
+			vx_int32 xi = (x + (vx_int32)i) % width;
+			pix[i] = PyramidLoadPixel(row, xi < 0 ? xi + width : xi, img.format);
+		}
+	}
+}
+
+//! \brief Number of valid columns and rows of a tile: step is the number of pixels per OpenCL work item.
+static inline bool PyramidTileSize(const StitchBlendTile& tile, vx_uint32 step, vx_uint32 width, vx_uint32 height1, vx_uint32& nx, vx_uint32& ny)
+{
+	if (tile.dstX >= width || tile.dstY >= height1)
+		return false;
+	nx = std::min(std::min((tile.last_x / step + 1) * step, 64u), width - tile.dstX);
+	ny = std::min(std::min(tile.last_y + 1, 16u), height1 - tile.dstY);
+	return true;
+}
+
+//! \brief Gaussian 5x5 [1 4 6 4 1] filter and half scale of a tile: output(x,y) is centered at input(2x+1,2y+1).
+static void HalfScaleGaussianTile(const StitchBlendTile& tile, vx_uint32 nx, vx_uint32 ny,
+	const PyramidImageCPU& src, PyramidImageCPU& dst, float scale)
+{
+	__m128 pix[2 * 64 + 3], ring[5][64], out[64];
+	const __m128 w4 = _mm_set1_ps(4.0f), w6 = _mm_set1_ps(6.0f), s = _mm_set1_ps(scale);
+	vx_int32 xbase = 2 * (vx_int32)tile.dstX - 1, ybase = 2 * (vx_int32)tile.dstY - 1;
+	vx_uint32 rowsDone = 0;
+	for (vx_uint32 y = 0; y < ny; y++) {
+		// horizontal pass of input rows 2y..2y+4 of the tile
+		for (; rowsDone <= 2 * y + 4; rowsDone++) {
+			PyramidLoadRow(pix, src, tile.camId, ybase + rowsDone, xbase, 2 * nx + 3);
+			__m128 * h = ring[rowsDone % 5];
+			for (vx_uint32 x = 0; x < nx; x++) {
+				const __m128 * p = pix + 2 * x;
+				__m128 f = _mm_add_ps(p[0], p[4]);
+				f = _mm_add_ps(f, _mm_mul_ps(_mm_add_ps(p[1], p[3]), w4));
+				h[x] = _mm_add_ps(f, _mm_mul_ps(p[2], w6));
+			}
+		}
+		// vertical pass
+		const __m128 * r0 = ring[(2 * y) % 5], * r1 = ring[(2 * y + 1) % 5], * r2 = ring[(2 * y + 2) % 5];
+		const __m128 * r3 = ring[(2 * y + 3) % 5], * r4 = ring[(2 * y + 4) % 5];
+		for (vx_uint32 x = 0; x < nx; x++) {
+			__m128 f = _mm_add_ps(r0[x], r4[x]);
+			f = _mm_add_ps(f, _mm_mul_ps(_mm_add_ps(r1[x], r3[x]), w4));
+			f = _mm_add_ps(f, _mm_mul_ps(r2[x], w6));
+			out[x] = _mm_mul_ps(f, s);
+		}
+		PyramidStorePixels(PyramidImageRow(dst, tile.camId, tile.dstY + y), tile.dstX, nx, dst.format, out);
+	}
+}
+
+//! \brief Upscale of next level into a tile with [1 4 6 4 1] filter: result is zero for copy tiles.
+static void UpscaleGaussianTile(const StitchBlendTile& tile, vx_uint32 nx, vx_uint32 ny,
+	const PyramidImageCPU& src, __m128 up[16][64])
+{
+	if (tile.copyTile) {
+		for (vx_uint32 y = 0; y < ny; y++)
+			for (vx_uint32 x = 0; x < nx; x++)
+				up[y][x] = _mm_setzero_ps();
+		return;
+	}
+	__m128 pix[64 / 2 + 3], ring[3][64];
+	const __m128 w4 = _mm_set1_ps(4.0f), w6 = _mm_set1_ps(6.0f), s = _mm_set1_ps(0.015625f);
+	vx_int32 xbase = (vx_int32)(tile.dstX >> 1) - 1, ybase = (vx_int32)(tile.dstY >> 1) - 1;
+	vx_uint32 rowsDone = 0;
+	for (vx_uint32 y = 0; y < ny; y++) {
+		vx_uint32 c = (y >> 1) + 1;
+		// horizontal pass of next level rows c-1..c+1 of the tile
+		for (; rowsDone <= c + 1; rowsDone++) {
+			PyramidLoadRow(pix, src, tile.camId, ybase + rowsDone, xbase, ((nx - 1) >> 1) + 3);
+			__m128 * h = ring[rowsDone % 3];
+			for (vx_uint32 x = 0; x < nx; x++) {
+				const __m128 * p = pix + (x >> 1);
+				if (x & 1)
+					h[x] = _mm_mul_ps(_mm_add_ps(p[1], p[2]), w4);
+				else
+					h[x] = _mm_add_ps(_mm_add_ps(p[0], p[2]), _mm_mul_ps(p[1], w6));
+			}
+		}
+		// vertical pass
+		const __m128 * r0 = ring[(c - 1) % 3], * r1 = ring[c % 3], * r2 = ring[(c + 1) % 3];
+		if (y & 1) {
+			for (vx_uint32 x = 0; x < nx; x++)
+				up[y][x] = _mm_mul_ps(_mm_mul_ps(_mm_add_ps(r1[x], r2[x]), w4), s);
+		}
+		else {
+			for (vx_uint32 x = 0; x < nx; x++)
+				up[y][x] = _mm_mul_ps(_mm_add_ps(_mm_add_ps(r0[x], r2[x]), _mm_mul_ps(r1[x], w6)), s);
+		}
+	}
+}
+
+//! \brief Enable CPU target for multiband pyramid kernels with MULTIBAND_CPU environment variable or host execution.
+vx_uint32 PyramidTargetAffinity(vx_graph graph)
+{
+	char textBuffer[256];
+	int MULTIBAND_CPU = 0;
+	if (StitchGetEnvironmentVariable("MULTIBAND_CPU", textBuffer, sizeof(textBuffer))) { MULTIBAND_CPU = atoi(textBuffer); }
+	if (StitchIsHostExecution(graph)) MULTIBAND_CPU = 1;
+	return MULTIBAND_CPU ? AGO_TARGET_AFFINITY_CPU : AGO_TARGET_AFFINITY_GPU;
+}
+
 //! \brief The input validator callback.
 static vx_status VX_CALLBACK half_scale_gaussian_input_validator(vx_node node, vx_uint32 index)
 {
@@ -62,7 +333,7 @@ static vx_status VX_CALLBACK half_scale_gaussian_input_validator(vx_node node, v
 	{ // array object of StitchBlendValidEntry type
 		vx_size itemsize = 0;
 		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
-		if (itemsize == sizeof(StitchBlendValidEntry)) {
+		if (itemsize == sizeof(StitchBlendValidEntry) || itemsize == sizeof(StitchBlendValidWideEntry)) {
 			status = VX_SUCCESS;
 		}
 		else {
@@ -149,7 +420,7 @@ static vx_status VX_CALLBACK half_scale_gaussian_query_target_support(vx_graph g
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = PyramidTargetAffinity(graph);
 	return VX_SUCCESS;
 }
 
@@ -208,9 +479,11 @@ static vx_status VX_CALLBACK half_scale_gaussian_opencl_codegen(
 	ERROR_CHECK_OBJECT(scalar);
 	ERROR_CHECK_STATUS(vxReadScalarValue(scalar, &num_cameras));
 	ERROR_CHECK_STATUS(vxReleaseScalar(&scalar));
+	vx_size arr_itemsize = 0;
 	vx_array arr = (vx_array)avxGetNodeParamRef(node, 2);				// input array
 	ERROR_CHECK_OBJECT(arr);
 	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_CAPACITY, &arr_capacity, sizeof(arr_capacity)));
+	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &arr_itemsize, sizeof(arr_itemsize)));
 	ERROR_CHECK_STATUS(vxReleaseArray(&arr));
 	vx_image image = (vx_image)avxGetNodeParamRef(node, 3);				// input image
 	ERROR_CHECK_OBJECT(image);
@@ -275,12 +548,12 @@ static vx_status VX_CALLBACK half_scale_gaussian_opencl_codegen(
 	opencl_kernel_code +=
 		"  if(grp_id < valid_pix_num_items)\n"
 		"  {\n"
-		"    valid_pix_buf += valid_pix_buf_offset + ((grp_id + arr_offs) << 3) ;\n"			// each entry is 8 bytes
-		"    uint2 wgInfo = *(__global uint2 * ) valid_pix_buf;\n"
+		"    valid_pix_buf += valid_pix_buf_offset + ((grp_id + arr_offs) << BLEND_ENTRY_SHIFT);\n"			// each entry is 8 or 16 bytes
+		"    BLEND_ENTRY wgInfo = *(__global BLEND_ENTRY *) valid_pix_buf;\n"
 		"    bool outputValid = (lx <= ((wgInfo.s1 & 0xFF) >> 2)) && (ly <= ((wgInfo.s1 >> 8) & 0xFF)) ? true : false;\n"
-		"    int camId = wgInfo.s0 & 0x1F;\n"
-		"    int gx = (wgInfo.s0 >> 5) & 0x3FFF;\n"
-		"    int gy = (wgInfo.s0 >> 19) & 0x1FFF;\n"
+		"    int camId = BLEND_CAM(wgInfo);\n"
+		"    int gx = BLEND_X(wgInfo);\n"
+		"    int gy = BLEND_Y(wgInfo);\n"
 		"    int border = (wgInfo.s1 >> 30)&0x3;\n";
 		if (input_format == VX_DF_IMAGE_U8) {
 		if (output_format == VX_DF_IMAGE_U8){
@@ -672,13 +945,32 @@ static vx_status VX_CALLBACK half_scale_gaussian_opencl_codegen(
 			"}\n";
 	}
 	
+	opencl_kernel_code = GetBlendValidEntryOpenCLMacros(arr_itemsize == sizeof(StitchBlendValidWideEntry)) + opencl_kernel_code;
 	return VX_SUCCESS;
 }
 
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK half_scale_gaussian_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_SUPPORTED;
+	vx_uint32 numCam = 0, arr_offset = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &numCam));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[1], &arr_offset));
+	std::vector<StitchBlendTile> tiles;
+	ERROR_CHECK_STATUS(GetBlendWorkList((vx_array)parameters[2], arr_offset, tiles));
+	PyramidImageCPU src, dst;
+	ERROR_CHECK_STATUS(PyramidImageAccess(src, parameters[3], numCam, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(PyramidImageAccess(dst, parameters[4], numCam, VX_WRITE_ONLY));
+	// U8 to S16 output keeps 7 fractional bits: same as OpenCL kernel
+	float scale = (src.format == VX_DF_IMAGE_U8 && dst.format == VX_DF_IMAGE_S16) ? 0.5f : 0.00390625f;
+#pragma omp parallel for
+	for (int t = 0; t < (int)tiles.size(); t++) {
+		vx_uint32 nx, ny;
+		if (PyramidTileSize(tiles[t], 4, dst.width, dst.height1, nx, ny))
+			HalfScaleGaussianTile(tiles[t], nx, ny, src, dst, scale);
+	}
+	ERROR_CHECK_STATUS(PyramidImageCommit(src));
+	ERROR_CHECK_STATUS(PyramidImageCommit(dst));
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel publisher.
@@ -790,7 +1082,7 @@ static vx_status VX_CALLBACK upscale_gaussian_subtract_input_validator(vx_node n
 	{ // array object for offsets
 		vx_size itemsize = 0;
 		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
-		if (itemsize == sizeof(StitchBlendValidEntry)) {
+		if (itemsize == sizeof(StitchBlendValidEntry) || itemsize == sizeof(StitchBlendValidWideEntry)) {
 			status = VX_SUCCESS;
 		}
 		else {
@@ -858,14 +1150,57 @@ static vx_status VX_CALLBACK upscale_gaussian_subtract_query_target_support(vx_g
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = PyramidTargetAffinity(graph);
 	return VX_SUCCESS;
 }
 
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK upscale_gaussian_subtract_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_IMPLEMENTED;
+	vx_uint32 numCam = 0, arr_offset = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &numCam));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[1], &arr_offset));
+	std::vector<StitchBlendTile> tiles;
+	ERROR_CHECK_STATUS(GetBlendWorkList((vx_array)parameters[4], arr_offset, tiles));
+	PyramidImageCPU src, src1, wt, dst;
+	bool useWeight = parameters[5] ? true : false;
+	ERROR_CHECK_STATUS(PyramidImageAccess(src, parameters[2], numCam, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(PyramidImageAccess(src1, parameters[3], numCam, VX_READ_ONLY));
+	if (useWeight) {
+		ERROR_CHECK_STATUS(PyramidImageAccess(wt, parameters[5], numCam, VX_READ_ONLY));
+	}
+	ERROR_CHECK_STATUS(PyramidImageAccess(dst, parameters[6], numCam, VX_WRITE_ONLY));
+	float divfactor = (useWeight && wt.format == VX_DF_IMAGE_U8) ? 0.0627451f : 0.000490196f;
+	// output = (G(l) - upscale(G(l+1))) * weight * divfactor
+#pragma omp parallel for
+	for (int t = 0; t < (int)tiles.size(); t++) {
+		const StitchBlendTile& tile = tiles[t];
+		vx_uint32 nx, ny;
+		if (!PyramidTileSize(tile, 4, std::min(dst.width, src.width), std::min(dst.height1, src.height1), nx, ny))
+			continue;
+		__m128 up[16][64];
+		UpscaleGaussianTile(tile, nx, ny, src1, up);
+		__m128 pix[64], w[64];
+		for (vx_uint32 y = 0; y < ny; y++) {
+			PyramidLoadPixels(pix, PyramidImageRow(src, tile.camId, tile.dstY + y), tile.dstX, nx, src.format);
+			if (useWeight)
+				PyramidLoadPixels(w, PyramidImageRow(wt, tile.camId, tile.dstY + y), tile.dstX, nx, wt.format);
+			for (vx_uint32 x = 0; x < nx; x++) {
+				__m128 f = _mm_sub_ps(pix[x], up[y][x]);
+				if (useWeight)
+					f = _mm_mul_ps(f, _mm_mul_ps(_mm_shuffle_ps(w[x], w[x], 0), _mm_set1_ps(divfactor)));
+				pix[x] = f;
+			}
+			PyramidStorePixels(PyramidImageRow(dst, tile.camId, tile.dstY + y), tile.dstX, nx, dst.format, pix);
+		}
+	}
+	ERROR_CHECK_STATUS(PyramidImageCommit(src));
+	ERROR_CHECK_STATUS(PyramidImageCommit(src1));
+	if (useWeight) {
+		ERROR_CHECK_STATUS(PyramidImageCommit(wt));
+	}
+	ERROR_CHECK_STATUS(PyramidImageCommit(dst));
+	return VX_SUCCESS;
 }
 
 //! \brief The OpenCL code generator callback.
@@ -898,8 +1233,10 @@ static vx_status VX_CALLBACK upscale_gaussian_subtract_opencl_codegen(
 	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
 	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_FORMAT, &out_format, sizeof(out_format)));
 	ERROR_CHECK_STATUS(vxReleaseImage(&image));
+	vx_size wg_itemsize = 0;
 	vx_array wg_offsets = (vx_array)avxGetNodeParamRef(node, 4);
 	ERROR_CHECK_STATUS(vxQueryArray(wg_offsets, VX_ARRAY_ATTRIBUTE_CAPACITY, &wg_num, sizeof(wg_num)));
+	ERROR_CHECK_STATUS(vxQueryArray(wg_offsets, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &wg_itemsize, sizeof(wg_itemsize)));
 	ERROR_CHECK_STATUS(vxReleaseArray(&wg_offsets));
 	vx_image weight_image = (vx_image)avxGetNodeParamRef(node, 5);
 	vx_df_image wt_format = VX_DF_IMAGE_VIRT;
@@ -948,15 +1285,16 @@ static vx_status VX_CALLBACK upscale_gaussian_subtract_opencl_codegen(
 			"   uint op_width, uint op_height, __global uchar * op_buf, uint op_stride, uint op_offset)\n"
 			"{\n"
 			"	int grp_id = get_global_id(0)>>4, lx = get_local_id(0), ly = get_global_id(1);\n"
-			"	pG_buf += (pG_offs + (arr_offs<<3));\n"
+			"	pG_buf += (pG_offs + (arr_offs<<BLEND_ENTRY_SHIFT));\n"
 			"	if (grp_id < pG_num) {\n"
 			"	int size_x = get_local_size(0) - 1; \n"
-			"	uint2 offs = ((__global uint2 *)pG_buf)[grp_id];\n"
-			"	uint camera_id = offs.x & 0x1f; int gx = (lx<<2) + ((offs.x >> 5) & 0x3FFF); int gy = (offs.x >> 19);\n"
+			"	BLEND_ENTRY offs = ((__global BLEND_ENTRY *)pG_buf)[grp_id];\n"
+			"	uint camera_id = BLEND_CAM(offs); int gx = (lx<<2) + BLEND_X(offs); int gy = BLEND_Y(offs);\n"
 			"	if (!get_group_id(1) | (get_group_id(1) && (gy+8 < %d))) {\n"
 			"	gy += (ly<<1);\n"
 			"   bool outputValid = (lx*4 <= (offs.y & 0xFF)) && (ly*2 <= ((offs.y >> 8)&0xFF));\n"
 			"	int border = (offs.y >> 30) & 0x3;\n"
+			"	bool copy_tile = (offs.y >> 29) & 0x1;\n"
 			"	int ybound = %d;\n"
 			"	ip_buf += ip_offset + mad24(gy, (int)ip_stride, gx<<2);\n"
 			"	op_buf  += op_offset + mad24(gy, (int)op_stride, gx*6);\n"
@@ -995,14 +1333,15 @@ static vx_status VX_CALLBACK upscale_gaussian_subtract_opencl_codegen(
 			"   uint op_width, uint op_height, __global uchar * op_buf, uint op_stride, uint op_offset)\n"
 			"{\n"
 			"	int grp_id = get_global_id(0)>>4, lx = get_local_id(0), ly = get_global_id(1);\n"
-			"	pG_buf += (pG_offs + (arr_offs<<3));\n"
+			"	pG_buf += (pG_offs + (arr_offs<<BLEND_ENTRY_SHIFT));\n"
 			"	int size_x = get_local_size(0) - 1; \n"
-			"	uint2 offs = ((__global uint2 *)pG_buf)[grp_id];\n"
-			"	uint camera_id = offs.x & 0x1f; int gx = (lx<<2) + ((offs.x >> 5) & 0x3FFF); uint gy = (offs.x >> 19);\n"
+			"	BLEND_ENTRY offs = ((__global BLEND_ENTRY *)pG_buf)[grp_id];\n"
+			"	uint camera_id = BLEND_CAM(offs); int gx = (lx<<2) + BLEND_X(offs); uint gy = BLEND_Y(offs);\n"
 			"	if (!get_group_id(1) | (get_group_id(1) && (gy+8 < %d))) {\n"
 			"	gy += (ly<<1);\n"
 			"   bool outputValid = (lx*4 <= (offs.y & 0xFF)) && (ly*2 <= ((offs.y >> 8)&0xFF));\n"
 			"	int border = (offs.y >> 30)&0x3;\n"
+			"	bool copy_tile = (offs.y >> 29) & 0x1;\n"
 			"	int ybound = %d;\n"
 			"	ip_buf += ip_offset + mad24(gy, (int)ip_stride, gx<<2);\n"
 			"	op_buf  += op_offset + mad24(gy, (int)op_stride, gx*6);\n"
@@ -1020,7 +1359,10 @@ static vx_status VX_CALLBACK upscale_gaussian_subtract_opencl_codegen(
 		"	__local short lsVert[64*6*3];\n"
 		"	int loffset = mad24(ly, (int)36, (lx<<1)); \n"
 		"	int2 loffs2  = (int2)((loffset + 4*36), 4*ip1_stride);\n"
-		"  if (!border){\n"
+		"  if (copy_tile) {\n"
+		"    // tile away from seams: no upscale term\n"
+		"  }\n"
+		"  else if (!border){\n"
 		"   ip1_buf += mad24(gy>>1, (int)ip1_stride, gx<<1);\n"
 		"  	ip1_buf -= (ip1_stride + 8);\n"
 		"  	if (!lx){\n"
@@ -1114,7 +1456,8 @@ static vx_status VX_CALLBACK upscale_gaussian_subtract_opencl_codegen(
 			"     row0_8 += convert_float8(tmp_8); row0_4 += convert_float4(tmp_4);\n"
 			"     row1_8 = mad(convert_float8(tmp_8), (float8)(4.0f), row1_8); row1_4 = mad(convert_float4(tmp_4), (float4)(4.0f), row1_4);\n"
 			"     row0_8 *= (float8)0.015625f; row0_4 *= (float4)0.015625f;"
-			"     row1_8 *= (float8)0.015625f; row1_4 *= (float4)0.015625f;"
+			"     row1_8 *= (float8)0.015625f; row1_4 *= (float4)0.015625f;\n"
+			"     if (copy_tile) { row0_8 = row1_8 = (float8)0.0f; row0_4 = row1_4 = (float4)0.0f; }\n"
 			"     uint4 px = *(__global uint4 *)ip_buf;"
 			"     tmp = amd_unpack_3(px.s0); row0_8.s012 = tmp - row0_8.s012;\n"
 			"     tmp = amd_unpack_3(px.s1); row0_8.s345 = tmp - row0_8.s345;\n"
@@ -1180,7 +1523,8 @@ static vx_status VX_CALLBACK upscale_gaussian_subtract_opencl_codegen(
 		"     row0_8 += convert_float8(tmp_8); row0_4 += convert_float4(tmp_4);\n"
 		"     row1_8 = mad(convert_float8(tmp_8), (float8)(4.0f), row1_8); row1_4 = mad(convert_float4(tmp_4), (float4)(4.0f), row1_4);\n"
 		"     row0_8 *= (float8)0.015625f; row0_4 *= (float4)0.015625f;"
-		"     row1_8 *= (float8)0.015625f; row1_4 *= (float4)0.015625f;"
+		"     row1_8 *= (float8)0.015625f; row1_4 *= (float4)0.015625f;\n"
+		"     if (copy_tile) { row0_8 = row1_8 = (float8)0.0f; row0_4 = row1_4 = (float4)0.0f; }\n"
 		"     uint4 px = *(__global uint4 *)ip_buf;"
 		"     tmp = amd_unpack_3(px.s0); row0_8.s012 = tmp - row0_8.s012;\n"
 		"     tmp = amd_unpack_3(px.s1); row0_8.s345 = tmp - row0_8.s345;\n"
@@ -1200,6 +1544,7 @@ static vx_status VX_CALLBACK upscale_gaussian_subtract_opencl_codegen(
 		" }\n"
 		"}\n";
 	}
+	opencl_kernel_code = GetBlendValidEntryOpenCLMacros(wg_itemsize == sizeof(StitchBlendValidWideEntry)) + opencl_kernel_code;
 	return VX_SUCCESS;
 }
 
@@ -1334,7 +1679,7 @@ static vx_status VX_CALLBACK upscale_gaussian_add_input_validator(vx_node node,
 	{ // array object for offsets
 		vx_size itemsize = 0;
 		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
-		if (itemsize == sizeof(StitchBlendValidEntry)) {
+		if (itemsize == sizeof(StitchBlendValidEntry) || itemsize == sizeof(StitchBlendValidWideEntry)) {
 			status = VX_SUCCESS;
 		}
 		else {
@@ -1385,14 +1730,43 @@ static vx_status VX_CALLBACK upscale_gaussian_add_query_target_support(vx_graph
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = PyramidTargetAffinity(graph);
 	return VX_SUCCESS;
 }
 
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK upscale_gaussian_add_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_IMPLEMENTED;
+	vx_uint32 numCam = 0, arr_offset = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &numCam));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[1], &arr_offset));
+	std::vector<StitchBlendTile> tiles;
+	ERROR_CHECK_STATUS(GetBlendWorkList((vx_array)parameters[4], arr_offset, tiles));
+	PyramidImageCPU src, src1, dst;
+	ERROR_CHECK_STATUS(PyramidImageAccess(src, parameters[2], numCam, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(PyramidImageAccess(src1, parameters[3], numCam, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(PyramidImageAccess(dst, parameters[5], numCam, VX_WRITE_ONLY));
+	// output = L(l) + upscale(R(l+1))
+#pragma omp parallel for
+	for (int t = 0; t < (int)tiles.size(); t++) {
+		const StitchBlendTile& tile = tiles[t];
+		vx_uint32 nx, ny;
+		if (!PyramidTileSize(tile, 8, std::min(dst.width, src.width), std::min(dst.height1, src.height1), nx, ny))
+			continue;
+		__m128 up[16][64];
+		UpscaleGaussianTile(tile, nx, ny, src1, up);
+		__m128 pix[64];
+		for (vx_uint32 y = 0; y < ny; y++) {
+			PyramidLoadPixels(pix, PyramidImageRow(src, tile.camId, tile.dstY + y), tile.dstX, nx, src.format);
+			for (vx_uint32 x = 0; x < nx; x++)
+				pix[x] = _mm_add_ps(pix[x], up[y][x]);
+			PyramidStorePixels(PyramidImageRow(dst, tile.camId, tile.dstY + y), tile.dstX, nx, dst.format, pix);
+		}
+	}
+	ERROR_CHECK_STATUS(PyramidImageCommit(src));
+	ERROR_CHECK_STATUS(PyramidImageCommit(src1));
+	ERROR_CHECK_STATUS(PyramidImageCommit(dst));
+	return VX_SUCCESS;
 }
 
 //! \brief The OpenCL code generator callback.
@@ -1426,8 +1800,10 @@ static vx_status VX_CALLBACK upscale_gaussian_add_opencl_codegen(
 	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
 	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_FORMAT, &out_format, sizeof(out_format)));
 	ERROR_CHECK_STATUS(vxReleaseImage(&image));
+	vx_size wg_itemsize = 0;
 	vx_array wg_offsets = (vx_array)avxGetNodeParamRef(node, 4);
 	ERROR_CHECK_STATUS(vxQueryArray(wg_offsets, VX_ARRAY_ATTRIBUTE_CAPACITY, &wg_num, sizeof(wg_num)));
+	ERROR_CHECK_STATUS(vxQueryArray(wg_offsets, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &wg_itemsize, sizeof(wg_itemsize)));
 	ERROR_CHECK_STATUS(vxReleaseArray(&wg_offsets));
 	// set kernel configuration
 	strcpy(opencl_kernel_function_name, "upscale_gaussian_add");
@@ -1458,11 +1834,11 @@ static vx_status VX_CALLBACK upscale_gaussian_add_opencl_codegen(
 		"   uint op_width, uint op_height, __global uchar * op_buf, uint op_stride, uint op_offset)\n"
 		"{\n"
 		"	int grp_id = get_global_id(0)>>3, lx = get_local_id(0), ly = get_global_id(1);\n"
-		"	pG_buf += (pG_offs + (arr_offs<<3));\n"
+		"	pG_buf += (pG_offs + (arr_offs<<BLEND_ENTRY_SHIFT));\n"
 		"	if (grp_id < pG_num) {\n"
 		"		int size_x = get_local_size(0) - 1; \n"
-		"		uint2 offs = ((__global uint2 *)pG_buf)[grp_id];\n"
-		"		uint camera_id = offs.x & 0x1f; uint gx = (lx<<3) + ((offs.x >> 5) & 0x3FFF); uint gy = ly*2 + (offs.x >> 19);\n"
+		"		BLEND_ENTRY offs = ((__global BLEND_ENTRY *)pG_buf)[grp_id];\n"
+		"		uint camera_id = BLEND_CAM(offs); uint gx = (lx<<3) + BLEND_X(offs); uint gy = ly*2 + BLEND_Y(offs);\n"
 		"	    bool outputValid = (lx*8 <= (offs.y & 0xFF)) && (ly*2 <= ((offs.y >> 8) & 0xFF));\n"
 		"		int border = (offs.y >> 30) & 0x3;\n"
 		"		int height1 = %d;\n"
@@ -1608,6 +1984,7 @@ static vx_status VX_CALLBACK upscale_gaussian_add_opencl_codegen(
 		"       }\n"
 		"	}\n"
 		"}\n";
+	opencl_kernel_code = GetBlendValidEntryOpenCLMacros(wg_itemsize == sizeof(StitchBlendValidWideEntry)) + opencl_kernel_code;
 	return VX_SUCCESS;
 }
 
@@ -1742,7 +2119,7 @@ static vx_status VX_CALLBACK laplacian_reconstruct_input_validator(vx_node node,
 	{ // array object for offsets
 		vx_size itemsize = 0;
 		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
-		if (itemsize == sizeof(StitchBlendValidEntry)) {
+		if (itemsize == sizeof(StitchBlendValidEntry) || itemsize == sizeof(StitchBlendValidWideEntry)) {
 			status = VX_SUCCESS;
 		}
 		else {
@@ -1793,14 +2170,44 @@ static vx_status VX_CALLBACK laplacian_reconstruct_query_target_support(vx_graph
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = PyramidTargetAffinity(graph);
 	return VX_SUCCESS;
 }
 
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK laplacian_reconstruct_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_IMPLEMENTED;
+	vx_uint32 numCam = 0, arr_offset = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &numCam));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[1], &arr_offset));
+	std::vector<StitchBlendTile> tiles;
+	ERROR_CHECK_STATUS(GetBlendWorkList((vx_array)parameters[4], arr_offset, tiles));
+	PyramidImageCPU src, src1, dst;
+	ERROR_CHECK_STATUS(PyramidImageAccess(src, parameters[2], numCam, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(PyramidImageAccess(src1, parameters[3], numCam, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(PyramidImageAccess(dst, parameters[5], numCam, VX_WRITE_ONLY));
+	// output = (L(0) + upscale(R(1))) / 16 with alpha = 255
+	const __m128 scale = _mm_set1_ps(0.0625f), alpha = _mm_set1_ps(255.0f);
+#pragma omp parallel for
+	for (int t = 0; t < (int)tiles.size(); t++) {
+		const StitchBlendTile& tile = tiles[t];
+		vx_uint32 nx, ny;
+		if (!PyramidTileSize(tile, 8, std::min(dst.width, src.width), std::min(dst.height1, src.height1), nx, ny))
+			continue;
+		__m128 up[16][64];
+		UpscaleGaussianTile(tile, nx, ny, src1, up);
+		__m128 pix[64];
+		for (vx_uint32 y = 0; y < ny; y++) {
+			PyramidLoadPixels(pix, PyramidImageRow(src, tile.camId, tile.dstY + y), tile.dstX, nx, src.format);
+			for (vx_uint32 x = 0; x < nx; x++)
+				pix[x] = _mm_blend_ps(_mm_mul_ps(_mm_add_ps(pix[x], up[y][x]), scale), alpha, 8);
+			PyramidStorePixels(PyramidImageRow(dst, tile.camId, tile.dstY + y), tile.dstX, nx, dst.format, pix);
+		}
+	}
+	ERROR_CHECK_STATUS(PyramidImageCommit(src));
+	ERROR_CHECK_STATUS(PyramidImageCommit(src1));
+	ERROR_CHECK_STATUS(PyramidImageCommit(dst));
+	return VX_SUCCESS;
 }
 
 //! \brief The OpenCL code generator callback.
@@ -1834,8 +2241,10 @@ static vx_status VX_CALLBACK laplacian_reconstruct_opencl_codegen(
 	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
 	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_FORMAT, &out_format, sizeof(out_format)));
 	ERROR_CHECK_STATUS(vxReleaseImage(&image));
+	vx_size wg_itemsize = 0;
 	vx_array wg_offsets = (vx_array)avxGetNodeParamRef(node, 4);
 	ERROR_CHECK_STATUS(vxQueryArray(wg_offsets, VX_ARRAY_ATTRIBUTE_CAPACITY, &wg_num, sizeof(wg_num)));
+	ERROR_CHECK_STATUS(vxQueryArray(wg_offsets, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &wg_itemsize, sizeof(wg_itemsize)));
 	ERROR_CHECK_STATUS(vxReleaseArray(&wg_offsets));
 	// set kernel configuration
 	strcpy(opencl_kernel_function_name, "laplacian_reconstruct");
@@ -1865,13 +2274,14 @@ static vx_status VX_CALLBACK laplacian_reconstruct_opencl_codegen(
 		"   uint op_width, uint op_height, __global uchar * op_buf, uint op_stride, uint op_offset)\n"
 		"{\n"
 		"	int grp_id = get_global_id(0)>>3, lx = get_local_id(0), ly = get_global_id(1);\n"
-		"	pG_buf += (pG_offs + (arr_offs<<3));\n"
+		"	pG_buf += (pG_offs + (arr_offs<<BLEND_ENTRY_SHIFT));\n"
 		"	if (grp_id < pG_num) {\n"
 		"		int size_x = get_local_size(0) - 1; \n"
-		"		uint2 offs = ((__global uint2 *)pG_buf)[grp_id];\n"
-		"		uint camera_id = offs.x & 0x1f; uint gx = (lx<<3) + ((offs.x >> 5) & 0x3FFF); uint gy = ly*2 + (offs.x >> 19);\n"
+		"		BLEND_ENTRY offs = ((__global BLEND_ENTRY *)pG_buf)[grp_id];\n"
+		"		uint camera_id = BLEND_CAM(offs); uint gx = (lx<<3) + BLEND_X(offs); uint gy = ly*2 + BLEND_Y(offs);\n"
 		"	    bool outputValid = (lx*8 <= (offs.y & 0xFF)) && (ly*2 <= ((offs.y >> 8) & 0xFF));\n"
 		"		int border = (offs.y >> 30) & 0x3;\n"
+		"		bool copy_tile = (offs.y >> 29) & 0x1;\n"
 		"		int height1 = %d;\n"
 		"		ip_buf += ip_offset + mad24(gy, ip_stride, gx*6);\n"
 		"		op_buf  += op_offset + mad24(gy, op_stride, gx*4);\n"
@@ -1888,7 +2298,10 @@ static vx_status VX_CALLBACK laplacian_reconstruct_opencl_codegen(
 		"		__local float lsVert[64*6*3];\n"
 		"		int loffset = mad24(ly, (int)104, lx*12); \n"
 		"		int2 loffs2  = (int2)((loffset + 416), 4*ip1_stride);\n"
-		"		if (!border){\n"
+		"		if (copy_tile) {\n"
+		"			// tile away from seams: no upscale term\n"
+		"		}\n"
+		"		else if (!border){\n"
 		"			ip1_buf += mad24(gy>>1, ip1_stride, gx*3);\n"
 		"			ip1_buf -= (ip1_stride + 8);\n"
 		"			*(__local uint4 *)(lsSrc+loffset) = vload4(0, (global uint *)ip1_buf);\n"
@@ -1983,6 +2396,7 @@ static vx_status VX_CALLBACK laplacian_reconstruct_opencl_codegen(
 		"       row1_8 = mad(filtpix_8, (float8)(4.0f), row1_8); row1_4 = mad(filtpix_4, (float4)(4.0f), row1_4);\n"
 		"       row0_8 *= (float8)0.015625f; row0_4 *= (float4)0.015625f;\n"
 		"       row1_8 *= (float8)0.015625f; row1_4 *= (float4)0.015625f;\n"
+		"       if (copy_tile) { row0_8 = row1_8 = (float8)0.0f; row0_4 = row1_4 = (float4)0.0f; }\n"
 		"       filtpix_8 = convert_float8(*(__global short8 *)(ip_buf)); filtpix_4 = convert_float4(*(__global short4 *)(ip_buf + 16));\n"
 		"       row0_8 += filtpix_8; row0_4 += filtpix_4;\n"
 		"       row0_8 *= (float8)0.0625f; row0_4 *= (float4)0.0625f;\n"
@@ -2006,6 +2420,7 @@ static vx_status VX_CALLBACK laplacian_reconstruct_opencl_codegen(
 		"       row1_8 = mad(filtpix_8, (float8)(4.0f), row1_8); row1_4 = mad(filtpix_4, (float4)(4.0f), row1_4);\n"
 		"       row0_8 *= (float8)0.015625f; row0_4 *= (float4)0.015625f;\n"
 		"       row1_8 *= (float8)0.015625f; row1_4 *= (float4)0.015625f;\n"
+		"       if (copy_tile) { row0_8 = row1_8 = (float8)0.0f; row0_4 = row1_4 = (float4)0.0f; }\n"
 		"       filtpix_8 = convert_float8(*(__global short8 *)(ip_buf + 24)); filtpix_4 = convert_float4(*(__global short4 *)(ip_buf + 40));\n"
 		"       row0_8 += filtpix_8; row0_4 += filtpix_4;\n"
 		"       row0_8 *= (float8)0.0625f; row0_4 *= (float4)0.0625f;\n"
@@ -2021,6 +2436,7 @@ static vx_status VX_CALLBACK laplacian_reconstruct_opencl_codegen(
 		"       }\n"
 		"	}\n"
 		"}\n";
+	opencl_kernel_code = GetBlendValidEntryOpenCLMacros(wg_itemsize == sizeof(StitchBlendValidWideEntry)) + opencl_kernel_code;
 	return VX_SUCCESS;
 }
 
@@ -33,4 +33,7 @@ vx_status upscale_gaussian_subtract_publish(vx_context context);
 vx_status upscale_gaussian_add_publish(vx_context context);
 vx_status laplacian_reconstruct_publish(vx_context context);
 
+//! \brief The target affinity of multiband kernels: CPU with MULTIBAND_CPU environment variable or host execution, GPU otherwise.
+vx_uint32 PyramidTargetAffinity(vx_graph graph);
+
 #endif //__PYRAMID_SCALE_H__
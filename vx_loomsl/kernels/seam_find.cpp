@@ -63,6 +63,30 @@ int64_t stitchGetClockFrequency()
 }
 #endif //GET_TIMING
 
+//! \brief The validator of the optional camera plane array of row packed seamfind images.
+static vx_status ValidateCameraPlaneArray(vx_node node, vx_reference ref)
+{
+	vx_size itemsize = 0;
+	ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
+	ERROR_CHECK_STATUS(vxReleaseArray((vx_array *)&ref));
+	if (itemsize != sizeof(StitchCameraPlaneEntry)) {
+		vxAddLogEntry((vx_reference)node, VX_ERROR_INVALID_DIMENSION, "ERROR: SeamFind array element (StitchCameraPlaneEntry) size should be 16 bytes\n");
+		return VX_ERROR_INVALID_DIMENSION;
+	}
+	return VX_SUCCESS;
+}
+
+//! \brief The camera plane rows of seamfind images: number of cameras from the optional camera plane array,
+//  otherwise the image has full camera planes of height1 rows.
+static vx_status SeamFindCameraPlaneRows(vx_reference cameraPlaneArray, vx_uint32 imageHeight, vx_uint32 height1, std::vector<vx_int32>& camRow)
+{
+	vx_size numCamera = height1 ? imageHeight / height1 : 0;
+	if (cameraPlaneArray) {
+		ERROR_CHECK_STATUS(vxQueryArray((vx_array)cameraPlaneArray, VX_ARRAY_ATTRIBUTE_NUMITEMS, &numCamera, sizeof(numCamera)));
+	}
+	return GetCameraPlaneRows((vx_array)cameraPlaneArray, (vx_uint32)numCamera, height1, camRow);
+}
+
 /***********************************************************************************************************************************
 												Seam Find CPU Model
 ***********************************************************************************************************************************/
@@ -685,6 +709,10 @@ static vx_status VX_CALLBACK seamfind_scene_detect_input_validator(vx_node node,
 		}
 		ERROR_CHECK_STATUS(vxReleaseArray((vx_array *)&ref));
 	}
+	else if (index == 6)
+	{ // optional array object of StitchCameraPlaneEntry type
+		status = ValidateCameraPlaneArray(node, ref);
+	}
 	return status;
 }
 
@@ -744,7 +772,7 @@ static vx_status VX_CALLBACK seamfind_scene_detect_query_target_support(vx_graph
 	int SEAM_FIND_TARGET = 0;
 	if (StitchGetEnvironmentVariable("SEAM_FIND_TARGET", textBuffer, sizeof(textBuffer))) { SEAM_FIND_TARGET = atoi(textBuffer); }
 
-	if (!SEAM_FIND_TARGET)
+	if (!SEAM_FIND_TARGET && !StitchIsHostExecution(graph))
 		supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
 	else
 		supported_target_affinity = AGO_TARGET_AFFINITY_CPU;
@@ -813,6 +841,7 @@ static vx_status VX_CALLBACK seamfind_scene_detect_opencl_codegen(
 	// kernel header and reading
 	char item[8192];
 	sprintf(item,
+		"%s"
 		"#pragma OPENCL EXTENSION cl_amd_media_ops : enable\n"
 		"#pragma OPENCL EXTENSION cl_amd_media_ops2 : enable\n"
 		"\n"
@@ -822,8 +851,8 @@ static vx_status VX_CALLBACK seamfind_scene_detect_opencl_codegen(
 		"						uint ip_cost_width, uint ip_cost_height, __global uchar * ip_cost_buf, uint ip_cost_stride, uint ip_cost_offset,\n"
 		"						__global char * seam_info_buf, uint seam_info_buf_offset, uint seam_info_num_items,\n"
 		"						__global char * seam_pref_buf, uint seam_pref_buf_offset, uint seam_pref_num_items,\n"
-		"						__global char * seam_scene_buf, uint seam_scene_buf_offset, uint seam_scene_num_items)\n"
-		, (int)opencl_local_work[0], opencl_kernel_function_name);
+		"						__global char * seam_scene_buf, uint seam_scene_buf_offset, uint seam_scene_num_items%s)\n"
+		, GetCameraPlaneOpenCLMacros(parameters[6] != nullptr, "equi_height").c_str(), (int)opencl_local_work[0], opencl_kernel_function_name, GetCameraPlaneOpenCLArgs(parameters[6] != nullptr));
 	opencl_kernel_code = item;
 	opencl_kernel_code +=
 		"{\n"
@@ -843,8 +872,8 @@ static vx_status VX_CALLBACK seamfind_scene_detect_opencl_codegen(
 		"		short8 info, pref;\n"
 		"		info = vload8(0, (__global short *)seam_info_buf);\n"
 		"		pref = vload8(0, (__global short *)&seam_pref_buf[gid * 16]);\n"
-		"		uint offset_1 = (info.s0 * equi_height);\n"
-		"		uint offset_2 = (info.s1 * equi_height);\n"
+		"		int offset_1 = CAM_ROW(info.s0);\n"
+		"		int offset_2 = CAM_ROW(info.s1);\n"
 		"		uint x_dir = (info.s3 - info.s2);\n"
 		"		uint y_dir = (info.s5 - info.s4);\n"
 		"		uint thresholdDefaultPercentage = 25;\n" // default if no threshold passed
@@ -858,7 +887,7 @@ static vx_status VX_CALLBACK seamfind_scene_detect_opencl_codegen(
 		"			{\n"
 #if ENABLE_VERTICAL_SEAM
 		"\n"
-		"				if (pref.s7 != 0)\n"
+		"				if (pref.s7 != 0 && pref.s3 != 0)\n"
 		"				{\n"
 		"\n"
 		"					pref.s6 --;\n"
@@ -879,7 +908,7 @@ static vx_status VX_CALLBACK seamfind_scene_detect_opencl_codegen(
 		"				uint valid_pixel = 0;\n"
 		"				uint changed_valid_pixel = 0;\n"
 		"\n"
-		"				if (pref.s7 == 0)\n"
+		"				if (pref.s7 == 0 || pref.s3 == 0)\n"
 		"				{\n"
 		"					for (uint f = 0; f < 8; f++)\n"
 		"					{\n"
@@ -914,7 +943,11 @@ static vx_status VX_CALLBACK seamfind_scene_detect_opencl_codegen(
 		"\n"
 		"					threshold_scene_vert = (uint)(thresholdDefaultPercentage * valid_pixel * 0.01);\n"
 		"\n"
-		"					if(changed_valid_pixel > threshold_scene_vert && current_frame != 0 )\n"
+		"					if(changed_valid_pixel > threshold_scene_vert && current_frame != 0 && pref.s3 == 0)\n"
+		"					{\n" // event driven: pending change magnitude for analyze kernel
+		"						pref.s6 = max(pref.s6, (short)clamp((changed_valid_pixel * 100) / valid_pixel, (uint)1, (uint)100));\n"
+		"					}\n"
+		"					else if(changed_valid_pixel > threshold_scene_vert && current_frame != 0 )\n"
 		"					{\n"
 		"						pref.s2 = current_frame;\n"
 		"						pref.s6 = 1800;\n"
@@ -950,7 +983,7 @@ static vx_status VX_CALLBACK seamfind_scene_detect_opencl_codegen(
 		"			{\n"
 #if ENABLE_HORIZONTAL_SEAM
 		"\n"
-		"				if (pref.s7 != 0)\n"
+		"				if (pref.s7 != 0 && pref.s3 != 0)\n"
 		"				{\n"
 		"\n"
 		"					pref.s6 --;\n"
@@ -971,7 +1004,7 @@ static vx_status VX_CALLBACK seamfind_scene_detect_opencl_codegen(
 		"				uint valid_pixel = 0;\n"
 		"				uint changed_valid_pixel = 0;\n"
 		"\n"
-		"				if (pref.s7 == 0)\n"
+		"				if (pref.s7 == 0 || pref.s3 == 0)\n"
 		"				{\n"
 		"					for (uint f = 0; f < 8; f++)\n"
 		"					{\n"
@@ -1006,7 +1039,11 @@ static vx_status VX_CALLBACK seamfind_scene_detect_opencl_codegen(
 		"\n"
 		"					threshold_scene_hort = (uint)(thresholdDefaultPercentage * valid_pixel * 0.01);\n"
 		"\n"
-		"					if(changed_valid_pixel > threshold_scene_hort && current_frame != 0 )\n"
+		"					if(changed_valid_pixel > threshold_scene_hort && current_frame != 0 && pref.s3 == 0)\n"
+		"					{\n" // event driven: pending change magnitude for analyze kernel
+		"						pref.s6 = max(pref.s6, (short)clamp((changed_valid_pixel * 100) / valid_pixel, (uint)1, (uint)100));\n"
+		"					}\n"
+		"					else if(changed_valid_pixel > threshold_scene_hort && current_frame != 0 )\n"
 		"					{\n"
 		"						pref.s2 = current_frame;\n"
 		"						pref.s6 = 1800;\n"
@@ -1043,6 +1080,12 @@ static vx_status VX_CALLBACK seamfind_scene_detect_opencl_codegen(
 	return VX_SUCCESS;
 }
 
+//! \brief The scene change magnitude in percentage (1 - 100) for event driven seam refresh.
+static inline vx_int16 SeamChangeMagnitude(vx_uint32 change, vx_uint32 total)
+{
+	return (vx_int16)std::min(std::max((change * 100) / total, 1u), 100u);
+}
+
 //! \brief The kernel execution on the CPU.
 static vx_status VX_CALLBACK seamfind_scene_detect_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
@@ -1062,6 +1105,8 @@ static vx_status VX_CALLBACK seamfind_scene_detect_kernel(vx_node node, const vx
 	vx_uint8 *input_ptr = (vx_uint8*)input_image_ptr;
 	width_eqr = input_width;
 	height_eqr = (width_eqr >> 1);
+	std::vector<vx_int32> camRow;
+	ERROR_CHECK_STATUS(SeamFindCameraPlaneRows(parameters[6], input_height, height_eqr, camRow));
 
 	//SeamFindInfo Array - Variable 3
 	vx_size arr_numitems = 0;
@@ -1101,8 +1146,8 @@ static vx_status VX_CALLBACK seamfind_scene_detect_kernel(vx_node node, const vx
 	//Loop over all the overlap camera once
 	for (vx_uint32 i = 0; i < arr_numitems; i++)
 	{
-		vx_uint32 offset_1 = SeamFindInfo_ptr[i].cam_id_1 * height_eqr;
-		vx_uint32 offset_2 = SeamFindInfo_ptr[i].cam_id_2 * height_eqr;
+		vx_int32 offset_1 = camRow[SeamFindInfo_ptr[i].cam_id_1];
+		vx_int32 offset_2 = camRow[SeamFindInfo_ptr[i].cam_id_2];
 		int y_dir = SeamFindInfo_ptr[i].end_y - SeamFindInfo_ptr[i].start_y;
 		int x_dir = SeamFindInfo_ptr[i].end_x - SeamFindInfo_ptr[i].start_x;
 		/***********************************************************************************************************************************
@@ -1112,7 +1157,7 @@ static vx_status VX_CALLBACK seamfind_scene_detect_kernel(vx_node node, const vx
 		{
 #if	ENABLE_VERTICAL_SEAM
 			//count down previous scene change
-			if (Seam_Pref[i].scene_flag != 0)
+			if (Seam_Pref[i].scene_flag != 0 && Seam_Pref[i].frequency != 0)
 			{
 				Seam_Pref[i].seam_lock--;
 				if (Seam_Pref[i].seam_lock == 0)
@@ -1163,7 +1208,12 @@ static vx_status VX_CALLBACK seamfind_scene_detect_kernel(vx_node node, const vx
 						Seam_Previous_scene[i].segment[f][k] = current_seam_scene[i].segment[f][k];
 					}
 				//if scene change detected, set seam to be found in the current frame
-				if (SAD > SEAM_THRESHOLD && Seam_Pref[i].scene_flag == 0)
+				if (SAD > SEAM_THRESHOLD && Seam_Pref[i].frequency == 0)
+				{
+					// event driven: pending change magnitude for analyze kernel
+					Seam_Pref[i].seam_lock = std::max(Seam_Pref[i].seam_lock, SeamChangeMagnitude(SAD, MAX_SEGMENTS * MAX_SEAM_BYTES * 255));
+				}
+				else if (SAD > SEAM_THRESHOLD && Seam_Pref[i].scene_flag == 0)
 				{
 					Seam_Pref[i].start_frame = current_frame;
 					Seam_Pref[i].scene_flag = 1;
@@ -1181,7 +1231,7 @@ static vx_status VX_CALLBACK seamfind_scene_detect_kernel(vx_node node, const vx
 		{
 #if ENABLE_HORIZONTAL_SEAM
 			//count down previous scene change
-			if (Seam_Pref[i].scene_flag != 0)
+			if (Seam_Pref[i].scene_flag != 0 && Seam_Pref[i].frequency != 0)
 			{
 				Seam_Pref[i].seam_lock--;
 				if (Seam_Pref[i].seam_lock == 0)
@@ -1232,7 +1282,12 @@ static vx_status VX_CALLBACK seamfind_scene_detect_kernel(vx_node node, const vx
 						Seam_Previous_scene[i].segment[f][k] = current_seam_scene[i].segment[f][k];
 					}
 				//if scene change detected, set seam to be found in the current frame
-				if (SAD > SEAM_THRESHOLD && Seam_Pref[i].scene_flag == 0)
+				if (SAD > SEAM_THRESHOLD && Seam_Pref[i].frequency == 0)
+				{
+					// event driven: pending change magnitude for analyze kernel
+					Seam_Pref[i].seam_lock = std::max(Seam_Pref[i].seam_lock, SeamChangeMagnitude(SAD, MAX_SEGMENTS * MAX_SEAM_BYTES * 255));
+				}
+				else if (SAD > SEAM_THRESHOLD && Seam_Pref[i].scene_flag == 0)
 				{
 					Seam_Pref[i].start_frame = current_frame;
 					Seam_Pref[i].scene_flag = 1;
@@ -1263,7 +1318,7 @@ vx_status seamfind_scene_detect_publish(vx_context context)
 	vx_kernel kernel = vxAddKernel(context, "com.amd.loomsl.seamfind_scene_detect",
 		AMDOVX_KERNEL_STITCHING_SEAMFIND_SCENE_DETECT,
 		seamfind_scene_detect_kernel,
-		6,
+		7,
 		seamfind_scene_detect_input_validator,
 		seamfind_scene_detect_output_validator,
 		nullptr,
@@ -1283,6 +1338,7 @@ vx_status seamfind_scene_detect_publish(vx_context context)
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 3, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 4, VX_OUTPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 5, VX_OUTPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 6, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_OPTIONAL));
 
 	// finalize and release kernel object
 	ERROR_CHECK_STATUS(vxFinalizeKernel(kernel));
@@ -1380,7 +1436,7 @@ static vx_status VX_CALLBACK seamfind_cost_generate_query_target_support(vx_grap
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = StitchIsHostExecution(graph) ? AGO_TARGET_AFFINITY_CPU : AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -1532,7 +1588,58 @@ static vx_status VX_CALLBACK seamfind_cost_generate_opencl_codegen(
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK seamfind_cost_generate_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_SUPPORTED;
+	//Seam Find Flag - Variable 0
+	vx_uint32 flag = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &flag));
+	if (!flag)
+		return VX_SUCCESS;
+
+	//Input image - Variable 1
+	vx_image input_image = (vx_image)parameters[1];
+	vx_uint32 width = 0, height = 0, plane = 0;
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	vx_rectangle_t rect; rect.start_x = rect.start_y = 0; rect.end_x = width; rect.end_y = height;
+	void *input_image_ptr = nullptr; vx_imagepatch_addressing_t input_addr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(input_image, &rect, plane, &input_addr, &input_image_ptr, VX_READ_ONLY));
+
+	//Output magnitude & phase images - Variable 2 & 3
+	vx_image mag_image = (vx_image)parameters[2];
+	vx_image phase_image = (vx_image)parameters[3];
+	void *mag_image_ptr = nullptr, *phase_image_ptr = nullptr; vx_imagepatch_addressing_t mag_addr, phase_addr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(mag_image, &rect, plane, &mag_addr, &mag_image_ptr, VX_WRITE_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(phase_image, &rect, plane, &phase_addr, &phase_image_ptr, VX_WRITE_ONLY));
+
+	//Sobel 3x3 with replicated border: magnitude |Gx|+|Gy| and phase quantized to 8 directions in the top 3 bits
+	const float T1 = 0.4142135623730950488016887242097f, T2 = 2.4142135623730950488016887242097f;
+#pragma omp parallel for
+	for (int y = 0; y < (int)height; y++)
+	{
+		const vx_uint8 *r0 = (const vx_uint8 *)input_image_ptr + (y > 0 ? y - 1 : 0) * input_addr.stride_y;
+		const vx_uint8 *r1 = (const vx_uint8 *)input_image_ptr + y * input_addr.stride_y;
+		const vx_uint8 *r2 = (const vx_uint8 *)input_image_ptr + (y < (int)height - 1 ? y + 1 : y) * input_addr.stride_y;
+		vx_uint8 *mag = (vx_uint8 *)mag_image_ptr + y * mag_addr.stride_y;
+		vx_uint8 *phase = (vx_uint8 *)phase_image_ptr + y * phase_addr.stride_y;
+		for (int x = 0; x < (int)width; x++)
+		{
+			int xl = x > 0 ? x - 1 : 0, xr = x < (int)width - 1 ? x + 1 : x;
+			int Gx = (r0[xr] - r0[xl]) + 2 * (r1[xr] - r1[xl]) + (r2[xr] - r2[xl]);
+			int Gy = (r2[xl] - r0[xl]) + 2 * (r2[x] - r0[x]) + (r2[xr] - r0[xr]);
+			int quad = (Gx < 0) ? ((Gy < 0) ? 2 : 1) : ((Gy < 0) ? 3 : 0);
+			float ax = (float)abs(Gx), ay = (float)abs(Gy);
+			int t = (ay < T1 * ax) ? 0 : ((ay < T2 * ax) ? 1 : 2);
+			t += 2 * quad;
+			if (t > 7) t = 0;
+			mag[x] = (vx_uint8)std::min(abs(Gx) + abs(Gy), 255);
+			phase[x] = (vx_uint8)(t << 5);
+		}
+	}
+
+	ERROR_CHECK_STATUS(vxCommitImagePatch(input_image, &rect, plane, &input_addr, input_image_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(mag_image, &rect, plane, &mag_addr, mag_image_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(phase_image, &rect, plane, &phase_addr, phase_image_ptr));
+
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel publisher.
@@ -1581,7 +1688,7 @@ static vx_status VX_CALLBACK seamfind_cost_accumulate_input_validator(vx_node no
 	vx_reference ref = avxGetNodeParamRef(node, index);
 	ERROR_CHECK_OBJECT(ref);
 	// validate each parameter
-	if (index == 0 || index == 1 || index == 2)
+	if (index == 0 || index == 1 || index == 2 || index == 10)
 	{ // object of SCALAR type
 		vx_enum itemtype = VX_TYPE_INVALID;
 		ERROR_CHECK_STATUS(vxQueryScalar((vx_scalar)ref, VX_SCALAR_ATTRIBUTE_TYPE, &itemtype, sizeof(itemtype)));
@@ -1686,6 +1793,10 @@ static vx_status VX_CALLBACK seamfind_cost_accumulate_input_validator(vx_node no
 		}
 		ERROR_CHECK_STATUS(vxReleaseArray((vx_array *)&ref));
 	}
+	else if (index == 11)
+	{ // optional array object of StitchCameraPlaneEntry type
+		status = ValidateCameraPlaneArray(node, ref);
+	}
 
 	return status;
 }
@@ -1723,7 +1834,14 @@ static vx_status VX_CALLBACK seamfind_cost_accumulate_query_target_support(vx_gr
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	char textBuffer[256];
+	int SEAM_FIND_TARGET = 0;
+	if (StitchGetEnvironmentVariable("SEAM_FIND_TARGET", textBuffer, sizeof(textBuffer))) { SEAM_FIND_TARGET = atoi(textBuffer); }
+
+	if (!SEAM_FIND_TARGET && !StitchIsHostExecution(graph))
+		supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	else
+		supported_target_affinity = AGO_TARGET_AFFINITY_CPU;
 	return VX_SUCCESS;
 }
 
@@ -1737,13 +1855,273 @@ static vx_status VX_CALLBACK seamfind_cost_accumulate_opencl_global_work_update(
 	const vx_size opencl_local_work[]              // [input] local_work[] for clEnqueueNDRangeKernel()
 	)
 {
+	// coarse-to-fine path search runs a work group per overlap, otherwise a work item per valid entry
+	vx_uint32 coarse_scale = 0;
+	if (parameters[10]) {
+		ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[10], &coarse_scale));
+	}
+
 	// Get the number of elements in the array
 	vx_size arr_numitems = 0;
-	vx_array arr = (vx_array)avxGetNodeParamRef(node, 6);				// input array
+	vx_array arr = (vx_array)avxGetNodeParamRef(node, coarse_scale > 1 ? 8 : 6);	// input array
 	ERROR_CHECK_OBJECT(arr);
 	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &arr_numitems, sizeof(arr_numitems)));
 	ERROR_CHECK_STATUS(vxReleaseArray(&arr));
-	opencl_global_work[0] = (arr_numitems + opencl_local_work[0] - 1) & ~(opencl_local_work[0] - 1);
+	if (coarse_scale > 1)
+		opencl_global_work[0] = arr_numitems * opencl_local_work[0];
+	else
+		opencl_global_work[0] = (arr_numitems + opencl_local_work[0] - 1) & ~(opencl_local_work[0] - 1);
+
+	return VX_SUCCESS;
+}
+
+//! \brief The OpenCL code generator of the coarse-to-fine path search: a work group per overlap.
+//  The coarse path search on the scale x scale downsampled cost grid keeps its accumulated costs in the accum buffer of the
+//  overlap and its path in local memory, then the full resolution search runs row by row in the corridor around the coarse path.
+//  Cost, edge-bonus, parent-selection and corridor rules are the same as SeamFindCoarseCorridor and SeamFindAccumulateOverlap.
+static vx_status seamfind_cost_accumulate_coarse_opencl_codegen(vx_node node, const vx_reference parameters[], vx_uint32 coarse_scale,
+	int COST_SELECT, int SEAM_QUALITY, char opencl_kernel_function_name[64], std::string& opencl_kernel_code,
+	vx_uint32& opencl_work_dim, vx_size opencl_global_work[], vx_size opencl_local_work[])
+{
+	vx_uint32 width_eqr = 0, height_eqr = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[1], &width_eqr));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[2], &height_eqr));
+	vx_size arr_capacity = 0;
+	vx_array arr = (vx_array)avxGetNodeParamRef(node, 8); // overlap info array
+	ERROR_CHECK_OBJECT(arr);
+	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_CAPACITY, &arr_capacity, sizeof(arr_capacity)));
+	ERROR_CHECK_STATUS(vxReleaseArray(&arr));
+
+	// set kernel configuration
+	vx_uint32 max_coarse_steps = (std::max(width_eqr, height_eqr) + coarse_scale - 1) / coarse_scale;
+	strcpy(opencl_kernel_function_name, "seamfind_cost_accumulate");
+	opencl_work_dim = 1;
+	opencl_local_work[0] = 64;
+	opencl_global_work[0] = arr_capacity * opencl_local_work[0];
+
+	// edge bonus thresholds of the vertical and horizontal seams
+	int threshold_v = 0, threshold_h = 0, winner_v = 0x7FFFFFFF, winner_h = 0x7FFFFFFF;
+	if (SEAM_QUALITY == 1) { threshold_v = 75; threshold_h = 64; winner_v = winner_h = 225; }
+	else if (SEAM_QUALITY == 2) { threshold_v = threshold_h = 128; winner_v = 225; winner_h = 200; }
+
+	char item[8192];
+	sprintf(item,
+		"%s"							// CAM_ROW
+		"#define LOCAL_SIZE %d\n"		// opencl_local_work[0]
+		"#define MAX_COARSE_STEPS %d\n"	// max_coarse_steps
+		"#define COST_SELECT %d\n"		// COST_SELECT
+		"#define SEAM_QUALITY %d\n"		// SEAM_QUALITY
+		"#define ENABLE_VERTICAL_SEAM %d\n"
+		"#define ENABLE_HORIZONTAL_SEAM %d\n"
+		"#define INVALID_COST 0x7F00FFFF\n"
+		"#define MAX_VALUE 0x7FFFFFFF\n"
+		"#define SX(t,l) (vertical ? start_x + (l) : start_x + (t))\n"
+		"#define SY(t,l) (vertical ? start_y + (t) : start_y + (l))\n"
+		"\n"
+		"bool seam_valid(__global uchar * mask, uint mask_stride, int x, int y, int offset_1, int offset_2)\n"
+		"{\n"
+		"	return mask[(y + offset_1) * mask_stride + x] && mask[(y + offset_2) * mask_stride + x];\n"
+		"}\n"
+		"\n"
+		"int seam_pixel_cost(__global uchar * cost, uint cost_stride, __global uchar * mask, uint mask_stride, int x, int y, int offset_1, int offset_2, int vertical)\n"
+		"{\n"
+		"	if (!seam_valid(mask, mask_stride, x, y, offset_1, offset_2))\n"
+		"		return INVALID_COST;\n"
+		"	int cost_img = cost[(y + offset_1) * cost_stride + x];\n"
+		"	if (COST_SELECT && vertical)\n"
+		"		cost_img = (cost_img + cost[(y + offset_2) * cost_stride + x]) / 2;\n"
+		"	return cost_img;\n"
+		"}\n"
+		"\n"
+		"int seam_edge_bonus(__global uchar * cost, uint cost_stride, __global uchar * phase, uint phase_stride, uint equi_width, uint equi_height, int x, int y, int offset_1, int vertical)\n"
+		"{\n"
+		"	int threshold = vertical ? %d : %d, winner_threshold = vertical ? %d : %d;\n"	// threshold_v, threshold_h, winner_v, winner_h
+		"	int phase_a = vertical ? 0 : 2, phase_b = vertical ? 4 : 6;\n"
+		"	int BONUS = 0;\n"
+		"	if (SEAM_QUALITY == 1 || SEAM_QUALITY == 2) {\n"
+		"		for (int side = -1; side <= 1; side += 2) {\n"
+		"			int sx = vertical ? x + side : x, sy = vertical ? y : y + side;\n"
+		"			if (sx < 0 || sx >= (int)equi_width || sy < 0 || sy >= (int)equi_height)\n"
+		"				continue;\n"
+		"			int magnitude_img = cost[(sy + offset_1) * cost_stride + sx];\n"
+		"			int phase_img = phase[(sy + offset_1) * phase_stride + sx] >> 5;\n"
+		"			if (magnitude_img > threshold && (phase_img == phase_a || phase_img == phase_b))\n"
+		"				BONUS += magnitude_img + (magnitude_img > winner_threshold ? 50 : 0);\n"
+		"		}\n"
+		"	}\n"
+		"	return BONUS;\n"
+		"}\n"
+		"\n"
+		"int2 seam_corridor(__local short * path, int path_found, int t, int scale, int Tc, int lateral)\n"
+		"{\n"
+		"	if (!path_found)\n"
+		"		return (int2)(0, lateral - 1);\n"
+		"	int tc = t / scale;\n"
+		"	int cmin = path[tc], cmax = path[tc];\n"
+		"	if (tc > 0) { cmin = min(cmin, (int)path[tc - 1]); cmax = max(cmax, (int)path[tc - 1]); }\n"
+		"	if (tc + 1 < Tc) { cmin = min(cmin, (int)path[tc + 1]); cmax = max(cmax, (int)path[tc + 1]); }\n"
+		"	return (int2)(max(0, (cmin - 1) * scale), min(lateral - 1, (cmax + 2) * scale - 1));\n"
+		"}\n"
+		"\n"
+		"__kernel __attribute__((reqd_work_group_size(LOCAL_SIZE, 1, 1)))\n"
+		"void %s(uint current_frame, uint equi_width, uint equi_height,\n"	// opencl_kernel_function_name
+		"						uint ip_cost_width, uint ip_cost_height, __global uchar * ip_cost_buf, uint ip_cost_stride, uint ip_cost_offset,\n"
+		"						uint ip_phase_width, uint ip_phase_height, __global uchar * ip_phase_buf, uint ip_phase_stride, uint ip_phase_offset,\n"
+		"						uint ip_mask_width, uint ip_mask_height, __global uchar * ip_mask_buf, uint ip_mask_stride, uint ip_mask_offset,\n"
+		"						__global char * seam_valid_buf, uint seam_valid_buf_offset, uint valid_pix_num_items,\n"
+		"						__global char * seam_pref_buf, uint seam_pref_buf_offset, uint seam_pref_num_items,\n"
+		"						__global char * seam_info_buf, uint seam_info_buf_offset, uint seam_info_num_items,\n"
+		"						__global char * seam_accum_buf, uint seam_accum_buf_offset, uint seam_num_items, uint coarse_scale%s)\n"
+		, GetCameraPlaneOpenCLMacros(parameters[11] != nullptr, "equi_height").c_str(), (int)opencl_local_work[0], max_coarse_steps, COST_SELECT, SEAM_QUALITY, ENABLE_VERTICAL_SEAM, ENABLE_HORIZONTAL_SEAM,
+		threshold_v, threshold_h, winner_v, winner_h, opencl_kernel_function_name, GetCameraPlaneOpenCLArgs(parameters[11] != nullptr));
+	opencl_kernel_code = item;
+	opencl_kernel_code +=
+		"{\n"
+		"	__local short path[MAX_COARSE_STEPS];\n"
+		"	__local int path_found;\n"
+		"	int lid = get_local_id(0);\n"
+		"	int overlap = get_group_id(0);\n"
+		"	if (overlap >= seam_info_num_items || overlap >= seam_pref_num_items)\n"
+		"		return;\n"
+		"\n"
+		"	/* the whole work group skips overlaps not scheduled for this frame */\n"
+		"	short8 pref = vload8(0, (__global short *)&seam_pref_buf[seam_pref_buf_offset + overlap * 16]);\n"
+		"	short8 info = vload8(0, (__global short *)&seam_info_buf[seam_info_buf_offset + overlap * 16]);\n"
+		"	if (pref.s5 == -1 || !((pref.s2 == (short)current_frame) || (pref.s3 > 0 && (current_frame + 1) % (pref.s3 + pref.s1) == 0)))\n"
+		"		return;\n"
+		"	int vertical = (info.s5 - info.s4) >= (info.s3 - info.s2);\n"
+		"	int lateral = vertical ? (info.s3 - info.s2) : (info.s5 - info.s4);\n"
+		"	int steps = vertical ? (info.s5 - info.s4) : (info.s3 - info.s2);\n"
+		"	uint overlap_offset = ((info.s7 << 16) & 0xFFFF0000) | (info.s6 & 0x0000FFFF);\n"
+		"	if ((vertical && !ENABLE_VERTICAL_SEAM) || (!vertical && !ENABLE_HORIZONTAL_SEAM))\n"
+		"		return;\n"
+		"	if (lateral <= 0 || steps <= 0 || overlap_offset + lateral * steps > seam_num_items)\n"
+		"		return;\n"
+		"	int start_x = info.s2, start_y = info.s4;\n"
+		"	int offset_1 = CAM_ROW(info.s0), offset_2 = CAM_ROW(info.s1);\n"
+		"	__global uchar * cost = ip_cost_buf + ip_cost_offset;\n"
+		"	__global uchar * phase = ip_phase_buf + ip_phase_offset;\n"
+		"	__global uchar * mask = ip_mask_buf + ip_mask_offset;\n"
+		"	__global int * accum = (__global int *)(seam_accum_buf + seam_accum_buf_offset) + overlap_offset * 3;\n"
+		"\n"
+		"	/* coarse path search: accumulated cost and parent direction of the coarse cells in the accum buffer */\n"
+		"	int scale = (int)coarse_scale;\n"
+		"	int Lc = (lateral + scale - 1) / scale, Tc = (steps + scale - 1) / scale;\n"
+		"	int sample = max(1, scale / 4);\n"
+		"	for (int tc = 0; tc < Tc; tc++) {\n"
+		"		for (int lc = lid; lc < Lc; lc += LOCAL_SIZE) {\n"
+		"			int sum = 0, count = 0;\n"
+		"			for (int t = tc * scale; t < min((tc + 1) * scale, steps); t += sample) {\n"
+		"				for (int l = lc * scale; l < min((lc + 1) * scale, lateral); l += sample) {\n"
+		"					int Pixel = seam_pixel_cost(cost, ip_cost_stride, mask, ip_mask_stride, SX(t, l), SY(t, l), offset_1, offset_2, vertical);\n"
+		"					if (Pixel != INVALID_COST) { sum += Pixel; count++; }\n"
+		"				}\n"
+		"			}\n"
+		"			int block_cost = count ? (sum * scale * scale + count / 2) / count : MAX_VALUE;\n"
+		"			int parent = 0, dir = 0;\n"
+		"			if (tc > 0) {\n"
+		"				__global int * prev = accum + (tc - 1) * Lc * 3;\n"
+		"				parent = prev[lc * 3 + 1];\n"
+		"				if (lc + 1 < Lc && prev[(lc + 1) * 3 + 1] < parent) { parent = prev[(lc + 1) * 3 + 1]; dir = 1; }\n"
+		"				if (lc > 0 && prev[(lc - 1) * 3 + 1] < parent) { parent = prev[(lc - 1) * 3 + 1]; dir = -1; }\n"
+		"			}\n"
+		"			accum[(tc * Lc + lc) * 3 + 1] = add_sat(parent, block_cost);\n"
+		"			accum[(tc * Lc + lc) * 3 + 2] = dir;\n"
+		"		}\n"
+		"		barrier(CLK_GLOBAL_MEM_FENCE);\n"
+		"	}\n"
+		"\n"
+		"	/* trace the least cost coarse path back from the last step */\n"
+		"	if (lid == 0) {\n"
+		"		__global int * last = accum + (Tc - 1) * Lc * 3;\n"
+		"		int lc = 0;\n"
+		"		for (int l = 1; l < Lc; l++)\n"
+		"			if (last[l * 3 + 1] < last[lc * 3 + 1]) lc = l;\n"
+		"		path_found = (Tc <= MAX_COARSE_STEPS && last[lc * 3 + 1] < MAX_VALUE) ? 1 : 0;\n"
+		"		if (path_found) {\n"
+		"			for (int tc = Tc - 1; tc >= 0; tc--) {\n"
+		"				path[tc] = (short)lc;\n"
+		"				lc += accum[(tc * Lc + lc) * 3 + 2];\n"
+		"			}\n"
+		"		}\n"
+		"	}\n"
+		"	barrier(CLK_LOCAL_MEM_FENCE | CLK_GLOBAL_MEM_FENCE);\n"
+		"\n"
+		"	/* full resolution search in the corridor around the coarse path */\n"
+		"	int2 prev_corridor = (int2)(0, lateral - 1);\n"
+		"	for (int t = 0; t < steps; t++) {\n"
+		"		int2 corridor = seam_corridor(path, path_found, t, scale, Tc, lateral);\n"
+		"		__global int * row = accum + t * lateral * 3;\n"
+		"		if (t == steps - 1) {\n"
+		"			/* cells outside the corridor of the last step are unreachable for path trace */\n"
+		"			for (int l = lid; l < lateral; l += LOCAL_SIZE) {\n"
+		"				if (l < corridor.s0 || l > corridor.s1) {\n"
+		"					row[l * 3] = -1;\n"
+		"					row[l * 3 + 1] = MAX_VALUE;\n"
+		"					row[l * 3 + 2] = 0;\n"
+		"				}\n"
+		"			}\n"
+		"		}\n"
+		"		for (int l = corridor.s0 + lid; l <= corridor.s1; l += LOCAL_SIZE) {\n"
+		"			int x = SX(t, l), y = SY(t, l);\n"
+		"			int Pixel = seam_pixel_cost(cost, ip_cost_stride, mask, ip_mask_stride, x, y, offset_1, offset_2, vertical);\n"
+		"			int parent = -1, value = Pixel, propagate = 0;\n"
+		"			if (t == 0) {\n"
+		"				/* parent at the start of the seam set to control value */\n"
+		"				propagate = (Pixel != INVALID_COST && (!vertical || l > 0)) ? 1 : 0;\n"
+		"			}\n"
+		"			else {\n"
+		"				/* parent right, left & middle values from the corridor of the previous step */\n"
+		"				__global int * prev = row - lateral * 3;\n"
+		"				long parent_value[3] = { MAX_VALUE, MAX_VALUE, MAX_VALUE };\n"
+		"				int parent_prop[3] = { 0, 0, 0 };\n"
+		"				const int parent_dir[3] = { 1, -1, 0 };\n"
+		"				for (int k = 0; k < 3; k++) {\n"
+		"					int pl = l + parent_dir[k];\n"
+		"					if (pl >= prev_corridor.s0 && pl <= prev_corridor.s1 && seam_valid(mask, ip_mask_stride, SX(t - 1, pl), SY(t - 1, pl), offset_1, offset_2)) {\n"
+		"						parent_value[k] = prev[pl * 3 + 1];\n"
+		"						parent_prop[k] = prev[pl * 3 + 2];\n"
+		"					}\n"
+		"				}\n"
+		"				/* adding bonus to the path next to an edge */\n"
+		"				long BONUS = 2 * seam_edge_bonus(cost, ip_cost_stride, phase, ip_phase_stride, equi_width, equi_height, x, y, offset_1, vertical);\n"
+		"				int select = -1;\n"
+		"				if (Pixel != INVALID_COST && (parent_prop[0] || parent_prop[1] || parent_prop[2])) {\n"
+		"					/* select right, left or middle parent path among the paths propagated from the seam start */\n"
+		"					long valid_child = MAX_VALUE;\n"
+		"					for (int k = 0; k < 3; k++) {\n"
+		"						if (parent_prop[k] && parent_value[k] < valid_child) {\n"
+		"							valid_child = parent_value[k];\n"
+		"							select = k;\n"
+		"						}\n"
+		"					}\n"
+		"					propagate = (select >= 0) ? 1 : 0;\n"
+		"				}\n"
+		"				if (select < 0) {\n"
+		"					/* select the least cost right, left or middle parent path */\n"
+		"					if (parent_value[0] < parent_value[2] && parent_value[0] < parent_value[1]) select = 0;\n"
+		"					else if (parent_value[1] < parent_value[0] && parent_value[1] < parent_value[2]) select = 1;\n"
+		"					else select = 2;\n"
+		"				}\n"
+		"				int pl = l + parent_dir[select];\n"
+		"				if (pl < prev_corridor.s0 || pl > prev_corridor.s1) {\n"
+		"					/* parent outside the corridor: path can't be traced beyond this cell */\n"
+		"					value = MAX_VALUE;\n"
+		"					propagate = 0;\n"
+		"				}\n"
+		"				else {\n"
+		"					parent = ((SY(t - 1, pl) << 16) & 0xFFFF0000) | (SX(t - 1, pl) & 0x0000FFFF);\n"
+		"					value = (int)min(parent_value[select] + Pixel + (select < 2 ? BONUS : -BONUS), (long)MAX_VALUE);\n"
+		"				}\n"
+		"			}\n"
+		"			row[l * 3] = parent;\n"
+		"			row[l * 3 + 1] = value;\n"
+		"			row[l * 3 + 2] = propagate;\n"
+		"		}\n"
+		"		prev_corridor = corridor;\n"
+		"		barrier(CLK_GLOBAL_MEM_FENCE);\n"
+		"	}\n"
+		"}\n";
 
 	return VX_SUCCESS;
 }
@@ -1778,6 +2156,16 @@ static vx_status VX_CALLBACK seamfind_cost_accumulate_opencl_codegen(
 	if (StitchGetEnvironmentVariable("COST_SELECT", textBuffer, sizeof(textBuffer)))	{ COST_SELECT = atoi(textBuffer); }
 	if (StitchGetEnvironmentVariable("SEAM_QUALITY", textBuffer, sizeof(textBuffer)))	{ SEAM_QUALITY = atoi(textBuffer); }
 
+	// coarse-to-fine path search
+	vx_uint32 coarse_scale = 0;
+	if (parameters[10]) {
+		ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[10], &coarse_scale));
+	}
+	if (coarse_scale > 1) {
+		return seamfind_cost_accumulate_coarse_opencl_codegen(node, parameters, coarse_scale, COST_SELECT, SEAM_QUALITY,
+			opencl_kernel_function_name, opencl_kernel_code, opencl_work_dim, opencl_global_work, opencl_local_work);
+	}
+
 	// set kernel configuration
 	vx_uint32 work_items = (vx_uint32)arr_capacity;
 	strcpy(opencl_kernel_function_name, "seamfind_cost_accumulate");
@@ -1792,6 +2180,7 @@ static vx_status VX_CALLBACK seamfind_cost_accumulate_opencl_codegen(
 	// kernel header and reading
 	char item[8192];
 	sprintf(item,
+		"%s"
 		"#pragma OPENCL EXTENSION cl_amd_media_ops : enable\n"
 		"#pragma OPENCL EXTENSION cl_amd_media_ops2 : enable\n"
 		"\n"
@@ -1804,8 +2193,9 @@ static vx_status VX_CALLBACK seamfind_cost_accumulate_opencl_codegen(
 		"						__global char * seam_valid_buf, uint seam_valid_buf_offset, uint valid_pix_num_items,\n"
 		"						__global char * seam_pref_buf, uint seam_pref_buf_offset, uint seam_pref_num_items,\n"
 		"						__global char * seam_info_buf, uint seam_info_buf_offset, uint seam_info_num_items,\n"
-		"						__global char * seam_accum_buf, uint seam_accum_buf_offset, uint seam_num_items)\n"
-		, (int)opencl_local_work[0], opencl_kernel_function_name);
+		"						__global char * seam_accum_buf, uint seam_accum_buf_offset, uint seam_num_items%s%s)\n"	// coarse_scale, camera planes
+		, GetCameraPlaneOpenCLMacros(parameters[11] != nullptr, "equi_height").c_str(), (int)opencl_local_work[0], opencl_kernel_function_name,
+		parameters[10] ? ", uint coarse_scale" : "", GetCameraPlaneOpenCLArgs(parameters[11] != nullptr));
 	opencl_kernel_code = item;
 	opencl_kernel_code +=
 		"{\n"
@@ -1830,19 +2220,20 @@ static vx_status VX_CALLBACK seamfind_cost_accumulate_opencl_codegen(
 		"	pref = vload8(0, (__global short *)&seam_pref_buf[dim.s7 * 16]);\n"
 		"	info = vload8(0, (__global short *)&seam_info_buf[dim.s7 * 16]);\n"
 		"	uint overlap_offset = ((info.s7 << 16) & 0xFFFF0000) | (info.s6  & 0x0000FFFF);\n"
+		"	int ov_y = dim.s1 + CAM_ROW(info.s1);\n"
 		"\n"
-		"	if (pref.s5 != -1 && ( (pref.s2 == current_frame) || ((current_frame + 1) % (pref.s3 + pref.s1) == 0)))\n"
+		"	if (pref.s5 != -1 && ( (pref.s2 == (short)current_frame) || (pref.s3 > 0 && (current_frame + 1) % (pref.s3 + pref.s1) == 0)))\n"
 		"	{\n"
 		"\n"
 		"/*	Vertical Seam */\n"
 		"		if (dim.s2 >= dim.s3)\n"
 		"		{\n"
 #if ENABLE_VERTICAL_SEAM
-		"			uint input_offset = dim.s6 * equi_height;\n"
+		"			int input_offset = CAM_ROW(dim.s6);\n"
 		"			for (uint i = 0; i < dim.s2; i++)\n"
 		"			{\n"
 		"				uint ID1 = (((dim.s1 + i) + input_offset) * equi_width) + dim.s0;\n"
-		"				uint ID2 = ((dim.s5 + i) * equi_width) + dim.s4;\n"
+		"				uint ID2 = ((ov_y + i) * equi_width) + dim.s4;\n"
 		"				uint output_ID = overlap_offset + (((dim.s1 - info.s4) + i) * dim.s3) + (dim.s0 - info.s2);\n"
 		"\n"
 		"				uchar mask_img_1 = *(__global uchar *)&ip_mask_buf[ID1];\n"
@@ -1904,7 +2295,7 @@ static vx_status VX_CALLBACK seamfind_cost_accumulate_opencl_codegen(
 		"						uint ID_left = overlap_offset + ((dim.s1 - info.s4 + i - 1) * dim.s3) + (dim.s0 - info.s2 - 1);\n"
 		"						int4 left_accum = vload4(0, (__global int *)&seam_accum_buf[ID_left * 12]);\n"
 		"						mask_1 = *(__global uchar *)&ip_mask_buf[((((dim.s1 + i) -1 ) + input_offset) * equi_width) + (dim.s0 - 1)];\n"
-		"						mask_2 = *(__global uchar *)&ip_mask_buf[(((dim.s5 + i) -1 ) * equi_width) + (dim.s4 - 1)];\n"
+		"						mask_2 = *(__global uchar *)&ip_mask_buf[(((ov_y + i) -1 ) * equi_width) + (dim.s4 - 1)];\n"
 		"						if(mask_1 && mask_2)\n"
 		"						{\n"
 		"							left = left_accum.s1;\n"
@@ -1919,7 +2310,7 @@ static vx_status VX_CALLBACK seamfind_cost_accumulate_opencl_codegen(
 		"						uint ID_right = overlap_offset + ((dim.s1 - info.s4 + i - 1) * dim.s3) + (dim.s0 - info.s2 + 1);\n"
 		"						int4 right_accum = vload4(0, (__global int *)&seam_accum_buf[ID_right * 12]);\n"
 		"						mask_1 = *(__global uchar *)&ip_mask_buf[((((dim.s1 + i) -1 ) + input_offset) * equi_width) + (dim.s0 + 1)];\n"
-		"						mask_2 = *(__global uchar *)&ip_mask_buf[(((dim.s5 + i) -1 ) * equi_width) + (dim.s4 + 1)];\n"
+		"						mask_2 = *(__global uchar *)&ip_mask_buf[(((ov_y + i) -1 ) * equi_width) + (dim.s4 + 1)];\n"
 		"						if(mask_1 && mask_2)\n"
 		"						{\n"
 		"							right = right_accum.s1;\n"
@@ -1931,7 +2322,7 @@ static vx_status VX_CALLBACK seamfind_cost_accumulate_opencl_codegen(
 		"					uint ID_middle = overlap_offset + ((dim.s1 - info.s4 + i - 1) * dim.s3) + (dim.s0 - info.s2);\n"
 		"					int4 middle_accum = vload4(0, (__global int *)&seam_accum_buf[ID_middle * 12]);\n"
 		"					mask_1 = *(__global uchar *)&ip_mask_buf[((((dim.s1 + i) -1 ) + input_offset) * equi_width) + (dim.s0)];\n"
-		"					mask_2 = *(__global uchar *)&ip_mask_buf[(((dim.s5 + i) -1 ) * equi_width) + (dim.s4)];\n"
+		"					mask_2 = *(__global uchar *)&ip_mask_buf[(((ov_y + i) -1 ) * equi_width) + (dim.s4)];\n"
 		"					if(mask_1 && mask_2)\n"
 		"					{\n"
 		"						middle = middle_accum.s1;\n"
@@ -2045,11 +2436,11 @@ static vx_status VX_CALLBACK seamfind_cost_accumulate_opencl_codegen(
 		"	else if(dim.s3 > dim.s2)\n"
 		"	{\n"
 #if ENABLE_HORIZONTAL_SEAM
-		"		uint input_offset = dim.s6 * equi_height;\n"
+		"		int input_offset = CAM_ROW(dim.s6);\n"
 		"		for (uint i = 0; i < dim.s3; i++)\n"
 		"		{\n"
 		"			uint ID1 = ((dim.s1 + input_offset) * equi_width) + (dim.s0 + i);\n"
-		"			uint ID2 = ((dim.s5 * equi_width)) + (dim.s4 + i);\n"
+		"			uint ID2 = ((ov_y * equi_width)) + (dim.s4 + i);\n"
 		"			uint output_ID = overlap_offset + ((dim.s0 - info.s2 + i) * dim.s2) + (dim.s1 - info.s4) ;\n"
 		"\n"
 		"			uchar mask_img_1 = *(__global uchar *)&ip_mask_buf[ID1];\n"
@@ -2098,7 +2489,7 @@ static vx_status VX_CALLBACK seamfind_cost_accumulate_opencl_codegen(
 		"					uint ID_left = overlap_offset + ((dim.s0 - info.s2 + i - 1) * dim.s2) + (dim.s1 - info.s4 - 1) ;\n"
 		"					int4 left_accum = vload4(0, (__global int *)&seam_accum_buf[ID_left * 12]);\n"
 		"					mask_1 = *(__global uchar *)&ip_mask_buf[(((dim.s1 - 1) + input_offset) * equi_width) + ((dim.s0 + i) - 1)];\n"
-		"					mask_2 = *(__global uchar *)&ip_mask_buf[((dim.s5 - 1) * equi_width) + ((dim.s4 + i) - 1)];\n"
+		"					mask_2 = *(__global uchar *)&ip_mask_buf[((ov_y - 1) * equi_width) + ((dim.s4 + i) - 1)];\n"
 		"					if (mask_1 && mask_2)\n"
 		"					{\n"
 		"						left = left_accum.s1;\n"
@@ -2113,7 +2504,7 @@ static vx_status VX_CALLBACK seamfind_cost_accumulate_opencl_codegen(
 		"					uint ID_right = overlap_offset + ((dim.s0 - info.s2 + i - 1) * dim.s2) + (dim.s1 - info.s4 + 1) ;\n"
 		"					int4 right_accum = vload4(0, (__global int *)&seam_accum_buf[ID_right * 12]);\n"
 		"					mask_1 = *(__global uchar *)&ip_mask_buf[(((dim.s1 + 1) + input_offset) * equi_width) + ((dim.s0 + i) - 1)];\n"
-		"					mask_2 = *(__global uchar *)&ip_mask_buf[((dim.s5 + 1) * equi_width) + ((dim.s4 + i) - 1)];\n"
+		"					mask_2 = *(__global uchar *)&ip_mask_buf[((ov_y + 1) * equi_width) + ((dim.s4 + i) - 1)];\n"
 		"					if (mask_1 && mask_2)\n"
 		"					{\n"
 		"						right = right_accum.s1;\n"
@@ -2126,7 +2517,7 @@ static vx_status VX_CALLBACK seamfind_cost_accumulate_opencl_codegen(
 		"					uint ID_middle = overlap_offset + ((dim.s0 - info.s2 + i - 1) * dim.s2) + (dim.s1 - info.s4);\n"
 		"					int4 middle_accum = vload4(0, (__global int *)&seam_accum_buf[ID_middle * 12]);\n"
 		"					mask_1 = *(__global uchar *)&ip_mask_buf[((dim.s1 + input_offset) * equi_width) + ((dim.s0 + i) - 1)];\n"
-		"					mask_2 = *(__global uchar *)&ip_mask_buf[(dim.s5 * equi_width) + ((dim.s4 + i) - 1)];\n"
+		"					mask_2 = *(__global uchar *)&ip_mask_buf[(ov_y * equi_width) + ((dim.s4 + i) - 1)];\n"
 		"					if (mask_1 && mask_2)\n"
 		"					{\n"
 		"						middle = middle_accum.s1;\n"
@@ -2239,10 +2630,272 @@ static vx_status VX_CALLBACK seamfind_cost_accumulate_opencl_codegen(
 	return VX_SUCCESS;
 }
 
-//! \brief The kernel execution.
+//! \brief Overlap geometry and input images for the CPU seam path search.
+//  A seam runs over "steps" t (rows of a vertical seam, columns of a horizontal seam) and moves across "lateral" positions l.
+struct SeamFindAccumOverlap {
+	const vx_uint8 * cost; const vx_uint8 * phase; const vx_uint8 * mask;
+	vx_int32 cost_stride, phase_stride, mask_stride;
+	vx_int32 width_eqr, height_eqr;
+	vx_int32 start_x, start_y, offset_1, offset_2;
+	vx_int32 lateral, steps;
+	bool vertical;
+	inline vx_int32 X(vx_int32 t, vx_int32 l) const { return vertical ? start_x + l : start_x + t; }
+	inline vx_int32 Y(vx_int32 t, vx_int32 l) const { return vertical ? start_y + t : start_y + l; }
+	inline bool Valid(vx_int32 t, vx_int32 l) const {
+		vx_int32 x = X(t, l), y = Y(t, l);
+		return mask[(y + offset_1) * mask_stride + x] && mask[(y + offset_2) * mask_stride + x];
+	}
+};
+
+//! \brief Seam pixel cost at (t,l): 0x7F00FFFF outside the valid overlap pixels.
+static inline vx_int32 SeamFindPixelCost(const SeamFindAccumOverlap& ov, vx_int32 t, vx_int32 l, int COST_SELECT)
+{
+	if (!ov.Valid(t, l))
+		return 0x7F00FFFF;
+	vx_int32 x = ov.X(t, l), y = ov.Y(t, l);
+	vx_int32 cost_img = ov.cost[(y + ov.offset_1) * ov.cost_stride + x];
+	if (COST_SELECT && ov.vertical)
+		cost_img = (cost_img + ov.cost[(y + ov.offset_2) * ov.cost_stride + x]) / 2;
+	return cost_img;
+}
+
+//! \brief Edgeness bonus at (t,l) from the edges on either side of the seam (same rules as the OpenCL kernel).
+static inline vx_int32 SeamFindEdgeBonus(const SeamFindAccumOverlap& ov, vx_int32 t, vx_int32 l, int SEAM_QUALITY)
+{
+	vx_int32 threshold = 0, winner_threshold = 0, phase_a = 0, phase_b = 4;
+	if (SEAM_QUALITY == 1) { threshold = ov.vertical ? 75 : 64; winner_threshold = 225; }
+	else if (SEAM_QUALITY == 2) { threshold = 128; winner_threshold = ov.vertical ? 225 : 200; }
+	else return 0;
+	if (!ov.vertical) { phase_a = 2; phase_b = 6; }
+	vx_int32 BONUS = 0;
+	for (vx_int32 side = -1; side <= 1; side += 2) {
+		vx_int32 x = ov.X(t, l + side), y = ov.Y(t, l + side);
+		if (x < 0 || x >= ov.width_eqr || y < 0 || y >= ov.height_eqr)
+			continue;
+		vx_int32 magnitude_img = ov.cost[(y + ov.offset_1) * ov.cost_stride + x];
+		vx_int32 phase_img = ov.phase[(y + ov.offset_1) * ov.phase_stride + x] >> 5;
+		if (magnitude_img > threshold && (phase_img == phase_a || phase_img == phase_b))
+			BONUS += magnitude_img + (magnitude_img > winner_threshold ? 50 : 0);
+	}
+	return BONUS;
+}
+
+//! \brief Coarse seam path search on a scale x scale downsampled cost grid.
+//  Returns the lateral corridor [lo[t],hi[t]] around the coarse path for each step, or false if no valid coarse path exists.
+static bool SeamFindCoarseCorridor(const SeamFindAccumOverlap& ov, vx_int32 scale, int COST_SELECT, std::vector<vx_int32>& lo, std::vector<vx_int32>& hi)
+{
+	const vx_int64 INF = (vx_int64)1 << 48;
+	vx_int32 Lc = (ov.lateral + scale - 1) / scale, Tc = (ov.steps + scale - 1) / scale;
+	vx_int32 sample = std::max(1, scale / 4);
+	std::vector<vx_int64> D(Lc * Tc);
+	std::vector<vx_int8> P(Lc * Tc, 0);
+	for (vx_int32 tc = 0; tc < Tc; tc++) {
+		for (vx_int32 lc = 0; lc < Lc; lc++) {
+			// average cost of valid pixels sampled in the block
+			vx_int64 sum = 0, count = 0;
+			for (vx_int32 t = tc * scale; t < std::min((tc + 1) * scale, ov.steps); t += sample) {
+				for (vx_int32 l = lc * scale; l < std::min((lc + 1) * scale, ov.lateral); l += sample) {
+					vx_int32 Pixel = SeamFindPixelCost(ov, t, l, COST_SELECT);
+					if (Pixel != 0x7F00FFFF) { sum += Pixel; count++; }
+				}
+			}
+			vx_int64 cost = count ? (sum * scale * scale + count / 2) / count : INF;
+			vx_int64 parent = 0; vx_int8 dir = 0;
+			if (tc > 0) {
+				parent = D[(tc - 1) * Lc + lc];
+				if (lc + 1 < Lc && D[(tc - 1) * Lc + lc + 1] < parent) { parent = D[(tc - 1) * Lc + lc + 1]; dir = 1; }
+				if (lc > 0 && D[(tc - 1) * Lc + lc - 1] < parent) { parent = D[(tc - 1) * Lc + lc - 1]; dir = -1; }
+			}
+			D[tc * Lc + lc] = std::min(parent + cost, INF);
+			P[tc * Lc + lc] = dir;
+		}
+	}
+	// trace the least cost coarse path back from the last step
+	std::vector<vx_int32> path(Tc);
+	vx_int32 lc = 0;
+	for (vx_int32 l = 1; l < Lc; l++)
+		if (D[(Tc - 1) * Lc + l] < D[(Tc - 1) * Lc + lc]) lc = l;
+	if (D[(Tc - 1) * Lc + lc] >= INF)
+		return false;
+	for (vx_int32 tc = Tc - 1; tc >= 0; tc--) {
+		path[tc] = lc;
+		lc += P[tc * Lc + lc];
+	}
+	// corridor covers the coarse path of the neighboring coarse steps with a margin of one block on each side
+	lo.resize(ov.steps); hi.resize(ov.steps);
+	for (vx_int32 t = 0; t < ov.steps; t++) {
+		vx_int32 tc = t / scale;
+		vx_int32 cmin = path[tc], cmax = path[tc];
+		if (tc > 0) { cmin = std::min(cmin, path[tc - 1]); cmax = std::max(cmax, path[tc - 1]); }
+		if (tc + 1 < Tc) { cmin = std::min(cmin, path[tc + 1]); cmax = std::max(cmax, path[tc + 1]); }
+		lo[t] = std::max(0, (cmin - 1) * scale);
+		hi[t] = std::min(ov.lateral - 1, (cmax + 2) * scale - 1);
+	}
+	return true;
+}
+
+//! \brief Seam path cost accumulation of one overlap restricted to the lateral corridor [lo[t],hi[t]] of each step.
+//  Cells outside the corridor are not updated except on the last step where they are marked unreachable for path trace.
+static void SeamFindAccumulateOverlap(const SeamFindAccumOverlap& ov, StitchSeamFindAccumEntry * accum,
+	const std::vector<vx_int32>& lo, const std::vector<vx_int32>& hi, int COST_SELECT, int SEAM_QUALITY)
+{
+	const vx_int64 MAX_VALUE = 0x7FFFFFFF;
+	for (vx_int32 t = 0; t < ov.steps; t++) {
+		StitchSeamFindAccumEntry * row = accum + t * ov.lateral;
+		if (t == ov.steps - 1) {
+			for (vx_int32 l = 0; l < ov.lateral; l++) {
+				if (l < lo[t] || l > hi[t]) {
+					row[l].parent_x = row[l].parent_y = -1;
+					row[l].value = 0x7FFFFFFF;
+					row[l].propagate = 0;
+				}
+			}
+		}
+		for (vx_int32 l = lo[t]; l <= hi[t]; l++) {
+			StitchSeamFindAccumEntry entry;
+			vx_int32 Pixel = SeamFindPixelCost(ov, t, l, COST_SELECT);
+			if (t == 0) {
+				// parent at the start of the seam set to control value
+				entry.parent_x = entry.parent_y = -1;
+				entry.value = Pixel;
+				entry.propagate = (Pixel != 0x7F00FFFF && (!ov.vertical || l > 0)) ? 1 : 0;
+			}
+			else {
+				const StitchSeamFindAccumEntry * prev = row - ov.lateral;
+				// parent right, left & middle values from the corridor of the previous step
+				vx_int64 parent_value[3] = { MAX_VALUE, MAX_VALUE, MAX_VALUE };
+				vx_int32 parent_prop[3] = { 0, 0, 0 };
+				const vx_int32 parent_dir[3] = { 1, -1, 0 };
+				for (int k = 0; k < 3; k++) {
+					vx_int32 pl = l + parent_dir[k];
+					if (pl >= lo[t - 1] && pl <= hi[t - 1] && ov.Valid(t - 1, pl)) {
+						parent_value[k] = prev[pl].value;
+						parent_prop[k] = prev[pl].propagate;
+					}
+				}
+				// adding bonus to the path next to an edge
+				vx_int64 BONUS = 2 * SeamFindEdgeBonus(ov, t, l, SEAM_QUALITY);
+				int select = -1, propagate = 0;
+				if (Pixel != 0x7F00FFFF && (parent_prop[0] || parent_prop[1] || parent_prop[2])) {
+					// select right, left or middle parent path among the paths propagated from the seam start
+					vx_int64 valid_child = MAX_VALUE;
+					for (int k = 0; k < 3; k++) {
+						if (parent_prop[k] && parent_value[k] < valid_child) {
+							valid_child = parent_value[k];
+							select = k;
+						}
+					}
+					propagate = (select >= 0) ? 1 : 0;
+				}
+				if (select < 0) {
+					// select the least cost right, left or middle parent path
+					if (parent_value[0] < parent_value[2] && parent_value[0] < parent_value[1]) select = 0;
+					else if (parent_value[1] < parent_value[0] && parent_value[1] < parent_value[2]) select = 1;
+					else select = 2;
+				}
+				vx_int32 pl = l + parent_dir[select];
+				if (pl < lo[t - 1] || pl > hi[t - 1]) {
+					// parent outside the corridor: path can't be traced beyond this cell
+					entry.parent_x = entry.parent_y = -1;
+					entry.value = 0x7FFFFFFF;
+					entry.propagate = 0;
+				}
+				else {
+					vx_int64 value = parent_value[select] + Pixel + (select < 2 ? BONUS : -BONUS);
+					entry.parent_x = (vx_int16)ov.X(t - 1, pl);
+					entry.parent_y = (vx_int16)ov.Y(t - 1, pl);
+					entry.value = (vx_int32)std::min(value, MAX_VALUE);
+					entry.propagate = propagate;
+				}
+			}
+			row[l] = entry;
+		}
+	}
+}
+
+//! \brief The kernel execution on the CPU: full resolution or coarse-to-fine seam path cost accumulation.
 static vx_status VX_CALLBACK seamfind_cost_accumulate_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_SUPPORTED;
+	vx_uint32 current_frame = 0, width_eqr = 0, height_eqr = 0, coarse_scale = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &current_frame));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[1], &width_eqr));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[2], &height_eqr));
+	if (parameters[10]) {
+		ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[10], &coarse_scale));
+	}
+
+	// get developer configurations
+	int COST_SELECT = 0, SEAM_QUALITY = 1;
+	char textBuffer[256];
+	if (StitchGetEnvironmentVariable("COST_SELECT", textBuffer, sizeof(textBuffer)))	{ COST_SELECT = atoi(textBuffer); }
+	if (StitchGetEnvironmentVariable("SEAM_QUALITY", textBuffer, sizeof(textBuffer)))	{ SEAM_QUALITY = atoi(textBuffer); }
+
+	// Input magnitude, phase & mask images - Variable 3, 4 & 5
+	vx_image cost_image = (vx_image)parameters[3], phase_image = (vx_image)parameters[4], mask_image = (vx_image)parameters[5];
+	vx_uint32 width = 0, height = 0, plane = 0;
+	ERROR_CHECK_STATUS(vxQueryImage(mask_image, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage(mask_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	vx_rectangle_t rect; rect.start_x = rect.start_y = 0; rect.end_x = width; rect.end_y = height;
+	void *cost_image_ptr = nullptr, *phase_image_ptr = nullptr, *mask_image_ptr = nullptr;
+	vx_imagepatch_addressing_t cost_addr, phase_addr, mask_addr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(cost_image, &rect, plane, &cost_addr, &cost_image_ptr, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(phase_image, &rect, plane, &phase_addr, &phase_image_ptr, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(mask_image, &rect, plane, &mask_addr, &mask_image_ptr, VX_READ_ONLY));
+	std::vector<vx_int32> camRow;
+	ERROR_CHECK_STATUS(SeamFindCameraPlaneRows(parameters[11], height, height_eqr, camRow));
+
+	// SeamFind Pref, Info & Accum Arrays - Variable 7, 8 & 9
+	vx_array Array_SeamFind_Pref = (vx_array)parameters[7], SeamFindInfo = (vx_array)parameters[8], Array_SeamFind_ACCUM = (vx_array)parameters[9];
+	vx_size SeamFind_Pref_max = 0, arr_numitems = 0, SeamFind_ACCUM_max = 0;
+	ERROR_CHECK_STATUS(vxQueryArray(Array_SeamFind_Pref, VX_ARRAY_ATTRIBUTE_NUMITEMS, &SeamFind_Pref_max, sizeof(SeamFind_Pref_max)));
+	ERROR_CHECK_STATUS(vxQueryArray(SeamFindInfo, VX_ARRAY_ATTRIBUTE_NUMITEMS, &arr_numitems, sizeof(arr_numitems)));
+	ERROR_CHECK_STATUS(vxQueryArray(Array_SeamFind_ACCUM, VX_ARRAY_ATTRIBUTE_NUMITEMS, &SeamFind_ACCUM_max, sizeof(SeamFind_ACCUM_max)));
+	StitchSeamFindPreference *SeamFind_Pref = nullptr; StitchSeamFindInformation *SeamFindInfo_ptr = nullptr; StitchSeamFindAccumEntry *SeamFind_Accum = nullptr;
+	vx_size stride_pref = sizeof(StitchSeamFindPreference), stride = sizeof(StitchSeamFindInformation), stride_accum = sizeof(StitchSeamFindAccumEntry);
+	ERROR_CHECK_STATUS(vxAccessArrayRange(Array_SeamFind_Pref, 0, SeamFind_Pref_max, &stride_pref, (void **)&SeamFind_Pref, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessArrayRange(SeamFindInfo, 0, arr_numitems, &stride, (void **)&SeamFindInfo_ptr, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessArrayRange(Array_SeamFind_ACCUM, 0, SeamFind_ACCUM_max, &stride_accum, (void **)&SeamFind_Accum, VX_READ_AND_WRITE));
+	vx_int32 num_overlaps = (vx_int32)std::min(arr_numitems, SeamFind_Pref_max);
+
+	//Loop over all the overlaps scheduled for this frame
+#pragma omp parallel for
+	for (vx_int32 i = 0; i < num_overlaps; i++)
+	{
+		const StitchSeamFindPreference& pref = SeamFind_Pref[i];
+		const StitchSeamFindInformation& info = SeamFindInfo_ptr[i];
+		if (pref.priority == -1 || !((pref.start_frame == (vx_int16)current_frame) || (pref.frequency > 0 && (current_frame + 1) % (pref.frequency + pref.seam_type_num) == 0)))
+			continue;
+		SeamFindAccumOverlap ov;
+		ov.cost = (const vx_uint8 *)cost_image_ptr; ov.cost_stride = cost_addr.stride_y;
+		ov.phase = (const vx_uint8 *)phase_image_ptr; ov.phase_stride = phase_addr.stride_y;
+		ov.mask = (const vx_uint8 *)mask_image_ptr; ov.mask_stride = mask_addr.stride_y;
+		ov.width_eqr = (vx_int32)width_eqr; ov.height_eqr = (vx_int32)height_eqr;
+		ov.start_x = info.start_x; ov.start_y = info.start_y;
+		ov.offset_1 = camRow[info.cam_id_1]; ov.offset_2 = camRow[info.cam_id_2];
+		ov.vertical = (info.end_y - info.start_y) >= (info.end_x - info.start_x);
+		ov.lateral = ov.vertical ? (info.end_x - info.start_x) : (info.end_y - info.start_y);
+		ov.steps = ov.vertical ? (info.end_y - info.start_y) : (info.end_x - info.start_x);
+		if ((ov.vertical && !ENABLE_VERTICAL_SEAM) || (!ov.vertical && !ENABLE_HORIZONTAL_SEAM))
+			continue;
+		if (ov.lateral <= 0 || ov.steps <= 0 || (vx_size)info.offset + (vx_size)ov.lateral * ov.steps > SeamFind_ACCUM_max)
+			continue;
+		// coarse path search limits the full resolution search to a corridor around the coarse path
+		std::vector<vx_int32> lo, hi;
+		if (coarse_scale <= 1 || !SeamFindCoarseCorridor(ov, (vx_int32)coarse_scale, COST_SELECT, lo, hi)) {
+			lo.assign(ov.steps, 0);
+			hi.assign(ov.steps, ov.lateral - 1);
+		}
+		SeamFindAccumulateOverlap(ov, SeamFind_Accum + info.offset, lo, hi, COST_SELECT, SEAM_QUALITY);
+	}
+
+	ERROR_CHECK_STATUS(vxCommitArrayRange(Array_SeamFind_ACCUM, 0, SeamFind_ACCUM_max, SeamFind_Accum));
+	ERROR_CHECK_STATUS(vxCommitArrayRange(SeamFindInfo, 0, arr_numitems, SeamFindInfo_ptr));
+	ERROR_CHECK_STATUS(vxCommitArrayRange(Array_SeamFind_Pref, 0, SeamFind_Pref_max, SeamFind_Pref));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(cost_image, &rect, plane, &cost_addr, cost_image_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(phase_image, &rect, plane, &phase_addr, phase_image_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(mask_image, &rect, plane, &mask_addr, mask_image_ptr));
+
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel publisher.
@@ -2252,7 +2905,7 @@ vx_status seamfind_cost_accumulate_publish(vx_context context)
 	vx_kernel kernel = vxAddKernel(context, "com.amd.loomsl.seamfind_cost_accumulate",
 		AMDOVX_KERNEL_STITCHING_SEAMFIND_COST_ACCUMULATE,
 		seamfind_cost_accumulate_kernel,
-		10,
+		12,
 		seamfind_cost_accumulate_input_validator,
 		seamfind_cost_accumulate_output_validator,
 		nullptr,
@@ -2276,6 +2929,8 @@ vx_status seamfind_cost_accumulate_publish(vx_context context)
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 7, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 8, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 9, VX_OUTPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 10, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_OPTIONAL));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 11, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_OPTIONAL));
 
 	// finalize and release kernel object
 	ERROR_CHECK_STATUS(vxFinalizeKernel(kernel));
@@ -2368,6 +3023,10 @@ static vx_status VX_CALLBACK seamfind_path_trace_input_validator(vx_node node, v
 		}
 		ERROR_CHECK_STATUS(vxReleaseArray((vx_array *)&ref));
 	}
+	else if (index == 6)
+	{ // optional array object of StitchCameraPlaneEntry type
+		status = ValidateCameraPlaneArray(node, ref);
+	}
 	return status;
 }
 
@@ -2409,7 +3068,7 @@ static vx_status VX_CALLBACK seamfind_path_trace_query_target_support(vx_graph g
 	int SEAM_FIND_TARGET = 0;
 	if (StitchGetEnvironmentVariable("SEAM_FIND_TARGET", textBuffer, sizeof(textBuffer))) { SEAM_FIND_TARGET = atoi(textBuffer); }
 
-	if (!SEAM_FIND_TARGET)
+	if (!SEAM_FIND_TARGET && !StitchIsHostExecution(graph))
 		supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
 	else
 		supported_target_affinity = AGO_TARGET_AFFINITY_CPU;
@@ -2475,6 +3134,7 @@ static vx_status VX_CALLBACK seamfind_path_trace_opencl_codegen(
 	// kernel header and reading
 	char item[8192];
 	sprintf(item,
+		"%s"
 		"#pragma OPENCL EXTENSION cl_amd_media_ops : enable\n"
 		"#pragma OPENCL EXTENSION cl_amd_media_ops2 : enable\n"
 		"\n"
@@ -2485,8 +3145,8 @@ static vx_status VX_CALLBACK seamfind_path_trace_opencl_codegen(
 		"						__global char * seam_info_buf, uint seam_info_buf_offset, uint seam_info_num_items,\n"
 		"						__global char * seam_accum_buf, uint seam_accum_buf_offset, uint seam_accum_num_items,\n"
 		"						__global char * seam_pref_buf, uint seam_pref_buf_offset, uint seam_pref_num_items,\n"
-		"						__global char * seam_path_buf, uint seam_path_buf_offset, uint seam_path_num_items)\n"
-		, (int)opencl_local_work[0], opencl_kernel_function_name);
+		"						__global char * seam_path_buf, uint seam_path_buf_offset, uint seam_path_num_items%s)\n"
+		, GetCameraPlaneOpenCLMacros(parameters[6] != nullptr, "equi_height").c_str(), (int)opencl_local_work[0], opencl_kernel_function_name, GetCameraPlaneOpenCLArgs(parameters[6] != nullptr));
 	opencl_kernel_code = item;
 	opencl_kernel_code +=
 		"{\n"
@@ -2507,7 +3167,7 @@ static vx_status VX_CALLBACK seamfind_path_trace_opencl_codegen(
 		"		short8 info, pref;\n"
 		"		info = vload8(0, (__global short *)seam_info_buf);\n"
 		"		pref = vload8(0, (__global short *)&seam_pref_buf[gid * 16]);\n"
-		"		uint offset_1 = (info.s0 * equi_height);\n"
+		"		int offset_1 = CAM_ROW(info.s0);\n"
 		"		uint x_dir = (info.s3 - info.s2);\n"
 		"		uint y_dir = (info.s5 - info.s4);\n"
 		"		uint overlap_offset = ((info.s7 << 16) & 0xFFFF0000) | (info.s6  & 0x0000FFFF);\n"
@@ -2516,7 +3176,7 @@ static vx_status VX_CALLBACK seamfind_path_trace_opencl_codegen(
 		"		int min_cost = 0X7FFFFFFF;\n"
 		"		int4 accum;\n"
 		"\n"
-		"		if (pref.s5 != -1 && ( (pref.s2 == current_frame) || ((current_frame + 1) % (pref.s3 + pref.s1) == 0)))\n"
+		"		if (pref.s5 != -1 && ( (pref.s2 == (short)current_frame) || (pref.s3 > 0 && (current_frame + 1) % (pref.s3 + pref.s1) == 0)))\n"
 		"		{\n"
 		"/*			Vertical Seam */\n"
 		"			if (y_dir >= x_dir)\n"
@@ -2652,6 +3312,8 @@ static vx_status VX_CALLBACK seamfind_path_trace_kernel(vx_node node, const vx_r
 
 	width_eqr = width;
 	height_eqr = (width_eqr >> 1);
+	std::vector<vx_int32> camRow;
+	ERROR_CHECK_STATUS(SeamFindCameraPlaneRows(parameters[6], height, height_eqr, camRow));
 
 	//SeamFindInfo Array - Variable 2
 	vx_size arr_numitems = 0;
@@ -2687,15 +3349,15 @@ static vx_status VX_CALLBACK seamfind_path_trace_kernel(vx_node node, const vx_r
 	//Loop over all the overlaps
 	for (vx_uint32 i = 0; i < arr_numitems; i++)
 	{
-		vx_uint32 offset_1 = SeamFindInfo_ptr[i].cam_id_1 * height_eqr;
-		vx_uint32 offset_2 = SeamFindInfo_ptr[i].cam_id_2 * height_eqr;
+		vx_int32 offset_1 = camRow[SeamFindInfo_ptr[i].cam_id_1];
+		vx_int32 offset_2 = camRow[SeamFindInfo_ptr[i].cam_id_2];
 		int y_dir = SeamFindInfo_ptr[i].end_y - SeamFindInfo_ptr[i].start_y;
 		int x_dir = SeamFindInfo_ptr[i].end_x - SeamFindInfo_ptr[i].start_x;
 
 		vx_int32 min_cost = 0X7FFFFFFF;
 		vx_int32 min_x = -1, min_y = -1;
 
-		if (SeamFind_Pref[i].priority != -1 && ((SeamFind_Pref[i].start_frame == current_frame) || ((current_frame + 1) % (SeamFind_Pref[i].frequency + SeamFind_Pref[i].seam_type_num) == 0)))
+		if (SeamFind_Pref[i].priority != -1 && ((SeamFind_Pref[i].start_frame == (vx_int16)current_frame) || (SeamFind_Pref[i].frequency > 0 && (current_frame + 1) % (SeamFind_Pref[i].frequency + SeamFind_Pref[i].seam_type_num) == 0)))
 		{
 			/***********************************************************************************************************************************
 			Vertical SeamCut
@@ -2841,7 +3503,7 @@ vx_status seamfind_path_trace_publish(vx_context context)
 	vx_kernel kernel = vxAddKernel(context, "com.amd.loomsl.seamfind_path_trace",
 		AMDOVX_KERNEL_STITCHING_SEAMFIND_PATH_TRACE,
 		seamfind_path_trace_kernel,
-		6,
+		7,
 		seamfind_path_trace_input_validator,
 		seamfind_path_trace_output_validator,
 		nullptr,
@@ -2861,6 +3523,7 @@ vx_status seamfind_path_trace_publish(vx_context context)
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 3, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 4, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 5, VX_OUTPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 6, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_OPTIONAL));
 
 	// finalize and release kernel object
 	ERROR_CHECK_STATUS(vxFinalizeKernel(kernel));
@@ -2936,6 +3599,10 @@ static vx_status VX_CALLBACK seamfind_set_weights_input_validator(vx_node node,
 		}
 		ERROR_CHECK_STATUS(vxReleaseArray((vx_array *)&ref));
 	}
+	else if (index == 9)
+	{ // optional array object of StitchCameraPlaneEntry type
+		status = ValidateCameraPlaneArray(node, ref);
+	}
 
 	return status;
 }
@@ -2988,7 +3655,113 @@ static vx_status VX_CALLBACK seamfind_set_weights_deinitialize(vx_node node, con
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK seamfind_set_weights_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_IMPLEMENTED;
+	//Current Frame, Number Of Cameras, Equirectangular Width & Height - Variable 0, 1, 2 & 3
+	vx_uint32 current_frame = 0, NumCam = 0, equi_width = 0, equi_height = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &current_frame));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[1], &NumCam));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[2], &equi_width));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[3], &equi_height));
+
+	//Debug Flags - Variable 8
+	vx_uint32 debugFlags = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[8], &debugFlags));
+	int DRAW_SEAM = (debugFlags >> 8) & 1;
+	int VIEW_SCENE_CHANGE = (debugFlags >> 9) & 1;
+	int SHOW_ALL_SEAMS = (debugFlags >> 10) & 1;
+	if (SHOW_ALL_SEAMS)
+		DRAW_SEAM = 1;
+
+	//Seam Find Weight Entry Array - Variable 4
+	vx_array Array_Weight = (vx_array)parameters[4];
+	vx_size weight_numitems = 0;
+	ERROR_CHECK_STATUS(vxQueryArray(Array_Weight, VX_ARRAY_ATTRIBUTE_NUMITEMS, &weight_numitems, sizeof(weight_numitems)));
+	if (weight_numitems == 0)
+		return VX_SUCCESS;
+	StitchSeamFindWeightEntry *Weight_Entry = nullptr;
+	vx_size stride_weight = sizeof(StitchSeamFindWeightEntry);
+	ERROR_CHECK_STATUS(vxAccessArrayRange(Array_Weight, 0, weight_numitems, &stride_weight, (void **)&Weight_Entry, VX_READ_ONLY));
+
+	//Seam Find Path Array - Variable 5
+	vx_array Array_Path = (vx_array)parameters[5];
+	vx_size path_numitems = 0;
+	ERROR_CHECK_STATUS(vxQueryArray(Array_Path, VX_ARRAY_ATTRIBUTE_NUMITEMS, &path_numitems, sizeof(path_numitems)));
+	StitchSeamFindPathEntry *SeamFind_Path = nullptr;
+	vx_size stride_path = sizeof(StitchSeamFindPathEntry);
+	if (path_numitems > 0) {
+		ERROR_CHECK_STATUS(vxAccessArrayRange(Array_Path, 0, path_numitems, &stride_path, (void **)&SeamFind_Path, VX_READ_ONLY));
+	}
+
+	//Seam Find Pref Array - Variable 6
+	vx_array Array_SeamFind_Pref = (vx_array)parameters[6];
+	vx_size SeamFind_Pref_max = 0;
+	ERROR_CHECK_STATUS(vxQueryArray(Array_SeamFind_Pref, VX_ARRAY_ATTRIBUTE_NUMITEMS, &SeamFind_Pref_max, sizeof(SeamFind_Pref_max)));
+	StitchSeamFindPreference *SeamFind_Pref = nullptr;
+	vx_size stride_pref = sizeof(StitchSeamFindPreference);
+	ERROR_CHECK_STATUS(vxAccessArrayRange(Array_SeamFind_Pref, 0, SeamFind_Pref_max, &stride_pref, (void **)&SeamFind_Pref, VX_READ_ONLY));
+
+	//Weight image - Variable 7: only the pixels of refreshed overlaps are updated
+	vx_image weight_image = (vx_image)parameters[7];
+	vx_uint32 width = 0, height = 0, plane = 0;
+	ERROR_CHECK_STATUS(vxQueryImage(weight_image, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage(weight_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	void *weight_image_ptr = nullptr; vx_rectangle_t weight_rect; vx_imagepatch_addressing_t weight_addr;
+	weight_rect.start_x = weight_rect.start_y = 0; weight_rect.end_x = width; weight_rect.end_y = height;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(weight_image, &weight_rect, plane, &weight_addr, &weight_image_ptr, VX_READ_AND_WRITE));
+	vx_uint8 *weight_ptr = (vx_uint8 *)weight_image_ptr;
+	vx_uint32 weight_stride = weight_addr.stride_y;
+	// rows of camera planes: a row outside the camera plane of a camera has no pixels of that camera
+	std::vector<vx_int32> camRow;
+	ERROR_CHECK_STATUS(GetCameraPlaneRows((vx_array)parameters[9], NumCam, equi_height, camRow));
+	vx_int32 height1 = NumCam ? (vx_int32)(height / NumCam) : 0;
+
+#pragma omp parallel for
+	for (int i = 0; i < (int)weight_numitems; i++)
+	{
+		const StitchSeamFindWeightEntry& dim = Weight_Entry[i];
+		if (dim.overlap_id < 0 || dim.overlap_id >= (vx_int16)SeamFind_Pref_max)
+			continue;
+		const StitchSeamFindPreference& pref = SeamFind_Pref[dim.overlap_id];
+		if (pref.priority == -1 || !((pref.start_frame == (vx_int16)current_frame) || (pref.frequency > 0 && (current_frame + 1) % (pref.frequency + pref.seam_type_num) == 0)))
+			continue;
+		if ((dim.overlap_type == 0 && !ENABLE_VERTICAL_SEAM) || (dim.overlap_type == 1 && !ENABLE_HORIZONTAL_SEAM) || dim.overlap_type > 1)
+			continue;
+
+		// seam position along the path: vertical seams are indexed by row, horizontal seams by column
+		vx_int16 along = (dim.overlap_type == 0) ? dim.y : dim.x;
+		vx_int16 across = (dim.overlap_type == 0) ? dim.x : dim.y;
+		vx_size overlap_ID = (vx_size)along + (vx_size)dim.overlap_id * equi_width;
+		if (overlap_ID >= path_numitems)
+			continue;
+		const StitchSeamFindPathEntry& path = SeamFind_Path[overlap_ID];
+
+		vx_uint8 * ID1 = weight_ptr + (dim.y + camRow[dim.cam_id_1]) * weight_stride + dim.x;
+		vx_uint8 * ID2 = weight_ptr + (dim.y + camRow[dim.cam_id_2]) * weight_stride + dim.x;
+		if (!SHOW_ALL_SEAMS)
+		{
+			bool start = (across >= path.min_pixel);
+			bool i_first = (path.weight_value_i == 255);
+			*ID1 = (start == i_first) ? 255 : 0;
+			*ID2 = (start == i_first) ? 0 : 255;
+			if (VIEW_SCENE_CHANGE && (pref.scene_flag == 2 || pref.scene_flag == 3))
+				*ID1 = *ID2 = (pref.scene_flag == 2) ? 50 : 255;
+			for (int cam = 0; cam < (int)NumCam; cam++) {
+				vx_int32 row = dim.y + camRow[cam];
+				if (cam != dim.cam_id_1 && cam != dim.cam_id_2 && row >= cam * height1 && row < (cam + 1) * height1)
+					weight_ptr[row * weight_stride + dim.x] = 0;
+			}
+		}
+		if (DRAW_SEAM && across == path.min_pixel)
+			*ID1 = *ID2 = 0;
+	}
+
+	ERROR_CHECK_STATUS(vxCommitImagePatch(weight_image, &weight_rect, plane, &weight_addr, weight_image_ptr));
+	ERROR_CHECK_STATUS(vxCommitArrayRange(Array_Weight, 0, weight_numitems, Weight_Entry));
+	if (path_numitems > 0) {
+		ERROR_CHECK_STATUS(vxCommitArrayRange(Array_Path, 0, path_numitems, SeamFind_Path));
+	}
+	ERROR_CHECK_STATUS(vxCommitArrayRange(Array_SeamFind_Pref, 0, SeamFind_Pref_max, SeamFind_Pref));
+
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel target support callback.
@@ -2997,7 +3770,7 @@ static vx_status VX_CALLBACK seamfind_set_weights_query_target_support(vx_graph
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = StitchIsHostExecution(graph) ? AGO_TARGET_AFFINITY_CPU : AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -3070,6 +3843,7 @@ static vx_status VX_CALLBACK seamfind_set_weights_opencl_codegen(
 	// kernel header and reading
 	char item[8192];
 	sprintf(item,
+		"%s"
 		"#pragma OPENCL EXTENSION cl_amd_media_ops : enable\n"
 		"#pragma OPENCL EXTENSION cl_amd_media_ops2 : enable\n"
 		"\n"
@@ -3080,8 +3854,8 @@ static vx_status VX_CALLBACK seamfind_set_weights_opencl_codegen(
 		"        __global char * seam_valid_buf, uint seam_valid_buf_offset, uint valid_pix_num_items,\n"
 		"        __global char * path_buf, uint path_buf_offset, uint path_num_items,\n"
 		"		 __global char * seam_pref_buf, uint seam_pref_buf_offset, uint seam_pref_num_items,\n"
-		"        uint weight_width, uint weight_height, __global uchar * weight_buf, uint weight_stride, uint weight_offset, uint flags)\n"
-		, (int)opencl_local_work[0], opencl_kernel_function_name);
+		"        uint weight_width, uint weight_height, __global uchar * weight_buf, uint weight_stride, uint weight_offset, uint flags%s)\n"
+		, GetCameraPlaneOpenCLMacros(parameters[9] != nullptr, "equi_height").c_str(), (int)opencl_local_work[0], opencl_kernel_function_name, GetCameraPlaneOpenCLArgs(parameters[9] != nullptr));
 	opencl_kernel_code = item;
 	opencl_kernel_code +=
 		"{\n"
@@ -3100,10 +3874,10 @@ static vx_status VX_CALLBACK seamfind_set_weights_opencl_codegen(
 		"			pref = vload8(0, (__global short *)&seam_pref_buf[dim.s4 * 16]);\n"
 		"			short2 path;\n"
 		"\n"
-		"			if (pref.s5 != -1 && ( (pref.s2 == current_frame) || ((current_frame + 1) % (pref.s3 + pref.s1) == 0)))\n"
+		"			if (pref.s5 != -1 && ( (pref.s2 == (short)current_frame) || (pref.s3 > 0 && (current_frame + 1) % (pref.s3 + pref.s1) == 0)))\n"
 		"			{\n"
-		"				uint offset_1 = dim.s2 * equi_height;\n"
-		"				uint offset_2 = dim.s3 * equi_height;\n"
+		"				int offset_1 = CAM_ROW(dim.s2);\n"
+		"				int offset_2 = CAM_ROW(dim.s3);\n"
 		"\n"
 		"				uint ID1 = ((dim.s1 + offset_1) * equi_width) + dim.s0;\n"
 		"				uint ID2 = ((dim.s1 + offset_2) * equi_width) + dim.s0;\n"
@@ -3159,9 +3933,9 @@ static vx_status VX_CALLBACK seamfind_set_weights_opencl_codegen(
 		"							for(int cam = 0; cam < NumCam; cam ++)\n"
 		"								if(cam != dim.s2 && cam != dim.s3)\n"
 		"								{\n"
-		"									uint offset_pixel = cam * equi_height;\n"
-		"									uint ID_PIXEL = ((dim.s1 + offset_pixel) * equi_width) + dim.s0;\n"
-		"									*(__global uchar *)&weight_buf[ID_PIXEL] = 0;\n"
+		"									int row = dim.s1 + CAM_ROW(cam), height1 = weight_height / NumCam;\n"
+		"									if (row >= cam * height1 && row < (cam + 1) * height1)\n"
+		"										*(__global uchar *)&weight_buf[(row * equi_width) + dim.s0] = 0;\n"
 		"								}\n"
 		"\n"
 		"					}\n"
@@ -3189,9 +3963,9 @@ static vx_status VX_CALLBACK seamfind_set_weights_opencl_codegen(
 		"						for(int cam = 0; cam < NumCam; cam ++)\n"
 		"							if(cam != dim.s2 && cam != dim.s3)\n"
 		"							{\n"
-		"								uint offset_pixel = cam * equi_height;\n"
-		"								uint ID_PIXEL = ((dim.s1 + offset_pixel) * equi_width) + dim.s0;\n"
-		"								*(__global uchar *)&weight_buf[ID_PIXEL] = 0;\n"
+		"								int row = dim.s1 + CAM_ROW(cam), height1 = weight_height / NumCam;\n"
+		"								if (row >= cam * height1 && row < (cam + 1) * height1)\n"
+		"									*(__global uchar *)&weight_buf[(row * equi_width) + dim.s0] = 0;\n"
 		"							}\n"
 		"\n"
 		"					}\n"
@@ -3258,9 +4032,9 @@ static vx_status VX_CALLBACK seamfind_set_weights_opencl_codegen(
 		"						for(int cam = 0; cam < NumCam; cam ++)\n"
 		"							if(cam != dim.s2 && cam != dim.s3)\n"
 		"							{\n"
-		"								uint offset_pixel = cam * equi_height;\n"
-		"								uint ID_PIXEL = ((dim.s1 + offset_pixel) * equi_width) + dim.s0;\n"
-		"								*(__global uchar *)&weight_buf[ID_PIXEL] = 0;\n"
+		"								int row = dim.s1 + CAM_ROW(cam), height1 = weight_height / NumCam;\n"
+		"								if (row >= cam * height1 && row < (cam + 1) * height1)\n"
+		"									*(__global uchar *)&weight_buf[(row * equi_width) + dim.s0] = 0;\n"
 		"							}\n"
 		"\n"
 		"					}\n"
@@ -3289,9 +4063,9 @@ static vx_status VX_CALLBACK seamfind_set_weights_opencl_codegen(
 		"						for(int cam = 0; cam < NumCam; cam ++)\n"
 		"							if(cam != dim.s2 && cam != dim.s3)\n"
 		"							{\n"
-		"								uint offset_pixel = cam * equi_height;\n"
-		"								uint ID_PIXEL = ((dim.s1 + offset_pixel) * equi_width) + dim.s0;\n"
-		"								*(__global uchar *)&weight_buf[ID_PIXEL] = 0;\n"
+		"								int row = dim.s1 + CAM_ROW(cam), height1 = weight_height / NumCam;\n"
+		"								if (row >= cam * height1 && row < (cam + 1) * height1)\n"
+		"									*(__global uchar *)&weight_buf[(row * equi_width) + dim.s0] = 0;\n"
 		"							}\n"
 		"\n"
 		"					}\n"
@@ -3373,7 +4147,7 @@ vx_status seamfind_set_weights_publish(vx_context context)
 	vx_kernel kernel = vxAddKernel(context, "com.amd.loomsl.seamfind_set_weights",
 		AMDOVX_KERNEL_STITCHING_SEAMFIND_SET_WEIGHTS,
 		seamfind_set_weights_kernel,
-		9,
+		10,
 		seamfind_set_weights_input_validator,
 		seamfind_set_weights_output_validator,
 		seamfind_set_weights_initialize,
@@ -3397,6 +4171,7 @@ vx_status seamfind_set_weights_publish(vx_context context)
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 6, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 7, VX_OUTPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 8, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 9, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_OPTIONAL));
 
 	// finalize and release kernel object
 	ERROR_CHECK_STATUS(vxFinalizeKernel(kernel));
@@ -3448,6 +4223,21 @@ static vx_status VX_CALLBACK seamfind_analyze_input_validator(vx_node node, vx_u
 		ERROR_CHECK_STATUS(vxReleaseArray((vx_array *)&ref));
 	}
 
+	if (index == 3)
+	{ // Seam budget
+		vx_enum itemtype = VX_TYPE_INVALID;
+		ERROR_CHECK_STATUS(vxQueryScalar((vx_scalar)ref, VX_SCALAR_ATTRIBUTE_TYPE, &itemtype, sizeof(itemtype)));
+
+		if (itemtype == VX_TYPE_UINT32) {
+			status = VX_SUCCESS;
+		}
+		else {
+			status = VX_ERROR_INVALID_TYPE;
+			vxAddLogEntry((vx_reference)node, status, "ERROR: SeamFind Analyze budget scalar type should be a UINT32\n");
+		}
+		ERROR_CHECK_STATUS(vxReleaseScalar((vx_scalar *)&ref));
+	}
+
 	return status;
 }
 
@@ -3487,14 +4277,51 @@ static vx_status VX_CALLBACK seamfind_analyze_kernel(vx_node node, const vx_refe
 	ERROR_CHECK_STATUS(vxQueryArray(Array_SeamFind_Pref, VX_ARRAY_ATTRIBUTE_NUMITEMS, &SeamFind_Pref_max, sizeof(SeamFind_Pref_max)));
 	StitchSeamFindPreference *SeamFind_Pref = nullptr;
 	vx_size stride_pref = sizeof(StitchSeamFindPreference);
-	ERROR_CHECK_STATUS(vxAccessArrayRange(Array_SeamFind_Pref, 0, SeamFind_Pref_max, &stride_pref, (void **)&SeamFind_Pref, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessArrayRange(Array_SeamFind_Pref, 0, SeamFind_Pref_max, &stride_pref, (void **)&SeamFind_Pref, VX_READ_AND_WRITE));
+
+	//Seam Budget - Variable 3 (optional): max overlaps scheduled per frame, 0 - unlimited
+	vx_uint32 budget = 0;
+	if (parameters[3]) {
+		ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[3], &budget));
+	}
+
+	//Schedule event driven overlaps with pending scene change, largest change magnitude first
+	std::vector<int> dirty;
+	for (int i = 0; i < (int)SeamFind_Pref_max; i++)
+	{
+		if (SeamFind_Pref[i].priority != -1 && SeamFind_Pref[i].frequency == 0 && SeamFind_Pref[i].seam_lock > 0)
+			dirty.push_back(i);
+	}
+	size_t scheduled = dirty.size();
+	if (budget > 0 && scheduled > budget) {
+		scheduled = budget;
+		std::partial_sort(dirty.begin(), dirty.begin() + scheduled, dirty.end(), [SeamFind_Pref](int a, int b) {
+			if (SeamFind_Pref[a].seam_lock != SeamFind_Pref[b].seam_lock)
+				return SeamFind_Pref[a].seam_lock > SeamFind_Pref[b].seam_lock;
+			if (SeamFind_Pref[a].priority != SeamFind_Pref[b].priority)
+				return SeamFind_Pref[a].priority < SeamFind_Pref[b].priority;
+			return a < b;
+		});
+	}
+	for (size_t k = 0; k < dirty.size(); k++)
+	{
+		StitchSeamFindPreference& pref = SeamFind_Pref[dirty[k]];
+		if (k < scheduled) {
+			pref.start_frame = (vx_int16)current_frame;
+			pref.seam_lock = 0;
+		}
+		else if (pref.seam_lock < SEAM_CHANGE_MAGNITUDE_MAX) {
+			// age deferred overlaps
+			pref.seam_lock++;
+		}
+	}
 
 	vx_uint32 flag = 0;
 	for (int i = 0; i < SeamFind_Pref_max; i++)
 	{
 		if (SeamFind_Pref[i].priority != -1){
-			if (SeamFind_Pref[i].start_frame == current_frame) flag++;
-			else if ((current_frame + 1) % (SeamFind_Pref[i].frequency + SeamFind_Pref[i].seam_type_num) == 0) flag++;
+			if (SeamFind_Pref[i].start_frame == (vx_int16)current_frame) flag++;
+			else if (SeamFind_Pref[i].frequency > 0 && (current_frame + 1) % (SeamFind_Pref[i].frequency + SeamFind_Pref[i].seam_type_num) == 0) flag++;
 
 			if (flag) break;
 		}
@@ -3514,7 +4341,7 @@ vx_status seamfind_analyze_publish(vx_context context)
 	vx_kernel kernel = vxAddKernel(context, "com.amd.loomsl.seamfind_analyze",
 		AMDOVX_KERNEL_STITCHING_SEAMFIND_ANALYZE,
 		seamfind_analyze_kernel,
-		3,
+		4,
 		seamfind_analyze_input_validator,
 		seamfind_analyze_output_validator,
 		nullptr,
@@ -3523,8 +4350,9 @@ vx_status seamfind_analyze_publish(vx_context context)
 
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
-	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 1, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 1, VX_BIDIRECTIONAL, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 2, VX_OUTPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 3, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_OPTIONAL));
 
 	// finalize and release kernel object
 	ERROR_CHECK_STATUS(vxFinalizeKernel(kernel));
@@ -3564,7 +4392,7 @@ static bool GenerateSeamFindOverlapsForFishEyeOnEquator(
 	vx_uint32 eqrHeight,                          // [in] output equirectangular image height
 	const camera_params * camera_par,             // [in] camera parameters
 	const vx_float32 * live_stitch_attr,          // [in] attributes
-	const vx_uint32 * validPixelCamMap,           // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,           // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
 	const vx_rectangle_t * const * overlapValid,  // [in] overlap regions: overlapValid[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i
 	vx_rectangle_t ** overlapRegion               // [out] overlap regions: overlapRegion[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i
 	)
@@ -3765,12 +4593,12 @@ static inline vx_status GenerateSeamFindBuffersModel(
 	vx_uint32 eqrWidth,                             // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                            // [in] output equirectangular image height
 	const camera_params * camera_par,               // [in] camera parameters
-	const vx_uint32 * validPixelCamMap,             // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,             // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
 	const vx_rectangle_t * const * overlapValid,    // [in] overlap regions: overlapValid[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i
-	const vx_uint32 * validCamOverlapInfo,          // [in] camera overlap info - use "validCamOverlapInfo[cam_i] & (1 << cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
-	const vx_uint32 * paddedPixelCamMap,            // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
+	const vx_uint64 * validCamOverlapInfo,          // [in] camera overlap info - use "validCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
+	const vx_uint64 * paddedPixelCamMap,            // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
 	const vx_rectangle_t * const * overlapPadded,   // [in] overlap regions: overlapPadded[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i(optional)
-	const vx_uint32 * paddedCamOverlapInfo,         // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & (1 << cam_j)": size: [LIVE_STITCH_MAX_CAMERAS](optional)
+	const vx_uint64 * paddedCamOverlapInfo,         // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS](optional)
 	const vx_float32 * live_stitch_attr,            // [in] attributes
 	vx_size validTableSize,                         // [in] size of seamFind valid table in terms of number of entries
 	vx_size weightTableSize,                        // [in] size of seamFind weight table in terms of number of entries
@@ -3797,6 +4625,11 @@ static inline vx_status GenerateSeamFindBuffersModel(
 	vx_int32 SEAM_LOCK = (vx_int32)live_stitch_attr[LIVE_STITCH_ATTR_SEAM_LOCK];
 	vx_int32 SEAM_FLAG = ((vx_int32)live_stitch_attr[LIVE_STITCH_ATTR_SEAM_FLAGS]) & 3;
 	vx_int32 SEAM_COEQUSH_ENABLE = ((vx_int32)live_stitch_attr[LIVE_STITCH_ATTR_SEAM_COEQUSH_ENABLE]);
+	if ((vx_int32)live_stitch_attr[LIVE_STITCH_ATTR_OUTPUT_PROJECTION] != output_projection_equirectangular) {
+		// equator special handling assumes equirectangular output
+		SEAM_COEQUSH_ENABLE = 0;
+	}
+	vx_int32 SEAM_SCHEDULE = ((vx_int32)live_stitch_attr[LIVE_STITCH_ATTR_SEAM_SCHEDULE]);
 
 	// allocate memory for overlap region
 	std::vector<vx_rectangle_t> overlapRegionRect(numCamera * numCamera);
@@ -3819,13 +4652,13 @@ static inline vx_status GenerateSeamFindBuffersModel(
 	// generate tables
 	for (vx_uint32 i = 1; i < numCamera; i++) {
 		for (vx_uint32 j = 0; j < i; j++) {
-			vx_uint32 overlapMaskBits = (1 << i) | (1 << j);
+			vx_uint64 overlapMaskBits = StitchCameraBit(i) | StitchCameraBit(j);
 			vx_uint32 start_x = overlapValid[i][j].start_x, end_x = overlapValid[i][j].end_x;
 			vx_uint32 start_y = overlapValid[i][j].start_y, end_y = overlapValid[i][j].end_y;
 			if (start_x < end_x && (end_x - start_x) <= (end_y - start_y)) {
 				// make sure top and bottom has a valid pixels between start_x+1 and end_x-1
 				for (; start_y < end_y; start_y++) {
-					const vx_uint32 * map = validPixelCamMap + start_y * eqrWidth;
+					const vx_uint64 * map = validPixelCamMap + start_y * eqrWidth;
 					vx_uint32 x = start_x + 1;
 					for (; x < end_x - 1; x++)
 						if ((map[x] & overlapMaskBits) == overlapMaskBits)
@@ -3834,7 +4667,7 @@ static inline vx_status GenerateSeamFindBuffersModel(
 						break;
 				}
 				for (; start_y < end_y; end_y--) {
-					const vx_uint32 * map = validPixelCamMap + (end_y - 1) * eqrWidth;
+					const vx_uint64 * map = validPixelCamMap + (end_y - 1) * eqrWidth;
 					vx_uint32 x = start_x + 1;
 					for (; x < end_x - 1; x++)
 						if ((map[x] & overlapMaskBits) == overlapMaskBits)
@@ -3846,7 +4679,7 @@ static inline vx_status GenerateSeamFindBuffersModel(
 			if (start_y < end_y && (end_y - start_y) <= (end_x - start_x)) {
 				// make sure left and right has a valid pixels between start_y+1 and end_y-1
 				for (; start_x < end_x; start_x++) {
-					const vx_uint32 * map = validPixelCamMap + start_x;
+					const vx_uint64 * map = validPixelCamMap + start_x;
 					vx_uint32 y = start_y + 1;
 					for (; y < end_y - 1; y++)
 						if ((map[y * eqrWidth] & overlapMaskBits) == overlapMaskBits)
@@ -3855,7 +4688,7 @@ static inline vx_status GenerateSeamFindBuffersModel(
 						break;
 				}
 				for (; start_x < end_x; end_x--) {
-					const vx_uint32 * map = validPixelCamMap + (end_x - 1);
+					const vx_uint64 * map = validPixelCamMap + (end_x - 1);
 					vx_uint32 y = start_y + 1;
 					for (; y < end_y - 1; y++)
 						if ((map[y * eqrWidth] & overlapMaskBits) == overlapMaskBits)
@@ -3903,8 +4736,13 @@ static inline vx_status GenerateSeamFindBuffersModel(
 							prefTableEntry.start_frame = SEAM_STAGGER * vertical_overlap;
 							prefTableEntry.frequency = SEAM_FREQUENCY;
 							prefTableEntry.quality = SEAM_QUALITY;
+							if (SEAM_SCHEDULE) {
+								// event driven: no periodic refresh and seam pending with highest change magnitude
+								prefTableEntry.start_frame = -1;
+								prefTableEntry.frequency = 0;
+							}
 							prefTableEntry.priority = VERTICAL_SEAM_PRIORITY;
-							prefTableEntry.seam_lock = SEAM_LOCK;
+							prefTableEntry.seam_lock = SEAM_SCHEDULE ? SEAM_CHANGE_MAGNITUDE_MAX : SEAM_LOCK;
 							prefTableEntry.scene_flag = SEAM_FLAG;
 							prefTable[overlap_number] = prefTableEntry;
 						}
@@ -3943,8 +4781,13 @@ static inline vx_status GenerateSeamFindBuffersModel(
 							prefTableEntry.start_frame = SEAM_STAGGER * horizontal_overlap;
 							prefTableEntry.frequency = SEAM_FREQUENCY;
 							prefTableEntry.quality = SEAM_QUALITY;
+							if (SEAM_SCHEDULE) {
+								// event driven: no periodic refresh and seam pending with highest change magnitude
+								prefTableEntry.start_frame = -1;
+								prefTableEntry.frequency = 0;
+							}
 							prefTableEntry.priority = HORIZONTAL_SEAM_PRIORITY;
-							prefTableEntry.seam_lock = SEAM_LOCK;
+							prefTableEntry.seam_lock = SEAM_SCHEDULE ? SEAM_CHANGE_MAGNITUDE_MAX : SEAM_LOCK;
 							prefTableEntry.scene_flag = SEAM_FLAG;
 							prefTable[overlap_number] = prefTableEntry;
 						}
@@ -4025,12 +4868,12 @@ vx_status CalculateSmallestSeamFindBufferSizes(
 	vx_uint32 eqrWidth,                            // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                           // [in] output equirectangular image height
 	const camera_params * camera_par,              // [in] camera parameters
-	const vx_uint32 * validPixelCamMap,            // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,            // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
 	const vx_rectangle_t * const * overlapValid,   // [in] overlap regions: overlapValid[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i
-	const vx_uint32 * validCamOverlapInfo,         // [in] camera overlap info - use "validCamOverlapInfo[cam_i] & (1 << cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
-	const vx_uint32 * paddedPixelCamMap,           // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
+	const vx_uint64 * validCamOverlapInfo,         // [in] camera overlap info - use "validCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
+	const vx_uint64 * paddedPixelCamMap,           // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
 	const vx_rectangle_t * const * overlapPadded,  // [in] overlap regions: overlapPadded[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i(optional)
-	const vx_uint32 * paddedCamOverlapInfo,        // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & (1 << cam_j)": size: [LIVE_STITCH_MAX_CAMERAS](optional)
+	const vx_uint64 * paddedCamOverlapInfo,        // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS](optional)
 	const vx_float32 * live_stitch_attr,           // [in] attributes
 	vx_size * seamFindValidEntryCount,             // [out] number of entries needed by seamFind valid table
 	vx_size * seamFindWeightEntryCount,            // [out] number of entries needed by seamFind weight table
@@ -4051,12 +4894,12 @@ vx_status GenerateSeamFindBuffers(
 	vx_uint32 eqrWidth,                             // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                            // [in] output equirectangular image height
 	const camera_params * camera_par,               // [in] camera parameters
-	const vx_uint32 * validPixelCamMap,             // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,             // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
 	const vx_rectangle_t * const * overlapValid,    // [in] overlap regions: overlapValid[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i
-	const vx_uint32 * validCamOverlapInfo,          // [in] camera overlap info - use "validCamOverlapInfo[cam_i] & (1 << cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
-	const vx_uint32 * paddedPixelCamMap,            // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
+	const vx_uint64 * validCamOverlapInfo,          // [in] camera overlap info - use "validCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
+	const vx_uint64 * paddedPixelCamMap,            // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
 	const vx_rectangle_t * const * overlapPadded,   // [in] overlap regions: overlapPadded[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i(optional)
-	const vx_uint32 * paddedCamOverlapInfo,         // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & (1 << cam_j)": size: [LIVE_STITCH_MAX_CAMERAS](optional)
+	const vx_uint64 * paddedCamOverlapInfo,         // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS](optional)
 	const vx_float32 * live_stitch_attr,            // [in] attributes
 	vx_size validTableSize,                         // [in] size of seamFind valid table in terms of number of entries
 	vx_size weightTableSize,                        // [in] size of seamFind weight table in terms of number of entries
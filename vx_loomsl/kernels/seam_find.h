@@ -25,6 +25,7 @@ THE SOFTWARE.
 #define __SEAM_FIND_H__
 
 #include "kernels.h"
+#include "warp.h"
 
 /*********************************************************************
 SeamFind Data Structures
@@ -48,17 +49,23 @@ typedef struct {
 } StitchSeamFindInformation;
 
 //! \brief The Seam Find Preference attributes.
+//  With event driven seam refresh (frequency == 0) the seam is calculated only in frames picked by the
+//  analyze kernel: seam_lock holds the pending scene change magnitude and start_frame the scheduled frame.
 typedef struct {
 	vx_int16 type;			// Overlap type: 0 - Vertical Overlap, 1 - Hortzontal Overlap,  2 - Diagonal Overlap
 	vx_int16 seam_type_num;	// Overlap type ID - vertical/horizontal overlap ID
-	vx_int16 start_frame;	// Start frame to calculate the seam
-	vx_int16 frequency;		// Frequency to calculate the seam		
+	vx_int16 start_frame;	// Start frame to calculate the seam (compared with lower 16-bits of current frame)
+	vx_int16 frequency;		// Frequency to calculate the seam: 0 - event driven
 	vx_int16 quality;		// Quality of the calculated the seam		
 	vx_int16 priority;		// Priority to calculate the seam	
-	vx_int16 seam_lock;		// Lock the seam after scene change is detected for n frames
+	vx_int16 seam_lock;		// Lock the seam after scene change is detected for n frames (event driven: pending change magnitude)
 	vx_int16 scene_flag;	// Scene change detection flag
 } StitchSeamFindPreference;
 
+//! \brief The pending change magnitude of event driven seam refresh: percentage of changed scene samples,
+//  deferred overlaps age by one each frame up to the max so that they cannot starve.
+#define SEAM_CHANGE_MAGNITUDE_MAX 0x7fff
+
 //! \brief The valid pixel entry for Seam Find.
 typedef struct {
 	vx_int16 dstX;		 // destination pixel x-coordinate (integer)
@@ -141,12 +148,12 @@ vx_status CalculateSmallestSeamFindBufferSizes(
 	vx_uint32 eqrWidth,                            // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                           // [in] output equirectangular image height
 	const camera_params * camera_par,               // [in] camera parameters
-	const vx_uint32 * validPixelCamMap,            // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,            // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
 	const vx_rectangle_t * const * overlapValid,   // [in] overlap regions: overlapValid[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i
-	const vx_uint32 * validCamOverlapInfo,         // [in] camera overlap info - use "validCamOverlapInfo[cam_i] & (1 << cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
-	const vx_uint32 * paddedPixelCamMap,           // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
+	const vx_uint64 * validCamOverlapInfo,         // [in] camera overlap info - use "validCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
+	const vx_uint64 * paddedPixelCamMap,           // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
 	const vx_rectangle_t * const * overlapPadded,  // [in] overlap regions: overlapPadded[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i(optional)
-	const vx_uint32 * paddedCamOverlapInfo,        // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & (1 << cam_j)": size: [LIVE_STITCH_MAX_CAMERAS](optional)
+	const vx_uint64 * paddedCamOverlapInfo,        // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS](optional)
 	const vx_float32 * live_stitch_attr,           // [in] attributes
 	vx_size * seamFindValidEntryCount,             // [out] number of entries needed by seamFind valid table
 	vx_size * seamFindWeightEntryCount,            // [out] number of entries needed by seamFind weight table
@@ -160,12 +167,12 @@ vx_status GenerateSeamFindBuffers(
 	vx_uint32 eqrWidth,                             // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                            // [in] output equirectangular image height
 	const camera_params * camera_par,               // [in] camera parameters
-	const vx_uint32 * validPixelCamMap,             // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,             // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
 	const vx_rectangle_t * const * overlapValid,    // [in] overlap regions: overlapValid[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i
-	const vx_uint32 * validCamOverlapInfo,          // [in] camera overlap info - use "validCamOverlapInfo[cam_i] & (1 << cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
-	const vx_uint32 * paddedPixelCamMap,            // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
+	const vx_uint64 * validCamOverlapInfo,          // [in] camera overlap info - use "validCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS]
+	const vx_uint64 * paddedPixelCamMap,            // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight](optional)
 	const vx_rectangle_t * const * overlapPadded,   // [in] overlap regions: overlapPadded[cam_i][cam_j] for overlap of cam_i and cam_j, cam_j <= cam_i(optional)
-	const vx_uint32 * paddedCamOverlapInfo,         // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & (1 << cam_j)": size: [LIVE_STITCH_MAX_CAMERAS](optional)
+	const vx_uint64 * paddedCamOverlapInfo,         // [in] camera overlap info - use "paddedCamOverlapInfo[cam_i] & StitchCameraBit(cam_j)": size: [LIVE_STITCH_MAX_CAMERAS](optional)
 	const vx_float32 * live_stitch_attr,            // [in] attributes
 	vx_size validTableSize,                         // [in] size of seamFind valid table in terms of number of entries
 	vx_size weightTableSize,                        // [in] size of seamFind weight table in terms of number of entries
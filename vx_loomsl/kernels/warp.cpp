@@ -63,12 +63,12 @@ static vx_status VX_CALLBACK warp_input_validator(vx_node node, vx_uint32 index)
 	{ // array object of StitchValidPixelEntry type
 		vx_size itemsize = 0;
 		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
-		if (itemsize == sizeof(StitchValidPixelEntry)) {
+		if (itemsize == sizeof(StitchValidPixelEntry) || itemsize == sizeof(StitchValidPixelWideEntry)) {
 			status = VX_SUCCESS;
 		}
 		else {
 			status = VX_ERROR_INVALID_DIMENSION;
-			vxAddLogEntry((vx_reference)node, status, "ERROR: warp array element (StitchWarpRemapEntry) size should be 32 bytes\n");
+			vxAddLogEntry((vx_reference)node, status, "ERROR: warp array element (StitchValidPixelEntry) size should be 4 bytes (or 8 bytes for StitchValidPixelWideEntry)\n");
 		}
 		ERROR_CHECK_STATUS(vxReleaseArray((vx_array *)&ref));
 		
@@ -77,12 +77,12 @@ static vx_status VX_CALLBACK warp_input_validator(vx_node node, vx_uint32 index)
 	{ // array object of StitchWarpRemapEntry type
 		vx_size itemsize = 0;
 		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
-		if (itemsize == sizeof(StitchWarpRemapEntry)) {
+		if (itemsize == sizeof(StitchWarpRemapEntry) || itemsize == sizeof(StitchWarpRemapCompactEntry)) {
 			status = VX_SUCCESS;
 		}
 		else {
 			status = VX_ERROR_INVALID_DIMENSION;
-			vxAddLogEntry((vx_reference)node, status, "ERROR: warp array element (StitchWarpRemapEntry) size should be 32 bytes\n");
+			vxAddLogEntry((vx_reference)node, status, "ERROR: warp array element (StitchWarpRemapEntry) size should be 32 bytes (or 8 bytes for StitchWarpRemapCompactEntry)\n");
 		}
 		ERROR_CHECK_STATUS(vxReleaseArray((vx_array *)&ref));
 
@@ -219,7 +219,7 @@ static vx_status VX_CALLBACK warp_query_target_support(vx_graph graph, vx_node n
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = StitchIsHostExecution(graph) ? AGO_TARGET_AFFINITY_CPU : AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -280,6 +280,18 @@ static vx_status VX_CALLBACK warp_opencl_codegen(
 	ERROR_CHECK_OBJECT(arr);
 	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_CAPACITY, &arr_capacity, sizeof(arr_capacity)));
 	ERROR_CHECK_STATUS(vxReleaseArray(&arr));
+	vx_size warp_remap_itemsize = 0;
+	arr = (vx_array)avxGetNodeParamRef(node, 3);						// warp remap array
+	ERROR_CHECK_OBJECT(arr);
+	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &warp_remap_itemsize, sizeof(warp_remap_itemsize)));
+	ERROR_CHECK_STATUS(vxReleaseArray(&arr));
+	bool bCompactWarpRemap = (warp_remap_itemsize == sizeof(StitchWarpRemapCompactEntry));
+	vx_size valid_pix_itemsize = 0;
+	arr = (vx_array)avxGetNodeParamRef(node, 2);						// valid pixel array
+	ERROR_CHECK_OBJECT(arr);
+	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &valid_pix_itemsize, sizeof(valid_pix_itemsize)));
+	ERROR_CHECK_STATUS(vxReleaseArray(&arr));
+	bool bWideValidPixel = (valid_pix_itemsize == sizeof(StitchValidPixelWideEntry));
 	vx_image image = (vx_image)avxGetNodeParamRef(node, 4);				// input image
 	vx_uint32 input_height = 0, output_height = 0;
 	ERROR_CHECK_OBJECT(image);
@@ -319,8 +331,28 @@ static vx_status VX_CALLBACK warp_opencl_codegen(
 	opencl_local_work[0] = 64;
 	opencl_global_work[0] = (work_items + opencl_local_work[0] - 1) & ~(opencl_local_work[0] - 1);
 	
+	// warp remap table access: a work item processes 4 pixels, i.e., half of an entry;
+	// compact entries are expanded into the same packed (x,y) pairs as full entries
+	const char * warp_remap_offset = bCompactWarpRemap ? "((gid >> 1) << 3)" : "(gid << 4)";
+	const char * warp_remap_load = bCompactWarpRemap ? "warp_remap_compact(warp_remap_buf - ((gid >> 1) << 3), *(__global uint2 *) warp_remap_buf, (gid & 1) << 2)" : "*(__global uint4 *) warp_remap_buf";
+	// valid pixel table access: wide entries come with Q14.2 warp remap entries
+	vx_uint32 warp_remap_qf = bWideValidPixel ? 2 : 3;
+	const char * valid_pix_offset = bWideValidPixel ? "((gid >> 1) << 3)" : "((gid >> 1) << 2)";
+	const char * valid_pix_load = bWideValidPixel ?
+		"    uint2 pixelEntry = *(__global uint2*) valid_pix_buf;\n"
+		"    if(pixelEntry.s0 == 0xffffffff) return;\n" :
+		"    uint pixelEntry = *(__global uint*) valid_pix_buf;\n"
+		"    if(pixelEntry == 0xffffffff) return;\n";
+	const char * valid_pix_decode = bWideValidPixel ?
+		"    uint camera_id = pixelEntry.s0 & 0xff; uint op_x = pixelEntry.s1 & 0xffff; uint op_y = pixelEntry.s1 >> 16;\n" :
+		"    uint camera_id = pixelEntry & 0x1f; uint op_x = (pixelEntry >> 8) & 0x7ff; uint op_y = (pixelEntry >> 19) & 0x1fff;\n";
+
 	vx_uint32 ip_image_height_offs = (vx_uint32)(input_height / num_cameras);
 	vx_uint32 op_image_height_offs = (vx_uint32)(output_height / num_cameras);
+	if (flags & STITCH_WARP_FLAG_PACKED_OUTPUT) {
+		// valid pixel entries already have the camera plane offset
+		op_image_height_offs = 0;
+	}
 	// Setting variables required by the interface
 	opencl_local_buffer_usage_mask = 0;
 	opencl_local_buffer_size_in_bytes = 0;
@@ -361,11 +393,11 @@ static vx_status VX_CALLBACK warp_opencl_codegen(
 		"{\n"
 		"  int gid = get_global_id(0);\n"
 		"  float4 f, mf; uint sx, sy, offset; uint4 outpix;\n"
-		"  uint QF = 3;\n"
+		"  uint QF = %d;\n" // warp_remap_qf
 		"  uint QFB = (1 << QF) - 1; float QFM = 1.0f / (1 << QF);\n"
 		"  uint ip_image_height_offset = %d;\n" // ip_image_height_offs
 		"  uint op_image_height_offset = %d;\n" // op_image_height_offs
-		, ip_image_height_offs, op_image_height_offs);
+		, warp_remap_qf, ip_image_height_offs, op_image_height_offs);
 	opencl_kernel_code += item;
 	if (bWriteU8Image)
 	{
@@ -374,14 +406,15 @@ static vx_status VX_CALLBACK warp_opencl_codegen(
 			, op_image_height_offs);
 		opencl_kernel_code += item;
 	}
-	opencl_kernel_code +=
-		"  warp_remap_buf += warp_remap_buf_offset + (gid << 4);\n"
-		"  valid_pix_buf += valid_pix_buf_offset + ((gid >> 1) << 2);\n"
+	sprintf(item,
+		"  warp_remap_buf += warp_remap_buf_offset + %s;\n" // warp_remap_offset
+		"  valid_pix_buf += valid_pix_buf_offset + %s;\n" // valid_pix_offset
 		"  if (((gid >> 1) < valid_pix_num_items)) {\n"
-		"    uint pixelEntry = *(__global uint*) valid_pix_buf;\n"
-		"    if(pixelEntry == 0xffffffff) return;\n"
-		"    uint4 map = *(__global uint4 *) warp_remap_buf;\n"
-		"    uint camera_id = pixelEntry & 0x1f; uint op_x = (pixelEntry >> 8) & 0x7ff; uint op_y = (pixelEntry >> 19) & 0x1fff;\n";
+		"%s" // valid_pix_load
+		"    uint4 map = %s;\n" // warp_remap_load
+		"%s" // valid_pix_decode
+		, warp_remap_offset, valid_pix_offset, valid_pix_load, warp_remap_load, valid_pix_decode);
+	opencl_kernel_code += item;
 	if (num_camera_columns == 1)
 		opencl_kernel_code += "    ip_buf += ip_offset + (camera_id * ip_image_height_offset * ip_stride);\n";
 	else {
@@ -852,11 +885,11 @@ static vx_status VX_CALLBACK warp_opencl_codegen(
 			"{\n"
 			"  int gid = get_global_id(0);\n"
 			"  float4 f, mf; uint sx, sy, offset; uint4 outpix;\n"
-			"  uint QF = 3;\n"
+			"  uint QF = %d;\n" // warp_remap_qf
 			"  uint QFB = (1 << QF) - 1; float QFM = 1.0f / (1 << QF);\n"
 			"  uint ip_image_height_offset = %d;\n" // ip_image_height_offs
 			"  uint op_image_height_offset = %d;\n" // op_image_height_offs
-			, ip_image_height_offs, op_image_height_offs);
+			, warp_remap_qf, ip_image_height_offs, op_image_height_offs);
 		opencl_kernel_code += item;
 		if (bWriteU8Image)
 		{
@@ -865,14 +898,15 @@ static vx_status VX_CALLBACK warp_opencl_codegen(
 				, op_image_height_offs);
 			opencl_kernel_code += item;
 		}
-		opencl_kernel_code +=
-			"  warp_remap_buf += warp_remap_buf_offset + (gid << 4);\n"
-			"  valid_pix_buf += valid_pix_buf_offset + ((gid >> 1) << 2);\n"
+		sprintf(item,
+			"  warp_remap_buf += warp_remap_buf_offset + %s;\n" // warp_remap_offset
+			"  valid_pix_buf += valid_pix_buf_offset + %s;\n" // valid_pix_offset
 			"  if (((gid >> 1) < valid_pix_num_items)) {\n"
-			"    uint pixelEntry = *(__global uint*) valid_pix_buf;\n"
-			"    if(pixelEntry == 0xffffffff) return;\n"
-			"    uint4 map = *(__global uint4 *) warp_remap_buf;\n"
-			"    uint camera_id = pixelEntry & 0x1f; uint op_x = (pixelEntry >> 8) & 0x7ff; uint op_y = (pixelEntry >> 19) & 0x1fff;\n";
+			"%s" // valid_pix_load
+			"    uint4 map = %s;\n" // warp_remap_load
+			"%s" // valid_pix_decode
+			, warp_remap_offset, valid_pix_offset, valid_pix_load, warp_remap_load, valid_pix_decode);
+		opencl_kernel_code += item;
 		if (num_camera_columns == 1)
 			opencl_kernel_code += "    ip_buf += ip_offset + (camera_id * ip_image_height_offset * ip_stride);\n";
 		else {
@@ -1373,11 +1407,11 @@ static vx_status VX_CALLBACK warp_opencl_codegen(
 			"{\n"
 			"  int gid = get_global_id(0);\n"
 			"  float4 f, mf; uint sx, sy, offset; uint4 outpix; float y;\n"
-			"  uint QF = 3;\n"
+			"  uint QF = %d;\n" // warp_remap_qf
 			"  uint QFB = (1 << QF) - 1; float QFM = 1.0f / (1 << QF);\n"
 			"  uint ip_image_height_offset = %d;\n" // ip_image_height_offs
 			"  uint op_image_height_offset = %d;\n" // op_image_height_offs
-			, ip_image_height_offs, op_image_height_offs);
+			, warp_remap_qf, ip_image_height_offs, op_image_height_offs);
 		opencl_kernel_code += item;
 		if (bWriteU8Image)
 		{
@@ -1386,14 +1420,15 @@ static vx_status VX_CALLBACK warp_opencl_codegen(
 				, op_image_height_offs);
 			opencl_kernel_code += item;
 		}
-		opencl_kernel_code +=
-			"  warp_remap_buf += warp_remap_buf_offset + (gid << 4);\n"
-			"  valid_pix_buf += valid_pix_buf_offset + ((gid >> 1) << 2);\n"
+		sprintf(item,
+			"  warp_remap_buf += warp_remap_buf_offset + %s;\n" // warp_remap_offset
+			"  valid_pix_buf += valid_pix_buf_offset + %s;\n" // valid_pix_offset
 			"  if (((gid >> 1) < valid_pix_num_items)) {\n"
-			"    uint pixelEntry = *(__global uint*) valid_pix_buf;\n"
-			"    if(pixelEntry == 0xffffffff) return;\n"
-			"    uint4 map = *(__global uint4 *) warp_remap_buf;\n"
-			"    uint camera_id = pixelEntry & 0x1f; uint op_x = (pixelEntry >> 8) & 0x7ff; uint op_y = (pixelEntry >> 19) & 0x1fff;\n";
+			"%s" // valid_pix_load
+			"    uint4 map = %s;\n" // warp_remap_load
+			"%s" // valid_pix_decode
+			, warp_remap_offset, valid_pix_offset, valid_pix_load, warp_remap_load, valid_pix_decode);
+		opencl_kernel_code += item;
 		if (num_camera_columns == 1)
 			opencl_kernel_code += "    ip_buf += ip_offset + (camera_id * ip_image_height_offset * ip_stride);\n";
 		else {
@@ -1889,6 +1924,23 @@ static vx_status VX_CALLBACK warp_opencl_codegen(
 			"}\n";
 	}
 #endif
+	if (bCompactWarpRemap) {
+		// reconstruct source (x,y) of pixels i0..i0+3 from compact entry (see StitchWarpRemapCompactEntry)
+		opencl_kernel_code =
+			"uint4 warp_remap_compact(__global char * warp_remap_base, uint2 entry, uint i0)\n"
+			"{\n"
+			"  if ((entry.s1 & 0xfff00) == (0x800 << 8)) // escaped entry: full entry in the overflow area\n"
+			"    return vload4(0, (__global uint *)(warp_remap_base + (entry.s0 << 3) + (i0 << 2)));\n"
+			"  uint valid_mask = entry.s1 & 0xff; int first = (int)popcount((valid_mask & (0u - valid_mask)) - 1);\n"
+			"  int dx = ((int)(entry.s1 << 12)) >> 20, dy = ((int)entry.s1) >> 20;\n"
+			"  int4 k = (int4)((int)i0 - first) + (int4)(0, 1, 2, 3);\n"
+			"  uint4 sx = as_uint4(clamp(((int4)((int)(entry.s0 & 0xffff) << 5) + k * dx + 16) >> 5, 0, 0xfffe));\n"
+			"  uint4 sy = as_uint4(clamp(((int4)((int)(entry.s0 >> 16) << 5) + k * dy + 16) >> 5, 0, 0xfffe));\n"
+			"  uint4 valid = ((uint4)valid_mask >> ((uint4)i0 + (uint4)(0, 1, 2, 3))) & 1;\n"
+			"  return select((uint4)0xffffffff, sx | (sy << 16), valid == (uint4)1);\n"
+			"}\n"
+			+ opencl_kernel_code;
+	}
 	if (s_num_camera_columns)	ERROR_CHECK_STATUS(vxReleaseScalar(&s_num_camera_columns));
 	if (s_alpha_value)			ERROR_CHECK_STATUS(vxReleaseScalar(&s_alpha_value));
 	if (s_flags)				ERROR_CHECK_STATUS(vxReleaseScalar(&s_flags));
@@ -1896,10 +1948,191 @@ static vx_status VX_CALLBACK warp_opencl_codegen(
 	return VX_SUCCESS;
 }
 
-//! \brief The kernel execution.
+//! \brief Get the source locations of 8 consecutive pixels from a full or compact warp remap entry: same as warp_remap_compact in OpenCL.
+//  Escaped compact entries are decoded from the full entry in the overflow area of warp_remap_buf.
+void WarpRemapDecodeEntry(const vx_uint8 * warp_remap_buf, const vx_uint8 * entry, bool bCompactWarpRemap, vx_uint32 sx[8], vx_uint32 sy[8])
+{
+	if (bCompactWarpRemap && (((const StitchWarpRemapCompactEntry *)entry)->deltaX == STITCH_WARP_COMPACT_ESCAPE)) {
+		const StitchWarpRemapCompactEntry * escapeEntry = (const StitchWarpRemapCompactEntry *)entry;
+		vx_size index = ((vx_size)escapeEntry->srcY << 16) | escapeEntry->srcX;
+		entry = warp_remap_buf + index * sizeof(StitchWarpRemapCompactEntry);
+		bCompactWarpRemap = false;
+	}
+	if (!bCompactWarpRemap) {
+		vx_uint16 map[16];
+		memcpy(map, entry, sizeof(map));
+		for (vx_uint32 i = 0; i < 8; i++) {
+			sx[i] = map[2 * i + 0];
+			sy[i] = map[2 * i + 1];
+		}
+		return;
+	}
+	vx_uint32 w[2];
+	memcpy(w, entry, sizeof(w));
+	vx_uint32 valid_mask = w[1] & 0xff;
+	vx_int32 first = valid_mask ? (vx_int32)GetOneBitCount((valid_mask & (0u - valid_mask)) - 1) : 0;
+	vx_int32 dx = ((vx_int32)(w[1] << 12)) >> 20, dy = ((vx_int32)w[1]) >> 20;
+	for (vx_int32 i = 0; i < 8; i++) {
+		if ((valid_mask >> i) & 1) {
+			sx[i] = (vx_uint32)std::min(std::max((((vx_int32)(w[0] & 0xffff) << 5) + (i - first) * dx + 16) >> 5, 0), 0xfffe);
+			sy[i] = (vx_uint32)std::min(std::max((((vx_int32)(w[0] >> 16) << 5) + (i - first) * dy + 16) >> 5, 0), 0xfffe);
+		}
+		else {
+			sx[i] = sy[i] = 0xffff;
+		}
+	}
+}
+
+//! \brief Interpolate a pixel of the camera image at a Q13.3 or Q14.2 source location.
+//  Neighbors outside the camera buffer are clamped to its border.
+void WarpSamplePixel(const vx_uint8 * ip_buf, vx_uint32 ip_stride, vx_uint32 pixel_size, vx_uint32 width, vx_uint32 height,
+	vx_uint32 sx, vx_uint32 sy, vx_uint32 QF, bool useBilinearInterpolation, vx_float32 f[4])
+{
+	vx_float32 QFM = 1.0f / (1 << QF);
+	vx_int32 x0 = (vx_int32)(sx >> QF), y0 = (vx_int32)(sy >> QF);
+	vx_float32 fx = (sx & ((1 << QF) - 1)) * QFM, fy = (sy & ((1 << QF) - 1)) * QFM;
+	vx_int32 taps = 2;
+	vx_float32 wx[4] = { 1.0f - fx, fx }, wy[4] = { 1.0f - fy, fy };
+	if (!useBilinearInterpolation) {
+		// bicubic with the same coefficients as compute_bicubic_coeffs in OpenCL
+		taps = 4; x0--; y0--;
+		wx[0] = -0.5f*fx + fx*fx - 0.5f*fx*fx*fx; wx[1] = 1.0f - 2.5f*fx*fx + 1.5f*fx*fx*fx; wx[2] = 0.5f*fx + 2.0f*fx*fx - 1.5f*fx*fx*fx; wx[3] = 0.5f*(-fx*fx + fx*fx*fx);
+		wy[0] = -0.5f*fy + fy*fy - 0.5f*fy*fy*fy; wy[1] = 1.0f - 2.5f*fy*fy + 1.5f*fy*fy*fy; wy[2] = 0.5f*fy + 2.0f*fy*fy - 1.5f*fy*fy*fy; wy[3] = 0.5f*(-fy*fy + fy*fy*fy);
+	}
+	f[0] = f[1] = f[2] = f[3] = 0.0f;
+	for (vx_int32 j = 0; j < taps; j++) {
+		const vx_uint8 * row = ip_buf + std::min(std::max(y0 + j, 0), (vx_int32)height - 1) * ip_stride;
+		for (vx_int32 i = 0; i < taps; i++) {
+			const vx_uint8 * pt = row + std::min(std::max(x0 + i, 0), (vx_int32)width - 1) * pixel_size;
+			vx_float32 w = wx[i] * wy[j];
+			for (vx_uint32 c = 0; c < pixel_size; c++)
+				f[c] += pt[c] * w;
+		}
+	}
+}
+
+//! \brief The kernel execution: used with host execution and matches the OpenCL kernel.
 static vx_status VX_CALLBACK warp_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_SUPPORTED;
+	// get configuration
+	vx_enum grayscale_compute_method = STITCH_GRAY_SCALE_COMPUTE_METHOD_AVG;
+	vx_uint32 num_cameras = 0, num_camera_columns = 1;
+	vx_uint8 alpha = 0, flags = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &grayscale_compute_method));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[1], &num_cameras));
+	if (parameters[7]) {
+		ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[7], &num_camera_columns));
+	}
+	if (parameters[8]) {
+		ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[8], &alpha));
+	}
+	if (parameters[9]) {
+		ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[9], &flags));
+	}
+	bool useAlphaValue = parameters[8] ? true : false;
+	bool useBilinearInterpolation = (flags & 1) ? false : true;
+	vx_array valid_pix_arr = (vx_array)parameters[2];
+	vx_array warp_remap_arr = (vx_array)parameters[3];
+	vx_size numitems = 0, warp_remap_numitems = 0, valid_pix_itemsize = 0, warp_remap_itemsize = 0;
+	ERROR_CHECK_STATUS(vxQueryArray(valid_pix_arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &numitems, sizeof(numitems)));
+	ERROR_CHECK_STATUS(vxQueryArray(warp_remap_arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &warp_remap_numitems, sizeof(warp_remap_numitems)));
+	ERROR_CHECK_STATUS(vxQueryArray(valid_pix_arr, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &valid_pix_itemsize, sizeof(valid_pix_itemsize)));
+	ERROR_CHECK_STATUS(vxQueryArray(warp_remap_arr, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &warp_remap_itemsize, sizeof(warp_remap_itemsize)));
+	bool bCompactWarpRemap = (warp_remap_itemsize == sizeof(StitchWarpRemapCompactEntry));
+	bool bWideValidPixel = (valid_pix_itemsize == sizeof(StitchValidPixelWideEntry));
+	vx_uint32 QF = bWideValidPixel ? 2 : 3;
+	vx_image input_image = (vx_image)parameters[4];
+	vx_image output_image = (vx_image)parameters[5];
+	vx_image luma_image = (vx_image)parameters[6];
+	vx_uint32 input_width = 0, input_height = 0, output_width = 0, output_height = 0;
+	vx_df_image input_format = VX_DF_IMAGE_VIRT, output_format = VX_DF_IMAGE_VIRT;
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_WIDTH, &input_width, sizeof(input_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &input_height, sizeof(input_height)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_FORMAT, &input_format, sizeof(input_format)));
+	ERROR_CHECK_STATUS(vxQueryImage(output_image, VX_IMAGE_ATTRIBUTE_WIDTH, &output_width, sizeof(output_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(output_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &output_height, sizeof(output_height)));
+	ERROR_CHECK_STATUS(vxQueryImage(output_image, VX_IMAGE_ATTRIBUTE_FORMAT, &output_format, sizeof(output_format)));
+	vx_uint32 ip_pixel_size = (input_format == VX_DF_IMAGE_RGBX) ? 4 : 3;
+	vx_uint32 op_pixel_size = (output_format == VX_DF_IMAGE_RGBX) ? 4 : 3;
+	vx_uint32 ip_image_height_offs = input_height / num_cameras;
+	vx_uint32 op_image_height_offs = (flags & STITCH_WARP_FLAG_PACKED_OUTPUT) ? 0 : output_height / num_cameras;
+
+	// access images: output pixels not in the valid pixel table are left untouched, same as OpenCL
+	vx_rectangle_t ip_rect = { 0, 0, input_width, input_height }, op_rect = { 0, 0, output_width, output_height };
+	vx_imagepatch_addressing_t ip_addr, op_addr, luma_addr;
+	void * ip_ptr = nullptr, * op_ptr = nullptr, * luma_ptr = nullptr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(input_image, &ip_rect, 0, &ip_addr, &ip_ptr, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(output_image, &op_rect, 0, &op_addr, &op_ptr, VX_READ_AND_WRITE));
+	if (luma_image) {
+		ERROR_CHECK_STATUS(vxAccessImagePatch(luma_image, &op_rect, 0, &luma_addr, &luma_ptr, VX_READ_AND_WRITE));
+	}
+
+	if (numitems > 0) {
+		vx_size valid_pix_stride = 0, warp_remap_stride = 0;
+		vx_uint8 * valid_pix_buf = nullptr, * warp_remap_buf = nullptr;
+		ERROR_CHECK_STATUS(vxAccessArrayRange(valid_pix_arr, 0, numitems, &valid_pix_stride, (void **)&valid_pix_buf, VX_READ_ONLY));
+		// the whole warp remap table is accessed: escaped compact entries refer to the overflow area
+		ERROR_CHECK_STATUS(vxAccessArrayRange(warp_remap_arr, 0, warp_remap_numitems, &warp_remap_stride, (void **)&warp_remap_buf, VX_READ_ONLY));
+#pragma omp parallel for
+		for (int item = 0; item < (int)numitems; item++) {
+			// decode valid pixel entry
+			vx_uint32 pixelEntry[2] = { 0xffffffff, 0 };
+			memcpy(pixelEntry, valid_pix_buf + item * valid_pix_stride, bWideValidPixel ? 8 : 4);
+			if (pixelEntry[0] == 0xffffffff)
+				continue;
+			vx_uint32 camera_id, op_x, op_y;
+			if (bWideValidPixel) {
+				camera_id = pixelEntry[0] & 0xff; op_x = pixelEntry[1] & 0xffff; op_y = pixelEntry[1] >> 16;
+			}
+			else {
+				camera_id = pixelEntry[0] & 0x1f; op_x = (pixelEntry[0] >> 8) & 0x7ff; op_y = (pixelEntry[0] >> 19) & 0x1fff;
+			}
+			vx_uint32 sx[8], sy[8];
+			WarpRemapDecodeEntry(warp_remap_buf, warp_remap_buf + item * warp_remap_stride, bCompactWarpRemap, sx, sy);
+			// camera buffer of the entry and output row
+			vx_uint32 ip_row = (camera_id / num_camera_columns) * ip_image_height_offs;
+			const vx_uint8 * ip_buf = (const vx_uint8 *)ip_ptr + ip_row * ip_addr.stride_y;
+			vx_uint32 op_row = camera_id * op_image_height_offs + op_y;
+			vx_uint8 * op_buf = (vx_uint8 *)op_ptr + op_row * op_addr.stride_y;
+			vx_uint8 * luma_buf = luma_ptr ? (vx_uint8 *)luma_ptr + op_row * luma_addr.stride_y : nullptr;
+			for (vx_uint32 i = 0, x = op_x * 8; i < 8 && x < output_width; i++, x++) {
+				vx_float32 f[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+				bool isSrcInvalid = (sx[i] == 0xffff && sy[i] == 0xffff);
+				if (!isSrcInvalid) {
+					WarpSamplePixel(ip_buf, (vx_uint32)ip_addr.stride_y, ip_pixel_size, input_width, input_height - ip_row,
+						sx[i], sy[i], QF, useBilinearInterpolation, f);
+				}
+				if (ip_pixel_size == 3) {
+					if (useAlphaValue)
+						f[3] = (vx_float32)alpha;
+					else if (grayscale_compute_method == STITCH_GRAY_SCALE_COMPUTE_METHOD_AVG)
+						f[3] = (f[0] + f[1] + f[2]) * 0.3333333333f;
+					else
+						f[3] = sqrtf((f[0] * f[0] + f[1] * f[1] + f[2] * f[2]) * 0.3333333333f);
+				}
+				vx_uint8 * op = op_buf + x * op_pixel_size;
+				if (isSrcInvalid && op_pixel_size == 4) {
+					op[0] = op[1] = op[2] = 0; op[3] = 128;
+				}
+				else {
+					for (vx_uint32 c = 0; c < op_pixel_size; c++)
+						op[c] = StitchPackU8(f[c]);
+				}
+				if (luma_buf) {
+					luma_buf[x] = isSrcInvalid ? 0 : StitchPackU8(f[0] * 0.2126f + f[1] * 0.7152f + f[2] * 0.0722f);
+				}
+			}
+		}
+		ERROR_CHECK_STATUS(vxCommitArrayRange(valid_pix_arr, 0, numitems, valid_pix_buf));
+		ERROR_CHECK_STATUS(vxCommitArrayRange(warp_remap_arr, 0, warp_remap_numitems, warp_remap_buf));
+	}
+
+	ERROR_CHECK_STATUS(vxCommitImagePatch(input_image, &ip_rect, 0, &ip_addr, ip_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(output_image, &op_rect, 0, &op_addr, op_ptr));
+	if (luma_image) {
+		ERROR_CHECK_STATUS(vxCommitImagePatch(luma_image, &op_rect, 0, &luma_addr, luma_ptr));
+	}
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel publisher.
@@ -1963,8 +2196,8 @@ vx_status CalculateSmallestWarpBufferSizes(
 	vx_uint32 numCamera,                         // [in] number of cameras
 	vx_uint32 eqrWidth,                          // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                         // [in] output equirectangular image height
-	const vx_uint32 * validPixelCamMap,          // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
-	const vx_uint32 * paddedPixelCamMap,         // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,          // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * paddedPixelCamMap,         // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight]
 	vx_size * warpMapEntryCount                  // [out] number of entries needed by warp map table
 	)
 {
@@ -1974,7 +2207,7 @@ vx_status CalculateSmallestWarpBufferSizes(
 		for (vx_uint32 x_eqr = 0; x_eqr < eqrWidth; x_eqr += 8, pixelPosition += 8)
 		{
 			// get camera use mask for consecutive 8 pixels from current pixel position
-			vx_uint32 validMaskFor8Pixels =
+			vx_uint64 validMaskFor8Pixels =
 				validPixelCamMap[pixelPosition + 0] | validPixelCamMap[pixelPosition + 1] |
 				validPixelCamMap[pixelPosition + 2] | validPixelCamMap[pixelPosition + 3] |
 				validPixelCamMap[pixelPosition + 4] | validPixelCamMap[pixelPosition + 5] |
@@ -1997,34 +2230,81 @@ vx_status CalculateSmallestWarpBufferSizes(
 	return VX_SUCCESS;
 }
 
+//! \brief Round a fixed-point source coordinate into a remap entry field: 0xffff is reserved for invalid pixels.
+static inline vx_uint16 EncodeWarpRemapCoord(float value)
+{
+	return (vx_uint16)(value <= 0.0f ? 0.0f : (value >= 65534.0f ? 65534.0f : value + 0.5f));
+}
+
+//! \brief Encode the remap of 8 consecutive pixels as a compact entry: returns false when it can't be represented.
+//  srcX and srcY are the source coordinates of the 8 pixels in Q13.3 units (before rounding).
+static bool EncodeWarpRemapCompactEntry(const float * srcX, const float * srcY, vx_uint32 validMask, StitchWarpRemapCompactEntry * entry)
+{
+	vx_uint32 first = 0, last = 7;
+	while (!(validMask & (1 << first))) first++;
+	while (!(validMask & (1 << last))) last--;
+	// anchor at the first valid pixel and step from the first to the last valid pixel (Q3.8 is Q13.3 with 5 more bits)
+	vx_int32 x0 = (vx_int32)(srcX[first] + 0.5f), y0 = (vx_int32)(srcY[first] + 0.5f), dx = 0, dy = 0;
+	if (last > first) {
+		dx = (vx_int32)floorf((srcX[last] - srcX[first]) * 32.0f / (float)(last - first) + 0.5f);
+		dy = (vx_int32)floorf((srcY[last] - srcY[first]) * 32.0f / (float)(last - first) + 0.5f);
+	}
+	if (x0 < 0 || x0 > 0xfffe || y0 < 0 || y0 > 0xfffe || dx < -2047 || dx > 2047 || dy < -2048 || dy > 2047)
+		return false;
+	// check reconstruction error of all valid pixels using the same arithmetic as the warp kernel
+	for (vx_uint32 i = first; i <= last; i++) {
+		if (validMask & (1 << i)) {
+			vx_int32 k = (vx_int32)(i - first);
+			vx_int32 x = ((x0 << 5) + k * dx + 16) >> 5, y = ((y0 << 5) + k * dy + 16) >> 5;
+			if (x < 0 || x > 0xfffe || y < 0 || y > 0xfffe ||
+				fabsf((float)x - srcX[i]) > STITCH_WARP_COMPACT_MAX_ERROR || fabsf((float)y - srcY[i]) > STITCH_WARP_COMPACT_MAX_ERROR)
+				return false;
+		}
+	}
+	entry->srcX = (vx_uint16)x0;
+	entry->srcY = (vx_uint16)y0;
+	entry->validMask = validMask;
+	entry->deltaX = (vx_uint32)dx & 0xfff;
+	entry->deltaY = (vx_uint32)dy & 0xfff;
+	return true;
+}
+
 vx_status GenerateWarpBuffers(
 	vx_uint32 numCamera,                         // [in] number of cameras
 	vx_uint32 eqrWidth,                          // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                         // [in] output equirectangular image height
-	const vx_uint32 * validPixelCamMap,          // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
-	const vx_uint32 * paddedPixelCamMap,         // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,          // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * paddedPixelCamMap,         // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight]
 	const StitchCoord2dFloat * camSrcMap,        // [in] camera coordinate mapping: size: [numCamera * eqrWidth * eqrHeight] (optional)
 	vx_uint32 numCameraColumns,                  // [in] number of camera columns
 	vx_uint32 camWidth,                          // [in] input camera image width
 	vx_size   mapTableSize,                      // [in] size of warp/valid map table, in terms of number of entries
-	StitchValidPixelEntry * validMap,            // [in] valid map table
-	StitchWarpRemapEntry * warpMap,              // [in] warp map table
-	vx_size * mapEntryCount                      // [out] number of entries added to warp/valid map table
+	StitchValidPixelEntry * validMap,            // [in] valid map table (NULL when validMapWide is used)
+	StitchValidPixelWideEntry * validMapWide,    // [in] wide valid map table (NULL when validMap is used)
+	StitchWarpRemapEntry * warpMap,              // [in] warp map table (NULL when warpMapCompact is used)
+	StitchWarpRemapCompactEntry * warpMapCompact, // [in] compact warp map table (NULL when warpMap is used)
+	vx_size * mapEntryCount,                     // [out] number of entries added to warp/valid map table
+	vx_size * warpMapCompactCount                // [out] number of entries in compact warp map table including overflow area (optional)
 	)
 {
+	// wide tables use Q14.2 source coordinates; compact warp map table is only supported with Q13.3
+	if (validMapWide && warpMapCompact)
+		return VX_ERROR_NOT_SUPPORTED;
+	float srcScale = validMapWide ? 4.0f : 8.0f;
 	vx_uint32  entryCount = 0;
+	vx_size overflowCount = 0, overflowCapacity = STITCH_WARP_COMPACT_OVERFLOW_SIZE(mapTableSize) / 4;
 	for (vx_uint32 camId = 0; camId < numCamera; camId++)
 	{
-		float xSrcOffset = (float)((camId % numCameraColumns) * camWidth) * 8.0f;
-		vx_uint32 camMapBit = 1 << camId;
+		float xSrcOffset = (float)((camId % numCameraColumns) * camWidth) * srcScale;
+		vx_uint64 camMapBit = StitchCameraBit(camId);
 		const StitchCoord2dFloat * camSrcMapCurrent = camSrcMap + camId * eqrWidth * eqrHeight;
 		for (vx_uint32 y_eqr = 0, pixelPosition = 0; y_eqr < eqrHeight; y_eqr++)
 		{
 			for (vx_uint32 x_eqr = 0; x_eqr < eqrWidth; x_eqr += 8, pixelPosition += 8)
 			{
 				// get camera use mask for consecutive 8 pixels from current pixel position
-				vx_uint32 validMask[8];
-				vx_uint32 validMaskFor8Pixels = 0;
+				vx_uint64 validMask[8];
+				vx_uint64 validMaskFor8Pixels = 0;
 				if (paddedPixelCamMap) {
 					for (vx_uint32 i = 0; i < 8; i++) {
 						validMask[i] = validPixelCamMap[pixelPosition + i] | paddedPixelCamMap[pixelPosition + i];
@@ -2042,22 +2322,62 @@ vx_status GenerateWarpBuffers(
 					if (entryCount < mapTableSize)
 					{
 						// get mask to check if all pixels are valid and set validMap entry
-						vx_uint32 allValidMaskFor8Pixels = validMask[0];
+						vx_uint64 allValidMaskFor8Pixels = validMask[0];
 						for (vx_uint32 i = 1; i < 8; i++) {
 							allValidMaskFor8Pixels &= validMask[i];
 						}
-						StitchValidPixelEntry validEntry = { 0 };
-						validEntry.camId = camId;
-						validEntry.allValid = (allValidMaskFor8Pixels & camMapBit) ? 1 : 0;
-						validEntry.dstX = x_eqr >> 3;
-						validEntry.dstY = y_eqr;
-						validMap[entryCount] = validEntry;
-						// set warpMap entry: NOTE: assumes that current structure of StitchWarpRemapEntry to be consetive (x,y) value pairs
+						if (validMapWide) {
+							StitchValidPixelWideEntry validEntry = { 0 };
+							validEntry.camId = camId;
+							validEntry.allValid = (allValidMaskFor8Pixels & camMapBit) ? 1 : 0;
+							validEntry.dstX = x_eqr >> 3;
+							validEntry.dstY = y_eqr;
+							validMapWide[entryCount] = validEntry;
+						}
+						else {
+							StitchValidPixelEntry validEntry = { 0 };
+							validEntry.camId = camId;
+							validEntry.allValid = (allValidMaskFor8Pixels & camMapBit) ? 1 : 0;
+							validEntry.dstX = x_eqr >> 3;
+							validEntry.dstY = y_eqr;
+							validMap[entryCount] = validEntry;
+						}
 						const StitchCoord2dFloat * srcEntry = &camSrcMapCurrent[pixelPosition];
-						vx_uint16 * warpEntry = (vx_uint16 *)&warpMap[entryCount];
-						for (vx_uint32 i = 0; i < 8; i++, warpEntry += 2, srcEntry++) {
-							warpEntry[0] = !(validMask[i] & camMapBit) ? (vx_uint16)0xffff : (vx_uint16)(srcEntry->x * 8.0f + 0.5f + xSrcOffset);
-							warpEntry[1] = !(validMask[i] & camMapBit) ? (vx_uint16)0xffff : (vx_uint16)(srcEntry->y * 8.0f + 0.5f);
+						if (warpMapCompact) {
+							// set compact warpMap entry
+							float srcX[8], srcY[8];
+							vx_uint32 validMaskCompact = 0;
+							for (vx_uint32 i = 0; i < 8; i++, srcEntry++) {
+								srcX[i] = srcEntry->x * 8.0f + xSrcOffset;
+								srcY[i] = srcEntry->y * 8.0f;
+								if (validMask[i] & camMapBit) validMaskCompact |= (1 << i);
+							}
+							if (!EncodeWarpRemapCompactEntry(srcX, srcY, validMaskCompact, &warpMapCompact[entryCount])) {
+								// escape: keep the full entry in the overflow area after the map table
+								if (overflowCount >= overflowCapacity)
+									return VX_ERROR_NOT_SUPPORTED;
+								vx_uint32 index = (vx_uint32)(mapTableSize + overflowCount * 4);
+								vx_uint16 * warpEntry = (vx_uint16 *)&warpMapCompact[index];
+								for (vx_uint32 i = 0; i < 8; i++, warpEntry += 2) {
+									warpEntry[0] = !(validMaskCompact & (1 << i)) ? (vx_uint16)0xffff : EncodeWarpRemapCoord(srcX[i]);
+									warpEntry[1] = !(validMaskCompact & (1 << i)) ? (vx_uint16)0xffff : EncodeWarpRemapCoord(srcY[i]);
+								}
+								StitchWarpRemapCompactEntry escapeEntry = { 0 };
+								escapeEntry.srcX = (vx_uint16)(index & 0xffff);
+								escapeEntry.srcY = (vx_uint16)(index >> 16);
+								escapeEntry.validMask = validMaskCompact;
+								escapeEntry.deltaX = STITCH_WARP_COMPACT_ESCAPE;
+								warpMapCompact[entryCount] = escapeEntry;
+								overflowCount++;
+							}
+						}
+						else {
+							// set warpMap entry: NOTE: assumes that current structure of StitchWarpRemapEntry to be consetive (x,y) value pairs
+							vx_uint16 * warpEntry = (vx_uint16 *)&warpMap[entryCount];
+							for (vx_uint32 i = 0; i < 8; i++, warpEntry += 2, srcEntry++) {
+								warpEntry[0] = !(validMask[i] & camMapBit) ? (vx_uint16)0xffff : EncodeWarpRemapCoord(srcEntry->x * srcScale + xSrcOffset);
+								warpEntry[1] = !(validMask[i] & camMapBit) ? (vx_uint16)0xffff : EncodeWarpRemapCoord(srcEntry->y * srcScale);
+							}
 						}
 					}
 					entryCount++;
@@ -2067,16 +2387,24 @@ vx_status GenerateWarpBuffers(
 	}
 
 	while (entryCount < mapTableSize) {
-		vx_uint32 * validEntry = (vx_uint32 *) &validMap[entryCount];
+		vx_uint32 * validEntry = validMapWide ? (vx_uint32 *) &validMapWide[entryCount] : (vx_uint32 *) &validMap[entryCount];
 		*validEntry = 0xFFFFFFFF;
 
-		vx_uint16 * warpEntry = (vx_uint16 *)&warpMap[entryCount];
-		for (int i = 0; i < 16; i++)	
-			warpEntry[i] = (vx_uint16)0xffff;
+		if (warpMapCompact) {
+			StitchWarpRemapCompactEntry invalidEntry = { 0 };
+			warpMapCompact[entryCount] = invalidEntry;
+		}
+		else {
+			vx_uint16 * warpEntry = (vx_uint16 *)&warpMap[entryCount];
+			for (int i = 0; i < 16; i++)
+				warpEntry[i] = (vx_uint16)0xffff;
+		}
 
 		entryCount++;
 	}
 	*mapEntryCount = entryCount;
+	if (warpMapCompactCount)
+		*warpMapCompactCount = warpMapCompact ? mapTableSize + overflowCount * 4 : entryCount;
 
 	// check for buffer overflow error condition
 	if (entryCount > mapTableSize) {
@@ -2085,3 +2413,172 @@ vx_status GenerateWarpBuffers(
 
 	return VX_SUCCESS;
 }
+
+vx_status CalculatePackedCameraPlanes(
+	vx_uint32 numCamera,                         // [in] number of cameras
+	vx_uint32 eqrWidth,                          // [in] output equirectangular image width
+	vx_uint32 eqrHeight,                         // [in] output equirectangular image height
+	const vx_rectangle_t * const * cameraRect,   // [in] camera bounding rectangles: cameraRect[cam][cam] (end inclusive)
+	StitchCameraPlaneEntry * cameraPlane,        // [out] camera planes: size: [numCamera]
+	vx_uint32 * packedWidth,                     // [out] width of packed images
+	vx_uint32 * packedHeight                     // [out] height of packed images (for all cameras)
+	)
+{
+	vx_uint32 width = 8, height = 0;
+	for (vx_uint32 camId = 0; camId < numCamera; camId++) {
+		const vx_rectangle_t& rect = cameraRect[camId][camId];
+		if (rect.start_x > rect.end_x || rect.start_y > rect.end_y || rect.end_x >= eqrWidth || rect.end_y >= eqrHeight) {
+			// camera doesn't contribute to the output
+			cameraPlane[camId].offsetX = 0;
+			cameraPlane[camId].offsetY = 0;
+			cameraPlane[camId].width = 0;
+			cameraPlane[camId].height = 0;
+			continue;
+		}
+		// warp writes and merge reads camera pixels in groups of 8
+		vx_uint32 x0 = rect.start_x & ~7, x1 = (rect.end_x + 8) & ~7;
+		cameraPlane[camId].offsetX = -(vx_int32)x0;
+		cameraPlane[camId].offsetY = (vx_int32)height - (vx_int32)rect.start_y;
+		cameraPlane[camId].width = x1 - x0;
+		cameraPlane[camId].height = rect.end_y + 1 - rect.start_y;
+		width = std::max(width, x1 - x0);
+		height += cameraPlane[camId].height;
+	}
+	*packedWidth = width;
+	*packedHeight = std::max(height, 1u);
+	return VX_SUCCESS;
+}
+
+vx_status CalculateRowPackedCameraPlanes(
+	vx_uint32 numCamera,                         // [in] number of cameras
+	vx_uint32 eqrWidth,                          // [in] output equirectangular image width
+	vx_uint32 eqrHeight,                         // [in] output equirectangular image height
+	const vx_rectangle_t * const * cameraRect,   // [in] camera bounding rectangles: cameraRect[cam][cam] (end inclusive)
+	vx_uint32 rowAlign,                          // [in] alignment of first output row of camera planes (power of 2)
+	vx_uint32 rowMargin,                         // [in] rows kept above and below camera bounding rectangles
+	StitchCameraPlaneEntry * cameraPlane,        // [out] camera planes: size: [numCamera]
+	vx_uint32 * packedWidth,                     // [out] width of packed images
+	vx_uint32 * packedHeight                     // [out] height of packed images (for all cameras)
+	)
+{
+	if (!rowAlign || (rowAlign & (rowAlign - 1)))
+		return VX_ERROR_INVALID_PARAMETERS;
+	// bounding rows of each camera with margin: start rows aligned to rowAlign
+	std::vector<vx_int32> startY(numCamera, 0);
+	vx_int32 height = 1;
+	for (vx_uint32 camId = 0; camId < numCamera; camId++) {
+		const vx_rectangle_t& rect = cameraRect[camId][camId];
+		if (rect.start_x > rect.end_x || rect.start_y > rect.end_y || rect.end_x >= eqrWidth || rect.end_y >= eqrHeight)
+			continue; // camera doesn't contribute to the output
+		vx_int32 y0 = std::max(0, (vx_int32)rect.start_y - (vx_int32)rowMargin) & ~(vx_int32)(rowAlign - 1);
+		vx_int32 y1 = std::min((vx_int32)eqrHeight, (vx_int32)(rect.end_y + 1 + rowMargin));
+		startY[camId] = y0;
+		height = std::max(height, y1 - y0);
+	}
+	// all camera planes have same height: keep rows below the last plane start aligned, so that a plane
+	// moved up to fit into the output ends at its last row
+	height = (vx_int32)eqrHeight - (((vx_int32)eqrHeight - height) & ~(vx_int32)(rowAlign - 1));
+	for (vx_uint32 camId = 0; camId < numCamera; camId++) {
+		vx_int32 y0 = std::min(startY[camId], (vx_int32)eqrHeight - height);
+		cameraPlane[camId].offsetX = 0;
+		cameraPlane[camId].offsetY = (vx_int32)camId * height - y0;
+		cameraPlane[camId].width = eqrWidth;
+		cameraPlane[camId].height = (vx_uint32)height;
+	}
+	*packedWidth = eqrWidth;
+	*packedHeight = (vx_uint32)height * numCamera;
+	return VX_SUCCESS;
+}
+
+vx_status PackCameraPlaneRows(
+	vx_uint32 numCamera,                         // [in] number of cameras
+	vx_uint32 eqrHeight,                         // [in] output equirectangular image height
+	const StitchCameraPlaneEntry * cameraPlane,  // [in] camera planes: size: [numCamera]
+	vx_uint32 pixelSize,                         // [in] size of a pixel in bytes
+	vx_uint32 srcStride,                         // [in] stride (in bytes) of full camera plane image
+	const vx_uint8 * srcBuf,                     // [in] full camera plane image: size: [eqrHeight * numCamera] rows
+	vx_uint32 dstStride,                         // [in] stride (in bytes) of packed image
+	vx_uint8 * dstBuf                            // [out] packed image
+	)
+{
+	// camera planes are stacked vertically in camera order
+	vx_int32 yp = 0;
+	for (vx_uint32 camId = 0; camId < numCamera; camId++) {
+		const StitchCameraPlaneEntry& plane = cameraPlane[camId];
+		for (vx_uint32 i = 0; i < plane.height; i++, yp++) {
+			vx_int32 y = yp - plane.offsetY;
+			if (y < 0 || y >= (vx_int32)eqrHeight || plane.offsetX > 0)
+				return VX_ERROR_INVALID_PARAMETERS;
+			memcpy(dstBuf + yp * dstStride, srcBuf + (camId * eqrHeight + y) * srcStride - plane.offsetX * pixelSize, plane.width * pixelSize);
+		}
+	}
+	return VX_SUCCESS;
+}
+
+vx_status GetCameraPlaneRows(vx_array cameraPlaneArray, vx_uint32 numCamera, vx_uint32 height1, std::vector<vx_int32>& camRow)
+{
+	camRow.resize(numCamera);
+	for (vx_uint32 camId = 0; camId < numCamera; camId++)
+		camRow[camId] = (vx_int32)(camId * height1);
+	if (cameraPlaneArray) {
+		vx_size numitems = 0;
+		ERROR_CHECK_STATUS(vxQueryArray(cameraPlaneArray, VX_ARRAY_ATTRIBUTE_NUMITEMS, &numitems, sizeof(numitems)));
+		if (numitems < numCamera)
+			return VX_ERROR_INVALID_DIMENSION;
+		std::vector<StitchCameraPlaneEntry> plane(numCamera);
+		ERROR_CHECK_STATUS(vxCopyArrayRange(cameraPlaneArray, 0, numCamera, sizeof(StitchCameraPlaneEntry), plane.data(), VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
+		for (vx_uint32 camId = 0; camId < numCamera; camId++)
+			camRow[camId] = plane[camId].offsetY;
+	}
+	return VX_SUCCESS;
+}
+
+const char * GetCameraPlaneOpenCLArgs(bool packed)
+{
+	return packed ? ",\n        __global uchar * cp_buf, uint cp_offset, uint cp_num_items" : "";
+}
+
+std::string GetCameraPlaneOpenCLMacros(bool packed, const char * height1)
+{
+	if (packed)
+		return "#define CAM_ROW(c) (((__global int4 *)(cp_buf + cp_offset))[c].s1)\n";
+	return std::string("#define CAM_ROW(c) ((int)(c) * (int)(") + height1 + "))\n";
+}
+
+vx_status PackWarpBuffers(
+	vx_uint32 numCamera,                         // [in] number of cameras
+	const StitchCameraPlaneEntry * cameraPlane,  // [in] camera planes: size: [numCamera]
+	vx_size   mapEntryCount,                     // [in] number of entries in warp/valid map table
+	StitchValidPixelEntry * validMap,            // [in/out] valid map table (NULL when validMapWide is used)
+	StitchValidPixelWideEntry * validMapWide     // [in/out] wide valid map table (NULL when validMap is used)
+	)
+{
+	for (vx_size i = 0; i < mapEntryCount; i++) {
+		vx_uint32 camId, dstX, dstY;
+		if (validMapWide) {
+			if (*(vx_uint32 *)&validMapWide[i] == 0xFFFFFFFF) continue;
+			camId = validMapWide[i].camId; dstX = validMapWide[i].dstX; dstY = validMapWide[i].dstY;
+		}
+		else {
+			if (*(vx_uint32 *)&validMap[i] == 0xFFFFFFFF) continue;
+			camId = validMap[i].camId; dstX = validMap[i].dstX; dstY = validMap[i].dstY;
+		}
+		if (camId >= numCamera)
+			return VX_ERROR_INVALID_PARAMETERS;
+		vx_int32 x = (vx_int32)(dstX << 3) + cameraPlane[camId].offsetX;
+		vx_int32 y = (vx_int32)dstY + cameraPlane[camId].offsetY;
+		if (x < 0 || y < 0 || x >= (vx_int32)cameraPlane[camId].width)
+			return VX_ERROR_INVALID_PARAMETERS;
+		if (validMapWide) {
+			if (y > 0xffff) return VX_ERROR_NOT_SUPPORTED;
+			validMapWide[i].dstX = x >> 3;
+			validMapWide[i].dstY = y;
+		}
+		else {
+			if (y >= STITCH_WARP_COMPACT_MAX_DST_HEIGHT) return VX_ERROR_NOT_SUPPORTED;
+			validMap[i].dstX = x >> 3;
+			validMap[i].dstY = y;
+		}
+	}
+	return VX_SUCCESS;
+}
@@ -45,6 +45,19 @@ typedef struct {
 	vx_uint32 dstY      : 13; // destination pixel y-coordinate   (integer)
 } StitchValidPixelEntry;
 
+//////////////////////////////////////////////////////////////////////
+//! \brief The wide valid pixel entry for 8 consecutive pixel locations.
+//  Used instead of StitchValidPixelEntry when the output or camera buffers exceed the limits of the compact tables.
+//  The warp remap entries are in Q14.2 format instead of Q13.3 when wide valid pixel entries are used.
+//  For dummy entries in the buffer for alignment to 32 items, the invalid items shall have first word as (vx_uint32)0xFFFFFFFF
+typedef struct {
+	vx_uint32 camId     :  8; // destination buffer/camera ID
+	vx_uint32 reserved0 : 23; // reserved (shall be zero)
+	vx_uint32 allValid  :  1; // all 8 consecutive pixels are valid
+	vx_uint32 dstX      : 16; // destination pixel x-coordinate/8 (integer)
+	vx_uint32 dstY      : 16; // destination pixel y-coordinate   (integer)
+} StitchValidPixelWideEntry;
+
 //////////////////////////////////////////////////////////////////////
 //! \brief The warp pixel remap entry for 8 consecutive pixel locations.
 //  Entry is invalid if srcX and srcY has all bits set to 1s.
@@ -69,15 +82,112 @@ typedef struct {
 	vx_uint16 srcY7;
 } StitchWarpRemapEntry;
 
+//////////////////////////////////////////////////////////////////////
+//! \brief The compact warp pixel remap entry for 8 consecutive pixel locations.
+//  Source coordinates are reconstructed in the warp kernel along a line through the first valid pixel:
+//     src(i) = (srcX,srcY) + (i - first) * (deltaX,deltaY), where first is the lowest bit set in validMask
+//  Entry is invalid if validMask is zero.
+//  Entries that don't fit a line are escaped: deltaX is STITCH_WARP_COMPACT_ESCAPE and (srcY << 16 | srcX) is the index
+//  of a StitchWarpRemapEntry stored in 4 consecutive compact entries of the overflow area after the map table.
+//  Below fixed-point representations are used:
+//     srcX, srcY     : Q13.3
+//     deltaX, deltaY : Q3.8 (signed, two's complement)
+typedef struct {
+	vx_uint16 srcX;           // source pixel (x,y) for the first valid pixel in Q13.3 format
+	vx_uint16 srcY;
+	vx_uint32 validMask :  8; // bit i is set when (dstX*8+i,dstY) is valid
+	vx_uint32 deltaX    : 12; // source pixel x step per destination pixel in Q3.8 format
+	vx_uint32 deltaY    : 12; // source pixel y step per destination pixel in Q3.8 format
+} StitchWarpRemapCompactEntry;
+
+//////////////////////////////////////////////////////////////////////
+//! \brief The warp remap table formats
+enum {
+	STITCH_WARP_TABLE_FORMAT_FULL    = 0, // StitchWarpRemapEntry: 32 bytes for 8 pixels
+	STITCH_WARP_TABLE_FORMAT_COMPACT = 1, // StitchWarpRemapCompactEntry: 8 bytes for 8 pixels
+};
+
+//////////////////////////////////////////////////////////////////////
+//! \brief The largest error allowed in compact warp remap entries, in Q13.3 units
+#define STITCH_WARP_COMPACT_MAX_ERROR  1.0f
+
+//////////////////////////////////////////////////////////////////////
+//! \brief The escaped compact warp remap entries and their overflow area
+#define STITCH_WARP_COMPACT_ESCAPE     0x800 // deltaX of escaped entries (Q3.8 steps use -2047..2047)
+#define STITCH_WARP_COMPACT_OVERFLOW_SIZE(mapTableSize) \
+	(((((vx_size)(mapTableSize)) >> 5) + 64) * 4) // compact entries after the map table: room for 1/32 of the entries + 64
+
+//////////////////////////////////////////////////////////////////////
+//! \brief The limits of compact valid pixel entries and Q13.3 warp remap entries
+#define STITCH_WARP_COMPACT_MAX_DST_WIDTH    16384 // StitchValidPixelEntry::dstX has 11 bits for x/8
+#define STITCH_WARP_COMPACT_MAX_DST_HEIGHT    8192 // StitchValidPixelEntry::dstY has 13 bits
+#define STITCH_WARP_COMPACT_MAX_SRC_SIZE      8191 // Q13.3 of the whole camera buffer, clamped to 0xfffe (0xffff marks invalid pixels)
+#define STITCH_WARP_WIDE_MAX_SRC_SIZE        16383 // Q14.2 of the whole camera buffer, clamped to 0xfffe (0xffff marks invalid pixels)
+#define STITCH_WARP_COMPACT_MAX_CAMERAS         31 // compact entries have 5-bit camera IDs (31 marks invalid)
+
+//////////////////////////////////////////////////////////////////////
+//! \brief The camera plane within packed per-camera intermediate images.
+//  Packed images hold only the bounding box of each camera, stacked vertically, instead of
+//  full output size planes: output pixel (x,y) of a camera is at (x + offsetX, y + offsetY).
+typedef struct {
+	vx_int32  offsetX;    // x offset of camera plane (multiple of 8)
+	vx_int32  offsetY;    // y offset of camera plane
+	vx_uint32 width;      // width of camera plane (multiple of 8)
+	vx_uint32 height;     // height of camera plane
+} StitchCameraPlaneEntry;
+
+//! \brief The camera plane rows for kernels with an optional camera plane array: output row y of camera c is
+//  at image row y + camRow[c]; without camera plane array camRow[c] is c * height1 (full camera planes).
+vx_status GetCameraPlaneRows(vx_array cameraPlaneArray, vx_uint32 numCamera, vx_uint32 height1, std::vector<vx_int32>& camRow);
+
+//! \brief The OpenCL kernel arguments of an optional camera plane array and the CAM_ROW(c) macro that gives
+//  the image row of output row 0 of camera c: height1 is the OpenCL expression of full camera plane height.
+const char * GetCameraPlaneOpenCLArgs(bool packed);
+std::string GetCameraPlaneOpenCLMacros(bool packed, const char * height1);
+
+//////////////////////////////////////////////////////////////////////
+//! \brief The warp flags
+#define STITCH_WARP_FLAG_PACKED_OUTPUT    0x02 // valid pixel entries have packed camera plane locations
+
 //////////////////////////////////////////////////////////////////////
 //! \brief The kernel registration functions.
 vx_status warp_publish(vx_context context);
 
+//////////////////////////////////////////////////////////////////////
+// Host helpers of the warp and warp merge CPU kernels
+//   WarpRemapDecodeEntry             - source locations of the 8 pixels of a full or compact (incl. escaped) entry;
+//                                      invalid pixels are set to 0xffff
+//   WarpSamplePixel                  - interpolate a camera pixel at a Q13.3 or Q14.2 source location
+
+void WarpRemapDecodeEntry(
+	const vx_uint8 * warp_remap_buf,             // [in] warp remap table (overflow area of escaped compact entries)
+	const vx_uint8 * entry,                      // [in] warp remap entry
+	bool bCompactWarpRemap,                      // [in] entry is a StitchWarpRemapCompactEntry
+	vx_uint32 sx[8],                             // [out] source x of the 8 pixels
+	vx_uint32 sy[8]                              // [out] source y of the 8 pixels
+	);
+
+void WarpSamplePixel(
+	const vx_uint8 * ip_buf,                     // [in] camera buffer
+	vx_uint32 ip_stride,                         // [in] camera buffer stride (in bytes)
+	vx_uint32 pixel_size,                        // [in] 3 for RGB, 4 for RGBX
+	vx_uint32 width,                             // [in] camera buffer width
+	vx_uint32 height,                            // [in] camera buffer height
+	vx_uint32 sx,                                // [in] source x
+	vx_uint32 sy,                                // [in] source y
+	vx_uint32 QF,                                // [in] fractional bits of source location
+	bool useBilinearInterpolation,               // [in] bilinear, otherwise bicubic
+	vx_float32 f[4]                              // [out] interpolated pixel
+	);
+
 //////////////////////////////////////////////////////////////////////
 // Calculate buffer sizes and generate data in buffers for warp
 //   CalculateLargestWarpBufferSizes  - useful when reinitialize is enabled
 //   CalculateSmallestWarpBufferSizes - useful when reinitialize is disabled
-//   GenerateWarpBuffers              - generate tables
+//   GenerateWarpBuffers              - generate tables: warpMapCompact needs room for mapTableSize entries plus
+//                                      STITCH_WARP_COMPACT_OVERFLOW_SIZE(mapTableSize) entries for escaped entries;
+//                                      returns VX_ERROR_NOT_SUPPORTED when the overflow area is full;
+//                                      warpMap is in Q14.2 format when validMapWide is used
 
 vx_status CalculateLargestWarpBufferSizes(
 	vx_uint32 numCamera,                  // [in] number of cameras
@@ -90,8 +200,8 @@ vx_status CalculateSmallestWarpBufferSizes(
 	vx_uint32 numCamera,                         // [in] number of cameras
 	vx_uint32 eqrWidth,                          // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                         // [in] output equirectangular image height
-	const vx_uint32 * validPixelCamMap,          // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
-	const vx_uint32 * paddedPixelCamMap,         // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,          // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * paddedPixelCamMap,         // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight]
 	vx_size * warpMapEntryCount                  // [out] number of entries needed by warp map table
 	);
 
@@ -99,15 +209,69 @@ vx_status GenerateWarpBuffers(
 	vx_uint32 numCamera,                         // [in] number of cameras
 	vx_uint32 eqrWidth,                          // [in] output equirectangular image width
 	vx_uint32 eqrHeight,                         // [in] output equirectangular image height
-	const vx_uint32 * validPixelCamMap,          // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
-	const vx_uint32 * paddedPixelCamMap,         // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * validPixelCamMap,          // [in] valid pixel camera index map: size: [eqrWidth * eqrHeight]
+	const vx_uint64 * paddedPixelCamMap,         // [in] padded pixel camera index map: size: [eqrWidth * eqrHeight]
 	const StitchCoord2dFloat * camSrcMap,        // [in] camera coordinate mapping: size: [numCamera * eqrWidth * eqrHeight] (optional)
 	vx_uint32 numCameraColumns,                  // [in] number of camera columns
 	vx_uint32 camWidth,                          // [in] input camera image width
 	vx_size   mapTableSize,                      // [in] size of warp/valid map table, in terms of number of entries
-	StitchValidPixelEntry * validMap,            // [in] valid map table
-	StitchWarpRemapEntry * warpMap,              // [in] warp map table
-	vx_size * mapEntryCount                      // [out] number of entries added to warp/valid map table
+	StitchValidPixelEntry * validMap,            // [in] valid map table (NULL when validMapWide is used)
+	StitchValidPixelWideEntry * validMapWide,    // [in] wide valid map table (NULL when validMap is used)
+	StitchWarpRemapEntry * warpMap,              // [in] warp map table (NULL when warpMapCompact is used)
+	StitchWarpRemapCompactEntry * warpMapCompact, // [in] compact warp map table (NULL when warpMap is used)
+	vx_size * mapEntryCount,                     // [out] number of entries added to warp/valid map table
+	vx_size * warpMapCompactCount                // [out] number of entries in compact warp map table including overflow area (optional)
+	);
+
+//////////////////////////////////////////////////////////////////////
+// Calculate packed camera planes and move warp output into packed camera planes
+//   CalculatePackedCameraPlanes      - camera planes from bounding rectangles of each camera
+//   CalculateRowPackedCameraPlanes   - camera planes of full width and same height from bounding rows of each camera:
+//                                      used when kernels filter or pair camera planes (exposure comp, seamfind and
+//                                      multiband blend), so that they keep height1 = height / numCamera and the rows
+//                                      within rowMargin of each camera are same as in full camera planes
+//   PackCameraPlaneRows              - copy camera planes from a full camera plane image into a packed image
+//   PackWarpBuffers                  - update valid pixel entries with locations in packed camera planes
+
+vx_status CalculatePackedCameraPlanes(
+	vx_uint32 numCamera,                         // [in] number of cameras
+	vx_uint32 eqrWidth,                          // [in] output equirectangular image width
+	vx_uint32 eqrHeight,                         // [in] output equirectangular image height
+	const vx_rectangle_t * const * cameraRect,   // [in] camera bounding rectangles: cameraRect[cam][cam] (end inclusive)
+	StitchCameraPlaneEntry * cameraPlane,        // [out] camera planes: size: [numCamera]
+	vx_uint32 * packedWidth,                     // [out] width of packed images
+	vx_uint32 * packedHeight                     // [out] height of packed images (for all cameras)
+	);
+
+vx_status CalculateRowPackedCameraPlanes(
+	vx_uint32 numCamera,                         // [in] number of cameras
+	vx_uint32 eqrWidth,                          // [in] output equirectangular image width
+	vx_uint32 eqrHeight,                         // [in] output equirectangular image height
+	const vx_rectangle_t * const * cameraRect,   // [in] camera bounding rectangles: cameraRect[cam][cam] (end inclusive)
+	vx_uint32 rowAlign,                          // [in] alignment of first output row of camera planes (power of 2)
+	vx_uint32 rowMargin,                         // [in] rows kept above and below camera bounding rectangles
+	StitchCameraPlaneEntry * cameraPlane,        // [out] camera planes: size: [numCamera]
+	vx_uint32 * packedWidth,                     // [out] width of packed images
+	vx_uint32 * packedHeight                     // [out] height of packed images (for all cameras)
+	);
+
+vx_status PackCameraPlaneRows(
+	vx_uint32 numCamera,                         // [in] number of cameras
+	vx_uint32 eqrHeight,                         // [in] output equirectangular image height
+	const StitchCameraPlaneEntry * cameraPlane,  // [in] camera planes: size: [numCamera]
+	vx_uint32 pixelSize,                         // [in] size of a pixel in bytes
+	vx_uint32 srcStride,                         // [in] stride (in bytes) of full camera plane image
+	const vx_uint8 * srcBuf,                     // [in] full camera plane image: size: [eqrHeight * numCamera] rows
+	vx_uint32 dstStride,                         // [in] stride (in bytes) of packed image
+	vx_uint8 * dstBuf                            // [out] packed image
+	);
+
+vx_status PackWarpBuffers(
+	vx_uint32 numCamera,                         // [in] number of cameras
+	const StitchCameraPlaneEntry * cameraPlane,  // [in] camera planes: size: [numCamera]
+	vx_size   mapEntryCount,                     // [in] number of entries in warp/valid map table
+	StitchValidPixelEntry * validMap,            // [in/out] valid map table (NULL when validMapWide is used)
+	StitchValidPixelWideEntry * validMapWide     // [in/out] wide valid map table (NULL when validMap is used)
 	);
 
 #endif //__WARP_H__
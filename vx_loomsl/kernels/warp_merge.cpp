@@ -0,0 +1,670 @@
+/*
+Copyright (c) 2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "warp_merge.h"
+#include <vector>
+
+//! \brief The input validator callback.
+static vx_status VX_CALLBACK warp_merge_input_validator(vx_node node, vx_uint32 index)
+{
+	vx_status status = VX_ERROR_INVALID_PARAMETERS;
+	// get reference for parameter at specified index
+	vx_reference ref = avxGetNodeParamRef(node, index);
+	if (index == 7 || index == 8) {
+		// optional parameters
+		if (!ref) return VX_SUCCESS;
+	}
+	ERROR_CHECK_OBJECT(ref);
+	// validate each parameter
+	if (index == 0 || index == 8)
+	{ // object of SCALAR type (UINT32) for num_cameras and num_camera_columns
+		vx_enum itemtype = VX_TYPE_INVALID;
+		ERROR_CHECK_STATUS(vxQueryScalar((vx_scalar)ref, VX_SCALAR_ATTRIBUTE_TYPE, &itemtype, sizeof(itemtype)));
+		ERROR_CHECK_STATUS(vxReleaseScalar((vx_scalar *)&ref));
+		if (itemtype == VX_TYPE_UINT32) {
+			status = VX_SUCCESS;
+		}
+		else {
+			status = VX_ERROR_INVALID_TYPE;
+			vxAddLogEntry((vx_reference)node, status, "ERROR: warp_merge %s scalar type should be a UINT32\n", index == 0 ? "num_cameras" : "num_camera_columns");
+		}
+	}
+	else if (index == 1)
+	{ // array object of StitchValidPixelEntry type
+		vx_size itemsize = 0;
+		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
+		ERROR_CHECK_STATUS(vxReleaseArray((vx_array *)&ref));
+		if (itemsize == sizeof(StitchValidPixelEntry) || itemsize == sizeof(StitchValidPixelWideEntry)) {
+			status = VX_SUCCESS;
+		}
+		else {
+			status = VX_ERROR_INVALID_DIMENSION;
+			vxAddLogEntry((vx_reference)node, status, "ERROR: warp_merge array element (StitchValidPixelEntry) size should be 4 bytes (or 8 bytes for StitchValidPixelWideEntry)\n");
+		}
+	}
+	else if (index == 2)
+	{ // array object of StitchWarpRemapEntry type
+		vx_size itemsize = 0;
+		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &itemsize, sizeof(itemsize)));
+		ERROR_CHECK_STATUS(vxReleaseArray((vx_array *)&ref));
+		if (itemsize == sizeof(StitchWarpRemapEntry) || itemsize == sizeof(StitchWarpRemapCompactEntry)) {
+			status = VX_SUCCESS;
+		}
+		else {
+			status = VX_ERROR_INVALID_DIMENSION;
+			vxAddLogEntry((vx_reference)node, status, "ERROR: warp_merge array element (StitchWarpRemapEntry) size should be 32 bytes (or 8 bytes for StitchWarpRemapCompactEntry)\n");
+		}
+	}
+	else if (index == 3)
+	{ // image object of U032 type
+		vx_df_image format = VX_DF_IMAGE_VIRT;
+		ERROR_CHECK_STATUS(vxQueryImage((vx_image)ref, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format)));
+		ERROR_CHECK_STATUS(vxReleaseImage((vx_image *)&ref));
+		if (format == VX_DF_IMAGE_U32) {
+			status = VX_SUCCESS;
+		}
+		else {
+			status = VX_ERROR_INVALID_TYPE;
+			vxAddLogEntry((vx_reference)node, status, "ERROR: warp_merge index image should be an image of U032 type\n");
+		}
+	}
+	else if (index == 4)
+	{ // image of format RGB
+		vx_df_image input_format = VX_DF_IMAGE_VIRT;
+		ERROR_CHECK_STATUS(vxQueryImage((vx_image)ref, VX_IMAGE_ATTRIBUTE_FORMAT, &input_format, sizeof(input_format)));
+		ERROR_CHECK_STATUS(vxReleaseImage((vx_image *)&ref));
+		if (input_format == VX_DF_IMAGE_RGB) {
+			status = VX_SUCCESS;
+		}
+		else {
+			status = VX_ERROR_INVALID_TYPE;
+			vxAddLogEntry((vx_reference)node, status, "ERROR: warp_merge doesn't support input image format: %4.4s\n", &input_format);
+		}
+	}
+	else if (index == 5)
+	{ // input weight image of format U008
+		vx_image image = (vx_image)avxGetNodeParamRef(node, 3);
+		ERROR_CHECK_OBJECT(image);
+		vx_uint32 width = 0, height = 0;
+		ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+		ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+		ERROR_CHECK_STATUS(vxReleaseImage(&image));
+		vx_uint32 num_cameras = 0;
+		vx_scalar scalar = (vx_scalar)avxGetNodeParamRef(node, 0);
+		ERROR_CHECK_OBJECT(scalar);
+		ERROR_CHECK_STATUS(vxReadScalarValue(scalar, &num_cameras));
+		ERROR_CHECK_STATUS(vxReleaseScalar(&scalar));
+		// check input image format and dimensions
+		vx_uint32 input_width = 0, input_height = 0;
+		vx_df_image input_format = VX_DF_IMAGE_VIRT;
+		ERROR_CHECK_STATUS(vxQueryImage((vx_image)ref, VX_IMAGE_ATTRIBUTE_WIDTH, &input_width, sizeof(input_width)));
+		ERROR_CHECK_STATUS(vxQueryImage((vx_image)ref, VX_IMAGE_ATTRIBUTE_HEIGHT, &input_height, sizeof(input_height)));
+		ERROR_CHECK_STATUS(vxQueryImage((vx_image)ref, VX_IMAGE_ATTRIBUTE_FORMAT, &input_format, sizeof(input_format)));
+		ERROR_CHECK_STATUS(vxReleaseImage((vx_image *)&ref));
+		if (input_format != VX_DF_IMAGE_U8) {
+			status = VX_ERROR_INVALID_TYPE;
+			vxAddLogEntry((vx_reference)node, status, "ERROR: warp_merge input weight image should be of U008 type\n");
+		}
+		else if ((input_width != width * 8) || (input_height != height * num_cameras)) {
+			status = VX_ERROR_INVALID_DIMENSION;
+			vxAddLogEntry((vx_reference)node, status, "ERROR: warp_merge invalid input weight image dimensions %dx%d do not match index image dimensions %dx%d for %d cameras\n", input_width, input_height, width, height, num_cameras);
+		}
+		else {
+			status = VX_SUCCESS;
+		}
+	}
+	else if (index == 7)
+	{ // array object of FLOAT32 type for gains
+		vx_enum itemtype = VX_TYPE_INVALID;
+		vx_size capacity = 0;
+		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMTYPE, &itemtype, sizeof(itemtype)));
+		ERROR_CHECK_STATUS(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_CAPACITY, &capacity, sizeof(capacity)));
+		ERROR_CHECK_STATUS(vxReleaseArray((vx_array *)&ref));
+		vx_uint32 num_cameras = 0;
+		vx_scalar scalar = (vx_scalar)avxGetNodeParamRef(node, 0);
+		ERROR_CHECK_OBJECT(scalar);
+		ERROR_CHECK_STATUS(vxReadScalarValue(scalar, &num_cameras));
+		ERROR_CHECK_STATUS(vxReleaseScalar(&scalar));
+		if (itemtype != VX_TYPE_FLOAT32) {
+			status = VX_ERROR_INVALID_TYPE;
+			vxAddLogEntry((vx_reference)node, status, "ERROR: warp_merge gain array type should be float32\n");
+		}
+		else if (capacity != num_cameras && capacity != num_cameras * 3) {
+			status = VX_ERROR_INVALID_DIMENSION;
+			vxAddLogEntry((vx_reference)node, status, "ERROR: warp_merge gain array should have one or three gains per camera\n");
+		}
+		else {
+			status = VX_SUCCESS;
+		}
+	}
+	return status;
+}
+
+//! \brief The output validator callback.
+static vx_status VX_CALLBACK warp_merge_output_validator(vx_node node, vx_uint32 index, vx_meta_format meta)
+{
+	vx_status status = VX_ERROR_INVALID_PARAMETERS;
+	if (index == 6)
+	{ // image of format RGB or RGBX
+		// get index image configuration
+		vx_image image = (vx_image)avxGetNodeParamRef(node, 3);
+		ERROR_CHECK_OBJECT(image);
+		vx_uint32 width = 0, height = 0;
+		ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+		ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+		ERROR_CHECK_STATUS(vxReleaseImage(&image));
+		// set output image meta data
+		image = (vx_image)avxGetNodeParamRef(node, index);
+		ERROR_CHECK_OBJECT(image);
+		vx_uint32 output_width = 0, output_height = 0;
+		vx_df_image output_format = VX_DF_IMAGE_VIRT;
+		ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_WIDTH, &output_width, sizeof(output_width)));
+		ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &output_height, sizeof(output_height)));
+		ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_FORMAT, &output_format, sizeof(output_format)));
+		ERROR_CHECK_STATUS(vxReleaseImage(&image));
+		if (width != (output_width >> 3))
+		{ // pick default output width as the index image width * 8
+			output_width = width << 3;
+		}
+		if (height != output_height)
+		{ // pick default output height as the index image height
+			output_height = height;
+		}
+		if ((output_format != VX_DF_IMAGE_RGB) && (output_format != VX_DF_IMAGE_RGBX))
+		{ // pick default output format RGB
+			output_format = VX_DF_IMAGE_RGB;
+		}
+		// set output image meta data
+		ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(meta, VX_IMAGE_ATTRIBUTE_WIDTH, &output_width, sizeof(output_width)));
+		ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(meta, VX_IMAGE_ATTRIBUTE_HEIGHT, &output_height, sizeof(output_height)));
+		ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(meta, VX_IMAGE_ATTRIBUTE_FORMAT, &output_format, sizeof(output_format)));
+		status = VX_SUCCESS;
+	}
+	return status;
+}
+
+//! \brief The kernel target support callback.
+static vx_status VX_CALLBACK warp_merge_query_target_support(vx_graph graph, vx_node node,
+	vx_bool use_opencl_1_2,              // [input]  false: OpenCL driver is 2.0+; true: OpenCL driver is 1.2
+	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
+	)
+{
+	supported_target_affinity = StitchIsHostExecution(graph) ? AGO_TARGET_AFFINITY_CPU : AGO_TARGET_AFFINITY_GPU;
+	return VX_SUCCESS;
+}
+
+//! \brief The OpenCL code generator callback.
+static vx_status VX_CALLBACK warp_merge_opencl_codegen(
+	vx_node node,                                  // [input] node
+	const vx_reference parameters[],               // [input] parameters
+	vx_uint32 num,                                 // [input] number of parameters
+	bool opencl_load_function,                     // [input]  false: normal OpenCL kernel; true: reserved
+	char opencl_kernel_function_name[64],          // [output] kernel_name for clCreateKernel()
+	std::string& opencl_kernel_code,               // [output] string for clCreateProgramWithSource()
+	std::string& opencl_build_options,             // [output] options for clBuildProgram()
+	vx_uint32& opencl_work_dim,                    // [output] work_dim for clEnqueueNDRangeKernel()
+	vx_size opencl_global_work[],                  // [output] global_work[] for clEnqueueNDRangeKernel()
+	vx_size opencl_local_work[],                   // [output] local_work[] for clEnqueueNDRangeKernel()
+	vx_uint32& opencl_local_buffer_usage_mask,     // [output] reserved: must be ZERO
+	vx_uint32& opencl_local_buffer_size_in_bytes   // [output] reserved: must be ZERO
+	)
+{
+	// get configuration of tables, input and output images
+	vx_uint32 num_cameras = 0, input_height = 0, width = 0, height = 0;
+	vx_size valid_pix_itemsize = 0, warp_remap_itemsize = 0, gain_capacity = 0;
+	vx_df_image output_format = VX_DF_IMAGE_VIRT;
+	vx_scalar scalar = (vx_scalar)avxGetNodeParamRef(node, 0);			// input scalar - num cameras
+	ERROR_CHECK_OBJECT(scalar);
+	ERROR_CHECK_STATUS(vxReadScalarValue(scalar, &num_cameras));
+	ERROR_CHECK_STATUS(vxReleaseScalar(&scalar));
+	vx_array arr = (vx_array)avxGetNodeParamRef(node, 1);				// valid pixel array
+	ERROR_CHECK_OBJECT(arr);
+	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &valid_pix_itemsize, sizeof(valid_pix_itemsize)));
+	ERROR_CHECK_STATUS(vxReleaseArray(&arr));
+	arr = (vx_array)avxGetNodeParamRef(node, 2);						// warp remap array
+	ERROR_CHECK_OBJECT(arr);
+	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &warp_remap_itemsize, sizeof(warp_remap_itemsize)));
+	ERROR_CHECK_STATUS(vxReleaseArray(&arr));
+	bool bWideValidPixel = (valid_pix_itemsize == sizeof(StitchValidPixelWideEntry));
+	bool bCompactWarpRemap = (warp_remap_itemsize == sizeof(StitchWarpRemapCompactEntry));
+	vx_image image = (vx_image)avxGetNodeParamRef(node, 4);				// input image
+	ERROR_CHECK_OBJECT(image);
+	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &input_height, sizeof(input_height)));
+	ERROR_CHECK_STATUS(vxReleaseImage(&image));
+	image = (vx_image)avxGetNodeParamRef(node, 6);						// output image
+	ERROR_CHECK_OBJECT(image);
+	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	ERROR_CHECK_STATUS(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_FORMAT, &output_format, sizeof(output_format)));
+	ERROR_CHECK_STATUS(vxReleaseImage(&image));
+	vx_array gain_array = (vx_array)parameters[7];
+	if (gain_array) {
+		ERROR_CHECK_STATUS(vxQueryArray(gain_array, VX_ARRAY_ATTRIBUTE_CAPACITY, &gain_capacity, sizeof(gain_capacity)));
+	}
+	bool bRGBGain = (gain_capacity == num_cameras * 3);
+	vx_scalar s_num_camera_columns = (vx_scalar)parameters[8];
+
+	// set kernel configuration: a work item processes 4 output pixels, i.e., half of a warp/valid map table entry
+	strcpy(opencl_kernel_function_name, "warp_merge");
+	vx_uint32 work_items[2] = { (width + 3) / 4, height };
+	opencl_work_dim = 2;
+	opencl_local_work[0] = 16;
+	opencl_local_work[1] = 4;
+	opencl_global_work[0] = (work_items[0] + opencl_local_work[0] - 1) & ~(opencl_local_work[0] - 1);
+	opencl_global_work[1] = (work_items[1] + opencl_local_work[1] - 1) & ~(opencl_local_work[1] - 1);
+
+	// Setting variables required by the interface
+	opencl_local_buffer_usage_mask = 0;
+	opencl_local_buffer_size_in_bytes = 0;
+
+	// helper functions: bilinear sampling of RGB input same as warp kernel (Q14.2 with wide valid pixel entries, otherwise Q13.3)
+	char item[8192];
+	sprintf(item,
+		"#pragma OPENCL EXTENSION cl_amd_media_ops : enable\n"
+		"#pragma OPENCL EXTENSION cl_amd_media_ops2 : enable\n"
+		"#define QF  %d\n" // warp_remap_qf
+		"#define QFB ((1 << QF) - 1)\n"
+		"#define QFM (1.0f / (1 << QF))\n"
+		"\n"
+		"float4 warp_merge_sample(__global uchar * ip_buf, uint ip_stride, uint map)\n"
+		"{\n"
+		"  uint sx = map & 0xffff, sy = map >> 16;\n"
+		"  if (sx == 0xffff && sy == 0xffff) return (float4)0.0f;\n"
+		"  uint offset = (sy >> QF) * ip_stride + (sx >> QF) * 3; __global uchar * pt = ip_buf + (offset & ~3);\n"
+		"  uint3 px0 = vload3(0, (__global uint *)pt), px1 = vload3(0, (__global uint *)(pt + ip_stride));\n"
+		"  px0.s0 = amd_bytealign(px0.s1, px0.s0, offset); px0.s1 = amd_bytealign(px0.s2, px0.s1, offset);\n"
+		"  px1.s0 = amd_bytealign(px1.s1, px1.s0, offset); px1.s1 = amd_bytealign(px1.s2, px1.s1, offset);\n"
+		"  float4 mf, f; mf.s0 = (sx & QFB) * QFM; mf.s1 = (sy & QFB) * QFM; mf.s2 = 1.0f - mf.s0; mf.s3 = 1.0f - mf.s1;\n"
+		"  f.s0 = (amd_unpack0(px0.s0) * mf.s2 + amd_unpack3(px0.s0) * mf.s0) * mf.s3 + (amd_unpack0(px1.s0) * mf.s2 + amd_unpack3(px1.s0) * mf.s0) * mf.s1;\n"
+		"  f.s1 = (amd_unpack1(px0.s0) * mf.s2 + amd_unpack0(px0.s1) * mf.s0) * mf.s3 + (amd_unpack1(px1.s0) * mf.s2 + amd_unpack0(px1.s1) * mf.s0) * mf.s1;\n"
+		"  f.s2 = (amd_unpack2(px0.s0) * mf.s2 + amd_unpack1(px0.s1) * mf.s0) * mf.s3 + (amd_unpack2(px1.s0) * mf.s2 + amd_unpack1(px1.s1) * mf.s0) * mf.s1;\n"
+		"  f.s3 = 0.0f;\n"
+		"  return f;\n"
+		"}\n"
+		"\n"
+		, bWideValidPixel ? 2 : 3);
+	opencl_kernel_code = item;
+	if (bCompactWarpRemap) {
+		// reconstruct source (x,y) of pixels i0..i0+3 from compact entry (see StitchWarpRemapCompactEntry)
+		opencl_kernel_code +=
+			"uint4 warp_remap_compact(__global uchar * warp_remap_base, uint2 entry, uint i0)\n"
+			"{\n"
+			"  if ((entry.s1 & 0xfff00) == (0x800 << 8)) // escaped entry: full entry in the overflow area\n"
+			"    return vload4(0, (__global uint *)(warp_remap_base + (entry.s0 << 3) + (i0 << 2)));\n"
+			"  uint valid_mask = entry.s1 & 0xff; int first = (int)popcount((valid_mask & (0u - valid_mask)) - 1);\n"
+			"  int dx = ((int)(entry.s1 << 12)) >> 20, dy = ((int)entry.s1) >> 20;\n"
+			"  int4 k = (int4)((int)i0 - first) + (int4)(0, 1, 2, 3);\n"
+			"  uint4 sx = as_uint4(clamp(((int4)((int)(entry.s0 & 0xffff) << 5) + k * dx + 16) >> 5, 0, 0xfffe));\n"
+			"  uint4 sy = as_uint4(clamp(((int4)((int)(entry.s0 >> 16) << 5) + k * dy + 16) >> 5, 0, 0xfffe));\n"
+			"  uint4 valid = ((uint4)valid_mask >> ((uint4)i0 + (uint4)(0, 1, 2, 3))) & 1;\n"
+			"  return select((uint4)0xffffffff, sx | (sy << 16), valid == (uint4)1);\n"
+			"}\n"
+			"\n";
+	}
+
+	// kernel header
+	sprintf(item,
+		"__kernel __attribute__((reqd_work_group_size(%d, %d, 1)))\n" // opencl_local_work[0], opencl_local_work[1]
+		"void %s(uint num_cameras,\n" // opencl_kernel_function_name
+		"        __global uchar * valid_pix_buf, uint valid_pix_buf_offset, uint valid_pix_num_items,\n"
+		"        __global uchar * warp_remap_buf, uint warp_remap_buf_offset, uint warp_remap_num_items,\n"
+		"        uint idx_width, uint idx_height, __global uchar * idx_buf, uint idx_stride, uint idx_offset,\n"
+		"        uint ip_width, uint ip_height, __global uchar * ip_buf, uint ip_stride, uint ip_offset,\n"
+		"        uint wt_width, uint wt_height, __global uchar * wt_buf, uint wt_stride, uint wt_offset,\n"
+		"        uint op_width, uint op_height, __global uchar * op_buf, uint op_stride, uint op_offset"
+		, (int)opencl_local_work[0], (int)opencl_local_work[1], opencl_kernel_function_name);
+	opencl_kernel_code += item;
+	if (gain_array) {
+		opencl_kernel_code +=
+			",\n"
+			"        __global uchar * gain_buf, uint gain_buf_offset, uint gain_num_items";
+	}
+	if (s_num_camera_columns) {
+		opencl_kernel_code +=
+			",\n"
+			"        uint num_camera_columns";
+	}
+	sprintf(item,
+		")\n"
+		"{\n"
+		"  int gx = get_global_id(0);\n"
+		"  int gy = get_global_id(1);\n"
+		"  if ((gx < %d) && (gy < %d)) {\n" // work_items[0], work_items[1]
+		"    uint idx = *(__global uint *)(idx_buf + idx_offset + gy * idx_stride + ((gx >> 1) << 2));\n"
+		"    if (idx == 0xffffffe0) return;\n" // STITCH_WARP_MERGE_INDEX_SKIP
+		"    uint count = idx & 0x1f, entry = idx >> 5, end = entry + count;\n"
+		"    uint ip_image_height_offset = %d;\n" // input_height / num_cameras
+		"    float4 f0 = (float4)0.0f, f1 = (float4)0.0f, f2 = (float4)0.0f, f3 = (float4)0.0f;\n"
+		"    for (; entry < end; entry++) {\n"
+		, work_items[0], work_items[1], input_height / num_cameras);
+	opencl_kernel_code += item;
+
+	// gather the contributing cameras: decode entry, sample input, apply gains
+	if (bWideValidPixel) {
+		opencl_kernel_code +=
+			"      uint2 pixelEntry = *(__global uint2 *)(valid_pix_buf + valid_pix_buf_offset + (entry << 3));\n"
+			"      uint camera_id = pixelEntry.s0 & 0xff; bool all_valid = (pixelEntry.s0 >> 31) != 0;\n";
+	}
+	else {
+		opencl_kernel_code +=
+			"      uint pixelEntry = *(__global uint *)(valid_pix_buf + valid_pix_buf_offset + (entry << 2));\n"
+			"      uint camera_id = pixelEntry & 0x1f; bool all_valid = ((pixelEntry >> 7) & 1) != 0;\n";
+	}
+	if (bCompactWarpRemap) {
+		opencl_kernel_code +=
+			"      uint4 map = warp_remap_compact(warp_remap_buf + warp_remap_buf_offset, *(__global uint2 *)(warp_remap_buf + warp_remap_buf_offset + (entry << 3)), (gx & 1) << 2);\n";
+	}
+	else {
+		opencl_kernel_code +=
+			"      uint4 map = *(__global uint4 *)(warp_remap_buf + warp_remap_buf_offset + (entry << 5) + ((gx & 1) << 4));\n";
+	}
+	if (s_num_camera_columns) {
+		opencl_kernel_code +=
+			"      __global uchar * pt = ip_buf + ip_offset + ((camera_id / num_camera_columns) * ip_image_height_offset * ip_stride);\n";
+	}
+	else {
+		opencl_kernel_code +=
+			"      __global uchar * pt = ip_buf + ip_offset + (camera_id * ip_image_height_offset * ip_stride);\n";
+	}
+	opencl_kernel_code +=
+		"      float4 p0 = warp_merge_sample(pt, ip_stride, map.s0);\n"
+		"      float4 p1 = warp_merge_sample(pt, ip_stride, map.s1);\n"
+		"      float4 p2 = warp_merge_sample(pt, ip_stride, map.s2);\n"
+		"      float4 p3 = warp_merge_sample(pt, ip_stride, map.s3);\n";
+	if (gain_array) {
+		if (bRGBGain) {
+			opencl_kernel_code +=
+				"      __global float * pg = (__global float *)(gain_buf + gain_buf_offset) + camera_id * 3;\n"
+				"      float4 g4 = (float4)(pg[0], pg[1], pg[2], 1.0f);\n";
+		}
+		else {
+			opencl_kernel_code +=
+				"      __global float * pg = (__global float *)(gain_buf + gain_buf_offset) + camera_id;\n"
+				"      float4 g4 = (float4)((float3)pg[0], 1.0f);\n";
+		}
+		opencl_kernel_code +=
+			"      p0 = clamp(p0 * g4, 0.0f, 255.0f); p1 = clamp(p1 * g4, 0.0f, 255.0f);\n"
+			"      p2 = clamp(p2 * g4, 0.0f, 255.0f); p3 = clamp(p3 * g4, 0.0f, 255.0f);\n";
+	}
+	// blend: a single camera covering all 8 pixels is copied, otherwise weighted sum same as merge kernel;
+	// pixels without cameras (count == 0) are written as zero same as merge kernel
+	opencl_kernel_code +=
+		"      if (count == 1 && all_valid) {\n"
+		"        f0 = p0; f1 = p1; f2 = p2; f3 = p3;\n"
+		"      }\n"
+		"      else {\n"
+		"        float4 w = convert_float4(*(__global uchar4 *)(wt_buf + wt_offset + ((gy + op_height * camera_id) * wt_stride) + (gx << 2))) * (1.0f / 255.0f);\n"
+		"        f0 = mad((float4)w.s0, p0, f0); f1 = mad((float4)w.s1, p1, f1);\n"
+		"        f2 = mad((float4)w.s2, p2, f2); f3 = mad((float4)w.s3, p3, f3);\n"
+		"      }\n"
+		"    }\n";
+	if (output_format == VX_DF_IMAGE_RGB) {
+		opencl_kernel_code +=
+			"    uint3 pRGB_out;\n"
+			"    pRGB_out.s0 = amd_pack((float4)(f0.s012, f1.s0));\n"
+			"    pRGB_out.s1 = amd_pack((float4)(f1.s12, f2.s01));\n"
+			"    pRGB_out.s2 = amd_pack((float4)(f2.s2, f3.s012));\n"
+			"    op_buf += op_offset + gy * op_stride + gx * 12;\n"
+			"    vstore3(pRGB_out, 0, (__global uint *) op_buf);\n"
+			"  }\n"
+			"}\n";
+	}
+	else { // RGBX out
+		opencl_kernel_code +=
+			"    uint4 pRGB_out;\n"
+			"    pRGB_out.s0 = amd_pack((float4)(f0.s012, 255.0f));\n"
+			"    pRGB_out.s1 = amd_pack((float4)(f1.s012, 255.0f));\n"
+			"    pRGB_out.s2 = amd_pack((float4)(f2.s012, 255.0f));\n"
+			"    pRGB_out.s3 = amd_pack((float4)(f3.s012, 255.0f));\n"
+			"    op_buf += op_offset + gy * op_stride + (gx << 4);\n"
+			"    *(__global uint4 *) op_buf = pRGB_out;\n"
+			"  }\n"
+			"}\n";
+	}
+	return VX_SUCCESS;
+}
+
+//! \brief The kernel execution: used with host execution and matches the OpenCL kernel.
+static vx_status VX_CALLBACK warp_merge_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
+{
+	// get configuration
+	vx_uint32 num_cameras = 0, num_camera_columns = 1;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &num_cameras));
+	if (parameters[8]) {
+		ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[8], &num_camera_columns));
+	}
+	vx_array valid_pix_arr = (vx_array)parameters[1];
+	vx_array warp_remap_arr = (vx_array)parameters[2];
+	vx_array gain_arr = (vx_array)parameters[7];
+	vx_size numitems = 0, warp_remap_numitems = 0, valid_pix_itemsize = 0, warp_remap_itemsize = 0, gain_numitems = 0, gain_capacity = 0;
+	ERROR_CHECK_STATUS(vxQueryArray(valid_pix_arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &numitems, sizeof(numitems)));
+	ERROR_CHECK_STATUS(vxQueryArray(warp_remap_arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &warp_remap_numitems, sizeof(warp_remap_numitems)));
+	ERROR_CHECK_STATUS(vxQueryArray(valid_pix_arr, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &valid_pix_itemsize, sizeof(valid_pix_itemsize)));
+	ERROR_CHECK_STATUS(vxQueryArray(warp_remap_arr, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &warp_remap_itemsize, sizeof(warp_remap_itemsize)));
+	if (gain_arr) {
+		ERROR_CHECK_STATUS(vxQueryArray(gain_arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &gain_numitems, sizeof(gain_numitems)));
+		ERROR_CHECK_STATUS(vxQueryArray(gain_arr, VX_ARRAY_ATTRIBUTE_CAPACITY, &gain_capacity, sizeof(gain_capacity)));
+	}
+	bool bCompactWarpRemap = (warp_remap_itemsize == sizeof(StitchWarpRemapCompactEntry));
+	bool bWideValidPixel = (valid_pix_itemsize == sizeof(StitchValidPixelWideEntry));
+	bool bRGBGain = (gain_capacity == num_cameras * 3);
+	vx_uint32 QF = bWideValidPixel ? 2 : 3;
+	vx_image index_image = (vx_image)parameters[3];
+	vx_image input_image = (vx_image)parameters[4];
+	vx_image weight_image = (vx_image)parameters[5];
+	vx_image output_image = (vx_image)parameters[6];
+	vx_uint32 index_width = 0, input_width = 0, input_height = 0, output_width = 0, output_height = 0;
+	vx_df_image output_format = VX_DF_IMAGE_VIRT;
+	ERROR_CHECK_STATUS(vxQueryImage(index_image, VX_IMAGE_ATTRIBUTE_WIDTH, &index_width, sizeof(index_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_WIDTH, &input_width, sizeof(input_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &input_height, sizeof(input_height)));
+	ERROR_CHECK_STATUS(vxQueryImage(output_image, VX_IMAGE_ATTRIBUTE_WIDTH, &output_width, sizeof(output_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(output_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &output_height, sizeof(output_height)));
+	ERROR_CHECK_STATUS(vxQueryImage(output_image, VX_IMAGE_ATTRIBUTE_FORMAT, &output_format, sizeof(output_format)));
+	vx_uint32 op_pixel_size = (output_format == VX_DF_IMAGE_RGBX) ? 4 : 3;
+	vx_uint32 ip_image_height_offs = input_height / num_cameras;
+
+	// access images and tables
+	vx_rectangle_t idx_rect = { 0, 0, index_width, output_height }, ip_rect = { 0, 0, input_width, input_height };
+	vx_rectangle_t wt_rect = { 0, 0, output_width, output_height * num_cameras }, op_rect = { 0, 0, output_width, output_height };
+	vx_imagepatch_addressing_t idx_addr, ip_addr, wt_addr, op_addr;
+	void * idx_ptr = nullptr, * ip_ptr = nullptr, * wt_ptr = nullptr, * op_ptr = nullptr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(index_image, &idx_rect, 0, &idx_addr, &idx_ptr, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(input_image, &ip_rect, 0, &ip_addr, &ip_ptr, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(weight_image, &wt_rect, 0, &wt_addr, &wt_ptr, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(output_image, &op_rect, 0, &op_addr, &op_ptr, VX_READ_AND_WRITE));
+	vx_size valid_pix_stride = 0, warp_remap_stride = 0, gain_stride = 0;
+	vx_uint8 * valid_pix_buf = nullptr, * warp_remap_buf = nullptr;
+	vx_float32 * gain_buf = nullptr;
+	if (numitems > 0) {
+		ERROR_CHECK_STATUS(vxAccessArrayRange(valid_pix_arr, 0, numitems, &valid_pix_stride, (void **)&valid_pix_buf, VX_READ_ONLY));
+		// the whole warp remap table is accessed: escaped compact entries refer to the overflow area
+		ERROR_CHECK_STATUS(vxAccessArrayRange(warp_remap_arr, 0, warp_remap_numitems, &warp_remap_stride, (void **)&warp_remap_buf, VX_READ_ONLY));
+	}
+	if (gain_numitems > 0) {
+		ERROR_CHECK_STATUS(vxAccessArrayRange(gain_arr, 0, gain_numitems, &gain_stride, (void **)&gain_buf, VX_READ_ONLY));
+	}
+
+	// gather the contributing cameras of each group of 8 output pixels: groups without cameras are written as zero
+	// and groups outside active output regions are skipped
+#pragma omp parallel for
+	for (int y = 0; y < (int)output_height; y++) {
+		const StitchWarpMergeIndexEntry * index = (const StitchWarpMergeIndexEntry *)((const vx_uint8 *)idx_ptr + y * idx_addr.stride_y);
+		vx_uint8 * op_buf = (vx_uint8 *)op_ptr + y * op_addr.stride_y;
+		for (vx_uint32 gx = 0; gx < index_width; gx++) {
+			if (*(const vx_uint32 *)&index[gx] == STITCH_WARP_MERGE_INDEX_SKIP)
+				continue;
+			vx_float32 f[8][4] = { { 0.0f } };
+			vx_uint32 count = index[gx].count, entry = index[gx].start;
+			for (vx_uint32 end = (numitems > 0) ? std::min(entry + count, (vx_uint32)numitems) : entry; entry < end; entry++) {
+				// decode valid pixel entry
+				vx_uint32 pixelEntry[2] = { 0xffffffff, 0 };
+				memcpy(pixelEntry, valid_pix_buf + entry * valid_pix_stride, bWideValidPixel ? 8 : 4);
+				vx_uint32 camera_id = bWideValidPixel ? (pixelEntry[0] & 0xff) : (pixelEntry[0] & 0x1f);
+				bool all_valid = bWideValidPixel ? ((pixelEntry[0] >> 31) != 0) : (((pixelEntry[0] >> 7) & 1) != 0);
+				vx_uint32 sx[8], sy[8];
+				WarpRemapDecodeEntry(warp_remap_buf, warp_remap_buf + entry * warp_remap_stride, bCompactWarpRemap, sx, sy);
+				vx_uint32 ip_row = (camera_id / num_camera_columns) * ip_image_height_offs;
+				const vx_uint8 * ip_buf = (const vx_uint8 *)ip_ptr + ip_row * ip_addr.stride_y;
+				const vx_uint8 * wt_buf = (const vx_uint8 *)wt_ptr + (y + output_height * camera_id) * wt_addr.stride_y + gx * 8;
+				vx_float32 g[3] = { 1.0f, 1.0f, 1.0f };
+				if (gain_buf) {
+					for (vx_uint32 c = 0; c < 3; c++)
+						g[c] = gain_buf[bRGBGain ? camera_id * 3 + c : camera_id];
+				}
+				for (vx_uint32 i = 0; i < 8; i++) {
+					vx_float32 p[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+					if (!(sx[i] == 0xffff && sy[i] == 0xffff)) {
+						WarpSamplePixel(ip_buf, (vx_uint32)ip_addr.stride_y, 3, input_width, input_height - ip_row, sx[i], sy[i], QF, true, p);
+					}
+					if (gain_buf) {
+						for (vx_uint32 c = 0; c < 3; c++)
+							p[c] = std::min(std::max(p[c] * g[c], 0.0f), 255.0f);
+					}
+					// blend: a single camera covering all 8 pixels is copied, otherwise weighted sum same as merge kernel
+					vx_float32 w = wt_buf[i] * (1.0f / 255.0f);
+					for (vx_uint32 c = 0; c < 3; c++)
+						f[i][c] = (count == 1 && all_valid) ? p[c] : f[i][c] + w * p[c];
+				}
+			}
+			for (vx_uint32 i = 0, x = gx * 8; i < 8 && x < output_width; i++, x++) {
+				vx_uint8 * op = op_buf + x * op_pixel_size;
+				op[0] = StitchPackU8(f[i][0]);
+				op[1] = StitchPackU8(f[i][1]);
+				op[2] = StitchPackU8(f[i][2]);
+				if (op_pixel_size == 4)
+					op[3] = 255;
+			}
+		}
+	}
+
+	if (numitems > 0) {
+		ERROR_CHECK_STATUS(vxCommitArrayRange(valid_pix_arr, 0, numitems, valid_pix_buf));
+		ERROR_CHECK_STATUS(vxCommitArrayRange(warp_remap_arr, 0, warp_remap_numitems, warp_remap_buf));
+	}
+	if (gain_numitems > 0) {
+		ERROR_CHECK_STATUS(vxCommitArrayRange(gain_arr, 0, gain_numitems, gain_buf));
+	}
+	ERROR_CHECK_STATUS(vxCommitImagePatch(index_image, &idx_rect, 0, &idx_addr, idx_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(input_image, &ip_rect, 0, &ip_addr, ip_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(weight_image, &wt_rect, 0, &wt_addr, wt_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(output_image, &op_rect, 0, &op_addr, op_ptr));
+	return VX_SUCCESS;
+}
+
+//! \brief The kernel publisher.
+vx_status warp_merge_publish(vx_context context)
+{
+	// add kernel to the context with callbacks
+	vx_kernel kernel = vxAddKernel(context, "com.amd.loomsl.warp_merge",
+		AMDOVX_KERNEL_STITCHING_WARP_MERGE,
+		warp_merge_kernel,
+		9,
+		warp_merge_input_validator,
+		warp_merge_output_validator,
+		nullptr,
+		nullptr);
+	ERROR_CHECK_OBJECT(kernel);
+	amd_kernel_query_target_support_f query_target_support_f = warp_merge_query_target_support;
+	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = warp_merge_opencl_codegen;
+	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
+	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
+
+	// set kernel parameters
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 1, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 2, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 3, VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 4, VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 5, VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 6, VX_OUTPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 7, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_OPTIONAL));
+	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 8, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_OPTIONAL));
+
+	// finalize and release kernel object
+	ERROR_CHECK_STATUS(vxFinalizeKernel(kernel));
+	ERROR_CHECK_STATUS(vxReleaseKernel(&kernel));
+
+	return VX_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Generate data in buffers for warp merge
+vx_status GenerateWarpMergeBuffers(
+	vx_uint32 eqrWidth,                          // [in] output equirectangular image width
+	vx_uint32 eqrHeight,                         // [in] output equirectangular image height
+	vx_size   mapEntryCount,                     // [in] number of entries in warp/valid map table
+	StitchValidPixelEntry * validMap,            // [in/out] valid map table (NULL when validMapWide is used)
+	StitchValidPixelWideEntry * validMapWide,    // [in/out] wide valid map table (NULL when validMap is used)
+	StitchWarpRemapEntry * warpMap,              // [in/out] warp map table (NULL when warpMapCompact is used)
+	StitchWarpRemapCompactEntry * warpMapCompact, // [in/out] compact warp map table (NULL when warpMap is used)
+	vx_uint32 indexStride,                       // [in] stride (in bytes) of index table (image)
+	StitchWarpMergeIndexEntry * indexBuf         // [out] index table (image)
+	)
+{
+	// start index of all ones is reserved for STITCH_WARP_MERGE_INDEX_SKIP
+	if (mapEntryCount >= (1 << 27) - 1)
+		return VX_ERROR_NOT_SUPPORTED;
+	vx_uint32 groupWidth = eqrWidth >> 3;
+	vx_size groupCount = (vx_size)groupWidth * eqrHeight;
+	// count entries per group of 8 output pixels: dummy entries at the end are left in place
+	std::vector<vx_uint32> groupStart(groupCount + 1, 0), entryGroup(mapEntryCount);
+	for (vx_size i = 0; i < mapEntryCount; i++) {
+		vx_uint32 dstX = validMapWide ? validMapWide[i].dstX : validMap[i].dstX;
+		vx_uint32 dstY = validMapWide ? validMapWide[i].dstY : validMap[i].dstY;
+		if ((validMapWide ? *(vx_uint32 *)&validMapWide[i] : *(vx_uint32 *)&validMap[i]) == 0xFFFFFFFF || dstX >= groupWidth || dstY >= eqrHeight) {
+			mapEntryCount = i;
+			break;
+		}
+		entryGroup[i] = dstY * groupWidth + dstX;
+		groupStart[entryGroup[i] + 1]++;
+	}
+	for (vx_size g = 0; g < groupCount; g++) {
+		if (groupStart[g + 1] > 31)
+			return VX_ERROR_NOT_SUPPORTED;
+		groupStart[g + 1] += groupStart[g];
+	}
+	// set index table
+	for (vx_uint32 y = 0; y < eqrHeight; y++) {
+		StitchWarpMergeIndexEntry * index = (StitchWarpMergeIndexEntry *)((vx_uint8 *)indexBuf + y * indexStride);
+		for (vx_uint32 x = 0; x < groupWidth; x++) {
+			vx_size g = (vx_size)y * groupWidth + x;
+			index[x].count = groupStart[g + 1] - groupStart[g];
+			index[x].start = groupStart[g];
+		}
+	}
+	// stable reorder of the entries by output location: the order of cameras within a group is unchanged
+	vx_size validItemSize = validMapWide ? sizeof(StitchValidPixelWideEntry) : sizeof(StitchValidPixelEntry);
+	vx_size warpItemSize = warpMapCompact ? sizeof(StitchWarpRemapCompactEntry) : sizeof(StitchWarpRemapEntry);
+	vx_uint8 * validBuf = validMapWide ? (vx_uint8 *)validMapWide : (vx_uint8 *)validMap;
+	vx_uint8 * warpBuf = warpMapCompact ? (vx_uint8 *)warpMapCompact : (vx_uint8 *)warpMap;
+	std::vector<vx_uint8> validCopy(validBuf, validBuf + mapEntryCount * validItemSize);
+	std::vector<vx_uint8> warpCopy(warpBuf, warpBuf + mapEntryCount * warpItemSize);
+	for (vx_size i = 0; i < mapEntryCount; i++) {
+		vx_size j = groupStart[entryGroup[i]]++;
+		memcpy(validBuf + j * validItemSize, &validCopy[i * validItemSize], validItemSize);
+		memcpy(warpBuf + j * warpItemSize, &warpCopy[i * warpItemSize], warpItemSize);
+	}
+	return VX_SUCCESS;
+}
@@ -0,0 +1,64 @@
+/*
+Copyright (c) 2016 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+
+#ifndef __WARP_MERGE_H__
+#define __WARP_MERGE_H__
+
+#include "kernels.h"
+#include "warp.h"
+
+//////////////////////////////////////////////////////////////////////
+//! \brief The warp merge index entry for 8 consecutive output pixel locations (U032 image of size [eqrWidth/8 x eqrHeight]).
+//  The warp/valid map table entries of all the cameras contributing to the 8 pixels are consecutive in the tables.
+typedef struct {
+	vx_uint32 count : 5;  // number of warp/valid map table entries (0 when no camera contributes)
+	vx_uint32 start : 27; // index of the first warp/valid map table entry
+} StitchWarpMergeIndexEntry;
+
+//! \brief The warp merge index entry of groups outside active output regions: output pixels are left untouched.
+#define STITCH_WARP_MERGE_INDEX_SKIP     0xFFFFFFE0 // count = 0, start = all ones
+
+//////////////////////////////////////////////////////////////////////
+//! \brief The kernel registration functions.
+vx_status warp_merge_publish(vx_context context);
+
+//////////////////////////////////////////////////////////////////////
+// Generate data in buffers for warp merge
+//   GenerateWarpMergeBuffers - reorder warp/valid map tables from GenerateWarpBuffers by output location
+//                              and generate the index table: the warp kernel doesn't depend on the order
+//                              of the entries, so the same tables are used by both the warp and warp merge kernels
+
+vx_status GenerateWarpMergeBuffers(
+	vx_uint32 eqrWidth,                          // [in] output equirectangular image width
+	vx_uint32 eqrHeight,                         // [in] output equirectangular image height
+	vx_size   mapEntryCount,                     // [in] number of entries in warp/valid map table
+	StitchValidPixelEntry * validMap,            // [in/out] valid map table (NULL when validMapWide is used)
+	StitchValidPixelWideEntry * validMapWide,    // [in/out] wide valid map table (NULL when validMap is used)
+	StitchWarpRemapEntry * warpMap,              // [in/out] warp map table (NULL when warpMapCompact is used)
+	StitchWarpRemapCompactEntry * warpMapCompact, // [in/out] compact warp map table (NULL when warpMap is used)
+	vx_uint32 indexStride,                       // [in] stride (in bytes) of index table (image)
+	StitchWarpMergeIndexEntry * indexBuf         // [out] index table (image)
+	);
+
+#endif //__WARP_MERGE_H__
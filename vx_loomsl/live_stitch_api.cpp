@@ -21,10 +21,13 @@ THE SOFTWARE.
 */
 #define _CRT_SECURE_NO_WARNINGS
 #include "profiler.h"
+#include "host_memory.h"
 #include "kernels.h"
 #include "lens_distortion_remap.h"
 #include "warp.h"
 #include "merge.h"
+#include "warp_merge.h"
+#include "overlay_blend.h"
 #include "seam_find.h"
 #include "exposure_compensation.h"
 #include "multiband_blender.h"
@@ -32,6 +35,8 @@ THE SOFTWARE.
 #include <stdarg.h>
 #include <map>
 #include <string>
+#include <vector>
+#include <algorithm>
 
 // Version
 #define LS_VERSION             "0.9.7"
@@ -72,6 +77,23 @@ struct ls_internal_table_size_info {
 	vx_size seamFindAccumTableSize;
 	vx_size seamFindPrefInfoTableSize;
 	vx_size seamFindPathTableSize;
+	vx_size mergeOverflowTableSize;
+};
+
+//////////////////////////////////////////////////////////////////////
+//! \brief The rolling performance statistics
+#define LS_PERF_WINDOW_SIZE    256
+struct ls_perf_entry {
+	vx_node     node;                           // graph node (nullptr for stages)
+	vx_uint32   stage;                          // LIVE_STITCH_PERF_STAGE_*
+	std::string name;                           // stage or kernel name
+	vx_uint64   bytes;                          // estimated bytes read and written per frame
+	vx_uint64   frames;                         // total number of frames measured
+	std::vector<vx_float32> samples;            // processing time of recent frames in milliseconds
+};
+struct ls_perf_data {
+	ls_perf_entry stages[LIVE_STITCH_PERF_STAGE_COUNT];
+	std::vector<ls_perf_entry> nodes;
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -128,7 +150,8 @@ struct ls_context_t {
 	ls_internal_table_size_info table_sizes;	// internal table sizes
 	vx_image	rgb_input, rgb_output;			// internal images
 	// data objects
-	vx_remap    overlay_remap;                  // remap table for overlay
+	vx_remap    overlay_remap;                  // remap table for overlay (only when overlay tables can't be used)
+	vx_array    OverlayValidPixelEntry, OverlayWarpRemapEntry; // overlay tables for overlay footprint
 	vx_remap    camera_remap;                   // remap table for camera (in simple stitch mode)
 	vx_image    Img_input, Img_output, Img_overlay;
 	vx_image    Img_input_rgb, Img_output_rgb, Img_overlay_rgb, Img_overlay_rgba;
@@ -136,7 +159,10 @@ struct ls_context_t {
 	vx_array    ValidPixelEntry, WarpRemapEntry, OverlapPixelEntry, valid_array, gain_array;
 	vx_matrix   overlap_matrix, A_matrix;
 	vx_image    RGBY1, RGBY2, weight_image, cam_id_image, group1_image, group2_image;
+	vx_array    merge_overflow_array;           // camera masks of merge blocks with more than STITCH_MERGE_MAX_GROUP_CAMERAS cameras
 	vx_node     WarpNode, ExpcompComputeGainNode, ExpcompSolveGainNode, ExpcompApplyGainNode, MergeNode;
+	vx_image    warp_merge_index_image;         // index of warp table entries by output location (fused warp merge only)
+	vx_node     WarpMergeNode;
 	vx_node     nodeOverlayRemap, nodeOverlayBlend;
 	vx_float32  alpha, beta;                    // needed for expcomp
 	vx_int32    * A_matrix_initial_value;       // needed for expcomp
@@ -147,9 +173,17 @@ struct ls_context_t {
 				sobel_magnitude_image, sobel_phase_image, seamfind_weight_image;
 	vx_node     SobelNode, MagnitudeNode, PhaseNode, ConvertDepthNode, SeamfindStep1Node, SeamfindStep2Node,
 				SeamfindStep3Node, SeamfindStep4Node, SeamfindStep5Node, SeamfindAnalyzeNode;
-	vx_scalar   current_frame, scene_threshold, seam_cost_enable;
+	vx_scalar   current_frame, scene_threshold, seam_cost_enable, seam_budget;
 	vx_int32    current_frame_value;
 	vx_uint32   scene_threshold_value, SEAM_FIND_TARGET;
+	vx_uint32   SEAM_SCHEDULE, seam_budget_value;   // seamfind event driven seam refresh and overlaps per frame
+	vx_uint32   SEAM_COARSE_SCALE;                  // seamfind coarse-to-fine path search downsample factor
+	vx_uint32   FUSED_WARP_MERGE;                   // warp, exposure gain and merge in a single pass
+	// packed intermediate images: camera planes hold only the camera bounding boxes
+	vx_uint32   PACKED_INTERMEDIATES;
+	vx_uint32   packed_plane_width, packed_plane_height;
+	StitchCameraPlaneEntry cameraPlanes[LIVE_STITCH_MAX_CAMERAS];
+	vx_array    camera_plane_array;
 	// multiband data elements
 	vx_int32    num_bands;
 	vx_array    blend_offsets;
@@ -168,14 +202,14 @@ struct ls_context_t {
 	StitchCoord2dFloat * camSrcMap;
 	vx_float32  * camIndexTmpBuf;
 	vx_uint8    * camIndexBuf;
-	vx_uint32   * validPixelCamMap, *paddedPixelCamMap;
+	vx_uint64   * validPixelCamMap, *paddedPixelCamMap;
 	vx_rectangle_t * overlapRectBuf;
 	vx_rectangle_t * overlapValid[LIVE_STITCH_MAX_CAMERAS], *overlapPadded[LIVE_STITCH_MAX_CAMERAS];
-	vx_uint32   validCamOverlapInfo[LIVE_STITCH_MAX_CAMERAS], paddedCamOverlapInfo[LIVE_STITCH_MAX_CAMERAS];
+	vx_uint64   validCamOverlapInfo[LIVE_STITCH_MAX_CAMERAS], paddedCamOverlapInfo[LIVE_STITCH_MAX_CAMERAS];
 	vx_int32    * overlapMatrixBuf;
 	// internal buffers for overlay models
 	StitchCoord2dFloat * overlaySrcMap;
-	vx_uint32   * validPixelOverlayMap;
+	vx_uint64   * validPixelOverlayMap;
 	vx_float32  * overlayIndexTmpBuf;
 	vx_uint8    * overlayIndexBuf;
 	// internal buffers for frame encode
@@ -190,6 +224,12 @@ struct ls_context_t {
 	vx_rectangle_t src_encode_tile_rect[MAX_TILE_IMG];  // src encode rectangles 
 	vx_rectangle_t dst_encode_tile_rect[MAX_TILE_IMG];  // dst encode rectangles 
 	vx_node     encode_color_convert_nodes[MAX_TILE_IMG];// nodes to color convert each of the sectional ROI images
+	// output rendition ladder (index 0 is the stitch output)
+	vx_uint32   num_output_renditions;                  // number of output renditions
+	vx_image    rendition_rgb[LIVE_STITCH_MAX_OUTPUT_RENDITIONS];          // downscaled RGB images (only when output is not RGB)
+	vx_image    rendition_output[LIVE_STITCH_MAX_OUTPUT_RENDITIONS];       // rendition output images created from OpenCL handle
+	vx_node     rendition_scale_nodes[LIVE_STITCH_MAX_OUTPUT_RENDITIONS];  // nodes to downscale previous rendition
+	vx_node     rendition_convert_nodes[LIVE_STITCH_MAX_OUTPUT_RENDITIONS];// nodes to color convert each rendition
 	// chroma key
 	vx_uint32   CHROMA_KEY;                             // chroma key flag variable
 	vx_uint32   CHROMA_KEY_EED;                         // chroma key flag variable
@@ -209,12 +249,49 @@ struct ls_context_t {
 	vx_delay    noiseFilterImageDelay;                  // temporal noise filter delay element
 	vx_image    noiseFilterInput_image;                 // temporal noise filter delay input image
 	vx_node     noiseFilterNode;                        // temporal noise filter node
+	// exposure comp temporal solve
+	vx_uint32   expCompSolveInterval;                   // exposure comp number of frames between gain solves
+	vx_uint32   expCompSolveWindow;                     // exposure comp number of recent frames used by a gain solve
+	vx_uint32   expCompFrameCount;                      // exposure comp frames scheduled since initialize
+	vx_float32  expCompGainSmoothing;                   // exposure comp gain moving average factor
+	vx_graph    graphExpCompSolve;                      // exposure comp gain solve graph run by lsScheduleFrame on solve frames
+	bool        expCompSolved;                          // exposure comp graphExpCompSolve ran for the scheduled frame
+	vx_delay    expCompMatrixDelay;                     // exposure comp error function matrices of the sliding window
+	vx_size     expCompGainCount;                       // exposure comp number of gains
+	vx_float32  * expCompSolvedGains;                   // exposure comp gains from the last solve
+	vx_float32  * expCompGains;                         // exposure comp gains used by the stitch graph
 	// quick setup load
 	vx_uint32   SETUP_LOAD;                             // quick setup load flag variable
 	vx_bool     SETUP_LOAD_FILES_FOUND;                 // quick setup load files found flag variable
 	// data for Initialize tables
 	vx_uint32   USE_CPU_INIT;
+	vx_uint32   HOST_EXECUTION;                         // run stitch graph on CPU with host memory buffers
+	vx_uint32   OUTPUT_PROJECTION;                      // output projection: output_projection_*
+	vx_uint32   WARP_TABLE_FORMAT;                      // warp remap table format: STITCH_WARP_TABLE_FORMAT_*
+	bool        useWideTables;                          // use wide table entries for outputs/cameras beyond compact entry limits
 	StitchInitializeData *stitchInitData;
+	// performance statistics
+	ls_perf_data * perf;                                // per stage and per node frame times (when profiler is enabled)
+	// active output regions
+	vx_uint32   num_active_regions;                     // number of active output regions (0: full output)
+	vx_rectangle_t activeRegion[LIVE_STITCH_MAX_ACTIVE_REGIONS]; // active output regions
+	vx_uint8    * fullValidPixelTable, * fullWarpRemapTable; // warp tables for full output
+	vx_uint8    * fullCamIdTable;                       // merge camId table for full output
+	vx_size     fullWarpEntryCount;                     // number of warp table entries for full output
+	vx_size     fullWarpRemapCount;                     // number of warp remap table entries for full output (with compact overflow area)
+	vx_uint32   * fullWarpMergeIndexTable;              // fused warp merge index table for full output
+	vx_uint8    * fullExpCompValidTable;                // exposure comp gain table for full output
+	vx_size     fullExpCompValidCount;                  // number of exposure comp gain table entries for full output
+	vx_uint8    * fullOverlapPixelTable;                // exposure comp overlap table for full output
+	vx_size     fullOverlapPixelCount;                  // number of exposure comp overlap table entries for full output
+	vx_uint8    * fullBlendOffsetTable;                 // multiband blend work lists for full output
+	vx_int32    * expCompActiveMatrix;                  // exposure comp error matrix of the last full output frame
+	// internal tables shared across contexts
+	ls_context  table_owner;                            // context to share internal tables from (only until lsInitialize)
+	bool        tables_shared;                          // true if internal tables are shared with other contexts
+	StitchSeamFindPreference * seamfindPrefInitial;     // seamfind preferences after initialize for contexts sharing tables
+	// host memory of large internal buffers
+	HostMemoryStats host_memory;                        // host memory held by lens model buffers and warp tables
 	// attributes
 	vx_float32  live_stitch_attr[LIVE_STITCH_ATTR_MAX_COUNT];
 };
@@ -456,6 +533,8 @@ static void ResetLiveStitchGlobalAttributes()
 		g_live_stitch_attr[LIVE_STITCH_ATTR_MULTIBAND] = 1;
 		g_live_stitch_attr[LIVE_STITCH_ATTR_MULTIBAND_NUMBANDS] = 4;
 		g_live_stitch_attr[LIVE_STITCH_ATTR_STITCH_MODE] = (float)stitching_mode_normal;
+		g_live_stitch_attr[LIVE_STITCH_ATTR_HOST_HUGEPAGES] = 1;
+		g_live_stitch_attr[LIVE_STITCH_ATTR_HOST_NUMA_NODE] = -1;
 		// frame encoding default attributes
 		g_live_stitch_attr[LIVE_STITCH_ATTR_OUTPUT_TILE_NUM_X] = 1;
 		g_live_stitch_attr[LIVE_STITCH_ATTR_OUTPUT_TILE_NUM_Y] = 1;
@@ -464,6 +543,8 @@ static void ResetLiveStitchGlobalAttributes()
 		g_live_stitch_attr[LIVE_STITCH_ATTR_OUTPUT_ENCODER_WIDTH] = 3840;
 		g_live_stitch_attr[LIVE_STITCH_ATTR_OUTPUT_ENCODER_HEIGHT] = 2160;
 		g_live_stitch_attr[LIVE_STITCH_ATTR_OUTPUT_ENCODER_STRIDE_Y] = 3840;
+		g_live_stitch_attr[LIVE_STITCH_ATTR_OUTPUT_RENDITIONS] = 1;
+		g_live_stitch_attr[LIVE_STITCH_ATTR_OUTPUT_PROJECTION] = 0;
 		// chroma key default
 		g_live_stitch_attr[LIVE_STITCH_ATTR_CHROMA_KEY] = 0;
 		g_live_stitch_attr[LIVE_STITCH_ATTR_CHROMA_KEY_VALUE] = 8454016;
@@ -477,6 +558,15 @@ static void ResetLiveStitchGlobalAttributes()
 		g_live_stitch_attr[LIVE_STITCH_ATTR_NOISE_FILTER] = 0;
 		g_live_stitch_attr[LIVE_STITCH_ATTR_NOISE_FILTER_LAMBDA] = 1;
 		g_live_stitch_attr[LIVE_STITCH_ATTR_SAVE_AND_LOAD_INIT] = 0;
+		g_live_stitch_attr[LIVE_STITCH_ATTR_WARP_TABLE_FORMAT] = 0;
+		g_live_stitch_attr[LIVE_STITCH_ATTR_EXPCOMP_SOLVE_INTERVAL] = 1;
+		g_live_stitch_attr[LIVE_STITCH_ATTR_EXPCOMP_SOLVE_WINDOW] = 1;
+		g_live_stitch_attr[LIVE_STITCH_ATTR_EXPCOMP_GAIN_SMOOTHING] = 1;
+		g_live_stitch_attr[LIVE_STITCH_ATTR_SEAM_SCHEDULE] = 0;
+		g_live_stitch_attr[LIVE_STITCH_ATTR_SEAM_BUDGET] = 2;
+		g_live_stitch_attr[LIVE_STITCH_ATTR_SEAM_COARSE_SCALE] = 0;
+		g_live_stitch_attr[LIVE_STITCH_ATTR_FUSED_WARP_MERGE] = 0;
+		g_live_stitch_attr[LIVE_STITCH_ATTR_PACKED_INTERMEDIATES] = 0;
 	}
 }
 static std::vector<std::string> split(std::string str, char delimiter) {
@@ -517,10 +607,13 @@ static const char * GetFileNameSuffix(ls_context stitch, vx_reference ref, bool&
 		{ (vx_reference)stitch->ValidPixelEntry,       false, false, "warp-valid.bin" },
 		{ (vx_reference)stitch->WarpRemapEntry,        false, false, "warp-remap.bin" },
 		{ (vx_reference)stitch->RGBY1,                 false, false, "warp-rgby.raw" },
+		{ (vx_reference)stitch->warp_merge_index_image, false, false, "warp-merge-index.raw" },
 		{ (vx_reference)stitch->cam_id_image,          false, false, "merge-camid.raw" },
 		{ (vx_reference)stitch->group1_image,          false, false, "merge-group1.raw" },
 		{ (vx_reference)stitch->group2_image,          false, false, "merge-group2.raw" },
+		{ (vx_reference)stitch->merge_overflow_array,  false, false, "merge-overflow.bin" },
 		{ (vx_reference)stitch->weight_image,          false, false, "merge-weight.raw" },
+		{ (vx_reference)stitch->camera_plane_array,    false, false, "merge-planes.bin" },
 		{ (vx_reference)stitch->valid_array,           false, false, "exp-valid.bin" },
 		{ (vx_reference)stitch->OverlapPixelEntry,     false, false, "exp-overlap.bin" },
 		{ (vx_reference)stitch->overlap_matrix,        false, true,  "exp-count.bin" },
@@ -538,6 +631,8 @@ static const char * GetFileNameSuffix(ls_context stitch, vx_reference ref, bool&
 		{ (vx_reference)stitch->blend_offsets,         false, false, "blend-offsets.bin" },
 		{ (vx_reference)stitch->camera_remap,          false, false, "remap-input.raw" },
 		{ (vx_reference)stitch->overlay_remap,         false, false, "remap-overlay.raw" },
+		{ (vx_reference)stitch->OverlayValidPixelEntry, false, false, "overlay-valid.bin" },
+		{ (vx_reference)stitch->OverlayWarpRemapEntry, false, false, "overlay-remap.bin" },
 		// intermediate temporary data
 		{ (vx_reference)stitch->Img_input,             true,  false, "camera-input.raw" },
 		{ (vx_reference)stitch->Img_overlay,           true,  false, "overlay-input.raw" },
@@ -560,10 +655,13 @@ static vx_status DumpInternalTables(ls_context stitch, const char * fileNamePref
 		(vx_reference)stitch->ValidPixelEntry,
 		(vx_reference)stitch->WarpRemapEntry,
 		(vx_reference)stitch->RGBY1,
+		(vx_reference)stitch->warp_merge_index_image,
 		(vx_reference)stitch->cam_id_image,
 		(vx_reference)stitch->group1_image,
 		(vx_reference)stitch->group2_image,
+		(vx_reference)stitch->merge_overflow_array,
 		(vx_reference)stitch->weight_image,
+		(vx_reference)stitch->camera_plane_array,
 		(vx_reference)stitch->valid_array,
 		(vx_reference)stitch->OverlapPixelEntry,
 		(vx_reference)stitch->overlap_matrix,
@@ -581,6 +679,8 @@ static vx_status DumpInternalTables(ls_context stitch, const char * fileNamePref
 		(vx_reference)stitch->blend_offsets,
 		(vx_reference)stitch->camera_remap,
 		(vx_reference)stitch->overlay_remap,
+		(vx_reference)stitch->OverlayValidPixelEntry,
+		(vx_reference)stitch->OverlayWarpRemapEntry,
 		// intermediate temporary data
 		(vx_reference)stitch->Img_input,
 		(vx_reference)stitch->Img_overlay,
@@ -628,10 +728,13 @@ static vx_status SyncInternalTables(ls_context stitch)
 	vx_reference refList[] = {
 		(vx_reference)stitch->ValidPixelEntry,
 		(vx_reference)stitch->WarpRemapEntry,
+		(vx_reference)stitch->warp_merge_index_image,
 		(vx_reference)stitch->cam_id_image,
 		(vx_reference)stitch->group1_image,
 		(vx_reference)stitch->group2_image,
+		(vx_reference)stitch->merge_overflow_array,
 		(vx_reference)stitch->weight_image,
+		(vx_reference)stitch->camera_plane_array,
 		(vx_reference)stitch->valid_mask_image,
 		(vx_reference)stitch->valid_array,
 		(vx_reference)stitch->OverlapPixelEntry,
@@ -647,6 +750,8 @@ static vx_status SyncInternalTables(ls_context stitch)
 		(vx_reference)stitch->RGBY1,
 		(vx_reference)stitch->RGBY2,
 		(vx_reference)stitch->overlay_remap,
+		(vx_reference)stitch->OverlayValidPixelEntry,
+		(vx_reference)stitch->OverlayWarpRemapEntry,
 		(vx_reference)stitch->camera_remap,
 	};
 	for (vx_size i = 0; i < dimof(refList); i++) {
@@ -685,6 +790,7 @@ static vx_status quickSetupDumpTableSizes(ls_context stitch)
 	fprintf(fp, VX_FMT_SIZE, stitch->table_sizes.seamFindValidTableSize); fprintf(fp, "\n");
 	fprintf(fp, VX_FMT_SIZE, stitch->table_sizes.seamFindWeightTableSize); fprintf(fp, "\n");
 	fprintf(fp, VX_FMT_SIZE, stitch->table_sizes.warpTableSize); fprintf(fp, "\n");
+	fprintf(fp, VX_FMT_SIZE, stitch->table_sizes.mergeOverflowTableSize); fprintf(fp, "\n");
 	fclose(fp);
 
 	return VX_SUCCESS;
@@ -698,6 +804,7 @@ static vx_status quickSetupDumpTables(ls_context stitch)
 		(vx_reference)stitch->cam_id_image,
 		(vx_reference)stitch->group1_image,
 		(vx_reference)stitch->group2_image,
+		(vx_reference)stitch->merge_overflow_array,
 		(vx_reference)stitch->weight_image,
 		(vx_reference)stitch->valid_array,
 		(vx_reference)stitch->OverlapPixelEntry,
@@ -780,9 +887,15 @@ vx_status loadArray(vx_array arr, const char * fileName)
 	vx_uint8 * ptr;
 	vx_size stride;
 	ERROR_CHECK_STATUS_(vxMapArrayRange(arr, 0, numItems, &map_id, &stride, (void **)&ptr, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, 0));
-	ERROR_CHECK_FREAD_(fread(ptr, itemSize, numItems, fp),numItems);
+	// arrays can be dumped with fewer items than their capacity (e.g., compact warp remap table)
+	vx_size count = fread(ptr, itemSize, numItems, fp);
 	ERROR_CHECK_STATUS_(vxUnmapArrayRange(arr, map_id));
 	fclose(fp);
+	if (count == 0) {
+		ls_printf("ERROR: loadArray: unable to read items from: %s\n", fileName);
+		return VX_FAILURE;
+	}
+	ERROR_CHECK_STATUS_(vxTruncateArray(arr, count));
 	return VX_SUCCESS;
 }
 static vx_status loadMatrix(vx_matrix mat, const char * fileName)
@@ -863,6 +976,8 @@ static vx_status quickSetupLoadTableSizes(ls_context stitch)
 	if (!readValue) { ls_printf("ERROR: quickSetupLoadTableSizes: unable to read file\n"); return VX_FAILURE; }
 	readValue = fscanf(fp, VX_FMT_SIZE, &stitch->table_sizes.warpTableSize); 
 	if (!readValue) { ls_printf("ERROR: quickSetupLoadTableSizes: unable to read file\n"); return VX_FAILURE; }
+	readValue = fscanf(fp, VX_FMT_SIZE, &stitch->table_sizes.mergeOverflowTableSize); 
+	if (readValue != 1) { ls_printf("ERROR: quickSetupLoadTableSizes: unable to read file\n"); return VX_FAILURE; }
 
 	return VX_SUCCESS;
 }
@@ -876,6 +991,7 @@ static vx_status quickSetupLoadTables(ls_context stitch)
 		(vx_reference)stitch->cam_id_image,
 		(vx_reference)stitch->group1_image,
 		(vx_reference)stitch->group2_image,
+		(vx_reference)stitch->merge_overflow_array,
 		(vx_reference)stitch->weight_image,
 		(vx_reference)stitch->valid_array,
 		(vx_reference)stitch->OverlapPixelEntry,
@@ -917,7 +1033,7 @@ static vx_status setupQuickInitializeParams(ls_context stitch)
 	vx_uint32 eqrWidth = stitch->output_rgb_buffer_width;
 	vx_uint32 eqrHeight = stitch->output_rgb_buffer_height;
 	// compute camera warp parameters and check for supported lens types
-	float Mcam[32 * 9], Tcam[32 * 3], fcam[32 * 2], Mr[3 * 3];
+	float Mcam[LIVE_STITCH_MAX_CAMERAS * 9], Tcam[LIVE_STITCH_MAX_CAMERAS * 3], fcam[LIVE_STITCH_MAX_CAMERAS * 2], Mr[3 * 3];
 	vx_status status = CalculateCameraWarpParameters(numCamera, camWidth, camHeight, &stitch->rig_par, stitch->camera_par, Mcam, Tcam, fcam, Mr);
 	if (status != VX_SUCCESS) return status;
 
@@ -1007,12 +1123,18 @@ static vx_status setupQuickInitializeGraph(ls_context stitch)
 
 	return VX_SUCCESS;
 }
+//! \brief Allocate large host buffers with hugepages and NUMA placement (see LIVE_STITCH_ATTR_HOST_HUGEPAGES and LIVE_STITCH_ATTR_HOST_NUMA_NODE).
+template<typename T> static T * AllocateHostBuffer(ls_context stitch, vx_size count)
+{
+	return (T *)HostMemoryAlloc(&stitch->host_memory, count * sizeof(T),
+		stitch->live_stitch_attr[LIVE_STITCH_ATTR_HOST_HUGEPAGES] != 0, (vx_int32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_HOST_NUMA_NODE]);
+}
 static vx_status AllocateLensModelBuffersForCamera(ls_context stitch)
 {
-	stitch->camSrcMap = new StitchCoord2dFloat[stitch->output_rgb_buffer_width * stitch->output_rgb_buffer_height * stitch->num_cameras];
-	stitch->validPixelCamMap = new vx_uint32[stitch->output_rgb_buffer_width * stitch->output_rgb_buffer_height];
-	stitch->camIndexTmpBuf = new vx_float32[stitch->output_rgb_buffer_width * stitch->output_rgb_buffer_height];
-	stitch->camIndexBuf = new vx_uint8[stitch->output_rgb_buffer_width * stitch->output_rgb_buffer_height];
+	ERROR_CHECK_ALLOC_(stitch->camSrcMap = AllocateHostBuffer<StitchCoord2dFloat>(stitch, stitch->output_rgb_buffer_width * stitch->output_rgb_buffer_height * stitch->num_cameras));
+	ERROR_CHECK_ALLOC_(stitch->validPixelCamMap = AllocateHostBuffer<vx_uint64>(stitch, stitch->output_rgb_buffer_width * stitch->output_rgb_buffer_height));
+	ERROR_CHECK_ALLOC_(stitch->camIndexTmpBuf = AllocateHostBuffer<vx_float32>(stitch, stitch->output_rgb_buffer_width * stitch->output_rgb_buffer_height));
+	ERROR_CHECK_ALLOC_(stitch->camIndexBuf = AllocateHostBuffer<vx_uint8>(stitch, stitch->output_rgb_buffer_width * stitch->output_rgb_buffer_height));
 	if (stitch->stitching_mode == stitching_mode_normal) {
 		if (stitch->EXPO_COMP) {
 			stitch->overlapMatrixBuf = new vx_int32[stitch->num_cameras * stitch->num_cameras];
@@ -1024,7 +1146,7 @@ static vx_status AllocateLensModelBuffersForCamera(ls_context stitch)
 			else {
 				stitch->paddingPixelCount = (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_MULTIBAND_PAD_PIXELS];
 			}
-			stitch->paddedPixelCamMap = new vx_uint32[stitch->output_rgb_buffer_width * stitch->output_rgb_buffer_height];
+			ERROR_CHECK_ALLOC_(stitch->paddedPixelCamMap = AllocateHostBuffer<vx_uint64>(stitch, stitch->output_rgb_buffer_width * stitch->output_rgb_buffer_height));
 		}
 		stitch->overlapRectBuf = new vx_rectangle_t[2 * stitch->num_cameras * stitch->num_cameras];
 		for (vx_uint32 cam = 0; cam < stitch->num_cameras; cam++) {
@@ -1062,19 +1184,19 @@ static vx_status AllocateLensModelBuffersForCamera(ls_context stitch)
 }
 static vx_status AllocateLensModelBuffersForOverlay(ls_context stitch)
 {
-	stitch->overlaySrcMap = new StitchCoord2dFloat[stitch->output_rgb_buffer_width * stitch->output_rgb_buffer_height * stitch->num_overlays];
-	stitch->validPixelOverlayMap = new vx_uint32[stitch->output_rgb_buffer_width * stitch->output_rgb_buffer_height];
-	stitch->overlayIndexTmpBuf = new vx_float32[stitch->output_rgb_buffer_width * stitch->output_rgb_buffer_height];
-	stitch->overlayIndexBuf = new vx_uint8[stitch->output_rgb_buffer_width * stitch->output_rgb_buffer_height];
+	ERROR_CHECK_ALLOC_(stitch->overlaySrcMap = AllocateHostBuffer<StitchCoord2dFloat>(stitch, stitch->output_rgb_buffer_width * stitch->output_rgb_buffer_height * stitch->num_overlays));
+	ERROR_CHECK_ALLOC_(stitch->validPixelOverlayMap = AllocateHostBuffer<vx_uint64>(stitch, stitch->output_rgb_buffer_width * stitch->output_rgb_buffer_height));
+	ERROR_CHECK_ALLOC_(stitch->overlayIndexTmpBuf = AllocateHostBuffer<vx_float32>(stitch, stitch->output_rgb_buffer_width * stitch->output_rgb_buffer_height));
+	ERROR_CHECK_ALLOC_(stitch->overlayIndexBuf = AllocateHostBuffer<vx_uint8>(stitch, stitch->output_rgb_buffer_width * stitch->output_rgb_buffer_height));
 	return VX_SUCCESS;
 }
 static vx_status InitializeInternalTablesForRemap(ls_context stitch, vx_remap remap,
 	vx_uint32 numCamera, vx_uint32 numCameraColumns, vx_uint32 camWidth, vx_uint32 camHeight, vx_uint32 eqrWidth, vx_uint32 eqrHeight,
 	const rig_params * rig_par, const camera_params * cam_par,
-	StitchCoord2dFloat * srcMap, vx_uint32 * validPixelMap, vx_float32 * camIndexTmpBuf, vx_uint8 * camIndexBuf)
+	StitchCoord2dFloat * srcMap, vx_uint64 * validPixelMap, vx_float32 * camIndexTmpBuf, vx_uint8 * camIndexBuf)
 {
 	// compute lens distortion and warp models
-	vx_status status = CalculateLensDistortionAndWarpMaps(stitch->stitchInitData, numCamera, camWidth, camHeight, eqrWidth, eqrHeight,
+	vx_status status = CalculateLensDistortionAndWarpMaps(stitch->stitchInitData, numCamera, camWidth, camHeight, eqrWidth, eqrHeight, stitch->OUTPUT_PROJECTION,
 		rig_par, cam_par, validPixelMap, 0, nullptr, srcMap, camIndexTmpBuf, camIndexBuf);
 
 	if (status != VX_SUCCESS) {
@@ -1105,18 +1227,145 @@ static vx_status InitializeInternalTablesForRemap(ls_context stitch, vx_remap re
 
 	return VX_SUCCESS;
 }
+static vx_status InitializeInternalTablesForOverlay(ls_context stitch)
+{
+	vx_uint32 overlayWidth = stitch->overlay_buffer_width / stitch->num_overlay_columns;
+	vx_uint32 overlayHeight = stitch->overlay_buffer_height / stitch->num_overlay_rows;
+	vx_uint32 eqrWidth = stitch->output_rgb_buffer_width;
+	vx_uint32 eqrHeight = stitch->output_rgb_buffer_height;
+	if (stitch->overlay_remap) {
+		return InitializeInternalTablesForRemap(stitch, stitch->overlay_remap,
+			stitch->num_overlays, stitch->num_overlay_columns, overlayWidth, overlayHeight, eqrWidth, eqrHeight,
+			&stitch->rig_par, stitch->overlay_par, stitch->overlaySrcMap, stitch->validPixelOverlayMap,
+			stitch->overlayIndexTmpBuf, stitch->overlayIndexBuf);
+	}
+
+	// compute lens distortion and warp models
+	vx_status status = CalculateLensDistortionAndWarpMaps(stitch->stitchInitData, stitch->num_overlays, overlayWidth, overlayHeight, eqrWidth, eqrHeight, stitch->OUTPUT_PROJECTION,
+		&stitch->rig_par, stitch->overlay_par, stitch->validPixelOverlayMap, 0, nullptr, stitch->overlaySrcMap, stitch->overlayIndexTmpBuf, stitch->overlayIndexBuf);
+	if (status != VX_SUCCESS) {
+		ls_printf("ERROR: InitializeInternalTablesForOverlay: CalculateLensDistortionAndWarpMaps() failed (%d)\n", status);
+		return status;
+	}
+
+	// overlay tables only have entries for output pixels with overlays: when lsReinitialize
+	// can move the overlays, the tables need capacity for the whole output
+	bool useWideTables = stitch->useWideTables || std::max(stitch->overlay_buffer_width, stitch->overlay_buffer_height) > STITCH_WARP_COMPACT_MAX_SRC_SIZE ||
+		stitch->num_overlays > STITCH_WARP_COMPACT_MAX_CAMERAS;
+	if (!stitch->OverlayValidPixelEntry) {
+		vx_size tableSize = (vx_size)(eqrWidth >> 3) * eqrHeight;
+		if (!stitch->feature_enable_reinitialize) {
+			ERROR_CHECK_STATUS_(CalculateOverlayBufferSize(stitch->num_overlays, eqrWidth, eqrHeight, stitch->overlayIndexBuf, &tableSize));
+		}
+		tableSize = std::max(tableSize, (vx_size)1);
+		vx_enum StitchValidPixelEntryType, StitchWarpRemapEntryType;
+		ERROR_CHECK_TYPE_(StitchValidPixelEntryType = vxRegisterUserStruct(stitch->context, useWideTables ? sizeof(StitchValidPixelWideEntry) : sizeof(StitchValidPixelEntry)));
+		ERROR_CHECK_TYPE_(StitchWarpRemapEntryType = vxRegisterUserStruct(stitch->context, sizeof(StitchWarpRemapEntry)));
+		ERROR_CHECK_OBJECT_(stitch->OverlayValidPixelEntry = vxCreateArray(stitch->context, StitchValidPixelEntryType, tableSize));
+		ERROR_CHECK_OBJECT_(stitch->OverlayWarpRemapEntry = vxCreateArray(stitch->context, StitchWarpRemapEntryType, tableSize));
+	}
+
+	// initialize overlay tables
+	vx_size tableSize = 0;
+	ERROR_CHECK_STATUS_(vxQueryArray(stitch->OverlayValidPixelEntry, VX_ARRAY_CAPACITY, &tableSize, sizeof(tableSize)));
+	StitchValidPixelWideEntry validPixelEntry = { 0 }; StitchValidPixelEntry *validPixelBuf = nullptr;
+	StitchWarpRemapEntry warpRemapEntry = { 0 }, *warpRemapBuf = nullptr;
+	ERROR_CHECK_STATUS_(vxTruncateArray(stitch->OverlayValidPixelEntry, 0));
+	ERROR_CHECK_STATUS_(vxTruncateArray(stitch->OverlayWarpRemapEntry, 0));
+	ERROR_CHECK_STATUS_(vxAddArrayItems(stitch->OverlayValidPixelEntry, tableSize, &validPixelEntry, 0));
+	ERROR_CHECK_STATUS_(vxAddArrayItems(stitch->OverlayWarpRemapEntry, tableSize, &warpRemapEntry, 0));
+	vx_size stride = 0, overlayEntryCount = 0; vx_map_id map_id_valid = 0, map_id_warp = 0;
+	ERROR_CHECK_STATUS_(vxMapArrayRange(stitch->OverlayValidPixelEntry, 0, tableSize, &map_id_valid, &stride, (void **)&validPixelBuf, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, 0));
+	ERROR_CHECK_STATUS_(vxMapArrayRange(stitch->OverlayWarpRemapEntry, 0, tableSize, &map_id_warp, &stride, (void **)&warpRemapBuf, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, 0));
+	status = GenerateOverlayBuffers(stitch->num_overlays, eqrWidth, eqrHeight, stitch->overlayIndexBuf, stitch->overlaySrcMap,
+		stitch->num_overlay_columns, overlayWidth, overlayHeight, tableSize,
+		useWideTables ? nullptr : validPixelBuf, useWideTables ? (StitchValidPixelWideEntry *)validPixelBuf : nullptr,
+		warpRemapBuf, &overlayEntryCount);
+	if (status == VX_SUCCESS && overlayEntryCount == 0) {
+		// no overlay in the output: keep one entry that gets skipped by the kernel
+		memset(validPixelBuf, 0xff, useWideTables ? sizeof(StitchValidPixelWideEntry) : sizeof(StitchValidPixelEntry));
+		overlayEntryCount = 1;
+	}
+	ERROR_CHECK_STATUS_(vxUnmapArrayRange(stitch->OverlayValidPixelEntry, map_id_valid));
+	ERROR_CHECK_STATUS_(vxUnmapArrayRange(stitch->OverlayWarpRemapEntry, map_id_warp));
+	if (status != VX_SUCCESS) {
+		ls_printf("ERROR: InitializeInternalTablesForOverlay: GenerateOverlayBuffers() failed (%d)\n", status);
+		return status;
+	}
+	ERROR_CHECK_STATUS_(vxTruncateArray(stitch->OverlayValidPixelEntry, overlayEntryCount));
+	ERROR_CHECK_STATUS_(vxTruncateArray(stitch->OverlayWarpRemapEntry, overlayEntryCount));
+
+	return VX_SUCCESS;
+}
+//! \brief Initialize RGBY1 & RGBY2 to invalid pixels.
+static vx_status InitializeWarpOutputImages(ls_context stitch)
+{
+	vx_uint32 numCamera = stitch->num_cameras;
+	vx_uint32 eqrWidth = stitch->output_rgb_buffer_width;
+	vx_uint32 eqrHeight = stitch->output_rgb_buffer_height;
+	vx_rectangle_t rect = { 0, 0, eqrWidth, eqrHeight * numCamera };
+	if (stitch->camera_plane_array) {
+		rect.end_x = stitch->packed_plane_width;
+		rect.end_y = stitch->packed_plane_height;
+	}
+	vx_imagepatch_addressing_t addr;
+	vx_map_id map_id;
+	vx_uint32 * ptr;
+	const __m128i r0 = _mm_set1_epi32(0x80000000);
+	if (stitch->RGBY1) {
+		ERROR_CHECK_STATUS_(vxMapImagePatch(stitch->RGBY1, &rect, 0, &map_id, &addr, (void **)&ptr, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, VX_NOGAP_X));
+		__m128i *dst = (__m128i*) ptr;
+		vx_size size_in_bytes = (addr.stride_y * addr.dim_y)&~127;
+		for (vx_uint32 i = 0; i < size_in_bytes; i += 128){
+			_mm_store_si128(dst++, r0);
+			_mm_store_si128(dst++, r0);
+			_mm_store_si128(dst++, r0);
+			_mm_store_si128(dst++, r0);
+			_mm_store_si128(dst++, r0);
+			_mm_store_si128(dst++, r0);
+			_mm_store_si128(dst++, r0);
+			_mm_store_si128(dst++, r0);
+		}
+		ERROR_CHECK_STATUS_(vxUnmapImagePatch(stitch->RGBY1, map_id));
+	}
+	if (stitch->RGBY2) {
+		ERROR_CHECK_STATUS_(vxMapImagePatch(stitch->RGBY2, &rect, 0, &map_id, &addr, (void **)&ptr, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, VX_NOGAP_X));
+		__m128i *dst = (__m128i*) ptr;
+		vx_size size_in_bytes = (addr.stride_y * addr.dim_y)&~127;
+		for (vx_uint32 i = 0; i < size_in_bytes; i += 128){
+			_mm_store_si128(dst++, r0);
+			_mm_store_si128(dst++, r0);
+			_mm_store_si128(dst++, r0);
+			_mm_store_si128(dst++, r0);
+			_mm_store_si128(dst++, r0);
+			_mm_store_si128(dst++, r0);
+			_mm_store_si128(dst++, r0);
+			_mm_store_si128(dst++, r0);
+		}
+		ERROR_CHECK_STATUS_(vxUnmapImagePatch(stitch->RGBY2, map_id));
+	}
+	return VX_SUCCESS;
+}
+//! \brief The capacity of the warp remap table: compact tables have an overflow area for escaped entries.
+static vx_size GetWarpRemapTableCapacity(ls_context stitch)
+{
+	vx_size capacity = stitch->table_sizes.warpTableSize;
+	if (stitch->WARP_TABLE_FORMAT == STITCH_WARP_TABLE_FORMAT_COMPACT)
+		capacity += STITCH_WARP_COMPACT_OVERFLOW_SIZE(capacity);
+	return capacity;
+}
 static vx_status InitializeInternalTablesForCamera(ls_context stitch)
 {
 	vx_uint32 numCamera = stitch->num_cameras;
 	vx_uint32 eqrWidth = stitch->output_rgb_buffer_width;
 	vx_uint32 eqrHeight = stitch->output_rgb_buffer_height;
-	const vx_uint32 * validPixelCamMap = stitch->validPixelCamMap;
-	const vx_uint32 * paddedPixelCamMap = stitch->paddedPixelCamMap;
+	const vx_uint64 * validPixelCamMap = stitch->validPixelCamMap;
+	const vx_uint64 * paddedPixelCamMap = stitch->paddedPixelCamMap;
 	const StitchCoord2dFloat * camSrcMap = stitch->camSrcMap;
 	const vx_rectangle_t * const * overlapValid = stitch->overlapValid;
 	const vx_rectangle_t * const * overlapPadded = stitch->overlapPadded;
-	const vx_uint32 * validCamOverlapInfo = stitch->validCamOverlapInfo;
-	const vx_uint32 * paddedCamOverlapInfo = stitch->paddedCamOverlapInfo;
+	const vx_uint64 * validCamOverlapInfo = stitch->validCamOverlapInfo;
+	const vx_uint64 * paddedCamOverlapInfo = stitch->paddedCamOverlapInfo;
 	const vx_uint8 * camIndexBuf = stitch->camIndexBuf;
 
 	if (stitch->feature_enable_reinitialize)
@@ -1125,7 +1374,7 @@ static vx_status InitializeInternalTablesForCamera(ls_context stitch)
 		vx_status status = CalculateLensDistortionAndWarpMaps(!stitch->USE_CPU_INIT ? stitch->stitchInitData : nullptr, stitch->num_cameras,
 			stitch->camera_rgb_buffer_width / stitch->num_camera_columns,
 			stitch->camera_rgb_buffer_height / stitch->num_camera_rows,
-			stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height,
+			stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height, stitch->OUTPUT_PROJECTION,
 			&stitch->rig_par, stitch->camera_par,
 			stitch->validPixelCamMap, stitch->paddingPixelCount, stitch->paddedPixelCamMap,
 			stitch->camSrcMap, stitch->camIndexTmpBuf, stitch->camIndexBuf);
@@ -1137,28 +1386,51 @@ static vx_status InitializeInternalTablesForCamera(ls_context stitch)
 			stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height,
 			stitch->validPixelCamMap, stitch->overlapValid, stitch->validCamOverlapInfo,
 			stitch->paddedPixelCamMap, stitch->overlapPadded, stitch->paddedCamOverlapInfo);
-		if (stitch->overlapCount > 6) {
-			vxAddLogEntry((vx_reference)stitch->context, status, "ERROR: AllocateInternalTablesForCamera: number of overlaps (%d) greater than 6 not supported\n", stitch->overlapCount);
-			return VX_ERROR_NOT_SUPPORTED;
-		}
 	}
 
 	{ // initialize warp tables
-		StitchValidPixelEntry validPixelEntry = { 0 }, *validPixelBuf = nullptr;
+		StitchValidPixelWideEntry validPixelEntry = { 0 }; StitchValidPixelEntry *validPixelBuf = nullptr;
 		StitchWarpRemapEntry warpRemapEntry = { 0 }, *warpRemapBuf = nullptr;
+		vx_size warpRemapCapacity = GetWarpRemapTableCapacity(stitch);
 		ERROR_CHECK_STATUS_(vxTruncateArray(stitch->ValidPixelEntry, 0));
 		ERROR_CHECK_STATUS_(vxTruncateArray(stitch->WarpRemapEntry, 0));
 		ERROR_CHECK_STATUS_(vxAddArrayItems(stitch->ValidPixelEntry, stitch->table_sizes.warpTableSize, &validPixelEntry, 0));
-		ERROR_CHECK_STATUS_(vxAddArrayItems(stitch->WarpRemapEntry, stitch->table_sizes.warpTableSize, &warpRemapEntry, 0));
-		vx_size stride = 0, warpEntryCount = 0; vx_map_id map_id_valid = 0, map_id_warp = 0;
+		ERROR_CHECK_STATUS_(vxAddArrayItems(stitch->WarpRemapEntry, warpRemapCapacity, &warpRemapEntry, 0));
+		vx_size stride = 0, warpEntryCount = 0, warpRemapCount = 0; vx_map_id map_id_valid = 0, map_id_warp = 0;
 		ERROR_CHECK_STATUS_(vxMapArrayRange(stitch->ValidPixelEntry, 0, stitch->table_sizes.warpTableSize, &map_id_valid, &stride, (void **)&validPixelBuf, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, 0));
-		ERROR_CHECK_STATUS_(vxMapArrayRange(stitch->WarpRemapEntry, 0, stitch->table_sizes.warpTableSize, &map_id_warp, &stride, (void **)&warpRemapBuf, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, 0));
+		ERROR_CHECK_STATUS_(vxMapArrayRange(stitch->WarpRemapEntry, 0, warpRemapCapacity, &map_id_warp, &stride, (void **)&warpRemapBuf, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, 0));
+		bool useCompactWarpTable = (stitch->WARP_TABLE_FORMAT == STITCH_WARP_TABLE_FORMAT_COMPACT);
 		vx_status status = GenerateWarpBuffers(numCamera, eqrWidth, eqrHeight,
 			validPixelCamMap, paddedPixelCamMap, camSrcMap,
 			stitch->num_camera_columns, stitch->camera_rgb_buffer_width / stitch->num_camera_columns,
-			stitch->table_sizes.warpTableSize, validPixelBuf, warpRemapBuf, &warpEntryCount);
+			stitch->table_sizes.warpTableSize,
+			stitch->useWideTables ? nullptr : validPixelBuf, stitch->useWideTables ? (StitchValidPixelWideEntry *)validPixelBuf : nullptr,
+			useCompactWarpTable ? nullptr : warpRemapBuf, useCompactWarpTable ? (StitchWarpRemapCompactEntry *)warpRemapBuf : nullptr,
+			&warpEntryCount, &warpRemapCount);
 		ERROR_CHECK_STATUS_(vxUnmapArrayRange(stitch->ValidPixelEntry, map_id_valid));
 		ERROR_CHECK_STATUS_(vxUnmapArrayRange(stitch->WarpRemapEntry, map_id_warp));
+		if (status == VX_ERROR_NOT_SUPPORTED && useCompactWarpTable) {
+			// too many escaped entries for the overflow area: switch to full warp remap table and generate again
+			ls_printf("WARNING: InitializeInternalTablesForCamera: camera remap doesn't fit into compact warp table: using full warp table\n");
+			stitch->WARP_TABLE_FORMAT = STITCH_WARP_TABLE_FORMAT_FULL;
+			vx_enum StitchWarpRemapEntryType;
+			ERROR_CHECK_TYPE_(StitchWarpRemapEntryType = vxRegisterUserStruct(stitch->context, sizeof(StitchWarpRemapEntry)));
+			ERROR_CHECK_STATUS_(vxReleaseArray(&stitch->WarpRemapEntry));
+			ERROR_CHECK_OBJECT_(stitch->WarpRemapEntry = vxCreateArray(stitch->context, StitchWarpRemapEntryType, stitch->table_sizes.warpTableSize));
+			if (stitch->WarpNode || stitch->WarpMergeNode) {
+				// re-initialize: replace the table in the graph, which gets verified again for the new table format
+				if (stitch->WarpNode) {
+					ERROR_CHECK_STATUS_(vxSetParameterByIndex(stitch->WarpNode, 3, (vx_reference)stitch->WarpRemapEntry));
+				}
+				if (stitch->WarpMergeNode) {
+					ERROR_CHECK_STATUS_(vxSetParameterByIndex(stitch->WarpMergeNode, 2, (vx_reference)stitch->WarpRemapEntry));
+				}
+				ERROR_CHECK_STATUS_(InitializeInternalTablesForCamera(stitch));
+				ERROR_CHECK_STATUS_(vxVerifyGraph(stitch->graphStitch));
+				return VX_SUCCESS;
+			}
+			return InitializeInternalTablesForCamera(stitch);
+		}
 		if (status != VX_SUCCESS) {
 			ls_printf("ERROR: InitializeInternalTablesForCamera: GenerateWarpBuffers() failed (%d)\n", status);
 			return status;
@@ -1172,7 +1444,41 @@ static vx_status InitializeInternalTablesForCamera(ls_context stitch)
 			return VX_FAILURE;
 		}
 		ERROR_CHECK_STATUS_(vxTruncateArray(stitch->ValidPixelEntry, warpEntryCount));
-		ERROR_CHECK_STATUS_(vxTruncateArray(stitch->WarpRemapEntry, warpEntryCount));
+		ERROR_CHECK_STATUS_(vxTruncateArray(stitch->WarpRemapEntry, useCompactWarpTable ? warpRemapCount : warpEntryCount));
+		if (stitch->camera_plane_array)
+		{ // move warp output locations into packed camera planes
+			ERROR_CHECK_STATUS_(vxMapArrayRange(stitch->ValidPixelEntry, 0, warpEntryCount, &map_id_valid, &stride, (void **)&validPixelBuf, VX_READ_AND_WRITE, VX_MEMORY_TYPE_HOST, 0));
+			status = PackWarpBuffers(numCamera, stitch->cameraPlanes, warpEntryCount,
+				stitch->useWideTables ? nullptr : validPixelBuf, stitch->useWideTables ? (StitchValidPixelWideEntry *)validPixelBuf : nullptr);
+			ERROR_CHECK_STATUS_(vxUnmapArrayRange(stitch->ValidPixelEntry, map_id_valid));
+			if (status != VX_SUCCESS) {
+				ls_printf("ERROR: InitializeInternalTablesForCamera: PackWarpBuffers() failed (%d)\n", status);
+				return status;
+			}
+		}
+	}
+	if (stitch->warp_merge_index_image)
+	{ // reorder warp tables by output location and initialize warp merge index table
+		vx_size stride = 0, warpEntryCount = 0; vx_map_id map_id_valid = 0, map_id_warp = 0, map_id_index = 0;
+		void * validPixelBuf = nullptr, *warpRemapBuf = nullptr; StitchWarpMergeIndexEntry * ptr_index = nullptr;
+		vx_rectangle_t rectIndex = { 0, 0, eqrWidth >> 3, eqrHeight };
+		vx_imagepatch_addressing_t addrIndex;
+		ERROR_CHECK_STATUS_(vxQueryArray(stitch->ValidPixelEntry, VX_ARRAY_NUMITEMS, &warpEntryCount, sizeof(warpEntryCount)));
+		ERROR_CHECK_STATUS_(vxMapArrayRange(stitch->ValidPixelEntry, 0, warpEntryCount, &map_id_valid, &stride, &validPixelBuf, VX_READ_AND_WRITE, VX_MEMORY_TYPE_HOST, 0));
+		ERROR_CHECK_STATUS_(vxMapArrayRange(stitch->WarpRemapEntry, 0, warpEntryCount, &map_id_warp, &stride, &warpRemapBuf, VX_READ_AND_WRITE, VX_MEMORY_TYPE_HOST, 0));
+		ERROR_CHECK_STATUS_(vxMapImagePatch(stitch->warp_merge_index_image, &rectIndex, 0, &map_id_index, &addrIndex, (void **)&ptr_index, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, VX_NOGAP_X));
+		bool useCompactWarpTable = (stitch->WARP_TABLE_FORMAT == STITCH_WARP_TABLE_FORMAT_COMPACT);
+		vx_status status = GenerateWarpMergeBuffers(eqrWidth, eqrHeight, warpEntryCount,
+			stitch->useWideTables ? nullptr : (StitchValidPixelEntry *)validPixelBuf, stitch->useWideTables ? (StitchValidPixelWideEntry *)validPixelBuf : nullptr,
+			useCompactWarpTable ? nullptr : (StitchWarpRemapEntry *)warpRemapBuf, useCompactWarpTable ? (StitchWarpRemapCompactEntry *)warpRemapBuf : nullptr,
+			addrIndex.stride_y, ptr_index);
+		ERROR_CHECK_STATUS_(vxUnmapArrayRange(stitch->ValidPixelEntry, map_id_valid));
+		ERROR_CHECK_STATUS_(vxUnmapArrayRange(stitch->WarpRemapEntry, map_id_warp));
+		ERROR_CHECK_STATUS_(vxUnmapImagePatch(stitch->warp_merge_index_image, map_id_index));
+		if (status != VX_SUCCESS) {
+			ls_printf("ERROR: InitializeInternalTablesForCamera: GenerateWarpMergeBuffers() failed (%d)\n", status);
+			return status;
+		}
 	}
 
 	{ // initialize merge tables
@@ -1183,17 +1489,49 @@ static vx_status InitializeInternalTablesForCamera(ls_context stitch)
 		ERROR_CHECK_STATUS_(vxMapImagePatch(stitch->cam_id_image, &rectId, 0, &map_id_camId, &addrId, (void **)&ptr_camId, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, VX_NOGAP_X));
 		ERROR_CHECK_STATUS_(vxMapImagePatch(stitch->group1_image, &rectId, 0, &map_id_camG1, &addrG1, (void **)&ptr_camG1, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, VX_NOGAP_X));
 		ERROR_CHECK_STATUS_(vxMapImagePatch(stitch->group2_image, &rectId, 0, &map_id_camG2, &addrG2, (void **)&ptr_camG2, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, VX_NOGAP_X));
+		vx_size stride = 0, overflowEntryCount = 0; vx_map_id map_id_overflow = 0;
+		void * overflowBuf = nullptr;
+		bool wideMerge = numCamera > STITCH_MERGE_MAX_CAMID_CAMERAS;
+		if (stitch->merge_overflow_array) {
+			// blocks with more than STITCH_MERGE_MAX_GROUP_CAMERAS cameras (all multi-camera blocks with wide merge tables) go into overflow table
+			vx_uint64 overflowEntry = 0;
+			ERROR_CHECK_STATUS_(vxTruncateArray(stitch->merge_overflow_array, 0));
+			ERROR_CHECK_STATUS_(vxAddArrayItems(stitch->merge_overflow_array, stitch->table_sizes.mergeOverflowTableSize, &overflowEntry, 0));
+			ERROR_CHECK_STATUS_(vxMapArrayRange(stitch->merge_overflow_array, 0, stitch->table_sizes.mergeOverflowTableSize, &map_id_overflow, &stride, (void **)&overflowBuf, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, 0));
+		}
 		vx_status status = GenerateMergeBuffers(numCamera, eqrWidth, eqrHeight,
 			validPixelCamMap, paddedPixelCamMap,
-			addrId.stride_y, addrG1.stride_y, addrG2.stride_y, ptr_camId, ptr_camG1, ptr_camG2);
+			addrId.stride_y, addrG1.stride_y, addrG2.stride_y, ptr_camId, ptr_camG1, ptr_camG2,
+			stitch->table_sizes.mergeOverflowTableSize, wideMerge ? nullptr : (vx_uint32 *)overflowBuf, &overflowEntryCount,
+			wideMerge ? (vx_uint64 *)overflowBuf : nullptr);
 		ERROR_CHECK_STATUS_(vxUnmapImagePatch(stitch->cam_id_image, map_id_camId));
 		ERROR_CHECK_STATUS_(vxUnmapImagePatch(stitch->group1_image, map_id_camG1));
 		ERROR_CHECK_STATUS_(vxUnmapImagePatch(stitch->group2_image, map_id_camG2));
+		if (stitch->merge_overflow_array) {
+			ERROR_CHECK_STATUS_(vxUnmapArrayRange(stitch->merge_overflow_array, map_id_overflow));
+		}
 		if (status != VX_SUCCESS) {
 			ls_printf("ERROR: InitializeInternalTablesForCamera: GenerateMergeBuffers() failed (%d)\n", status);
 			return status;
 		}
+		if (stitch->merge_overflow_array) {
+			ERROR_CHECK_STATUS_(vxTruncateArray(stitch->merge_overflow_array, overflowEntryCount));
+		}
+		else if (stitch->overlapCount > STITCH_MERGE_MAX_GROUP_CAMERAS) {
+			ls_printf("WARNING: InitializeInternalTablesForCamera: merge uses first %d of %d overlapping cameras\n", STITCH_MERGE_MAX_GROUP_CAMERAS, stitch->overlapCount);
+		}
+	}
+	if (stitch->camera_plane_array)
+	{ // initialize packed weight image
+		vx_rectangle_t rectMask = { 0, 0, stitch->packed_plane_width, stitch->packed_plane_height };
+		vx_imagepatch_addressing_t addrMask;
+		vx_map_id map_id_mask;
+		vx_uint8 * ptr_mask;
+		ERROR_CHECK_STATUS_(vxMapImagePatch(stitch->weight_image, &rectMask, 0, &map_id_mask, &addrMask, (void **)&ptr_mask, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, VX_NOGAP_X));
+		GeneratePackedMergeMaskImage(numCamera, eqrWidth, eqrHeight, camIndexBuf, stitch->cameraPlanes, stitch->packed_plane_width, addrMask.stride_y, ptr_mask);
+		ERROR_CHECK_STATUS_(vxUnmapImagePatch(stitch->weight_image, map_id_mask));
 	}
+	else
 	{ // initialize weight and valid mask images
 		vx_rectangle_t rectMask = { 0, 0, eqrWidth, eqrHeight * numCamera };
 		vx_imagepatch_addressing_t addrMask;
@@ -1205,8 +1543,8 @@ static vx_status InitializeInternalTablesForCamera(ls_context stitch)
 	}
 	if (stitch->EXPO_COMP)
 	{ // exposure comp tables
-		StitchExpCompCalcEntry validEntry = { 0 }, *validBuf = nullptr;
-		StitchOverlapPixelEntry overlapEntry = { 0 }, *overlapBuf = nullptr;
+		StitchExpCompCalcWideEntry validEntry = { 0 }; StitchExpCompCalcEntry *validBuf = nullptr;
+		StitchOverlapPixelWideEntry overlapEntry = { 0 }; StitchOverlapPixelEntry *overlapBuf = nullptr;
 		vx_size stride = 0, validEntryCount = 0, overlapEntryCount = 0; vx_map_id map_id_valid = 0, map_id_overlap = 0;
 		ERROR_CHECK_STATUS_(vxTruncateArray(stitch->valid_array, 0));
 		ERROR_CHECK_STATUS_(vxAddArrayItems(stitch->valid_array, stitch->table_sizes.expCompValidTableSize, &validEntry, 0));
@@ -1221,7 +1559,9 @@ static vx_status InitializeInternalTablesForCamera(ls_context stitch)
 			paddedPixelCamMap, overlapPadded, paddedCamOverlapInfo,
 			stitch->table_sizes.expCompValidTableSize,
 			stitch->table_sizes.expCompOverlapTableSize,
-			validBuf, overlapBuf, &validEntryCount, &overlapEntryCount, stitch->overlapMatrixBuf);
+			stitch->useWideTables ? nullptr : validBuf, stitch->useWideTables ? nullptr : overlapBuf,
+			stitch->useWideTables ? (StitchExpCompCalcWideEntry *)validBuf : nullptr, stitch->useWideTables ? (StitchOverlapPixelWideEntry *)overlapBuf : nullptr,
+			&validEntryCount, &overlapEntryCount, stitch->overlapMatrixBuf);
 		ERROR_CHECK_STATUS_(vxUnmapArrayRange(stitch->valid_array, map_id_valid));
 		if (stitch->EXPO_COMP < 3) {
 			ERROR_CHECK_STATUS_(vxUnmapArrayRange(stitch->OverlapPixelEntry, map_id_overlap));
@@ -1339,25 +1679,42 @@ static vx_status InitializeInternalTablesForCamera(ls_context stitch)
 		
 		// initialize seamfind mask image
 		vx_rectangle_t rectMask = { 0, 0, eqrWidth, eqrHeight * numCamera };
+		if (stitch->camera_plane_array) {
+			rectMask.end_x = stitch->packed_plane_width;
+			rectMask.end_y = stitch->packed_plane_height;
+		}
 		vx_imagepatch_addressing_t addrMask;
 		vx_map_id map_id_mask;
 		vx_uint8 * ptr_mask;
 		ERROR_CHECK_STATUS_(vxMapImagePatch(stitch->seamfind_weight_image, &rectMask, 0, &map_id_mask, &addrMask, (void **)&ptr_mask, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, VX_NOGAP_X));
-		GenerateDefaultMergeMaskImage(numCamera, eqrWidth, eqrHeight, camIndexBuf, addrMask.stride_y, ptr_mask);
+		if (stitch->camera_plane_array)
+			GeneratePackedMergeMaskImage(numCamera, eqrWidth, eqrHeight, camIndexBuf, stitch->cameraPlanes, stitch->packed_plane_width, addrMask.stride_y, ptr_mask);
+		else
+			GenerateDefaultMergeMaskImage(numCamera, eqrWidth, eqrHeight, camIndexBuf, addrMask.stride_y, ptr_mask);
 		ERROR_CHECK_STATUS_(vxUnmapImagePatch(stitch->seamfind_weight_image, map_id_mask));
 	}
 
 	if (stitch->MULTIBAND_BLEND)
 	{ // multiband blend tables
 		vx_size stride;
-		StitchBlendValidEntry blendValidEntry = { 0 }, *blendOffsetTable = nullptr;
+		StitchBlendValidWideEntry blendValidEntry = { 0 }; StitchBlendValidEntry *blendOffsetTable = nullptr;
 		vx_map_id mapIdValid;
 		ERROR_CHECK_STATUS_(vxTruncateArray(stitch->blend_offsets, 0));
 		ERROR_CHECK_STATUS_(vxAddArrayItems(stitch->blend_offsets, stitch->table_sizes.blendOffsetTableSize, &blendValidEntry, 0));
 		ERROR_CHECK_STATUS_(vxMapArrayRange(stitch->blend_offsets, 0, stitch->table_sizes.blendOffsetTableSize, &mapIdValid, &stride, (void **)&blendOffsetTable, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, VX_NOGAP_X));
 		vx_status status = GenerateBlendBuffers(numCamera, eqrWidth, eqrHeight, stitch->num_bands,
 			validPixelCamMap, paddedPixelCamMap, overlapPadded, paddedCamOverlapInfo,
-			stitch->multibandBlendOffsetIntoBuffer, stitch->table_sizes.blendOffsetTableSize, blendOffsetTable);
+			stitch->multibandBlendOffsetIntoBuffer, stitch->table_sizes.blendOffsetTableSize,
+			stitch->useWideTables ? nullptr : blendOffsetTable, stitch->useWideTables ? (StitchBlendValidWideEntry *)blendOffsetTable : nullptr);
+		if (status == VX_SUCCESS && stitch->camera_plane_array) {
+			status = PackBlendBuffers(numCamera, stitch->num_bands, stitch->cameraPlanes, stitch->multibandBlendOffsetIntoBuffer,
+				stitch->useWideTables ? nullptr : blendOffsetTable, stitch->useWideTables ? (StitchBlendValidWideEntry *)blendOffsetTable : nullptr);
+			if (status != VX_SUCCESS) {
+				ERROR_CHECK_STATUS_(vxUnmapArrayRange(stitch->blend_offsets, mapIdValid));
+				ls_printf("ERROR: InitializeInternalTablesForCamera: PackBlendBuffers() failed (%d)\n", status);
+				return status;
+			}
+		}
 		ERROR_CHECK_STATUS_(vxUnmapArrayRange(stitch->blend_offsets, mapIdValid));
 		if (status != VX_SUCCESS) {
 			ls_printf("ERROR: InitializeInternalTablesForCamera: GenerateBlendBuffers() failed (%d)\n", status);
@@ -1368,17 +1725,38 @@ static vx_status InitializeInternalTablesForCamera(ls_context stitch)
 	if (stitch->valid_mask_image)
 	{ // initialize valid pixel mask
 		vx_rectangle_t rectMask = { 0, 0, eqrWidth, eqrHeight * numCamera };
+		if (stitch->camera_plane_array) {
+			rectMask.end_x = stitch->packed_plane_width;
+			rectMask.end_y = stitch->packed_plane_height;
+		}
 		vx_imagepatch_addressing_t addrMask;
 		vx_map_id map_id_mask;
 		vx_uint8 * ptr_mask;
 		ERROR_CHECK_STATUS_(vxMapImagePatch(stitch->valid_mask_image, &rectMask, 0, &map_id_mask, &addrMask, (void **)&ptr_mask, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, VX_NOGAP_X));
-		GenerateValidMaskImage(numCamera, eqrWidth, eqrHeight, validPixelCamMap, addrMask.stride_y, ptr_mask);
+		if (stitch->camera_plane_array) {
+			// generate full camera planes and copy the rows of packed camera planes
+			std::vector<vx_uint8> validMask((size_t)eqrWidth * eqrHeight * numCamera);
+			GenerateValidMaskImage(numCamera, eqrWidth, eqrHeight, validPixelCamMap, eqrWidth, validMask.data());
+			vx_status status = PackCameraPlaneRows(numCamera, eqrHeight, stitch->cameraPlanes, 1, eqrWidth, validMask.data(), addrMask.stride_y, ptr_mask);
+			if (status != VX_SUCCESS) {
+				ERROR_CHECK_STATUS_(vxUnmapImagePatch(stitch->valid_mask_image, map_id_mask));
+				ls_printf("ERROR: InitializeInternalTablesForCamera: PackCameraPlaneRows() failed (%d)\n", status);
+				return status;
+			}
+		}
+		else {
+			GenerateValidMaskImage(numCamera, eqrWidth, eqrHeight, validPixelCamMap, addrMask.stride_y, ptr_mask);
+		}
 		ERROR_CHECK_STATUS_(vxUnmapImagePatch(stitch->valid_mask_image, map_id_mask));
 	}
 
 	// initialize blend mask image
 	if (stitch->blend_mask_image) {
 		vx_rectangle_t rectMask = { 0, 0, eqrWidth, eqrHeight * numCamera };
+		if (stitch->camera_plane_array) {
+			rectMask.end_x = stitch->packed_plane_width;
+			rectMask.end_y = stitch->packed_plane_height;
+		}
 		vx_imagepatch_addressing_t addrMask;
 		vx_map_id map_id_mask;
 		vx_uint8 * ptr_mask;
@@ -1386,55 +1764,147 @@ static vx_status InitializeInternalTablesForCamera(ls_context stitch)
 		memset(ptr_mask, 255, addrMask.stride_y * addrMask.dim_y);
 		ERROR_CHECK_STATUS_(vxUnmapImagePatch(stitch->blend_mask_image, map_id_mask));
 	}
-	{ // initialize RGBY1 & RGBY2 to invalid pixels and sync to GPU
-		vx_rectangle_t rect = { 0, 0, eqrWidth, eqrHeight * numCamera };
-		vx_imagepatch_addressing_t addr;
-		vx_map_id map_id;
-		vx_uint32 * ptr;
-		const __m128i r0 = _mm_set1_epi32(0x80000000);
-		ERROR_CHECK_STATUS_(vxMapImagePatch(stitch->RGBY1, &rect, 0, &map_id, &addr, (void **)&ptr, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, VX_NOGAP_X));
-		__m128i *dst = (__m128i*) ptr;
-		vx_size size_in_bytes = (addr.stride_y * addr.dim_y)&~127;
-		for (vx_uint32 i = 0; i < size_in_bytes; i += 128){
-			_mm_store_si128(dst++, r0);
-			_mm_store_si128(dst++, r0);
-			_mm_store_si128(dst++, r0);
-			_mm_store_si128(dst++, r0);
-			_mm_store_si128(dst++, r0);
-			_mm_store_si128(dst++, r0);
-			_mm_store_si128(dst++, r0);
-			_mm_store_si128(dst++, r0);
-		}
-		ERROR_CHECK_STATUS_(vxUnmapImagePatch(stitch->RGBY1, map_id));
-		if (stitch->RGBY2) {
-			ERROR_CHECK_STATUS_(vxMapImagePatch(stitch->RGBY2, &rect, 0, &map_id, &addr, (void **)&ptr, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, VX_NOGAP_X));
-			__m128i *dst = (__m128i*) ptr;
-			vx_size size_in_bytes = (addr.stride_y * addr.dim_y)&~127;
-			for (vx_uint32 i = 0; i < size_in_bytes; i += 128){
-				_mm_store_si128(dst++, r0);
-				_mm_store_si128(dst++, r0);
-				_mm_store_si128(dst++, r0);
-				_mm_store_si128(dst++, r0);
-				_mm_store_si128(dst++, r0);
-				_mm_store_si128(dst++, r0);
-				_mm_store_si128(dst++, r0);
-				_mm_store_si128(dst++, r0);
+	ERROR_CHECK_STATUS_(InitializeWarpOutputImages(stitch));
+	return VX_SUCCESS;
+}
+/*****************************************************************************************************************************************
+functions for internal tables shared across contexts
+*****************************************************************************************************************************************/
+//! \brief Check that internal tables of the table owner match the configuration of a context.
+static vx_status CheckSharedTableConfiguration(ls_context stitch)
+{
+	ls_context owner = stitch->table_owner;
+	bool isSame = stitch->stitching_mode == owner->stitching_mode &&
+		stitch->num_cameras == owner->num_cameras &&
+		stitch->num_camera_rows == owner->num_camera_rows && stitch->num_camera_columns == owner->num_camera_columns &&
+		stitch->camera_rgb_buffer_width == owner->camera_rgb_buffer_width && stitch->camera_rgb_buffer_height == owner->camera_rgb_buffer_height &&
+		stitch->output_rgb_buffer_width == owner->output_rgb_buffer_width && stitch->output_rgb_buffer_height == owner->output_rgb_buffer_height &&
+		!memcmp(&stitch->rig_par, &owner->rig_par, sizeof(rig_params)) &&
+		!memcmp(stitch->camera_par, owner->camera_par, stitch->num_cameras * sizeof(camera_params));
+	for (vx_uint32 attr = 0; isSame && attr < LIVE_STITCH_ATTR_MAX_COUNT; attr++) {
+		// attributes that can be changed after initialize don't affect internal tables
+		if (attr == LIVE_STITCH_ATTR_SEAM_THRESHOLD || attr == LIVE_STITCH_ATTR_NOISE_FILTER_LAMBDA ||
+			attr == LIVE_STITCH_ATTR_SEAM_BUDGET || attr == LIVE_STITCH_ATTR_EXPCOMP_GAIN_SMOOTHING)
+			continue;
+		isSame = (stitch->live_stitch_attr[attr] == owner->live_stitch_attr[attr]);
+	}
+	if (!isSame) {
+		ls_printf("ERROR: lsInitialize: configuration, camera parameters and attributes need to be identical with the table owner to share internal tables\n");
+		return VX_ERROR_INVALID_PARAMETERS;
+	}
+	return VX_SUCCESS;
+}
+//! \brief Pick internal table sizes and the features enabled by the table owner.
+static vx_status ShareInternalTableSizes(ls_context stitch)
+{
+	ls_context owner = stitch->table_owner;
+	stitch->table_sizes = owner->table_sizes;
+	stitch->EXPO_COMP = owner->EXPO_COMP;
+	stitch->SEAM_FIND = owner->SEAM_FIND;
+	stitch->MULTIBAND_BLEND = owner->MULTIBAND_BLEND;
+	stitch->num_bands = owner->num_bands;
+	stitch->paddingPixelCount = owner->paddingPixelCount;
+	stitch->overlapCount = owner->overlapCount;
+	stitch->WARP_TABLE_FORMAT = owner->WARP_TABLE_FORMAT;
+	stitch->packed_plane_width = owner->packed_plane_width;
+	stitch->packed_plane_height = owner->packed_plane_height;
+	memcpy(stitch->cameraPlanes, owner->cameraPlanes, sizeof(stitch->cameraPlanes));
+	if (stitch->MULTIBAND_BLEND) {
+		ERROR_CHECK_ALLOC_(stitch->multibandBlendOffsetIntoBuffer = new vx_size[stitch->num_bands * 2]);
+		memcpy(stitch->multibandBlendOffsetIntoBuffer, owner->multibandBlendOffsetIntoBuffer, stitch->num_bands * 2 * sizeof(vx_size));
+	}
+	return VX_SUCCESS;
+}
+//! \brief Replace internal tables with the ones of the table owner and initialize the remaining per context data.
+//  OpenVX allocates memory of data objects on first use, so the replaced objects never hold table data.
+static vx_status ShareInternalTablesForCamera(ls_context stitch)
+{
+	ls_context owner = stitch->table_owner;
+	struct { vx_reference * ref; vx_reference shared; } tableList[] = {
+		{ (vx_reference *)&stitch->ValidPixelEntry,        (vx_reference)owner->ValidPixelEntry },
+		{ (vx_reference *)&stitch->WarpRemapEntry,         (vx_reference)owner->WarpRemapEntry },
+		{ (vx_reference *)&stitch->warp_merge_index_image, (vx_reference)owner->warp_merge_index_image },
+		{ (vx_reference *)&stitch->camera_plane_array,     (vx_reference)owner->camera_plane_array },
+		{ (vx_reference *)&stitch->cam_id_image,           (vx_reference)owner->cam_id_image },
+		{ (vx_reference *)&stitch->group1_image,           (vx_reference)owner->group1_image },
+		{ (vx_reference *)&stitch->group2_image,           (vx_reference)owner->group2_image },
+		{ (vx_reference *)&stitch->merge_overflow_array,   (vx_reference)owner->merge_overflow_array },
+		{ (vx_reference *)&stitch->weight_image,           (vx_reference)owner->weight_image },
+		{ (vx_reference *)&stitch->valid_mask_image,       (vx_reference)owner->valid_mask_image },
+		{ (vx_reference *)&stitch->valid_array,            (vx_reference)owner->valid_array },
+		{ (vx_reference *)&stitch->OverlapPixelEntry,      (vx_reference)owner->OverlapPixelEntry },
+		{ (vx_reference *)&stitch->overlap_matrix,         (vx_reference)owner->overlap_matrix },
+		{ (vx_reference *)&stitch->seamfind_valid_array,   (vx_reference)owner->seamfind_valid_array },
+		{ (vx_reference *)&stitch->seamfind_weight_array,  (vx_reference)owner->seamfind_weight_array },
+		{ (vx_reference *)&stitch->seamfind_info_array,    (vx_reference)owner->seamfind_info_array },
+		{ (vx_reference *)&stitch->blend_offsets,          (vx_reference)owner->blend_offsets },
+		{ (vx_reference *)&stitch->blend_mask_image,       (vx_reference)owner->blend_mask_image },
+	};
+	for (vx_size i = 0; i < dimof(tableList); i++) {
+		if (*tableList[i].ref) {
+			if (!tableList[i].shared) {
+				ls_printf("ERROR: ShareInternalTablesForCamera: table owner doesn't have table#%d\n", (int)i);
+				return VX_ERROR_INVALID_PARAMETERS;
 			}
-			ERROR_CHECK_STATUS_(vxUnmapImagePatch(stitch->RGBY2, map_id));
+			ERROR_CHECK_STATUS_(vxReleaseReference(tableList[i].ref));
+			ERROR_CHECK_STATUS_(vxRetainReference(tableList[i].shared));
+			*tableList[i].ref = tableList[i].shared;
 		}
 	}
-	return VX_SUCCESS;
+
+	if (stitch->SEAM_FIND)
+	{ // seamfind tables updated by seamfind kernels start from the state after initialize of the table owner
+		vx_size prefCount = stitch->table_sizes.seamFindPrefInfoTableSize;
+		StitchSeamFindAccumEntry accumEntry = { -1, -1, -1, -1 };
+		StitchSeamFindPathEntry pathEntry = { 0 };
+		ERROR_CHECK_STATUS_(vxTruncateArray(stitch->seamfind_accum_array, 0));
+		ERROR_CHECK_STATUS_(vxTruncateArray(stitch->seamfind_pref_array, 0));
+		ERROR_CHECK_STATUS_(vxTruncateArray(stitch->seamfind_path_array, 0));
+		ERROR_CHECK_STATUS_(vxAddArrayItems(stitch->seamfind_accum_array, stitch->table_sizes.seamFindAccumTableSize, &accumEntry, 0));
+		ERROR_CHECK_STATUS_(vxAddArrayItems(stitch->seamfind_pref_array, prefCount, owner->seamfindPrefInitial, sizeof(StitchSeamFindPreference)));
+		ERROR_CHECK_STATUS_(vxAddArrayItems(stitch->seamfind_path_array, stitch->table_sizes.seamFindPathTableSize, &pathEntry, 0));
+		if (stitch->seamfind_scene_array) {
+			StitchSeamFindSceneEntry sceneEntry = { 0 };
+			ERROR_CHECK_STATUS_(vxTruncateArray(stitch->seamfind_scene_array, 0));
+			ERROR_CHECK_STATUS_(vxAddArrayItems(stitch->seamfind_scene_array, prefCount, &sceneEntry, 0));
+		}
+		stitch->current_frame_value = 0;
+		ERROR_CHECK_STATUS_(vxWriteScalarValue(stitch->current_frame, &stitch->current_frame_value));
+
+		// initial seamfind mask image is same as the merge weight image
+		vx_rectangle_t rectMask = { 0, 0, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras };
+		if (stitch->camera_plane_array) {
+			rectMask.end_x = stitch->packed_plane_width;
+			rectMask.end_y = stitch->packed_plane_height;
+		}
+		vx_imagepatch_addressing_t addrSrc, addrDst;
+		vx_map_id map_id_src, map_id_dst;
+		vx_uint8 * ptr_src, * ptr_dst;
+		ERROR_CHECK_STATUS_(vxMapImagePatch(stitch->weight_image, &rectMask, 0, &map_id_src, &addrSrc, (void **)&ptr_src, VX_READ_ONLY, VX_MEMORY_TYPE_HOST, VX_NOGAP_X));
+		ERROR_CHECK_STATUS_(vxMapImagePatch(stitch->seamfind_weight_image, &rectMask, 0, &map_id_dst, &addrDst, (void **)&ptr_dst, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, VX_NOGAP_X));
+		for (vx_uint32 y = 0; y < rectMask.end_y; y++) {
+			memcpy(ptr_dst + y * addrDst.stride_y, ptr_src + y * addrSrc.stride_y, rectMask.end_x);
+		}
+		ERROR_CHECK_STATUS_(vxUnmapImagePatch(stitch->seamfind_weight_image, map_id_dst));
+		ERROR_CHECK_STATUS_(vxUnmapImagePatch(stitch->weight_image, map_id_src));
+	}
+	return InitializeWarpOutputImages(stitch);
 }
 static vx_status AllocateInternalTablesForCamera(ls_context stitch)
 {
-	// make sure to allocate internal buffers for initialize atleast once
-	if (!stitch->camSrcMap) {
+	// make sure to allocate internal buffers for initialize atleast once (not needed with shared tables)
+	if (!stitch->camSrcMap && !stitch->table_owner) {
 		vx_status status = AllocateLensModelBuffersForCamera(stitch);
 		if (status)
 			return status;
 	}
 
-	if (!stitch->feature_enable_reinitialize)
+	if (stitch->table_owner)
+	{
+		// tables will be shared with table owner: use its table sizes and features
+		ERROR_CHECK_STATUS_(ShareInternalTableSizes(stitch));
+	}
+	else if (!stitch->feature_enable_reinitialize)
 	{
 		if (!stitch->SETUP_LOAD_FILES_FOUND)
 		{
@@ -1444,7 +1914,7 @@ static vx_status AllocateInternalTablesForCamera(ls_context stitch)
 			vx_status status = CalculateLensDistortionAndWarpMaps(!stitch->USE_CPU_INIT ? stitch->stitchInitData : nullptr, stitch->num_cameras,
 				stitch->camera_rgb_buffer_width / stitch->num_camera_columns,
 				stitch->camera_rgb_buffer_height / stitch->num_camera_rows,
-				stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height,
+				stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height, stitch->OUTPUT_PROJECTION,
 				&stitch->rig_par, stitch->camera_par,
 				stitch->validPixelCamMap, stitch->paddingPixelCount, stitch->paddedPixelCamMap,
 				stitch->camSrcMap, stitch->camIndexTmpBuf, stitch->camIndexBuf);
@@ -1456,13 +1926,11 @@ static vx_status AllocateInternalTablesForCamera(ls_context stitch)
 				stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height,
 				stitch->validPixelCamMap, stitch->overlapValid, stitch->validCamOverlapInfo,
 				stitch->paddedPixelCamMap, stitch->overlapPadded, stitch->paddedCamOverlapInfo);
-			if (stitch->overlapCount > 6) {
-				vxAddLogEntry((vx_reference)stitch->context, status, "ERROR: AllocateInternalTablesForCamera: number of overlaps (%d) greater than 6 not supported\n", stitch->overlapCount);
-				return VX_ERROR_NOT_SUPPORTED;
-			}
 			// calculate minimum buffer sizes needed
 			CalculateSmallestWarpBufferSizes(stitch->num_cameras, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height,
 				stitch->validPixelCamMap, stitch->paddedPixelCamMap, &stitch->table_sizes.warpTableSize);
+			CalculateMergeOverflowBufferSize(stitch->num_cameras, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height,
+				stitch->validPixelCamMap, stitch->paddedPixelCamMap, &stitch->table_sizes.mergeOverflowTableSize);
 			if (stitch->EXPO_COMP) {
 				CalculateSmallestExpCompBufferSizes(stitch->num_cameras, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height,
 					stitch->validPixelCamMap, stitch->overlapValid, stitch->validCamOverlapInfo,
@@ -1481,7 +1949,7 @@ static vx_status AllocateInternalTablesForCamera(ls_context stitch)
 					&stitch->table_sizes.seamFindPrefInfoTableSize, &stitch->table_sizes.seamFindPathTableSize);
 			}
 			if (stitch->MULTIBAND_BLEND) {
-				ERROR_CHECK_ALLOC_(stitch->multibandBlendOffsetIntoBuffer = new vx_size[stitch->num_bands]());
+				ERROR_CHECK_ALLOC_(stitch->multibandBlendOffsetIntoBuffer = new vx_size[stitch->num_bands * 2]());
 				CalculateSmallestBlendBufferSizes(stitch->num_cameras, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height, stitch->num_bands,
 					stitch->validPixelCamMap, stitch->paddedPixelCamMap, stitch->overlapPadded, stitch->paddedCamOverlapInfo,
 					stitch->multibandBlendOffsetIntoBuffer, &stitch->table_sizes.blendOffsetTableSize);
@@ -1509,6 +1977,8 @@ static vx_status AllocateInternalTablesForCamera(ls_context stitch)
 		// when re-initialize support is required, allocate largest buffers to accomodate changes during reinitialize
 		CalculateLargestWarpBufferSizes(stitch->num_cameras, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height,
 			&stitch->table_sizes.warpTableSize);
+		stitch->table_sizes.mergeOverflowTableSize = (stitch->num_cameras > STITCH_MERGE_MAX_GROUP_CAMERAS) ?
+			(vx_size)(stitch->output_rgb_buffer_width / 8) * stitch->output_rgb_buffer_height : 0;
 		if (stitch->EXPO_COMP) {
 			CalculateLargestExpCompBufferSizes(stitch->num_cameras, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height,
 				&stitch->table_sizes.expCompValidTableSize, &stitch->table_sizes.expCompOverlapTableSize);
@@ -1519,7 +1989,7 @@ static vx_status AllocateInternalTablesForCamera(ls_context stitch)
 				&stitch->table_sizes.seamFindPrefInfoTableSize, &stitch->table_sizes.seamFindPathTableSize);
 		}
 		if (stitch->MULTIBAND_BLEND) {
-			ERROR_CHECK_ALLOC_(stitch->multibandBlendOffsetIntoBuffer = new vx_size[stitch->num_bands]());
+			ERROR_CHECK_ALLOC_(stitch->multibandBlendOffsetIntoBuffer = new vx_size[stitch->num_bands * 2]());
 			CalculateLargestBlendBufferSizes(stitch->num_cameras, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height, stitch->num_bands,
 				stitch->multibandBlendOffsetIntoBuffer, &stitch->table_sizes.blendOffsetTableSize);
 		}
@@ -1552,30 +2022,90 @@ static vx_status AllocateInternalTablesForCamera(ls_context stitch)
 		return VX_ERROR_INVALID_PARAMETERS;
 	}
 
+	// pick wide table entries when output or camera dimensions don't fit into compact entries:
+	// warp remap x includes the camera column offset, so the limits apply to the whole camera buffer
+	vx_uint32 camBufferWidth = stitch->camera_rgb_buffer_width;
+	vx_uint32 camBufferHeight = stitch->camera_rgb_buffer_height;
+	if (camBufferWidth > STITCH_WARP_WIDE_MAX_SRC_SIZE || camBufferHeight > STITCH_WARP_WIDE_MAX_SRC_SIZE) {
+		ls_printf("ERROR: AllocateInternalTablesForCamera: camera buffer dimensions %dx%d not supported (max %d)\n", camBufferWidth, camBufferHeight, STITCH_WARP_WIDE_MAX_SRC_SIZE);
+		return VX_ERROR_NOT_SUPPORTED;
+	}
+	stitch->useWideTables =
+		stitch->output_rgb_buffer_width > STITCH_WARP_COMPACT_MAX_DST_WIDTH || stitch->output_rgb_buffer_height > STITCH_WARP_COMPACT_MAX_DST_HEIGHT ||
+		camBufferWidth > STITCH_WARP_COMPACT_MAX_SRC_SIZE || camBufferHeight > STITCH_WARP_COMPACT_MAX_SRC_SIZE ||
+		stitch->num_cameras > STITCH_WARP_COMPACT_MAX_CAMERAS;
+	// packed camera planes from camera bounding boxes
+	vx_uint32 warpOutputWidth = stitch->output_rgb_buffer_width, warpOutputHeight = stitch->output_rgb_buffer_height * stitch->num_cameras;
+	if (stitch->PACKED_INTERMEDIATES) {
+		if (!stitch->table_owner) {
+			if (stitch->MULTIBAND_BLEND || stitch->EXPO_COMP || stitch->SEAM_FIND) {
+				// exposure comp, seamfind and multiband blend need camera planes of same height with rows
+				// aligned to the coarsest pyramid level and margin rows for filters across camera planes
+				vx_uint32 rowAlign = stitch->MULTIBAND_BLEND ? (1u << (stitch->num_bands - 1)) : 1u;
+				ERROR_CHECK_STATUS_(CalculateRowPackedCameraPlanes(stitch->num_cameras, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height,
+					stitch->paddedPixelCamMap ? stitch->overlapPadded : stitch->overlapValid, rowAlign, std::max(16u, 6 * rowAlign),
+					stitch->cameraPlanes, &stitch->packed_plane_width, &stitch->packed_plane_height));
+			}
+			else {
+				ERROR_CHECK_STATUS_(CalculatePackedCameraPlanes(stitch->num_cameras, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height,
+					stitch->paddedPixelCamMap ? stitch->overlapPadded : stitch->overlapValid, stitch->cameraPlanes, &stitch->packed_plane_width, &stitch->packed_plane_height));
+			}
+		}
+		warpOutputWidth = stitch->packed_plane_width;
+		warpOutputHeight = stitch->packed_plane_height;
+		if (warpOutputHeight > STITCH_WARP_COMPACT_MAX_DST_HEIGHT)
+			stitch->useWideTables = true;
+		ls_printf("OK: AllocateInternalTablesForCamera: packed camera planes %dx%d instead of %dx%d\n", warpOutputWidth, warpOutputHeight,
+			stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras);
+	}
+	if (stitch->useWideTables && stitch->WARP_TABLE_FORMAT == STITCH_WARP_TABLE_FORMAT_COMPACT) {
+		ls_printf("WARNING: AllocateInternalTablesForCamera: compact warp table not supported with wide table entries: using full warp table\n");
+		stitch->WARP_TABLE_FORMAT = STITCH_WARP_TABLE_FORMAT_FULL;
+	}
+
 	// create data objects needed by warp kernel
 	vx_enum StitchValidPixelEntryType, StitchWarpRemapEntryType;
-	ERROR_CHECK_TYPE_(StitchValidPixelEntryType = vxRegisterUserStruct(stitch->context, sizeof(StitchValidPixelEntry)));
-	ERROR_CHECK_TYPE_(StitchWarpRemapEntryType = vxRegisterUserStruct(stitch->context, sizeof(StitchWarpRemapEntry)));
+	ERROR_CHECK_TYPE_(StitchValidPixelEntryType = vxRegisterUserStruct(stitch->context, stitch->useWideTables ? sizeof(StitchValidPixelWideEntry) : sizeof(StitchValidPixelEntry)));
+	ERROR_CHECK_TYPE_(StitchWarpRemapEntryType = vxRegisterUserStruct(stitch->context, (stitch->WARP_TABLE_FORMAT == STITCH_WARP_TABLE_FORMAT_COMPACT) ? sizeof(StitchWarpRemapCompactEntry) : sizeof(StitchWarpRemapEntry)));
 	ERROR_CHECK_OBJECT_(stitch->ValidPixelEntry = vxCreateArray(stitch->context, StitchValidPixelEntryType, stitch->table_sizes.warpTableSize));
-	ERROR_CHECK_OBJECT_(stitch->WarpRemapEntry = vxCreateArray(stitch->context, StitchWarpRemapEntryType, stitch->table_sizes.warpTableSize));
-	ERROR_CHECK_OBJECT_(stitch->RGBY1 = vxCreateImage(stitch->context, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras, VX_DF_IMAGE_RGBX));
+	ERROR_CHECK_OBJECT_(stitch->WarpRemapEntry = vxCreateArray(stitch->context, StitchWarpRemapEntryType, GetWarpRemapTableCapacity(stitch)));
+	if (!stitch->FUSED_WARP_MERGE || stitch->EXPO_COMP || stitch->SEAM_FIND) {
+		// fused warp merge needs warp output only for exposure comp error function and seamfind: with either of them
+		// the warp pass and RGBY1 are kept and the fused pass only saves RGBY2 and the separate gain and merge passes
+		ERROR_CHECK_OBJECT_(stitch->RGBY1 = vxCreateImage(stitch->context, warpOutputWidth, warpOutputHeight, VX_DF_IMAGE_RGBX));
+	}
+	if (stitch->FUSED_WARP_MERGE) {
+		ERROR_CHECK_OBJECT_(stitch->warp_merge_index_image = vxCreateImage(stitch->context, (stitch->output_rgb_buffer_width / 8), stitch->output_rgb_buffer_height, VX_DF_IMAGE_U32));
+	}
 	// create data objects needed by merge kernel
-	ERROR_CHECK_OBJECT_(stitch->weight_image = vxCreateImage(stitch->context, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras, VX_DF_IMAGE_U8));
+	ERROR_CHECK_OBJECT_(stitch->weight_image = vxCreateImage(stitch->context, warpOutputWidth, warpOutputHeight, VX_DF_IMAGE_U8));
+	if (stitch->PACKED_INTERMEDIATES) {
+		vx_enum StitchCameraPlaneEntryType;
+		ERROR_CHECK_TYPE_(StitchCameraPlaneEntryType = vxRegisterUserStruct(stitch->context, sizeof(StitchCameraPlaneEntry)));
+		ERROR_CHECK_OBJECT_(stitch->camera_plane_array = vxCreateArray(stitch->context, StitchCameraPlaneEntryType, stitch->num_cameras));
+		ERROR_CHECK_STATUS_(vxAddArrayItems(stitch->camera_plane_array, stitch->num_cameras, stitch->cameraPlanes, sizeof(StitchCameraPlaneEntry)));
+	}
 	ERROR_CHECK_OBJECT_(stitch->cam_id_image = vxCreateImage(stitch->context, (stitch->output_rgb_buffer_width / 8), stitch->output_rgb_buffer_height, VX_DF_IMAGE_U8));
 	ERROR_CHECK_OBJECT_(stitch->group1_image = vxCreateImage(stitch->context, (stitch->output_rgb_buffer_width / 8), stitch->output_rgb_buffer_height, VX_DF_IMAGE_U16));
 	ERROR_CHECK_OBJECT_(stitch->group2_image = vxCreateImage(stitch->context, (stitch->output_rgb_buffer_width / 8), stitch->output_rgb_buffer_height, VX_DF_IMAGE_U16));
+	if (stitch->table_sizes.mergeOverflowTableSize > 0) {
+		ERROR_CHECK_OBJECT_(stitch->merge_overflow_array = vxCreateArray(stitch->context,
+			(stitch->num_cameras > STITCH_MERGE_MAX_CAMID_CAMERAS) ? VX_TYPE_UINT64 : VX_TYPE_UINT32, stitch->table_sizes.mergeOverflowTableSize));
+	}
 	// create data objects needed by exposure comp kernel
 	if (stitch->EXPO_COMP) {
 		vx_enum StitchOverlapPixelEntryType, StitchExpCompCalcEntryType;
 		vx_float32 one = 1.0f; // initialize gain_array with default gains as one
-		ERROR_CHECK_TYPE_(StitchOverlapPixelEntryType = vxRegisterUserStruct(stitch->context, sizeof(StitchOverlapPixelEntry)));
-		ERROR_CHECK_TYPE_(StitchExpCompCalcEntryType = vxRegisterUserStruct(stitch->context, sizeof(StitchExpCompCalcEntry)));
+		ERROR_CHECK_TYPE_(StitchOverlapPixelEntryType = vxRegisterUserStruct(stitch->context, stitch->useWideTables ? sizeof(StitchOverlapPixelWideEntry) : sizeof(StitchOverlapPixelEntry)));
+		ERROR_CHECK_TYPE_(StitchExpCompCalcEntryType = vxRegisterUserStruct(stitch->context, stitch->useWideTables ? sizeof(StitchExpCompCalcWideEntry) : sizeof(StitchExpCompCalcEntry)));
 		ERROR_CHECK_OBJECT_(stitch->valid_array = vxCreateArray(stitch->context, StitchExpCompCalcEntryType, stitch->table_sizes.expCompValidTableSize));
 		if (stitch->EXPO_COMP < 3) {
 			ERROR_CHECK_OBJECT_(stitch->OverlapPixelEntry = vxCreateArray(stitch->context, StitchOverlapPixelEntryType, stitch->table_sizes.expCompOverlapTableSize));
 		}
 		ERROR_CHECK_OBJECT_(stitch->overlap_matrix = vxCreateMatrix(stitch->context, VX_TYPE_INT32, stitch->num_cameras, stitch->num_cameras));
-		ERROR_CHECK_OBJECT_(stitch->RGBY2 = vxCreateImage(stitch->context, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras, VX_DF_IMAGE_RGBX));
+		if (!stitch->FUSED_WARP_MERGE) {
+			ERROR_CHECK_OBJECT_(stitch->RGBY2 = vxCreateImage(stitch->context, warpOutputWidth, warpOutputHeight, VX_DF_IMAGE_RGBX));
+		}
 		if (stitch->EXPO_COMP == 1) {
 			ERROR_CHECK_OBJECT_(stitch->A_matrix = vxCreateMatrix(stitch->context, VX_TYPE_INT32, stitch->num_cameras, stitch->num_cameras));
 			ERROR_CHECK_ALLOC_(stitch->A_matrix_initial_value = new vx_int32[stitch->num_cameras * stitch->num_cameras]());
@@ -1607,15 +2137,15 @@ static vx_status AllocateInternalTablesForCamera(ls_context stitch)
 		ERROR_CHECK_OBJECT_(stitch->seamfind_pref_array = vxCreateArray(stitch->context, StitchSeamFindPreferenceType, stitch->table_sizes.seamFindPrefInfoTableSize));
 		ERROR_CHECK_OBJECT_(stitch->seamfind_info_array = vxCreateArray(stitch->context, StitchSeamFindInformationType, stitch->table_sizes.seamFindPrefInfoTableSize));
 		ERROR_CHECK_OBJECT_(stitch->seamfind_path_array = vxCreateArray(stitch->context, StitchSeamFindPathEntryType, stitch->table_sizes.seamFindPathTableSize));
-		ERROR_CHECK_OBJECT_(stitch->warp_luma_image = vxCreateVirtualImage(stitch->graphStitch, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras, VX_DF_IMAGE_U8));
+		ERROR_CHECK_OBJECT_(stitch->warp_luma_image = vxCreateVirtualImage(stitch->graphStitch, warpOutputWidth, warpOutputHeight, VX_DF_IMAGE_U8));
 		if (!stitch->SEAM_COST_SELECT) {
-			ERROR_CHECK_OBJECT_(stitch->sobelx_image = vxCreateVirtualImage(stitch->graphStitch, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras, VX_DF_IMAGE_S16));
-			ERROR_CHECK_OBJECT_(stitch->sobely_image = vxCreateVirtualImage(stitch->graphStitch, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras, VX_DF_IMAGE_S16));
-			ERROR_CHECK_OBJECT_(stitch->sobel_magnitude_s16_image = vxCreateVirtualImage(stitch->graphStitch, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras, VX_DF_IMAGE_S16));
+			ERROR_CHECK_OBJECT_(stitch->sobelx_image = vxCreateVirtualImage(stitch->graphStitch, warpOutputWidth, warpOutputHeight, VX_DF_IMAGE_S16));
+			ERROR_CHECK_OBJECT_(stitch->sobely_image = vxCreateVirtualImage(stitch->graphStitch, warpOutputWidth, warpOutputHeight, VX_DF_IMAGE_S16));
+			ERROR_CHECK_OBJECT_(stitch->sobel_magnitude_s16_image = vxCreateVirtualImage(stitch->graphStitch, warpOutputWidth, warpOutputHeight, VX_DF_IMAGE_S16));
 		}
-		ERROR_CHECK_OBJECT_(stitch->sobel_magnitude_image = vxCreateVirtualImage(stitch->graphStitch, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras, VX_DF_IMAGE_U8));
-		ERROR_CHECK_OBJECT_(stitch->sobel_phase_image = vxCreateVirtualImage(stitch->graphStitch, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras, VX_DF_IMAGE_U8));
-		ERROR_CHECK_OBJECT_(stitch->seamfind_weight_image = vxCreateImage(stitch->context, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras, VX_DF_IMAGE_U8));
+		ERROR_CHECK_OBJECT_(stitch->sobel_magnitude_image = vxCreateVirtualImage(stitch->graphStitch, warpOutputWidth, warpOutputHeight, VX_DF_IMAGE_U8));
+		ERROR_CHECK_OBJECT_(stitch->sobel_phase_image = vxCreateVirtualImage(stitch->graphStitch, warpOutputWidth, warpOutputHeight, VX_DF_IMAGE_U8));
+		ERROR_CHECK_OBJECT_(stitch->seamfind_weight_image = vxCreateImage(stitch->context, warpOutputWidth, warpOutputHeight, VX_DF_IMAGE_U8));
 		ERROR_CHECK_OBJECT_(stitch->current_frame = vxCreateScalar(stitch->context, VX_TYPE_UINT32, &stitch->current_frame_value));
 		if (stitch->SEAM_REFRESH) {
 			vx_enum StitchSeamSceneType;
@@ -1623,41 +2153,53 @@ static vx_status AllocateInternalTablesForCamera(ls_context stitch)
 			ERROR_CHECK_OBJECT_(stitch->seamfind_scene_array = vxCreateArray(stitch->context, StitchSeamSceneType, stitch->table_sizes.seamFindPrefInfoTableSize));
 			ERROR_CHECK_OBJECT_(stitch->scene_threshold = vxCreateScalar(stitch->context, VX_TYPE_UINT32, &stitch->scene_threshold_value));
 		}
-		if (stitch->SEAM_COST_SELECT) {
+		if (stitch->SEAM_COST_SELECT || stitch->SEAM_SCHEDULE) {
 			vx_uint32 cost_enable = 1;
 			ERROR_CHECK_OBJECT_(stitch->seam_cost_enable = vxCreateScalar(stitch->context, VX_TYPE_UINT32, &cost_enable));
 		}
+		if (stitch->SEAM_SCHEDULE) {
+			ERROR_CHECK_OBJECT_(stitch->seam_budget = vxCreateScalar(stitch->context, VX_TYPE_UINT32, &stitch->seam_budget_value));
+		}
 	}
 	// create data objects needed by multiband blend
 	if (stitch->MULTIBAND_BLEND) {
 		vx_enum StitchBlendValidType;
-		ERROR_CHECK_TYPE_(StitchBlendValidType = vxRegisterUserStruct(stitch->context, sizeof(StitchBlendValidEntry)));
+		ERROR_CHECK_TYPE_(StitchBlendValidType = vxRegisterUserStruct(stitch->context, stitch->useWideTables ? sizeof(StitchBlendValidWideEntry) : sizeof(StitchBlendValidEntry)));
 		ERROR_CHECK_OBJECT_(stitch->blend_offsets = vxCreateArray(stitch->context, StitchBlendValidType, stitch->table_sizes.blendOffsetTableSize));
 		ERROR_CHECK_ALLOC_(stitch->pStitchMultiband = new StitchMultibandData[stitch->num_bands]());
 		memset(stitch->pStitchMultiband, 0, sizeof(StitchMultibandData)*stitch->num_bands);
 		stitch->pStitchMultiband[0].WeightPyrImgGaussian = stitch->SEAM_FIND ? stitch->seamfind_weight_image : stitch->weight_image;	// for level#0: weight image is mask image after seem find
 		stitch->pStitchMultiband[0].DstPyrImgGaussian = stitch->EXPO_COMP ? stitch->RGBY2 : stitch->RGBY1;			// for level#0: dst image is image after exposure_comp
-		ERROR_CHECK_OBJECT_(stitch->pStitchMultiband[0].DstPyrImgLaplacian = CreateAlignedImage(stitch, stitch->output_rgb_buffer_width, (stitch->output_rgb_buffer_height * stitch->num_cameras), 8, VX_DF_IMAGE_RGB4_AMD, VX_MEMORY_TYPE_OPENCL));
-		ERROR_CHECK_OBJECT_(stitch->pStitchMultiband[0].DstPyrImgLaplacianRec = CreateAlignedImage(stitch, stitch->output_rgb_buffer_width, (stitch->output_rgb_buffer_height * stitch->num_cameras), 8, VX_DF_IMAGE_RGBX, VX_MEMORY_TYPE_OPENCL));
+		ERROR_CHECK_OBJECT_(stitch->pStitchMultiband[0].DstPyrImgLaplacian = CreateAlignedImage(stitch, warpOutputWidth, warpOutputHeight, 8, VX_DF_IMAGE_RGB4_AMD, stitch->HOST_EXECUTION ? VX_MEMORY_TYPE_HOST : VX_MEMORY_TYPE_OPENCL));
+		ERROR_CHECK_OBJECT_(stitch->pStitchMultiband[0].DstPyrImgLaplacianRec = CreateAlignedImage(stitch, warpOutputWidth, warpOutputHeight, 8, VX_DF_IMAGE_RGBX, stitch->HOST_EXECUTION ? VX_MEMORY_TYPE_HOST : VX_MEMORY_TYPE_OPENCL));
 		for (vx_int32 level = 1, levelAlign = 1; level < stitch->num_bands; level++, levelAlign = ((levelAlign << 1) | 1)) {
-			vx_uint32 width_l = (stitch->output_rgb_buffer_width + levelAlign) >> level;
-			vx_uint32 height_l = ((stitch->output_rgb_buffer_height + levelAlign) >> level) * stitch->num_cameras;
-			ERROR_CHECK_OBJECT_(stitch->pStitchMultiband[level].WeightPyrImgGaussian = CreateAlignedImage(stitch, width_l, height_l, 16, VX_DF_IMAGE_U8, VX_MEMORY_TYPE_OPENCL));
-			ERROR_CHECK_OBJECT_(stitch->pStitchMultiband[level].DstPyrImgGaussian = CreateAlignedImage(stitch, width_l, height_l, 8, VX_DF_IMAGE_RGBX, VX_MEMORY_TYPE_OPENCL));
-			ERROR_CHECK_OBJECT_(stitch->pStitchMultiband[level].DstPyrImgLaplacian = CreateAlignedImage(stitch, width_l, height_l, 8, VX_DF_IMAGE_RGB4_AMD, VX_MEMORY_TYPE_OPENCL));
-			ERROR_CHECK_OBJECT_(stitch->pStitchMultiband[level].DstPyrImgLaplacianRec = CreateAlignedImage(stitch, width_l, height_l, 8, VX_DF_IMAGE_RGB4_AMD, VX_MEMORY_TYPE_OPENCL));
+			vx_uint32 width_l = (warpOutputWidth + levelAlign) >> level;
+			vx_uint32 height_l = (((warpOutputHeight / stitch->num_cameras) + levelAlign) >> level) * stitch->num_cameras;
+			ERROR_CHECK_OBJECT_(stitch->pStitchMultiband[level].WeightPyrImgGaussian = CreateAlignedImage(stitch, width_l, height_l, 16, VX_DF_IMAGE_U8, stitch->HOST_EXECUTION ? VX_MEMORY_TYPE_HOST : VX_MEMORY_TYPE_OPENCL));
+			ERROR_CHECK_OBJECT_(stitch->pStitchMultiband[level].DstPyrImgGaussian = CreateAlignedImage(stitch, width_l, height_l, 8, VX_DF_IMAGE_RGBX, stitch->HOST_EXECUTION ? VX_MEMORY_TYPE_HOST : VX_MEMORY_TYPE_OPENCL));
+			ERROR_CHECK_OBJECT_(stitch->pStitchMultiband[level].DstPyrImgLaplacian = CreateAlignedImage(stitch, width_l, height_l, 8, VX_DF_IMAGE_RGB4_AMD, stitch->HOST_EXECUTION ? VX_MEMORY_TYPE_HOST : VX_MEMORY_TYPE_OPENCL));
+			ERROR_CHECK_OBJECT_(stitch->pStitchMultiband[level].DstPyrImgLaplacianRec = CreateAlignedImage(stitch, width_l, height_l, 8, VX_DF_IMAGE_RGB4_AMD, stitch->HOST_EXECUTION ? VX_MEMORY_TYPE_HOST : VX_MEMORY_TYPE_OPENCL));
 		}
 		for (int level = 0; level < stitch->num_bands; level++) {
 			stitch->pStitchMultiband[level].valid_array_offset = (vx_uint32)stitch->multibandBlendOffsetIntoBuffer[level];
+			stitch->pStitchMultiband[level].gaussian_array_offset = (vx_uint32)stitch->multibandBlendOffsetIntoBuffer[stitch->num_bands + level];
 		}
-		ERROR_CHECK_OBJECT_(stitch->blend_mask_image = vxCreateImage(stitch->context, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras, VX_DF_IMAGE_U8));
+		ERROR_CHECK_OBJECT_(stitch->blend_mask_image = vxCreateImage(stitch->context, warpOutputWidth, warpOutputHeight, VX_DF_IMAGE_U8));
 	}
     if (stitch->SEAM_FIND || stitch->EXPO_COMP == 1 || stitch->EXPO_COMP == 2) {
-		ERROR_CHECK_OBJECT_(stitch->valid_mask_image = vxCreateImage(stitch->context, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras, VX_DF_IMAGE_U8));
+		ERROR_CHECK_OBJECT_(stitch->valid_mask_image = vxCreateImage(stitch->context, warpOutputWidth, warpOutputHeight, VX_DF_IMAGE_U8));
 	}
 	vx_status status = VX_FAILURE;
 
-	if (!stitch->SETUP_LOAD_FILES_FOUND){
+	if (stitch->table_owner) {
+		// reference tables of the table owner and initialize the ones that can't be shared
+		status = ShareInternalTablesForCamera(stitch);
+		if (status != VX_SUCCESS) {
+			vxAddLogEntry((vx_reference)stitch->context, status, "ERROR: AllocateInternalTablesForCamera: ShareInternalTablesForCamera() failed (%d)\n", status);
+			return status;
+		}
+	}
+	else if (!stitch->SETUP_LOAD_FILES_FOUND){
 		// initialize internal tables
 		status = InitializeInternalTablesForCamera(stitch);
 		if (status != VX_SUCCESS) {
@@ -1679,20 +2221,65 @@ static vx_status AllocateInternalTablesForCamera(ls_context stitch)
 			return status;
 		}
 	}
+	if (stitch->SEAM_FIND && !stitch->feature_enable_reinitialize) {
+		// keep seamfind preferences after initialize for contexts sharing these tables
+		ERROR_CHECK_ALLOC_(stitch->seamfindPrefInitial = new StitchSeamFindPreference[stitch->table_sizes.seamFindPrefInfoTableSize]);
+		ERROR_CHECK_STATUS_(vxCopyArrayRange(stitch->seamfind_pref_array, 0, stitch->table_sizes.seamFindPrefInfoTableSize, sizeof(StitchSeamFindPreference),
+			stitch->seamfindPrefInitial, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
+	}
 
 	if (!stitch->feature_enable_reinitialize) {
 		// release internal buffers as they are not needed anymore
-		if (stitch->validPixelCamMap) { delete[] stitch->validPixelCamMap; stitch->validPixelCamMap = nullptr; }
-		if (stitch->paddedPixelCamMap) { delete[] stitch->paddedPixelCamMap; stitch->paddedPixelCamMap = nullptr; }
-		if (stitch->camSrcMap) { delete[] stitch->camSrcMap; stitch->camSrcMap = nullptr; }
+		if (stitch->validPixelCamMap) { HostMemoryFree(&stitch->host_memory, stitch->validPixelCamMap); stitch->validPixelCamMap = nullptr; }
+		if (stitch->paddedPixelCamMap) { HostMemoryFree(&stitch->host_memory, stitch->paddedPixelCamMap); stitch->paddedPixelCamMap = nullptr; }
+		if (stitch->camSrcMap) { HostMemoryFree(&stitch->host_memory, stitch->camSrcMap); stitch->camSrcMap = nullptr; }
 		if (stitch->overlapRectBuf) { delete[] stitch->overlapRectBuf; stitch->overlapRectBuf = nullptr; }
-		if (stitch->camIndexTmpBuf) { delete[] stitch->camIndexTmpBuf; stitch->camIndexTmpBuf = nullptr; }
-		if (stitch->camIndexBuf) { delete[] stitch->camIndexBuf; stitch->camIndexBuf = nullptr; }
+		if (stitch->camIndexTmpBuf) { HostMemoryFree(&stitch->host_memory, stitch->camIndexTmpBuf); stitch->camIndexTmpBuf = nullptr; }
+		if (stitch->camIndexBuf) { HostMemoryFree(&stitch->host_memory, stitch->camIndexBuf); stitch->camIndexBuf = nullptr; }
 		if (stitch->overlapMatrixBuf) { delete[] stitch->overlapMatrixBuf; stitch->overlapMatrixBuf = nullptr; }
 	}
 
 	return VX_SUCCESS;
 }
+/*****************************************************************************************************************************************
+functions for output rendition ladder
+*****************************************************************************************************************************************/
+static void GetOutputRenditionConfig(ls_context stitch, vx_uint32 rendition, vx_uint32& width, vx_uint32& height, vx_uint32& stride_in_bytes)
+{
+	width = stitch->output_rgb_buffer_width >> rendition;
+	height = stitch->output_rgb_buffer_height >> rendition;
+	if (rendition == 0) stride_in_bytes = stitch->output_buffer_stride_in_bytes;
+	else if (stitch->output_buffer_format == VX_DF_IMAGE_NV12 || stitch->output_buffer_format == VX_DF_IMAGE_IYUV) stride_in_bytes = width;
+	else stride_in_bytes = width * (stitch->output_buffer_format == VX_DF_IMAGE_RGB ? 3 : 2);
+}
+static vx_status CreateOutputRenditionImages(ls_context stitch, vx_uint32 rendition)
+{
+	vx_uint32 width, height, stride;
+	GetOutputRenditionConfig(stitch, rendition, width, height, stride);
+	// create rendition output image from OpenCL handle
+	vx_imagepatch_addressing_t addr_out[3] = { 0, 0, 0 };
+	void *ptr[3] = { nullptr, nullptr, nullptr };
+	addr_out[0].dim_x = width; addr_out[0].dim_y = height;
+	addr_out[0].stride_x = (stitch->output_buffer_format == VX_DF_IMAGE_RGB) ? 3 : ((stitch->output_buffer_format == VX_DF_IMAGE_NV12 || stitch->output_buffer_format == VX_DF_IMAGE_IYUV) ? 1 : 2);
+	addr_out[0].stride_y = stride;
+	if (stitch->output_buffer_format == VX_DF_IMAGE_NV12){
+		addr_out[1].dim_x = width; addr_out[1].dim_y = height >> 1;
+		addr_out[1].stride_x = 1; addr_out[1].stride_y = stride;
+	}
+	else if (stitch->output_buffer_format == VX_DF_IMAGE_IYUV){
+		addr_out[1].dim_x = width; addr_out[1].dim_y = height;
+		addr_out[1].stride_x = 1; addr_out[1].stride_y = stride;
+		addr_out[2].dim_x = width; addr_out[2].dim_y = height;
+		addr_out[2].stride_x = 1; addr_out[2].stride_y = stride;
+	}
+	ERROR_CHECK_OBJECT_(stitch->rendition_output[rendition] = vxCreateImageFromHandle(stitch->context, stitch->output_buffer_format, &addr_out[0], ptr, VX_MEMORY_TYPE_OPENCL));
+	// RGB outputs are downscaled in place, other formats need an RGB image for the next downscale and color conversion
+	if (stitch->output_buffer_format != VX_DF_IMAGE_RGB) {
+		ERROR_CHECK_OBJECT_(stitch->rendition_rgb[rendition] = vxCreateVirtualImage(stitch->graphStitch, width, height, VX_DF_IMAGE_RGB));
+	}
+	return VX_SUCCESS;
+}
+
 /*****************************************************************************************************************************************
 functions to encode stitched output
 *****************************************************************************************************************************************/
@@ -1793,6 +2380,498 @@ static vx_status EncodeProcessImage(ls_context stitch)
 	return VX_SUCCESS;
 }
 
+//! \brief Estimate the bytes in a data object accessed by a node.
+static vx_uint64 GetReferenceSizeInBytes(vx_reference ref)
+{
+	vx_enum type = VX_TYPE_INVALID;
+	if (vxQueryReference(ref, VX_REFERENCE_TYPE, &type, sizeof(type)) != VX_SUCCESS)
+		return 0;
+	if (type == VX_TYPE_IMAGE) {
+		vx_uint32 width = 0, height = 0; vx_df_image format = VX_DF_IMAGE_VIRT;
+		vxQueryImage((vx_image)ref, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
+		vxQueryImage((vx_image)ref, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+		vxQueryImage((vx_image)ref, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format));
+		vx_uint64 bitsPerPixel = 8;
+		if (format == VX_DF_IMAGE_U1_AMD) bitsPerPixel = 1;
+		else if (format == VX_DF_IMAGE_NV12 || format == VX_DF_IMAGE_IYUV) bitsPerPixel = 12;
+		else if (format == VX_DF_IMAGE_U16 || format == VX_DF_IMAGE_S16 || format == VX_DF_IMAGE_UYVY || format == VX_DF_IMAGE_YUYV) bitsPerPixel = 16;
+		else if (format == VX_DF_IMAGE_RGB) bitsPerPixel = 24;
+		else if (format == VX_DF_IMAGE_RGBX || format == VX_DF_IMAGE_U32 || format == VX_DF_IMAGE_S32) bitsPerPixel = 32;
+		else if (format == VX_DF_IMAGE_RGB4_AMD) bitsPerPixel = 48;
+		return ((vx_uint64)width * height * bitsPerPixel) >> 3;
+	}
+	else if (type == VX_TYPE_ARRAY) {
+		vx_size numItems = 0, itemSize = 0;
+		vxQueryArray((vx_array)ref, VX_ARRAY_NUMITEMS, &numItems, sizeof(numItems));
+		vxQueryArray((vx_array)ref, VX_ARRAY_ITEMSIZE, &itemSize, sizeof(itemSize));
+		return (vx_uint64)numItems * itemSize;
+	}
+	else if (type == VX_TYPE_MATRIX) {
+		vx_size size = 0;
+		vxQueryMatrix((vx_matrix)ref, VX_MATRIX_SIZE, &size, sizeof(size));
+		return (vx_uint64)size;
+	}
+	else if (type == VX_TYPE_REMAP) {
+		vx_uint32 dstWidth = 0, dstHeight = 0;
+		vxQueryRemap((vx_remap)ref, VX_REMAP_DESTINATION_WIDTH, &dstWidth, sizeof(dstWidth));
+		vxQueryRemap((vx_remap)ref, VX_REMAP_DESTINATION_HEIGHT, &dstHeight, sizeof(dstHeight));
+		return (vx_uint64)dstWidth * dstHeight * 2 * sizeof(vx_float32);
+	}
+	return 0;
+}
+
+//! \brief Create the list of graph nodes for per stage performance statistics.
+static vx_status InitializePerformanceData(ls_context stitch)
+{
+	static const char * stageNameList[LIVE_STITCH_PERF_STAGE_COUNT] = {
+		"frame", "input", "warp", "expcomp", "seamfind", "blend", "overlay", "output",
+	};
+	struct { vx_node node; vx_uint32 stage; const char * name; } nodeList[] = {
+		{ stitch->nodeLoomIoCamera, LIVE_STITCH_PERF_STAGE_INPUT, stitch->loomio_camera.kernelName },
+		{ stitch->InputColorConvertNode, LIVE_STITCH_PERF_STAGE_INPUT, "com.amd.loomsl.color_convert" },
+		{ stitch->noiseFilterNode, LIVE_STITCH_PERF_STAGE_BLEND, "com.amd.loomsl.noise_filter" },
+		{ stitch->SimpleStitchRemapNode, LIVE_STITCH_PERF_STAGE_WARP, "org.khronos.openvx.remap" },
+		{ stitch->WarpNode, LIVE_STITCH_PERF_STAGE_WARP, "com.amd.loomsl.warp" },
+		{ stitch->ExpcompComputeGainNode, LIVE_STITCH_PERF_STAGE_EXPCOMP, "com.amd.loomsl.expcomp_compute_gainmatrix" },
+		{ stitch->ExpcompSolveGainNode, LIVE_STITCH_PERF_STAGE_EXPCOMP, "com.amd.loomsl.expcomp_solvegains" },
+		{ stitch->ExpcompApplyGainNode, LIVE_STITCH_PERF_STAGE_EXPCOMP, "com.amd.loomsl.expcomp_applygains" },
+		{ stitch->SobelNode, LIVE_STITCH_PERF_STAGE_SEAMFIND, "org.khronos.openvx.sobel_3x3" },
+		{ stitch->MagnitudeNode, LIVE_STITCH_PERF_STAGE_SEAMFIND, "org.khronos.openvx.magnitude" },
+		{ stitch->PhaseNode, LIVE_STITCH_PERF_STAGE_SEAMFIND, "org.khronos.openvx.phase" },
+		{ stitch->ConvertDepthNode, LIVE_STITCH_PERF_STAGE_SEAMFIND, "org.khronos.openvx.convert_depth" },
+		{ stitch->SeamfindStep1Node, LIVE_STITCH_PERF_STAGE_SEAMFIND, "com.amd.loomsl.seamfind_scene_detect" },
+		{ stitch->SeamfindAnalyzeNode, LIVE_STITCH_PERF_STAGE_SEAMFIND, "com.amd.loomsl.seamfind_analyze" },
+		{ stitch->SeamfindStep2Node, LIVE_STITCH_PERF_STAGE_SEAMFIND, "com.amd.loomsl.seamfind_cost_generate" },
+		{ stitch->SeamfindStep3Node, LIVE_STITCH_PERF_STAGE_SEAMFIND, "com.amd.loomsl.seamfind_cost_accumulate" },
+		{ stitch->SeamfindStep4Node, LIVE_STITCH_PERF_STAGE_SEAMFIND, "com.amd.loomsl.seamfind_path_trace" },
+		{ stitch->SeamfindStep5Node, LIVE_STITCH_PERF_STAGE_SEAMFIND, "com.amd.loomsl.seamfind_set_weights" },
+		{ stitch->MergeNode, LIVE_STITCH_PERF_STAGE_BLEND, "com.amd.loomsl.merge" },
+		{ stitch->WarpMergeNode, LIVE_STITCH_PERF_STAGE_WARP, "com.amd.loomsl.warp_merge" },
+		{ stitch->chromaKey_mask_generation_node, LIVE_STITCH_PERF_STAGE_BLEND, "com.amd.loomsl.chroma_key_mask_generation" },
+		{ stitch->chromaKey_dilate_node, LIVE_STITCH_PERF_STAGE_BLEND, "org.khronos.openvx.dilate_3x3" },
+		{ stitch->chromaKey_erode_node, LIVE_STITCH_PERF_STAGE_BLEND, "org.khronos.openvx.erode_3x3" },
+		{ stitch->chromaKey_merge_node, LIVE_STITCH_PERF_STAGE_BLEND, "com.amd.loomsl.chroma_key_merge" },
+		{ stitch->nodeLoomIoOverlay, LIVE_STITCH_PERF_STAGE_OVERLAY, stitch->loomio_overlay.kernelName },
+		{ stitch->nodeOverlayRemap, LIVE_STITCH_PERF_STAGE_OVERLAY, "org.khronos.openvx.remap" },
+		{ stitch->nodeOverlayBlend, LIVE_STITCH_PERF_STAGE_OVERLAY, stitch->overlay_remap ? "com.amd.loomsl.alpha_blend" : "com.amd.loomsl.overlay_blend" },
+		{ stitch->OutputColorConvertNode, LIVE_STITCH_PERF_STAGE_OUTPUT, "com.amd.loomsl.color_convert" },
+		{ stitch->nodeLoomIoOutput, LIVE_STITCH_PERF_STAGE_OUTPUT, stitch->loomio_output.kernelName },
+		{ stitch->nodeLoomIoViewing, LIVE_STITCH_PERF_STAGE_OUTPUT, stitch->loomio_viewing.kernelName },
+	};
+	ls_perf_data * perf = new ls_perf_data;
+	for (vx_uint32 stage = 0; stage < LIVE_STITCH_PERF_STAGE_COUNT; stage++) {
+		perf->stages[stage].node = nullptr;
+		perf->stages[stage].stage = stage;
+		perf->stages[stage].name = stageNameList[stage];
+		perf->stages[stage].bytes = 0;
+		perf->stages[stage].frames = 0;
+	}
+	std::vector<ls_perf_entry> nodes;
+	for (vx_size i = 0; i < dimof(nodeList); i++) {
+		if (nodeList[i].node) {
+			ls_perf_entry entry = { nodeList[i].node, nodeList[i].stage, nodeList[i].name, 0, 0 };
+			nodes.push_back(entry);
+		}
+	}
+	if (stitch->MULTIBAND_BLEND && stitch->pStitchMultiband) {
+		for (vx_int32 level = 0; level < stitch->num_bands; level++) {
+			StitchMultibandData * band = &stitch->pStitchMultiband[level];
+			struct { vx_node node; const char * name; } bandList[] = {
+				{ band->WeightHSGNode, "com.amd.loomsl.half_scale_gaussian" },
+				{ band->SourceHSGNode, "com.amd.loomsl.half_scale_gaussian" },
+				{ band->UpscaleSubtractNode, "com.amd.loomsl.upscale_gaussian_subtract" },
+				{ band->BlendNode, "com.amd.loomsl.multiband_blend" },
+				{ band->UpscaleAddNode, (level > 0) ? "com.amd.loomsl.upscale_gaussian_add" : "com.amd.loomsl.laplacian_reconstruct" },
+				{ band->LaplacianReconNode, "com.amd.loomsl.laplacian_reconstruct" },
+			};
+			for (vx_size i = 0; i < dimof(bandList); i++) {
+				if (bandList[i].node) {
+					ls_perf_entry entry = { bandList[i].node, LIVE_STITCH_PERF_STAGE_BLEND, bandList[i].name, 0, 0 };
+					nodes.push_back(entry);
+				}
+			}
+		}
+	}
+	for (vx_uint32 i = 0; i < stitch->num_encode_sections && i < MAX_TILE_IMG; i++) {
+		if (stitch->encode_color_convert_nodes[i]) {
+			ls_perf_entry entry = { stitch->encode_color_convert_nodes[i], LIVE_STITCH_PERF_STAGE_OUTPUT, "org.khronos.openvx.color_convert", 0, 0 };
+			nodes.push_back(entry);
+		}
+	}
+	for (vx_uint32 i = 1; i < stitch->num_output_renditions; i++) {
+		ls_perf_entry scaleEntry = { stitch->rendition_scale_nodes[i], LIVE_STITCH_PERF_STAGE_OUTPUT, "com.amd.loomsl.half_scale_rgb", 0, 0 };
+		nodes.push_back(scaleEntry);
+		if (stitch->rendition_convert_nodes[i]) {
+			bool isOpenVX = (stitch->output_buffer_format == VX_DF_IMAGE_NV12 || stitch->output_buffer_format == VX_DF_IMAGE_IYUV);
+			ls_perf_entry convertEntry = { stitch->rendition_convert_nodes[i], LIVE_STITCH_PERF_STAGE_OUTPUT, isOpenVX ? "org.khronos.openvx.color_convert" : "com.amd.loomsl.color_convert", 0, 0 };
+			nodes.push_back(convertEntry);
+		}
+	}
+	// estimate bytes moved per frame from the data objects connected to each node
+	std::map<vx_node, bool> nodeAdded;
+	for (auto it = nodes.begin(); it != nodes.end(); it++) {
+		if (nodeAdded.find(it->node) != nodeAdded.end())
+			continue;
+		nodeAdded[it->node] = true;
+		vx_uint32 paramCount = 0;
+		vx_status status = vxQueryNode(it->node, VX_NODE_PARAMETERS, &paramCount, sizeof(paramCount));
+		if (status != VX_SUCCESS) {
+			delete perf;
+			ls_printf("ERROR: InitializePerformanceData: vxQueryNode(%s) failed (%d)\n", it->name.c_str(), status);
+			return status;
+		}
+		for (vx_uint32 paramIndex = 0; paramIndex < paramCount; paramIndex++) {
+			vx_reference ref = avxGetNodeParamRef(it->node, paramIndex);
+			if (vxGetStatus(ref) == VX_SUCCESS) {
+				it->bytes += GetReferenceSizeInBytes(ref);
+			}
+		}
+		perf->stages[it->stage].bytes += it->bytes;
+		perf->stages[LIVE_STITCH_PERF_STAGE_FRAME].bytes += it->bytes;
+		perf->nodes.push_back(*it);
+	}
+	stitch->perf = perf;
+	return VX_SUCCESS;
+}
+
+//! \brief Add a frame to the rolling window of a performance entry.
+static void AddPerformanceSample(ls_perf_entry& entry, vx_float32 msec)
+{
+	if (entry.samples.size() < LS_PERF_WINDOW_SIZE) entry.samples.push_back(msec);
+	else entry.samples[entry.frames % LS_PERF_WINDOW_SIZE] = msec;
+	entry.frames++;
+}
+
+//! \brief Collect the processing time of the last frame from the graph nodes.
+static vx_status UpdatePerformanceData(ls_context stitch)
+{
+	ls_perf_data * perf = stitch->perf;
+	vx_float32 stageTime[LIVE_STITCH_PERF_STAGE_COUNT] = { 0.0f };
+	for (auto it = perf->nodes.begin(); it != perf->nodes.end(); it++) {
+		// the gain solve node is in graphExpCompSolve: sampled only on frames that ran the solve
+		if (it->node == stitch->ExpcompSolveGainNode && stitch->graphExpCompSolve && !stitch->expCompSolved)
+			continue;
+		vx_perf_t nodePerf = { 0 };
+		ERROR_CHECK_STATUS_(vxQueryNode(it->node, VX_NODE_PERFORMANCE, &nodePerf, sizeof(nodePerf)));
+		vx_float32 msec = (vx_float32)(nodePerf.tmp * 1e-6);
+		AddPerformanceSample(*it, msec);
+		stageTime[it->stage] += msec;
+	}
+	vx_perf_t graphPerf = { 0 };
+	ERROR_CHECK_STATUS_(vxQueryGraph(stitch->graphStitch, VX_GRAPH_PERFORMANCE, &graphPerf, sizeof(graphPerf)));
+	stageTime[LIVE_STITCH_PERF_STAGE_FRAME] = (vx_float32)(graphPerf.tmp * 1e-6);
+	if (stitch->graphExpCompSolve && stitch->expCompSolved) {
+		// the gain solve runs before the stitch graph as part of the frame
+		ERROR_CHECK_STATUS_(vxQueryGraph(stitch->graphExpCompSolve, VX_GRAPH_PERFORMANCE, &graphPerf, sizeof(graphPerf)));
+		stageTime[LIVE_STITCH_PERF_STAGE_FRAME] += (vx_float32)(graphPerf.tmp * 1e-6);
+	}
+	for (vx_uint32 stage = 0; stage < LIVE_STITCH_PERF_STAGE_COUNT; stage++) {
+		AddPerformanceSample(perf->stages[stage], stageTime[stage]);
+	}
+	return VX_SUCCESS;
+}
+
+//! \brief Compute statistics over the rolling window of a performance entry.
+static void GetPerformanceInfo(const ls_perf_entry& entry, ls_perf_info * info)
+{
+	memset(info, 0, sizeof(ls_perf_info));
+	strncpy(info->name, entry.name.c_str(), sizeof(info->name) - 1);
+	info->stage = entry.stage;
+	info->frames = entry.frames;
+	info->bytes = entry.bytes;
+	if (entry.samples.size() > 0) {
+		std::vector<vx_float32> sorted(entry.samples);
+		std::sort(sorted.begin(), sorted.end());
+		vx_size num = sorted.size();
+		vx_float32 sum = 0.0f;
+		for (vx_size i = 0; i < num; i++) sum += sorted[i];
+		info->num = (vx_uint32)num;
+		info->last_ms = entry.samples[(entry.frames - 1) % LS_PERF_WINDOW_SIZE];
+		info->min_ms = sorted[0];
+		info->avg_ms = sum / num;
+		info->p99_ms = sorted[std::min(num - 1, (num * 99 + 99) / 100 - 1)];
+		info->max_ms = sorted[num - 1];
+	}
+}
+
+//! \brief Release copies of full output tables used for active output regions.
+static void ReleaseActiveRegionTables(ls_context stitch)
+{
+	if (stitch->fullValidPixelTable) { HostMemoryFree(&stitch->host_memory, stitch->fullValidPixelTable); stitch->fullValidPixelTable = nullptr; }
+	if (stitch->fullWarpRemapTable) { HostMemoryFree(&stitch->host_memory, stitch->fullWarpRemapTable); stitch->fullWarpRemapTable = nullptr; }
+	if (stitch->fullCamIdTable) { delete[] stitch->fullCamIdTable; stitch->fullCamIdTable = nullptr; }
+	if (stitch->fullWarpMergeIndexTable) { delete[] stitch->fullWarpMergeIndexTable; stitch->fullWarpMergeIndexTable = nullptr; }
+	if (stitch->fullExpCompValidTable) { HostMemoryFree(&stitch->host_memory, stitch->fullExpCompValidTable); stitch->fullExpCompValidTable = nullptr; }
+	if (stitch->fullOverlapPixelTable) { HostMemoryFree(&stitch->host_memory, stitch->fullOverlapPixelTable); stitch->fullOverlapPixelTable = nullptr; }
+	if (stitch->fullBlendOffsetTable) { HostMemoryFree(&stitch->host_memory, stitch->fullBlendOffsetTable); stitch->fullBlendOffsetTable = nullptr; }
+	stitch->fullWarpEntryCount = 0;
+	stitch->fullWarpRemapCount = 0;
+	stitch->fullExpCompValidCount = 0;
+	stitch->fullOverlapPixelCount = 0;
+}
+
+//! \brief Check if output rectangle [start_x,end_x)x[start_y,end_y) intersects any active output region grown by margin.
+static inline bool IsActiveOutputRect(ls_context stitch, vx_int32 start_x, vx_int32 start_y, vx_int32 end_x, vx_int32 end_y, vx_int32 margin)
+{
+	for (vx_uint32 i = 0; i < stitch->num_active_regions; i++) {
+		const vx_rectangle_t& rect = stitch->activeRegion[i];
+		if (end_x > (vx_int32)rect.start_x - margin && start_x < (vx_int32)rect.end_x + margin &&
+			end_y > (vx_int32)rect.start_y - margin && start_y < (vx_int32)rect.end_y + margin)
+			return true;
+	}
+	return false;
+}
+
+//! \brief Filter exposure comp tables to active output regions.
+static vx_status ApplyActiveOutputRegionsExpComp(ls_context stitch, vx_int32 margin)
+{
+	// gains are applied only to blocks within active regions
+	vx_size validItemSize = 0;
+	ERROR_CHECK_STATUS_(vxQueryArray(stitch->valid_array, VX_ARRAY_ITEMSIZE, &validItemSize, sizeof(validItemSize)));
+	if (!stitch->fullExpCompValidTable) {
+		ERROR_CHECK_STATUS_(vxQueryArray(stitch->valid_array, VX_ARRAY_NUMITEMS, &stitch->fullExpCompValidCount, sizeof(stitch->fullExpCompValidCount)));
+		ERROR_CHECK_ALLOC_(stitch->fullExpCompValidTable = AllocateHostBuffer<vx_uint8>(stitch, stitch->fullExpCompValidCount * validItemSize));
+		ERROR_CHECK_STATUS_(vxCopyArrayRange(stitch->valid_array, 0, stitch->fullExpCompValidCount, validItemSize, stitch->fullExpCompValidTable, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
+	}
+	std::vector<vx_uint8> validTable;
+	if (stitch->num_active_regions > 0 && stitch->fullExpCompValidCount > 0) {
+		for (vx_size i = 0; i < stitch->fullExpCompValidCount; i++) {
+			const vx_uint8 * validEntry = stitch->fullExpCompValidTable + i * validItemSize;
+			vx_int32 x, y, w, h;
+			if (stitch->useWideTables) {
+				const StitchExpCompCalcWideEntry * entry = (const StitchExpCompCalcWideEntry *)validEntry;
+				x = (entry->dstX << 3) + entry->start_x; y = (entry->dstY << 1) + entry->start_y; w = entry->end_x + 1; h = entry->end_y + 1;
+			}
+			else {
+				const StitchExpCompCalcEntry * entry = (const StitchExpCompCalcEntry *)validEntry;
+				x = (entry->dstX << 3) + entry->start_x; y = (entry->dstY << 1) + entry->start_y; w = entry->end_x + 1; h = entry->end_y + 1;
+			}
+			if (IsActiveOutputRect(stitch, x, y, x + w, y + h, margin))
+				validTable.insert(validTable.end(), validEntry, validEntry + validItemSize);
+		}
+		if (validTable.size() == 0) {
+			// keep one block so that the node still has work
+			validTable.assign(stitch->fullExpCompValidTable, stitch->fullExpCompValidTable + validItemSize);
+		}
+	}
+	const vx_uint8 * validBuf = validTable.size() > 0 ? validTable.data() : stitch->fullExpCompValidTable;
+	vx_size validCount = validTable.size() > 0 ? validTable.size() / validItemSize : stitch->fullExpCompValidCount;
+	ERROR_CHECK_STATUS_(vxTruncateArray(stitch->valid_array, 0));
+	if (validCount > 0) {
+		ERROR_CHECK_STATUS_(vxAddArrayItems(stitch->valid_array, validCount, validBuf, validItemSize));
+	}
+	ERROR_CHECK_STATUS_(vxDirective((vx_reference)stitch->valid_array, VX_DIRECTIVE_AMD_COPY_TO_OPENCL));
+
+	// error function gets a single empty block while regions are active: gains are solved from the error
+	// function of the last full output frame instead (see UpdateExposureCompSolve)
+	if (stitch->OverlapPixelEntry) {
+		vx_size overlapItemSize = 0;
+		ERROR_CHECK_STATUS_(vxQueryArray(stitch->OverlapPixelEntry, VX_ARRAY_ITEMSIZE, &overlapItemSize, sizeof(overlapItemSize)));
+		if (!stitch->fullOverlapPixelTable) {
+			ERROR_CHECK_STATUS_(vxQueryArray(stitch->OverlapPixelEntry, VX_ARRAY_NUMITEMS, &stitch->fullOverlapPixelCount, sizeof(stitch->fullOverlapPixelCount)));
+			ERROR_CHECK_ALLOC_(stitch->fullOverlapPixelTable = AllocateHostBuffer<vx_uint8>(stitch, stitch->fullOverlapPixelCount * overlapItemSize));
+			ERROR_CHECK_STATUS_(vxCopyArrayRange(stitch->OverlapPixelEntry, 0, stitch->fullOverlapPixelCount, overlapItemSize, stitch->fullOverlapPixelTable, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
+		}
+		std::vector<vx_uint8> emptyEntry(overlapItemSize, 0);
+		const vx_uint8 * overlapBuf = stitch->num_active_regions > 0 ? emptyEntry.data() : stitch->fullOverlapPixelTable;
+		vx_size overlapCount = stitch->num_active_regions > 0 ? 1 : stitch->fullOverlapPixelCount;
+		ERROR_CHECK_STATUS_(vxTruncateArray(stitch->OverlapPixelEntry, 0));
+		if (overlapCount > 0) {
+			ERROR_CHECK_STATUS_(vxAddArrayItems(stitch->OverlapPixelEntry, overlapCount, overlapBuf, overlapItemSize));
+		}
+		ERROR_CHECK_STATUS_(vxDirective((vx_reference)stitch->OverlapPixelEntry, VX_DIRECTIVE_AMD_COPY_TO_OPENCL));
+	}
+	return VX_SUCCESS;
+}
+
+//! \brief Filter multiband blend work lists to active output regions.
+//  Lists keep their place in the table (node scalars refer to them): entries are picked in place and the count
+//  in the first entry of each list is updated.
+static vx_status ApplyActiveOutputRegionsBlend(ls_context stitch, vx_int32 margin)
+{
+	vx_size itemSize = 0, tableSize = stitch->table_sizes.blendOffsetTableSize;
+	ERROR_CHECK_STATUS_(vxQueryArray(stitch->blend_offsets, VX_ARRAY_ITEMSIZE, &itemSize, sizeof(itemSize)));
+	if (!stitch->fullBlendOffsetTable) {
+		ERROR_CHECK_ALLOC_(stitch->fullBlendOffsetTable = AllocateHostBuffer<vx_uint8>(stitch, tableSize * itemSize));
+		ERROR_CHECK_STATUS_(vxCopyArrayRange(stitch->blend_offsets, 0, tableSize, itemSize, stitch->fullBlendOffsetTable, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
+	}
+	std::vector<vx_uint8> table(stitch->fullBlendOffsetTable, stitch->fullBlendOffsetTable + tableSize * itemSize);
+	if (stitch->num_active_regions > 0) {
+		for (vx_int32 list = 0; list < stitch->num_bands * 2; list++) {
+			// level#0 footprint list is same as level#0 seam band list
+			if (list == stitch->num_bands)
+				continue;
+			vx_int32 level = list % stitch->num_bands;
+			vx_uint8 * listBuf = &table[stitch->multibandBlendOffsetIntoBuffer[list] * itemSize];
+			vx_uint64 fullCount = 0, count = 0;
+			memcpy(&fullCount, listBuf - itemSize, sizeof(fullCount));
+			for (vx_uint64 i = 0; i < fullCount; i++) {
+				const vx_uint8 * entry = listBuf + i * itemSize;
+				vx_int32 x = stitch->useWideTables ? ((const StitchBlendValidWideEntry *)entry)->dstX : ((const StitchBlendValidEntry *)entry)->dstX;
+				vx_int32 y = stitch->useWideTables ? ((const StitchBlendValidWideEntry *)entry)->dstY : ((const StitchBlendValidEntry *)entry)->dstY;
+				if (stitch->camera_plane_array) {
+					// tiles in row packed camera planes are moved up by first row of camera plane at the level
+					vx_uint32 camId = stitch->useWideTables ? ((const StitchBlendValidWideEntry *)entry)->camId : ((const StitchBlendValidEntry *)entry)->camId;
+					const StitchCameraPlaneEntry& plane = stitch->cameraPlanes[camId];
+					y += ((vx_int32)(camId * plane.height) - plane.offsetY) >> level;
+				}
+				// 64x16 tile at the level covers (64x16 << level) output pixels
+				if (IsActiveOutputRect(stitch, x << level, y << level, (x + 64) << level, (y + 16) << level, margin)) {
+					memmove(listBuf + count * itemSize, entry, itemSize);
+					count++;
+				}
+			}
+			memcpy(listBuf - itemSize, &count, sizeof(count));
+		}
+	}
+	ERROR_CHECK_STATUS_(vxCopyArrayRange(stitch->blend_offsets, 0, tableSize, itemSize, table.data(), VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST));
+	ERROR_CHECK_STATUS_(vxDirective((vx_reference)stitch->blend_offsets, VX_DIRECTIVE_AMD_COPY_TO_OPENCL));
+	return VX_SUCCESS;
+}
+
+//! \brief Filter warp, exposure comp, blend and merge tables to active output regions.
+static vx_status ApplyActiveOutputRegions(ls_context stitch)
+{
+	vx_size validItemSize = 0, remapItemSize = 0;
+	ERROR_CHECK_STATUS_(vxQueryArray(stitch->ValidPixelEntry, VX_ARRAY_ITEMSIZE, &validItemSize, sizeof(validItemSize)));
+	ERROR_CHECK_STATUS_(vxQueryArray(stitch->WarpRemapEntry, VX_ARRAY_ITEMSIZE, &remapItemSize, sizeof(remapItemSize)));
+	vx_uint32 camIdWidth = stitch->output_rgb_buffer_width / 8, camIdHeight = stitch->output_rgb_buffer_height;
+	vx_rectangle_t rectId = { 0, 0, camIdWidth, camIdHeight };
+	vx_imagepatch_addressing_t addrId = { 0 }, addrIndex = { 0 };
+	addrId.dim_x = camIdWidth;
+	addrId.dim_y = camIdHeight;
+	addrId.stride_x = 1;
+	addrId.stride_y = camIdWidth;
+	addrIndex.dim_x = camIdWidth;
+	addrIndex.dim_y = camIdHeight;
+	addrIndex.stride_x = sizeof(vx_uint32);
+	addrIndex.stride_y = camIdWidth * sizeof(vx_uint32);
+	if (!stitch->fullValidPixelTable) {
+		// keep a copy of full output tables
+		ERROR_CHECK_STATUS_(vxQueryArray(stitch->ValidPixelEntry, VX_ARRAY_NUMITEMS, &stitch->fullWarpEntryCount, sizeof(stitch->fullWarpEntryCount)));
+		ERROR_CHECK_STATUS_(vxQueryArray(stitch->WarpRemapEntry, VX_ARRAY_NUMITEMS, &stitch->fullWarpRemapCount, sizeof(stitch->fullWarpRemapCount)));
+		ERROR_CHECK_ALLOC_(stitch->fullValidPixelTable = AllocateHostBuffer<vx_uint8>(stitch, stitch->fullWarpEntryCount * validItemSize));
+		ERROR_CHECK_ALLOC_(stitch->fullWarpRemapTable = AllocateHostBuffer<vx_uint8>(stitch, stitch->fullWarpRemapCount * remapItemSize));
+		ERROR_CHECK_ALLOC_(stitch->fullCamIdTable = new vx_uint8[camIdWidth * camIdHeight]);
+		ERROR_CHECK_STATUS_(vxCopyArrayRange(stitch->ValidPixelEntry, 0, stitch->fullWarpEntryCount, validItemSize, stitch->fullValidPixelTable, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
+		ERROR_CHECK_STATUS_(vxCopyArrayRange(stitch->WarpRemapEntry, 0, stitch->fullWarpRemapCount, remapItemSize, stitch->fullWarpRemapTable, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
+		ERROR_CHECK_STATUS_(vxCopyImagePatch(stitch->cam_id_image, &rectId, 0, &addrId, stitch->fullCamIdTable, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
+		if (stitch->warp_merge_index_image) {
+			ERROR_CHECK_ALLOC_(stitch->fullWarpMergeIndexTable = new vx_uint32[camIdWidth * camIdHeight]);
+			ERROR_CHECK_STATUS_(vxCopyImagePatch(stitch->warp_merge_index_image, &rectId, 0, &addrIndex, stitch->fullWarpMergeIndexTable, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
+		}
+	}
+	// multiband blend pyramid filters read pixels around active regions: warp and gains cover those pixels too
+	vx_int32 margin = stitch->MULTIBAND_BLEND ? (4 << stitch->num_bands) : 0;
+
+	// pick warp table entries within active regions: escaped compact entries get a new overflow area
+	bool useCompactWarpTable = (remapItemSize == sizeof(StitchWarpRemapCompactEntry));
+	std::vector<vx_uint8> validTable, remapTable, overflowTable;
+	std::vector<vx_size> escapeEntries;
+	if (stitch->num_active_regions > 0) {
+		validTable.reserve(stitch->fullWarpEntryCount * validItemSize);
+		remapTable.reserve(stitch->fullWarpEntryCount * remapItemSize);
+		for (vx_size i = 0; i < stitch->fullWarpEntryCount; i++) {
+			const vx_uint8 * validEntry = stitch->fullValidPixelTable + i * validItemSize;
+			if (*(const vx_uint32 *)validEntry == 0xFFFFFFFF)
+				continue;
+			vx_uint32 camId, dstX, dstY;
+			if (stitch->useWideTables) {
+				const StitchValidPixelWideEntry * entry = (const StitchValidPixelWideEntry *)validEntry;
+				camId = entry->camId; dstX = entry->dstX; dstY = entry->dstY;
+			}
+			else {
+				const StitchValidPixelEntry * entry = (const StitchValidPixelEntry *)validEntry;
+				camId = entry->camId; dstX = entry->dstX; dstY = entry->dstY;
+			}
+			vx_int32 x = (vx_int32)(dstX << 3), y = (vx_int32)dstY;
+			if (stitch->camera_plane_array) {
+				// packed camera plane location to output location
+				x -= stitch->cameraPlanes[camId].offsetX;
+				y -= stitch->cameraPlanes[camId].offsetY;
+			}
+			if (IsActiveOutputRect(stitch, x, y, x + 8, y + 1, margin)) {
+				const vx_uint8 * remapEntry = stitch->fullWarpRemapTable + i * remapItemSize;
+				if (useCompactWarpTable && ((const StitchWarpRemapCompactEntry *)remapEntry)->deltaX == STITCH_WARP_COMPACT_ESCAPE) {
+					const StitchWarpRemapCompactEntry * escapeEntry = (const StitchWarpRemapCompactEntry *)remapEntry;
+					const vx_uint8 * fullEntry = stitch->fullWarpRemapTable + (((vx_size)escapeEntry->srcY << 16) | escapeEntry->srcX) * remapItemSize;
+					escapeEntries.push_back(remapTable.size() / remapItemSize);
+					overflowTable.insert(overflowTable.end(), fullEntry, fullEntry + sizeof(StitchWarpRemapEntry));
+				}
+				validTable.insert(validTable.end(), validEntry, validEntry + validItemSize);
+				remapTable.insert(remapTable.end(), remapEntry, remapEntry + remapItemSize);
+			}
+		}
+		for (vx_size k = 0; k < escapeEntries.size(); k++) {
+			// overflow area follows the picked entries
+			vx_uint32 index = (vx_uint32)(remapTable.size() / remapItemSize + k * (sizeof(StitchWarpRemapEntry) / remapItemSize));
+			StitchWarpRemapCompactEntry * escapeEntry = (StitchWarpRemapCompactEntry *)&remapTable[escapeEntries[k] * remapItemSize];
+			escapeEntry->srcX = (vx_uint16)(index & 0xffff);
+			escapeEntry->srcY = (vx_uint16)(index >> 16);
+		}
+		remapTable.insert(remapTable.end(), overflowTable.begin(), overflowTable.end());
+		if (validTable.size() == 0) {
+			// keep one entry that gets skipped by warp
+			validTable.resize(validItemSize, 0xFF);
+			remapTable.resize(remapItemSize, 0);
+		}
+	}
+	const vx_uint8 * validBuf = validTable.size() > 0 ? validTable.data() : stitch->fullValidPixelTable;
+	const vx_uint8 * remapBuf = remapTable.size() > 0 ? remapTable.data() : stitch->fullWarpRemapTable;
+	vx_size entryCount = validTable.size() > 0 ? validTable.size() / validItemSize : stitch->fullWarpEntryCount;
+	vx_size remapCount = remapTable.size() > 0 ? remapTable.size() / remapItemSize : stitch->fullWarpRemapCount;
+	ERROR_CHECK_STATUS_(vxTruncateArray(stitch->ValidPixelEntry, 0));
+	ERROR_CHECK_STATUS_(vxTruncateArray(stitch->WarpRemapEntry, 0));
+	ERROR_CHECK_STATUS_(vxAddArrayItems(stitch->ValidPixelEntry, entryCount, validBuf, validItemSize));
+	ERROR_CHECK_STATUS_(vxAddArrayItems(stitch->WarpRemapEntry, remapCount, remapBuf, remapItemSize));
+
+	// merge skips camId blocks outside active regions
+	std::vector<vx_uint8> camIdTable(stitch->fullCamIdTable, stitch->fullCamIdTable + camIdWidth * camIdHeight);
+	if (stitch->num_active_regions > 0) {
+		for (vx_uint32 y = 0; y < camIdHeight; y++) {
+			for (vx_uint32 xi = 0; xi < camIdWidth; xi++) {
+				if (!IsActiveOutputRect(stitch, (vx_int32)(xi << 3), (vx_int32)y, (vx_int32)(xi << 3) + 8, (vx_int32)y + 1, 0))
+					camIdTable[y * camIdWidth + xi] = 31;
+			}
+		}
+	}
+	ERROR_CHECK_STATUS_(vxCopyImagePatch(stitch->cam_id_image, &rectId, 0, &addrId, camIdTable.data(), VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST));
+
+	if (stitch->warp_merge_index_image) {
+		// fused warp merge tables are ordered by output location, so the picked entries of each group stay
+		// consecutive: groups get new start indices and groups outside active regions are skipped
+		std::vector<vx_uint32> indexTable(stitch->fullWarpMergeIndexTable, stitch->fullWarpMergeIndexTable + camIdWidth * camIdHeight);
+		if (stitch->num_active_regions > 0) {
+			vx_uint32 start = 0;
+			for (vx_uint32 y = 0; y < camIdHeight; y++) {
+				for (vx_uint32 xi = 0; xi < camIdWidth; xi++) {
+					StitchWarpMergeIndexEntry * index = (StitchWarpMergeIndexEntry *)&indexTable[y * camIdWidth + xi];
+					if (IsActiveOutputRect(stitch, (vx_int32)(xi << 3), (vx_int32)y, (vx_int32)(xi << 3) + 8, (vx_int32)y + 1, 0)) {
+						index->start = start;
+						start += index->count;
+					}
+					else {
+						indexTable[y * camIdWidth + xi] = STITCH_WARP_MERGE_INDEX_SKIP;
+					}
+				}
+			}
+		}
+		ERROR_CHECK_STATUS_(vxCopyImagePatch(stitch->warp_merge_index_image, &rectId, 0, &addrIndex, indexTable.data(), VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST));
+		ERROR_CHECK_STATUS_(vxDirective((vx_reference)stitch->warp_merge_index_image, VX_DIRECTIVE_AMD_COPY_TO_OPENCL));
+	}
+	if (stitch->EXPO_COMP) {
+		ERROR_CHECK_STATUS_(ApplyActiveOutputRegionsExpComp(stitch, margin));
+	}
+	if (stitch->MULTIBAND_BLEND) {
+		ERROR_CHECK_STATUS_(ApplyActiveOutputRegionsBlend(stitch, margin));
+	}
+
+	ERROR_CHECK_STATUS_(vxDirective((vx_reference)stitch->ValidPixelEntry, VX_DIRECTIVE_AMD_COPY_TO_OPENCL));
+	ERROR_CHECK_STATUS_(vxDirective((vx_reference)stitch->WarpRemapEntry, VX_DIRECTIVE_AMD_COPY_TO_OPENCL));
+	ERROR_CHECK_STATUS_(vxDirective((vx_reference)stitch->cam_id_image, VX_DIRECTIVE_AMD_COPY_TO_OPENCL));
+	return VX_SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 // Stitch API implementation
 
@@ -1884,6 +2963,19 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetAttributes(ls_context stitch, v
 					return status;
 			}
 		}
+		else if (attr == LIVE_STITCH_ATTR_SEAM_BUDGET) {
+			// update scalar of seamfind analyze kernel
+			stitch->seam_budget_value = (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_SEAM_BUDGET];
+			if (stitch->seam_budget) {
+				vx_status status = vxWriteScalarValue(stitch->seam_budget, &stitch->seam_budget_value);
+				if (status != VX_SUCCESS)
+					return status;
+			}
+		}
+		else if (attr == LIVE_STITCH_ATTR_EXPCOMP_GAIN_SMOOTHING) {
+			// gain moving average is applied by lsScheduleFrame
+			stitch->expCompGainSmoothing = std::min(std::max(stitch->live_stitch_attr[LIVE_STITCH_ATTR_EXPCOMP_GAIN_SMOOTHING], 0.0f), 1.0f);
+		}
 		else {
 			// not all attributes are supported
 			return VX_ERROR_NOT_SUPPORTED;
@@ -1932,6 +3024,27 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetOpenCLContext(ls_context stitch
 	return VX_SUCCESS;
 }
 
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsShareInternalTables(ls_context stitch, ls_context table_owner)
+{
+	ERROR_CHECK_STATUS_(IsValidContextAndNotInitialized(stitch));
+	ERROR_CHECK_STATUS_(IsValidContextAndInitialized(table_owner));
+	if (!table_owner->context_is_external || (stitch->context && stitch->context != table_owner->context)) {
+		ls_printf("ERROR: lsShareInternalTables: both contexts need to use the same OpenVX context set with lsSetOpenVXContext\n");
+		return VX_ERROR_NOT_SUPPORTED;
+	}
+	if (table_owner->feature_enable_reinitialize || table_owner->num_active_regions > 0) {
+		ls_printf("ERROR: lsShareInternalTables: tables can't be shared when reinitialize or active output regions are used\n");
+		return VX_ERROR_NOT_SUPPORTED;
+	}
+	if (!stitch->context) {
+		// use OpenVX context of the table owner
+		stitch->context = table_owner->context;
+		stitch->context_is_external = true;
+	}
+	stitch->table_owner = table_owner;
+	return VX_SUCCESS;
+}
+
 LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetRigParams(ls_context stitch, const rig_params * par)
 {
 	ERROR_CHECK_STATUS_(IsValidContext(stitch));
@@ -1991,6 +3104,24 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetCameraConfig(ls_context stitch,
 	return VX_SUCCESS;
 }
 
+//! \brief Check the output projection and the output dimensions it needs: the projection attribute can change after lsSetOutputConfig.
+static vx_status CheckOutputProjection(const char * func, vx_uint32 projection, vx_uint32 buffer_width, vx_uint32 buffer_height)
+{
+	if (projection > output_projection_eac) {
+		ls_printf("ERROR: %s: output projection %d is not supported\n", func, projection);
+		return VX_ERROR_NOT_SUPPORTED;
+	}
+	if (projection == output_projection_equirectangular && buffer_width != (buffer_height * 2)) {
+		ls_printf("ERROR: %s: buffer_width should be 2 times buffer_height\n", func);
+		return VX_ERROR_INVALID_DIMENSION;
+	}
+	if (projection != output_projection_equirectangular && (buffer_width * 2) != (buffer_height * 3)) {
+		ls_printf("ERROR: %s: buffer_width should be 1.5 times buffer_height for cubemap output (3x2 faces)\n", func);
+		return VX_ERROR_INVALID_DIMENSION;
+	}
+	return VX_SUCCESS;
+}
+
 LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetOutputConfig(ls_context stitch, vx_df_image buffer_format, vx_uint32 buffer_width, vx_uint32 buffer_height)
 {
 	ERROR_CHECK_STATUS_(IsValidContextAndNotInitialized(stitch));
@@ -1998,10 +3129,7 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetOutputConfig(ls_context stitch,
 		ls_printf("ERROR: lsSetOutputConfig: only UYVY/YUYV/RGB/NV12/IYUV buffer formats are allowed\n");
 		return VX_ERROR_INVALID_FORMAT;
 	}
-	if (buffer_width != (buffer_height * 2)) {
-		ls_printf("ERROR: lsSetOutputConfig: buffer_width should be 2 times buffer_height\n");
-		return VX_ERROR_INVALID_DIMENSION;
-	}
+	ERROR_CHECK_STATUS_(CheckOutputProjection("lsSetOutputConfig", (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_OUTPUT_PROJECTION], buffer_width, buffer_height));
 	// check that dimensions are multiples of 16x2
 	if ((buffer_width % 16) != 0 || (buffer_height % 2) != 0) {
 		ls_printf("ERROR: lsSetOutputConfig: output dimensions are required to be multiple of 16x2\n");
@@ -2187,6 +3315,19 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 	stitch->loomioOverlayAuxDataLength = std::min((vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_IO_OVERLAY_AUX_DATA_SIZE], (vx_uint32)LOOMIO_MIN_AUX_DATA_CAPACITY);
 	stitch->loomioOutputAuxDataLength = std::min((vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_IO_OUTPUT_AUX_DATA_SIZE], (vx_uint32)LOOMIO_MIN_AUX_DATA_CAPACITY);
 
+	// host execution: LoomIO modules use OpenCL buffers; overlays, renditions and encode tiles have only OpenCL kernels
+	stitch->HOST_EXECUTION = (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_HOST_EXECUTION];
+	if (stitch->HOST_EXECUTION) {
+		if (strlen(stitch->loomio_camera.kernelName) > 0 || strlen(stitch->loomio_overlay.kernelName) > 0 || strlen(stitch->loomio_output.kernelName) > 0 ||
+			strlen(stitch->loomio_viewing.kernelName) > 0 || stitch->num_overlays > 0 || stitch->live_stitch_attr[LIVE_STITCH_ATTR_OUTPUT_RENDITIONS] > 1.0f ||
+			stitch->live_stitch_attr[LIVE_STITCH_ATTR_OUTPUT_TILE_NUM_X] != 1.0f || stitch->live_stitch_attr[LIVE_STITCH_ATTR_OUTPUT_TILE_NUM_Y] != 1.0f)
+		{
+			ls_printf("ERROR: lsInitialize: LoomIO modules, overlays, output renditions and encode tiles are not supported with host execution\n");
+			return VX_ERROR_NOT_SUPPORTED;
+		}
+	}
+	vx_enum io_memory_type = stitch->HOST_EXECUTION ? VX_MEMORY_TYPE_HOST : VX_MEMORY_TYPE_OPENCL;
+
 	/////////////////////////////////////////////////////////
 	// create and initialize OpenVX context and graphs
 	if (!stitch->context) {
@@ -2196,6 +3337,12 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 		}
 	}
 	ERROR_CHECK_OBJECT_(stitch->context);
+	if (stitch->HOST_EXECUTION) {
+		// CPU target affinity for all nodes: the stitch kernels check it to pick their CPU implementations
+		AgoTargetAffinityInfo affinity = { 0 };
+		affinity.device_type = AGO_TARGET_AFFINITY_CPU;
+		ERROR_CHECK_STATUS_(vxSetContextAttribute(stitch->context, VX_CONTEXT_ATTRIBUTE_AMD_AFFINITY, &affinity, sizeof(affinity)));
+	}
 	vxRegisterLogCallback(stitch->context, log_callback, vx_false_e);
 	ERROR_CHECK_STATUS_(vxPublishKernels(stitch->context));
 	ERROR_CHECK_OBJECT_(stitch->graphStitch = vxCreateGraph(stitch->context));
@@ -2243,7 +3390,7 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 				addr_in[2].dim_x = stitch->camera_buffer_width;	addr_in[2].dim_y = stitch->camera_buffer_height;
 				addr_in[2].stride_x = 1; addr_in[2].stride_y = stitch->camera_buffer_stride_in_bytes;
 			}
-			ERROR_CHECK_OBJECT_(stitch->Img_input = vxCreateImageFromHandle(stitch->context, stitch->camera_buffer_format, &addr_in[0], ptr, VX_MEMORY_TYPE_OPENCL));
+			ERROR_CHECK_OBJECT_(stitch->Img_input = vxCreateImageFromHandle(stitch->context, stitch->camera_buffer_format, &addr_in[0], ptr, io_memory_type));
 		}
 		else{
 			vx_imagepatch_addressing_t addr_in = { 0 };
@@ -2253,11 +3400,22 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 			addr_in.stride_x = (stitch->camera_buffer_format == VX_DF_IMAGE_RGB) ? 3 : 2;
 			addr_in.stride_y = stitch->camera_buffer_stride_in_bytes;
 			if (addr_in.stride_y == 0) addr_in.stride_y = addr_in.stride_x * addr_in.dim_x;
-			ERROR_CHECK_OBJECT_(stitch->Img_input = vxCreateImageFromHandle(stitch->context, stitch->camera_buffer_format, &addr_in, ptr, VX_MEMORY_TYPE_OPENCL));
+			ERROR_CHECK_OBJECT_(stitch->Img_input = vxCreateImageFromHandle(stitch->context, stitch->camera_buffer_format, &addr_in, ptr, io_memory_type));
 		}
 	}
 	// check attribute for fast init code
 	stitch->USE_CPU_INIT = (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_USE_CPU_FOR_INIT];
+	// cubemap outputs: the GPU initialize kernels only generate equirectangular tables; host execution has no GPU
+	stitch->OUTPUT_PROJECTION = (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_OUTPUT_PROJECTION];
+	ERROR_CHECK_STATUS_(CheckOutputProjection("lsInitialize", stitch->OUTPUT_PROJECTION, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height));
+	if (stitch->OUTPUT_PROJECTION != output_projection_equirectangular || stitch->HOST_EXECUTION) {
+		stitch->USE_CPU_INIT = 1;
+	}
+	// the GPU initialize kernels generate 32-bit camera masks
+	if (stitch->num_cameras > 32 || stitch->num_overlays > 32) {
+		stitch->USE_CPU_INIT = 1;
+	}
+	stitch->WARP_TABLE_FORMAT = (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_WARP_TABLE_FORMAT];
 	stitch->stitchInitData = nullptr;
 
 	if (stitch->num_overlays > 0) {
@@ -2293,24 +3451,20 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 			if (addr_overlay.stride_y == 0) addr_overlay.stride_y = addr_overlay.stride_x * addr_overlay.dim_x;
 			ERROR_CHECK_OBJECT_(stitch->Img_overlay = vxCreateImageFromHandle(stitch->context, VX_DF_IMAGE_RGBX, &addr_overlay, ptr_overlay, VX_MEMORY_TYPE_OPENCL));
 		}
-		// create remap table object and image for overlay warp
-		ERROR_CHECK_OBJECT_(stitch->overlay_remap = vxCreateRemap(stitch->context, stitch->overlay_buffer_width, stitch->overlay_buffer_height, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height));
-		ERROR_CHECK_OBJECT_(stitch->Img_overlay_rgb = vxCreateVirtualImage(stitch->graphStitch, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height, VX_DF_IMAGE_RGB));
-		ERROR_CHECK_OBJECT_(stitch->Img_overlay_rgba = vxCreateVirtualImage(stitch->graphStitch, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height, VX_DF_IMAGE_RGBX));
-		// initialize remap using lens model
+		if (std::max(stitch->overlay_buffer_width, stitch->overlay_buffer_height) > STITCH_WARP_WIDE_MAX_SRC_SIZE) {
+			// overlay buffer locations don't fit in overlay tables: create remap table object and image for full output overlay warp
+			ERROR_CHECK_OBJECT_(stitch->overlay_remap = vxCreateRemap(stitch->context, stitch->overlay_buffer_width, stitch->overlay_buffer_height, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height));
+			ERROR_CHECK_OBJECT_(stitch->Img_overlay_rgb = vxCreateVirtualImage(stitch->graphStitch, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height, VX_DF_IMAGE_RGB));
+			ERROR_CHECK_OBJECT_(stitch->Img_overlay_rgba = vxCreateVirtualImage(stitch->graphStitch, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height, VX_DF_IMAGE_RGBX));
+		}
+		// initialize overlay tables using lens model
 		ERROR_CHECK_STATUS_(AllocateLensModelBuffersForOverlay(stitch));
-		ERROR_CHECK_STATUS_(InitializeInternalTablesForRemap(stitch, stitch->overlay_remap,
-			stitch->num_overlays, stitch->num_overlay_columns,
-			stitch->overlay_buffer_width / stitch->num_overlay_columns,
-			stitch->overlay_buffer_height / stitch->num_overlay_rows,
-			stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height,
-			&stitch->rig_par, stitch->overlay_par, stitch->overlaySrcMap, stitch->validPixelOverlayMap,
-			stitch->overlayIndexTmpBuf, stitch->overlayIndexBuf));
+		ERROR_CHECK_STATUS_(InitializeInternalTablesForOverlay(stitch));
 		if (!stitch->feature_enable_reinitialize) {
-			if (stitch->overlaySrcMap) { delete[] stitch->overlaySrcMap; stitch->overlaySrcMap = nullptr; }
-			if (stitch->validPixelOverlayMap) { delete[] stitch->validPixelOverlayMap; stitch->validPixelOverlayMap = nullptr; }
-			if (stitch->overlayIndexTmpBuf) { delete[] stitch->overlayIndexTmpBuf; stitch->overlayIndexTmpBuf = nullptr; }
-			if (stitch->overlayIndexBuf) { delete[] stitch->overlayIndexBuf; stitch->overlayIndexBuf = nullptr; }
+			if (stitch->overlaySrcMap) { HostMemoryFree(&stitch->host_memory, stitch->overlaySrcMap); stitch->overlaySrcMap = nullptr; }
+			if (stitch->validPixelOverlayMap) { HostMemoryFree(&stitch->host_memory, stitch->validPixelOverlayMap); stitch->validPixelOverlayMap = nullptr; }
+			if (stitch->overlayIndexTmpBuf) { HostMemoryFree(&stitch->host_memory, stitch->overlayIndexTmpBuf); stitch->overlayIndexTmpBuf = nullptr; }
+			if (stitch->overlayIndexBuf) { HostMemoryFree(&stitch->host_memory, stitch->overlayIndexBuf); stitch->overlayIndexBuf = nullptr; }
 		}
 	}
 	if (strlen(stitch->loomio_output.kernelName) > 0) {
@@ -2410,7 +3564,7 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 					addr_out[2].dim_x = stitch->output_rgb_buffer_width;	addr_out[2].dim_y = stitch->output_rgb_buffer_height;
 					addr_out[2].stride_x = 1; addr_out[2].stride_y = stitch->output_buffer_stride_in_bytes;
 				}
-				ERROR_CHECK_OBJECT_(stitch->Img_output = vxCreateImageFromHandle(stitch->context, stitch->output_buffer_format, &addr_out[0], ptr, VX_MEMORY_TYPE_OPENCL));
+				ERROR_CHECK_OBJECT_(stitch->Img_output = vxCreateImageFromHandle(stitch->context, stitch->output_buffer_format, &addr_out[0], ptr, io_memory_type));
 			}			
 		}
 		else{
@@ -2422,10 +3576,32 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 			addr_out.stride_x = (stitch->output_buffer_format == VX_DF_IMAGE_RGB) ? 3 : 2;
 			addr_out.stride_y = stitch->output_buffer_stride_in_bytes;
 			if (addr_out.stride_y == 0) addr_out.stride_y = addr_out.stride_x * addr_out.dim_x;
-			ERROR_CHECK_OBJECT_(stitch->Img_output = vxCreateImageFromHandle(stitch->context, stitch->output_buffer_format, &addr_out, ptr, VX_MEMORY_TYPE_OPENCL));
+			ERROR_CHECK_OBJECT_(stitch->Img_output = vxCreateImageFromHandle(stitch->context, stitch->output_buffer_format, &addr_out, ptr, io_memory_type));
 		}
 	}
 	if (stitch->output_encode_tiles > 4){ ls_printf("ERROR: lsInitialize: Max Encode Tiles supported is 4\n"); return VX_ERROR_INVALID_PARAMETERS;}
+	// output rendition ladder: each rendition is a 2x downscale of the previous one
+	stitch->num_output_renditions = std::max(1u, (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_OUTPUT_RENDITIONS]);
+	if (stitch->num_output_renditions > 1) {
+		if (stitch->num_output_renditions > LIVE_STITCH_MAX_OUTPUT_RENDITIONS) {
+			ls_printf("ERROR: lsInitialize: Max Output Renditions supported is %d\n", LIVE_STITCH_MAX_OUTPUT_RENDITIONS);
+			return VX_ERROR_INVALID_PARAMETERS;
+		}
+		if (stitch->nodeLoomIoOutput) {
+			stitch->num_output_renditions = 1;
+			ls_printf("WARNING: output renditions are not supported with LoomIO output module: using single output\n");
+		}
+		else if ((stitch->output_rgb_buffer_width % (16 << (stitch->num_output_renditions - 1))) != 0 ||
+			(stitch->output_rgb_buffer_height % (2 << (stitch->num_output_renditions - 1))) != 0)
+		{
+			ls_printf("ERROR: lsInitialize: output dimensions are required to be multiple of %dx%d for %d renditions\n",
+				16 << (stitch->num_output_renditions - 1), 2 << (stitch->num_output_renditions - 1), stitch->num_output_renditions);
+			return VX_ERROR_INVALID_DIMENSION;
+		}
+	}
+	for (vx_uint32 i = 1; i < stitch->num_output_renditions; i++) {
+		ERROR_CHECK_STATUS_(CreateOutputRenditionImages(stitch, i));
+	}
 	// create temporary images when extra color conversion is needed
 	if (stitch->camera_buffer_format != VX_DF_IMAGE_RGB) {
 		ERROR_CHECK_OBJECT_(stitch->Img_input_rgb = vxCreateVirtualImage(stitch->graphStitch, stitch->camera_rgb_buffer_width, stitch->camera_rgb_buffer_height, VX_DF_IMAGE_RGB));
@@ -2446,7 +3622,7 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 		addr_out.stride_x = 3;
 		addr_out.stride_y = stitch->output_buffer_width * 3;
 		if (addr_out.stride_y == 0) addr_out.stride_y = addr_out.stride_x * addr_out.dim_x;
-		ERROR_CHECK_OBJECT_(stitch->chroma_key_input_img = vxCreateImageFromHandle(stitch->context, VX_DF_IMAGE_RGB, &addr_out, ptr, VX_MEMORY_TYPE_OPENCL));
+		ERROR_CHECK_OBJECT_(stitch->chroma_key_input_img = vxCreateImageFromHandle(stitch->context, VX_DF_IMAGE_RGB, &addr_out, ptr, io_memory_type));
 		// create chroma key mask U8 buffer
 		vx_uint32 output_img_width = stitch->output_buffer_width;
 		vx_uint32 output_img_height = stitch->output_buffer_height;
@@ -2503,6 +3679,18 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 		}
 		stitch->rgb_output = stitch->Img_output_rgb;
 	}
+	// lower renditions are chained from the final RGB output of the stitch
+	for (vx_uint32 i = 1; i < stitch->num_output_renditions; i++) {
+		vx_image src_rgb = (i > 1) ? (stitch->rendition_rgb[i - 1] ? stitch->rendition_rgb[i - 1] : stitch->rendition_output[i - 1]) : stitch->rgb_output;
+		vx_image dst_rgb = stitch->rendition_rgb[i] ? stitch->rendition_rgb[i] : stitch->rendition_output[i];
+		ERROR_CHECK_OBJECT_(stitch->rendition_scale_nodes[i] = stitchHalfScaleRGBNode(stitch->graphStitch, src_rgb, dst_rgb));
+		if (stitch->output_buffer_format == VX_DF_IMAGE_NV12 || stitch->output_buffer_format == VX_DF_IMAGE_IYUV) {
+			ERROR_CHECK_OBJECT_(stitch->rendition_convert_nodes[i] = vxColorConvertNode(stitch->graphStitch, dst_rgb, stitch->rendition_output[i]));
+		}
+		else if (stitch->output_buffer_format != VX_DF_IMAGE_RGB) {
+			ERROR_CHECK_OBJECT_(stitch->rendition_convert_nodes[i] = stitchColorConvertNode(stitch->graphStitch, dst_rgb, stitch->rendition_output[i]));
+		}
+	}
 	if (stitch->CHROMA_KEY){
 		vx_uint32 ChromaKey_value = (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_CHROMA_KEY_VALUE];
 		vx_uint32 ChromaKey_Tol = (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_CHROMA_KEY_TOL];
@@ -2522,12 +3710,16 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 		}
 		stitch->rgb_output = stitch->chroma_key_input_RGB_img;
 	}
-	if (stitch->Img_overlay) {
+	if (stitch->Img_overlay && stitch->overlay_remap) {
 		// need add overlay
 		ERROR_CHECK_OBJECT_(stitch->nodeOverlayRemap = vxRemapNode(stitch->graphStitch, stitch->Img_overlay, stitch->overlay_remap, VX_INTERPOLATION_TYPE_BILINEAR, stitch->Img_overlay_rgba));
 		ERROR_CHECK_OBJECT_(stitch->nodeOverlayBlend = stitchAlphaBlendNode(stitch->graphStitch, stitch->Img_overlay_rgb, stitch->Img_overlay_rgba, stitch->rgb_output));
 		stitch->rgb_output = stitch->Img_overlay_rgb;
 	}
+	else if (stitch->Img_overlay) {
+		// need add overlay: warp and blend only at overlay footprint in the output
+		ERROR_CHECK_OBJECT_(stitch->nodeOverlayBlend = stitchOverlayBlendNode(stitch->graphStitch, stitch->OverlayValidPixelEntry, stitch->OverlayWarpRemapEntry, stitch->Img_overlay, stitch->rgb_output));
+	}
 	if (strlen(stitch->loomio_viewing.kernelName) > 0) {
 		// load OpenVX module (if specified)
 		if (strlen(stitch->loomio_viewing.module) > 0) {
@@ -2555,22 +3747,30 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 	************************************************************************************************************************************/
 	if (stitch->stitching_mode == stitching_mode_quick_and_dirty)
 	{
-		// create remap table object
-		ERROR_CHECK_OBJECT_(stitch->camera_remap = vxCreateRemap(stitch->context, stitch->camera_rgb_buffer_width, stitch->camera_rgb_buffer_height, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height));
-		// initialize remap using lens model
-		ERROR_CHECK_STATUS_(AllocateLensModelBuffersForCamera(stitch));
-		ERROR_CHECK_STATUS_(InitializeInternalTablesForRemap(stitch, stitch->camera_remap,
-			stitch->num_cameras, stitch->num_camera_columns,
-			stitch->camera_buffer_width / stitch->num_camera_columns,
-			stitch->camera_buffer_height / stitch->num_camera_rows,
-			stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height,
-			&stitch->rig_par, stitch->camera_par, stitch->camSrcMap, stitch->validPixelCamMap,
-			stitch->camIndexTmpBuf, stitch->camIndexBuf));
-		if (!stitch->feature_enable_reinitialize) {
-			if (stitch->camSrcMap) { delete[] stitch->camSrcMap; stitch->camSrcMap = nullptr; }
-			if (stitch->validPixelCamMap) { delete[] stitch->validPixelCamMap; stitch->validPixelCamMap = nullptr; }
-			if (stitch->camIndexTmpBuf) { delete[] stitch->camIndexTmpBuf; stitch->camIndexTmpBuf = nullptr; }
-			if (stitch->camIndexBuf) { delete[] stitch->camIndexBuf; stitch->camIndexBuf = nullptr; }
+		if (stitch->table_owner) {
+			// share remap table of the table owner
+			ERROR_CHECK_STATUS_(CheckSharedTableConfiguration(stitch));
+			ERROR_CHECK_STATUS_(vxRetainReference((vx_reference)stitch->table_owner->camera_remap));
+			stitch->camera_remap = stitch->table_owner->camera_remap;
+		}
+		else {
+			// create remap table object
+			ERROR_CHECK_OBJECT_(stitch->camera_remap = vxCreateRemap(stitch->context, stitch->camera_rgb_buffer_width, stitch->camera_rgb_buffer_height, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height));
+			// initialize remap using lens model
+			ERROR_CHECK_STATUS_(AllocateLensModelBuffersForCamera(stitch));
+			ERROR_CHECK_STATUS_(InitializeInternalTablesForRemap(stitch, stitch->camera_remap,
+				stitch->num_cameras, stitch->num_camera_columns,
+				stitch->camera_buffer_width / stitch->num_camera_columns,
+				stitch->camera_buffer_height / stitch->num_camera_rows,
+				stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height,
+				&stitch->rig_par, stitch->camera_par, stitch->camSrcMap, stitch->validPixelCamMap,
+				stitch->camIndexTmpBuf, stitch->camIndexBuf));
+			if (!stitch->feature_enable_reinitialize) {
+				if (stitch->camSrcMap) { HostMemoryFree(&stitch->host_memory, stitch->camSrcMap); stitch->camSrcMap = nullptr; }
+				if (stitch->validPixelCamMap) { HostMemoryFree(&stitch->host_memory, stitch->validPixelCamMap); stitch->validPixelCamMap = nullptr; }
+				if (stitch->camIndexTmpBuf) { HostMemoryFree(&stitch->host_memory, stitch->camIndexTmpBuf); stitch->camIndexTmpBuf = nullptr; }
+				if (stitch->camIndexBuf) { HostMemoryFree(&stitch->host_memory, stitch->camIndexBuf); stitch->camIndexBuf = nullptr; }
+			}
 		}
 
 		////////////////////////////////////////////////////////////////////////
@@ -2596,6 +3796,17 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 			stitch->SEAM_FLAGS = (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_SEAM_FLAGS];
 			stitch->scene_threshold_value = (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_SEAM_THRESHOLD];
 			stitch->SEAM_FIND_TARGET = 0;
+			if (!stitch->SEAM_REFRESH) {
+				// event driven seam refresh needs scene change detection
+				stitch->live_stitch_attr[LIVE_STITCH_ATTR_SEAM_SCHEDULE] = 0.0f;
+			}
+			stitch->SEAM_SCHEDULE = (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_SEAM_SCHEDULE];
+			stitch->seam_budget_value = (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_SEAM_BUDGET];
+			stitch->SEAM_COARSE_SCALE = (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_SEAM_COARSE_SCALE];
+			if (stitch->SEAM_COARSE_SCALE > 16) {
+				// general protection
+				stitch->SEAM_COARSE_SCALE = 16;
+			}
 			stitch->MULTIBAND_BLEND = (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_MULTIBAND];
 			stitch->num_bands = (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_MULTIBAND_NUMBANDS];
 			if (stitch->num_bands < 2) {
@@ -2639,10 +3850,28 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 					ls_printf("WARNING: SeamFind has been disabled using environment variable: LOOM_SEAM_FIND_DISABLE=1\n");
 				}
 			}
+			// multiband blend pyramids and seam paths wrap around the left and right edges of equirectangular output:
+			// cubemap faces have other neighbors, so filters and paths would run across unrelated face edges
+			if (stitch->OUTPUT_PROJECTION != output_projection_equirectangular && (stitch->MULTIBAND_BLEND || stitch->SEAM_FIND)) {
+				ls_printf("ERROR: lsInitialize: multiband blend and seamfind are only supported with equirectangular output\n");
+				return VX_ERROR_NOT_SUPPORTED;
+			}
+			// fused warp merge: only without multiband blend and with per camera exposure comp gains
+			stitch->FUSED_WARP_MERGE = (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_FUSED_WARP_MERGE];
+			if (stitch->FUSED_WARP_MERGE && (stitch->MULTIBAND_BLEND || stitch->EXPO_COMP > 2)) {
+				stitch->FUSED_WARP_MERGE = 0;
+				ls_printf("WARNING: fused warp merge is not supported with multiband blend or exposure comp gain images: using separate warp and merge\n");
+			}
 			// quick setup files load
 			stitch->SETUP_LOAD = (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_SAVE_AND_LOAD_INIT];
 			stitch->SETUP_LOAD_FILES_FOUND = vx_false_e;
-			if (stitch->MULTIBAND_BLEND || stitch->EXPO_COMP){ stitch->SETUP_LOAD = 0; }
+			// packed intermediates: not with fused warp merge, which has no warp output, or reinitialize, which changes camera planes
+			stitch->PACKED_INTERMEDIATES = (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_PACKED_INTERMEDIATES];
+			if (stitch->PACKED_INTERMEDIATES && (stitch->FUSED_WARP_MERGE || stitch->feature_enable_reinitialize)) {
+				stitch->PACKED_INTERMEDIATES = 0;
+				ls_printf("WARNING: packed intermediates are not supported with fused warp merge or reinitialize: using full camera planes\n");
+			}
+			if (stitch->MULTIBAND_BLEND || stitch->EXPO_COMP || stitch->FUSED_WARP_MERGE || stitch->PACKED_INTERMEDIATES){ stitch->SETUP_LOAD = 0; }
 			if (stitch->SETUP_LOAD){ 	
 				vx_status status = quickSetupFilesLookup(stitch);
 				if (status != VX_SUCCESS) {
@@ -2652,6 +3881,13 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 			}
 		}
 
+		if (stitch->table_owner) {
+			// tables come from the table owner instead of quick setup files
+			ERROR_CHECK_STATUS_(CheckSharedTableConfiguration(stitch));
+			stitch->SETUP_LOAD = 0;
+			stitch->SETUP_LOAD_FILES_FOUND = vx_false_e;
+		}
+
 		// allocate internal tables
 		vx_status status = AllocateInternalTablesForCamera(stitch);
 		if (status != VX_SUCCESS)
@@ -2660,24 +3896,73 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 		////////////////////////////////////////////////////////////////////////
 		// create and verify graphStitch using low-level kernels
 		////////////////////////////////////////////////////////////////////////
-		// warping
-		ERROR_CHECK_OBJECT_(stitch->WarpNode = stitchWarpNode(stitch->graphStitch, 1, stitch->num_cameras, stitch->ValidPixelEntry, stitch->WarpRemapEntry, stitch->rgb_input, stitch->RGBY1, stitch->warp_luma_image, stitch->num_camera_columns));
+		// warping: with fused warp merge, warp output is only needed by exposure comp error function and seamfind
+		if (stitch->RGBY1) {
+			ERROR_CHECK_OBJECT_(stitch->WarpNode = stitchWarpNode(stitch->graphStitch, 1, stitch->num_cameras, stitch->ValidPixelEntry, stitch->WarpRemapEntry, stitch->rgb_input, stitch->RGBY1, stitch->warp_luma_image, stitch->num_camera_columns));
+			if (stitch->camera_plane_array) {
+				vx_uint8 flags = STITCH_WARP_FLAG_PACKED_OUTPUT;
+				vx_scalar s_flags = vxCreateScalar(stitch->context, VX_TYPE_UINT8, &flags);
+				ERROR_CHECK_OBJECT_(s_flags);
+				ERROR_CHECK_STATUS_(vxSetParameterByIndex(stitch->WarpNode, 9, (vx_reference)s_flags));
+				ERROR_CHECK_STATUS_(vxReleaseScalar(&s_flags));
+			}
+		}
 
 		// exposure comp
 		vx_image merge_input = stitch->RGBY1;
 		vx_image merge_weight = stitch->weight_image;
 		if (stitch->EXPO_COMP) {
+			vx_matrix error_matrix = stitch->A_matrix;
+			vx_graph solve_graph = stitch->graphStitch;
+			if (stitch->EXPO_COMP <= 2) {
+				// temporal solve: gains are solved every expCompSolveInterval frames from the error function of the
+				// last expCompSolveWindow frames in a separate graph, so that other frames skip the CPU solve node
+				// and its transfers (see UpdateExposureCompSolve)
+				stitch->expCompSolveInterval = std::min(std::max((vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_EXPCOMP_SOLVE_INTERVAL], 1u), 32u);
+				stitch->expCompSolveWindow = std::min(std::max((vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_EXPCOMP_SOLVE_WINDOW], 1u), 32u);
+				stitch->expCompGainSmoothing = std::min(std::max(stitch->live_stitch_attr[LIVE_STITCH_ATTR_EXPCOMP_GAIN_SMOOTHING], 0.0f), 1.0f);
+				if (stitch->expCompSolveInterval > 1 || stitch->expCompSolveWindow > 1) {
+					ERROR_CHECK_OBJECT_(stitch->graphExpCompSolve = vxCreateGraph(stitch->context));
+					solve_graph = stitch->graphExpCompSolve;
+					if (stitch->expCompSolveWindow > 1) {
+						// each frame accumulates into slot 0 and A_matrix gets the sum of all slots before a solve
+						ERROR_CHECK_OBJECT_(stitch->expCompMatrixDelay = vxCreateDelay(stitch->context, (vx_reference)stitch->A_matrix, stitch->expCompSolveWindow));
+						error_matrix = (vx_matrix)vxGetReferenceFromDelay(stitch->expCompMatrixDelay, 0);
+					}
+					ERROR_CHECK_STATUS_(vxQueryArray(stitch->gain_array, VX_ARRAY_NUMITEMS, &stitch->expCompGainCount, sizeof(stitch->expCompGainCount)));
+					ERROR_CHECK_ALLOC_(stitch->expCompSolvedGains = new vx_float32[stitch->expCompGainCount]);
+					ERROR_CHECK_ALLOC_(stitch->expCompGains = new vx_float32[stitch->expCompGainCount]);
+					for (vx_size i = 0; i < stitch->expCompGainCount; i++)
+						stitch->expCompSolvedGains[i] = stitch->expCompGains[i] = 1.0f;
+				}
+			}
 			if (stitch->EXPO_COMP == 1) {
-				ERROR_CHECK_OBJECT_(stitch->ExpcompComputeGainNode = stitchExposureCompCalcErrorFnNode(stitch->graphStitch, stitch->num_cameras, stitch->RGBY1, stitch->OverlapPixelEntry, stitch->valid_mask_image, stitch->A_matrix));
-				ERROR_CHECK_OBJECT_(stitch->ExpcompSolveGainNode = stitchExposureCompSolveForGainNode(stitch->graphStitch, stitch->alpha, stitch->beta, stitch->A_matrix, stitch->overlap_matrix, stitch->gain_array));
+				ERROR_CHECK_OBJECT_(stitch->ExpcompComputeGainNode = stitchExposureCompCalcErrorFnNode(stitch->graphStitch, stitch->num_cameras, stitch->RGBY1, stitch->OverlapPixelEntry, stitch->valid_mask_image, error_matrix));
+				ERROR_CHECK_OBJECT_(stitch->ExpcompSolveGainNode = stitchExposureCompSolveForGainNode(solve_graph, stitch->alpha, stitch->beta, stitch->A_matrix, stitch->overlap_matrix, stitch->gain_array, stitch->expCompSolveWindow));
 			}
 			else if (stitch->EXPO_COMP == 2) {
-				ERROR_CHECK_OBJECT_(stitch->ExpcompComputeGainNode = stitchExposureCompCalcErrorFnRGBNode(stitch->graphStitch, stitch->num_cameras, stitch->RGBY1, stitch->OverlapPixelEntry, stitch->valid_mask_image, stitch->A_matrix));
-				ERROR_CHECK_OBJECT_(stitch->ExpcompSolveGainNode = stitchExposureCompSolveForGainNode(stitch->graphStitch, stitch->alpha, stitch->beta, stitch->A_matrix, stitch->overlap_matrix, stitch->gain_array));
+				ERROR_CHECK_OBJECT_(stitch->ExpcompComputeGainNode = stitchExposureCompCalcErrorFnRGBNode(stitch->graphStitch, stitch->num_cameras, stitch->RGBY1, stitch->OverlapPixelEntry, stitch->valid_mask_image, error_matrix));
+				ERROR_CHECK_OBJECT_(stitch->ExpcompSolveGainNode = stitchExposureCompSolveForGainNode(solve_graph, stitch->alpha, stitch->beta, stitch->A_matrix, stitch->overlap_matrix, stitch->gain_array, stitch->expCompSolveWindow));
+			}
+			if (stitch->ExpcompComputeGainNode && stitch->camera_plane_array) {
+				ERROR_CHECK_STATUS_(vxSetParameterByIndex(stitch->ExpcompComputeGainNode, 5, (vx_reference)stitch->camera_plane_array));
+			}
+			if (stitch->graphExpCompSolve) {
+				ERROR_CHECK_STATUS_(vxVerifyGraph(stitch->graphExpCompSolve));
+			}
+			if (!stitch->FUSED_WARP_MERGE) {
+				ERROR_CHECK_OBJECT_(stitch->ExpcompApplyGainNode = stitchExposureCompApplyGainNode(stitch->graphStitch, stitch->RGBY1, stitch->gain_array, stitch->valid_array, stitch->num_cameras, stitch->EXPO_COMP_GAINW, stitch->EXPO_COMP_GAINH, stitch->RGBY2));
+				if (stitch->camera_plane_array) {
+					// valid pixel entries and gain images use output locations: camera planes and output height give packed locations
+					vx_scalar eqr_height;
+					ERROR_CHECK_OBJECT_(eqr_height = vxCreateScalar(stitch->context, VX_TYPE_UINT32, &stitch->output_rgb_buffer_height));
+					ERROR_CHECK_STATUS_(vxSetParameterByIndex(stitch->ExpcompApplyGainNode, 7, (vx_reference)stitch->camera_plane_array));
+					ERROR_CHECK_STATUS_(vxSetParameterByIndex(stitch->ExpcompApplyGainNode, 8, (vx_reference)eqr_height));
+					ERROR_CHECK_STATUS_(vxReleaseScalar(&eqr_height));
+				}
+				// update merge input
+				merge_input = stitch->RGBY2;
 			}
-			ERROR_CHECK_OBJECT_(stitch->ExpcompApplyGainNode = stitchExposureCompApplyGainNode(stitch->graphStitch, stitch->RGBY1, stitch->gain_array, stitch->valid_array, stitch->num_cameras, stitch->EXPO_COMP_GAINW, stitch->EXPO_COMP_GAINH, stitch->RGBY2));
-			// update merge input
-			merge_input = stitch->RGBY2;
 		}
 		if (stitch->SEAM_FIND) {
 			if (stitch->SEAM_REFRESH)
@@ -2686,6 +3971,13 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 				stitch->SeamfindStep1Node = stitchSeamFindSceneDetectNode(stitch->graphStitch, stitch->current_frame, stitch->scene_threshold,
 					stitch->warp_luma_image, stitch->seamfind_info_array, stitch->seamfind_pref_array, stitch->seamfind_scene_array);
 				ERROR_CHECK_OBJECT_(stitch->SeamfindStep1Node);
+				if (stitch->camera_plane_array) {
+					ERROR_CHECK_STATUS_(vxSetParameterByIndex(stitch->SeamfindStep1Node, 6, (vx_reference)stitch->camera_plane_array));
+				}
+			}
+			//SeamFind Analyze: schedule overlaps with scene change events within seam budget
+			if (stitch->SEAM_SCHEDULE) {
+				ERROR_CHECK_OBJECT_(stitch->SeamfindAnalyzeNode = stitchSeamFindAnalyzeNode(stitch->graphStitch, stitch->current_frame, stitch->seamfind_pref_array, stitch->seam_cost_enable, stitch->seam_budget));
 			}
 			//SeamFind Step 2 - Cost Generation: 0:OpenVX Sobel 1:Optimized Sobel
 			if (!stitch->SEAM_COST_SELECT) {
@@ -2698,22 +3990,33 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 				ERROR_CHECK_STATUS_(vxReleaseScalar(&shift));
 			}
 			else {
-				ERROR_CHECK_OBJECT_(stitch->SeamfindAnalyzeNode = stitchSeamFindAnalyzeNode(stitch->graphStitch, stitch->current_frame, stitch->seamfind_pref_array, stitch->seam_cost_enable));
+				if (!stitch->SeamfindAnalyzeNode) {
+					ERROR_CHECK_OBJECT_(stitch->SeamfindAnalyzeNode = stitchSeamFindAnalyzeNode(stitch->graphStitch, stitch->current_frame, stitch->seamfind_pref_array, stitch->seam_cost_enable, nullptr));
+				}
 				ERROR_CHECK_OBJECT_(stitch->SeamfindStep2Node = stitchSeamFindCostGenerateNode(stitch->graphStitch, stitch->seam_cost_enable, stitch->warp_luma_image, stitch->sobel_magnitude_image, stitch->sobel_phase_image));
 			}
 			//SeamFind Step 3 - Cost Accumulate
 			stitch->SeamfindStep3Node = stitchSeamFindCostAccumulateNode(stitch->graphStitch, stitch->current_frame, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height,
 				stitch->sobel_magnitude_image, stitch->sobel_phase_image, stitch->valid_mask_image, stitch->seamfind_valid_array, stitch->seamfind_pref_array,
-				stitch->seamfind_info_array, stitch->seamfind_accum_array);
+				stitch->seamfind_info_array, stitch->seamfind_accum_array, stitch->SEAM_COARSE_SCALE);
 			ERROR_CHECK_OBJECT_(stitch->SeamfindStep3Node);
+			if (stitch->camera_plane_array) {
+				ERROR_CHECK_STATUS_(vxSetParameterByIndex(stitch->SeamfindStep3Node, 11, (vx_reference)stitch->camera_plane_array));
+			}
 			//SeamFind Step 4 - Path Trace
 			stitch->SeamfindStep4Node = stitchSeamFindPathTraceNode(stitch->graphStitch, stitch->current_frame, stitch->weight_image, stitch->seamfind_info_array, 
 				stitch->seamfind_accum_array, stitch->seamfind_pref_array, stitch->seamfind_path_array);
 			ERROR_CHECK_OBJECT_(stitch->SeamfindStep4Node);
+			if (stitch->camera_plane_array) {
+				ERROR_CHECK_STATUS_(vxSetParameterByIndex(stitch->SeamfindStep4Node, 6, (vx_reference)stitch->camera_plane_array));
+			}
 			//SeamFind Step 5 - Set Weights
 			stitch->SeamfindStep5Node = stitchSeamFindSetWeightsNode(stitch->graphStitch, stitch->current_frame, stitch->num_cameras, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height,
 				stitch->seamfind_weight_array, stitch->seamfind_path_array, stitch->seamfind_pref_array, stitch->seamfind_weight_image, stitch->SEAM_FLAGS);
 			ERROR_CHECK_OBJECT_(stitch->SeamfindStep5Node);
+			if (stitch->camera_plane_array) {
+				ERROR_CHECK_STATUS_(vxSetParameterByIndex(stitch->SeamfindStep5Node, 9, (vx_reference)stitch->camera_plane_array));
+			}
 			// update merge weight image
 			merge_weight = stitch->seamfind_weight_image;
 		}
@@ -2721,10 +4024,10 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 		if (stitch->MULTIBAND_BLEND){
 			// create Laplacian pyramids.
 			for (int i = 1; i < stitch->num_bands; i++) {
-				stitch->pStitchMultiband[i].WeightHSGNode = stitchMultiBandHalfScaleGaussianNode(stitch->graphStitch, stitch->num_cameras, stitch->pStitchMultiband[i].valid_array_offset,
+				stitch->pStitchMultiband[i].WeightHSGNode = stitchMultiBandHalfScaleGaussianNode(stitch->graphStitch, stitch->num_cameras, stitch->pStitchMultiband[i].gaussian_array_offset,
 					stitch->blend_offsets, stitch->pStitchMultiband[i - 1].WeightPyrImgGaussian, stitch->pStitchMultiband[i].WeightPyrImgGaussian);
 				ERROR_CHECK_OBJECT_(stitch->pStitchMultiband[i].WeightHSGNode);
-				stitch->pStitchMultiband[i].SourceHSGNode = stitchMultiBandHalfScaleGaussianNode(stitch->graphStitch, stitch->num_cameras, stitch->pStitchMultiband[i].valid_array_offset,
+				stitch->pStitchMultiband[i].SourceHSGNode = stitchMultiBandHalfScaleGaussianNode(stitch->graphStitch, stitch->num_cameras, stitch->pStitchMultiband[i].gaussian_array_offset,
 					stitch->blend_offsets, stitch->pStitchMultiband[i - 1].DstPyrImgGaussian, stitch->pStitchMultiband[i].DstPyrImgGaussian);
 				ERROR_CHECK_OBJECT_(stitch->pStitchMultiband[i].SourceHSGNode);
 				stitch->pStitchMultiband[i - 1].UpscaleSubtractNode = stitchMultiBandUpscaleGaussianSubtractNode(stitch->graphStitch, stitch->num_cameras, stitch->pStitchMultiband[i - 1].valid_array_offset,
@@ -2751,8 +4054,21 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 			merge_weight = stitch->blend_mask_image;
 		}
 		// merge node
-		ERROR_CHECK_OBJECT_(stitch->MergeNode = stitchMergeNode(stitch->graphStitch,
-			stitch->cam_id_image, stitch->group1_image, stitch->group2_image, merge_input, merge_weight, stitch->rgb_output));
+		if (stitch->FUSED_WARP_MERGE) {
+			// warp, apply gains and merge directly from camera input
+			ERROR_CHECK_OBJECT_(stitch->WarpMergeNode = stitchWarpMergeNode(stitch->graphStitch, stitch->num_cameras, stitch->ValidPixelEntry, stitch->WarpRemapEntry,
+				stitch->warp_merge_index_image, stitch->rgb_input, merge_weight, stitch->rgb_output, stitch->EXPO_COMP ? stitch->gain_array : nullptr, stitch->num_camera_columns));
+		}
+		else {
+			ERROR_CHECK_OBJECT_(stitch->MergeNode = stitchMergeNode(stitch->graphStitch,
+				stitch->cam_id_image, stitch->group1_image, stitch->group2_image, merge_input, merge_weight, stitch->rgb_output));
+			if (stitch->camera_plane_array) {
+				ERROR_CHECK_STATUS_(vxSetParameterByIndex(stitch->MergeNode, 6, (vx_reference)stitch->camera_plane_array));
+			}
+			if (stitch->merge_overflow_array) {
+				ERROR_CHECK_STATUS_(vxSetParameterByIndex(stitch->MergeNode, 7, (vx_reference)stitch->merge_overflow_array));
+			}
+		}
 
 		// verify the graph
 		ERROR_CHECK_STATUS_(vxVerifyGraph(stitch->graphStitch));
@@ -2768,6 +4084,17 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 
 	// mark that initialization is successful
 	stitch->initialized = true;
+	if (stitch->table_owner) {
+		// shared tables are reference counted from now on
+		stitch->table_owner->tables_shared = true;
+		stitch->tables_shared = true;
+		stitch->table_owner = nullptr;
+	}
+
+	// per stage performance statistics
+	if (stitch->live_stitch_attr[LIVE_STITCH_ATTR_PROFILER] && !stitch->perf) {
+		ERROR_CHECK_STATUS_(InitializePerformanceData(stitch));
+	}
 
 	// debug: dump auxiliary data
 	if (stitch->loomioCameraAuxData || stitch->loomioOverlayAuxData || stitch->loomioOutputAuxData || stitch->loomioViewingAuxData) {
@@ -2822,17 +4149,16 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsReinitialize(ls_context stitch)
 			ERROR_CHECK_STATUS_(InitializeInternalTablesForCamera(stitch));
 		}
 		ERROR_CHECK_STATUS_(SyncInternalTables(stitch));
+		if (stitch->fullValidPixelTable) {
+			// tables for full output have changed: pick active output regions again
+			ReleaseActiveRegionTables(stitch);
+			ERROR_CHECK_STATUS_(ApplyActiveOutputRegions(stitch));
+		}
 	}
 	if (stitch->rig_params_updated || stitch->overlay_params_updated) {
 		// re-initialize tables for overlay
-		if (stitch->overlay_remap) {
-			ERROR_CHECK_STATUS_(InitializeInternalTablesForRemap(stitch, stitch->overlay_remap,
-				stitch->num_overlays, stitch->num_overlay_columns,
-				stitch->overlay_buffer_width / stitch->num_overlay_columns,
-				stitch->overlay_buffer_height / stitch->num_overlay_rows,
-				stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height,
-				&stitch->rig_par, stitch->overlay_par, stitch->overlaySrcMap, stitch->validPixelOverlayMap,
-				stitch->overlayIndexTmpBuf, stitch->overlayIndexBuf));
+		if (stitch->overlay_remap || stitch->OverlayValidPixelEntry) {
+			ERROR_CHECK_STATUS_(InitializeInternalTablesForOverlay(stitch));
 			ERROR_CHECK_STATUS_(SyncInternalTables(stitch));
 		}	
 	}
@@ -2866,6 +4192,7 @@ SHARED_PUBLIC vx_status VX_API_CALL lsReleaseContext(ls_context * pStitch)
 		// release configurations
 		if (stitch->camera_par) delete[] stitch->camera_par;
 		if (stitch->overlay_par) delete[] stitch->overlay_par;
+		if (stitch->perf) delete stitch->perf;
 
 		// release image objects
 		if (stitch->Img_input) ERROR_CHECK_STATUS_(vxReleaseImage(&stitch->Img_input));
@@ -2878,9 +4205,12 @@ SHARED_PUBLIC vx_status VX_API_CALL lsReleaseContext(ls_context * pStitch)
 		if (stitch->RGBY1) ERROR_CHECK_STATUS_(vxReleaseImage(&stitch->RGBY1));
 		if (stitch->RGBY2) ERROR_CHECK_STATUS_(vxReleaseImage(&stitch->RGBY2));
 		if (stitch->weight_image) ERROR_CHECK_STATUS_(vxReleaseImage(&stitch->weight_image));
+		if (stitch->camera_plane_array) ERROR_CHECK_STATUS_(vxReleaseArray(&stitch->camera_plane_array));
 		if (stitch->cam_id_image) ERROR_CHECK_STATUS_(vxReleaseImage(&stitch->cam_id_image));
+		if (stitch->warp_merge_index_image) ERROR_CHECK_STATUS_(vxReleaseImage(&stitch->warp_merge_index_image));
 		if (stitch->group1_image) ERROR_CHECK_STATUS_(vxReleaseImage(&stitch->group1_image));
 		if (stitch->group2_image) ERROR_CHECK_STATUS_(vxReleaseImage(&stitch->group2_image));
+		if (stitch->merge_overflow_array) ERROR_CHECK_STATUS_(vxReleaseArray(&stitch->merge_overflow_array));
 		if (stitch->valid_mask_image) ERROR_CHECK_STATUS_(vxReleaseImage(&stitch->valid_mask_image));
 		if (stitch->warp_luma_image) ERROR_CHECK_STATUS_(vxReleaseImage(&stitch->warp_luma_image));
 		if (stitch->sobel_magnitude_s16_image) ERROR_CHECK_STATUS_(vxReleaseImage(&stitch->sobel_magnitude_s16_image));
@@ -2900,18 +4230,25 @@ SHARED_PUBLIC vx_status VX_API_CALL lsReleaseContext(ls_context * pStitch)
 
 		// release scalar objects
 		if (stitch->current_frame) ERROR_CHECK_STATUS_(vxReleaseScalar(&stitch->current_frame));
+		if (stitch->seam_budget) ERROR_CHECK_STATUS_(vxReleaseScalar(&stitch->seam_budget));
 		if (stitch->scene_threshold) ERROR_CHECK_STATUS_(vxReleaseScalar(&stitch->scene_threshold));
 		if (stitch->seam_cost_enable) ERROR_CHECK_STATUS_(vxReleaseScalar(&stitch->seam_cost_enable));
 		if (stitch->filterLambda) ERROR_CHECK_STATUS_(vxReleaseScalar(&stitch->filterLambda));
 
 		// release remap objects
 		if (stitch->overlay_remap) ERROR_CHECK_STATUS_(vxReleaseRemap(&stitch->overlay_remap));
+		if (stitch->OverlayValidPixelEntry) ERROR_CHECK_STATUS_(vxReleaseArray(&stitch->OverlayValidPixelEntry));
+		if (stitch->OverlayWarpRemapEntry) ERROR_CHECK_STATUS_(vxReleaseArray(&stitch->OverlayWarpRemapEntry));
 		if (stitch->camera_remap) ERROR_CHECK_STATUS_(vxReleaseRemap(&stitch->camera_remap));
 
 		// release matrix
 		if (stitch->overlap_matrix) ERROR_CHECK_STATUS_(vxReleaseMatrix(&stitch->overlap_matrix));
 		if (stitch->A_matrix) ERROR_CHECK_STATUS_(vxReleaseMatrix(&stitch->A_matrix));
 		if (stitch->A_matrix_initial_value) delete[] stitch->A_matrix_initial_value;
+		if (stitch->expCompActiveMatrix) delete[] stitch->expCompActiveMatrix;
+		if (stitch->expCompMatrixDelay) ERROR_CHECK_STATUS_(vxReleaseDelay(&stitch->expCompMatrixDelay));
+		if (stitch->expCompSolvedGains) delete[] stitch->expCompSolvedGains;
+		if (stitch->expCompGains) delete[] stitch->expCompGains;
 
 		// release arrays
 		if (stitch->ValidPixelEntry) ERROR_CHECK_STATUS_(vxReleaseArray(&stitch->ValidPixelEntry));
@@ -2941,6 +4278,7 @@ SHARED_PUBLIC vx_status VX_API_CALL lsReleaseContext(ls_context * pStitch)
 		if (stitch->ExpcompSolveGainNode) ERROR_CHECK_STATUS_(vxReleaseNode(&stitch->ExpcompSolveGainNode));
 		if (stitch->ExpcompApplyGainNode) ERROR_CHECK_STATUS_(vxReleaseNode(&stitch->ExpcompApplyGainNode));
 		if (stitch->MergeNode) ERROR_CHECK_STATUS_(vxReleaseNode(&stitch->MergeNode));
+		if (stitch->WarpMergeNode) ERROR_CHECK_STATUS_(vxReleaseNode(&stitch->WarpMergeNode));
 		if (stitch->SobelNode) ERROR_CHECK_STATUS_(vxReleaseNode(&stitch->SobelNode));
 		if (stitch->MagnitudeNode) ERROR_CHECK_STATUS_(vxReleaseNode(&stitch->MagnitudeNode));
 		if (stitch->PhaseNode) ERROR_CHECK_STATUS_(vxReleaseNode(&stitch->PhaseNode));
@@ -2972,6 +4310,7 @@ SHARED_PUBLIC vx_status VX_API_CALL lsReleaseContext(ls_context * pStitch)
 			delete[] stitch->pStitchMultiband;
 			delete[] stitch->multibandBlendOffsetIntoBuffer;
 		}
+		if (stitch->seamfindPrefInitial) delete[] stitch->seamfindPrefInitial;
 
 		// release LoomIO objects
 		if (stitch->cameraMediaConfig) ERROR_CHECK_STATUS_(vxReleaseScalar(&stitch->cameraMediaConfig));
@@ -2997,6 +4336,14 @@ SHARED_PUBLIC vx_status VX_API_CALL lsReleaseContext(ls_context * pStitch)
 			}
 		}
 
+		// release output rendition elements
+		for (vx_uint32 i = 1; i < stitch->num_output_renditions; i++){
+			if (stitch->rendition_scale_nodes[i]) ERROR_CHECK_STATUS_(vxReleaseNode(&stitch->rendition_scale_nodes[i]));
+			if (stitch->rendition_convert_nodes[i]) ERROR_CHECK_STATUS_(vxReleaseNode(&stitch->rendition_convert_nodes[i]));
+			if (stitch->rendition_rgb[i]) ERROR_CHECK_STATUS_(vxReleaseImage(&stitch->rendition_rgb[i]));
+			if (stitch->rendition_output[i]) ERROR_CHECK_STATUS_(vxReleaseImage(&stitch->rendition_output[i]));
+		}
+
 		// release fast GPU initialize elements
 		if (!stitch->USE_CPU_INIT){
 			if (stitch->stitchInitData){
@@ -3016,17 +4363,18 @@ SHARED_PUBLIC vx_status VX_API_CALL lsReleaseContext(ls_context * pStitch)
 		}
 
 		// release internal buffers
-		if (stitch->validPixelCamMap) { delete[] stitch->validPixelCamMap; stitch->validPixelCamMap = nullptr; }
-		if (stitch->paddedPixelCamMap) { delete[] stitch->paddedPixelCamMap; stitch->paddedPixelCamMap = nullptr; }
-		if (stitch->camSrcMap) { delete[] stitch->camSrcMap; stitch->camSrcMap = nullptr; }
+		if (stitch->validPixelCamMap) { HostMemoryFree(&stitch->host_memory, stitch->validPixelCamMap); stitch->validPixelCamMap = nullptr; }
+		if (stitch->paddedPixelCamMap) { HostMemoryFree(&stitch->host_memory, stitch->paddedPixelCamMap); stitch->paddedPixelCamMap = nullptr; }
+		if (stitch->camSrcMap) { HostMemoryFree(&stitch->host_memory, stitch->camSrcMap); stitch->camSrcMap = nullptr; }
 		if (stitch->overlapRectBuf) { delete[] stitch->overlapRectBuf; stitch->overlapRectBuf = nullptr; }
-		if (stitch->camIndexTmpBuf) { delete[] stitch->camIndexTmpBuf; stitch->camIndexTmpBuf = nullptr; }
-		if (stitch->camIndexBuf) { delete[] stitch->camIndexBuf; stitch->camIndexBuf = nullptr; }
+		if (stitch->camIndexTmpBuf) { HostMemoryFree(&stitch->host_memory, stitch->camIndexTmpBuf); stitch->camIndexTmpBuf = nullptr; }
+		if (stitch->camIndexBuf) { HostMemoryFree(&stitch->host_memory, stitch->camIndexBuf); stitch->camIndexBuf = nullptr; }
 		if (stitch->overlapMatrixBuf) { delete[] stitch->overlapMatrixBuf; stitch->overlapMatrixBuf = nullptr; }
-		if (stitch->overlaySrcMap) { delete[] stitch->overlaySrcMap; stitch->overlaySrcMap = nullptr; }
-		if (stitch->validPixelOverlayMap) { delete[] stitch->validPixelOverlayMap; stitch->validPixelOverlayMap = nullptr; }
-		if (stitch->overlayIndexTmpBuf) { delete[] stitch->overlayIndexTmpBuf; stitch->overlayIndexTmpBuf = nullptr; }
-		if (stitch->overlayIndexBuf) { delete[] stitch->overlayIndexBuf; stitch->overlayIndexBuf = nullptr; }
+		if (stitch->overlaySrcMap) { HostMemoryFree(&stitch->host_memory, stitch->overlaySrcMap); stitch->overlaySrcMap = nullptr; }
+		if (stitch->validPixelOverlayMap) { HostMemoryFree(&stitch->host_memory, stitch->validPixelOverlayMap); stitch->validPixelOverlayMap = nullptr; }
+		if (stitch->overlayIndexTmpBuf) { HostMemoryFree(&stitch->host_memory, stitch->overlayIndexTmpBuf); stitch->overlayIndexTmpBuf = nullptr; }
+		if (stitch->overlayIndexBuf) { HostMemoryFree(&stitch->host_memory, stitch->overlayIndexBuf); stitch->overlayIndexBuf = nullptr; }
+		ReleaseActiveRegionTables(stitch);
 
 		// debug aux dumps
 		if (stitch->loomioAuxDumpFile) {
@@ -3038,6 +4386,7 @@ SHARED_PUBLIC vx_status VX_API_CALL lsReleaseContext(ls_context * pStitch)
 
 		//Graph & Context
 		if (stitch->graphStitch) ERROR_CHECK_STATUS_(vxReleaseGraph(&stitch->graphStitch));
+		if (stitch->graphExpCompSolve) ERROR_CHECK_STATUS_(vxReleaseGraph(&stitch->graphExpCompSolve));
 		if (stitch->context && !stitch->context_is_external) ERROR_CHECK_STATUS_(vxReleaseContext(&stitch->context));
 
 		delete stitch;
@@ -3057,8 +4406,9 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetCameraBuffer(ls_context stitch,
 {
 	PROFILER_START(LoomSL, SetInputBuffer);
 	ERROR_CHECK_STATUS_(IsValidContextAndInitialized(stitch));
-	// check to make sure that LoomIO for camera is not active
+	// check to make sure that LoomIO for camera is not active and images use OpenCL buffers
 	if (stitch->nodeLoomIoCamera) return VX_ERROR_NOT_ALLOCATED;
+	if (stitch->HOST_EXECUTION) return VX_ERROR_NOT_SUPPORTED;
 
 	// switch the user specified OpenCL buffer into image
 	if (stitch->camera_buffer_format == VX_DF_IMAGE_NV12) {
@@ -3076,8 +4426,9 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetOutputBuffer(ls_context stitch,
 {
 	PROFILER_START(LoomSL, SetOutputBuffer);
 	ERROR_CHECK_STATUS_(IsValidContextAndInitialized(stitch));
-	// check to make sure that LoomIO for output is not active
+	// check to make sure that LoomIO for output is not active and images use OpenCL buffers
 	if (stitch->nodeLoomIoOutput) return VX_ERROR_NOT_ALLOCATED;
+	if (stitch->HOST_EXECUTION) return VX_ERROR_NOT_SUPPORTED;
 
 	// switch the user specified OpenCL buffer into image
 	if (stitch->output_buffer_format == VX_DF_IMAGE_NV12) {
@@ -3099,6 +4450,37 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetOutputBuffer(ls_context stitch,
 	PROFILER_STOP(LoomSL, SetOutputBuffer);
 	return VX_SUCCESS;
 }
+
+//! \brief Set host memory buffers (LIVE_STITCH_ATTR_HOST_EXECUTION)
+//     input_buffer   - input buffer with images from all cameras
+//     output_buffer  - output buffer for output equirectangular image
+//   Use of nullptr will return the control of previously set buffer
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetCameraBufferHost(ls_context stitch, void ** input_buffer)
+{
+	PROFILER_START(LoomSL, SetInputBuffer);
+	ERROR_CHECK_STATUS_(IsValidContextAndInitialized(stitch));
+	if (!stitch->HOST_EXECUTION) return VX_ERROR_NOT_SUPPORTED;
+
+	// switch the user specified host buffer into image
+	vx_uint32 num_planes = (stitch->camera_buffer_format == VX_DF_IMAGE_NV12) ? 2 : 1;
+	void * ptr_in[] = { input_buffer ? input_buffer[0] : nullptr, (input_buffer && num_planes > 1) ? input_buffer[1] : nullptr };
+	ERROR_CHECK_STATUS_(vxSwapImageHandle(stitch->Img_input, ptr_in, nullptr, num_planes));
+	PROFILER_STOP(LoomSL, SetInputBuffer);
+	return VX_SUCCESS;
+}
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetOutputBufferHost(ls_context stitch, void ** output_buffer)
+{
+	PROFILER_START(LoomSL, SetOutputBuffer);
+	ERROR_CHECK_STATUS_(IsValidContextAndInitialized(stitch));
+	if (!stitch->HOST_EXECUTION) return VX_ERROR_NOT_SUPPORTED;
+
+	// switch the user specified host buffer into image: encode tiles are not supported with host execution
+	vx_uint32 num_planes = (stitch->output_buffer_format == VX_DF_IMAGE_NV12) ? 2 : 1;
+	void * ptr_out[] = { output_buffer ? output_buffer[0] : nullptr, (output_buffer && num_planes > 1) ? output_buffer[1] : nullptr };
+	ERROR_CHECK_STATUS_(vxSwapImageHandle(stitch->Img_output, ptr_out, nullptr, num_planes));
+	PROFILER_STOP(LoomSL, SetOutputBuffer);
+	return VX_SUCCESS;
+}
 LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetOverlayBuffer(ls_context stitch, cl_mem * overlay_buffer)
 {
 	ERROR_CHECK_STATUS_(IsValidContextAndInitialized(stitch));
@@ -3115,6 +4497,7 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetChromaKeyBuffer(ls_context stit
 {
 	ERROR_CHECK_STATUS_(IsValidContextAndInitialized(stitch));
 	if (!stitch->CHROMA_KEY) return VX_ERROR_NOT_ALLOCATED;
+	if (stitch->HOST_EXECUTION) return VX_ERROR_NOT_SUPPORTED;
 
 	// switch the user specified OpenCL buffer into image
 	void * ptr_chroma[] = { chromaKey_buffer ? chromaKey_buffer[0] : nullptr };
@@ -3122,6 +4505,90 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetChromaKeyBuffer(ls_context stit
 
 	return VX_SUCCESS;
 }
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetChromaKeyBufferHost(ls_context stitch, void ** chromaKey_buffer)
+{
+	ERROR_CHECK_STATUS_(IsValidContextAndInitialized(stitch));
+	if (!stitch->CHROMA_KEY) return VX_ERROR_NOT_ALLOCATED;
+	if (!stitch->HOST_EXECUTION) return VX_ERROR_NOT_SUPPORTED;
+
+	// switch the user specified host buffer into image
+	void * ptr_chroma[] = { chromaKey_buffer ? chromaKey_buffer[0] : nullptr };
+	ERROR_CHECK_STATUS_(vxSwapImageHandle(stitch->chroma_key_input_img, ptr_chroma, nullptr, 1));
+
+	return VX_SUCCESS;
+}
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetOutputRenditionBuffer(ls_context stitch, vx_uint32 rendition, cl_mem * output_buffer)
+{
+	ERROR_CHECK_STATUS_(IsValidContextAndInitialized(stitch));
+	if (rendition == 0) return lsSetOutputBuffer(stitch, output_buffer);
+	if (rendition >= stitch->num_output_renditions) return VX_ERROR_NOT_ALLOCATED;
+
+	// switch the user specified OpenCL buffer into image
+	if (stitch->output_buffer_format == VX_DF_IMAGE_NV12) {
+		void * ptr_out[] = { output_buffer ? output_buffer[0] : nullptr, output_buffer ? output_buffer[1] : nullptr };
+		ERROR_CHECK_STATUS_(vxSwapImageHandle(stitch->rendition_output[rendition], ptr_out, nullptr, 2));
+	}
+	else {
+		void * ptr_out[] = { output_buffer ? output_buffer[0] : nullptr };
+		ERROR_CHECK_STATUS_(vxSwapImageHandle(stitch->rendition_output[rendition], ptr_out, nullptr, 1));
+	}
+	return VX_SUCCESS;
+}
+
+//! \brief Exposure comp temporal solve before scheduling a frame: the previous frame has completed
+//   - solves gains with graphExpCompSolve on solve frames and steps the gain moving average
+//   - clears the error function matrix of the next frame on GPU
+static vx_status UpdateExposureCompSolve(ls_context stitch)
+{
+	vx_uint32 frame = stitch->expCompFrameCount++;
+	vx_matrix error_matrix = stitch->A_matrix;
+	stitch->expCompSolved = false;
+	if (stitch->graphExpCompSolve) {
+		// solve every expCompSolveInterval frames once the sliding window has been filled
+		if (frame >= stitch->expCompSolveWindow && (frame % stitch->expCompSolveInterval) == 0) {
+			if (stitch->expCompMatrixDelay) {
+				// sum of the window: slot 0 holds the previous frame, slot -1 the one before, ...
+				vx_size columns = 0, rows = 0;
+				ERROR_CHECK_STATUS_(vxQueryMatrix(stitch->A_matrix, VX_MATRIX_COLUMNS, &columns, sizeof(columns)));
+				ERROR_CHECK_STATUS_(vxQueryMatrix(stitch->A_matrix, VX_MATRIX_ROWS, &rows, sizeof(rows)));
+				std::vector<vx_int32> sum(columns * rows, 0), slot(columns * rows);
+				for (vx_int32 i = 0; i < (vx_int32)stitch->expCompSolveWindow; i++) {
+					ERROR_CHECK_STATUS_(vxReadMatrix((vx_matrix)vxGetReferenceFromDelay(stitch->expCompMatrixDelay, -i), slot.data()));
+					for (vx_size k = 0; k < sum.size(); k++)
+						sum[k] += slot[k];
+				}
+				ERROR_CHECK_STATUS_(vxWriteMatrix(stitch->A_matrix, sum.data()));
+			}
+			ERROR_CHECK_STATUS_(vxProcessGraph(stitch->graphExpCompSolve));
+			stitch->expCompSolved = true;
+			ERROR_CHECK_STATUS_(vxCopyArrayRange(stitch->gain_array, 0, stitch->expCompGainCount, sizeof(vx_float32), stitch->expCompSolvedGains, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
+		}
+		// moving average from the gains in use towards the last solved gains: the gain array is rewritten
+		// only while the gains change, otherwise the stitch graph keeps using its copy on GPU
+		bool changed = false;
+		for (vx_size i = 0; i < stitch->expCompGainCount; i++) {
+			vx_float32 gain = stitch->expCompGains[i] + stitch->expCompGainSmoothing * (stitch->expCompSolvedGains[i] - stitch->expCompGains[i]);
+			if (gain != stitch->expCompGains[i]) changed = true;
+			stitch->expCompGains[i] = gain;
+		}
+		if (changed) {
+			ERROR_CHECK_STATUS_(vxCopyArrayRange(stitch->gain_array, 0, stitch->expCompGainCount, sizeof(vx_float32), stitch->expCompGains, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST));
+		}
+		if (stitch->expCompMatrixDelay) {
+			ERROR_CHECK_STATUS_(vxAgeDelay(stitch->expCompMatrixDelay));
+			error_matrix = (vx_matrix)vxGetReferenceFromDelay(stitch->expCompMatrixDelay, 0);
+		}
+	}
+	// error function has no overlaps while output regions are active: start from the last full output frame instead
+	if (stitch->num_active_regions > 0 && stitch->expCompActiveMatrix) {
+		ERROR_CHECK_STATUS_(vxWriteMatrix(error_matrix, stitch->expCompActiveMatrix));
+	}
+	else {
+		ERROR_CHECK_STATUS_(vxWriteMatrix(error_matrix, stitch->A_matrix_initial_value));
+	}
+	ERROR_CHECK_STATUS_(vxDirective((vx_reference)error_matrix, VX_DIRECTIVE_AMD_COPY_TO_OPENCL));
+	return VX_SUCCESS;
+}
 
 //! \brief Schedule next frame
 LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsScheduleFrame(ls_context stitch)
@@ -3145,8 +4612,7 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsScheduleFrame(ls_context stitch)
 
 	// exposure comp expects A_matrix to be initialized to ZERO on GPU
 	if ((stitch->EXPO_COMP <= 2) && stitch->A_matrix) {
-		ERROR_CHECK_STATUS_(vxWriteMatrix(stitch->A_matrix, stitch->A_matrix_initial_value));
-		ERROR_CHECK_STATUS_(vxDirective((vx_reference)stitch->A_matrix, VX_DIRECTIVE_AMD_COPY_TO_OPENCL));
+		ERROR_CHECK_STATUS_(UpdateExposureCompSolve(stitch));
 	}
 
 	// age delay element if temporal noise filter activated
@@ -3175,6 +4641,11 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsWaitForCompletion(ls_context stitc
 	ERROR_CHECK_STATUS_(vxWaitGraph(stitch->graphStitch));
 	stitch->scheduled = false;
 
+	// collect per stage performance statistics
+	if (stitch->perf) {
+		ERROR_CHECK_STATUS_(UpdatePerformanceData(stitch));
+	}
+
 	// debug: dump auxiliary data
 	if (stitch->loomioAuxDumpFile) {
 		vx_array auxList[] = { stitch->loomioCameraAuxData, stitch->loomioOverlayAuxData, stitch->loomioOutputAuxData, stitch->loomioViewingAuxData };
@@ -3198,6 +4669,41 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsWaitForCompletion(ls_context stitc
 	return VX_SUCCESS;
 }
 
+//! \brief Get per stage and per node processing time of recent frames.
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsGetPerformance(ls_context stitch, ls_perf_info * stages, ls_perf_info * nodes, vx_uint32 * num_nodes)
+{
+	ERROR_CHECK_STATUS_(IsValidContextAndInitialized(stitch));
+	if (!stitch->perf) {
+		ls_printf("ERROR: lsGetPerformance: requires LIVE_STITCH_ATTR_PROFILER before lsInitialize\n");
+		return VX_ERROR_NOT_SUPPORTED;
+	}
+	if (stages) {
+		for (vx_uint32 stage = 0; stage < LIVE_STITCH_PERF_STAGE_COUNT; stage++) {
+			GetPerformanceInfo(stitch->perf->stages[stage], &stages[stage]);
+		}
+	}
+	if (num_nodes) {
+		vx_uint32 count = (vx_uint32)stitch->perf->nodes.size();
+		if (nodes) {
+			for (vx_uint32 i = 0; i < std::min(count, *num_nodes); i++) {
+				GetPerformanceInfo(stitch->perf->nodes[i], &nodes[i]);
+			}
+		}
+		*num_nodes = count;
+	}
+	return VX_SUCCESS;
+}
+
+//! \brief Get host memory held by the context for lens model buffers and warp tables.
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsGetHostMemoryUsage(ls_context stitch, ls_host_memory_info * info)
+{
+	ERROR_CHECK_STATUS_(IsValidContext(stitch));
+	info->allocated_bytes = stitch->host_memory.allocatedBytes;
+	info->peak_bytes = stitch->host_memory.peakBytes;
+	info->hugepage_bytes = stitch->host_memory.hugepageBytes;
+	return VX_SUCCESS;
+}
+
 //! \brief query functions.
 LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsGetOpenVXContext(ls_context stitch, vx_context  * openvx_context)
 {
@@ -3251,6 +4757,17 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsGetOutputConfig(ls_context stitch,
 	*buffer_height = stitch->output_buffer_height;
 	return VX_SUCCESS;
 }
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsGetOutputRenditionConfig(ls_context stitch, vx_uint32 rendition, vx_df_image * buffer_format, vx_uint32 * buffer_width, vx_uint32 * buffer_height, vx_uint32 * buffer_stride_in_bytes)
+{
+	ERROR_CHECK_STATUS_(IsValidContextAndInitialized(stitch));
+	if (rendition >= stitch->num_output_renditions) {
+		ls_printf("ERROR: lsGetOutputRenditionConfig: invalid rendition %d (number of renditions: %d)\n", rendition, stitch->num_output_renditions);
+		return VX_ERROR_INVALID_PARAMETERS;
+	}
+	*buffer_format = stitch->output_buffer_format;
+	GetOutputRenditionConfig(stitch, rendition, *buffer_width, *buffer_height, *buffer_stride_in_bytes);
+	return VX_SUCCESS;
+}
 LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsGetOverlayConfig(ls_context stitch, vx_uint32 * num_overlay_rows, vx_uint32 * num_overlay_columns, vx_df_image * buffer_format, vx_uint32 * buffer_width, vx_uint32 * buffer_height)
 {
 	ERROR_CHECK_STATUS_(IsValidContext(stitch));
@@ -3582,7 +5099,7 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsExportConfiguration(ls_context sti
 		}
 		vx_node nodeObjList[] = {
 			stitch->InputColorConvertNode, stitch->SimpleStitchRemapNode, stitch->OutputColorConvertNode,
-			stitch->WarpNode, stitch->ExpcompComputeGainNode, stitch->ExpcompSolveGainNode, stitch->ExpcompApplyGainNode, stitch->MergeNode,
+			stitch->WarpNode, stitch->ExpcompComputeGainNode, stitch->ExpcompSolveGainNode, stitch->ExpcompApplyGainNode, stitch->MergeNode, stitch->WarpMergeNode,
 			stitch->SobelNode, stitch->MagnitudeNode, stitch->PhaseNode, stitch->ConvertDepthNode, 
 			stitch->SeamfindStep1Node, stitch->SeamfindStep2Node, stitch->SeamfindStep3Node, stitch->SeamfindStep4Node, stitch->SeamfindStep5Node,
 			stitch->nodeOverlayRemap, stitch->nodeOverlayBlend,
@@ -3590,10 +5107,10 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsExportConfiguration(ls_context sti
 		};
 		const char * kernelNameList[] = {
 			"com.amd.loomsl.color_convert", "org.khronos.openvx.remap", "com.amd.loomsl.color_convert",
-			"com.amd.loomsl.warp", "com.amd.loomsl.expcomp_compute_gainmatrix", "com.amd.loomsl.expcomp_solvegains", "com.amd.loomsl.expcomp_applygains", "com.amd.loomsl.merge",
+			"com.amd.loomsl.warp", "com.amd.loomsl.expcomp_compute_gainmatrix", "com.amd.loomsl.expcomp_solvegains", "com.amd.loomsl.expcomp_applygains", "com.amd.loomsl.merge", "com.amd.loomsl.warp_merge",
 			"org.khronos.openvx.sobel_3x3", "org.khronos.openvx.magnitude", "org.khronos.openvx.phase", "org.khronos.openvx.convert_depth",
 			"com.amd.loomsl.seamfind_scene_detect", "com.amd.loomsl.seamfind_cost_generate", "com.amd.loomsl.seamfind_cost_accumulate", "com.amd.loomsl.seamfind_path_trace", "com.amd.loomsl.seamfind_set_weights",
-			"org.khronos.openvx.remap", "com.amd.loomsl.alpha_blend",
+			"org.khronos.openvx.remap", stitch->overlay_remap ? "com.amd.loomsl.alpha_blend" : "com.amd.loomsl.overlay_blend",
 			stitch->loomio_camera.kernelName, stitch->loomio_overlay.kernelName, stitch->loomio_output.kernelName, stitch->loomio_viewing.kernelName,
 		};
 		std::map<vx_node, std::string> nodeMap;
@@ -3616,6 +5133,13 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsExportConfiguration(ls_context sti
 			}
 			nodeMap[stitch->pStitchMultiband[0].UpscaleAddNode] = "com.amd.loomsl.laplacian_reconstruct";
 		}
+		for (vx_uint32 i = 1; i < stitch->num_output_renditions; i++) {
+			nodeMap[stitch->rendition_scale_nodes[i]] = "com.amd.loomsl.half_scale_rgb";
+			if (stitch->rendition_convert_nodes[i]) {
+				bool isOpenVX = (stitch->output_buffer_format == VX_DF_IMAGE_NV12 || stitch->output_buffer_format == VX_DF_IMAGE_IYUV);
+				nodeMap[stitch->rendition_convert_nodes[i]] = isOpenVX ? "org.khronos.openvx.color_convert" : "com.amd.loomsl.color_convert";
+			}
+		}
 		std::map<vx_reference, std::string> refSuffixList;
 		std::map<vx_reference, bool> refIsForCpuUseOnly;
 		for (auto it = nodeMap.begin(); it != nodeMap.end(); it++) {
@@ -3643,37 +5167,39 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsExportConfiguration(ls_context sti
 		fprintf(fp, "import vx_loomsl\n");
 		std::map<vx_reference, std::string> refNameList;
 		if (stitch->stitching_mode == stitching_mode_normal) {
-			fprintf(fp, "type WarpValidPixelEntryType userstruct:%d\n", (int)sizeof(StitchValidPixelEntry));
-			fprintf(fp, "type WarpRemapEntryType userstruct:%d\n", (int)sizeof(StitchWarpRemapEntry));
+			fprintf(fp, "type WarpValidPixelEntryType userstruct:%d\n", stitch->useWideTables ? (int)sizeof(StitchValidPixelWideEntry) : (int)sizeof(StitchValidPixelEntry));
+			fprintf(fp, "type WarpRemapEntryType userstruct:%d\n", (stitch->WARP_TABLE_FORMAT == STITCH_WARP_TABLE_FORMAT_COMPACT) ? (int)sizeof(StitchWarpRemapCompactEntry) : (int)sizeof(StitchWarpRemapEntry));
 			fprintf(fp, "data warpValidPixelTable = array:WarpValidPixelEntryType,%d\n", (int)stitch->table_sizes.warpTableSize);
-			fprintf(fp, "data warpRemapTable = array:WarpRemapEntryType,%d\n", (int)stitch->table_sizes.warpTableSize);
-			fprintf(fp, "data RGBY1 = image:%d,%d,RGBA\n", stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras);
-			fprintf(fp, "data weight_image = image:%d,%d,U008\n", stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras);
+			fprintf(fp, "data warpRemapTable = array:WarpRemapEntryType,%d\n", (int)GetWarpRemapTableCapacity(stitch));
+			vx_uint32 warpOutputWidth = stitch->camera_plane_array ? stitch->packed_plane_width : stitch->output_rgb_buffer_width;
+			vx_uint32 warpOutputHeight = stitch->camera_plane_array ? stitch->packed_plane_height : stitch->output_rgb_buffer_height * stitch->num_cameras;
+			if (stitch->RGBY1) fprintf(fp, "data RGBY1 = image:%d,%d,RGBA\n", warpOutputWidth, warpOutputHeight);
+			fprintf(fp, "data weight_image = image:%d,%d,U008\n", warpOutputWidth, warpOutputHeight);
 			fprintf(fp, "data cam_id_image = image:%d,%d,U008\n", (stitch->output_rgb_buffer_width / 8), stitch->output_rgb_buffer_height);
 			fprintf(fp, "data group1_image = image:%d,%d,U016\n", (stitch->output_rgb_buffer_width / 8), stitch->output_rgb_buffer_height);
 			fprintf(fp, "data group2_image = image:%d,%d,U016\n", (stitch->output_rgb_buffer_width / 8), stitch->output_rgb_buffer_height);
 			refNameList[(vx_reference)stitch->ValidPixelEntry] = "warpValidPixelTable";
 			refNameList[(vx_reference)stitch->WarpRemapEntry] = "warpRemapTable";
-			refNameList[(vx_reference)stitch->RGBY1] = "RGBY1";
+			if (stitch->RGBY1) refNameList[(vx_reference)stitch->RGBY1] = "RGBY1";
 			refNameList[(vx_reference)stitch->weight_image] = "weight_image";
 			refNameList[(vx_reference)stitch->cam_id_image] = "cam_id_image";
 			refNameList[(vx_reference)stitch->group1_image] = "group1_image";
 			refNameList[(vx_reference)stitch->group2_image] = "group2_image";
 			if (stitch->EXPO_COMP) {
-				fprintf(fp, "type ExpCompValidEntryType userstruct:%d\n", (int)sizeof(StitchOverlapPixelEntry));
-				fprintf(fp, "type ExpCompCalcEntryType userstruct:%d\n", (int)sizeof(StitchExpCompCalcEntry));
+				fprintf(fp, "type ExpCompValidEntryType userstruct:%d\n", stitch->useWideTables ? (int)sizeof(StitchOverlapPixelWideEntry) : (int)sizeof(StitchOverlapPixelEntry));
+				fprintf(fp, "type ExpCompCalcEntryType userstruct:%d\n", stitch->useWideTables ? (int)sizeof(StitchExpCompCalcWideEntry) : (int)sizeof(StitchExpCompCalcEntry));
 				fprintf(fp, "data expCompValidTable = array:ExpCompValidEntryType,%d\n", (int)stitch->table_sizes.expCompValidTableSize);
 				if (stitch->EXPO_COMP < 3) fprintf(fp, "data expCompCalcTable = array:ExpCompCalcEntryType,%d\n", (int)stitch->table_sizes.expCompOverlapTableSize);
 				fprintf(fp, "data expCompGain = array:VX_TYPE_FLOAT32,%d\n", (int)stitch->num_cameras);
 				fprintf(fp, "data expCompAMat = matrix:VX_TYPE_INT32,%d,%d\n", stitch->num_cameras, stitch->num_cameras);
 				fprintf(fp, "data expCompCountMat = matrix:VX_TYPE_INT32,%d,%d\n", stitch->num_cameras, stitch->num_cameras);
-				fprintf(fp, "data RGBY2 = image:%d,%d,RGBA\n", stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras);
+				if (stitch->RGBY2) fprintf(fp, "data RGBY2 = image:%d,%d,RGBA\n", warpOutputWidth, warpOutputHeight);
 				refNameList[(vx_reference)stitch->valid_array] = "expCompValidTable";
 				if (stitch->EXPO_COMP < 3) refNameList[(vx_reference)stitch->OverlapPixelEntry] = "expCompCalcTable";
 				refNameList[(vx_reference)stitch->gain_array] = "expCompGain";
 				refNameList[(vx_reference)stitch->A_matrix] = "expCompAMat";
 				refNameList[(vx_reference)stitch->overlap_matrix] = "expCompCountMat";
-				refNameList[(vx_reference)stitch->RGBY2] = "RGBY2";
+				if (stitch->RGBY2) refNameList[(vx_reference)stitch->RGBY2] = "RGBY2";
 			}
 			if (stitch->SEAM_FIND) {
 				fprintf(fp, "type SeamFindValidEntryType userstruct:%d\n", (int)sizeof(StitchSeamFindValidEntry));
@@ -3688,7 +5214,7 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsExportConfiguration(ls_context sti
 				fprintf(fp, "data seamFindPref = array:SeamFindPreferenceType,%d\n", (int)stitch->table_sizes.seamFindPrefInfoTableSize);
 				fprintf(fp, "data seamFindInfo = array:SeamFindInformationType,%d\n", (int)stitch->table_sizes.seamFindPrefInfoTableSize);
 				fprintf(fp, "data seamFindPath = array:SeamFindPathEntryType,%d\n", (int)stitch->table_sizes.seamFindPathTableSize);
-				fprintf(fp, "data warpLuma = virtual-image:%d,%d,U008\n", stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras);
+				fprintf(fp, "data warpLuma = virtual-image:%d,%d,U008\n", warpOutputWidth, warpOutputHeight);
 				refNameList[(vx_reference)stitch->seamfind_valid_array] = "seamFindValid";
 				refNameList[(vx_reference)stitch->seamfind_weight_array] = "seamFindWeight";
 				refNameList[(vx_reference)stitch->seamfind_accum_array] = "seamFindAccum";
@@ -3697,16 +5223,16 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsExportConfiguration(ls_context sti
 				refNameList[(vx_reference)stitch->seamfind_path_array] = "seamFindPath";
 				refNameList[(vx_reference)stitch->warp_luma_image] = "warpLuma";
 				if (!stitch->SEAM_COST_SELECT) {
-					fprintf(fp, "data seamFindSobelX = virtual-image:%d,%d,S016\n", stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras);
-					fprintf(fp, "data seamFindSobelY = virtual-image:%d,%d,S016\n", stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras);
-					fprintf(fp, "data seamFindMagS16 = virtual-image:%d,%d,S016\n", stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras);
+					fprintf(fp, "data seamFindSobelX = virtual-image:%d,%d,S016\n", warpOutputWidth, warpOutputHeight);
+					fprintf(fp, "data seamFindSobelY = virtual-image:%d,%d,S016\n", warpOutputWidth, warpOutputHeight);
+					fprintf(fp, "data seamFindMagS16 = virtual-image:%d,%d,S016\n", warpOutputWidth, warpOutputHeight);
 					refNameList[(vx_reference)stitch->sobelx_image] = "seamFindSobelX";
 					refNameList[(vx_reference)stitch->sobely_image] = "seamFindSobelY";
 					refNameList[(vx_reference)stitch->sobel_magnitude_s16_image] = "seamFindMagS16";
 				}
-				fprintf(fp, "data seamFindMag = virtual-image:%d,%d,U008\n", stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras);
-				fprintf(fp, "data seamFindPhase = virtual-image:%d,%d,U008\n", stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras);
-				fprintf(fp, "data seamFindWeightImage = image:%d,%d,U008\n", stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras);
+				fprintf(fp, "data seamFindMag = virtual-image:%d,%d,U008\n", warpOutputWidth, warpOutputHeight);
+				fprintf(fp, "data seamFindPhase = virtual-image:%d,%d,U008\n", warpOutputWidth, warpOutputHeight);
+				fprintf(fp, "data seamFindWeightImage = image:%d,%d,U008\n", warpOutputWidth, warpOutputHeight);
 				fprintf(fp, "data seamFindCurFrame = scalar:VX_TYPE_UINT32,%d\n", stitch->current_frame_value);
 				refNameList[(vx_reference)stitch->sobel_magnitude_image] = "seamFindMag";
 				refNameList[(vx_reference)stitch->sobel_phase_image] = "seamFindPhase";
@@ -3726,12 +5252,12 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsExportConfiguration(ls_context sti
 				}
 			}
 			if (stitch->MULTIBAND_BLEND) {
-				fprintf(fp, "type BlendValidEntryType userstruct:%d\n", (int)sizeof(StitchBlendValidEntry));
+				fprintf(fp, "type BlendValidEntryType userstruct:%d\n", stitch->useWideTables ? (int)sizeof(StitchBlendValidWideEntry) : (int)sizeof(StitchBlendValidEntry));
 				fprintf(fp, "data blendValidTable = array:BlendValidEntryType,%d\n", (int)stitch->table_sizes.blendOffsetTableSize);
 				refNameList[(vx_reference)stitch->blend_offsets] = "blendValidTable";
 			}
 			if (stitch->SEAM_FIND || stitch->EXPO_COMP) {
-				fprintf(fp, "data validMaskImage = image:%d,%d,U008\n", stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras);
+				fprintf(fp, "data validMaskImage = image:%d,%d,U008\n", warpOutputWidth, warpOutputHeight);
 				refNameList[(vx_reference)stitch->valid_mask_image] = "validMaskImage";
 			}
 		}
@@ -3749,6 +5275,19 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsExportConfiguration(ls_context sti
 			refNameList[(vx_reference)stitch->Img_overlay_rgb] = "Img_overlay_rgb";
 			refNameList[(vx_reference)stitch->overlay_remap] = "overlay_remap";
 		}
+		else if (stitch->OverlayValidPixelEntry) {
+			vx_size itemsize = 0, capacity = 0;
+			ERROR_CHECK_STATUS_(vxQueryArray(stitch->OverlayValidPixelEntry, VX_ARRAY_ITEMSIZE, &itemsize, sizeof(itemsize)));
+			ERROR_CHECK_STATUS_(vxQueryArray(stitch->OverlayValidPixelEntry, VX_ARRAY_CAPACITY, &capacity, sizeof(capacity)));
+			fprintf(fp, "data Img_overlay = image:%d,%d,RGBA\n", stitch->overlay_buffer_width, stitch->overlay_buffer_height);
+			fprintf(fp, "type OverlayValidPixelEntryType userstruct:%d\n", (int)itemsize);
+			fprintf(fp, "type OverlayRemapEntryType userstruct:%d\n", (int)sizeof(StitchWarpRemapEntry));
+			fprintf(fp, "data overlayValidPixelTable = array:OverlayValidPixelEntryType,%d\n", (int)capacity);
+			fprintf(fp, "data overlayRemapTable = array:OverlayRemapEntryType,%d\n", (int)capacity);
+			refNameList[(vx_reference)stitch->Img_overlay] = "Img_overlay";
+			refNameList[(vx_reference)stitch->OverlayValidPixelEntry] = "overlayValidPixelTable";
+			refNameList[(vx_reference)stitch->OverlayWarpRemapEntry] = "overlayRemapTable";
+		}
 		if (stitch->camera_remap) {
 			fprintf(fp, "data camera_remap = remap:%d,%d,%d,%d\n", stitch->camera_rgb_buffer_width, stitch->camera_rgb_buffer_height, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height);
 			refNameList[(vx_reference)stitch->camera_remap] = "camera_remap";
@@ -3874,6 +5413,9 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsExportConfiguration(ls_context sti
 			fprintf(fp, "read %s %s-overlay-input.raw\n", refNameList[(vx_reference)stitch->Img_overlay].c_str(), fileNamePrefixForTables);
 		}
 		fprintf(fp, "write %s %s-stitch-output.raw\n", refNameList[(vx_reference)stitch->Img_output].c_str(), fileNamePrefixForTables);
+		for (vx_uint32 i = 1; i < stitch->num_output_renditions; i++) {
+			fprintf(fp, "write %s %s-stitch-output-%d.raw\n", refNameList[(vx_reference)stitch->rendition_output[i]].c_str(), fileNamePrefixForTables, i);
+		}
 		fprintf(fp, "\n");
 		for (auto it = refSuffixList.begin(); it != refSuffixList.end(); it++) {
 			if (refIsForCpuUseOnly.find(it->first) == refIsForCpuUseOnly.end() || !refIsForCpuUseOnly[it->first]) {
@@ -4042,11 +5584,32 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsGetExpCompGains(ls_context stitch,
 LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetBlendWeights(ls_context stitch, vx_uint8 * weights, size_t size)
 {
 	ERROR_CHECK_STATUS_(IsValidContextAndInitialized(stitch));
-	if (stitch->SEAM_FIND || !stitch->weight_image)
+	if (stitch->SEAM_FIND || !stitch->weight_image || stitch->tables_shared)
 		return VX_ERROR_NOT_SUPPORTED;
 	if (size != (size_t)(stitch->output_rgb_buffer_width * stitch->output_rgb_buffer_height * stitch->num_cameras))
 		return VX_ERROR_INVALID_PARAMETERS;
 
+	if (stitch->camera_plane_array) {
+		// copy camera bounding boxes into packed camera planes
+		vx_rectangle_t rect = { 0, 0, stitch->packed_plane_width, stitch->packed_plane_height };
+		vx_imagepatch_addressing_t addr;
+		vx_map_id map_id;
+		vx_uint8 * ptr;
+		ERROR_CHECK_STATUS_(vxMapImagePatch(stitch->weight_image, &rect, 0, &map_id, &addr, (void **)&ptr, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, VX_NOGAP_X));
+		memset(ptr, 0, addr.stride_y * addr.dim_y);
+		vx_uint32 yp = 0;
+		for (vx_uint32 camId = 0; camId < stitch->num_cameras; camId++) {
+			const StitchCameraPlaneEntry& plane = stitch->cameraPlanes[camId];
+			for (vx_uint32 i = 0; i < plane.height; i++, yp++) {
+				vx_uint32 y = (vx_uint32)((vx_int32)yp - plane.offsetY), x = (vx_uint32)(-plane.offsetX);
+				memcpy(ptr + yp * addr.stride_y, weights + ((size_t)camId * stitch->output_rgb_buffer_height + y) * stitch->output_rgb_buffer_width + x,
+					std::min(plane.width, stitch->output_rgb_buffer_width - x));
+			}
+		}
+		ERROR_CHECK_STATUS_(vxUnmapImagePatch(stitch->weight_image, map_id));
+		return VX_SUCCESS;
+	}
+
 	// copy weight image
 	vx_rectangle_t rect = { 0, 0, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height * stitch->num_cameras };
 	vx_imagepatch_addressing_t addr;
@@ -4058,3 +5621,113 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetBlendWeights(ls_context stitch,
 
 	return VX_SUCCESS;
 }
+
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetActiveOutputRegions(ls_context stitch, vx_uint32 num_regions, const vx_rectangle_t * regions)
+{
+	ERROR_CHECK_STATUS_(IsValidContextAndInitialized(stitch));
+	if ((!stitch->MergeNode && !stitch->WarpMergeNode) || stitch->SEAM_FIND) {
+		ls_printf("ERROR: lsSetActiveOutputRegions: active output regions need merge or fused warp merge without seamfind\n");
+		return VX_ERROR_NOT_SUPPORTED;
+	}
+	if (stitch->tables_shared) {
+		ls_printf("ERROR: lsSetActiveOutputRegions: active output regions can't be used with internal tables shared across contexts\n");
+		return VX_ERROR_NOT_SUPPORTED;
+	}
+	if (stitch->scheduled) {
+		ls_printf("ERROR: lsSetActiveOutputRegions: can't set active output regions when already scheduled\n");
+		return VX_ERROR_GRAPH_SCHEDULED;
+	}
+	if (num_regions > LIVE_STITCH_MAX_ACTIVE_REGIONS || (num_regions > 0 && !regions)) {
+		ls_printf("ERROR: lsSetActiveOutputRegions: invalid number of regions: %d (max %d)\n", num_regions, LIVE_STITCH_MAX_ACTIVE_REGIONS);
+		return VX_ERROR_INVALID_PARAMETERS;
+	}
+	for (vx_uint32 i = 0; i < num_regions; i++) {
+		vx_rectangle_t rect = regions[i];
+		rect.end_x = std::min(rect.end_x, stitch->output_rgb_buffer_width);
+		rect.end_y = std::min(rect.end_y, stitch->output_rgb_buffer_height);
+		if (rect.start_x >= rect.end_x || rect.start_y >= rect.end_y) {
+			ls_printf("ERROR: lsSetActiveOutputRegions: region#%d (%d,%d,%d,%d) is outside of output %dx%d\n", i,
+				regions[i].start_x, regions[i].start_y, regions[i].end_x, regions[i].end_y, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height);
+			return VX_ERROR_INVALID_PARAMETERS;
+		}
+		stitch->activeRegion[i] = rect;
+	}
+	if (num_regions > 0 && stitch->num_active_regions == 0 && stitch->A_matrix) {
+		// keep the exposure comp error function of the last full output frame: gains are solved from it
+		// while regions are active (see UpdateExposureCompSolve)
+		vx_matrix error_matrix = stitch->expCompMatrixDelay ? (vx_matrix)vxGetReferenceFromDelay(stitch->expCompMatrixDelay, 0) : stitch->A_matrix;
+		vx_size columns = 0, rows = 0;
+		ERROR_CHECK_STATUS_(vxQueryMatrix(error_matrix, VX_MATRIX_COLUMNS, &columns, sizeof(columns)));
+		ERROR_CHECK_STATUS_(vxQueryMatrix(error_matrix, VX_MATRIX_ROWS, &rows, sizeof(rows)));
+		if (!stitch->expCompActiveMatrix) {
+			ERROR_CHECK_ALLOC_(stitch->expCompActiveMatrix = new vx_int32[columns * rows]);
+		}
+		ERROR_CHECK_STATUS_(vxReadMatrix(error_matrix, stitch->expCompActiveMatrix));
+	}
+	stitch->num_active_regions = num_regions;
+	ERROR_CHECK_STATUS_(ApplyActiveOutputRegions(stitch));
+	return VX_SUCCESS;
+}
+
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetActiveViewports(ls_context stitch, vx_uint32 num_viewports, const ls_viewport * viewports)
+{
+	ERROR_CHECK_STATUS_(IsValidContextAndInitialized(stitch));
+	if (num_viewports > 0 && !viewports)
+		return VX_ERROR_INVALID_PARAMETERS;
+	if (num_viewports > 0 && stitch->OUTPUT_PROJECTION != output_projection_equirectangular) {
+		ls_printf("ERROR: lsSetActiveViewports: viewports are only supported with equirectangular output\n");
+		return VX_ERROR_NOT_SUPPORTED;
+	}
+	// each viewport covers one output rectangle, or two when it wraps around left/right edges
+	std::vector<vx_rectangle_t> regions;
+	vx_float32 width = (vx_float32)stitch->output_rgb_buffer_width, height = (vx_float32)stitch->output_rgb_buffer_height;
+	for (vx_uint32 i = 0; i < num_viewports; i++) {
+		const ls_viewport& view = viewports[i];
+		vx_float32 top = std::min(view.pitch + view.vfov * 0.5f, 90.0f), bottom = std::max(view.pitch - view.vfov * 0.5f, -90.0f);
+		// horizontal extent grows with latitude and covers all longitudes at the poles
+		vx_float32 maxLatitude = std::max(fabsf(top), fabsf(bottom));
+		vx_float32 hfov = (maxLatitude < 89.0f) ? view.hfov / cosf(maxLatitude * (vx_float32)M_PI / 180.0f) : 360.0f;
+		vx_rectangle_t rect;
+		rect.start_y = (vx_uint32)std::max(0.0f, floorf((90.0f - top) * height / 180.0f));
+		rect.end_y = (vx_uint32)std::min(height, ceilf((90.0f - bottom) * height / 180.0f));
+		if (hfov >= 360.0f) {
+			rect.start_x = 0;
+			rect.end_x = stitch->output_rgb_buffer_width;
+			regions.push_back(rect);
+			continue;
+		}
+		vx_float32 left = view.yaw - hfov * 0.5f + 180.0f, right = view.yaw + hfov * 0.5f + 180.0f;
+		left -= floorf(left / 360.0f) * 360.0f;
+		right = left + hfov;
+		rect.start_x = (vx_uint32)floorf(left * width / 360.0f);
+		rect.end_x = (vx_uint32)std::min(width, ceilf(right * width / 360.0f));
+		regions.push_back(rect);
+		if (right > 360.0f) {
+			rect.start_x = 0;
+			rect.end_x = (vx_uint32)std::min(width, ceilf((right - 360.0f) * width / 360.0f));
+			regions.push_back(rect);
+		}
+	}
+	return lsSetActiveOutputRegions(stitch, (vx_uint32)regions.size(), regions.size() > 0 ? regions.data() : nullptr);
+}
+
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetActiveOutputTiles(ls_context stitch, vx_uint32 num_tiles, const vx_uint32 * tile_indices)
+{
+	ERROR_CHECK_STATUS_(IsValidContextAndInitialized(stitch));
+	if (num_tiles > 0 && !tile_indices)
+		return VX_ERROR_INVALID_PARAMETERS;
+	vx_uint32 numTileX = std::max(1u, (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_OUTPUT_TILE_NUM_X]);
+	vx_uint32 numTileY = std::max(1u, (vx_uint32)stitch->live_stitch_attr[LIVE_STITCH_ATTR_OUTPUT_TILE_NUM_Y]);
+	vx_uint32 tileWidth = stitch->output_rgb_buffer_width / numTileX, tileHeight = stitch->output_rgb_buffer_height / numTileY;
+	std::vector<vx_rectangle_t> regions;
+	for (vx_uint32 i = 0; i < num_tiles; i++) {
+		if (tile_indices[i] >= numTileX * numTileY) {
+			ls_printf("ERROR: lsSetActiveOutputTiles: invalid tile index %d (max %d)\n", tile_indices[i], numTileX * numTileY - 1);
+			return VX_ERROR_INVALID_PARAMETERS;
+		}
+		vx_uint32 tx = tile_indices[i] % numTileX, ty = tile_indices[i] / numTileX;
+		vx_rectangle_t rect = { tx * tileWidth, ty * tileHeight, (tx + 1) * tileWidth, (ty + 1) * tileHeight };
+		regions.push_back(rect);
+	}
+	return lsSetActiveOutputRegions(stitch, (vx_uint32)regions.size(), regions.size() > 0 ? regions.data() : nullptr);
+}
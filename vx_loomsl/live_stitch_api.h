@@ -36,8 +36,16 @@ THE SOFTWARE.
 #endif
 
 //////////////////////////////////////////////////////////////////////
-//! \brief Maximum number of cameras supported
-#define LIVE_STITCH_MAX_CAMERAS          31
+//! \brief Maximum number of cameras supported: camera masks are 64-bit; rigs with more than 31 cameras use wide tables
+#define LIVE_STITCH_MAX_CAMERAS          64
+
+//////////////////////////////////////////////////////////////////////
+//! \brief Maximum number of active output regions (see lsSetActiveOutputRegions)
+#define LIVE_STITCH_MAX_ACTIVE_REGIONS   16
+
+//////////////////////////////////////////////////////////////////////
+//! \brief Maximum number of output renditions (see LIVE_STITCH_ATTR_OUTPUT_RENDITIONS)
+#define LIVE_STITCH_MAX_OUTPUT_RENDITIONS 4
 
 //////////////////////////////////////////////////////////////////////
 //! \brief The attributes
@@ -46,7 +54,7 @@ THE SOFTWARE.
 //  - the default values of these attributes will be good enough for most applications
 //  - only dynamic LoomSL attributes can be modified using lsSetAttributes API 
 enum {
-	LIVE_STITCH_ATTR_PROFILER                 =    0,   // profiler attribute: 0:OFF 1:ON
+	LIVE_STITCH_ATTR_PROFILER                 =    0,   // profiler attribute: 0:OFF 1:ON (also enables lsGetPerformance)
 	LIVE_STITCH_ATTR_EXPCOMP                  =    1,   // exp-comp attribute: 0:OFF 1:Global 2:GlobalUser  4:BlockUser
 	LIVE_STITCH_ATTR_SEAMFIND                 =    2,   // seamfind attribute: 0:OFF 1:ON
 	LIVE_STITCH_ATTR_SEAM_REFRESH             =    3,   // seamfind seam refresh attribute: 0:OFF 1:ON
@@ -54,6 +62,8 @@ enum {
 	LIVE_STITCH_ATTR_MULTIBAND                =    5,   // multiband attribute: 0:OFF 1:ON
 	LIVE_STITCH_ATTR_MULTIBAND_NUMBANDS       =    6,   // multiband attribute: numbands 2-6
 	LIVE_STITCH_ATTR_STITCH_MODE              =    7,   // stitch mode: 0:normal 1:quick (default: normal)
+	LIVE_STITCH_ATTR_HOST_HUGEPAGES           =    8,   // host buffers of 2MB or larger use 2MB hugepages when available: 0:OFF 1:ON (default:1)
+	LIVE_STITCH_ATTR_HOST_NUMA_NODE           =    9,   // NUMA node for host buffers of 2MB or larger: -1:first touch 0 - N:preferred node, typically the node running the stitch (default:-1)
 	LIVE_STITCH_ATTR_ENABLE_REINITIALIZE      =   10,   // enable lsReinitialize (default disabled)
 	LIVE_STITCH_ATTR_REDUCE_OVERLAP_REGION    =   11,   // Reduces the overlap region by n*n pixels (default: 0)
 	LIVE_STITCH_ATTR_SEAM_VERT_PRIORITY       =   12,   // Vertical seam priority: -1 to N Flag. -1:Disable 1:highest N:Lowest. (default 1)
@@ -81,6 +91,7 @@ enum {
 	LIVE_STITCH_ATTR_EXPCOMP_GAIN_IMG_C		  =	  36,   // exp-comp attribute: gain image num channels (default: 1)
 	LIVE_STITCH_ATTR_EXPCOMP_ALPHA_VALUE	  =	  37,   // exp-comp attribute: alpha value (variance of gain)
 	LIVE_STITCH_ATTR_EXPCOMP_BETA_VALUE		  =   38,   // exp-comp attribute: beta value (variance of mean intensity)
+	LIVE_STITCH_ATTR_EXPCOMP_SOLVE_WINDOW     =   39,   // exp-comp attribute: sliding window of frames whose statistics are used per gain solve: 1 - 32 (default:1)
 	LIVE_STITCH_ATTR_OUTPUT_TILE_NUM_X		  =	  40,   // number of horizontal tiles in the output (default: 1)
 	LIVE_STITCH_ATTR_OUTPUT_TILE_NUM_Y		  =   41,   // number of veritical tiles in the output (default: 1)
 	LIVE_STITCH_ATTR_OUTPUT_src_tile_overlap  =   42,   // overlap pixel count (default: 0)
@@ -88,6 +99,9 @@ enum {
 	LIVE_STITCH_ATTR_OUTPUT_ENCODER_WIDTH     =   44,   // encoder buffer width (default: 3840)
 	LIVE_STITCH_ATTR_OUTPUT_ENCODER_HEIGHT    =   45,   // encoder buffer height (default: 2160)
 	LIVE_STITCH_ATTR_OUTPUT_ENCODER_STRIDE_Y  =   46,   // encoder buffer stride_y (default: 2160)
+	LIVE_STITCH_ATTR_OUTPUT_RENDITIONS        =   47,   // number of output renditions: 1 - 4, each rendition is half the size of the previous one (default: 1)
+	LIVE_STITCH_ATTR_OUTPUT_PROJECTION        =   48,   // output projection: 0:equirectangular 1:cubemap 2:equi-angular cubemap (see output_projection) (default: 0)
+	LIVE_STITCH_ATTR_HOST_EXECUTION           =   49,   // run stitch graph on CPU with host memory buffers: 0:OFF 1:ON (see lsSetCameraBufferHost; no LoomIO, overlays, renditions or encode tiles) (default:0)
 	LIVE_STITCH_ATTR_CHROMA_KEY				  =   50,   // chroma key enable: 0:OFF 1:ON (default:0)
 	LIVE_STITCH_ATTR_CHROMA_KEY_VALUE		  =   51,   // chroma key value: 0 - N (default: 8454016 - Green 0x80FF80)
 	LIVE_STITCH_ATTR_CHROMA_KEY_TOL			  =	  52,   // chroma key tol: 0 - N (default: 25)
@@ -95,9 +109,17 @@ enum {
 	LIVE_STITCH_ATTR_NOISE_FILTER			  =   55,   // temporal filter to account for the camera noise: 0:OFF 1:ON (default:0)
 	LIVE_STITCH_ATTR_USE_CPU_FOR_INIT         =   56,   // use CPU kernels for initialize stitch: 0:OFF 1:ON (default:0)
 	LIVE_STITCH_ATTR_SAVE_AND_LOAD_INIT		  =	  57,   // save initialized stitch tables for quick load&run: 0:OFF 1:ON (default:0)
+	LIVE_STITCH_ATTR_WARP_TABLE_FORMAT        =   58,   // warp remap table format: 0:full 1:compact (default:0)
+	LIVE_STITCH_ATTR_EXPCOMP_SOLVE_INTERVAL   =   59,   // exposure comp frames between gain solves: 1 - 32; gains are solved outside the frame graph when interval or window > 1 (default:1)
+	LIVE_STITCH_ATTR_SEAM_SCHEDULE            =   60,   // seamfind seam refresh schedule: 0:fixed frequency 1:scene change events (default:0)
+	LIVE_STITCH_ATTR_SEAM_COARSE_SCALE        =   61,   // seamfind coarse-to-fine path search: 0:full resolution 2 - 16:downsample factor, 4 or 8 typical (default:0)
+	LIVE_STITCH_ATTR_FUSED_WARP_MERGE         =   62,   // fused warp, exposure gain and merge output pass: 0:OFF 1:ON (without multiband blend, exposure comp 0 - 2; warp pass still runs with exposure comp or seamfind) (default:0)
+	LIVE_STITCH_ATTR_PACKED_INTERMEDIATES     =   63,   // pack per camera warp and weight images to camera bounding boxes: 0:OFF 1:ON (without multiband blend, exposure comp, seamfind) (default:0)
 	// Dynamic LoomSL attributes
 	LIVE_STITCH_ATTR_SEAM_THRESHOLD           =   64,   // seamfind seam refresh Threshold: 0 - 100 percentage change (default:25)
 	LIVE_STITCH_ATTR_NOISE_FILTER_LAMBDA	  =   65,   // temporal filter variable: 0 - 1 (default:1)
+	LIVE_STITCH_ATTR_EXPCOMP_GAIN_SMOOTHING   =   66,   // exposure comp gain moving average factor per frame when solve interval or window > 1: 0 - 1 (default:1)
+	LIVE_STITCH_ATTR_SEAM_BUDGET              =   67,   // seamfind max overlaps recomputed per frame with event schedule: 0:unlimited (default:2)
 	// ... reserved for LoomSL internal attributes
 	LIVE_STITCH_ATTR_RESERVED_CORE_END        =  127,   // reserved first 128 attributes for LoomSL internal attributes
 	LIVE_STITCH_ATTR_RESERVED_EXT_BEGIN       =  128,   // start of reserved attributes for extensions
@@ -105,6 +127,18 @@ enum {
 	LIVE_STITCH_ATTR_MAX_COUNT                =  256    // total number of attributes
 };
 
+//! \brief The output projection (LIVE_STITCH_ATTR_OUTPUT_PROJECTION)
+//  - equirectangular output: width = 2 x height
+//  - cubemap outputs: 3x2 faces of height/2 x height/2 (width = 3 x height / 2), all faces upright
+//      top row:    left, front, right
+//      bottom row: bottom, back, top (front is towards the top edge of bottom face and the bottom edge of top face)
+//    multiband blend, seamfind and active viewports need equirectangular output
+typedef enum {
+	output_projection_equirectangular = 0, // equirectangular
+	output_projection_cubemap         = 1, // cubemap: faces with rectilinear sampling
+	output_projection_eac             = 2, // equi-angular cubemap: faces with uniform angular sampling
+} output_projection;
+
 
 //////////////////////////////////////////////////////////////////////
 // Camera Model Parameters
@@ -148,6 +182,48 @@ typedef struct {
     float d;                // focus sphere radius in depth pixel units (default: 0.0 for infinity)
 } rig_params;
 
+//! \brief The output viewport (see lsSetActiveViewports).
+//  - yaw: -180 at left edge of the output, 0 at center, 180 at right edge
+//  - pitch: 90 at top row of the output, -90 at bottom row
+typedef struct {
+	float yaw, pitch;       // viewport center in degrees
+	float hfov, vfov;       // horizontal and vertical field of view in degrees
+} ls_viewport;
+
+
+//////////////////////////////////////////////////////////////////////
+// Performance Statistics
+
+//! \brief The stitch pipeline stages (see lsGetPerformance)
+enum {
+	LIVE_STITCH_PERF_STAGE_FRAME              =    0,   // complete stitch graph
+	LIVE_STITCH_PERF_STAGE_INPUT              =    1,   // camera LoomIO and input color convert
+	LIVE_STITCH_PERF_STAGE_WARP               =    2,   // warp, fused warp merge, and simple stitch remap
+	LIVE_STITCH_PERF_STAGE_EXPCOMP            =    3,   // exposure comp gain computation, solve, and apply
+	LIVE_STITCH_PERF_STAGE_SEAMFIND           =    4,   // seamfind sobel and seam stages
+	LIVE_STITCH_PERF_STAGE_BLEND              =    5,   // merge, multiband blend, noise filter, and chroma key
+	LIVE_STITCH_PERF_STAGE_OVERLAY            =    6,   // overlay LoomIO, remap, and alpha blend
+	LIVE_STITCH_PERF_STAGE_OUTPUT             =    7,   // output color convert, encode tiles, and output/viewing LoomIO
+	LIVE_STITCH_PERF_STAGE_COUNT              =    8    // total number of stages
+};
+
+//! \brief The processing time statistics of a stage or a graph node over a rolling window of frames.
+typedef struct {
+	char       name[64];    // stage name or kernel name
+	vx_uint32  stage;       // LIVE_STITCH_PERF_STAGE_*
+	vx_uint32  num;         // number of frames in the rolling window
+	vx_uint64  frames;      // total number of frames measured
+	vx_float32 last_ms;     // processing time of the last frame in milliseconds
+	vx_float32 min_ms, avg_ms, p99_ms, max_ms; // processing time over the rolling window in milliseconds
+	vx_uint64  bytes;       // estimated bytes read and written per frame
+} ls_perf_info;
+
+//! \brief The host memory held by a stitch context for lens model buffers and warp tables (see lsGetHostMemoryUsage).
+typedef struct {
+	vx_size    allocated_bytes; // host memory currently allocated
+	vx_size    peak_bytes;      // largest allocated_bytes since context creation
+	vx_size    hugepage_bytes;  // part of allocated_bytes backed by or advised for 2MB hugepages
+} ls_host_memory_info;
 
 //////////////////////////////////////////////////////////////////////
 //! \brief The log callback function
@@ -196,6 +272,7 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsReleaseContext(ls_context * pStitc
 //  - supported formats: VX_DF_IMAGE_RGB, VX_DF_IMAGE_UYVY, VX_DF_IMAGE_YUYV
 //  - buffer_width must be multiple of 16
 //  - buffer_height must be multiple of 2
+//  - buffer_width must be 2 x buffer_height for equirectangular and 1.5 x buffer_height for cubemap output projections
 //  - Note that output scale factor attribute is not supported when output format is VX_DF_IMAGE_RGB
 //  - Note that this function must be called before lsInitialize call
 //  - return VX_SUCCESS or error code (see log messages for further details)
@@ -280,6 +357,16 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetOpenCLContext(ls_context stitch
 //  - Note that these function must be called before lsInitialize call if application requires use of a its own OpenVX context
 //  - return VX_SUCCESS or error code (see log messages for further details)
 LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetOpenVXContext(ls_context stitch, vx_context openvx_context);
+
+//! \brief Share internal tables (warp, merge, exposure comp, seamfind and blend tables) of an initialized context.
+//  - stitch will reference the tables of table_owner instead of computing and storing its own copy
+//  - both contexts must use the same OpenVX context set with lsSetOpenVXContext
+//  - rig, camera and output configurations, camera parameters and attributes must be identical (checked in lsInitialize)
+//  - shared tables are reference counted: contexts can be released in any order after lsInitialize of stitch
+//  - tables can't be modified by lsReinitialize, lsSetActiveOutputRegions or lsSetBlendWeights once shared
+//  - Note that this function must be called before lsInitialize of stitch and table_owner must stay valid until then
+//  - return VX_SUCCESS or error code (see log messages for further details)
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsShareInternalTables(ls_context stitch, ls_context table_owner);
 #endif
 
 //! \brief initialize the stitch context.
@@ -308,6 +395,24 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetOutputBuffer(ls_context stitch,
 LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetOverlayBuffer(ls_context stitch, cl_mem * overlay_buffer);
 LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetChromaKeyBuffer(ls_context stitch, cl_mem * chromaKey_buffer);
 
+//! \brief Set OpenCL buffers for output renditions
+//  - valid when LIVE_STITCH_ATTR_OUTPUT_RENDITIONS is greater than 1 (see lsGetOutputRenditionConfig)
+//  - rendition 0 is the output set with lsSetOutputBuffer
+//   Use of nullptr will return the control of previously set buffer
+//  - return VX_SUCCESS or error code (see log messages for further details)
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetOutputRenditionBuffer(ls_context stitch, vx_uint32 rendition, cl_mem * output_buffer);
+
+//! \brief Set host memory buffers
+//  - valid only when LIVE_STITCH_ATTR_HOST_EXECUTION is enabled (OpenCL buffer calls are rejected in that mode)
+//     input_buffer   - input buffer with images from all cameras (two planes for NV12: luma, interleaved chroma)
+//     output_buffer  - output buffer for output equirectangular image
+//     chromaKey_buffer - chroma key RGB buffer for equirectangular image
+//   Use of nullptr will return the control of previously set buffer
+//  - return VX_SUCCESS or error code (see log messages for further details)
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetCameraBufferHost(ls_context stitch, void ** input_buffer);
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetOutputBufferHost(ls_context stitch, void ** output_buffer);
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetChromaKeyBufferHost(ls_context stitch, void ** chromaKey_buffer);
+
 //! \brief Schedule a frame
 //  - only one frame can be scheduled at a time
 //  - every lsScheduleFrame call should be followed by lsWaitForCompletion call
@@ -325,6 +430,7 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsGetAttributes(ls_context stitch, v
 //! \brief Query configuration.
 //  - return VX_SUCCESS or error code (see log messages for further details)
 LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsGetOutputConfig(ls_context stitch, vx_df_image * buffer_format, vx_uint32 * buffer_width, vx_uint32 * buffer_height);
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsGetOutputRenditionConfig(ls_context stitch, vx_uint32 rendition, vx_df_image * buffer_format, vx_uint32 * buffer_width, vx_uint32 * buffer_height, vx_uint32 * buffer_stride_in_bytes);
 LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsGetCameraConfig(ls_context stitch, vx_uint32 * num_camera_rows, vx_uint32 * num_camera_columns, vx_df_image * buffer_format, vx_uint32 * buffer_width, vx_uint32 * buffer_height);
 LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsGetOverlayConfig(ls_context stitch, vx_uint32 * num_overlay_rows, vx_uint32 * num_overlay_columns, vx_df_image * buffer_format, vx_uint32 * buffer_width, vx_uint32 * buffer_height);
 LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsGetCameraParams(ls_context stitch, vx_uint32 cam_index, camera_params * par);
@@ -365,4 +471,31 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsGetExpCompGains(ls_context stitch,
 //  - weights: array of weights in output_width * output_height * num_camera
 LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetBlendWeights(ls_context stitch, vx_uint8 * weights, size_t size);
 
+//! \brief restrict stitching to active output regions.
+//  - only warp, exposure gain, blend and merge work within active regions gets processed: rest of the output is not updated
+//  - exposure comp keeps the gains solved from the last full output frame while regions are active
+//  - not supported with seamfind
+//  - call between frames: takes effect from the next lsScheduleFrame
+//  - regions: output rectangles (end is exclusive); num_regions = 0 restores full output
+//  - viewports: yaw/pitch/field of view converted to output rectangles
+//  - tile_indices: output tiles from LIVE_STITCH_ATTR_OUTPUT_TILE_NUM_X/Y in raster order
+//  - return VX_SUCCESS or error code (see log messages for further details)
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetActiveOutputRegions(ls_context stitch, vx_uint32 num_regions, const vx_rectangle_t * regions);
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetActiveViewports(ls_context stitch, vx_uint32 num_viewports, const ls_viewport * viewports);
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsSetActiveOutputTiles(ls_context stitch, vx_uint32 num_tiles, const vx_uint32 * tile_indices);
+
+//! \brief per stage and per node processing time of recent frames.
+//  - requires LIVE_STITCH_ATTR_PROFILER to be non-zero before lsInitialize
+//  - stages: LIVE_STITCH_PERF_STAGE_COUNT entries indexed by LIVE_STITCH_PERF_STAGE_* (can be NULL)
+//  - nodes: num_nodes entries, one per graph node (can be NULL)
+//  - num_nodes: number of entries in nodes as input and number of graph nodes as output (can be NULL)
+//  - return VX_SUCCESS or error code (see log messages for further details)
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsGetPerformance(ls_context stitch, ls_perf_info * stages, ls_perf_info * nodes, vx_uint32 * num_nodes);
+
+//! \brief host memory held by the context for lens model buffers and warp tables.
+//  - see LIVE_STITCH_ATTR_HOST_HUGEPAGES and LIVE_STITCH_ATTR_HOST_NUMA_NODE for placement of these buffers
+//  - OpenVX objects and the buffers of LoomIO modules are not included
+//  - return VX_SUCCESS or error code (see log messages for further details)
+LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsGetHostMemoryUsage(ls_context stitch, ls_host_memory_info * info);
+
 #endif //__LIVE_STITCH_API_H__
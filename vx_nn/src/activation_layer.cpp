@@ -32,6 +32,9 @@ struct ActivationLayerLocalData {
     miopenActivationDescriptor_t activationDesc;
     cl_mem input_mem;
     cl_mem output_mem;
+    bool fixedPoint;
+    FixedPointTensor fp_input;
+    FixedPointTensor fp_output;
 };
 
 
@@ -49,27 +52,37 @@ static vx_status VX_CALLBACK validateActivationLayer(vx_node node, const vx_refe
     // check tensor dimensions
     vx_size num_dims;
     vx_size input_dims[4], output_dims[4];
+    vx_enum input_type;
+    vx_int8 fixed_point_pos;
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
-    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
+    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DATA_TYPE, &input_type, sizeof(input_type)));
     if (num_dims != 4) return VX_ERROR_INVALID_DIMENSION;
-    if (type != VX_TYPE_FLOAT32) return VX_ERROR_INVALID_TYPE;
+    if (input_type != VX_TYPE_FLOAT32 && !isFixedPointType(input_type)) return VX_ERROR_INVALID_TYPE;
+    if (isFixedPointType(input_type)) {
+        // only RELU is supported for fixed-point tensors
+        vx_enum activationMode;
+        ERROR_CHECK_STATUS(vxCopyScalar((vx_scalar)parameters[1], &activationMode, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
+        if (activationMode != VX_NN_ACTIVATION_RELU) return VX_ERROR_NOT_SUPPORTED;
+    }
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DIMS, input_dims, sizeof(input_dims)));
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[4], VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[4], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
     if (num_dims != 4) return VX_ERROR_INVALID_DIMENSION;
-    if (type != VX_TYPE_FLOAT32) return VX_ERROR_INVALID_TYPE;
+    if (type != input_type) return VX_ERROR_INVALID_TYPE;
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[4], VX_TENSOR_DIMS, output_dims, sizeof(output_dims)));
+    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[4], VX_TENSOR_FIXED_POINT_POSITION, &fixed_point_pos, sizeof(fixed_point_pos)));
     if (output_dims[3] != input_dims[3]) return VX_ERROR_INVALID_DIMENSION;
     if (output_dims[2] != input_dims[2]) return VX_ERROR_INVALID_DIMENSION;
     if (output_dims[1] != input_dims[1]) return VX_ERROR_INVALID_DIMENSION;
     if (output_dims[0] != input_dims[0]) return VX_ERROR_INVALID_DIMENSION;
 
     // output tensor configuration
-    type = VX_TYPE_FLOAT32;
+    type = input_type;
     num_dims = 4;
     ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[4], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
     ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[4], VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
     ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[4], VX_TENSOR_DIMS, output_dims, sizeof(output_dims)));
+    ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[4], VX_TENSOR_FIXED_POINT_POSITION, &fixed_point_pos, sizeof(fixed_point_pos)));
     return VX_SUCCESS;
 }
 
@@ -80,6 +93,17 @@ static vx_status VX_CALLBACK processActivationLayer(vx_node node, const vx_refer
     ERROR_CHECK_STATUS(vxQueryNode(node, VX_NODE_LOCAL_DATA_PTR, &data, sizeof(data)));
     miopenHandle_t miopenHandle = data->handle->miopen_handle;
 
+    if (data->fixedPoint) {
+        //Fixed-point RELU on CPU.
+        cl_command_queue cmdq = data->handle->cmdq;
+        ERROR_CHECK_STATUS(mapFixedPointTensor(cmdq, data->fp_input, CL_MAP_READ));
+        ERROR_CHECK_STATUS(mapFixedPointTensor(cmdq, data->fp_output, CL_MAP_WRITE));
+        fixedPointActivationRelu(data->fp_input, data->fp_output);
+        ERROR_CHECK_STATUS(unmapFixedPointTensor(cmdq, data->fp_output));
+        ERROR_CHECK_STATUS(unmapFixedPointTensor(cmdq, data->fp_input));
+        return VX_SUCCESS;
+    }
+
     float alpha = 1.0f, beta = 0.0f;
     //miopen activation forward call.
     ERROR_CHECK_MIOPEN_STATUS((miopenActivationForward(miopenHandle, data->activationDesc, &alpha, data->inputDescriptor, data->input_mem, &beta, data->outputDescriptor, data->output_mem)));
@@ -93,6 +117,17 @@ static vx_status VX_CALLBACK initializeActivationLayer(vx_node node, const vx_re
     memset(data, 0, sizeof(*data));
     ERROR_CHECK_STATUS(createGraphHandle(node, &data->handle));
 
+    //fixed-point tensors are processed on CPU instead of MIOpen.
+    vx_enum type;
+    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
+    if (isFixedPointType(type)) {
+        data->fixedPoint = true;
+        ERROR_CHECK_STATUS(initializeFixedPointTensor((vx_tensor)parameters[0], data->fp_input));
+        ERROR_CHECK_STATUS(initializeFixedPointTensor((vx_tensor)parameters[4], data->fp_output));
+        ERROR_CHECK_STATUS(vxSetNodeAttribute(node, VX_NODE_LOCAL_DATA_PTR, &data, sizeof(data)));
+        return VX_SUCCESS;
+    }
+
     //initializing input and output Descriptors.
     vx_size input_dims[4], output_dims[4];
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DIMS, input_dims, sizeof(input_dims)));
@@ -143,9 +178,11 @@ static vx_status VX_CALLBACK uninitializeActivationLayer(vx_node node, const vx_
 {
     ActivationLayerLocalData * data = NULL;
     ERROR_CHECK_STATUS(vxQueryNode(node, VX_NODE_LOCAL_DATA_PTR, &data, sizeof(data)));
-    ERROR_CHECK_MIOPEN_STATUS(miopenDestroyActivationDescriptor(data->activationDesc));
-    ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->inputDescriptor));
-    ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->outputDescriptor));
+    if (!data->fixedPoint) {
+        ERROR_CHECK_MIOPEN_STATUS(miopenDestroyActivationDescriptor(data->activationDesc));
+        ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->inputDescriptor));
+        ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->outputDescriptor));
+    }
     if (data) {
         ERROR_CHECK_STATUS(releaseGraphHandle(node, data->handle));
         delete data;
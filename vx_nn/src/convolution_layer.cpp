@@ -38,6 +38,13 @@ struct ConvolutionLayerLocalData {
     size_t workspace_size;
     miopenTensorDescriptor_t bias_desc;
     cl_mem bias_mem;
+    bool fixedPoint;
+    FixedPointTensor fp_input;
+    FixedPointTensor fp_weights;
+    FixedPointTensor fp_bias;
+    FixedPointTensor fp_output;
+    FixedPointConvolutionParams fp_params;
+    vx_uint8 * fp_scratch;
 };
 
 static vx_status VX_CALLBACK validateConvolutionLayer(vx_node node, const vx_reference parameters[], vx_uint32 num, vx_meta_format metas[])
@@ -50,41 +57,45 @@ static vx_status VX_CALLBACK validateConvolutionLayer(vx_node node, const vx_ref
     // check tensor dimensions
     vx_size num_dims;
     vx_size input_dims[4], weights_dims[4], output_dims[4];
+    vx_enum input_type;
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
-    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
+    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DATA_TYPE, &input_type, sizeof(input_type)));
     if(num_dims != 4) return VX_ERROR_INVALID_DIMENSION;
-    if(type != VX_TYPE_FLOAT32) return VX_ERROR_INVALID_TYPE;
+    if(input_type != VX_TYPE_FLOAT32 && !isFixedPointType(input_type)) return VX_ERROR_INVALID_TYPE;
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DIMS, input_dims, sizeof(input_dims)));
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[1], VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[1], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
     if(num_dims != 4) return VX_ERROR_INVALID_DIMENSION;
-    if(type != VX_TYPE_FLOAT32) return VX_ERROR_INVALID_TYPE;
+    if(type != input_type) return VX_ERROR_INVALID_TYPE;
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[1], VX_TENSOR_DIMS, weights_dims, sizeof(weights_dims)));
     if(parameters[2]) {
         ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[2], VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
         ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[2], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
         if(num_dims != 1) return VX_ERROR_INVALID_DIMENSION;
-        if(type != VX_TYPE_FLOAT32) return VX_ERROR_INVALID_TYPE;
+        if(type != input_type) return VX_ERROR_INVALID_TYPE;
         vx_size bias_dims[1];
         ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[2], VX_TENSOR_DIMS, bias_dims, sizeof(bias_dims)));
         if(bias_dims[0] != weights_dims[3]) return VX_ERROR_INVALID_DIMENSION;
     }
+    vx_int8 fixed_point_pos;
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[4], VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[4], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
     if(num_dims != 4) return VX_ERROR_INVALID_DIMENSION;
-    if(type != VX_TYPE_FLOAT32) return VX_ERROR_INVALID_TYPE;
+    if(type != input_type) return VX_ERROR_INVALID_TYPE;
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[4], VX_TENSOR_DIMS, output_dims, sizeof(output_dims)));
+    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[4], VX_TENSOR_FIXED_POINT_POSITION, &fixed_point_pos, sizeof(fixed_point_pos)));
 
     if(output_dims[3] != input_dims[3]) return VX_ERROR_INVALID_DIMENSION;
     if(input_dims[2] != weights_dims[2]) return VX_ERROR_INVALID_DIMENSION;
     if(output_dims[2] != weights_dims[3]) return VX_ERROR_INVALID_DIMENSION;
 
     // output tensor configuration
-    type = VX_TYPE_FLOAT32;
+    type = input_type;
     num_dims = 4;
     ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[4], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
     ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[4], VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
     ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[4], VX_TENSOR_DIMS, output_dims, sizeof(output_dims)));
+    ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[4], VX_TENSOR_FIXED_POINT_POSITION, &fixed_point_pos, sizeof(fixed_point_pos)));
     return VX_SUCCESS;
 }
 
@@ -93,6 +104,25 @@ static vx_status VX_CALLBACK processConvolutionLayer(vx_node node, const vx_refe
     ConvolutionLayerLocalData * data= NULL;
     ERROR_CHECK_STATUS(vxQueryNode(node, VX_NODE_LOCAL_DATA_PTR, &data, sizeof(data)));
 
+    if(data->fixedPoint) {
+        //Fixed-point convolution on CPU.
+        cl_command_queue cmdq = data->handle->cmdq;
+        ERROR_CHECK_STATUS(mapFixedPointTensor(cmdq, data->fp_input, CL_MAP_READ));
+        ERROR_CHECK_STATUS(mapFixedPointTensor(cmdq, data->fp_weights, CL_MAP_READ));
+        if(parameters[2]) {
+            ERROR_CHECK_STATUS(mapFixedPointTensor(cmdq, data->fp_bias, CL_MAP_READ));
+        }
+        ERROR_CHECK_STATUS(mapFixedPointTensor(cmdq, data->fp_output, CL_MAP_WRITE));
+        fixedPointConvolution(data->fp_input, data->fp_weights, parameters[2] ? &data->fp_bias : NULL, data->fp_output, data->fp_params, data->fp_scratch);
+        ERROR_CHECK_STATUS(unmapFixedPointTensor(cmdq, data->fp_output));
+        if(parameters[2]) {
+            ERROR_CHECK_STATUS(unmapFixedPointTensor(cmdq, data->fp_bias));
+        }
+        ERROR_CHECK_STATUS(unmapFixedPointTensor(cmdq, data->fp_weights));
+        ERROR_CHECK_STATUS(unmapFixedPointTensor(cmdq, data->fp_input));
+        return VX_SUCCESS;
+    }
+
     //ConvolutionForward.
     ERROR_CHECK_MIOPEN_STATUS(miopenConvolutionForward(data->handle->miopen_handle, &data->alpha, data->input_desc, data->input_mem,
                                                        data->weight_desc,data->weight_mem,data->conv_desc,data->algo,&data->beta, data->output_desc, data->output_mem, data->workspace, data->workspace_size));
@@ -141,6 +171,31 @@ static vx_status VX_CALLBACK initializeConvolutionLayer(vx_node node, const vx_r
     stride_w = (output_dims[0] > 1) ? ((input_dims[0] + 2 * pad_w - kernel_w - (kernel_w - 1) * (dilation_w - 1) + ((output_dims[0] - 1) / 2)) / (output_dims[0] - 1)) : 1;
     stride_h = (output_dims[1] > 1) ? ((input_dims[1] + 2 * pad_h - kernel_h - (kernel_h - 1) * (dilation_h - 1) + ((output_dims[1] - 1) / 2)) / (output_dims[1] - 1)) : 1;
 
+    //fixed-point tensors are processed on CPU instead of MIOpen.
+    vx_enum type;
+    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
+    if(isFixedPointType(type)) {
+        data->fixedPoint = true;
+        ERROR_CHECK_STATUS(initializeFixedPointTensor((vx_tensor)parameters[0], data->fp_input));
+        ERROR_CHECK_STATUS(initializeFixedPointTensor((vx_tensor)parameters[1], data->fp_weights));
+        if(parameters[2]) {
+            ERROR_CHECK_STATUS(initializeFixedPointTensor((vx_tensor)parameters[2], data->fp_bias));
+        }
+        ERROR_CHECK_STATUS(initializeFixedPointTensor((vx_tensor)parameters[4], data->fp_output));
+        data->fp_params.pad_w = pad_w;
+        data->fp_params.pad_h = pad_h;
+        data->fp_params.stride_w = stride_w;
+        data->fp_params.stride_h = stride_h;
+        data->fp_params.dilation_w = dilation_w;
+        data->fp_params.dilation_h = dilation_h;
+        data->fp_params.overflow_policy = overflow_policy;
+        data->fp_params.rounding_policy = rounding_policy;
+        data->fp_params.num_threads = omp_get_max_threads();
+        data->fp_scratch = new vx_uint8[fixedPointConvolutionScratchSize(data->fp_input, data->fp_weights, data->fp_output, data->fp_params)];
+        ERROR_CHECK_STATUS(vxSetNodeAttribute(node, VX_NODE_LOCAL_DATA_PTR, &data, sizeof(data)));
+        return VX_SUCCESS;
+    }
+
     //input, weight and output descriptors.
     ERROR_CHECK_MIOPEN_STATUS(miopenCreateTensorDescriptor(&data->input_desc));
     ERROR_CHECK_MIOPEN_STATUS(miopenCreateTensorDescriptor(&data->weight_desc));
@@ -204,12 +259,17 @@ static vx_status VX_CALLBACK uninitializeConvolutionLayer(vx_node node, const vx
 {
     ConvolutionLayerLocalData * data = NULL;
     ERROR_CHECK_STATUS(vxQueryNode(node, VX_NODE_LOCAL_DATA_PTR, &data, sizeof(data)));
-    if(data->workspace && clReleaseMemObject(data->workspace) != 0) return VX_FAILURE;
-    ERROR_CHECK_MIOPEN_STATUS(miopenDestroyConvolutionDescriptor(data->conv_desc));
-    ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->input_desc));
-    ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->output_desc));
-    ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->weight_desc));
-    ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->bias_desc));
+    if(data->fixedPoint) {
+        delete[] data->fp_scratch;
+    }
+    else {
+        if(data->workspace && clReleaseMemObject(data->workspace) != 0) return VX_FAILURE;
+        ERROR_CHECK_MIOPEN_STATUS(miopenDestroyConvolutionDescriptor(data->conv_desc));
+        ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->input_desc));
+        ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->output_desc));
+        ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->weight_desc));
+        ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->bias_desc));
+    }
     if (data) {
         ERROR_CHECK_STATUS(releaseGraphHandle(node, data->handle));
         delete data;
@@ -0,0 +1,384 @@
+/*
+Copyright (c) 2017 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "kernels.h"
+#include <smmintrin.h>
+#include <math.h>
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////////////////
+// Fixed-point tensors hold value * 2^fixed_point_pos in VX_TYPE_INT8 or
+// VX_TYPE_INT16 elements (e.g., Q7.8 for VX_TYPE_INT16 with position 8).
+// Products are accumulated in 32-bit integers at (input + weights) fixed point
+// position and requantized to the output position with rounding_policy and
+// overflow_policy applied.
+
+bool isFixedPointType(vx_enum type)
+{
+    return (type == VX_TYPE_INT8 || type == VX_TYPE_INT16) ? true : false;
+}
+
+vx_status initializeFixedPointTensor(vx_tensor tensor, FixedPointTensor& t)
+{
+    memset(&t, 0, sizeof(t));
+    ERROR_CHECK_STATUS(vxQueryTensor(tensor, VX_TENSOR_DATA_TYPE, &t.type, sizeof(t.type)));
+    ERROR_CHECK_STATUS(vxQueryTensor(tensor, VX_TENSOR_FIXED_POINT_POSITION, &t.fixed_point_pos, sizeof(t.fixed_point_pos)));
+    ERROR_CHECK_STATUS(vxQueryTensor(tensor, VX_TENSOR_NUMBER_OF_DIMS, &t.num_dims, sizeof(t.num_dims)));
+    if(!isFixedPointType(t.type)) return VX_ERROR_INVALID_TYPE;
+    if(t.num_dims < 1 || t.num_dims > 4) return VX_ERROR_INVALID_DIMENSION;
+    ERROR_CHECK_STATUS(vxQueryTensor(tensor, VX_TENSOR_DIMS, t.dims, t.num_dims * sizeof(vx_size)));
+    ERROR_CHECK_STATUS(vxQueryTensor(tensor, VX_TENSOR_BUFFER_OPENCL, &t.mem, sizeof(t.mem)));
+    t.count = 1;
+    for(vx_size i = 0; i < t.num_dims; i++) t.count *= t.dims[i];
+    for(vx_size i = t.num_dims; i < 4; i++) t.dims[i] = 1;
+    return VX_SUCCESS;
+}
+
+vx_status mapFixedPointTensor(cl_command_queue cmdq, FixedPointTensor& t, cl_map_flags flags)
+{
+    cl_int err = CL_SUCCESS;
+    size_t size = t.count * (t.type == VX_TYPE_INT8 ? sizeof(vx_int8) : sizeof(vx_int16));
+    t.ptr = clEnqueueMapBuffer(cmdq, t.mem, CL_TRUE, flags, 0, size, 0, NULL, NULL, &err);
+    if(err || !t.ptr) {
+        vxAddLogEntry(NULL, VX_FAILURE, "ERROR: mapFixedPointTensor: clEnqueueMapBuffer(%d bytes) => %d\n", (int)size, err);
+        return VX_FAILURE;
+    }
+    return VX_SUCCESS;
+}
+
+vx_status unmapFixedPointTensor(cl_command_queue cmdq, FixedPointTensor& t)
+{
+    cl_int err = clEnqueueUnmapMemObject(cmdq, t.mem, t.ptr, 0, NULL, NULL);
+    t.ptr = NULL;
+    if(err) {
+        vxAddLogEntry(NULL, VX_FAILURE, "ERROR: unmapFixedPointTensor: clEnqueueUnmapMemObject() => %d\n", err);
+        return VX_FAILURE;
+    }
+    return VX_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// element access and requantization helpers
+
+static inline vx_int32 loadFixedPoint(const void * ptr, vx_size index, vx_enum type)
+{
+    return (type == VX_TYPE_INT8) ? ((const vx_int8 *)ptr)[index] : ((const vx_int16 *)ptr)[index];
+}
+
+static inline void storeFixedPoint(void * ptr, vx_size index, vx_enum type, vx_int64 value, vx_enum overflow_policy)
+{
+    if(type == VX_TYPE_INT8) {
+        if(overflow_policy == VX_CONVERT_POLICY_SATURATE)
+            value = (value < -128) ? -128 : ((value > 127) ? 127 : value);
+        ((vx_int8 *)ptr)[index] = (vx_int8)value;
+    }
+    else {
+        if(overflow_policy == VX_CONVERT_POLICY_SATURATE)
+            value = (value < -32768) ? -32768 : ((value > 32767) ? 32767 : value);
+        ((vx_int16 *)ptr)[index] = (vx_int16)value;
+    }
+}
+
+// moves value from (to + shift) fixed point position to "to" position: right shift when shift > 0
+static inline vx_int64 shiftFixedPoint(vx_int64 value, int shift, vx_enum rounding_policy)
+{
+    if(shift <= 0) {
+        return value * ((vx_int64)1 << -shift);
+    }
+    if(rounding_policy == VX_ROUND_POLICY_TO_ZERO) {
+        return (value >= 0) ? (value >> shift) : -((-value) >> shift);
+    }
+    vx_int64 half = (vx_int64)1 << (shift - 1);
+    vx_int64 result = (value + half) >> shift;
+    if((value & (((vx_int64)1 << shift) - 1)) == half && (result & 1)) {
+        // tie: round to even
+        result -= 1;
+    }
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// SSE4.1 dot products (pmaddwd): int8 products accumulate in 32 bits, int16
+// products can reach 2^30 and are widened to 64-bit accumulators
+
+static inline vx_int32 horizontalSum(__m128i acc)
+{
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0x4e));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0xb1));
+    return _mm_cvtsi128_si32(acc);
+}
+
+static inline vx_int64 dotProduct(const vx_int16 * a, const vx_int16 * b, vx_size n)
+{
+    __m128i acc = _mm_setzero_si128();
+    vx_size i = 0;
+    for(; i + 8 <= n; i += 8) {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + i));
+        __m128i prod = _mm_madd_epi16(va, vb);
+        acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(prod));
+        acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(_mm_srli_si128(prod, 8)));
+    }
+    vx_int64 sum = _mm_cvtsi128_si64(acc) + _mm_extract_epi64(acc, 1);
+    for(; i < n; i++) {
+        sum += (vx_int32)a[i] * (vx_int32)b[i];
+    }
+    return sum;
+}
+
+static inline vx_int32 dotProduct(const vx_int8 * a, const vx_int8 * b, vx_size n)
+{
+    // int8 lanes are sign-extended to int16 before pmaddwd: unlike pmaddubsw this
+    // can't saturate the intermediate 16-bit pair sums and works for signed activations
+    __m128i acc = _mm_setzero_si128();
+    vx_size i = 0;
+    for(; i + 16 <= n; i += 16) {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + i));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_cvtepi8_epi16(va), _mm_cvtepi8_epi16(vb)));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_cvtepi8_epi16(_mm_srli_si128(va, 8)), _mm_cvtepi8_epi16(_mm_srli_si128(vb, 8))));
+    }
+    vx_int32 sum = horizontalSum(acc);
+    for(; i < n; i++) {
+        sum += (vx_int32)a[i] * (vx_int32)b[i];
+    }
+    return sum;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// convolution: receptive fields of one output row are gathered (im2col) into
+// scratch so that each output element is a contiguous dot product with a row of
+// weights (weights are stored as [K][C][kernel_h][kernel_w] which matches the
+// gathered patch layout). Output rows are split across threads, each gathering
+// into its own row of scratch; when there are fewer rows than threads the
+// output channels of a row are split instead.
+
+vx_size fixedPointConvolutionScratchSize(const FixedPointTensor& input, const FixedPointTensor& weights, const FixedPointTensor& output,
+                                         const FixedPointConvolutionParams& params)
+{
+    vx_size patch_size = weights.dims[0] * weights.dims[1] * weights.dims[2];
+    vx_size elem_size = (input.type == VX_TYPE_INT8) ? sizeof(vx_int8) : sizeof(vx_int16);
+    return params.num_threads * output.dims[0] * patch_size * elem_size;
+}
+
+template <typename T>
+static void fixedPointConvolutionT(const FixedPointTensor& input, const FixedPointTensor& weights, const FixedPointTensor * bias, const FixedPointTensor& output,
+                                   const FixedPointConvolutionParams& params, T * scratch)
+{
+    vx_int64 W = input.dims[0], H = input.dims[1], C = input.dims[2], N = input.dims[3];
+    vx_int64 kernel_w = weights.dims[0], kernel_h = weights.dims[1], K = weights.dims[3];
+    vx_int64 ow = output.dims[0], oh = output.dims[1];
+    vx_int64 stride_w = params.stride_w, stride_h = params.stride_h, pad_w = params.pad_w, pad_h = params.pad_h;
+    vx_int64 dilation_w = params.dilation_w, dilation_h = params.dilation_h;
+    vx_size patch_size = (vx_size)(C * kernel_h * kernel_w);
+    int acc_fpp = input.fixed_point_pos + weights.fixed_point_pos;
+    int shift = acc_fpp - output.fixed_point_pos;
+    int num_threads = (int)params.num_threads;
+    int rows = (int)(N * oh);
+    const T * src = (const T *)input.ptr;
+    const T * wts = (const T *)weights.ptr;
+    // gather receptive fields of output pixels [ox_begin, ox_end) of a row
+    auto gatherPatches = [&](T * patch, vx_int64 n, vx_int64 oy, vx_int64 ox_begin, vx_int64 ox_end) {
+        for(vx_int64 ox = ox_begin; ox < ox_end; ox++) {
+            T * dst = patch + ox * patch_size;
+            vx_int64 x0 = ox * stride_w - pad_w;
+            vx_int64 y0 = oy * stride_h - pad_h;
+            for(vx_int64 c = 0; c < C; c++) {
+                const T * plane = src + (n * C + c) * H * W;
+                for(vx_int64 ky = 0; ky < kernel_h; ky++) {
+                    vx_int64 y = y0 + ky * dilation_h;
+                    for(vx_int64 kx = 0; kx < kernel_w; kx++) {
+                        vx_int64 x = x0 + kx * dilation_w;
+                        *dst++ = (y >= 0 && y < H && x >= 0 && x < W) ? plane[y * W + x] : 0;
+                    }
+                }
+            }
+        }
+    };
+    // dot product of output channel k weights with all gathered patches of a row
+    auto computeChannel = [&](const T * patch, vx_int64 n, vx_int64 oy, vx_int64 k) {
+        const T * w = wts + k * patch_size;
+        vx_int64 bias_value = 0;
+        if(bias) {
+            bias_value = shiftFixedPoint(loadFixedPoint(bias->ptr, (vx_size)k, bias->type), bias->fixed_point_pos - acc_fpp, VX_ROUND_POLICY_TO_NEAREST_EVEN);
+        }
+        vx_size dst_index = (vx_size)(((n * K + k) * oh + oy) * ow);
+        for(vx_int64 ox = 0; ox < ow; ox++) {
+            vx_int64 acc = (vx_int64)dotProduct(w, patch + ox * patch_size, patch_size) + bias_value;
+            storeFixedPoint(output.ptr, dst_index + ox, output.type, shiftFixedPoint(acc, shift, params.rounding_policy), params.overflow_policy);
+        }
+    };
+    if(rows >= num_threads) {
+        #pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+        for(int row = 0; row < rows; row++) {
+            T * patch = scratch + omp_get_thread_num() * ow * patch_size;
+            gatherPatches(patch, row / oh, row % oh, 0, ow);
+            for(vx_int64 k = 0; k < K; k++) {
+                computeChannel(patch, row / oh, row % oh, k);
+            }
+        }
+    }
+    else {
+        for(int row = 0; row < rows; row++) {
+            #pragma omp parallel num_threads(num_threads)
+            {
+                #pragma omp for
+                for(int ox = 0; ox < (int)ow; ox++) {
+                    gatherPatches(scratch, row / oh, row % oh, ox, ox + 1);
+                }
+                #pragma omp for
+                for(int k = 0; k < (int)K; k++) {
+                    computeChannel(scratch, row / oh, row % oh, k);
+                }
+            }
+        }
+    }
+}
+
+void fixedPointConvolution(const FixedPointTensor& input, const FixedPointTensor& weights, const FixedPointTensor * bias, const FixedPointTensor& output,
+                           const FixedPointConvolutionParams& params, vx_uint8 * scratch)
+{
+    if(input.type == VX_TYPE_INT8)
+        fixedPointConvolutionT<vx_int8>(input, weights, bias, output, params, (vx_int8 *)scratch);
+    else
+        fixedPointConvolutionT<vx_int16>(input, weights, bias, output, params, (vx_int16 *)scratch);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// fully connected: each output is a dot product of the flattened input of a batch
+// with a row of weights, outputs of all batches are split across threads
+
+void fixedPointFullyConnected(const FixedPointTensor& input, const FixedPointTensor& weights, const FixedPointTensor * bias, const FixedPointTensor& output,
+                              vx_enum overflow_policy, vx_enum rounding_policy)
+{
+    vx_size N = input.dims[3], K = weights.dims[3];
+    vx_size size = input.count / N;
+    int acc_fpp = input.fixed_point_pos + weights.fixed_point_pos;
+    int shift = acc_fpp - output.fixed_point_pos;
+    int outputs = (int)(N * K);
+    #pragma omp parallel for
+    for(int i = 0; i < outputs; i++) {
+        vx_size n = (vx_size)i / K, k = (vx_size)i % K;
+        vx_int64 acc;
+        if(input.type == VX_TYPE_INT8)
+            acc = dotProduct((const vx_int8 *)input.ptr + n * size, (const vx_int8 *)weights.ptr + k * size, size);
+        else
+            acc = dotProduct((const vx_int16 *)input.ptr + n * size, (const vx_int16 *)weights.ptr + k * size, size);
+        if(bias) {
+            acc += shiftFixedPoint(loadFixedPoint(bias->ptr, k, bias->type), bias->fixed_point_pos - acc_fpp, VX_ROUND_POLICY_TO_NEAREST_EVEN);
+        }
+        storeFixedPoint(output.ptr, (vx_size)i, output.type, shiftFixedPoint(acc, shift, rounding_policy), overflow_policy);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////
+// pooling: average uses the Caffe convention of counting padded elements
+// inside the image plus padding area, output rows of all planes are split
+// across threads
+
+void fixedPointPooling(const FixedPointTensor& input, const FixedPointTensor& output, vx_enum pooling_type,
+                       vx_size kernel_w, vx_size kernel_h, vx_size pad_w, vx_size pad_h, vx_size stride_w, vx_size stride_h)
+{
+    vx_int64 kw = kernel_w, kh = kernel_h, pw = pad_w, ph = pad_h, sw = stride_w, sh = stride_h;
+    vx_int64 W = input.dims[0], H = input.dims[1], planes = input.dims[2] * input.dims[3];
+    vx_int64 ow = output.dims[0], oh = output.dims[1];
+    int shift = input.fixed_point_pos - output.fixed_point_pos;
+    int rows = (int)(planes * oh);
+    #pragma omp parallel for
+    for(int row = 0; row < rows; row++) {
+        vx_int64 p = row / oh, oy = row % oh;
+        vx_size src_base = (vx_size)(p * H * W);
+        vx_size dst_base = (vx_size)(p * oh * ow);
+        vx_int64 ys = oy * sh - ph, ye = ys + kh;
+        if(ye > H + ph) ye = H + ph;
+        vx_int64 pool_h = ye - ys;
+        if(ys < 0) ys = 0;
+        if(ye > H) ye = H;
+        for(vx_int64 ox = 0; ox < ow; ox++) {
+            vx_int64 xs = ox * sw - pw, xe = xs + kw;
+            if(xe > W + pw) xe = W + pw;
+            vx_int64 pool_w = xe - xs;
+            if(xs < 0) xs = 0;
+            if(xe > W) xe = W;
+            vx_int64 value;
+            if(pooling_type == VX_NN_POOLING_MAX) {
+                value = (ys < ye && xs < xe) ? INT32_MIN : 0;
+                for(vx_int64 y = ys; y < ye; y++) {
+                    for(vx_int64 x = xs; x < xe; x++) {
+                        vx_int64 v = loadFixedPoint(input.ptr, src_base + (vx_size)(y * W + x), input.type);
+                        if(v > value) value = v;
+                    }
+                }
+                value = shiftFixedPoint(value, shift, VX_ROUND_POLICY_TO_NEAREST_EVEN);
+            }
+            else {
+                vx_int64 sum = 0;
+                for(vx_int64 y = ys; y < ye; y++) {
+                    for(vx_int64 x = xs; x < xe; x++) {
+                        sum += loadFixedPoint(input.ptr, src_base + (vx_size)(y * W + x), input.type);
+                    }
+                }
+                double scale = ldexp(1.0, -shift) / (double)(pool_h * pool_w);
+                value = (vx_int64)nearbyint((double)sum * scale);
+            }
+            storeFixedPoint(output.ptr, dst_base + (vx_size)(oy * ow + ox), output.type, value, VX_CONVERT_POLICY_SATURATE);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////
+// activation: only RELU is supported for fixed-point tensors
+
+void fixedPointActivationRelu(const FixedPointTensor& input, const FixedPointTensor& output)
+{
+    int shift = input.fixed_point_pos - output.fixed_point_pos;
+    if(shift == 0 && input.type == output.type && input.type == VX_TYPE_INT16) {
+        const __m128i zero = _mm_setzero_si128();
+        const vx_int16 * src = (const vx_int16 *)input.ptr;
+        vx_int16 * dst = (vx_int16 *)output.ptr;
+        vx_size i = 0;
+        for(; i + 8 <= input.count; i += 8) {
+            _mm_storeu_si128((__m128i *)(dst + i), _mm_max_epi16(_mm_loadu_si128((const __m128i *)(src + i)), zero));
+        }
+        for(; i < input.count; i++) {
+            dst[i] = src[i] > 0 ? src[i] : 0;
+        }
+    }
+    else if(shift == 0 && input.type == output.type && input.type == VX_TYPE_INT8) {
+        const __m128i zero = _mm_setzero_si128();
+        const vx_int8 * src = (const vx_int8 *)input.ptr;
+        vx_int8 * dst = (vx_int8 *)output.ptr;
+        vx_size i = 0;
+        for(; i + 16 <= input.count; i += 16) {
+            _mm_storeu_si128((__m128i *)(dst + i), _mm_max_epi8(_mm_loadu_si128((const __m128i *)(src + i)), zero));
+        }
+        for(; i < input.count; i++) {
+            dst[i] = src[i] > 0 ? src[i] : 0;
+        }
+    }
+    else {
+        for(vx_size i = 0; i < input.count; i++) {
+            vx_int64 v = loadFixedPoint(input.ptr, i, input.type);
+            storeFixedPoint(output.ptr, i, output.type, shiftFixedPoint(v > 0 ? v : 0, shift, VX_ROUND_POLICY_TO_NEAREST_EVEN), VX_CONVERT_POLICY_SATURATE);
+        }
+    }
+}
@@ -38,6 +38,13 @@ struct FullyConnectedLayerLocalData {
     float alpha;
     float beta;
     cl_mem workspace;
+    bool fixedPoint;
+    FixedPointTensor fp_input;
+    FixedPointTensor fp_weights;
+    FixedPointTensor fp_bias;
+    FixedPointTensor fp_output;
+    vx_enum overflow_policy;
+    vx_enum rounding_policy;
 };
 
 static vx_status VX_CALLBACK validateFullyConnectedLayer(vx_node node, const vx_reference parameters[], vx_uint32 num, vx_meta_format metas[])
@@ -52,40 +59,44 @@ static vx_status VX_CALLBACK validateFullyConnectedLayer(vx_node node, const vx_
     // check tensor dimensions
     vx_size num_dims;
     vx_size input_dims[4], weights_dims[4], output_dims[4];
+    vx_enum input_type;
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
-    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
+    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DATA_TYPE, &input_type, sizeof(input_type)));
     if(num_dims != 4) return VX_ERROR_INVALID_DIMENSION;
-    if(type != VX_TYPE_FLOAT32) return VX_ERROR_INVALID_TYPE;
+    if(input_type != VX_TYPE_FLOAT32 && !isFixedPointType(input_type)) return VX_ERROR_INVALID_TYPE;
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DIMS, input_dims, sizeof(input_dims)));
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[1], VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[1], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
     if(num_dims != 4) return VX_ERROR_INVALID_DIMENSION;
-    if(type != VX_TYPE_FLOAT32) return VX_ERROR_INVALID_TYPE;
+    if(type != input_type) return VX_ERROR_INVALID_TYPE;
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[1], VX_TENSOR_DIMS, weights_dims, sizeof(weights_dims)));
     if(parameters[2]) {
         ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[2], VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
         ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[2], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
         if(num_dims != 1) return VX_ERROR_INVALID_DIMENSION;
-        if(type != VX_TYPE_FLOAT32) return VX_ERROR_INVALID_TYPE;
+        if(type != input_type) return VX_ERROR_INVALID_TYPE;
         vx_size bias_dims[1];
         ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[2], VX_TENSOR_DIMS, bias_dims, sizeof(bias_dims)));
         if(bias_dims[0] != weights_dims[3]) return VX_ERROR_INVALID_DIMENSION;
     }
+    vx_int8 fixed_point_pos;
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[5], VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[5], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
     if(num_dims != 4) return VX_ERROR_INVALID_DIMENSION;
-    if(type != VX_TYPE_FLOAT32) return VX_ERROR_INVALID_TYPE;
+    if(type != input_type) return VX_ERROR_INVALID_TYPE;
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[5], VX_TENSOR_DIMS, output_dims, sizeof(output_dims)));
+    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[5], VX_TENSOR_FIXED_POINT_POSITION, &fixed_point_pos, sizeof(fixed_point_pos)));
     if(output_dims[3] != input_dims[3]) return VX_ERROR_INVALID_DIMENSION;
     if(input_dims[2] != weights_dims[2]) return VX_ERROR_INVALID_DIMENSION;
     if(output_dims[2] != weights_dims[3]) return VX_ERROR_INVALID_DIMENSION;
 
     // output tensor configuration
-    type = VX_TYPE_FLOAT32;
+    type = input_type;
     num_dims = 4;
     ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[5], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
     ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[5], VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
     ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[5], VX_TENSOR_DIMS, output_dims, sizeof(output_dims)));
+    ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[5], VX_TENSOR_FIXED_POINT_POSITION, &fixed_point_pos, sizeof(fixed_point_pos)));
     return VX_SUCCESS;
 }
 
@@ -95,6 +106,26 @@ static vx_status VX_CALLBACK processFullyConnectedLayer(vx_node node, const vx_r
     ERROR_CHECK_STATUS(vxQueryNode(node, VX_NODE_LOCAL_DATA_PTR, &data, sizeof(data)));
     miopenHandle_t miopen_handle = data->handle->miopen_handle;
 
+    if(data->fixedPoint) {
+        //Fixed-point fully connected layer on CPU.
+        cl_command_queue cmdq = data->handle->cmdq;
+        ERROR_CHECK_STATUS(mapFixedPointTensor(cmdq, data->fp_input, CL_MAP_READ));
+        ERROR_CHECK_STATUS(mapFixedPointTensor(cmdq, data->fp_weights, CL_MAP_READ));
+        if(parameters[2]) {
+            ERROR_CHECK_STATUS(mapFixedPointTensor(cmdq, data->fp_bias, CL_MAP_READ));
+        }
+        ERROR_CHECK_STATUS(mapFixedPointTensor(cmdq, data->fp_output, CL_MAP_WRITE));
+        fixedPointFullyConnected(data->fp_input, data->fp_weights, parameters[2] ? &data->fp_bias : NULL, data->fp_output,
+                                 data->overflow_policy, data->rounding_policy);
+        ERROR_CHECK_STATUS(unmapFixedPointTensor(cmdq, data->fp_output));
+        if(parameters[2]) {
+            ERROR_CHECK_STATUS(unmapFixedPointTensor(cmdq, data->fp_bias));
+        }
+        ERROR_CHECK_STATUS(unmapFixedPointTensor(cmdq, data->fp_weights));
+        ERROR_CHECK_STATUS(unmapFixedPointTensor(cmdq, data->fp_input));
+        return VX_SUCCESS;
+    }
+
     //ConvolutionForward.
     ERROR_CHECK_MIOPEN_STATUS(miopenConvolutionForward(data->handle->miopen_handle, &data->alpha, data->input_desc, data->input_mem,
                                                        data->weight_desc, data->weight_mem, data->convdesc, data->algo, &data->beta, data->output_desc, data->output_mem, data->workspace, data->workspace_size));
@@ -114,6 +145,23 @@ static vx_status VX_CALLBACK initializeFullyConnectedLayer(vx_node node, const v
     memset(data, 0, sizeof(*data));
     ERROR_CHECK_STATUS(createGraphHandle(node, &data->handle));
 
+    //fixed-point tensors are processed on CPU instead of MIOpen.
+    vx_enum type;
+    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
+    if(isFixedPointType(type)) {
+        data->fixedPoint = true;
+        ERROR_CHECK_STATUS(initializeFixedPointTensor((vx_tensor)parameters[0], data->fp_input));
+        ERROR_CHECK_STATUS(initializeFixedPointTensor((vx_tensor)parameters[1], data->fp_weights));
+        if(parameters[2]) {
+            ERROR_CHECK_STATUS(initializeFixedPointTensor((vx_tensor)parameters[2], data->fp_bias));
+        }
+        ERROR_CHECK_STATUS(initializeFixedPointTensor((vx_tensor)parameters[5], data->fp_output));
+        ERROR_CHECK_STATUS(vxCopyScalar((vx_scalar)parameters[3], &data->overflow_policy, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
+        ERROR_CHECK_STATUS(vxCopyScalar((vx_scalar)parameters[4], &data->rounding_policy, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
+        ERROR_CHECK_STATUS(vxSetNodeAttribute(node, VX_NODE_LOCAL_DATA_PTR, &data, sizeof(data)));
+        return VX_SUCCESS;
+    }
+
     //input,weight,bias,output descriptors.
     miopenConvolutionMode_t mode = miopenConvolution;
     vx_size input_dims[4], weights_dims[4], output_dims[4], bias_dims[1];;
@@ -182,12 +230,14 @@ static vx_status VX_CALLBACK uninitializeFullyConnectedLayer(vx_node node, const
 {
     FullyConnectedLayerLocalData * data = NULL;
     ERROR_CHECK_STATUS(vxQueryNode(node, VX_NODE_LOCAL_DATA_PTR, &data, sizeof(data)));
-    if(data->workspace && clReleaseMemObject(data->workspace) != 0 ) return VX_FAILURE;
-    ERROR_CHECK_MIOPEN_STATUS(miopenDestroyConvolutionDescriptor(data->convdesc));
-    ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->input_desc));
-    ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->output_desc));
-    ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->weight_desc));
-    ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->bias_desc));
+    if(!data->fixedPoint) {
+        if(data->workspace && clReleaseMemObject(data->workspace) != 0 ) return VX_FAILURE;
+        ERROR_CHECK_MIOPEN_STATUS(miopenDestroyConvolutionDescriptor(data->convdesc));
+        ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->input_desc));
+        ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->output_desc));
+        ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->weight_desc));
+        ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->bias_desc));
+    }
     if (data) {
         ERROR_CHECK_STATUS(releaseGraphHandle(node, data->handle));
         delete data;
@@ -40,6 +40,7 @@ THE SOFTWARE.
 #include <miopen/miopen.h>
 #include <iostream>
 #include <string.h>
+#include <omp.h>
 #if __APPLE__
 #include <opencl.h>
 #else
@@ -90,6 +91,29 @@ struct NeuralNetworkCommonHandle {
     bool exhaustiveSearch;
 };
 
+//////////////////////////////////////////////////////////////////////
+//! \brief Fixed-point tensor (VX_TYPE_INT8 or VX_TYPE_INT16 with fixed_point_position)
+//!        that is processed on the CPU by mapping its OpenCL buffer
+struct FixedPointTensor {
+    vx_enum type;
+    vx_int8 fixed_point_pos;
+    vx_size num_dims;
+    vx_size dims[4];
+    vx_size count;
+    cl_mem mem;
+    void * ptr; // valid only between mapFixedPointTensor() and unmapFixedPointTensor()
+};
+
+//! \brief Convolution geometry and output policies for fixedPointConvolution
+struct FixedPointConvolutionParams {
+    vx_size pad_w, pad_h;
+    vx_size stride_w, stride_h;
+    vx_size dilation_w, dilation_h;
+    vx_enum overflow_policy;
+    vx_enum rounding_policy;
+    vx_size num_threads; // OpenMP threads, each needs its own row of scratch
+};
+
 //////////////////////////////////////////////////////////////////////
 //! \brief The utility functions
 vx_node createNode(vx_graph graph, vx_enum kernelEnum, vx_reference params[], vx_uint32 num);
@@ -97,6 +121,22 @@ vx_reference getNodeParameterByIndex(vx_node node, vx_uint32 index);
 vx_status createGraphHandle(vx_node node, NeuralNetworkCommonHandle ** pHandle);
 vx_status releaseGraphHandle(vx_node node, NeuralNetworkCommonHandle * handle);
 
+//////////////////////////////////////////////////////////////////////
+//! \brief The fixed-point CPU kernels (see fixed_point_kernels.cpp)
+bool isFixedPointType(vx_enum type);
+vx_status initializeFixedPointTensor(vx_tensor tensor, FixedPointTensor& t);
+vx_status mapFixedPointTensor(cl_command_queue cmdq, FixedPointTensor& t, cl_map_flags flags);
+vx_status unmapFixedPointTensor(cl_command_queue cmdq, FixedPointTensor& t);
+vx_size fixedPointConvolutionScratchSize(const FixedPointTensor& input, const FixedPointTensor& weights, const FixedPointTensor& output,
+                                         const FixedPointConvolutionParams& params);
+void fixedPointConvolution(const FixedPointTensor& input, const FixedPointTensor& weights, const FixedPointTensor * bias, const FixedPointTensor& output,
+                           const FixedPointConvolutionParams& params, vx_uint8 * scratch);
+void fixedPointFullyConnected(const FixedPointTensor& input, const FixedPointTensor& weights, const FixedPointTensor * bias, const FixedPointTensor& output,
+                              vx_enum overflow_policy, vx_enum rounding_policy);
+void fixedPointPooling(const FixedPointTensor& input, const FixedPointTensor& output, vx_enum pooling_type,
+                       vx_size kernel_w, vx_size kernel_h, vx_size pad_w, vx_size pad_h, vx_size stride_w, vx_size stride_h);
+void fixedPointActivationRelu(const FixedPointTensor& input, const FixedPointTensor& output);
+
 //////////////////////////////////////////////////////////////////////
 //! \brief The kernel publish functions
 vx_status publishConvolutionLayer(vx_context context);
@@ -34,6 +34,13 @@ struct PoolingLayerLocalData {
     cl_mem pooling_workspace;
     size_t pooling_workspace_size;
     miopenPoolingMode_t mode;
+    bool fixedPoint;
+    FixedPointTensor fp_input;
+    FixedPointTensor fp_output;
+    vx_enum fp_pooling_type;
+    vx_size fp_kernel_w, fp_kernel_h;
+    vx_size fp_pad_w, fp_pad_h;
+    vx_size fp_stride_w, fp_stride_h;
 };
 
 static vx_status VX_CALLBACK validatePoolingLayer(vx_node node, const vx_reference parameters[], vx_uint32 num, vx_meta_format metas[])
@@ -56,25 +63,29 @@ static vx_status VX_CALLBACK validatePoolingLayer(vx_node node, const vx_referen
     // check tensor dimensions
     vx_size num_dims;
     vx_size input_dims[4], output_dims[4];
+    vx_enum input_type;
+    vx_int8 fixed_point_pos;
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
-    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
+    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DATA_TYPE, &input_type, sizeof(input_type)));
     if(num_dims != 4) return VX_ERROR_INVALID_DIMENSION;
-    if(type != VX_TYPE_FLOAT32) return VX_ERROR_INVALID_TYPE;
+    if(input_type != VX_TYPE_FLOAT32 && !isFixedPointType(input_type)) return VX_ERROR_INVALID_TYPE;
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DIMS, input_dims, sizeof(input_dims)));
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[7], VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[7], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
     if(num_dims != 4) return VX_ERROR_INVALID_DIMENSION;
-    if(type != VX_TYPE_FLOAT32) return VX_ERROR_INVALID_TYPE;
+    if(type != input_type) return VX_ERROR_INVALID_TYPE;
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[7], VX_TENSOR_DIMS, output_dims, sizeof(output_dims)));
+    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[7], VX_TENSOR_FIXED_POINT_POSITION, &fixed_point_pos, sizeof(fixed_point_pos)));
     if (output_dims[2] != input_dims[2]) return VX_ERROR_INVALID_DIMENSION;
     if (output_dims[3] != input_dims[3]) return VX_ERROR_INVALID_DIMENSION;
 
     // output tensor configuration
-    type = VX_TYPE_FLOAT32;
+    type = input_type;
     num_dims = 4;
     ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[7], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
     ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[7], VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
     ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[7], VX_TENSOR_DIMS, output_dims, sizeof(output_dims)));
+    ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[7], VX_TENSOR_FIXED_POINT_POSITION, &fixed_point_pos, sizeof(fixed_point_pos)));
     return VX_SUCCESS;
 }
 
@@ -84,6 +95,18 @@ static vx_status VX_CALLBACK processPoolingLayer(vx_node node, const vx_referenc
     ERROR_CHECK_STATUS(vxQueryNode(node, VX_NODE_LOCAL_DATA_PTR, &data, sizeof(data)));
     miopenHandle_t miopenHandle = data->handle->miopen_handle;
 
+    if(data->fixedPoint) {
+        //Fixed-point pooling on CPU.
+        cl_command_queue cmdq = data->handle->cmdq;
+        ERROR_CHECK_STATUS(mapFixedPointTensor(cmdq, data->fp_input, CL_MAP_READ));
+        ERROR_CHECK_STATUS(mapFixedPointTensor(cmdq, data->fp_output, CL_MAP_WRITE));
+        fixedPointPooling(data->fp_input, data->fp_output, data->fp_pooling_type, data->fp_kernel_w, data->fp_kernel_h,
+                          data->fp_pad_w, data->fp_pad_h, data->fp_stride_w, data->fp_stride_h);
+        ERROR_CHECK_STATUS(unmapFixedPointTensor(cmdq, data->fp_output));
+        ERROR_CHECK_STATUS(unmapFixedPointTensor(cmdq, data->fp_input));
+        return VX_SUCCESS;
+    }
+
     ERROR_CHECK_MIOPEN_STATUS(miopenPoolingForward(miopenHandle, data->pool_desc, &data->alpha, data->input_desc, data->input_mem, &data->beta, data->output_desc, data->output_mem, false, data->pooling_workspace, data->pooling_workspace_size));
 
     return VX_SUCCESS;
@@ -105,6 +128,26 @@ static vx_status VX_CALLBACK initializePoolingLayer(vx_node node, const vx_refer
         data->mode = miopenPoolingAverage;
     }
 
+    //fixed-point tensors are processed on CPU instead of MIOpen.
+    vx_enum type;
+    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
+    if(isFixedPointType(type)) {
+        data->fixedPoint = true;
+        data->fp_pooling_type = modeType;
+        ERROR_CHECK_STATUS(initializeFixedPointTensor((vx_tensor)parameters[0], data->fp_input));
+        ERROR_CHECK_STATUS(initializeFixedPointTensor((vx_tensor)parameters[7], data->fp_output));
+        ERROR_CHECK_STATUS(vxCopyScalar((vx_scalar)parameters[2], &data->fp_kernel_w, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
+        ERROR_CHECK_STATUS(vxCopyScalar((vx_scalar)parameters[3], &data->fp_kernel_h, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
+        ERROR_CHECK_STATUS(vxCopyScalar((vx_scalar)parameters[4], &data->fp_pad_w, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
+        ERROR_CHECK_STATUS(vxCopyScalar((vx_scalar)parameters[5], &data->fp_pad_h, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
+        vx_size input_w = data->fp_input.dims[0], input_h = data->fp_input.dims[1];
+        vx_size output_w = data->fp_output.dims[0], output_h = data->fp_output.dims[1];
+        data->fp_stride_w = (output_w > 1) ? ((input_w + 2 * data->fp_pad_w - data->fp_kernel_w + ((output_w - 1) / 2)) / (output_w - 1)) : 1;
+        data->fp_stride_h = (output_h > 1) ? ((input_h + 2 * data->fp_pad_h - data->fp_kernel_h + ((output_h - 1) / 2)) / (output_h - 1)) : 1;
+        ERROR_CHECK_STATUS(vxSetNodeAttribute(node, VX_NODE_LOCAL_DATA_PTR, &data, sizeof(data)));
+        return VX_SUCCESS;
+    }
+
     ERROR_CHECK_MIOPEN_STATUS(miopenCreatePoolingDescriptor(&data->pool_desc));
     ERROR_CHECK_MIOPEN_STATUS(miopenCreateTensorDescriptor(&data->input_desc));
     ERROR_CHECK_MIOPEN_STATUS(miopenCreateTensorDescriptor(&data->output_desc));
@@ -172,10 +215,12 @@ static vx_status VX_CALLBACK uninitializePoolingLayer(vx_node node, const vx_ref
 {
     PoolingLayerLocalData * data = NULL;
     ERROR_CHECK_STATUS(vxQueryNode(node, VX_NODE_LOCAL_DATA_PTR, &data, sizeof(data)));
-    if(data->pooling_workspace && clReleaseMemObject(data->pooling_workspace) != 0) return VX_FAILURE;
-    ERROR_CHECK_MIOPEN_STATUS(miopenDestroyPoolingDescriptor(data->pool_desc));
-    ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->input_desc));
-    ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->output_desc));
+    if(!data->fixedPoint) {
+        if(data->pooling_workspace && clReleaseMemObject(data->pooling_workspace) != 0) return VX_FAILURE;
+        ERROR_CHECK_MIOPEN_STATUS(miopenDestroyPoolingDescriptor(data->pool_desc));
+        ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->input_desc));
+        ERROR_CHECK_MIOPEN_STATUS(miopenDestroyTensorDescriptor(data->output_desc));
+    }
     if (data) {
         ERROR_CHECK_STATUS(releaseGraphHandle(node, data->handle));
         delete data;
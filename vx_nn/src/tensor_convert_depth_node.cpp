@@ -21,6 +21,17 @@ THE SOFTWARE.
 */
 
 #include "kernels.h"
+#include <math.h>
+
+static bool isSupportedConvertDepthType(vx_enum type)
+{
+    return type == VX_TYPE_FLOAT32 || type == VX_TYPE_INT8 || type == VX_TYPE_INT16;
+}
+
+static const char * openclDataType(vx_enum type)
+{
+    return type == VX_TYPE_INT8 ? "char" : (type == VX_TYPE_INT16 ? "short" : "float");
+}
 
 static vx_status VX_CALLBACK validateTensorConvertDepth(vx_node node, const vx_reference parameters[], vx_uint32 num, vx_meta_format metas[])
 {
@@ -32,7 +43,7 @@ static vx_status VX_CALLBACK validateTensorConvertDepth(vx_node node, const vx_r
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
     if (num_dims != 4) return VX_ERROR_INVALID_DIMENSION;
-    if (type != VX_TYPE_FLOAT32) return VX_ERROR_INVALID_TYPE;
+    if (!isSupportedConvertDepthType(type)) return VX_ERROR_INVALID_TYPE;
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DIMS, input_dims, sizeof(input_dims)));
 
     //check scalar types.
@@ -43,11 +54,14 @@ static vx_status VX_CALLBACK validateTensorConvertDepth(vx_node node, const vx_r
     ERROR_CHECK_STATUS(vxQueryScalar((vx_scalar)parameters[3], VX_SCALAR_TYPE, &type, sizeof(type)));
     if (type != VX_TYPE_FLOAT32) return VX_ERROR_INVALID_TYPE;
 
+    vx_enum output_type;
+    vx_int8 fixed_point_pos;
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[4], VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
-    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[4], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
+    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[4], VX_TENSOR_DATA_TYPE, &output_type, sizeof(output_type)));
     if (num_dims != 4) return VX_ERROR_INVALID_DIMENSION;
-    if (type != VX_TYPE_FLOAT32) return VX_ERROR_INVALID_TYPE;
+    if (!isSupportedConvertDepthType(output_type)) return VX_ERROR_INVALID_TYPE;
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[4], VX_TENSOR_DIMS, output_dims, sizeof(output_dims)));
+    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[4], VX_TENSOR_FIXED_POINT_POSITION, &fixed_point_pos, sizeof(fixed_point_pos)));
 
     if (output_dims[3] != input_dims[3]) return VX_ERROR_INVALID_DIMENSION;
     if (output_dims[2] != input_dims[2]) return VX_ERROR_INVALID_DIMENSION;
@@ -55,11 +69,11 @@ static vx_status VX_CALLBACK validateTensorConvertDepth(vx_node node, const vx_r
     if (output_dims[0] != input_dims[0]) return VX_ERROR_INVALID_DIMENSION;
 
     // output tensor configuration
-    type = VX_TYPE_FLOAT32;
     num_dims = 4;
-    ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[4], VX_TENSOR_DATA_TYPE, &type, sizeof(type)));
+    ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[4], VX_TENSOR_DATA_TYPE, &output_type, sizeof(output_type)));
     ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[4], VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
     ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[4], VX_TENSOR_DIMS, output_dims, sizeof(output_dims)));
+    ERROR_CHECK_STATUS(vxSetMetaFormatAttribute(metas[4], VX_TENSOR_FIXED_POINT_POSITION, &fixed_point_pos, sizeof(fixed_point_pos)));
     return VX_SUCCESS;
 }
 
@@ -89,11 +103,18 @@ static vx_status VX_CALLBACK opencl_codegen(
     vx_uint32& opencl_local_buffer_size_in_bytes   // [output] reserved: must be ZERO
 )
 {
-    //get tensor dimensions
+    //get tensor dimensions and fixed-point formats
     vx_size input_dims[4];
     vx_size num_of_dims;
+    vx_enum input_type, output_type, policy;
+    vx_int8 input_fpp, output_fpp;
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_NUMBER_OF_DIMS, &num_of_dims, sizeof(num_of_dims)));
     ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DIMS, input_dims, sizeof(input_dims)));
+    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_DATA_TYPE, &input_type, sizeof(input_type)));
+    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[0], VX_TENSOR_FIXED_POINT_POSITION, &input_fpp, sizeof(input_fpp)));
+    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[4], VX_TENSOR_DATA_TYPE, &output_type, sizeof(output_type)));
+    ERROR_CHECK_STATUS(vxQueryTensor((vx_tensor)parameters[4], VX_TENSOR_FIXED_POINT_POSITION, &output_fpp, sizeof(output_fpp)));
+    ERROR_CHECK_STATUS(vxCopyScalar((vx_scalar)parameters[1], &policy, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
     strcpy(opencl_kernel_function_name, "tensor_convert_node");
 
     vx_uint32 input_dim_size = input_dims[0] * input_dims[1] * input_dims[2] * input_dims[3];
@@ -106,14 +127,27 @@ static vx_status VX_CALLBACK opencl_codegen(
     opencl_local_buffer_size_in_bytes = 0;
 
     if (num_of_dims == 4) {
+        // fixed-point values are scaled by 2^-fpp on input and 2^fpp on output;
+        // integer outputs are rounded to nearest-even and saturated or wrapped according to the policy
+        float input_scale = (input_type == VX_TYPE_FLOAT32) ? 1.0f : ldexpf(1.0f, -input_fpp);
+        float output_scale = (output_type == VX_TYPE_FLOAT32) ? 1.0f : ldexpf(1.0f, output_fpp);
+        char convert[64] = "";
+        if (output_type != VX_TYPE_FLOAT32) {
+            sprintf(convert, "convert_%s%s_rte", openclDataType(output_type), policy == VX_CONVERT_POLICY_SATURATE ? "_sat" : "");
+        }
         char item[8192];
         sprintf(item,
-            "__kernel void tensor_convert_node(__global float * in, uint in_offset, float policy, float norm, float offset, __global float * out, uint out_offset) \n"
+            "__kernel void tensor_convert_node(__global uchar * in, uint in_offset, float policy, float norm, float offset, __global uchar * out, uint out_offset) \n"
             "{ \n"
-            "     size_t id = get_global_id(0);"
-            "     out[id] = in[id] - offset;"
-            "     out[id] = out[id]/norm;"
+            "     size_t id = get_global_id(0);\n"
+            "     __global %s * src = (__global %s *)(in + in_offset);\n"
+            "     __global %s * dst = (__global %s *)(out + out_offset);\n"
+            "     float value = ((float)src[id] * %.9ef - offset) / norm;\n"
+            "     dst[id] = %s(value * %.9ef);\n"
             " }\n"
+            , openclDataType(input_type), openclDataType(input_type)
+            , openclDataType(output_type), openclDataType(output_type)
+            , input_scale, convert, output_scale
         );
 
         opencl_kernel_code = item;
@@ -0,0 +1,275 @@
+/*
+Copyright (c) 2017 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+// Accuracy check of the fixed-point CPU kernels: convolution, fully connected and
+// pooling run on random data quantized to VX_TYPE_INT8 and VX_TYPE_INT16 and their
+// dequantized outputs are compared with a float reference using SNR in dB.
+//   usage: fixed_point_check [-v]
+
+#include "kernels.h"
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+static bool g_verbose = false;
+
+// deterministic pseudo-random values in [-1,1)
+static float randomValue(unsigned int& seed)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return (float)((seed >> 8) & 0xffff) / 32768.0f - 1.0f;
+}
+
+// fixed point position that fits the largest magnitude of the data into the element type
+// (same rule as getFixedPointPosition() in inference_generator)
+static vx_int8 fixedPointPosition(const std::vector<float>& data, vx_enum type)
+{
+    float maxabs = 0;
+    for(size_t i = 0; i < data.size(); i++) maxabs = std::max(maxabs, fabsf(data[i]));
+    int bits = (type == VX_TYPE_INT8) ? 7 : 15;
+    if(maxabs <= 0) return (vx_int8)bits;
+    int pos = bits - ((int)floorf(log2f(maxabs)) + 1);
+    return (vx_int8)std::max(0, std::min(pos, 2 * bits));
+}
+
+struct QuantizedTensor {
+    FixedPointTensor t;
+    std::vector<vx_int16> buf;
+};
+
+static void initializeTensor(QuantizedTensor& q, vx_enum type, vx_int8 fixed_point_pos, vx_size w, vx_size h, vx_size c, vx_size n)
+{
+    memset(&q.t, 0, sizeof(q.t));
+    q.t.type = type;
+    q.t.fixed_point_pos = fixed_point_pos;
+    q.t.num_dims = 4;
+    q.t.dims[0] = w; q.t.dims[1] = h; q.t.dims[2] = c; q.t.dims[3] = n;
+    q.t.count = w * h * c * n;
+    q.buf.assign(q.t.count, 0); // int16 elements are large enough for both types
+    q.t.ptr = &q.buf[0];
+}
+
+static void quantize(QuantizedTensor& q, const std::vector<float>& data)
+{
+    double scale = ldexp(1.0, q.t.fixed_point_pos);
+    double maxval = (q.t.type == VX_TYPE_INT8) ? 127.0 : 32767.0;
+    for(size_t i = 0; i < data.size(); i++) {
+        double v = std::max(-maxval - 1, std::min(maxval, nearbyint(data[i] * scale)));
+        if(q.t.type == VX_TYPE_INT8) ((vx_int8 *)q.t.ptr)[i] = (vx_int8)v;
+        else ((vx_int16 *)q.t.ptr)[i] = (vx_int16)v;
+    }
+}
+
+static std::vector<float> dequantize(const QuantizedTensor& q)
+{
+    std::vector<float> data(q.t.count);
+    double scale = ldexp(1.0, -q.t.fixed_point_pos);
+    for(size_t i = 0; i < data.size(); i++) {
+        vx_int32 v = (q.t.type == VX_TYPE_INT8) ? ((const vx_int8 *)q.t.ptr)[i] : ((const vx_int16 *)q.t.ptr)[i];
+        data[i] = (float)(v * scale);
+    }
+    return data;
+}
+
+static double computeSNR(const std::vector<float>& reference, const std::vector<float>& output)
+{
+    double signal = 0, noise = 0;
+    for(size_t i = 0; i < reference.size(); i++) {
+        double diff = (double)output[i] - (double)reference[i];
+        signal += (double)reference[i] * reference[i];
+        noise += diff * diff;
+    }
+    if(noise == 0) return 99.0;
+    return std::min(99.0, 10.0 * log10(signal / noise));
+}
+
+static bool checkResult(const char * name, const std::vector<float>& reference, const QuantizedTensor& output, double min_snr)
+{
+    double snr = computeSNR(reference, dequantize(output));
+    bool ok = snr >= min_snr;
+    if(g_verbose || !ok) {
+        printf("%-8s %-24s snr %6.2f dB (min %.1f dB)\n", ok ? "OK" : "FAILED", name, snr, min_snr);
+    }
+    return ok;
+}
+
+static void randomTensor(std::vector<float>& data, size_t count, float range, unsigned int& seed)
+{
+    data.resize(count);
+    for(size_t i = 0; i < count; i++) data[i] = randomValue(seed) * range;
+}
+
+//////////////////////////////////////////////////////////////////////
+// float references
+
+static void convolutionReference(const std::vector<float>& input, const std::vector<float>& weights, const std::vector<float>& bias, std::vector<float>& output,
+                                 int W, int H, int C, int N, int kernel_w, int kernel_h, int K, int ow, int oh, const FixedPointConvolutionParams& params)
+{
+    output.assign((size_t)ow * oh * K * N, 0.0f);
+    for(int n = 0; n < N; n++) for(int k = 0; k < K; k++) for(int oy = 0; oy < oh; oy++) for(int ox = 0; ox < ow; ox++) {
+        double acc = bias[k];
+        for(int c = 0; c < C; c++) for(int ky = 0; ky < kernel_h; ky++) for(int kx = 0; kx < kernel_w; kx++) {
+            int y = oy * (int)params.stride_h - (int)params.pad_h + ky * (int)params.dilation_h;
+            int x = ox * (int)params.stride_w - (int)params.pad_w + kx * (int)params.dilation_w;
+            if(y >= 0 && y < H && x >= 0 && x < W) {
+                acc += (double)input[(((size_t)n * C + c) * H + y) * W + x] * weights[(((size_t)k * C + c) * kernel_h + ky) * kernel_w + kx];
+            }
+        }
+        output[(((size_t)n * K + k) * oh + oy) * ow + ox] = (float)acc;
+    }
+}
+
+static void poolingReference(const std::vector<float>& input, std::vector<float>& output, vx_enum pooling_type,
+                             int W, int H, int planes, int kernel, int pad, int stride, int ow, int oh)
+{
+    output.assign((size_t)ow * oh * planes, 0.0f);
+    for(int p = 0; p < planes; p++) for(int oy = 0; oy < oh; oy++) for(int ox = 0; ox < ow; ox++) {
+        int ys = oy * stride - pad, ye = std::min(ys + kernel, H + pad);
+        int xs = ox * stride - pad, xe = std::min(xs + kernel, W + pad);
+        int pool_size = (ye - ys) * (xe - xs);
+        ys = std::max(ys, 0); ye = std::min(ye, H);
+        xs = std::max(xs, 0); xe = std::min(xe, W);
+        double value = (pooling_type == VX_NN_POOLING_MAX) ? -1e30 : 0.0;
+        for(int y = ys; y < ye; y++) for(int x = xs; x < xe; x++) {
+            float v = input[((size_t)p * H + y) * W + x];
+            value = (pooling_type == VX_NN_POOLING_MAX) ? std::max(value, (double)v) : value + v;
+        }
+        if(pooling_type != VX_NN_POOLING_MAX) value /= pool_size;
+        output[((size_t)p * oh + oy) * ow + ox] = (float)value;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+// checks: activations and weights are quantized with positions that fit their
+// range, the output position is derived from the float reference like the
+// calibration mode of inference_generator does
+
+static bool checkConvolution(vx_enum type, double min_snr, int W, int H, int C, int K, int kernel, int stride, int pad, int dilation, unsigned int seed)
+{
+    int N = 2;
+    FixedPointConvolutionParams params;
+    memset(&params, 0, sizeof(params));
+    params.pad_w = params.pad_h = pad;
+    params.stride_w = params.stride_h = stride;
+    params.dilation_w = params.dilation_h = dilation;
+    params.overflow_policy = VX_CONVERT_POLICY_SATURATE;
+    params.rounding_policy = VX_ROUND_POLICY_TO_NEAREST_EVEN;
+    params.num_threads = omp_get_max_threads();
+    int ow = (W + 2 * pad - ((kernel - 1) * dilation + 1)) / stride + 1;
+    int oh = (H + 2 * pad - ((kernel - 1) * dilation + 1)) / stride + 1;
+    std::vector<float> input, weights, bias, reference;
+    randomTensor(input, (size_t)W * H * C * N, 4.0f, seed);
+    randomTensor(weights, (size_t)kernel * kernel * C * K, 1.0f / sqrtf((float)(kernel * kernel * C)), seed);
+    randomTensor(bias, K, 0.5f, seed);
+    convolutionReference(input, weights, bias, reference, W, H, C, N, kernel, kernel, K, ow, oh, params);
+    QuantizedTensor qinput, qweights, qbias, qoutput;
+    initializeTensor(qinput, type, fixedPointPosition(input, type), W, H, C, N);
+    initializeTensor(qweights, type, fixedPointPosition(weights, type), kernel, kernel, C, K);
+    initializeTensor(qbias, type, fixedPointPosition(bias, type), K, 1, 1, 1);
+    initializeTensor(qoutput, type, fixedPointPosition(reference, type), ow, oh, K, N);
+    quantize(qinput, input);
+    quantize(qweights, weights);
+    quantize(qbias, bias);
+    std::vector<vx_uint8> scratch(fixedPointConvolutionScratchSize(qinput.t, qweights.t, qoutput.t, params));
+    fixedPointConvolution(qinput.t, qweights.t, &qbias.t, qoutput.t, params, &scratch[0]);
+    char name[64];
+    sprintf(name, "conv%s/%dx%dx%d/k%ds%dp%dd%d", type == VX_TYPE_INT8 ? "8" : "16", W, H, C, kernel, stride, pad, dilation);
+    return checkResult(name, reference, qoutput, min_snr);
+}
+
+static bool checkFullyConnected(vx_enum type, double min_snr, int size, int K, unsigned int seed)
+{
+    int N = 3;
+    std::vector<float> input, weights, bias, reference((size_t)K * N);
+    randomTensor(input, (size_t)size * N, 4.0f, seed);
+    randomTensor(weights, (size_t)size * K, 1.0f / sqrtf((float)size), seed);
+    randomTensor(bias, K, 0.5f, seed);
+    for(int n = 0; n < N; n++) for(int k = 0; k < K; k++) {
+        double acc = bias[k];
+        for(int i = 0; i < size; i++) acc += (double)input[(size_t)n * size + i] * weights[(size_t)k * size + i];
+        reference[(size_t)n * K + k] = (float)acc;
+    }
+    QuantizedTensor qinput, qweights, qbias, qoutput;
+    initializeTensor(qinput, type, fixedPointPosition(input, type), 1, 1, size, N);
+    initializeTensor(qweights, type, fixedPointPosition(weights, type), 1, 1, size, K);
+    initializeTensor(qbias, type, fixedPointPosition(bias, type), K, 1, 1, 1);
+    initializeTensor(qoutput, type, fixedPointPosition(reference, type), 1, 1, K, N);
+    quantize(qinput, input);
+    quantize(qweights, weights);
+    quantize(qbias, bias);
+    fixedPointFullyConnected(qinput.t, qweights.t, &qbias.t, qoutput.t, VX_CONVERT_POLICY_SATURATE, VX_ROUND_POLICY_TO_NEAREST_EVEN);
+    char name[64];
+    sprintf(name, "fc%s/%d/%d", type == VX_TYPE_INT8 ? "8" : "16", size, K);
+    return checkResult(name, reference, qoutput, min_snr);
+}
+
+static bool checkPooling(vx_enum type, double min_snr, vx_enum pooling_type, int W, int H, int C, int kernel, int stride, int pad, unsigned int seed)
+{
+    int N = 2;
+    int ow = (W + 2 * pad - kernel + stride - 1) / stride + 1;
+    int oh = (H + 2 * pad - kernel + stride - 1) / stride + 1;
+    std::vector<float> input, reference;
+    randomTensor(input, (size_t)W * H * C * N, 4.0f, seed);
+    poolingReference(input, reference, pooling_type, W, H, C * N, kernel, pad, stride, ow, oh);
+    QuantizedTensor qinput, qoutput;
+    initializeTensor(qinput, type, fixedPointPosition(input, type), W, H, C, N);
+    initializeTensor(qoutput, type, qinput.t.fixed_point_pos, ow, oh, C, N);
+    quantize(qinput, input);
+    fixedPointPooling(qinput.t, qoutput.t, pooling_type, kernel, kernel, pad, pad, stride, stride);
+    char name[64];
+    sprintf(name, "%s%s/%dx%dx%d/k%ds%dp%d", pooling_type == VX_NN_POOLING_MAX ? "maxpool" : "avgpool", type == VX_TYPE_INT8 ? "8" : "16",
+            W, H, C, kernel, stride, pad);
+    return checkResult(name, reference, qoutput, min_snr);
+}
+
+int main(int argc, char * argv[])
+{
+    for(int arg = 1; arg < argc; arg++) {
+        if(!strcmp(argv[arg], "-v")) g_verbose = true;
+        else {
+            printf("Usage: fixed_point_check [-v]\n");
+            return -1;
+        }
+    }
+
+    // minimum SNR of the dequantized output against the float reference: about 6 dB
+    // below what the 7-bit (int8) and 15-bit (int16) quantization of these data reaches
+    const struct { vx_enum type; double conv, fc, pool; } precision[] = {
+        { VX_TYPE_INT8,  30.0, 34.0, 30.0 },
+        { VX_TYPE_INT16, 78.0, 84.0, 80.0 },
+    };
+    int failed = 0, count = 0;
+    for(size_t i = 0; i < sizeof(precision) / sizeof(precision[0]); i++) {
+        vx_enum type = precision[i].type;
+        // enough output rows to split rows across threads, and a single row that splits output channels
+        failed += !checkConvolution(type, precision[i].conv, 23, 19, 8, 16, 3, 1, 1, 1, 1); count++;
+        failed += !checkConvolution(type, precision[i].conv, 17, 17, 5, 12, 3, 2, 2, 2, 2); count++;
+        failed += !checkConvolution(type, precision[i].conv, 7, 1, 64, 33, 1, 1, 0, 1, 3); count++;
+        failed += !checkFullyConnected(type, precision[i].fc, 500, 37, 4); count++;
+        failed += !checkPooling(type, precision[i].pool, VX_NN_POOLING_MAX, 17, 13, 6, 3, 2, 1, 5); count++;
+        failed += !checkPooling(type, precision[i].pool, VX_NN_POOLING_AVG, 17, 13, 6, 3, 2, 1, 6); count++;
+        failed += !checkPooling(type, precision[i].pool, VX_NN_POOLING_AVG, 16, 16, 4, 2, 2, 0, 7); count++;
+    }
+    printf("fixed_point_check: %d of %d checks passed\n", count - failed, count);
+    return failed ? 1 : 0;
+}
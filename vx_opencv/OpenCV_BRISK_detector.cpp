@@ -124,21 +124,17 @@ static vx_status VX_CALLBACK CV_brisk_detector_OutputValidator(vx_node node, vx_
 	return status;
 }
 
-/*!***********************************************************************************************************
-Execution Kernel
+/************************************************************************************************************
+Initializer function: creates the OpenCV detector once for the node.
 *************************************************************************************************************/
-static vx_status VX_CALLBACK CV_brisk_detector_Kernel(vx_node node, const vx_reference *parameters, vx_uint32 num)
+static vx_status VX_CALLBACK CV_brisk_detector_Initialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
 {
 	vx_status status = VX_SUCCESS;
 
-	vx_image image_in = (vx_image) parameters[0];
-	vx_image mask = (vx_image) parameters[1];
-	vx_array array = (vx_array) parameters[2];
 	vx_scalar THRESH = (vx_scalar) parameters[3];
 	vx_scalar OCTAVES = (vx_scalar) parameters[4];
 	vx_scalar SCALE = (vx_scalar) parameters[5];
 
-	Mat *mat, *mask_mat, Img;
 	int thresh, octaves;
 	float patternscale;
 	vx_float32 FloatValue = 0;
@@ -149,17 +145,44 @@ static vx_status VX_CALLBACK CV_brisk_detector_Kernel(vx_node node, const vx_ref
 	STATUS_ERROR_CHECK(vxReadScalarValue(THRESH, &value));thresh = value; 
 	STATUS_ERROR_CHECK(vxReadScalarValue(OCTAVES, &value));octaves = value; 
 
+	//Creating the OpenCV Detector
+	STATUS_ERROR_CHECK(CV_Detector_Data_Create(node, BRISK::create(thresh, octaves, patternscale)));
+
+	return status;
+}
+
+/************************************************************************************************************
+De-Initializer function: releases the OpenCV detector.
+*************************************************************************************************************/
+static vx_status VX_CALLBACK CV_brisk_detector_Deinitialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	return CV_Detector_Data_Release(node);
+}
+
+/*!***********************************************************************************************************
+Execution Kernel
+*************************************************************************************************************/
+static vx_status VX_CALLBACK CV_brisk_detector_Kernel(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	vx_status status = VX_SUCCESS;
+	vx_image image_in = (vx_image) parameters[0];
+	vx_image mask = (vx_image) parameters[1];
+	vx_array array = (vx_array) parameters[2];
+
+	CV_Detector_Data * data = CV_Detector_Data_Get(node);
+	if (!data) return VX_ERROR_INVALID_NODE;
+	VX_CV_Image mat, mask_mat;
+
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mask_mat, mask));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mask_mat, mask));
 
 	//Compute using OpenCV
-	vector<KeyPoint> key_points;
-	Ptr<Feature2D> brisk = BRISK::create(thresh, octaves, patternscale);
-	brisk->detect(*mat, key_points, *mask_mat);
+	data->key_points.clear();
+	data->detector->detect(*mat, data->key_points, *mask_mat);
 
 	//Converting OpenCV Keypoints to OpenVX Keypoints
-	STATUS_ERROR_CHECK(CV_to_VX_keypoints(key_points, array));
+	STATUS_ERROR_CHECK(CV_to_VX_keypoints(data->key_points, array));
 
 	return status;
 }
@@ -177,8 +200,8 @@ vx_status CV_brisk_detect_Register(vx_context context)
 		6,
 		CV_brisk_detector_InputValidator,
 		CV_brisk_detector_OutputValidator,
-		nullptr,
-		nullptr);
+		CV_brisk_detector_Initialize,
+		CV_brisk_detector_Deinitialize);
 
 	if (Kernel)
 	{
@@ -176,7 +176,7 @@ static vx_status VX_CALLBACK CV_Blur_Kernel(vx_node node, const vx_reference *pa
 	vx_scalar A_Y = (vx_scalar) parameters[5];
 	vx_scalar BORDER = (vx_scalar) parameters[6];
 
-	Mat *mat, bl;
+	VX_CV_Image mat, out; Mat bl;
 	int W, H, a_x, a_y, border;
 	vx_int32 value = 0;
 
@@ -189,16 +189,17 @@ static vx_status VX_CALLBACK CV_Blur_Kernel(vx_node node, const vx_reference *pa
 
 	//Converting VX Image to OpenCV Mat
 	STATUS_ERROR_CHECK(match_vx_image_parameters(image_in, image_out));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
 
 	//Compute using OpenCV
 	Point point;
 	point.x = a_x;
 	point.y = a_y;
-	cv::blur(*mat, bl, Size(W, H), point, border);
+	STATUS_ERROR_CHECK(CV_Tiled_Filter(*mat, bl, mat->type(), H / 2 + 1, border, [&](const Mat& src, Mat& dst) { cv::blur(src, dst, Size(W, H), point, border); }));
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, bl));
 
 	return status;
 }
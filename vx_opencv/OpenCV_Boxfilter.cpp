@@ -182,7 +182,7 @@ static vx_status VX_CALLBACK CV_Boxfilter_Kernel(vx_node node, const vx_referenc
 	vx_scalar NORM = (vx_scalar) parameters[7];
 	vx_scalar BORDER = (vx_scalar) parameters[8];
 
-	Mat *mat, bl;
+	VX_CV_Image mat, out; Mat bl;
 	int ddepth, W, H, a_x = -1, a_y = -1, border = 4;
 
 	vx_int32 value = 0;
@@ -199,7 +199,8 @@ static vx_status VX_CALLBACK CV_Boxfilter_Kernel(vx_node node, const vx_referenc
 
 	//Converting VX Image to OpenCV Mat
 	STATUS_ERROR_CHECK(match_vx_image_parameters(image_in, image_out));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
 
 	//Compute using OpenCV
 	Point point;
@@ -207,10 +208,11 @@ static vx_status VX_CALLBACK CV_Boxfilter_Kernel(vx_node node, const vx_referenc
 	if (norm == vx_true_e) Normalized = true; else Normalized = false;
 	point.x = a_x;
 	point.y = a_y;
-	cv::boxFilter(*mat, bl, ddepth, Size(W, H), point, Normalized, border);
+	int type = CV_MAKETYPE(ddepth < 0 ? mat->depth() : ddepth, mat->channels());
+	STATUS_ERROR_CHECK(CV_Tiled_Filter(*mat, bl, type, H / 2 + 1, border, [&](const Mat& src, Mat& dst) { cv::boxFilter(src, dst, ddepth, Size(W, H), point, Normalized, border); }));
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, bl));
 
 	return status;
 }
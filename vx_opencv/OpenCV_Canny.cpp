@@ -146,7 +146,7 @@ static vx_status VX_CALLBACK CV_Canny_Kernel(vx_node node, const vx_reference *p
 	vx_scalar APERSIZE = (vx_scalar) parameters[4];
 	vx_scalar L2GRAD = (vx_scalar) parameters[5];
 
-	Mat *mat, bl;
+	VX_CV_Image mat, out; Mat bl;
 
 	float threshold1, threshold2;
 	int aperture_size;
@@ -162,7 +162,8 @@ static vx_status VX_CALLBACK CV_Canny_Kernel(vx_node node, const vx_reference *p
 
 	//Converting VX Image to OpenCV Mat
 	STATUS_ERROR_CHECK(match_vx_image_parameters(image_in, image_out));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
 
 	//Compute using OpenCV
 	bool L2_Gradient;
@@ -170,7 +171,7 @@ static vx_status VX_CALLBACK CV_Canny_Kernel(vx_node node, const vx_reference *p
 	cv::Canny(*mat, bl, threshold1, threshold2, aperture_size, L2_Gradient);
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, bl));
 
 	return status;
 }
@@ -102,18 +102,16 @@ static vx_status VX_CALLBACK CV_FAST_detector_OutputValidator(vx_node node, vx_u
 	return status;
 }
 
-/*!***********************************************************************************************************
-Execution Kernel
+/************************************************************************************************************
+Initializer function: creates the OpenCV detector once for the node.
 *************************************************************************************************************/
-static vx_status VX_CALLBACK CV_FAST_detector_Kernel(vx_node node, const vx_reference *parameters, vx_uint32 num)
+static vx_status VX_CALLBACK CV_FAST_detector_Initialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
 {
 	vx_status status = VX_SUCCESS;
 
-	vx_image image_in = (vx_image) parameters[0];
-	vx_array array = (vx_array) parameters[1];
 	vx_scalar Threshold = (vx_scalar) parameters[2];
 	vx_scalar NonMAXSuppression = (vx_scalar) parameters[3];
-	Mat *mat, Img;
+
 	vx_int32 value = 0;
 	vx_bool value_b, nonmax;
 	int threshold = 0;
@@ -122,17 +120,44 @@ static vx_status VX_CALLBACK CV_FAST_detector_Kernel(vx_node node, const vx_refe
 	STATUS_ERROR_CHECK(vxReadScalarValue(Threshold, &value)); threshold = value;
 	STATUS_ERROR_CHECK(vxReadScalarValue(NonMAXSuppression, &value_b));	nonmax = value_b;
 
+	//Creating the OpenCV Detector (same 9/16 segment test as cv::FAST)
+	bool nonmax_bool = false;
+	if (nonmax == vx_true_e) nonmax_bool = true; else nonmax_bool = false;
+	STATUS_ERROR_CHECK(CV_Detector_Data_Create(node, FastFeatureDetector::create(threshold, nonmax_bool)));
+
+	return status;
+}
+
+/************************************************************************************************************
+De-Initializer function: releases the OpenCV detector.
+*************************************************************************************************************/
+static vx_status VX_CALLBACK CV_FAST_detector_Deinitialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	return CV_Detector_Data_Release(node);
+}
+
+/*!***********************************************************************************************************
+Execution Kernel
+*************************************************************************************************************/
+static vx_status VX_CALLBACK CV_FAST_detector_Kernel(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	vx_status status = VX_SUCCESS;
+	vx_image image_in = (vx_image) parameters[0];
+	vx_array array = (vx_array) parameters[1];
+
+	CV_Detector_Data * data = CV_Detector_Data_Get(node);
+	if (!data) return VX_ERROR_INVALID_NODE;
+	VX_CV_Image mat;
+
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
 
 	//Compute using OpenCV
-	vector<KeyPoint> key_points;
-	bool nonmax_bool = false;
-	if (nonmax == vx_true_e) nonmax_bool = true; else nonmax_bool = false;
-	cv::FAST(*mat, key_points, threshold, nonmax_bool);
+	data->key_points.clear();
+	data->detector->detect(*mat, data->key_points);
 
 	//Converting OpenCV Keypoints to OpenVX Keypoints
-	STATUS_ERROR_CHECK(CV_to_VX_keypoints(key_points, array));
+	STATUS_ERROR_CHECK(CV_to_VX_keypoints(data->key_points, array));
 
 	return status;
 }
@@ -150,8 +175,8 @@ vx_status CV_FAST_detector_Register(vx_context context)
 		4,
 		CV_FAST_detector_InputValidator,
 		CV_FAST_detector_OutputValidator,
-		nullptr,
-		nullptr);
+		CV_FAST_detector_Initialize,
+		CV_FAST_detector_Deinitialize);
 
 	if (Kernel)
 	{
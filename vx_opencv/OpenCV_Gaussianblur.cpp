@@ -158,7 +158,7 @@ static vx_status VX_CALLBACK CV_Gaussianblur_Kernel(vx_node node, const vx_refer
 	vx_scalar scalar_1 = (vx_scalar) parameters[5];
 	vx_scalar scalar_2 = (vx_scalar) parameters[6];
 
-	Mat *mat, bl;
+	VX_CV_Image mat, out; Mat bl;
 	int W, H, Border;
 	float Sigma_X, Sigma_Y;
 	vx_int32 value = 0;
@@ -173,13 +173,15 @@ static vx_status VX_CALLBACK CV_Gaussianblur_Kernel(vx_node node, const vx_refer
 
 	//Converting VX Image to OpenCV Mat
 	STATUS_ERROR_CHECK(match_vx_image_parameters(image_in, image_out));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
 
 	//Compute using OpenCV
-	cv::GaussianBlur(*mat, bl, Size(W, H), Sigma_X, Sigma_Y, Border);
+	int border_rows = H > 0 ? H / 2 + 1 : (int)ceil(4 * max(Sigma_X, Sigma_Y)) + 1;
+	STATUS_ERROR_CHECK(CV_Tiled_Filter(*mat, bl, mat->type(), border_rows, Border, [&](const Mat& src, Mat& dst) { cv::GaussianBlur(src, dst, Size(W, H), Sigma_X, Sigma_Y, Border); }));
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, bl));
 
 	return status;
 }
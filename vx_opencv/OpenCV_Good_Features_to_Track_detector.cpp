@@ -176,7 +176,7 @@ static vx_status VX_CALLBACK CV_good_feature_detector_Kernel(vx_node node, const
 	vx_scalar USEHARRISDETECTOR = (vx_scalar) parameters[7];
 	vx_scalar K = (vx_scalar) parameters[8];
 
-	Mat *mat, *mask_mat, Img;
+	VX_CV_Image mat, mask_mat; Mat Img;
 	int maxCorners, blockSize;
 	float qualityLevel, minDistance, k;
 	vx_float32 FloatValue = 0;
@@ -192,8 +192,8 @@ static vx_status VX_CALLBACK CV_good_feature_detector_Kernel(vx_node node, const
 	STATUS_ERROR_CHECK(vxReadScalarValue(USEHARRISDETECTOR, &value_b)); useHarris = value_b;
 
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mask_mat, mask));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mask_mat, mask));
 
 	//Compute using OpenCV
 	vector<Point2f> Points2;
@@ -158,7 +158,7 @@ static vx_status VX_CALLBACK CV_Laplacian_Kernel(vx_node node, const vx_referenc
 	vx_scalar DELTA = (vx_scalar) parameters[5];
 	vx_scalar BORDER = (vx_scalar) parameters[6];
 
-	Mat *mat, bl;
+	VX_CV_Image mat, out; Mat bl;
 	int ddepth, ksize, Border;
 	float scale, delta;
 	vx_int32 value = 0;
@@ -173,13 +173,14 @@ static vx_status VX_CALLBACK CV_Laplacian_Kernel(vx_node node, const vx_referenc
 
 	//Converting VX Image to OpenCV Mat
 	STATUS_ERROR_CHECK(match_vx_image_parameters(image_in, image_out));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
 
 	//Compute using OpenCV
 	cv::Laplacian(*mat, bl, ddepth, ksize, scale, delta, Border);
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, bl));
 
 	return status;
 }
@@ -187,16 +187,13 @@ static vx_status VX_CALLBACK CV_MSER_feature_detector_OutputValidator(vx_node no
 	return status;
 }
 
-/*!***********************************************************************************************************
-Execution Kernel
+/************************************************************************************************************
+Initializer function: creates the OpenCV detector once for the node.
 *************************************************************************************************************/
-static vx_status VX_CALLBACK CV_MSER_feature_detector_Kernel(vx_node node, const vx_reference *parameters, vx_uint32 num)
+static vx_status VX_CALLBACK CV_MSER_feature_detector_Initialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
 {
 	vx_status status = VX_SUCCESS;
 
-	vx_image image_in = (vx_image) parameters[0];
-	vx_array array = (vx_array) parameters[1];
-	vx_image mask = (vx_image) parameters[2];
 	vx_scalar DELTA = (vx_scalar) parameters[3];
 	vx_scalar MINAREA = (vx_scalar) parameters[4];
 	vx_scalar MAXAREA = (vx_scalar) parameters[5];
@@ -207,8 +204,6 @@ static vx_status VX_CALLBACK CV_MSER_feature_detector_Kernel(vx_node node, const
 	vx_scalar MINMAR = (vx_scalar) parameters[10];
 	vx_scalar EDGEBLUR = (vx_scalar) parameters[11];
 
-	Mat *mat, *mask_mat, Img;
-	vector<KeyPoint> key_points;
 	int delta, min_area, max_area, max_evolution, edge_blur_size;
 	float max_variation, min_diversity, area_threshold, min_margin;
 	vx_float32 FloatValue = 0;
@@ -225,21 +220,44 @@ static vx_status VX_CALLBACK CV_MSER_feature_detector_Kernel(vx_node node, const
 	STATUS_ERROR_CHECK(vxReadScalarValue(MAXAREA, &value));	max_area = value;
 	STATUS_ERROR_CHECK(vxReadScalarValue(EDGEBLUR, &value)); edge_blur_size = value;
 
+	//Creating the OpenCV Detector
+	STATUS_ERROR_CHECK(CV_Detector_Data_Create(node, MSER::create(delta, min_area, max_area, max_variation, min_diversity, max_evolution, area_threshold, min_margin, edge_blur_size)));
+
+	return status;
+}
+
+/************************************************************************************************************
+De-Initializer function: releases the OpenCV detector.
+*************************************************************************************************************/
+static vx_status VX_CALLBACK CV_MSER_feature_detector_Deinitialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	return CV_Detector_Data_Release(node);
+}
+
+/*!***********************************************************************************************************
+Execution Kernel
+*************************************************************************************************************/
+static vx_status VX_CALLBACK CV_MSER_feature_detector_Kernel(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	vx_status status = VX_SUCCESS;
+	vx_image image_in = (vx_image) parameters[0];
+	vx_array array = (vx_array) parameters[1];
+	vx_image mask = (vx_image) parameters[2];
+
+	CV_Detector_Data * data = CV_Detector_Data_Get(node);
+	if (!data) return VX_ERROR_INVALID_NODE;
+	VX_CV_Image mat, mask_mat;
+
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mask_mat, mask));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mask_mat, mask));
 
 	//Compute using OpenCV
-	Ptr<Feature2D> mser = MSER::create(delta, min_area, max_area, max_variation, min_diversity, max_evolution, area_threshold, min_margin, edge_blur_size);
-	mser->detect(*mat, key_points, *mask_mat);
-
-	//OpenCV 2.4.11 Call 
-	//MSER MSER(delta, min_area, max_area, max_variation, min_diversity, max_evolution, area_threshold, min_margin, edge_blur_size);
-	//MSER.detect(*mat, key_points, *mask_mat); ////Compute using OpenCV
+	data->key_points.clear();
+	data->detector->detect(*mat, data->key_points, *mask_mat);
 
 	//Converting OpenCV Keypoints to OpenVX Keypoints
-	STATUS_ERROR_CHECK(CV_to_VX_keypoints(key_points, array));
-
+	STATUS_ERROR_CHECK(CV_to_VX_keypoints(data->key_points, array));
 
 	return status;
 }
@@ -257,8 +275,8 @@ vx_status CV_MSER_detect_Register(vx_context context)
 		12,
 		CV_MSER_feature_detector_InputValidator,
 		CV_MSER_feature_detector_OutputValidator,
-		nullptr,
-		nullptr);
+		CV_MSER_feature_detector_Initialize,
+		CV_MSER_feature_detector_Deinitialize);
 
 	if (Kernel)
 	{
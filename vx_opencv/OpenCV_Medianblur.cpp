@@ -130,7 +130,7 @@ static vx_status VX_CALLBACK CV_MedianBlur_Kernel(vx_node node, const vx_referen
 	vx_image image_out = (vx_image) parameters[1];
 	vx_scalar scalar = (vx_scalar) parameters[2];
 
-	Mat *mat, bl;
+	VX_CV_Image mat, out; Mat bl;
 	int Ksize;
 	vx_int32 value = 0;
 
@@ -139,13 +139,14 @@ static vx_status VX_CALLBACK CV_MedianBlur_Kernel(vx_node node, const vx_referen
 
 	//Converting VX Image to OpenCV Mat
 	STATUS_ERROR_CHECK(match_vx_image_parameters(image_in, image_out));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
 
 	//Compute using OpenCV
 	cv::medianBlur(*mat, bl, Ksize);
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, bl));
 
 	return status;
 }
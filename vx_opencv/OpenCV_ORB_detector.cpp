@@ -178,15 +178,13 @@ static vx_status VX_CALLBACK CV_orb_detector_OutputValidator(vx_node node, vx_ui
 	return status;
 }
 
-/*!***********************************************************************************************************
-Execution Kernel
+/************************************************************************************************************
+Initializer function: creates the OpenCV detector once for the node.
 *************************************************************************************************************/
-static vx_status VX_CALLBACK CV_orb_detector_Kernel(vx_node node, const vx_reference *parameters, vx_uint32 num)
+static vx_status VX_CALLBACK CV_orb_detector_Initialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
 {
 	vx_status status = VX_SUCCESS;
-	vx_image image_in = (vx_image) parameters[0];
-	vx_image mask = (vx_image) parameters[1];
-	vx_array array = (vx_array) parameters[2];
+
 	vx_scalar NFEATURES = (vx_scalar) parameters[3];
 	vx_scalar SCALEFAC = (vx_scalar) parameters[4];
 	vx_scalar NLEVELS = (vx_scalar) parameters[5];
@@ -196,10 +194,8 @@ static vx_status VX_CALLBACK CV_orb_detector_Kernel(vx_node node, const vx_refer
 	vx_scalar SCORETYPE = (vx_scalar) parameters[9];
 	vx_scalar PATCHSIZE = (vx_scalar) parameters[10];
 
-	Mat *mat, *mask_mat, Img;
 	int nFeatures, nLevels, edgeThreshold, firstLevel, WTA_K, scoreType, patchSize;
 	float  ScaleFactor;
-	vector<KeyPoint> key_points;
 	vx_int32 value = 0;
 	vx_float32 value_F = 0;
 
@@ -213,20 +209,44 @@ static vx_status VX_CALLBACK CV_orb_detector_Kernel(vx_node node, const vx_refer
 	STATUS_ERROR_CHECK(vxReadScalarValue(SCORETYPE, &value));scoreType = value;
 	STATUS_ERROR_CHECK(vxReadScalarValue(PATCHSIZE, &value));patchSize = value;
 
+	//Creating the OpenCV Detector
+	STATUS_ERROR_CHECK(CV_Detector_Data_Create(node, ORB::create(nFeatures, ScaleFactor, nLevels, edgeThreshold, firstLevel, WTA_K, scoreType, patchSize)));
+
+	return status;
+}
+
+/************************************************************************************************************
+De-Initializer function: releases the OpenCV detector.
+*************************************************************************************************************/
+static vx_status VX_CALLBACK CV_orb_detector_Deinitialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	return CV_Detector_Data_Release(node);
+}
+
+/*!***********************************************************************************************************
+Execution Kernel
+*************************************************************************************************************/
+static vx_status VX_CALLBACK CV_orb_detector_Kernel(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	vx_status status = VX_SUCCESS;
+	vx_image image_in = (vx_image) parameters[0];
+	vx_image mask = (vx_image) parameters[1];
+	vx_array array = (vx_array) parameters[2];
+
+	CV_Detector_Data * data = CV_Detector_Data_Get(node);
+	if (!data) return VX_ERROR_INVALID_NODE;
+	VX_CV_Image mat, mask_mat;
+
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mask_mat, mask));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mask_mat, mask));
 
 	//Compute using OpenCV
-	Ptr<Feature2D> orb = ORB::create(nFeatures, ScaleFactor, nLevels, edgeThreshold, firstLevel, WTA_K, scoreType, patchSize);
-	orb->detect(*mat, key_points, *mask_mat);
-
-	//OpenCV 2.4 Call
-	//ORB orb(nFeatures, ScaleFactor, nLevels, edgeThreshold, firstLevel, WTA_K, scoreType, patchSize);
-	//orb(*mat, *mask_mat, key_points); ////Compute using OpenCV
+	data->key_points.clear();
+	data->detector->detect(*mat, data->key_points, *mask_mat);
 
 	//Converting OpenCV Keypoints to OpenVX Keypoints
-	STATUS_ERROR_CHECK(CV_to_VX_keypoints(key_points, array));
+	STATUS_ERROR_CHECK(CV_to_VX_keypoints(data->key_points, array));
 
 	return status;
 }
@@ -244,8 +264,8 @@ vx_status CV_ORB_detect_Register(vx_context context)
 		11,
 		CV_orb_detector_InputValidator,
 		CV_orb_detector_OutputValidator,
-		nullptr,
-		nullptr);
+		CV_orb_detector_Initialize,
+		CV_orb_detector_Deinitialize);
 
 	if (Kernel)
 	{
@@ -175,7 +175,7 @@ static vx_status VX_CALLBACK CV_SIFT_Compute_Kernel(vx_node node, const vx_refer
 	vx_scalar EdgeTHRESHOLD = (vx_scalar) parameters[7];
 	vx_scalar SIGMA = (vx_scalar) parameters[8];
 
-	Mat *mat, *mask_mat, Img;
+	VX_CV_Image mat, mask_mat; Mat Img;
 	std::vector<KeyPoint> key_points;
 	Mat Desp;
 	vx_float32 FloatValue = 0;
@@ -191,8 +191,8 @@ static vx_status VX_CALLBACK CV_SIFT_Compute_Kernel(vx_node node, const vx_refer
 	STATUS_ERROR_CHECK(vxReadScalarValue(SIGMA, &FloatValue)); Sigma = FloatValue;
 
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mask_mat, mask));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mask_mat, mask));
 
 	//Compute using OpenCV
 	Ptr<Feature2D> sift = xfeatures2d::SIFT::create(NFEATURES, NOctaveLayers, CTHRESHOLD, ETHRESHOLD, Sigma);
@@ -146,24 +146,19 @@ static vx_status VX_CALLBACK CV_SIFT_Detect_OutputValidator(vx_node node, vx_uin
 	return status;
 }
 
-/*!***********************************************************************************************************
-Execution Kernel
+/************************************************************************************************************
+Initializer function: creates the OpenCV detector once for the node.
 *************************************************************************************************************/
-static vx_status VX_CALLBACK CV_SIFT_Detect_Kernel(vx_node node, const vx_reference *parameters, vx_uint32 num)
+static vx_status VX_CALLBACK CV_SIFT_Detect_Initialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
 {
 	vx_status status = VX_SUCCESS;
 
-	vx_image image_in = (vx_image) parameters[0];
-	vx_image mask = (vx_image) parameters[1];
-	vx_array array = (vx_array) parameters[2];
 	vx_scalar nFEATURES = (vx_scalar) parameters[3];
 	vx_scalar nOCTAVELAYERS = (vx_scalar) parameters[4];
 	vx_scalar ContrastTHRESHOLD = (vx_scalar) parameters[5];
 	vx_scalar EdgeTHRESHOLD = (vx_scalar) parameters[6];
 	vx_scalar SIGMA = (vx_scalar) parameters[7];
 
-	Mat *mat, *mask_mat, Img;
-	vector<KeyPoint> key_points;
 	vx_float32 FloatValue = 0;
 	vx_int32 value = 0;
 	float CTHRESHOLD, ETHRESHOLD, Sigma;
@@ -176,16 +171,44 @@ static vx_status VX_CALLBACK CV_SIFT_Detect_Kernel(vx_node node, const vx_refere
 	STATUS_ERROR_CHECK(vxReadScalarValue(EdgeTHRESHOLD, &FloatValue)); ETHRESHOLD = FloatValue;
 	STATUS_ERROR_CHECK(vxReadScalarValue(SIGMA, &FloatValue)); Sigma = FloatValue;
 
+	//Creating the OpenCV Detector
+	STATUS_ERROR_CHECK(CV_Detector_Data_Create(node, xfeatures2d::SIFT::create(NFEATURES, NOctaveLayers, CTHRESHOLD, ETHRESHOLD, Sigma)));
+
+	return status;
+}
+
+/************************************************************************************************************
+De-Initializer function: releases the OpenCV detector.
+*************************************************************************************************************/
+static vx_status VX_CALLBACK CV_SIFT_Detect_Deinitialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	return CV_Detector_Data_Release(node);
+}
+
+/*!***********************************************************************************************************
+Execution Kernel
+*************************************************************************************************************/
+static vx_status VX_CALLBACK CV_SIFT_Detect_Kernel(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	vx_status status = VX_SUCCESS;
+	vx_image image_in = (vx_image) parameters[0];
+	vx_image mask = (vx_image) parameters[1];
+	vx_array array = (vx_array) parameters[2];
+
+	CV_Detector_Data * data = CV_Detector_Data_Get(node);
+	if (!data) return VX_ERROR_INVALID_NODE;
+	VX_CV_Image mat, mask_mat;
+
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mask_mat, mask));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mask_mat, mask));
 
 	//Compute using OpenCV
-	Ptr<Feature2D> sift = xfeatures2d::SIFT::create(NFEATURES, NOctaveLayers, CTHRESHOLD, ETHRESHOLD, Sigma);
-	sift->detect(*mat, key_points, *mask_mat);
+	data->key_points.clear();
+	data->detector->detect(*mat, data->key_points, *mask_mat);
 
 	//Converting OpenCV Keypoints to OpenVX Keypoints
-	STATUS_ERROR_CHECK(CV_to_VX_keypoints(key_points, array));
+	STATUS_ERROR_CHECK(CV_to_VX_keypoints(data->key_points, array));
 
 	return status;
 }
@@ -203,8 +226,8 @@ vx_status CV_SIFT_detect_Register(vx_context context)
 		8,
 		CV_SIFT_Detect_InputValidator,
 		CV_SIFT_Detect_OutputValidator,
-		nullptr,
-		nullptr);
+		CV_SIFT_Detect_Initialize,
+		CV_SIFT_Detect_Deinitialize);
 
 	if (Kernel)
 	{
@@ -171,7 +171,7 @@ static vx_status VX_CALLBACK CV_SURF_Compute_Kernel(vx_node node, const vx_refer
 	vx_scalar EXTENDED = (vx_scalar) parameters[7];
 	vx_scalar UPRIGHT = (vx_scalar) parameters[8];
 
-	Mat *mat, *mask_mat, Img;
+	VX_CV_Image mat, mask_mat; Mat Img;
 	vx_float32 FloatValue = 0;
 	vx_int32 value = 0;
 	vx_bool extend, upright, value_b;
@@ -186,8 +186,8 @@ static vx_status VX_CALLBACK CV_SURF_Compute_Kernel(vx_node node, const vx_refer
 	STATUS_ERROR_CHECK(vxReadScalarValue(UPRIGHT, &value_b)); upright = value_b;
 
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mask_mat, mask));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mask_mat, mask));
 
 	//Compute using OpenCV
 	bool extended_B, upright_b;
@@ -125,26 +125,19 @@ static vx_status VX_CALLBACK CV_SURF_Detect_OutputValidator(vx_node node, vx_uin
 	return status;
 }
 
-/*!***********************************************************************************************************
-Execution Kernel
+/************************************************************************************************************
+Initializer function: creates the OpenCV detector once for the node.
 *************************************************************************************************************/
-static vx_status VX_CALLBACK CV_SURF_Detect_Kernel(vx_node node, const vx_reference *parameters, vx_uint32 num)
+static vx_status VX_CALLBACK CV_SURF_Detect_Initialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
 {
 	vx_status status = VX_SUCCESS;
-	vx_image image_in = (vx_image) parameters[0];
-	vx_image mask = (vx_image) parameters[1];
-	vx_array array = (vx_array) parameters[2];
+
 	vx_scalar hessianThreshold = (vx_scalar) parameters[3];
 	vx_scalar nOctaves = (vx_scalar) parameters[4];
 	vx_scalar nOctaveLayers = (vx_scalar) parameters[5];
 
-	Mat *mat, *mask_mat, Img;
-	vx_uint32 width = 0;
-	vx_uint32 height = 0;
-
 	vx_float32 FloatValue = 0;
 	vx_int32 value = 0;
-
 	float HessianThreshold;
 	int NOctaves, NOctaveLayers;
 
@@ -153,17 +146,44 @@ static vx_status VX_CALLBACK CV_SURF_Detect_Kernel(vx_node node, const vx_refere
 	STATUS_ERROR_CHECK(vxReadScalarValue(nOctaves, &value)); NOctaves = value;
 	STATUS_ERROR_CHECK(vxReadScalarValue(nOctaveLayers, &value)); NOctaveLayers = value;
 
+	//Creating the OpenCV Detector
+	STATUS_ERROR_CHECK(CV_Detector_Data_Create(node, xfeatures2d::SURF::create(HessianThreshold, NOctaves, NOctaveLayers)));
+
+	return status;
+}
+
+/************************************************************************************************************
+De-Initializer function: releases the OpenCV detector.
+*************************************************************************************************************/
+static vx_status VX_CALLBACK CV_SURF_Detect_Deinitialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	return CV_Detector_Data_Release(node);
+}
+
+/*!***********************************************************************************************************
+Execution Kernel
+*************************************************************************************************************/
+static vx_status VX_CALLBACK CV_SURF_Detect_Kernel(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	vx_status status = VX_SUCCESS;
+	vx_image image_in = (vx_image) parameters[0];
+	vx_image mask = (vx_image) parameters[1];
+	vx_array array = (vx_array) parameters[2];
+
+	CV_Detector_Data * data = CV_Detector_Data_Get(node);
+	if (!data) return VX_ERROR_INVALID_NODE;
+	VX_CV_Image mat, mask_mat;
+
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mask_mat, mask));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mask_mat, mask));
 
 	//Compute using OpenCV
-	vector<KeyPoint> key_points;
-	Ptr<Feature2D> surf = xfeatures2d::SURF::create(HessianThreshold, NOctaves, NOctaveLayers);
-	surf->detect(*mat, key_points, *mask_mat);
+	data->key_points.clear();
+	data->detector->detect(*mat, data->key_points, *mask_mat);
 
 	//Converting OpenCV Keypoints to OpenVX Keypoints
-	STATUS_ERROR_CHECK(CV_to_VX_keypoints(key_points, array));
+	STATUS_ERROR_CHECK(CV_to_VX_keypoints(data->key_points, array));
 
 	return status;
 }
@@ -181,8 +201,8 @@ vx_status CV_SURF_detect_Register(vx_context context)
 		6,
 		CV_SURF_Detect_InputValidator,
 		CV_SURF_Detect_OutputValidator,
-		nullptr,
-		nullptr);
+		CV_SURF_Detect_Initialize,
+		CV_SURF_Detect_Deinitialize);
 
 	if (Kernel)
 	{
@@ -170,7 +170,7 @@ static vx_status VX_CALLBACK CV_Scharr_Kernel(vx_node node, const vx_reference *
 	vx_scalar Delta = (vx_scalar) parameters[6];
 	vx_scalar Bordertype = (vx_scalar) parameters[7];
 
-	Mat *mat, bl;
+	VX_CV_Image mat, out; Mat bl;
 	int ddepth, dx, dy, bordertype;
 	double scale, delta;
 	vx_int32 value = 0;
@@ -186,13 +186,14 @@ static vx_status VX_CALLBACK CV_Scharr_Kernel(vx_node node, const vx_reference *
 
 	//Converting VX Image to OpenCV Mat
 	STATUS_ERROR_CHECK(match_vx_image_parameters(image_in, image_out));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
 
 	//Compute using OpenCV
 	cv::Scharr(*mat, bl, ddepth, dx, dy, scale, delta, bordertype);
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, bl));
 
 	return status;
 }
@@ -144,26 +144,19 @@ static vx_status VX_CALLBACK CV_star_feature_detector_OutputValidator(vx_node no
 	return status;
 }
 
-/*!***********************************************************************************************************
-Execution Kernel
+/************************************************************************************************************
+Initializer function: creates the OpenCV detector once for the node.
 *************************************************************************************************************/
-static vx_status VX_CALLBACK CV_star_feature_detector_Kernel(vx_node node, const vx_reference *parameters, vx_uint32 num)
+static vx_status VX_CALLBACK CV_star_feature_detector_Initialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
 {
 	vx_status status = VX_SUCCESS;
 
-	vx_image image_in = (vx_image) parameters[0];
-	vx_array array = (vx_array) parameters[1];
-	vx_image mask = (vx_image) parameters[2];
 	vx_scalar maxS = (vx_scalar) parameters[3];
 	vx_scalar responseT = (vx_scalar) parameters[4];
 	vx_scalar lineT = (vx_scalar) parameters[5];
 	vx_scalar lineThresholdB = (vx_scalar) parameters[6];
 	vx_scalar suppressN = (vx_scalar) parameters[7];
 
-	Mat *mat, *mask_mat, Img;
-	vx_uint32 width = 0;
-	vx_uint32 height = 0;
-	vector<KeyPoint> key_points;
 	int maxSize, responseThreshold, lineThresholdProjected, lineThresholdBinarized, suppressNonmaxSize;
 	vx_int32 value = 0;
 
@@ -174,16 +167,44 @@ static vx_status VX_CALLBACK CV_star_feature_detector_Kernel(vx_node node, const
 	STATUS_ERROR_CHECK(vxReadScalarValue(lineThresholdB, &value)); lineThresholdBinarized = value;
 	STATUS_ERROR_CHECK(vxReadScalarValue(suppressN, &value)); suppressNonmaxSize = value;
 
+	//Creating the OpenCV Detector
+	STATUS_ERROR_CHECK(CV_Detector_Data_Create(node, xfeatures2d::StarDetector::create(maxSize, responseThreshold, lineThresholdProjected, lineThresholdBinarized, suppressNonmaxSize)));
+
+	return status;
+}
+
+/************************************************************************************************************
+De-Initializer function: releases the OpenCV detector.
+*************************************************************************************************************/
+static vx_status VX_CALLBACK CV_star_feature_detector_Deinitialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	return CV_Detector_Data_Release(node);
+}
+
+/*!***********************************************************************************************************
+Execution Kernel
+*************************************************************************************************************/
+static vx_status VX_CALLBACK CV_star_feature_detector_Kernel(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	vx_status status = VX_SUCCESS;
+	vx_image image_in = (vx_image) parameters[0];
+	vx_array array = (vx_array) parameters[1];
+	vx_image mask = (vx_image) parameters[2];
+
+	CV_Detector_Data * data = CV_Detector_Data_Get(node);
+	if (!data) return VX_ERROR_INVALID_NODE;
+	VX_CV_Image mat, mask_mat;
+
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mask_mat, mask));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mask_mat, mask));
 
 	//Compute using OpenCV
-	Ptr<Feature2D> star = xfeatures2d::StarDetector::create(maxSize, responseThreshold, lineThresholdProjected, lineThresholdBinarized, suppressNonmaxSize);
-	star->detect(*mat, key_points, *mask_mat);
+	data->key_points.clear();
+	data->detector->detect(*mat, data->key_points, *mask_mat);
 
 	//Converting OpenCV Keypoints to OpenVX Keypoints
-	STATUS_ERROR_CHECK(CV_to_VX_keypoints(key_points, array));
+	STATUS_ERROR_CHECK(CV_to_VX_keypoints(data->key_points, array));
 
 	return status;
 }
@@ -201,8 +222,8 @@ vx_status CV_star_detect_Register(vx_context context)
 		8,
 		CV_star_feature_detector_InputValidator,
 		CV_star_feature_detector_OutputValidator,
-		nullptr,
-		nullptr);
+		CV_star_feature_detector_Initialize,
+		CV_star_feature_detector_Deinitialize);
 
 	if (Kernel)
 	{
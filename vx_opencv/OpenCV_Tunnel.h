@@ -48,18 +48,52 @@ using namespace std;
 #define PARAM_ERROR_CHECK(call){vx_status status = call; if(status!= VX_SUCCESS) goto exit;}
 #define MAX_KERNELS 100
 
-int VX_to_CV_Image(Mat**, vx_image);
-int VX_to_CV_MATRIX(Mat**, vx_matrix);
+/* VX image mapped into an OpenCV Mat header (no copy): the patch is unmapped by CV_to_VX_Image or on destruction */
+class VX_CV_Image
+{
+public:
+	VX_CV_Image() : image(nullptr), map_id(0) {}
+	~VX_CV_Image() { if (image) vxUnmapImagePatch(image, map_id); }
+	Mat& operator*() { return mat; }
+	Mat* operator->() { return &mat; }
+
+	Mat mat; vx_image image; vx_map_id map_id;
+
+private:
+	VX_CV_Image(const VX_CV_Image&);
+	VX_CV_Image& operator=(const VX_CV_Image&);
+};
 
-int CV_to_VX_Pyramid(vx_pyramid, vector<Mat>);
+int VX_to_CV_Image(VX_CV_Image&, vx_image, vx_enum usage = VX_READ_ONLY);
+int VX_to_CV_MATRIX(Mat&, vx_matrix);
+
+int CV_to_VX_Pyramid(vx_pyramid, vector<Mat>&);
+int CV_to_VX_Image(VX_CV_Image&, Mat&);
 int CV_to_VX_Image(vx_image, Mat*);
 
-int CV_to_VX_keypoints(vector<KeyPoint>, vx_array);
-int CVPoints2f_to_VX_keypoints(vector<Point2f>, vx_array);
+int CV_to_VX_keypoints(vector<KeyPoint>&, vx_array);
+int CVPoints2f_to_VX_keypoints(vector<Point2f>&, vx_array);
 int CV_DESP_to_VX_DESP(Mat, vx_array, int);
 
 int match_vx_image_parameters(vx_image, vx_image);
 
+/* Per-node feature detector state: the OpenCV detector and the keypoint scratch are created once in the
+   kernel initializer and reused on every frame (the detector parameters are read from the node scalars then) */
+struct CV_Detector_Data
+{
+	Ptr<Feature2D> detector;
+	vector<KeyPoint> key_points;
+};
+
+int CV_Detector_Data_Create(vx_node, Ptr<Feature2D>);
+int CV_Detector_Data_Release(vx_node);
+CV_Detector_Data * CV_Detector_Data_Get(vx_node);
+
+/* Row-tiled parallel filtering: tiles are submatrix views, so OpenCV reads the rows above and below each tile
+   from the full image and only applies the border mode at the real image edges (not with BORDER_ISOLATED) */
+#define CV_TILE_CACHE_SIZE (256 * 1024)
+int CV_Tiled_Filter(Mat& src, Mat& dst, int dst_type, int border_rows, int border_type, std::function<void(const Mat&, Mat&)> filter);
+
 class Kernellist
 {
 public:
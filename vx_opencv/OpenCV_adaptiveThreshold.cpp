@@ -155,7 +155,7 @@ vx_status VX_CALLBACK CV_adaptiveThreshold_Kernel(vx_node node, const vx_referen
 	vx_scalar BLOCKSIZE = (vx_scalar)parameters[5];
 	vx_scalar C = (vx_scalar)parameters[6];
 
-	Mat *mat, bl;
+	VX_CV_Image mat, out; Mat bl;
 
 	int adaptiveMethod, thresholdType, blockSize;
 	float maxValue, c;
@@ -171,13 +171,14 @@ vx_status VX_CALLBACK CV_adaptiveThreshold_Kernel(vx_node node, const vx_referen
 
 	//Converting VX Image to OpenCV Mat
 	STATUS_ERROR_CHECK(match_vx_image_parameters(image_in, image_out));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
 
 	//Compute using OpenCV
 	cv::adaptiveThreshold(*mat, bl, maxValue, adaptiveMethod, thresholdType, blockSize, c);
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, bl));
 
 	return status;
 }
@@ -110,19 +110,20 @@ vx_status VX_CALLBACK CV_bitwise_xor_Kernel(vx_node node, const vx_reference *pa
 	vx_image image_2 = (vx_image) parameters[1];
 	vx_image image_out = (vx_image) parameters[2];
 
-	Mat *mat_1, *mat_2, bl;
+	VX_CV_Image mat_1, mat_2, out; Mat bl;
 
 	//Converting VX Image to OpenCV Mat 1
 	STATUS_ERROR_CHECK(match_vx_image_parameters(image_1, image_2));
 	STATUS_ERROR_CHECK(match_vx_image_parameters(image_1, image_out));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat_1, image_1));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat_2, image_2));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat_1, image_1));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat_2, image_2));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
 
 	//Compute using OpenCV
 	cv::bitwise_xor(*mat_1, *mat_2, bl);
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, bl));
 
 	return status;
 }
@@ -147,7 +147,7 @@ static vx_status VX_CALLBACK CV_brisk_compute_Kernel(vx_node node, const vx_refe
 	vx_scalar OCTAVES = (vx_scalar) parameters[5];
 	vx_scalar SCALE = (vx_scalar) parameters[6];
 
-	Mat *mat, *mask_mat, Img;
+	VX_CV_Image mat, mask_mat; Mat Img;
 	int thresh, octaves;
 	float patternscale;
 	vx_float32 FloatValue = 0;
@@ -159,8 +159,8 @@ static vx_status VX_CALLBACK CV_brisk_compute_Kernel(vx_node node, const vx_refe
 	STATUS_ERROR_CHECK(vxReadScalarValue(OCTAVES, &value));octaves = value; 
 
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mask_mat, mask));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mask_mat, mask));
 
 	//Compute using OpenCV
 	vector<KeyPoint> key_points;
@@ -196,7 +196,7 @@ static vx_status VX_CALLBACK CV_buildOpticalFlowPyramid_Kernel(vx_node node, con
 	vx_scalar D_Border = (vx_scalar) parameters[7];
 	vx_scalar TRY_Reuse = (vx_scalar) parameters[8];
 
-	Mat *mat, bl;
+	VX_CV_Image mat; Mat bl;
 	int W, H, WinSize, Pry_Border, derviBorder;
 	vx_bool WithDervi, try_reuse;
 	vx_int32 value = 0;
@@ -212,7 +212,7 @@ static vx_status VX_CALLBACK CV_buildOpticalFlowPyramid_Kernel(vx_node node, con
 	STATUS_ERROR_CHECK(vxReadScalarValue(TRY_Reuse, &value_b)); try_reuse = value_b;
 
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
 
 	//Compute using OpenCV
 	vector<Mat> pyramid_cv;
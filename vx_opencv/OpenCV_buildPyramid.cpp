@@ -134,7 +134,7 @@ static vx_status VX_CALLBACK CV_buildPyramid_Kernel(vx_node node, const vx_refer
 	vx_scalar scalar = (vx_scalar) parameters[2];
 	vx_scalar scalar1 = (vx_scalar) parameters[3];
 
-	Mat *mat, bl;
+	VX_CV_Image mat; Mat bl;
 	int maxLevel, border;
 
 	vx_int32 value = 0;
@@ -144,7 +144,7 @@ static vx_status VX_CALLBACK CV_buildPyramid_Kernel(vx_node node, const vx_refer
 	STATUS_ERROR_CHECK(vxReadScalarValue(scalar1, &value));border = value;
 
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
 
 	//Compute using OpenCV
 	vector<Mat> pyramid_cv;
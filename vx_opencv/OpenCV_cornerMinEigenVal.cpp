@@ -133,7 +133,7 @@ static vx_status VX_CALLBACK CV_cornerMinEigenVal_Kernel(vx_node node, const vx_
 	vx_scalar KSIZE = (vx_scalar) parameters[3];
 	vx_scalar BORDER = (vx_scalar) parameters[4];
 
-	Mat *mat, bl;
+	VX_CV_Image mat, out; Mat bl;
 	int blockSize, ksize, border;
 	vx_int32 value = 0;
 
@@ -144,13 +144,14 @@ static vx_status VX_CALLBACK CV_cornerMinEigenVal_Kernel(vx_node node, const vx_
 
 	//Converting VX Image to OpenCV Mat
 	STATUS_ERROR_CHECK(match_vx_image_parameters(image_in, image_out));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
 
 	//Compute using OpenCV
 	cv::cornerMinEigenVal(*mat, bl, blockSize, ksize, border);
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, bl));
 
 	return status;
 }
@@ -87,11 +87,11 @@ static vx_status VX_CALLBACK CV_countNonZero_Kernel(vx_node node, const vx_refer
 	vx_status status = VX_SUCCESS;
 	vx_image image_in = (vx_image) parameters[0];
 	vx_scalar scalar = (vx_scalar) parameters[1];
-	Mat *mat;
+	VX_CV_Image mat;
 	int NonZero;
 
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
 
 	//Compute using OpenCV
 	NonZero = cv::countNonZero(*mat);
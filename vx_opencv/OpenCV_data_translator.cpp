@@ -23,10 +23,28 @@ THE SOFTWARE.
 
 #include"OpenCV_Tunnel.h"
 
+/************************************************************************************************************
+VX image format to OpenCV Mat type
+*************************************************************************************************************/
+static int VX_to_CV_Format(vx_df_image format)
+{
+	switch (format)
+	{
+	case VX_DF_IMAGE_U8:   return CV_8U;
+	case VX_DF_IMAGE_U16:  return CV_16U;
+	case VX_DF_IMAGE_S16:  return CV_16S;
+	case VX_DF_IMAGE_U32:  return CV_32S;
+	case VX_DF_IMAGE_S32:  return CV_32S;
+	case VX_DF_IMAGE_RGB:  return CV_8UC3;
+	case VX_DF_IMAGE_RGBX: return CV_8UC4;
+	}
+	return -1;
+}
+
 /************************************************************************************************************
 Converting CV Pyramid into an OpenVX Pyramid
 *************************************************************************************************************/
-int CV_to_VX_Pyramid(vx_pyramid pyramid_vx, vector<Mat> pyramid_cv)
+int CV_to_VX_Pyramid(vx_pyramid pyramid_vx, vector<Mat>& pyramid_cv)
 {
 	vx_status status = VX_SUCCESS;
 	vx_size Level_vx = 0; vx_uint32 width = 0; 	vx_uint32 height = 0; vx_int32 i;
@@ -49,9 +67,9 @@ int CV_to_VX_Pyramid(vx_pyramid pyramid_vx, vector<Mat> pyramid_cv)
 }
 
 /************************************************************************************************************
-Converting VX matrix into an OpenCV Mat
+Converting VX matrix into an OpenCV Mat: the matrix is read directly into the Mat buffer
 *************************************************************************************************************/
-int VX_to_CV_MATRIX(Mat** mat, vx_matrix matrix_vx)
+int VX_to_CV_MATRIX(Mat& mat, vx_matrix matrix_vx)
 {
 	vx_status status = VX_SUCCESS;
 	vx_size numRows = 0; vx_size numCols = 0; vx_enum type; int Type_CV = 0;
@@ -68,24 +86,16 @@ int VX_to_CV_MATRIX(Mat** mat, vx_matrix matrix_vx)
 		vxAddLogEntry((vx_reference)matrix_vx, VX_ERROR_INVALID_FORMAT, "VX_to_CV_MATRIX ERROR: Matrix type not Supported in this RELEASE\n"); return VX_ERROR_INVALID_FORMAT;
 	}
 
-	Mat * m_cv;	m_cv = new Mat((int)numRows, (int)numCols, Type_CV); vx_size mat_size = numRows * numCols;
-	float *dyn_matrix = new float[mat_size]; int z = 0;
+	mat.create((int)numRows, (int)numCols, Type_CV);
+	STATUS_ERROR_CHECK(vxCopyMatrix(matrix_vx, mat.data, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
 
-	STATUS_ERROR_CHECK(vxReadMatrix(matrix_vx, (void *)dyn_matrix));
-	for (int i = 0; i < (int)numRows; i++)
-	for (int j = 0; j < (int)numCols; j++)
-	{
-		m_cv->at<float>(i, j) = dyn_matrix[z]; z++;
-	}
-
-	*mat = m_cv;
 	return status;
 }
 
 /************************************************************************************************************
-Converting VX Image into an OpenCV Mat
+Converting VX Image into an OpenCV Mat: the image patch is mapped and wrapped in a Mat header with the patch stride
 *************************************************************************************************************/
-int VX_to_CV_Image(Mat** mat, vx_image image)
+int VX_to_CV_Image(VX_CV_Image& mat, vx_image image, vx_enum usage)
 {
 	vx_status status = VX_SUCCESS;
 	vx_uint32 width = 0; vx_uint32 height = 0; vx_df_image format = VX_DF_IMAGE_VIRT; int CV_format = 0; vx_size planes = 0;
@@ -94,37 +104,44 @@ int VX_to_CV_Image(Mat** mat, vx_image image)
 	STATUS_ERROR_CHECK(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
 	STATUS_ERROR_CHECK(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format)));
 	STATUS_ERROR_CHECK(vxQueryImage(image, VX_IMAGE_ATTRIBUTE_PLANES, &planes, sizeof(planes)));
-	
-	if (format == VX_DF_IMAGE_U8)CV_format = CV_8U;
-	if (format == VX_DF_IMAGE_S16)CV_format = CV_16S;
-	if (format == VX_DF_IMAGE_RGB)CV_format = CV_8UC3;
-	
-	if (format != VX_DF_IMAGE_U8 && format != VX_DF_IMAGE_S16 && format != VX_DF_IMAGE_RGB)
+
+	CV_format = VX_to_CV_Format(format);
+	if (CV_format < 0 || planes != 1)
 	{
 		vxAddLogEntry((vx_reference)image, VX_ERROR_INVALID_FORMAT, "VX_to_CV_Image ERROR: Image type not Supported in this RELEASE\n"); return VX_ERROR_INVALID_FORMAT;
 	}
-	
-	Mat * m_cv;	m_cv = new Mat(height, width, CV_format); Mat *pMat = (Mat *)m_cv;
-	vx_rectangle_t rect; rect.start_x = 0; rect.start_y = 0; rect.end_x = width; rect.end_y = height; 
 
-	vx_uint8 *src[4] = { NULL, NULL, NULL, NULL }; vx_uint32 p; void *ptr = NULL;
-	vx_imagepatch_addressing_t addr[4] = { 0, 0, 0, 0 }; vx_uint32 y = 0u;
+	vx_rectangle_t rect; rect.start_x = 0; rect.start_y = 0; rect.end_x = width; rect.end_y = height;
+	vx_imagepatch_addressing_t addr; void *ptr = NULL; vx_map_id map_id = 0;
 
-	for (p = 0u; (p < (int)planes); p++)
+	STATUS_ERROR_CHECK(vxMapImagePatch(image, &rect, 0, &map_id, &addr, &ptr, usage, VX_MEMORY_TYPE_HOST, VX_NOGAP_X));
+	mat.mat = Mat(height, width, CV_format, ptr, addr.stride_y);
+	mat.image = image;
+	mat.map_id = map_id;
+
+	return status;
+}
+
+/************************************************************************************************************
+Completing an OpenCV Mat output into its mapped VX Image: copies only if OpenCV did not write into the mapped patch
+*************************************************************************************************************/
+int CV_to_VX_Image(VX_CV_Image& mat, Mat& result)
+{
+	vx_status status = VX_SUCCESS;
+
+	if (result.data != mat.mat.data)
 	{
-		STATUS_ERROR_CHECK(vxAccessImagePatch(image, &rect, p, &addr[p], (void **)&src[p], VX_READ_ONLY));
-		size_t len = addr[p].stride_x * (addr[p].dim_x * addr[p].scale_x) / VX_SCALE_UNITY;
-		for (y = 0; y < height; y += addr[p].step_y)
+		if (result.rows != mat.mat.rows || result.cols != mat.mat.cols || result.elemSize() != mat.mat.elemSize())
 		{
-			ptr = vxFormatImagePatchAddress2d(src[p], 0, y - rect.start_y, &addr[p]);
-			memcpy(pMat->data + y * pMat->step, ptr, len);
+			vxAddLogEntry((vx_reference)mat.image, VX_ERROR_INVALID_DIMENSION, "CV_to_VX_Image ERROR: Output Mat Mismatch\n"); return VX_ERROR_INVALID_DIMENSION;
 		}
+		size_t len = result.cols * result.elemSize();
+		for (int y = 0; y < result.rows; y++)
+			memcpy(mat.mat.ptr(y), result.ptr(y), len);
 	}
 
-	for (p = 0u; p < (int)planes; p++)
-		STATUS_ERROR_CHECK(vxCommitImagePatch(image, &rect, p, &addr[p], src[p]));
-
-	*mat = pMat;
+	STATUS_ERROR_CHECK(vxUnmapImagePatch(mat.image, mat.map_id));
+	mat.image = nullptr;
 
 	return status;
 }
@@ -143,11 +160,11 @@ int CV_to_VX_Image(vx_image image, Mat* mat)
 	Mat *pMat = mat; vx_rectangle_t rect; rect.start_x = 0; rect.start_y = 0; rect.end_x = width; rect.end_y = height; 
 
 	vx_uint8 *src[4] = { NULL, NULL, NULL, NULL }; vx_uint32 p; void *ptr = NULL;
-	vx_imagepatch_addressing_t addr[4] = { 0, 0, 0, 0 }; vx_uint32 y = 0u;
+	vx_imagepatch_addressing_t addr[4]; vx_map_id map_id[4] = { 0, 0, 0, 0 }; vx_uint32 y = 0u;
 
 	for (p = 0u; (p <(int)planes); p++)
 	{
-		STATUS_ERROR_CHECK(vxAccessImagePatch(image, &rect, p, &addr[p], (void **)&src[p], VX_READ_ONLY));
+		STATUS_ERROR_CHECK(vxMapImagePatch(image, &rect, p, &map_id[p], &addr[p], (void **)&src[p], VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, VX_NOGAP_X));
 		size_t len = addr[p].stride_x * (addr[p].dim_x * addr[p].scale_x) / VX_SCALE_UNITY;
 		for (y = 0; y < height; y += addr[p].step_y)
 		{
@@ -157,7 +174,7 @@ int CV_to_VX_Image(vx_image image, Mat* mat)
 	}
 
 	for (p = 0u; p < (int)planes; p++)
-		STATUS_ERROR_CHECK(vxCommitImagePatch(image, &rect, p, &addr[p], src[p]));
+		STATUS_ERROR_CHECK(vxUnmapImagePatch(image, map_id[p]));
 
 	return status;
 }
@@ -165,49 +182,80 @@ int CV_to_VX_Image(vx_image image, Mat* mat)
 /************************************************************************************************************
 sort function.
 *************************************************************************************************************/
-bool sortbysize_CV(const KeyPoint &lhs, const KeyPoint &rhs)
+bool sortbyresponse_CV(const KeyPoint &lhs, const KeyPoint &rhs)
 {
-	return lhs.size < rhs.size;
+	return lhs.response > rhs.response;
 }
 
 /************************************************************************************************************
-OpenCV Keypoints to OpenVX Keypoints
+Round OpenCV Keypoint Co-ordinates
 *************************************************************************************************************/
-int CV_to_VX_keypoints(vector<KeyPoint> key_points, vx_array array)
+static inline vx_int32 CV_Round_Coordinate(float X)
 {
+	return (fmod(X, 1) >= 0.5) ? (vx_int32)ceil(X) : (vx_int32)floor(X);
+}
 
+/************************************************************************************************************
+Resize an OpenVX Keypoint array to count items and map them for writing
+*************************************************************************************************************/
+static int VX_Map_Keypoints(vx_array array, vx_size count, vx_map_id *map_id, vx_size *stride, vx_uint8 **ptr)
+{
 	vx_status status = VX_SUCCESS;
-	vector<vx_keypoint_t> Keypoint_VX;
+	vx_size num_items = 0;
 
-	float X, Y, K_Size, K_Angle, K_Response; int x, y, j = 0;
-	void *ptr = NULL; vx_size size = 0;
-
-	STATUS_ERROR_CHECK(vxQueryArray(array, VX_ARRAY_ATTRIBUTE_CAPACITY, &size, sizeof(size)));
+	STATUS_ERROR_CHECK(vxQueryArray(array, VX_ARRAY_ATTRIBUTE_NUMITEMS, &num_items, sizeof(num_items)));
 
-	size_t 	S = key_points.size(); Keypoint_VX.resize(S);
-	//sort(key_points.begin(), key_points.end(), sortbysize_CV);
-	vx_size stride = 0; void *base = NULL; vx_size L = 0;
+	if (num_items > count)
+	{
+		status = vxTruncateArray(array, count);
+		if (status){ vxAddLogEntry((vx_reference)array, status, "VX_Map_Keypoints ERROR: vxTruncateArray failed\n"); return status; }
+	}
+	else if (num_items < count)
+	{
+		// the new items are zeroed here and overwritten through the mapped range below
+		vector<vx_keypoint_t> blank(count - num_items);
+		status = vxAddArrayItems(array, blank.size(), blank.data(), sizeof(vx_keypoint_t));
+		if (status){ vxAddLogEntry((vx_reference)array, status, "VX_Map_Keypoints ERROR: vxAddArrayItems failed\n"); return status; }
+	}
 
-	for (vector<KeyPoint>::const_iterator i = key_points.begin(); i != key_points.end(); ++i)
+	if (count > 0)
 	{
-		X = key_points[j].pt.x;	Y = key_points[j].pt.y;
-		K_Size = key_points[j].size; K_Angle = key_points[j].angle; K_Response = key_points[j].response;
+		status = vxMapArrayRange(array, 0, count, map_id, stride, (void **)ptr, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, 0);
+		if (status){ vxAddLogEntry((vx_reference)array, status, "VX_Map_Keypoints ERROR: vxMapArrayRange failed\n"); return status; }
+	}
 
-		if (fmod(X, 1) >= 0.5)x = (int)ceil(X); else x = (int)floor(X);
-		if (fmod(Y, 1) >= 0.5)y = (int)ceil(Y); else y = (int)floor(Y);
+	return status;
+}
 
-		Keypoint_VX[j].x = x; Keypoint_VX[j].y = y;
-		Keypoint_VX[j].strength = K_Size; Keypoint_VX[j].orientation = K_Angle; Keypoint_VX[j].scale = K_Response;
-		j++;
-	}
+/************************************************************************************************************
+OpenCV Keypoints to OpenVX Keypoints
+*************************************************************************************************************/
+int CV_to_VX_keypoints(vector<KeyPoint>& key_points, vx_array array)
+{
+	vx_status status = VX_SUCCESS;
+	vx_size size = 0, stride = 0; vx_map_id map_id = 0; vx_uint8 *base = NULL;
 
-	vx_keypoint_t * keypoint_ptr = &Keypoint_VX[0]; size = min(size, S);
+	STATUS_ERROR_CHECK(vxQueryArray(array, VX_ARRAY_ATTRIBUTE_CAPACITY, &size, sizeof(size)));
 
-	status = vxTruncateArray(array, 0);
-	if (status){ vxAddLogEntry((vx_reference)array, status, "CV_to_VX_keypoints ERROR: vxTruncateArray failed\n"); return status; }
+	// keep the strongest keypoints when the array is too small: partial selection, the kept ones are left unordered
+	if (key_points.size() > size)
+		nth_element(key_points.begin(), key_points.begin() + size, key_points.end(), sortbyresponse_CV);
+	size = min(size, key_points.size());
+
+	STATUS_ERROR_CHECK(VX_Map_Keypoints(array, size, &map_id, &stride, &base));
+	if (size == 0) return status;
+
+	for (vx_size j = 0; j < size; j++)
+	{
+		const KeyPoint& K = key_points[j];
+		vx_keypoint_t * keypoint = (vx_keypoint_t *)(base + j * stride);
+		keypoint->x = CV_Round_Coordinate(K.pt.x); keypoint->y = CV_Round_Coordinate(K.pt.y);
+		keypoint->strength = K.size; keypoint->orientation = K.angle; keypoint->scale = K.response;
+		keypoint->tracking_status = 0; keypoint->error = 0;
+	}
 
-	status = vxAddArrayItems(array, size, keypoint_ptr, sizeof(vx_keypoint_t));
-	if (status){ vxAddLogEntry((vx_reference)array, status, "CV_to_VX_keypoints ERROR: vxAddArrayItems failed\n"); return status; }
+	status = vxUnmapArrayRange(array, map_id);
+	if (status){ vxAddLogEntry((vx_reference)array, status, "CV_to_VX_keypoints ERROR: vxUnmapArrayRange failed\n"); return status; }
 
 	return status;
 }
@@ -215,41 +263,30 @@ int CV_to_VX_keypoints(vector<KeyPoint> key_points, vx_array array)
 /************************************************************************************************************
 OpenCV Points to OpenVX Keypoints
 *************************************************************************************************************/
-int CVPoints2f_to_VX_keypoints(vector<Point2f> key_points, vx_array array)
+int CVPoints2f_to_VX_keypoints(vector<Point2f>& key_points, vx_array array)
 {
 	vx_status status = VX_SUCCESS;
-	vector<vx_keypoint_t> Keypoint_VX; float X, Y; int x, y, j = 0;
-	void *ptr = NULL; vx_size size = 0;
+	vx_size size = 0, stride = 0; vx_map_id map_id = 0; vx_uint8 *base = NULL;
 
 	STATUS_ERROR_CHECK(vxQueryArray(array, VX_ARRAY_ATTRIBUTE_CAPACITY, &size, sizeof(size)));
 
-	size_t 	S = key_points.size(); Keypoint_VX.resize(S);
-	//sort(key_points.begin(), key_points.end(), sortbysize_CV);
-	vx_size stride = 0;	void *base = NULL; vx_size L = 0;
-
-	for (int i = 0; i < (int)key_points.size(); ++i)
-	{
-		X = key_points[j].x; Y = key_points[j].y;
+	size = min(size, key_points.size());
 
-		if (fmod(X, 1) >= 0.5)x = (int)ceil(X); else x = (int)floor(X);
-		if (fmod(Y, 1) >= 0.5)y = (int)ceil(Y); else y = (int)floor(Y);
+	STATUS_ERROR_CHECK(VX_Map_Keypoints(array, size, &map_id, &stride, &base));
+	if (size == 0) return status;
 
-		Keypoint_VX[j].x = x; Keypoint_VX[j].y = y;
-		Keypoint_VX[j].strength = 0; Keypoint_VX[j].orientation = 0;	Keypoint_VX[j].scale = 0;
-
-		j++;
+	for (vx_size j = 0; j < size; j++)
+	{
+		vx_keypoint_t * keypoint = (vx_keypoint_t *)(base + j * stride);
+		keypoint->x = CV_Round_Coordinate(key_points[j].x); keypoint->y = CV_Round_Coordinate(key_points[j].y);
+		keypoint->strength = 0; keypoint->orientation = 0; keypoint->scale = 0;
+		keypoint->tracking_status = 0; keypoint->error = 0;
 	}
 
-	vx_keypoint_t * keypoint_ptr = &Keypoint_VX[0]; size = min(size, S);
-
-	status = vxTruncateArray(array, 0);
-	if (status){ vxAddLogEntry((vx_reference)array, status, "CVPoints2f_to_VX_keypoints ERROR: vxTruncateArray failed\n"); return status; }
-
-	status = vxAddArrayItems(array, size, keypoint_ptr, sizeof(vx_keypoint_t));
-	if (status){ vxAddLogEntry((vx_reference)array, status, "CVPoints2f_to_VX_keypoints ERROR: vxAddArrayItems failed\n"); return status; }
+	status = vxUnmapArrayRange(array, map_id);
+	if (status){ vxAddLogEntry((vx_reference)array, status, "CVPoints2f_to_VX_keypoints ERROR: vxUnmapArrayRange failed\n"); return status; }
 
 	return status;
-
 }
 
 /************************************************************************************************************
@@ -295,4 +332,107 @@ int match_vx_image_parameters(vx_image image1, vx_image image2)
 	}
 
 	return status;
-}
\ No newline at end of file
+}
+
+/************************************************************************************************************
+Tile-parallel filtering of an image
+*************************************************************************************************************/
+class CV_Filter_Tiles : public ParallelLoopBody
+{
+public:
+	CV_Filter_Tiles(Mat& src, Mat& dst, int tile_rows, std::function<void(const Mat&, Mat&)>& filter)
+		: src_(src), dst_(dst), tile_rows_(tile_rows), filter_(filter) {}
+
+	void operator()(const Range& range) const
+	{
+		for (int tile = range.start; tile < range.end; tile++)
+		{
+			int y0 = tile * tile_rows_, y1 = min(y0 + tile_rows_, src_.rows);
+			Mat dst_tile = dst_.rowRange(y0, y1);
+			filter_(src_.rowRange(y0, y1), dst_tile);
+		}
+	}
+
+private:
+	Mat& src_; Mat& dst_; int tile_rows_; std::function<void(const Mat&, Mat&)>& filter_;
+};
+
+int CV_Tiled_Filter(Mat& src, Mat& dst, int dst_type, int border_rows, int border_type, std::function<void(const Mat&, Mat&)> filter)
+{
+	vx_status status = VX_SUCCESS;
+
+	// whole image when OpenCV has to allocate the output (type or size differ from the mapped VX output)
+	// or when the border mode must not look outside the tile
+	if (dst.rows != src.rows || dst.cols != src.cols || dst.type() != dst_type || dst.data == src.data || (border_type & BORDER_ISOLATED))
+	{
+		filter(src, dst);
+		return status;
+	}
+
+	// pick tile height so that tile rows, their border rows, and the output rows stay in L2
+	size_t src_row = src.cols * src.elemSize(), dst_row = dst.cols * dst.elemSize();
+	int tile_rows = (int)(CV_TILE_CACHE_SIZE / (src_row + dst_row)) - 2 * border_rows;
+	tile_rows = max(tile_rows, max(2 * border_rows, 16));
+	int tiles = (src.rows + tile_rows - 1) / tile_rows;
+
+	if (tiles <= 1) filter(src, dst);
+	else parallel_for_(Range(0, tiles), CV_Filter_Tiles(src, dst, tile_rows, filter));
+
+	return status;
+}
+
+/************************************************************************************************************
+Create the per-node Feature Detector state
+*************************************************************************************************************/
+int CV_Detector_Data_Create(vx_node node, Ptr<Feature2D> detector)
+{
+	vx_status status = VX_SUCCESS;
+
+	if (detector.empty())
+	{
+		vxAddLogEntry((vx_reference)node, VX_ERROR_NOT_SUPPORTED, "CV_Detector_Data_Create ERROR: OpenCV detector creation failed\n");
+		return VX_ERROR_NOT_SUPPORTED;
+	}
+
+	CV_Detector_Data * data = new CV_Detector_Data;
+	data->detector = detector;
+
+	vx_size size = sizeof(CV_Detector_Data);
+	status = vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &size, sizeof(size));
+	if (status == VX_SUCCESS) status = vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &data, sizeof(data));
+	if (status){ delete data; vxAddLogEntry((vx_reference)node, status, "CV_Detector_Data_Create ERROR: vxSetNodeAttribute failed\n"); return status; }
+
+	return status;
+}
+
+/************************************************************************************************************
+Get the per-node Feature Detector state
+*************************************************************************************************************/
+CV_Detector_Data * CV_Detector_Data_Get(vx_node node)
+{
+	CV_Detector_Data * data = nullptr; vx_size size = 0;
+
+	if (vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &size, sizeof(size)) || size != sizeof(CV_Detector_Data))
+		return nullptr;
+	if (vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &data, sizeof(data)))
+		return nullptr;
+
+	return data;
+}
+
+/************************************************************************************************************
+Release the per-node Feature Detector state
+*************************************************************************************************************/
+int CV_Detector_Data_Release(vx_node node)
+{
+	vx_status status = VX_SUCCESS;
+	CV_Detector_Data * data = CV_Detector_Data_Get(node);
+
+	if (data)
+	{
+		delete data; data = nullptr;
+		status = vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &data, sizeof(data));
+	}
+
+	return status;
+}
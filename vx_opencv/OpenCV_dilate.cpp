@@ -154,7 +154,7 @@ static vx_status VX_CALLBACK CV_dilate_Kernel(vx_node node, const vx_reference *
 	vx_scalar ITERATION = (vx_scalar) parameters[5];
 	vx_scalar BORDER = (vx_scalar) parameters[6];
 
-	Mat *mat, bl;
+	VX_CV_Image mat, out; Mat bl;
 	int iteration;
 	int a_x = -1, a_y = -1, border = 4;
 	vx_int32 value = 0;
@@ -167,15 +167,16 @@ static vx_status VX_CALLBACK CV_dilate_Kernel(vx_node node, const vx_reference *
 
 	//Converting VX Image to OpenCV Mat
 	STATUS_ERROR_CHECK(match_vx_image_parameters(image_in, image_out));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
 
 	//Compute using OpenCV
-	Mat *kernel;
-	STATUS_ERROR_CHECK(VX_to_CV_MATRIX(&kernel, KERNEL));
-	cv::dilate(*mat, bl, *kernel, Point(a_x, a_y), iteration, border);
+	Mat kernel;
+	STATUS_ERROR_CHECK(VX_to_CV_MATRIX(kernel, KERNEL));
+	cv::dilate(*mat, bl, kernel, Point(a_x, a_y), iteration, border);
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, bl));
 
 	return status;
 }
@@ -133,7 +133,7 @@ static vx_status VX_CALLBACK CV_divide_Kernel(vx_node node, const vx_reference *
 	vx_image image_out = (vx_image) parameters[2];
 	vx_scalar SCALE = (vx_scalar) parameters[3];
 	vx_scalar DTYPE = (vx_scalar) parameters[4];
-	Mat *mat_1, *mat_2, bl;
+	VX_CV_Image mat_1, mat_2, out; Mat bl;
 
 	vx_int32 value = 0;
 	int dtype;
@@ -147,14 +147,15 @@ static vx_status VX_CALLBACK CV_divide_Kernel(vx_node node, const vx_reference *
 	//Converting VX Image to OpenCV Mat
 	STATUS_ERROR_CHECK(match_vx_image_parameters(image_1, image_2));
 	STATUS_ERROR_CHECK(match_vx_image_parameters(image_1, image_out));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat_1, image_1));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat_2, image_2));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat_1, image_1));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat_2, image_2));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
 
 	//Compute using OpenCV
 	cv::divide(*mat_1, *mat_2, bl, scale, dtype);
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, bl));
 
 	return status;
 }
@@ -134,7 +134,7 @@ static vx_status VX_CALLBACK CV_fastNlMeansDenoising_Kernel(vx_node node, const
 	vx_scalar Template_WS = (vx_scalar) parameters[3];
 	vx_scalar Search_WS = (vx_scalar) parameters[4];
 
-	Mat *mat, bl;
+	VX_CV_Image mat, out; Mat bl;
 	int search_ws, template_ws;
 	float h;
 	vx_float32 value_f = 0;
@@ -147,13 +147,14 @@ static vx_status VX_CALLBACK CV_fastNlMeansDenoising_Kernel(vx_node node, const
 
 	//Converting VX Image to OpenCV Mat
 	STATUS_ERROR_CHECK(match_vx_image_parameters(image_in, image_out));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
 
 	//Compute using OpenCV
 	cv::fastNlMeansDenoising(*mat, bl, h, template_ws, search_ws);
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, bl));
 
 	return status;
 }
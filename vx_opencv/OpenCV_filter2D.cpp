@@ -166,7 +166,7 @@ static vx_status VX_CALLBACK CV_filter2D_Kernel(vx_node node, const vx_reference
 	vx_scalar DELTA = (vx_scalar) parameters[6];
 	vx_scalar BORDER = (vx_scalar) parameters[7];
 
-	Mat *mat, bl;
+	VX_CV_Image mat, out; Mat bl;
 	int ddepth, a_x = -1, a_y = -1, border = 4;
 	float delta = 0;
 	vx_int32 value = 0;
@@ -181,18 +181,20 @@ static vx_status VX_CALLBACK CV_filter2D_Kernel(vx_node node, const vx_reference
 
 	//Converting VX Image to OpenCV Mat
 	STATUS_ERROR_CHECK(match_vx_image_parameters(image_in, image_out));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
 
 	//Compute using OpenCV
 	Point point;
 	point.x = a_x;
 	point.y = a_y;
-	Mat *kernel;
-	STATUS_ERROR_CHECK(VX_to_CV_MATRIX(&kernel, KERNEL));
-	cv::filter2D(*mat, bl, ddepth, *kernel, point, delta, border);
+	Mat kernel;
+	STATUS_ERROR_CHECK(VX_to_CV_MATRIX(kernel, KERNEL));
+	int type = CV_MAKETYPE(ddepth < 0 ? mat->depth() : ddepth, mat->channels());
+	STATUS_ERROR_CHECK(CV_Tiled_Filter(*mat, bl, type, kernel.rows / 2 + 1, border, [&](const Mat& src, Mat& dst) { cv::filter2D(src, dst, ddepth, kernel, point, delta, border); }));
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, bl));
 
 	return status;
 }
@@ -109,7 +109,7 @@ static vx_status VX_CALLBACK CV_flip_Kernel(vx_node node, const vx_reference *pa
 	vx_image image_in = (vx_image)parameters[0];
 	vx_image image_out = (vx_image)parameters[1];
 	vx_scalar scalar = (vx_scalar)parameters[2];
-	Mat *mat, bl;
+	VX_CV_Image mat, out; Mat bl;
 	int FlipCode;
 
 	vx_int32 value = 0;
@@ -118,13 +118,14 @@ static vx_status VX_CALLBACK CV_flip_Kernel(vx_node node, const vx_reference *pa
 	STATUS_ERROR_CHECK(vxReadScalarValue(scalar, &value)); FlipCode = value;
 
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
 
 	//Compute using OpenCV
 	cv::flip(*mat, bl, FlipCode); //output image size should correspond to the right flip code
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, bl));
 
 	return status;
 }
@@ -110,7 +110,7 @@ static vx_status VX_CALLBACK CV_integral_Kernel(vx_node node, const vx_reference
 	vx_image image_out = (vx_image) parameters[1];
 	vx_scalar scalar = (vx_scalar) parameters[2];
 
-	Mat *mat, bl;
+	VX_CV_Image mat, out; Mat bl;
 	int sdepth;
 	vx_int32 value = 0;
 
@@ -119,13 +119,15 @@ static vx_status VX_CALLBACK CV_integral_Kernel(vx_node node, const vx_reference
 
 	//Converting VX Image to OpenCV Mat
 	STATUS_ERROR_CHECK(match_vx_image_parameters(image_in, image_out));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
 
-	//Compute using OpenCV
+	//Compute using OpenCV: the (H+1)x(W+1) result has a zero first row and column
 	cv::integral(*mat, bl, sdepth);
+	Mat roi = bl(cv::Rect(1, 1, (*mat).cols, (*mat).rows));
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, roi));
 
 	return status;
 }
@@ -100,7 +100,7 @@ static vx_status VX_CALLBACK CV_norm_Kernel(vx_node node, const vx_reference *pa
 	vx_scalar scalar = (vx_scalar) parameters[1];
 	vx_scalar scalar1 = (vx_scalar) parameters[2];
 
-	Mat *mat;
+	VX_CV_Image mat;
 	int Type;
 	vx_int32 value = 0;
 
@@ -108,7 +108,7 @@ static vx_status VX_CALLBACK CV_norm_Kernel(vx_node node, const vx_reference *pa
 	STATUS_ERROR_CHECK(vxReadScalarValue(scalar1, &value));	Type = value;
 
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
 
 	//Compute using OpenCV
 	float NORM_Val = 0;
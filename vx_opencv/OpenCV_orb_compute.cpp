@@ -208,7 +208,7 @@ static vx_status VX_CALLBACK CV_orb_compute_Kernel(vx_node node, const vx_refere
 	vx_scalar SCORETYPE = (vx_scalar) parameters[10];
 	vx_scalar PATCHSIZE = (vx_scalar) parameters[11];
 
-	Mat *mat, *mask_mat, Img;
+	VX_CV_Image mat, mask_mat; Mat Img;
 	int nFeatures, nLevels, edgeThreshold, firstLevel, WTA_K, scoreType, patchSize;
 	float  ScaleFactor;
 	vector<KeyPoint> key_points;
@@ -227,8 +227,8 @@ static vx_status VX_CALLBACK CV_orb_compute_Kernel(vx_node node, const vx_refere
 	STATUS_ERROR_CHECK(vxReadScalarValue(PATCHSIZE, &value));patchSize = value; 
 
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mask_mat, mask));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mask_mat, mask));
 	
 	//Compute using OpenCV
 	Ptr<Feature2D> orb = ORB::create(nFeatures, ScaleFactor, nLevels, edgeThreshold, firstLevel, WTA_K, scoreType, patchSize);
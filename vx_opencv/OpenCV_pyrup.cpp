@@ -134,7 +134,7 @@ static vx_status VX_CALLBACK CV_pyrup_Kernel(vx_node node, const vx_reference *p
 	vx_scalar S_height = (vx_scalar) parameters[3];
 	vx_scalar BORDER = (vx_scalar) parameters[4];
 
-	Mat *mat;
+	VX_CV_Image mat, out; Mat bl;
 	int W, H, border;
 	vx_int32 value = 0;
 
@@ -144,14 +144,18 @@ static vx_status VX_CALLBACK CV_pyrup_Kernel(vx_node node, const vx_reference *p
 	STATUS_ERROR_CHECK(vxReadScalarValue(BORDER, &value)); border = value;
 
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
+
+	//Validation: dstsize of zero means the output image size
+	if ((W > 0 && W != bl.cols) || (H > 0 && H != bl.rows)) { status = VX_ERROR_INVALID_DIMENSION; return status; }
 
 	//Compute using OpenCV
-	Mat bl(Size(W, H), CV_8U);//Only CV_8U supported in this release
-	cv::pyrUp(*mat, bl, Size(W, H), border);
+	//Only CV_8U supported in this release
+	cv::pyrUp(*mat, bl, bl.size(), border);
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, bl));
 
 	return status;
 }
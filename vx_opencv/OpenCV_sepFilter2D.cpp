@@ -174,7 +174,7 @@ static vx_status VX_CALLBACK CV_sepFilter2D_Kernel(vx_node node, const vx_refere
 	vx_scalar DELTA = (vx_scalar) parameters[7];
 	vx_scalar BORDER = (vx_scalar) parameters[8];
 
-	Mat *mat, bl;
+	VX_CV_Image mat, out; Mat bl;
 	int ddepth, a_x = -1, a_y = -1, border = 4;
 	float delta = 0;
 	vx_int32 value = 0;
@@ -189,19 +189,22 @@ static vx_status VX_CALLBACK CV_sepFilter2D_Kernel(vx_node node, const vx_refere
 
 	//Converting VX Image to OpenCV Mat
 	STATUS_ERROR_CHECK(match_vx_image_parameters(image_in, image_out));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
 
 	//Compute using OpenCV
 	Point point;
 	point.x = a_x;
 	point.y = a_y;
-	Mat *kernelX, *kernelY;
-	STATUS_ERROR_CHECK(VX_to_CV_MATRIX(&kernelX, KERNELX));
-	STATUS_ERROR_CHECK(VX_to_CV_MATRIX(&kernelY, KERNELY));
-	cv::sepFilter2D(*mat, bl, ddepth, *kernelX, *kernelY, point, delta, border);
+	Mat kernelX, kernelY;
+	STATUS_ERROR_CHECK(VX_to_CV_MATRIX(kernelX, KERNELX));
+	STATUS_ERROR_CHECK(VX_to_CV_MATRIX(kernelY, KERNELY));
+	int type = CV_MAKETYPE(ddepth < 0 ? mat->depth() : ddepth, mat->channels());
+	int border_rows = (int)max(kernelY.rows, kernelY.cols) / 2 + 1;
+	STATUS_ERROR_CHECK(CV_Tiled_Filter(*mat, bl, type, border_rows, border, [&](const Mat& src, Mat& dst) { cv::sepFilter2D(src, dst, ddepth, kernelX, kernelY, point, delta, border); }));
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, bl));
 
 	return status;
 }
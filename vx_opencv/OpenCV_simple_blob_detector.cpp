@@ -92,6 +92,27 @@ static vx_status VX_CALLBACK CV_simple_blob_detector_OutputValidator(vx_node nod
 	return status;
 }
 
+/************************************************************************************************************
+Initializer function: creates the OpenCV detector once for the node.
+*************************************************************************************************************/
+static vx_status VX_CALLBACK CV_simple_blob_detector_Initialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	vx_status status = VX_SUCCESS;
+
+	//Creating the OpenCV Detector
+	STATUS_ERROR_CHECK(CV_Detector_Data_Create(node, SimpleBlobDetector::create()));
+
+	return status;
+}
+
+/************************************************************************************************************
+De-Initializer function: releases the OpenCV detector.
+*************************************************************************************************************/
+static vx_status VX_CALLBACK CV_simple_blob_detector_Deinitialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	return CV_Detector_Data_Release(node);
+}
+
 /*!***********************************************************************************************************
 Execution Kernel
 *************************************************************************************************************/
@@ -101,19 +122,21 @@ static vx_status VX_CALLBACK CV_simple_blob_detector_Kernel(vx_node node, const
 	vx_image image_in = (vx_image) parameters[0];
 	vx_array array = (vx_array) parameters[1];
 	vx_image mask = (vx_image) parameters[2];
-	vector<KeyPoint> key_points;
-	Mat *mat, *mask_mat, Img;
+
+	CV_Detector_Data * data = CV_Detector_Data_Get(node);
+	if (!data) return VX_ERROR_INVALID_NODE;
+	VX_CV_Image mat, mask_mat;
 
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mask_mat, mask));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mask_mat, mask));
 
-	//OpenCV Calls to Simple Blob Detector
-	Ptr<Feature2D> simple = SimpleBlobDetector::create();
-	simple->detect(*mat, key_points, *mask_mat);
+	//Compute using OpenCV
+	data->key_points.clear();
+	data->detector->detect(*mat, data->key_points, *mask_mat);
 
 	//Converting OpenCV Keypoints to OpenVX Keypoints
-	STATUS_ERROR_CHECK(CV_to_VX_keypoints(key_points, array));
+	STATUS_ERROR_CHECK(CV_to_VX_keypoints(data->key_points, array));
 
 	return status;
 }
@@ -131,8 +154,8 @@ vx_status CV_simple_blob_detect_Register(vx_context context)
 		3,
 		CV_simple_blob_detector_InputValidator,
 		CV_simple_blob_detector_OutputValidator,
-		nullptr,
-		nullptr);
+		CV_simple_blob_detector_Initialize,
+		CV_simple_blob_detector_Deinitialize);
 
 	if (Kernel)
 	{
@@ -403,20 +426,13 @@ static vx_status VX_CALLBACK CV_simple_blob_detector_INITIALIZE_InputValidator(v
 	return status;
 }
 
-/*!***********************************************************************************************************
-Execution Kernel
+/************************************************************************************************************
+Initializer function: creates the OpenCV detector once for the node.
 *************************************************************************************************************/
-static vx_status VX_CALLBACK CV_simple_blob_detector_INITIALIZE_Kernel(vx_node node, const vx_reference *parameters, vx_uint32 num)
+static vx_status VX_CALLBACK CV_simple_blob_detector_INITIALIZE_Initialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
 {
 	vx_status status = VX_SUCCESS;
 
-	vx_image image_in = (vx_image) parameters[0];
-	vx_array array = (vx_array) parameters[1];
-	vx_image mask = (vx_image) parameters[2];
-
-	vector<KeyPoint> key_points;
-	Mat *mat, *mask_mat, Img;
-
 	vx_scalar THRESHOLDSTEP = (vx_scalar) parameters[3];
 	vx_scalar MINTHRESHOLD = (vx_scalar) parameters[4];
 	vx_scalar MAXTHRESHOLD = (vx_scalar) parameters[5];
@@ -466,11 +482,7 @@ static vx_status VX_CALLBACK CV_simple_blob_detector_INITIALIZE_Kernel(vx_node n
 	STATUS_ERROR_CHECK(vxReadScalarValue(FILTERBYCON, &value)); filterByConvexity = value;
 	STATUS_ERROR_CHECK(vxReadScalarValue(BLOBCOLOR, &blobColor));
 
-	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mask_mat, mask));
-
-	//OpenCV Calls to Simple Blob Detector
+	//Creating the OpenCV Detector
 	bool filterByColor_bool, filterByArea_bool, filterByCircularity_bool, filterByConvexity_bool, filterByInertia_bool;
 	if (filterByColor == vx_true_e) filterByColor_bool = true; else filterByColor_bool = false;
 	if (filterByArea == vx_true_e) filterByArea_bool = true; else filterByArea_bool = false;
@@ -498,11 +510,43 @@ static vx_status VX_CALLBACK CV_simple_blob_detector_INITIALIZE_Kernel(vx_node n
 	params.minArea = minArea;
 	params.minConvexity = minConvexity;
 
-	Ptr<Feature2D> simple = SimpleBlobDetector::create(params);
-	simple->detect(*mat, key_points, *mask_mat);
+	STATUS_ERROR_CHECK(CV_Detector_Data_Create(node, SimpleBlobDetector::create(params)));
+
+	return status;
+}
+
+/************************************************************************************************************
+De-Initializer function: releases the OpenCV detector.
+*************************************************************************************************************/
+static vx_status VX_CALLBACK CV_simple_blob_detector_INITIALIZE_Deinitialize(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	return CV_Detector_Data_Release(node);
+}
+
+/*!***********************************************************************************************************
+Execution Kernel
+*************************************************************************************************************/
+static vx_status VX_CALLBACK CV_simple_blob_detector_INITIALIZE_Kernel(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+	vx_status status = VX_SUCCESS;
+	vx_image image_in = (vx_image) parameters[0];
+	vx_array array = (vx_array) parameters[1];
+	vx_image mask = (vx_image) parameters[2];
+
+	CV_Detector_Data * data = CV_Detector_Data_Get(node);
+	if (!data) return VX_ERROR_INVALID_NODE;
+	VX_CV_Image mat, mask_mat;
+
+	//Converting VX Image to OpenCV Mat
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mask_mat, mask));
+
+	//Compute using OpenCV
+	data->key_points.clear();
+	data->detector->detect(*mat, data->key_points, *mask_mat);
 
 	//Converting OpenCV Keypoints to OpenVX Keypoints
-	STATUS_ERROR_CHECK(CV_to_VX_keypoints(key_points, array));
+	STATUS_ERROR_CHECK(CV_to_VX_keypoints(data->key_points, array));
 
 	return status;
 }
@@ -520,8 +564,8 @@ vx_status CV_simple_blob_detect_initialize_Register(vx_context context)
 		22,
 		CV_simple_blob_detector_INITIALIZE_InputValidator,
 		CV_simple_blob_detector_OutputValidator,
-		nullptr,
-		nullptr);
+		CV_simple_blob_detector_INITIALIZE_Initialize,
+		CV_simple_blob_detector_INITIALIZE_Deinitialize);
 
 	if (Kernel)
 	{
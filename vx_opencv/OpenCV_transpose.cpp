@@ -97,7 +97,7 @@ static vx_status VX_CALLBACK CV_transpose_Kernel(vx_node node, const vx_referenc
 	vx_image image_in = (vx_image) parameters[0];
 	vx_image image_out = (vx_image) parameters[1];
 
-	Mat *mat, bl;
+	VX_CV_Image mat, out; Mat bl;
 
 	//Validation
 	vx_uint32 width_in, height_in, width_out, height_out;
@@ -109,13 +109,14 @@ static vx_status VX_CALLBACK CV_transpose_Kernel(vx_node node, const vx_referenc
 	if (height_in != width_out || width_in != height_out) { status = VX_ERROR_INVALID_DIMENSION; return status; }
 
 	//Converting VX Image to OpenCV Mat
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
 
 	//Compute using OpenCV
 	cv::transpose(*mat, bl);
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, bl));
 
 	return status;
 }
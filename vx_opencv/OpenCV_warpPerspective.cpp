@@ -154,7 +154,7 @@ static vx_status VX_CALLBACK CV_warpPerspective_Kernel(vx_node node, const vx_re
 	vx_scalar FLAGS = (vx_scalar) parameters[5];
 	vx_scalar BORDER = (vx_scalar) parameters[6];
 
-	Mat *mat, bl;
+	VX_CV_Image mat, out; Mat bl;
 	int flags;
 	int a_x = -1, a_y = -1, border = 4;
 	vx_int32 value = 0;
@@ -167,15 +167,19 @@ static vx_status VX_CALLBACK CV_warpPerspective_Kernel(vx_node node, const vx_re
 
 	//Converting VX Image to OpenCV Mat
 	STATUS_ERROR_CHECK(match_vx_image_parameters(image_in, image_out));
-	STATUS_ERROR_CHECK(VX_to_CV_Image(&mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(mat, image_in));
+	STATUS_ERROR_CHECK(VX_to_CV_Image(out, image_out, VX_WRITE_ONLY)); bl = *out;
+
+	//Validation: dsize of zero means the output image size
+	if ((a_x > 0 && a_x != bl.cols) || (a_y > 0 && a_y != bl.rows)) { status = VX_ERROR_INVALID_DIMENSION; return status; }
 
 	//Compute using OpenCV
-	Mat *M;
-	STATUS_ERROR_CHECK(VX_to_CV_MATRIX(&M, KERNEL));
-	cv::warpPerspective(*mat, bl, *M, Size(a_x, a_y), flags, border);
+	Mat M;
+	STATUS_ERROR_CHECK(VX_to_CV_MATRIX(M, KERNEL));
+	cv::warpPerspective(*mat, bl, M, bl.size(), flags, border);
 
 	//Converting OpenCV Mat into VX Image
-	STATUS_ERROR_CHECK(CV_to_VX_Image(image_out, &bl));
+	STATUS_ERROR_CHECK(CV_to_VX_Image(out, bl));
 
 	return status;
 }